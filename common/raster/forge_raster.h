@@ -13,18 +13,38 @@
  * Supports:
  *   - RGBA8888 framebuffer creation, clearing, and BMP writing
  *   - Edge-function triangle rasterization with bounding box optimization
+ *     and 8x8 block classification: blocks fully outside a triangle are
+ *     skipped, blocks fully inside are drawn without per-pixel edge tests
+ *   - 1/256 pixel sub-pixel precision: fixed-point edge functions stepped
+ *     incrementally per pixel and per row, with the top-left fill rule, so
+ *     triangles sharing an edge never leave gaps or blend a pixel twice
  *   - Barycentric interpolation of vertex colors and UV coordinates
  *   - Optional grayscale texture sampling (nearest-neighbor)
+ *   - Signed distance field textures (bilinear distance, reconstructed
+ *     coverage) for rendering SDF font atlases at any scale
  *   - Source-over alpha blending
  *   - Indexed triangle drawing (vertex + index buffer batches)
+ *   - Packed 16-byte vertices (ForgeRasterPackedVertex, matching
+ *     ForgeUiPackedVertex): conversion and direct indexed drawing
+ *   - Partial redraws: clearing a rect and drawing a batch into a list of
+ *     damage rects (e.g. ForgeUiContext.damage_rects)
+ *   - Tiled drawing across worker threads: triangles are binned into
+ *     screen tiles in submission order, and the output is byte-identical
+ *     to the serial draw.  A ForgeRasterPool keeps the workers alive
+ *     between draws
+ *   - SSE2 / AVX2 / NEON span kernels for interpolation, sampling and
+ *     blending, chosen at runtime, with a scalar reference kernel
  *   - 32-bit BMP output with alpha channel
  *
  * Limitations (intentional for a learning library):
- *   - No subpixel precision or fill rules beyond basic edge function test
- *   - No SIMD or other optimizations -- clarity over speed
- *   - Nearest-neighbor texture sampling only (no bilinear filtering)
- *   - No depth buffer or z-testing
- *   - No clipping (triangles are clamped to framebuffer bounds)
+ *   - SIMD only in the span kernels; the scalar kernel is the readable
+ *     reference and SDF textures always use it
+ *   - Nearest-neighbor sampling for coverage textures (bilinear is used
+ *     only for SDF textures, where it is required for correct edges)
+ *   - 2D only: no depth buffer, projection or clipping (triangles are
+ *     clamped to framebuffer bounds; vertices more than 2^21 pixels from
+ *     the origin are rejected).  forge_raster_3d.h adds all three on top
+ *     of this rasterizer.
  *
  * Usage:
  *   #include "raster/forge_raster.h"
@@ -50,6 +70,28 @@
 #include <stdint.h>  /* UINT32_MAX for BMP size validation */
 #include <stdio.h>   /* FILE, fopen, fwrite, fclose for BMP writing */
 
+/* SIMD span kernels (forge_raster__span_*).  SSE2 is part of the x86-64
+ * baseline and NEON of AArch64, so those need no runtime check; AVX2 is
+ * compiled for a function-level target and only used when SDL_HasAVX2()
+ * says the CPU has it.  Other targets use the scalar kernel. */
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define FORGE_RASTER__SIMD_SSE2 1
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+#include <immintrin.h>
+#define FORGE_RASTER__SIMD_AVX2 1
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define FORGE_RASTER__SIMD_NEON 1
+#endif
+
+#if defined(FORGE_RASTER__SIMD_AVX2) && (defined(__GNUC__) || defined(__clang__))
+#define FORGE_RASTER__TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define FORGE_RASTER__TARGET_AVX2
+#endif
+
 /* ── Public Constants ────────────────────────────────────────────────────── */
 
 /* Bytes per pixel in the framebuffer (RGBA8888) */
@@ -61,6 +103,18 @@
  * 16384 is 4x a typical 4K display -- generous for a learning library. */
 #define FORGE_RASTER_MAX_DIM 16384
 
+/* Default edge length of a screen tile for tiled drawing (see
+ * ForgeRasterTileOpts.tile_size).  64x64 RGBA pixels is 16 KB, small
+ * enough to stay in a core's L1/L2 cache while its triangles are drawn. */
+#define FORGE_RASTER_DEFAULT_TILE_SIZE 64
+
+/* Smallest tile edge accepted by tiled drawing; smaller values are raised
+ * to this so the bin lists stay a small multiple of the triangle count. */
+#define FORGE_RASTER_MIN_TILE_SIZE 16
+
+/* Upper bound on ForgeRasterTileOpts.thread_count. */
+#define FORGE_RASTER_MAX_THREADS 64
+
 /* ── Public Types ────────────────────────────────────────────────────────── */
 
 /* A single vertex with position, texture coordinates, and color.
@@ -74,6 +128,15 @@ typedef struct ForgeRasterVertex {
                         * pixel and multiplied with the texture sample */
 } ForgeRasterVertex;   /* 32 bytes -- matches ForgeUiVertex layout */
 
+/* A packed vertex: float position, unorm16 UV, RGBA8 color.
+ * Matches ForgeUiPackedVertex layout, so a UI context's packed_vertices
+ * can be drawn without going back through the float format. */
+typedef struct ForgeRasterPackedVertex {
+    float  x, y;        /* screen position in pixels */
+    Uint16 u, v;        /* texture coordinates, 65535 = 1.0 */
+    Uint8  r, g, b, a;  /* vertex color (straight alpha), 255 = 1.0 */
+} ForgeRasterPackedVertex;  /* 16 bytes -- matches ForgeUiPackedVertex */
+
 /* An RGBA8888 pixel buffer (framebuffer).
  * Pixels are stored row-major, top-left origin, 4 bytes per pixel
  * in R, G, B, A order. */
@@ -94,8 +157,66 @@ typedef struct ForgeRasterTexture {
                            * the texel value multiplies the vertex color */
     int          width;   /* width in texels */
     int          height;  /* height in texels */
+    float        sdf_screen_range; /* 0 = texels are coverage.  > 0 = texels
+                           * are a signed distance field (128 = edge) and
+                           * this is the screen-pixel distance between
+                           * texel values 0 and 255 -- see
+                           * forge_ui_atlas_sdf_screen_range() */
 } ForgeRasterTexture;
 
+/* A pixel rectangle [x, x + w) x [y, y + h), e.g. one damage rect. */
+typedef struct ForgeRasterRect {
+    int x;
+    int y;
+    int w;
+    int h;
+} ForgeRasterRect;
+
+/* Span kernel used for the per-pixel work of every triangle: attribute
+ * interpolation, texture sampling and blending.  The SIMD kernels do 4 or
+ * 8 pixels per step with the scalar kernel's exact operation order, so
+ * they produce the same bytes -- unless the compiler contracts the scalar
+ * code into FMAs (-ffp-contract with -mfma), which can move a channel by
+ * one 8-bit step. */
+typedef enum ForgeRasterSimd {
+    FORGE_RASTER_SIMD_AUTO = 0,  /* widest kernel the CPU supports */
+    FORGE_RASTER_SIMD_SCALAR,    /* one pixel at a time (reference) */
+    FORGE_RASTER_SIMD_SSE2,      /* 4 pixels, x86-64 */
+    FORGE_RASTER_SIMD_AVX2,      /* 8 pixels, x86-64 with AVX2 */
+    FORGE_RASTER_SIMD_NEON       /* 4 pixels, AArch64 */
+} ForgeRasterSimd;
+
+/* Worker threads kept alive across tiled draws (see
+ * forge_raster_pool_create).  The workers sleep on a condition variable
+ * between draws, so a draw wakes them instead of starting threads.  One
+ * draw at a time: a pool must not be shared by draws running
+ * concurrently on different threads.  Fields are internal. */
+typedef struct ForgeRasterPool {
+    SDL_Thread                   *threads[FORGE_RASTER_MAX_THREADS];
+    int                           worker_count; /* threads besides the caller */
+    SDL_Mutex                    *lock;
+    SDL_Condition                *work_ready;   /* a job was posted or quit */
+    SDL_Condition                *work_done;    /* busy dropped to 0 */
+    struct ForgeRaster__TileJob  *job;          /* job being drawn */
+    Uint32                        generation;   /* bumped once per job */
+    int                           busy;         /* workers still in the job */
+    bool                          quit;
+} ForgeRasterPool;
+
+/* Options for forge_raster_triangles_indexed_tiled().  A zeroed struct
+ * (or NULL) uses 64x64 tiles and one thread per logical CPU core. */
+typedef struct ForgeRasterTileOpts {
+    int tile_size;     /* tile edge in pixels (0 = FORGE_RASTER_DEFAULT_TILE_SIZE,
+                        * at least FORGE_RASTER_MIN_TILE_SIZE) */
+    int thread_count;  /* threads drawing tiles, including the caller
+                        * (0 = SDL_GetNumLogicalCPUCores(), 1 = caller only;
+                        * clamped to FORGE_RASTER_MAX_THREADS).  Ignored
+                        * when pool is set.  The output is byte-identical
+                        * for any count */
+    ForgeRasterPool *pool;  /* workers to draw with (NULL = start and join
+                             * thread_count - 1 threads for this draw) */
+} ForgeRasterTileOpts;
+
 /* ── Public API ──────────────────────────────────────────────────────────── */
 
 /* Allocate an RGBA8888 framebuffer.  Returns a buffer with pixels set to
@@ -109,11 +230,19 @@ static inline void forge_raster_buffer_destroy(ForgeRasterBuffer *buf);
 static inline void forge_raster_clear(ForgeRasterBuffer *buf,
                                       float r, float g, float b, float a);
 
+/* Fill the pixels in [x, x + w) x [y, y + h) with a solid color.  The
+ * rect is intersected with the framebuffer; an empty rect does nothing. */
+static inline void forge_raster_clear_rect(ForgeRasterBuffer *buf,
+                                           int x, int y, int w, int h,
+                                           float r, float g, float b, float a);
+
 /* Rasterize a single triangle into the framebuffer.
  *
  * Uses the edge function method: compute barycentric coordinates for each
  * pixel in the triangle's bounding box, interpolate vertex attributes, and
- * alpha-blend onto the framebuffer.
+ * alpha-blend onto the framebuffer.  Vertices snap to 1/256 pixel, and a
+ * pixel center exactly on an edge is drawn only if the edge is a top or
+ * left edge, so the two triangles of a quad blend their diagonal once.
  *
  * If texture is non-NULL, interpolated UVs sample the grayscale texture
  * and multiply with the interpolated vertex color -- the same model Dear
@@ -124,6 +253,18 @@ static inline void forge_raster_triangle(ForgeRasterBuffer *buf,
                                          const ForgeRasterVertex *v2,
                                          const ForgeRasterTexture *texture);
 
+/* Sample an SDF texture at (u, v) and return coverage in [0, 1].
+ *
+ * This is the CPU reference for an SDF text shader: the distance is
+ * bilinearly interpolated from the four nearest texels (texel centers at
+ * (i + 0.5) / width), converted to screen pixels with sdf_screen_range,
+ * and mapped to coverage with a one-pixel-wide linear ramp centered on the
+ * outline:
+ *   alpha = clamp((d - 0.5) * sdf_screen_range + 0.5, 0, 1)
+ * Returns 0 if the texture is missing or not an SDF texture. */
+static inline float forge_raster_sample_sdf(const ForgeRasterTexture *texture,
+                                            float u, float v);
+
 /* Draw triangles from vertex and index arrays (batch draw call).
  *
  * Every three consecutive indices form one triangle.  index_count must
@@ -135,6 +276,100 @@ static inline void forge_raster_triangles_indexed(ForgeRasterBuffer *buf,
                                                   int index_count,
                                                   const ForgeRasterTexture *texture);
 
+/* Draw indexed triangles with a scissor rectangle, like a GPU draw call
+ * after SDL_SetGPUScissor.  Only pixels in [x, x + w) x [y, y + h) are
+ * touched; the rect is intersected with the framebuffer, and an empty
+ * rect draws nothing.  Pixels inside the scissor come out exactly as
+ * forge_raster_triangles_indexed would write them. */
+static inline void forge_raster_triangles_indexed_scissor(ForgeRasterBuffer *buf,
+                                                          const ForgeRasterVertex *vertices,
+                                                          int vertex_count,
+                                                          const Uint32 *indices,
+                                                          int index_count,
+                                                          const ForgeRasterTexture *texture,
+                                                          int x, int y,
+                                                          int w, int h);
+
+/* Draw indexed triangles into a list of non-overlapping rects -- the
+ * partial redraw of a damaged frame.  Each triangle is only rasterized
+ * against the rects its bounding box reaches, and pixels inside the rects
+ * come out exactly as forge_raster_triangles_indexed would write them;
+ * pixels outside every rect are not touched.  Clear the rects first
+ * (forge_raster_clear_rect) when redrawing a frame over its previous
+ * image. */
+static inline void forge_raster_triangles_indexed_rects(ForgeRasterBuffer *buf,
+                                                        const ForgeRasterVertex *vertices,
+                                                        int vertex_count,
+                                                        const Uint32 *indices,
+                                                        int index_count,
+                                                        const ForgeRasterTexture *texture,
+                                                        const ForgeRasterRect *rects,
+                                                        int rect_count);
+
+/* Draw indexed triangles split into screen tiles, drawn in parallel.
+ *
+ * A binning pass on the calling thread appends each triangle to the list
+ * of every tile its bounding box reaches, in submission order; worker
+ * threads then claim whole tiles and draw their lists.  Tiles never share
+ * a pixel and each pixel still sees its triangles in submission order, so
+ * the framebuffer comes out byte-identical to forge_raster_triangles_indexed
+ * for any tile size and thread count.  If the bins cannot be allocated the
+ * batch is drawn serially instead.  Pass a pool in opts when drawing
+ * many batches (e.g. one per UI draw command) so the worker threads are
+ * reused rather than started for every call. */
+static inline void forge_raster_triangles_indexed_tiled(ForgeRasterBuffer *buf,
+                                                        const ForgeRasterVertex *vertices,
+                                                        int vertex_count,
+                                                        const Uint32 *indices,
+                                                        int index_count,
+                                                        const ForgeRasterTexture *texture,
+                                                        const ForgeRasterTileOpts *opts);
+
+/* Start thread_count - 1 worker threads for tiled drawing; the thread
+ * that draws is the last one (0 = SDL_GetNumLogicalCPUCores(), clamped
+ * to FORGE_RASTER_MAX_THREADS).  Workers that fail to start are logged
+ * and left out.  Returns NULL if thread_count is negative or the pool's
+ * synchronization objects cannot be created. */
+static inline ForgeRasterPool *forge_raster_pool_create(int thread_count);
+
+/* Stop and join the pool's workers and free it.  NULL is a no-op.  Must
+ * not be called while a draw is using the pool. */
+static inline void forge_raster_pool_destroy(ForgeRasterPool *pool);
+
+/* Threads drawing tiles with this pool, including the caller (0 for
+ * NULL). */
+static inline int forge_raster_pool_thread_count(const ForgeRasterPool *pool);
+
+/* Expand packed vertices to the float format used by the rasterizer.
+ * UVs divide by 65535 and colors by 255. */
+static inline void forge_raster_unpack_vertices(const ForgeRasterPackedVertex *src,
+                                                ForgeRasterVertex *dst,
+                                                int count);
+
+/* Draw triangles from packed vertices and indices.  Each triangle's three
+ * vertices are unpacked on the fly, so no float copy of the whole buffer
+ * is needed; output matches unpacking first and calling
+ * forge_raster_triangles_indexed. */
+static inline void forge_raster_triangles_indexed_packed(ForgeRasterBuffer *buf,
+                                                         const ForgeRasterPackedVertex *vertices,
+                                                         int vertex_count,
+                                                         const Uint32 *indices,
+                                                         int index_count,
+                                                         const ForgeRasterTexture *texture);
+
+/* True if this build and CPU can run the given span kernel.  SCALAR and
+ * AUTO are always supported. */
+static inline bool forge_raster_simd_supported(ForgeRasterSimd simd);
+
+/* Select the span kernel for all later draws (AUTO = the widest
+ * supported).  Returns false, leaving the selection unchanged, if the
+ * kernel is not supported.  The selection is per translation unit and
+ * must not change while another thread is drawing. */
+static inline bool forge_raster_set_simd(ForgeRasterSimd simd);
+
+/* The span kernel draws currently use -- never AUTO. */
+static inline ForgeRasterSimd forge_raster_get_simd(void);
+
 /* Write the framebuffer to a 32-bit BMP file.  BMP stores pixels as BGRA
  * in bottom-up row order; this function handles the conversion from our
  * RGBA top-down format.  Returns true on success. */
@@ -197,7 +432,20 @@ static inline float forge_raster__to_float(Uint8 b)
     return (float)b / 255.0f;
 }
 
-/* The 2D orient function (edge function / signed parallelogram area).
+/* Sub-pixel precision of the rasterizer: vertex positions are snapped to
+ * 1/256 pixel (8 fractional bits, as D3D-class GPUs do) before any edge
+ * test, so coverage is decided in exact integer arithmetic. */
+#define FORGE_RASTER__SUBPIXEL_BITS 8
+#define FORGE_RASTER__SUBPIXEL_ONE  (1 << FORGE_RASTER__SUBPIXEL_BITS)
+#define FORGE_RASTER__SUBPIXEL_HALF (FORGE_RASTER__SUBPIXEL_ONE / 2)
+
+/* Largest vertex coordinate magnitude, in pixels.  2^21 px snaps to 2^29
+ * fixed-point units, so edge deltas fit in 30 bits and every edge function
+ * product fits in a 64-bit integer with room to spare. */
+#define FORGE_RASTER__MAX_COORD 2097152.0f
+
+/* The 2D orient function (edge function / signed parallelogram area),
+ * on fixed-point coordinates.
  *
  * orient2d(a, b, p) = (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x)
  *
@@ -207,26 +455,73 @@ static inline float forge_raster__to_float(Uint8 b)
  *   < 0  if p is to the right of edge a->b (CW side)
  *
  * This is the 2D cross product of vectors (a->b) and (a->p), which equals
- * twice the signed area of the triangle (a, b, p). */
-static inline float forge_raster__orient2d(float ax, float ay,
-                                           float bx, float by,
-                                           float px, float py)
+ * twice the signed area of the triangle (a, b, p).  With integer inputs
+ * the result is exact, so "exactly on the edge" really means it -- the
+ * fill rule depends on that. */
+static inline int64_t forge_raster__orient2d(int ax, int ay, int bx, int by,
+                                             int px, int py)
 {
-    return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+    return (int64_t)(bx - ax) * (int64_t)(py - ay) -
+           (int64_t)(by - ay) * (int64_t)(px - ax);
 }
 
-/* Absolute value of a float (avoids <math.h> dependency) */
-static inline float forge_raster__fabsf(float x)
+/* Returns false for NaN, Infinity, and magnitudes beyond
+ * FORGE_RASTER__MAX_COORD.  NaN fails both comparisons (IEEE 754), so this
+ * catches all non-finite values without requiring <math.h>. */
+static inline bool forge_raster__is_safe_coord(float x)
 {
-    return x < 0.0f ? -x : x;
+    return x >= -FORGE_RASTER__MAX_COORD && x <= FORGE_RASTER__MAX_COORD;
 }
 
-/* Returns false for NaN, Infinity, and extremely large magnitudes.
- * NaN fails both comparisons (IEEE 754), so this catches all non-finite
- * values without requiring <math.h>. */
-static inline bool forge_raster__is_safe_coord(float x)
+/* Snap a pixel coordinate to the sub-pixel grid (round to nearest).  The
+ * caller has checked forge_raster__is_safe_coord. */
+static inline int forge_raster__to_fixed(float x)
+{
+    float s = x * (float)FORGE_RASTER__SUBPIXEL_ONE;
+    return (int)(s < 0.0f ? s - 0.5f : s + 0.5f);
+}
+
+/* floor(v / FORGE_RASTER__SUBPIXEL_ONE) for any sign of v */
+static inline int forge_raster__fixed_floor(int v)
+{
+    return v >= 0 ? v >> FORGE_RASTER__SUBPIXEL_BITS
+                  : -((-v + FORGE_RASTER__SUBPIXEL_ONE - 1) >>
+                      FORGE_RASTER__SUBPIXEL_BITS);
+}
+
+/* ── Texture Sampling ────────────────────────────────────────────────────── */
+
+static inline float forge_raster_sample_sdf(const ForgeRasterTexture *texture,
+                                            float u, float v)
 {
-    return x >= -1e7f && x <= 1e7f;
+    if (!texture || !texture->pixels || texture->width <= 0 ||
+        texture->height <= 0 || !(texture->sdf_screen_range > 0.0f)) {
+        return 0.0f;
+    }
+
+    /* Continuous texel coordinates relative to texel centers */
+    float fx = forge_raster__clampf(u, 0.0f, 1.0f) * (float)texture->width  - 0.5f;
+    float fy = forge_raster__clampf(v, 0.0f, 1.0f) * (float)texture->height - 0.5f;
+    fx = forge_raster__clampf(fx, 0.0f, (float)(texture->width  - 1));
+    fy = forge_raster__clampf(fy, 0.0f, (float)(texture->height - 1));
+
+    int x0 = (int)fx;
+    int y0 = (int)fy;
+    int x1 = x0 + 1 < texture->width  ? x0 + 1 : x0;
+    int y1 = y0 + 1 < texture->height ? y0 + 1 : y0;
+    float tx = fx - (float)x0;
+    float ty = fy - (float)y0;
+
+    const Uint8 *row0 = texture->pixels + (size_t)y0 * (size_t)texture->width;
+    const Uint8 *row1 = texture->pixels + (size_t)y1 * (size_t)texture->width;
+    float top = forge_raster__to_float(row0[x0]) * (1.0f - tx) +
+                forge_raster__to_float(row0[x1]) * tx;
+    float bot = forge_raster__to_float(row1[x0]) * (1.0f - tx) +
+                forge_raster__to_float(row1[x1]) * tx;
+    float d = top * (1.0f - ty) + bot * ty;
+
+    return forge_raster__clampf((d - 0.5f) * texture->sdf_screen_range + 0.5f,
+                                0.0f, 1.0f);
 }
 
 /* ── Buffer Operations ───────────────────────────────────────────────────── */
@@ -294,109 +589,94 @@ static inline void forge_raster_clear(ForgeRasterBuffer *buf,
     }
 }
 
-/* ── Triangle Rasterization ──────────────────────────────────────────────── */
+/* Intersect the scissor span [pos, pos + len) with [0, limit) and store
+ * it as inclusive bounds.  Written so pos + len cannot overflow.  Returns
+ * false if the intersection is empty. */
+static inline bool forge_raster__scissor_span(int pos, int len, int limit,
+                                              int *lo, int *hi)
+{
+    if (len <= 0 || pos >= limit) return false;
+    int end = (pos >= 0 && len > limit - pos) ? limit : pos + len;
+    if (end > limit) end = limit;
+    *lo = pos < 0 ? 0 : pos;
+    *hi = end - 1;
+    return *lo <= *hi;
+}
 
-static inline void forge_raster_triangle(ForgeRasterBuffer *buf,
-                                         const ForgeRasterVertex *v0,
-                                         const ForgeRasterVertex *v1,
-                                         const ForgeRasterVertex *v2,
-                                         const ForgeRasterTexture *texture)
+static inline void forge_raster_clear_rect(ForgeRasterBuffer *buf,
+                                           int x, int y, int w, int h,
+                                           float r, float g, float b, float a)
 {
-    if (!buf || !buf->pixels || !v0 || !v1 || !v2) return;
+    if (!buf || !buf->pixels) return;
 
-    /* Reject vertices with non-finite coordinates (NaN, Infinity).
-     * Casting such values to int is undefined behavior in C99. */
-    if (!forge_raster__is_safe_coord(v0->x) ||
-        !forge_raster__is_safe_coord(v0->y) ||
-        !forge_raster__is_safe_coord(v1->x) ||
-        !forge_raster__is_safe_coord(v1->y) ||
-        !forge_raster__is_safe_coord(v2->x) ||
-        !forge_raster__is_safe_coord(v2->y)) {
-        return;
-    }
+    int x0, x1, y0, y1;
+    if (!forge_raster__scissor_span(x, w, buf->width, &x0, &x1)) return;
+    if (!forge_raster__scissor_span(y, h, buf->height, &y0, &y1)) return;
 
-    /* Compute the signed area of the triangle (twice the signed area).
-     * Positive for CCW winding, negative for CW, zero for degenerate. */
-    float area = forge_raster__orient2d(v0->x, v0->y,
-                                        v1->x, v1->y,
-                                        v2->x, v2->y);
-
-    /* Skip degenerate or near-degenerate triangles.  An exact == 0 test
-     * misses nearly-collinear vertices where 1/area produces extreme
-     * barycentric values.  The negated form handles NaN (NaN >= x is
-     * always false, so the check triggers). */
-    if (!(forge_raster__fabsf(area) >= 1e-6f)) return;
-
-    /* Compute bounding box of the triangle in pixel coordinates */
-    float fmin_x = forge_raster__min3f(v0->x, v1->x, v2->x);
-    float fmin_y = forge_raster__min3f(v0->y, v1->y, v2->y);
-    float fmax_x = forge_raster__max3f(v0->x, v1->x, v2->x);
-    float fmax_y = forge_raster__max3f(v0->y, v1->y, v2->y);
-
-    /* Convert to integer pixel coordinates and clamp to framebuffer.
-     * Truncation toward zero is correct here for positive coordinates
-     * (which pixel positions always are after framebuffer clamping). */
-    int min_x = forge_raster__clamp_int((int)fmin_x, 0, buf->width - 1);
-    int min_y = forge_raster__clamp_int((int)fmin_y, 0, buf->height - 1);
-    int max_x = forge_raster__clamp_int((int)fmax_x, 0, buf->width - 1);
-    int max_y = forge_raster__clamp_int((int)fmax_y, 0, buf->height - 1);
+    Uint8 rb = forge_raster__to_byte(r);
+    Uint8 gb = forge_raster__to_byte(g);
+    Uint8 bb = forge_raster__to_byte(b);
+    Uint8 ab = forge_raster__to_byte(a);
 
-    /* Precompute 1/area for barycentric normalization */
-    float inv_area = 1.0f / area;
-
-    /* Rasterize: test each pixel center in the bounding box */
-    for (int y = min_y; y <= max_y; y++) {
-        for (int x = min_x; x <= max_x; x++) {
-            /* Sample at the pixel center (x + 0.5, y + 0.5) rather than
-             * the corner — this is the same convention GPUs use and avoids
-             * off-by-half-pixel artifacts at triangle edges. */
-            float px = (float)x + 0.5f;
-            float py = (float)y + 0.5f;
-
-            /* Compute the three edge functions.  Each edge function gives
-             * the signed area of the sub-triangle formed by the opposite
-             * vertex and the edge.  The naming maps each weight to the
-             * vertex it "belongs to":
-             *   w0 = orient2d(v1, v2, p) -> weight for v0
-             *   w1 = orient2d(v2, v0, p) -> weight for v1
-             *   w2 = orient2d(v0, v1, p) -> weight for v2 */
-            float w0 = forge_raster__orient2d(v1->x, v1->y,
-                                              v2->x, v2->y, px, py);
-            float w1 = forge_raster__orient2d(v2->x, v2->y,
-                                              v0->x, v0->y, px, py);
-            float w2 = forge_raster__orient2d(v0->x, v0->y,
-                                              v1->x, v1->y, px, py);
-
-            /* Inside test: the pixel is inside if all three edge functions
-             * have the same sign.  This works for both CCW (all >= 0) and
-             * CW (all <= 0) winding orders. */
-            bool inside = (w0 >= 0.0f && w1 >= 0.0f && w2 >= 0.0f) ||
-                          (w0 <= 0.0f && w1 <= 0.0f && w2 <= 0.0f);
-            if (!inside) continue;
-
-            /* Normalize to barycentric coordinates.  Because w0+w1+w2 = area,
-             * dividing by area gives weights that sum to 1.0.  These weights
-             * tell us "how much" of each vertex influences this pixel. */
-            float b0 = w0 * inv_area;
-            float b1 = w1 * inv_area;
-            float b2 = w2 * inv_area;
-
-            /* Interpolate vertex colors using barycentric weights */
-            float src_r = b0 * v0->r + b1 * v1->r + b2 * v2->r;
-            float src_g = b0 * v0->g + b1 * v1->g + b2 * v2->g;
-            float src_b = b0 * v0->b + b1 * v1->b + b2 * v2->b;
-            float src_a = b0 * v0->a + b1 * v1->a + b2 * v2->a;
-
-            /* Optional texture sampling: interpolate UVs and sample the
-             * grayscale texture.  The texel value multiplies all four color
-             * channels — this is the Dear ImGui rendering model where the
-             * font atlas provides alpha coverage and the vertex color
-             * provides the RGB tint. */
-            if (texture && texture->pixels &&
-                texture->width > 0 && texture->height > 0) {
-                float tu = b0 * v0->u + b1 * v1->u + b2 * v2->u;
-                float tv = b0 * v0->v + b1 * v1->v + b2 * v2->v;
+    for (int py = y0; py <= y1; py++) {
+        Uint8 *row = buf->pixels + (size_t)py * (size_t)buf->stride;
+        for (int px = x0; px <= x1; px++) {
+            row[px * FORGE_RASTER_BPP + 0] = rb;
+            row[px * FORGE_RASTER_BPP + 1] = gb;
+            row[px * FORGE_RASTER_BPP + 2] = bb;
+            row[px * FORGE_RASTER_BPP + 3] = ab;
+        }
+    }
+}
 
+/* ── Span Kernels ────────────────────────────────────────────────────────── */
+
+/* One horizontal run of covered pixels.  Each attribute is linear along
+ * the run: pixel k (from 0) gets start + (offset + k) * step.  The start
+ * values belong to a fixed column of the triangle and offset is the run's
+ * distance from it, so a pixel's color does not depend on where the run
+ * was clipped (by a tile, say).  texture is NULL for
+ * untextured triangles and never an SDF texture -- those always take the
+ * scalar kernel, since bilinear distance sampling does not vectorize
+ * well. */
+typedef struct ForgeRaster__Span {
+    float r, g, b, a, u, v;        /* values at the first pixel */
+    float dr, dg, db, da, du, dv;  /* change per pixel to the right */
+    int offset;                    /* first pixel's distance from start */
+    const ForgeRasterTexture *texture;
+} ForgeRaster__Span;
+
+/* Pixels [first, count) of a span, one at a time.  The reference kernel,
+ * and the tail loop of the SIMD kernels. */
+static inline void forge_raster__span_scalar(Uint8 *dst, int first, int count,
+                                             const ForgeRaster__Span *s)
+{
+    const ForgeRasterTexture *texture = s->texture;
+
+    for (int k = first; k < count; k++) {
+        float fk = (float)(s->offset + k);
+
+        /* Interpolated vertex color */
+        float src_r = s->r + fk * s->dr;
+        float src_g = s->g + fk * s->dg;
+        float src_b = s->b + fk * s->db;
+        float src_a = s->a + fk * s->da;
+
+        /* Optional texture sampling: interpolate UVs and sample the
+         * grayscale texture.  The texel value multiplies all four color
+         * channels — this is the Dear ImGui rendering model where the
+         * font atlas provides alpha coverage and the vertex color
+         * provides the RGB tint. */
+        if (texture) {
+            float tu = s->u + fk * s->du;
+            float tv = s->v + fk * s->dv;
+
+            /* SDF textures reconstruct coverage from distance; plain
+             * textures use the texel value directly */
+            float texel;
+            if (texture->sdf_screen_range > 0.0f) {
+                texel = forge_raster_sample_sdf(texture, tu, tv);
+            } else {
                 /* Clamp UVs to valid range */
                 tu = forge_raster__clampf(tu, 0.0f, 1.0f);
                 tv = forge_raster__clampf(tv, 0.0f, 1.0f);
@@ -409,42 +689,756 @@ static inline void forge_raster_triangle(ForgeRasterBuffer *buf,
 
                 size_t texel_idx = (size_t)ty * (size_t)texture->width +
                                    (size_t)tx;
-                float texel = forge_raster__to_float(
-                    texture->pixels[texel_idx]);
-
-                /* Multiply all channels by the texel value */
-                src_r *= texel;
-                src_g *= texel;
-                src_b *= texel;
-                src_a *= texel;
+                texel = forge_raster__to_float(texture->pixels[texel_idx]);
             }
 
-            /* Alpha blend (source-over compositing).
-             *
-             * The source-over formula composites a partially transparent
-             * source color onto the existing destination:
-             *   out_rgb = src_rgb * src_a + dst_rgb * (1 - src_a)
-             *   out_a   = src_a + dst_a * (1 - src_a)
-             *
-             * When src_a = 1.0 (fully opaque), the source completely
-             * replaces the destination.  When src_a = 0.0 (fully
-             * transparent), the destination is unchanged. */
-            Uint8 *pixel = buf->pixels +
-                           (size_t)y * (size_t)buf->stride +
-                           (size_t)x * FORGE_RASTER_BPP;
-
-            float dst_r = forge_raster__to_float(pixel[0]);
-            float dst_g = forge_raster__to_float(pixel[1]);
-            float dst_b = forge_raster__to_float(pixel[2]);
-            float dst_a = forge_raster__to_float(pixel[3]);
-
-            float inv_a = 1.0f - src_a;
-            pixel[0] = forge_raster__to_byte(src_r * src_a + dst_r * inv_a);
-            pixel[1] = forge_raster__to_byte(src_g * src_a + dst_g * inv_a);
-            pixel[2] = forge_raster__to_byte(src_b * src_a + dst_b * inv_a);
-            pixel[3] = forge_raster__to_byte(src_a + dst_a * inv_a);
+            /* Multiply all channels by the texel value */
+            src_r *= texel;
+            src_g *= texel;
+            src_b *= texel;
+            src_a *= texel;
+        }
+
+        /* Alpha blend (source-over compositing).
+         *
+         * The source-over formula composites a partially transparent
+         * source color onto the existing destination:
+         *   out_rgb = src_rgb * src_a + dst_rgb * (1 - src_a)
+         *   out_a   = src_a + dst_a * (1 - src_a)
+         *
+         * When src_a = 1.0 (fully opaque), the source completely
+         * replaces the destination.  When src_a = 0.0 (fully
+         * transparent), the destination is unchanged. */
+        Uint8 *pixel = dst + (size_t)k * FORGE_RASTER_BPP;
+
+        float dst_r = forge_raster__to_float(pixel[0]);
+        float dst_g = forge_raster__to_float(pixel[1]);
+        float dst_b = forge_raster__to_float(pixel[2]);
+        float dst_a = forge_raster__to_float(pixel[3]);
+
+        float inv_a = 1.0f - src_a;
+        pixel[0] = forge_raster__to_byte(src_r * src_a + dst_r * inv_a);
+        pixel[1] = forge_raster__to_byte(src_g * src_a + dst_g * inv_a);
+        pixel[2] = forge_raster__to_byte(src_b * src_a + dst_b * inv_a);
+        pixel[3] = forge_raster__to_byte(src_a + dst_a * inv_a);
+    }
+}
+
+/* The SIMD kernels follow the scalar one step for step, with each lane a
+ * pixel.  A pixel's four bytes load as one little-endian 32-bit lane
+ * (R | G << 8 | B << 16 | A << 24), so channels split apart with shifts
+ * and masks and go back together with shifts and ORs.  Texels are fetched
+ * per lane: the texture is one byte per texel and has no padding, so a
+ * 32-bit gather could read past its end. */
+
+#if defined(FORGE_RASTER__SIMD_SSE2)
+
+/* to_byte for four lanes: clamp to [0, 1], scale, round, truncate */
+static inline __m128i forge_raster__to_byte_sse2(__m128 x)
+{
+    x = _mm_min_ps(_mm_max_ps(x, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(255.0f)),
+                                       _mm_set1_ps(0.5f)));
+}
+
+static inline void forge_raster__span_sse2(Uint8 *dst, int count,
+                                           const ForgeRaster__Span *s)
+{
+    const ForgeRasterTexture *tex = s->texture;
+    const __m128  lane   = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128  one    = _mm_set1_ps(1.0f);
+    const __m128  c255   = _mm_set1_ps(255.0f);
+    const __m128i mask   = _mm_set1_epi32(0xFF);
+
+    int k = 0;
+    for (; k + 4 <= count; k += 4) {
+        __m128 fk = _mm_add_ps(_mm_set1_ps((float)(s->offset + k)), lane);
+        __m128 r = _mm_add_ps(_mm_set1_ps(s->r), _mm_mul_ps(fk, _mm_set1_ps(s->dr)));
+        __m128 g = _mm_add_ps(_mm_set1_ps(s->g), _mm_mul_ps(fk, _mm_set1_ps(s->dg)));
+        __m128 b = _mm_add_ps(_mm_set1_ps(s->b), _mm_mul_ps(fk, _mm_set1_ps(s->db)));
+        __m128 a = _mm_add_ps(_mm_set1_ps(s->a), _mm_mul_ps(fk, _mm_set1_ps(s->da)));
+
+        if (tex) {
+            __m128 u = _mm_add_ps(_mm_set1_ps(s->u), _mm_mul_ps(fk, _mm_set1_ps(s->du)));
+            __m128 v = _mm_add_ps(_mm_set1_ps(s->v), _mm_mul_ps(fk, _mm_set1_ps(s->dv)));
+            u = _mm_min_ps(_mm_max_ps(u, _mm_setzero_ps()), one);
+            v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), one);
+            int tx[4], ty[4];
+            _mm_storeu_si128((__m128i *)tx, _mm_cvttps_epi32(_mm_add_ps(
+                _mm_mul_ps(u, _mm_set1_ps((float)(tex->width - 1))),
+                _mm_set1_ps(0.5f))));
+            _mm_storeu_si128((__m128i *)ty, _mm_cvttps_epi32(_mm_add_ps(
+                _mm_mul_ps(v, _mm_set1_ps((float)(tex->height - 1))),
+                _mm_set1_ps(0.5f))));
+            const Uint8 *tp = tex->pixels;
+            size_t tw = (size_t)tex->width;
+            __m128 t = _mm_div_ps(_mm_set_ps(
+                (float)tp[(size_t)ty[3] * tw + (size_t)tx[3]],
+                (float)tp[(size_t)ty[2] * tw + (size_t)tx[2]],
+                (float)tp[(size_t)ty[1] * tw + (size_t)tx[1]],
+                (float)tp[(size_t)ty[0] * tw + (size_t)tx[0]]), c255);
+            r = _mm_mul_ps(r, t);
+            g = _mm_mul_ps(g, t);
+            b = _mm_mul_ps(b, t);
+            a = _mm_mul_ps(a, t);
+        }
+
+        Uint8 *p = dst + (size_t)k * FORGE_RASTER_BPP;
+        __m128i d = _mm_loadu_si128((const __m128i *)p);
+        __m128 dr = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(d, mask)), c255);
+        __m128 dg = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(
+                        _mm_srli_epi32(d, 8), mask)), c255);
+        __m128 db = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(
+                        _mm_srli_epi32(d, 16), mask)), c255);
+        __m128 da = _mm_div_ps(_mm_cvtepi32_ps(_mm_srli_epi32(d, 24)), c255);
+
+        __m128 inv_a = _mm_sub_ps(one, a);
+        __m128i out_r = forge_raster__to_byte_sse2(
+            _mm_add_ps(_mm_mul_ps(r, a), _mm_mul_ps(dr, inv_a)));
+        __m128i out_g = forge_raster__to_byte_sse2(
+            _mm_add_ps(_mm_mul_ps(g, a), _mm_mul_ps(dg, inv_a)));
+        __m128i out_b = forge_raster__to_byte_sse2(
+            _mm_add_ps(_mm_mul_ps(b, a), _mm_mul_ps(db, inv_a)));
+        __m128i out_a = forge_raster__to_byte_sse2(
+            _mm_add_ps(a, _mm_mul_ps(da, inv_a)));
+        _mm_storeu_si128((__m128i *)p, _mm_or_si128(
+            _mm_or_si128(out_r, _mm_slli_epi32(out_g, 8)),
+            _mm_or_si128(_mm_slli_epi32(out_b, 16), _mm_slli_epi32(out_a, 24))));
+    }
+    forge_raster__span_scalar(dst, k, count, s);
+}
+
+#endif /* FORGE_RASTER__SIMD_SSE2 */
+
+#if defined(FORGE_RASTER__SIMD_AVX2)
+
+/* to_byte for eight lanes */
+FORGE_RASTER__TARGET_AVX2
+static inline __m256i forge_raster__to_byte_avx2(__m256 x)
+{
+    x = _mm256_min_ps(_mm256_max_ps(x, _mm256_setzero_ps()),
+                      _mm256_set1_ps(1.0f));
+    return _mm256_cvttps_epi32(_mm256_add_ps(
+        _mm256_mul_ps(x, _mm256_set1_ps(255.0f)), _mm256_set1_ps(0.5f)));
+}
+
+FORGE_RASTER__TARGET_AVX2
+static inline void forge_raster__span_avx2(Uint8 *dst, int count,
+                                           const ForgeRaster__Span *s)
+{
+    const ForgeRasterTexture *tex = s->texture;
+    const __m256  lane   = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f,
+                                         3.0f, 2.0f, 1.0f, 0.0f);
+    const __m256  one    = _mm256_set1_ps(1.0f);
+    const __m256  c255   = _mm256_set1_ps(255.0f);
+    const __m256i mask   = _mm256_set1_epi32(0xFF);
+
+    int k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m256 fk = _mm256_add_ps(_mm256_set1_ps((float)(s->offset + k)),
+                                  lane);
+        __m256 r = _mm256_add_ps(_mm256_set1_ps(s->r), _mm256_mul_ps(fk, _mm256_set1_ps(s->dr)));
+        __m256 g = _mm256_add_ps(_mm256_set1_ps(s->g), _mm256_mul_ps(fk, _mm256_set1_ps(s->dg)));
+        __m256 b = _mm256_add_ps(_mm256_set1_ps(s->b), _mm256_mul_ps(fk, _mm256_set1_ps(s->db)));
+        __m256 a = _mm256_add_ps(_mm256_set1_ps(s->a), _mm256_mul_ps(fk, _mm256_set1_ps(s->da)));
+
+        if (tex) {
+            __m256 u = _mm256_add_ps(_mm256_set1_ps(s->u), _mm256_mul_ps(fk, _mm256_set1_ps(s->du)));
+            __m256 v = _mm256_add_ps(_mm256_set1_ps(s->v), _mm256_mul_ps(fk, _mm256_set1_ps(s->dv)));
+            u = _mm256_min_ps(_mm256_max_ps(u, _mm256_setzero_ps()), one);
+            v = _mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()), one);
+            int tx[8], ty[8];
+            _mm256_storeu_si256((__m256i *)tx, _mm256_cvttps_epi32(_mm256_add_ps(
+                _mm256_mul_ps(u, _mm256_set1_ps((float)(tex->width - 1))),
+                _mm256_set1_ps(0.5f))));
+            _mm256_storeu_si256((__m256i *)ty, _mm256_cvttps_epi32(_mm256_add_ps(
+                _mm256_mul_ps(v, _mm256_set1_ps((float)(tex->height - 1))),
+                _mm256_set1_ps(0.5f))));
+            float texel[8];
+            for (int i = 0; i < 8; i++) {
+                texel[i] = (float)tex->pixels[(size_t)ty[i] * (size_t)tex->width +
+                                              (size_t)tx[i]];
+            }
+            __m256 t = _mm256_div_ps(_mm256_loadu_ps(texel), c255);
+            r = _mm256_mul_ps(r, t);
+            g = _mm256_mul_ps(g, t);
+            b = _mm256_mul_ps(b, t);
+            a = _mm256_mul_ps(a, t);
         }
+
+        Uint8 *p = dst + (size_t)k * FORGE_RASTER_BPP;
+        __m256i d = _mm256_loadu_si256((const __m256i *)p);
+        __m256 dr = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(d, mask)), c255);
+        __m256 dg = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(
+                        _mm256_srli_epi32(d, 8), mask)), c255);
+        __m256 db = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(
+                        _mm256_srli_epi32(d, 16), mask)), c255);
+        __m256 da = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(d, 24)), c255);
+
+        __m256 inv_a = _mm256_sub_ps(one, a);
+        __m256i out_r = forge_raster__to_byte_avx2(
+            _mm256_add_ps(_mm256_mul_ps(r, a), _mm256_mul_ps(dr, inv_a)));
+        __m256i out_g = forge_raster__to_byte_avx2(
+            _mm256_add_ps(_mm256_mul_ps(g, a), _mm256_mul_ps(dg, inv_a)));
+        __m256i out_b = forge_raster__to_byte_avx2(
+            _mm256_add_ps(_mm256_mul_ps(b, a), _mm256_mul_ps(db, inv_a)));
+        __m256i out_a = forge_raster__to_byte_avx2(
+            _mm256_add_ps(a, _mm256_mul_ps(da, inv_a)));
+        _mm256_storeu_si256((__m256i *)p, _mm256_or_si256(
+            _mm256_or_si256(out_r, _mm256_slli_epi32(out_g, 8)),
+            _mm256_or_si256(_mm256_slli_epi32(out_b, 16),
+                            _mm256_slli_epi32(out_a, 24))));
     }
+    forge_raster__span_scalar(dst, k, count, s);
+}
+
+#endif /* FORGE_RASTER__SIMD_AVX2 */
+
+#if defined(FORGE_RASTER__SIMD_NEON)
+
+/* to_byte for four lanes (vcvtq_u32_f32 truncates, like the cast) */
+static inline uint32x4_t forge_raster__to_byte_neon(float32x4_t x)
+{
+    x = vminq_f32(vmaxq_f32(x, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+    return vcvtq_u32_f32(vaddq_f32(vmulq_f32(x, vdupq_n_f32(255.0f)),
+                                   vdupq_n_f32(0.5f)));
+}
+
+static inline void forge_raster__span_neon(Uint8 *dst, int count,
+                                           const ForgeRaster__Span *s)
+{
+    static const float lane_init[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+    const ForgeRasterTexture *tex = s->texture;
+    const float32x4_t lane   = vld1q_f32(lane_init);
+    const float32x4_t one    = vdupq_n_f32(1.0f);
+    const float32x4_t c255   = vdupq_n_f32(255.0f);
+    const uint32x4_t  mask   = vdupq_n_u32(0xFF);
+
+    int k = 0;
+    for (; k + 4 <= count; k += 4) {
+        float32x4_t fk = vaddq_f32(vdupq_n_f32((float)(s->offset + k)), lane);
+        float32x4_t r = vaddq_f32(vdupq_n_f32(s->r), vmulq_f32(fk, vdupq_n_f32(s->dr)));
+        float32x4_t g = vaddq_f32(vdupq_n_f32(s->g), vmulq_f32(fk, vdupq_n_f32(s->dg)));
+        float32x4_t b = vaddq_f32(vdupq_n_f32(s->b), vmulq_f32(fk, vdupq_n_f32(s->db)));
+        float32x4_t a = vaddq_f32(vdupq_n_f32(s->a), vmulq_f32(fk, vdupq_n_f32(s->da)));
+
+        if (tex) {
+            float32x4_t u = vaddq_f32(vdupq_n_f32(s->u), vmulq_f32(fk, vdupq_n_f32(s->du)));
+            float32x4_t v = vaddq_f32(vdupq_n_f32(s->v), vmulq_f32(fk, vdupq_n_f32(s->dv)));
+            u = vminq_f32(vmaxq_f32(u, vdupq_n_f32(0.0f)), one);
+            v = vminq_f32(vmaxq_f32(v, vdupq_n_f32(0.0f)), one);
+            uint32_t tx[4], ty[4];
+            vst1q_u32(tx, vcvtq_u32_f32(vaddq_f32(
+                vmulq_f32(u, vdupq_n_f32((float)(tex->width - 1))),
+                vdupq_n_f32(0.5f))));
+            vst1q_u32(ty, vcvtq_u32_f32(vaddq_f32(
+                vmulq_f32(v, vdupq_n_f32((float)(tex->height - 1))),
+                vdupq_n_f32(0.5f))));
+            float texel[4];
+            for (int i = 0; i < 4; i++) {
+                texel[i] = (float)tex->pixels[(size_t)ty[i] * (size_t)tex->width +
+                                              (size_t)tx[i]];
+            }
+            float32x4_t t = vdivq_f32(vld1q_f32(texel), c255);
+            r = vmulq_f32(r, t);
+            g = vmulq_f32(g, t);
+            b = vmulq_f32(b, t);
+            a = vmulq_f32(a, t);
+        }
+
+        Uint8 *p = dst + (size_t)k * FORGE_RASTER_BPP;
+        uint32x4_t d = vld1q_u32((const uint32_t *)p);
+        float32x4_t dr = vdivq_f32(vcvtq_f32_u32(vandq_u32(d, mask)), c255);
+        float32x4_t dg = vdivq_f32(vcvtq_f32_u32(vandq_u32(vshrq_n_u32(d, 8), mask)), c255);
+        float32x4_t db = vdivq_f32(vcvtq_f32_u32(vandq_u32(vshrq_n_u32(d, 16), mask)), c255);
+        float32x4_t da = vdivq_f32(vcvtq_f32_u32(vshrq_n_u32(d, 24)), c255);
+
+        float32x4_t inv_a = vsubq_f32(one, a);
+        uint32x4_t out_r = forge_raster__to_byte_neon(
+            vaddq_f32(vmulq_f32(r, a), vmulq_f32(dr, inv_a)));
+        uint32x4_t out_g = forge_raster__to_byte_neon(
+            vaddq_f32(vmulq_f32(g, a), vmulq_f32(dg, inv_a)));
+        uint32x4_t out_b = forge_raster__to_byte_neon(
+            vaddq_f32(vmulq_f32(b, a), vmulq_f32(db, inv_a)));
+        uint32x4_t out_a = forge_raster__to_byte_neon(
+            vaddq_f32(a, vmulq_f32(da, inv_a)));
+        vst1q_u32((uint32_t *)p, vorrq_u32(
+            vorrq_u32(out_r, vshlq_n_u32(out_g, 8)),
+            vorrq_u32(vshlq_n_u32(out_b, 16), vshlq_n_u32(out_a, 24))));
+    }
+    forge_raster__span_scalar(dst, k, count, s);
+}
+
+#endif /* FORGE_RASTER__SIMD_NEON */
+
+/* The selected kernel: 0 (AUTO) until first resolved, then a concrete
+ * ForgeRasterSimd value.  Atomic so tile workers can read it while the
+ * first draw resolves it. */
+static SDL_AtomicInt forge_raster__simd_choice;
+
+static inline bool forge_raster_simd_supported(ForgeRasterSimd simd)
+{
+    switch (simd) {
+    case FORGE_RASTER_SIMD_AUTO:
+    case FORGE_RASTER_SIMD_SCALAR:
+        return true;
+#if defined(FORGE_RASTER__SIMD_SSE2)
+    case FORGE_RASTER_SIMD_SSE2:
+        return true;
+#endif
+#if defined(FORGE_RASTER__SIMD_AVX2)
+    case FORGE_RASTER_SIMD_AVX2:
+        return SDL_HasAVX2();
+#endif
+#if defined(FORGE_RASTER__SIMD_NEON)
+    case FORGE_RASTER_SIMD_NEON:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+/* Widest kernel this build and CPU support */
+static inline ForgeRasterSimd forge_raster__best_simd(void)
+{
+    if (forge_raster_simd_supported(FORGE_RASTER_SIMD_AVX2)) {
+        return FORGE_RASTER_SIMD_AVX2;
+    }
+    if (forge_raster_simd_supported(FORGE_RASTER_SIMD_SSE2)) {
+        return FORGE_RASTER_SIMD_SSE2;
+    }
+    if (forge_raster_simd_supported(FORGE_RASTER_SIMD_NEON)) {
+        return FORGE_RASTER_SIMD_NEON;
+    }
+    return FORGE_RASTER_SIMD_SCALAR;
+}
+
+static inline bool forge_raster_set_simd(ForgeRasterSimd simd)
+{
+    if (!forge_raster_simd_supported(simd)) {
+        SDL_Log("forge_raster_set_simd: kernel %d is not supported here",
+                (int)simd);
+        return false;
+    }
+    if (simd == FORGE_RASTER_SIMD_AUTO) simd = forge_raster__best_simd();
+    SDL_SetAtomicInt(&forge_raster__simd_choice, (int)simd);
+    return true;
+}
+
+static inline ForgeRasterSimd forge_raster_get_simd(void)
+{
+    int simd = SDL_GetAtomicInt(&forge_raster__simd_choice);
+    if (simd == FORGE_RASTER_SIMD_AUTO) {
+        simd = (int)forge_raster__best_simd();
+        SDL_SetAtomicInt(&forge_raster__simd_choice, simd);
+    }
+    return (ForgeRasterSimd)simd;
+}
+
+/* Draw count pixels of a span starting at dst with the given kernel */
+static inline void forge_raster__draw_span(ForgeRasterSimd simd, Uint8 *dst,
+                                           int count,
+                                           const ForgeRaster__Span *s)
+{
+    switch (simd) {
+#if defined(FORGE_RASTER__SIMD_SSE2)
+    case FORGE_RASTER_SIMD_SSE2:
+        forge_raster__span_sse2(dst, count, s);
+        return;
+#endif
+#if defined(FORGE_RASTER__SIMD_AVX2)
+    case FORGE_RASTER_SIMD_AVX2:
+        forge_raster__span_avx2(dst, count, s);
+        return;
+#endif
+#if defined(FORGE_RASTER__SIMD_NEON)
+    case FORGE_RASTER_SIMD_NEON:
+        forge_raster__span_neon(dst, count, s);
+        return;
+#endif
+    default:
+        forge_raster__span_scalar(dst, 0, count, s);
+        return;
+    }
+}
+
+/* ── Triangle Rasterization ──────────────────────────────────────────────── */
+
+/* Snap a triangle's vertices to the sub-pixel grid.  Returns false for
+ * vertices with non-finite or out-of-range coordinates, which the
+ * rasterizer rejects. */
+static inline bool forge_raster__snap_triangle(const ForgeRasterVertex *v0,
+                                               const ForgeRasterVertex *v1,
+                                               const ForgeRasterVertex *v2,
+                                               int fx[3], int fy[3])
+{
+    /* Casting NaN, Infinity or huge values to int is undefined behavior
+     * in C99, and larger coordinates would overflow the edge setup */
+    if (!forge_raster__is_safe_coord(v0->x) ||
+        !forge_raster__is_safe_coord(v0->y) ||
+        !forge_raster__is_safe_coord(v1->x) ||
+        !forge_raster__is_safe_coord(v1->y) ||
+        !forge_raster__is_safe_coord(v2->x) ||
+        !forge_raster__is_safe_coord(v2->y)) {
+        return false;
+    }
+    fx[0] = forge_raster__to_fixed(v0->x);
+    fy[0] = forge_raster__to_fixed(v0->y);
+    fx[1] = forge_raster__to_fixed(v1->x);
+    fy[1] = forge_raster__to_fixed(v1->y);
+    fx[2] = forge_raster__to_fixed(v2->x);
+    fy[2] = forge_raster__to_fixed(v2->y);
+    return true;
+}
+
+/* Pixels whose centers fall inside a snapped triangle's bounding box, as
+ * the inclusive range [*min_x, *max_x] x [*min_y, *max_y] intersected
+ * with [sx0, sx1] x [sy0, sy1].  Returns false if no pixel center is
+ * inside.  Tiled drawing bins triangles with the same bounds the
+ * rasterizer scans, so the two can never disagree. */
+static inline bool forge_raster__triangle_pixel_bounds(const int fx[3],
+                                                       const int fy[3],
+                                                       int sx0, int sy0,
+                                                       int sx1, int sy1,
+                                                       int *min_x, int *min_y,
+                                                       int *max_x, int *max_y)
+{
+    int lo_x = fx[0], hi_x = fx[0], lo_y = fy[0], hi_y = fy[0];
+    for (int i = 1; i < 3; i++) {
+        if (fx[i] < lo_x) lo_x = fx[i];
+        if (fx[i] > hi_x) hi_x = fx[i];
+        if (fy[i] < lo_y) lo_y = fy[i];
+        if (fy[i] > hi_y) hi_y = fy[i];
+    }
+
+    /* Pixel x has its center at x * ONE + HALF, so the first center at or
+     * after lo is ceil((lo - HALF) / ONE) and the last at or before hi is
+     * floor((hi - HALF) / ONE) */
+    int x0 = forge_raster__fixed_floor(lo_x - FORGE_RASTER__SUBPIXEL_HALF +
+                                       FORGE_RASTER__SUBPIXEL_ONE - 1);
+    int y0 = forge_raster__fixed_floor(lo_y - FORGE_RASTER__SUBPIXEL_HALF +
+                                       FORGE_RASTER__SUBPIXEL_ONE - 1);
+    int x1 = forge_raster__fixed_floor(hi_x - FORGE_RASTER__SUBPIXEL_HALF);
+    int y1 = forge_raster__fixed_floor(hi_y - FORGE_RASTER__SUBPIXEL_HALF);
+    if (x0 < sx0) x0 = sx0;
+    if (y0 < sy0) y0 = sy0;
+    if (x1 > sx1) x1 = sx1;
+    if (y1 > sy1) y1 = sy1;
+    if (x0 > x1 || y0 > y1) return false;
+
+    *min_x = x0;
+    *min_y = y0;
+    *max_x = x1;
+    *max_y = y1;
+    return true;
+}
+
+/* One edge function, set up for incremental evaluation.  w is its value
+ * at the current pixel center with the fill rule folded in (see
+ * forge_raster__edge_setup), so "w >= 0" is the whole inside test; moving
+ * one pixel right adds step_x and one pixel down adds step_y. */
+typedef struct ForgeRaster__Edge {
+    int64_t w;
+    int64_t step_x;
+    int64_t step_y;
+} ForgeRaster__Edge;
+
+/* Set up the edge a->b of a triangle with positive area, evaluated at the
+ * fixed-point pixel center (px, py).
+ *
+ * Top-left fill rule: a pixel center exactly on an edge belongs to the
+ * triangle only if that edge is a "left" edge (the interior lies to its
+ * right, +x) or a "top" edge (horizontal, with the interior below it, +y
+ * in our top-down framebuffer).  Two triangles sharing an edge see it
+ * with opposite orientation, so exactly one of them claims each pixel on
+ * it -- no gaps and no double blending.  Since w is an exact integer,
+ * "w > 0" equals "w - 1 >= 0", so non-top-left edges are biased by -1 up
+ * front.  The bias is 1 / (2 * area) of a barycentric weight at most --
+ * far below what a color byte can show. */
+static inline void forge_raster__edge_setup(ForgeRaster__Edge *e,
+                                            int ax, int ay, int bx, int by,
+                                            int px, int py)
+{
+    /* orient2d(a, b, p) is linear in p: d/dpx = ay - by, d/dpy = bx - ax */
+    int64_t dx = (int64_t)(ay - by);
+    int64_t dy = (int64_t)(bx - ax);
+    bool top_left = dx > 0 || (dx == 0 && dy > 0);
+
+    e->w      = forge_raster__orient2d(ax, ay, bx, by, px, py) -
+                (top_left ? 0 : 1);
+    e->step_x = dx * FORGE_RASTER__SUBPIXEL_ONE;
+    e->step_y = dy * FORGE_RASTER__SUBPIXEL_ONE;
+}
+
+/* Blocks of FORGE_RASTER__BLOCK_SIZE x FORGE_RASTER__BLOCK_SIZE pixels,
+ * aligned to the framebuffer, are classified before their pixels are
+ * visited.  The classes are ordered so a block's class is the minimum of
+ * its three edges' classes. */
+#define FORGE_RASTER__BLOCK_SIZE    8
+#define FORGE_RASTER__BLOCK_OUTSIDE 0  /* no pixel center inside */
+#define FORGE_RASTER__BLOCK_PARTIAL 1  /* test each pixel */
+#define FORGE_RASTER__BLOCK_INSIDE  2  /* every pixel center inside */
+
+/* Classify one edge over a block of pixel centers, given its value w at
+ * the block's first center and the block's last column and row relative
+ * to that center.  The edge function is linear, so its smallest and
+ * largest values over the block are at two of the corners. */
+static inline int forge_raster__edge_block_class(const ForgeRaster__Edge *e,
+                                                 int64_t w,
+                                                 int last_x, int last_y)
+{
+    int64_t ex = (int64_t)last_x * e->step_x;
+    int64_t ey = (int64_t)last_y * e->step_y;
+    int64_t lo = w + (ex < 0 ? ex : 0) + (ey < 0 ? ey : 0);
+    int64_t hi = w + (ex > 0 ? ex : 0) + (ey > 0 ? ey : 0);
+    if (hi < 0) return FORGE_RASTER__BLOCK_OUTSIDE;
+    if (lo >= 0) return FORGE_RASTER__BLOCK_INSIDE;
+    return FORGE_RASTER__BLOCK_PARTIAL;
+}
+
+/* Blocks per strip, enough for a FORGE_RASTER_MAX_DIM-wide bounding box */
+#define FORGE_RASTER__MAX_BLOCKS \
+    (FORGE_RASTER_MAX_DIM / FORGE_RASTER__BLOCK_SIZE + 1)
+
+/* Classify the blocks of one strip of rows (last_row rows below the
+ * edges' current row), covering columns [min_x, max_x].  The edges hold
+ * their values at (min_x, first row of the strip). */
+static inline void forge_raster__classify_strip(Uint8 *block_class,
+                                                int min_x, int max_x,
+                                                int last_row,
+                                                const ForgeRaster__Edge *e0,
+                                                const ForgeRaster__Edge *e1,
+                                                const ForgeRaster__Edge *e2)
+{
+    int first_block = min_x / FORGE_RASTER__BLOCK_SIZE;
+    int block_count = max_x / FORGE_RASTER__BLOCK_SIZE - first_block + 1;
+    for (int b = 0; b < block_count; b++) {
+        int bx0 = (first_block + b) * FORGE_RASTER__BLOCK_SIZE;
+        int bx1 = bx0 + FORGE_RASTER__BLOCK_SIZE - 1;
+        if (bx0 < min_x) bx0 = min_x;
+        if (bx1 > max_x) bx1 = max_x;
+        int64_t off = (int64_t)(bx0 - min_x);
+        int c0 = forge_raster__edge_block_class(
+            e0, e0->w + off * e0->step_x, bx1 - bx0, last_row);
+        int c1 = forge_raster__edge_block_class(
+            e1, e1->w + off * e1->step_x, bx1 - bx0, last_row);
+        int c2 = forge_raster__edge_block_class(
+            e2, e2->w + off * e2->step_x, bx1 - bx0, last_row);
+        int c = c0 < c1 ? c0 : c1;
+        block_class[b] = (Uint8)(c < c2 ? c : c2);
+    }
+}
+
+/* Find the covered pixels [*run_start, *run_end) of the edges' current
+ * row, using its strip's block classes: outside blocks are skipped with
+ * one comparison and inside blocks taken whole, and only partial blocks
+ * -- the ones an edge crosses -- step the edge functions pixel by pixel.
+ * A triangle is convex, so the covered pixels form one run.  Returns
+ * false if the row has none. */
+static inline bool forge_raster__row_run(const Uint8 *block_class,
+                                         int min_x, int max_x,
+                                         const ForgeRaster__Edge *e0,
+                                         const ForgeRaster__Edge *e1,
+                                         const ForgeRaster__Edge *e2,
+                                         int *run_start, int *run_end)
+{
+    int first_block = min_x / FORGE_RASTER__BLOCK_SIZE;
+    int block_count = max_x / FORGE_RASTER__BLOCK_SIZE - first_block + 1;
+    int start = -1, end = -1;
+
+    for (int b = 0; b < block_count; b++) {
+        int bx0 = (first_block + b) * FORGE_RASTER__BLOCK_SIZE;
+        int bx1 = bx0 + FORGE_RASTER__BLOCK_SIZE - 1;
+        if (bx0 < min_x) bx0 = min_x;
+        if (bx1 > max_x) bx1 = max_x;
+
+        if (block_class[b] == FORGE_RASTER__BLOCK_OUTSIDE) {
+            if (start >= 0) break;
+            continue;
+        }
+        if (block_class[b] == FORGE_RASTER__BLOCK_INSIDE) {
+            if (start < 0) start = bx0;
+            end = bx1 + 1;
+            continue;
+        }
+
+        /* Partial block: one add per edge per pixel.  Inside test with
+         * the top-left rule: every edge value must be non-negative, i.e.
+         * no sign bit in their OR. */
+        int64_t off = (int64_t)(bx0 - min_x);
+        int64_t w0 = e0->w + off * e0->step_x;
+        int64_t w1 = e1->w + off * e1->step_x;
+        int64_t w2 = e2->w + off * e2->step_x;
+        bool done = false;
+        for (int x = bx0; x <= bx1; x++) {
+            if ((w0 | w1 | w2) >= 0) {
+                if (start < 0) start = x;
+                end = x + 1;
+            } else if (start >= 0) {
+                done = true;
+                break;
+            }
+            w0 += e0->step_x;
+            w1 += e1->step_x;
+            w2 += e2->step_x;
+        }
+        if (done) break;
+    }
+
+    *run_start = start;
+    *run_end   = end;
+    return start >= 0;
+}
+
+/* Rasterize one triangle, touching only pixels in the inclusive range
+ * [sx0, sx1] x [sy0, sy1].  The caller keeps that range inside the
+ * framebuffer; forge_raster_triangle passes the whole buffer and the
+ * scissored draw passes its scissor. */
+static inline void forge_raster__triangle_bounded(ForgeRasterBuffer *buf,
+                                                  const ForgeRasterVertex *v0,
+                                                  const ForgeRasterVertex *v1,
+                                                  const ForgeRasterVertex *v2,
+                                                  const ForgeRasterTexture *texture,
+                                                  int sx0, int sy0,
+                                                  int sx1, int sy1)
+{
+    int fx[3], fy[3];
+    if (!forge_raster__snap_triangle(v0, v1, v2, fx, fy)) return;
+
+    /* Compute the signed area of the triangle (twice the signed area).
+     * Positive for CCW winding, negative for CW, zero for degenerate --
+     * exact, since the snapped coordinates are integers. */
+    int64_t area = forge_raster__orient2d(fx[0], fy[0], fx[1], fy[1],
+                                          fx[2], fy[2]);
+    if (area == 0) return;
+
+    /* Make the winding positive by swapping v1 and v2.  The fill rule
+     * needs to know which side of each edge is inside, and the weights
+     * below stay attached to the vertices they belong to. */
+    if (area < 0) {
+        const ForgeRasterVertex *tv = v1;
+        v1 = v2;
+        v2 = tv;
+        int t = fx[1]; fx[1] = fx[2]; fx[2] = t;
+        t = fy[1]; fy[1] = fy[2]; fy[2] = t;
+        area = -area;
+    }
+
+    int min_x, min_y, max_x, max_y;
+    if (!forge_raster__triangle_pixel_bounds(fx, fy, sx0, sy0, sx1, sy1,
+                                             &min_x, &min_y,
+                                             &max_x, &max_y)) {
+        return;
+    }
+
+    /* Set up the three edge functions at the first pixel center.  Sample
+     * at the pixel center (x + 0.5, y + 0.5) rather than the corner --
+     * this is the same convention GPUs use and avoids off-by-half-pixel
+     * artifacts at triangle edges.  Each edge function gives the signed
+     * area of the sub-triangle formed by the opposite vertex and the
+     * edge, so the naming maps each weight to the vertex it "belongs to":
+     *   w0 = orient2d(v1, v2, p) -> weight for v0
+     *   w1 = orient2d(v2, v0, p) -> weight for v1
+     *   w2 = orient2d(v0, v1, p) -> weight for v2 */
+    int px = min_x * FORGE_RASTER__SUBPIXEL_ONE + FORGE_RASTER__SUBPIXEL_HALF;
+    int py = min_y * FORGE_RASTER__SUBPIXEL_ONE + FORGE_RASTER__SUBPIXEL_HALF;
+    ForgeRaster__Edge e0, e1, e2;
+    forge_raster__edge_setup(&e0, fx[1], fy[1], fx[2], fy[2], px, py);
+    forge_raster__edge_setup(&e1, fx[2], fy[2], fx[0], fy[0], px, py);
+    forge_raster__edge_setup(&e2, fx[0], fy[0], fx[1], fy[1], px, py);
+
+    /* Precompute 1/area for barycentric normalization */
+    float inv_area = 1.0f / (float)area;
+
+    /* Attributes are linear in the pixel position, so along a row each
+     * one changes by the same amount per pixel.  Barycentric weights step
+     * by step_x / area, and Σ weight * attribute steps accordingly. */
+    float d0 = (float)e0.step_x * inv_area;
+    float d1 = (float)e1.step_x * inv_area;
+    float d2 = (float)e2.step_x * inv_area;
+    ForgeRaster__Span span;
+    span.dr = d0 * v0->r + d1 * v1->r + d2 * v2->r;
+    span.dg = d0 * v0->g + d1 * v1->g + d2 * v2->g;
+    span.db = d0 * v0->b + d1 * v1->b + d2 * v2->b;
+    span.da = d0 * v0->a + d1 * v1->a + d2 * v2->a;
+    span.du = d0 * v0->u + d1 * v1->u + d2 * v2->u;
+    span.dv = d0 * v0->v + d1 * v1->v + d2 * v2->v;
+
+    /* Textures with no texels draw untextured; SDF textures need the
+     * scalar kernel's bilinear distance sampling */
+    span.texture = (texture && texture->pixels &&
+                    texture->width > 0 && texture->height > 0)
+                   ? texture : NULL;
+    ForgeRasterSimd simd = forge_raster_get_simd();
+
+    /* Span start values are taken at the column of the leftmost vertex,
+     * which stays put however the bounds were clipped */
+    int lo_fx = fx[0];
+    if (fx[1] < lo_fx) lo_fx = fx[1];
+    if (fx[2] < lo_fx) lo_fx = fx[2];
+    int anchor_x = forge_raster__fixed_floor(lo_fx);
+    if (span.texture && span.texture->sdf_screen_range > 0.0f) {
+        simd = FORGE_RASTER_SIMD_SCALAR;
+    }
+
+    /* Rasterize in strips of 8 rows.  Each strip's 8x8 blocks are
+     * classified first, so rows only step the edge functions through the
+     * blocks an edge crosses.  For a large triangle that is a thin band
+     * along its edges; most of the bounding box costs nothing.  Each
+     * row's run of covered pixels goes to the span kernel. */
+    Uint8 block_class[FORGE_RASTER__MAX_BLOCKS];
+    int y = min_y;
+    while (y <= max_y) {
+        int strip_end = y | (FORGE_RASTER__BLOCK_SIZE - 1);
+        if (strip_end > max_y) strip_end = max_y;
+        forge_raster__classify_strip(block_class, min_x, max_x,
+                                     strip_end - y, &e0, &e1, &e2);
+
+        for (; y <= strip_end; y++) {
+            int run_start, run_end;
+            if (forge_raster__row_run(block_class, min_x, max_x,
+                                      &e0, &e1, &e2, &run_start, &run_end)) {
+                /* Evaluate the edge functions (exactly, in integers) at
+                 * the anchor column and normalize to barycentric
+                 * coordinates.  Because w0+w1+w2 = area, dividing by area
+                 * gives weights that sum to 1.0.  These weights tell us
+                 * "how much" of each vertex influences this pixel. */
+                int64_t off = (int64_t)(anchor_x - min_x);
+                float b0 = (float)(e0.w + off * e0.step_x) * inv_area;
+                float b1 = (float)(e1.w + off * e1.step_x) * inv_area;
+                float b2 = (float)(e2.w + off * e2.step_x) * inv_area;
+
+                span.r = b0 * v0->r + b1 * v1->r + b2 * v2->r;
+                span.g = b0 * v0->g + b1 * v1->g + b2 * v2->g;
+                span.b = b0 * v0->b + b1 * v1->b + b2 * v2->b;
+                span.a = b0 * v0->a + b1 * v1->a + b2 * v2->a;
+                span.u = b0 * v0->u + b1 * v1->u + b2 * v2->u;
+                span.v = b0 * v0->v + b1 * v1->v + b2 * v2->v;
+
+                Uint8 *dst = buf->pixels + (size_t)y * (size_t)buf->stride +
+                             (size_t)run_start * FORGE_RASTER_BPP;
+                span.offset = run_start - anchor_x;
+                forge_raster__draw_span(simd, dst, run_end - run_start,
+                                        &span);
+            }
+
+            e0.w += e0.step_y;
+            e1.w += e1.step_y;
+            e2.w += e2.step_y;
+        }
+    }
+}
+
+static inline void forge_raster_triangle(ForgeRasterBuffer *buf,
+                                         const ForgeRasterVertex *v0,
+                                         const ForgeRasterVertex *v1,
+                                         const ForgeRasterVertex *v2,
+                                         const ForgeRasterTexture *texture)
+{
+    if (!buf || !buf->pixels || !v0 || !v1 || !v2) return;
+    forge_raster__triangle_bounded(buf, v0, v1, v2, texture,
+                                   0, 0, buf->width - 1, buf->height - 1);
 }
 
 /* ── Indexed Drawing ─────────────────────────────────────────────────────── */
@@ -481,6 +1475,473 @@ static inline void forge_raster_triangles_indexed(ForgeRasterBuffer *buf,
     }
 }
 
+static inline void forge_raster_triangles_indexed_scissor(ForgeRasterBuffer *buf,
+                                                          const ForgeRasterVertex *vertices,
+                                                          int vertex_count,
+                                                          const Uint32 *indices,
+                                                          int index_count,
+                                                          const ForgeRasterTexture *texture,
+                                                          int x, int y,
+                                                          int w, int h)
+{
+    if (!buf || !buf->pixels || !vertices || !indices) return;
+    if (vertex_count <= 0 || index_count <= 0) return;
+
+    /* Intersect the scissor with the framebuffer (inclusive bounds) */
+    int x0, x1, y0, y1;
+    if (!forge_raster__scissor_span(x, w, buf->width, &x0, &x1)) return;
+    if (!forge_raster__scissor_span(y, h, buf->height, &y0, &y1)) return;
+
+    for (int i = 0; i + 2 < index_count; i += 3) {
+        Uint32 i0 = indices[i + 0];
+        Uint32 i1 = indices[i + 1];
+        Uint32 i2 = indices[i + 2];
+
+        if (i0 >= (Uint32)vertex_count ||
+            i1 >= (Uint32)vertex_count ||
+            i2 >= (Uint32)vertex_count) {
+            SDL_Log("forge_raster_triangles_indexed_scissor: index out of "
+                    "bounds (%u, %u, %u) with vertex_count=%d",
+                    (unsigned)i0, (unsigned)i1, (unsigned)i2, vertex_count);
+            continue;
+        }
+
+        forge_raster__triangle_bounded(buf,
+                                       &vertices[i0], &vertices[i1],
+                                       &vertices[i2], texture,
+                                       x0, y0, x1, y1);
+    }
+}
+
+static inline void forge_raster_triangles_indexed_rects(ForgeRasterBuffer *buf,
+                                                        const ForgeRasterVertex *vertices,
+                                                        int vertex_count,
+                                                        const Uint32 *indices,
+                                                        int index_count,
+                                                        const ForgeRasterTexture *texture,
+                                                        const ForgeRasterRect *rects,
+                                                        int rect_count)
+{
+    if (!buf || !buf->pixels || !vertices || !indices || !rects) return;
+    if (vertex_count <= 0 || index_count <= 0 || rect_count <= 0) return;
+
+    for (int i = 0; i + 2 < index_count; i += 3) {
+        Uint32 i0 = indices[i + 0];
+        Uint32 i1 = indices[i + 1];
+        Uint32 i2 = indices[i + 2];
+
+        if (i0 >= (Uint32)vertex_count ||
+            i1 >= (Uint32)vertex_count ||
+            i2 >= (Uint32)vertex_count) {
+            SDL_Log("forge_raster_triangles_indexed_rects: index out of "
+                    "bounds (%u, %u, %u) with vertex_count=%d",
+                    (unsigned)i0, (unsigned)i1, (unsigned)i2, vertex_count);
+            continue;
+        }
+
+        const ForgeRasterVertex *v0 = &vertices[i0];
+        const ForgeRasterVertex *v1 = &vertices[i1];
+        const ForgeRasterVertex *v2 = &vertices[i2];
+        float min_x = forge_raster__min3f(v0->x, v1->x, v2->x);
+        float max_x = forge_raster__max3f(v0->x, v1->x, v2->x);
+        float min_y = forge_raster__min3f(v0->y, v1->y, v2->y);
+        float max_y = forge_raster__max3f(v0->y, v1->y, v2->y);
+
+        for (int r = 0; r < rect_count; r++) {
+            int x0, x1, y0, y1;
+            if (!forge_raster__scissor_span(rects[r].x, rects[r].w,
+                                            buf->width, &x0, &x1) ||
+                !forge_raster__scissor_span(rects[r].y, rects[r].h,
+                                            buf->height, &y0, &y1)) {
+                continue;
+            }
+            /* Pixel px is covered only if its center px + 0.5 lies in
+             * [min_x, max_x]; the comparisons also skip NaN bounds (the
+             * rasterizer would reject those triangles anyway) */
+            if (!(max_x >= (float)x0) || !(min_x <= (float)x1 + 1.0f) ||
+                !(max_y >= (float)y0) || !(min_y <= (float)y1 + 1.0f)) {
+                continue;
+            }
+            forge_raster__triangle_bounded(buf, v0, v1, v2, texture,
+                                           x0, y0, x1, y1);
+        }
+    }
+}
+
+/* ── Tiled Drawing ───────────────────────────────────────────────────────── */
+
+/* Shared state for one tiled draw.  The bins are a counting sort of the
+ * batch: tile t's triangles are bin_tris[bin_start[t] .. bin_start[t + 1]),
+ * each stored as the offset of its first index, in submission order. */
+typedef struct ForgeRaster__TileJob {
+    ForgeRasterBuffer        *buf;
+    const ForgeRasterVertex  *vertices;
+    const Uint32             *indices;
+    const ForgeRasterTexture *texture;
+    int                       tile_size;
+    int                       tiles_x;
+    int                       tile_count;
+    const size_t             *bin_start;  /* [tile_count + 1] */
+    const int                *bin_tris;   /* [bin_start[tile_count]] */
+    SDL_AtomicInt             next;       /* next unclaimed tile */
+} ForgeRaster__TileJob;
+
+/* Claim tiles until none are left and draw each one's triangles, scissored
+ * to the tile.  Returns 0 (SDL_ThreadFunction signature). */
+static int forge_raster__tile_worker(void *data)
+{
+    ForgeRaster__TileJob *job = (ForgeRaster__TileJob *)data;
+    ForgeRasterBuffer *buf = job->buf;
+
+    for (;;) {
+        int t = SDL_AddAtomicInt(&job->next, 1);
+        if (t >= job->tile_count) break;
+
+        int x0 = (t % job->tiles_x) * job->tile_size;
+        int y0 = (t / job->tiles_x) * job->tile_size;
+        int x1 = x0 + job->tile_size - 1;
+        int y1 = y0 + job->tile_size - 1;
+        if (x1 > buf->width - 1)  x1 = buf->width - 1;
+        if (y1 > buf->height - 1) y1 = buf->height - 1;
+
+        for (size_t b = job->bin_start[t]; b < job->bin_start[t + 1]; b++) {
+            const Uint32 *tri = job->indices + job->bin_tris[b];
+            forge_raster__triangle_bounded(buf,
+                                           &job->vertices[tri[0]],
+                                           &job->vertices[tri[1]],
+                                           &job->vertices[tri[2]],
+                                           job->texture, x0, y0, x1, y1);
+        }
+    }
+    return 0;
+}
+
+/* Pool worker: sleep until a job is posted, draw tiles until none are
+ * left, report done, repeat until the pool quits.  Each worker joins
+ * every job exactly once, because the next job is only posted after all
+ * of them have reported the current one done. */
+static int forge_raster__pool_main(void *data)
+{
+    ForgeRasterPool *pool = (ForgeRasterPool *)data;
+    Uint32 seen = 0;
+    SDL_LockMutex(pool->lock);
+    for (;;) {
+        while (!pool->quit && pool->generation == seen) {
+            SDL_WaitCondition(pool->work_ready, pool->lock);
+        }
+        if (pool->quit) break;
+        seen = pool->generation;
+        struct ForgeRaster__TileJob *job = pool->job;
+        SDL_UnlockMutex(pool->lock);
+
+        forge_raster__tile_worker(job);
+
+        SDL_LockMutex(pool->lock);
+        if (--pool->busy == 0) SDL_SignalCondition(pool->work_done);
+    }
+    SDL_UnlockMutex(pool->lock);
+    return 0;
+}
+
+static inline ForgeRasterPool *forge_raster_pool_create(int thread_count)
+{
+    if (thread_count < 0) {
+        SDL_Log("forge_raster_pool_create: thread_count %d is negative",
+                thread_count);
+        return NULL;
+    }
+    if (thread_count == 0) thread_count = SDL_GetNumLogicalCPUCores();
+    if (thread_count > FORGE_RASTER_MAX_THREADS) {
+        thread_count = FORGE_RASTER_MAX_THREADS;
+    }
+
+    ForgeRasterPool *pool = (ForgeRasterPool *)SDL_calloc(1, sizeof(*pool));
+    if (!pool) {
+        SDL_Log("forge_raster_pool_create: allocation failed");
+        return NULL;
+    }
+    pool->lock       = SDL_CreateMutex();
+    pool->work_ready = SDL_CreateCondition();
+    pool->work_done  = SDL_CreateCondition();
+    if (!pool->lock || !pool->work_ready || !pool->work_done) {
+        SDL_Log("forge_raster_pool_create: mutex/condition creation "
+                "failed: %s", SDL_GetError());
+        forge_raster_pool_destroy(pool);
+        return NULL;
+    }
+    for (int t = 1; t < thread_count; t++) {
+        SDL_Thread *th = SDL_CreateThread(forge_raster__pool_main,
+                                          "forge_raster_pool", pool);
+        if (!th) {
+            SDL_Log("forge_raster_pool_create: SDL_CreateThread failed: %s",
+                    SDL_GetError());
+            break;
+        }
+        pool->threads[pool->worker_count++] = th;
+    }
+    return pool;
+}
+
+static inline void forge_raster_pool_destroy(ForgeRasterPool *pool)
+{
+    if (!pool) return;
+    if (pool->lock) {
+        SDL_LockMutex(pool->lock);
+        pool->quit = true;
+        SDL_BroadcastCondition(pool->work_ready);
+        SDL_UnlockMutex(pool->lock);
+    }
+    for (int t = 0; t < pool->worker_count; t++) {
+        SDL_WaitThread(pool->threads[t], NULL);
+    }
+    SDL_DestroyCondition(pool->work_done);
+    SDL_DestroyCondition(pool->work_ready);
+    SDL_DestroyMutex(pool->lock);
+    SDL_free(pool);
+}
+
+static inline int forge_raster_pool_thread_count(const ForgeRasterPool *pool)
+{
+    return pool ? pool->worker_count + 1 : 0;
+}
+
+/* Draw job's tiles on the pool's workers and the calling thread; returns
+ * when every tile is drawn. */
+static inline void forge_raster__pool_run(ForgeRasterPool *pool,
+                                          ForgeRaster__TileJob *job)
+{
+    if (pool->worker_count > 0) {
+        SDL_LockMutex(pool->lock);
+        pool->job  = job;
+        pool->busy = pool->worker_count;
+        pool->generation++;
+        SDL_BroadcastCondition(pool->work_ready);
+        SDL_UnlockMutex(pool->lock);
+    }
+
+    forge_raster__tile_worker(job);
+
+    if (pool->worker_count > 0) {
+        SDL_LockMutex(pool->lock);
+        while (pool->busy > 0) {
+            SDL_WaitCondition(pool->work_done, pool->lock);
+        }
+        pool->job = NULL;
+        SDL_UnlockMutex(pool->lock);
+    }
+}
+
+/* Range of tiles covered by a triangle's pixel bounds.  Returns false if
+ * the rasterizer would reject the triangle or it covers no pixel center
+ * in the framebuffer. */
+static inline bool forge_raster__tile_range(const ForgeRasterBuffer *buf,
+                                            const ForgeRasterVertex *vertices,
+                                            const Uint32 *tri, int tile_size,
+                                            int *tx0, int *ty0,
+                                            int *tx1, int *ty1)
+{
+    int fx[3], fy[3];
+    int min_x, min_y, max_x, max_y;
+    if (!forge_raster__snap_triangle(&vertices[tri[0]], &vertices[tri[1]],
+                                     &vertices[tri[2]], fx, fy) ||
+        !forge_raster__triangle_pixel_bounds(fx, fy, 0, 0, buf->width - 1,
+                                             buf->height - 1,
+                                             &min_x, &min_y,
+                                             &max_x, &max_y)) {
+        return false;
+    }
+    *tx0 = min_x / tile_size;
+    *ty0 = min_y / tile_size;
+    *tx1 = max_x / tile_size;
+    *ty1 = max_y / tile_size;
+    return true;
+}
+
+static inline void forge_raster_triangles_indexed_tiled(ForgeRasterBuffer *buf,
+                                                        const ForgeRasterVertex *vertices,
+                                                        int vertex_count,
+                                                        const Uint32 *indices,
+                                                        int index_count,
+                                                        const ForgeRasterTexture *texture,
+                                                        const ForgeRasterTileOpts *opts)
+{
+    if (!buf || !buf->pixels || !vertices || !indices) return;
+    if (vertex_count <= 0 || index_count <= 0) return;
+
+    int tile_size = opts ? opts->tile_size : 0;
+    if (tile_size <= 0) tile_size = FORGE_RASTER_DEFAULT_TILE_SIZE;
+    if (tile_size < FORGE_RASTER_MIN_TILE_SIZE) {
+        tile_size = FORGE_RASTER_MIN_TILE_SIZE;
+    }
+    int tiles_x = (buf->width  + tile_size - 1) / tile_size;
+    int tiles_y = (buf->height + tile_size - 1) / tile_size;
+    int tile_count = tiles_x * tiles_y;
+
+    size_t *bin_start = (size_t *)SDL_calloc((size_t)tile_count + 1,
+                                             sizeof(size_t));
+    if (!bin_start) {
+        SDL_Log("forge_raster_triangles_indexed_tiled: allocation failed "
+                "(bins) -- drawing serially");
+        forge_raster_triangles_indexed(buf, vertices, vertex_count, indices,
+                                       index_count, texture);
+        return;
+    }
+
+    /* Pass 1: count each tile's triangles.  Bad indices are reported here,
+     * once per triangle, exactly as the serial draw reports them. */
+    for (int i = 0; i + 2 < index_count; i += 3) {
+        if (indices[i + 0] >= (Uint32)vertex_count ||
+            indices[i + 1] >= (Uint32)vertex_count ||
+            indices[i + 2] >= (Uint32)vertex_count) {
+            SDL_Log("forge_raster_triangles_indexed_tiled: index out of "
+                    "bounds (%u, %u, %u) with vertex_count=%d",
+                    (unsigned)indices[i + 0], (unsigned)indices[i + 1],
+                    (unsigned)indices[i + 2], vertex_count);
+            continue;
+        }
+        int tx0, ty0, tx1, ty1;
+        if (!forge_raster__tile_range(buf, vertices, &indices[i], tile_size,
+                                      &tx0, &ty0, &tx1, &ty1)) {
+            continue;
+        }
+        for (int ty = ty0; ty <= ty1; ty++) {
+            for (int tx = tx0; tx <= tx1; tx++) {
+                bin_start[ty * tiles_x + tx + 1]++;
+            }
+        }
+    }
+    for (int t = 0; t < tile_count; t++) {
+        bin_start[t + 1] += bin_start[t];
+    }
+
+    /* Pass 2: fill the bins in submission order, using bin_fill as each
+     * tile's write cursor */
+    size_t total = bin_start[tile_count];
+    int *bin_tris = (int *)SDL_malloc((total > 0 ? total : 1) * sizeof(int));
+    size_t *bin_fill = (size_t *)SDL_malloc((size_t)tile_count *
+                                            sizeof(size_t));
+    if (!bin_tris || !bin_fill) {
+        SDL_Log("forge_raster_triangles_indexed_tiled: allocation failed "
+                "(%zu binned triangles) -- drawing serially", total);
+        SDL_free(bin_fill);
+        SDL_free(bin_tris);
+        SDL_free(bin_start);
+        forge_raster_triangles_indexed(buf, vertices, vertex_count, indices,
+                                       index_count, texture);
+        return;
+    }
+    SDL_memcpy(bin_fill, bin_start, (size_t)tile_count * sizeof(size_t));
+    for (int i = 0; i + 2 < index_count; i += 3) {
+        if (indices[i + 0] >= (Uint32)vertex_count ||
+            indices[i + 1] >= (Uint32)vertex_count ||
+            indices[i + 2] >= (Uint32)vertex_count) {
+            continue;
+        }
+        int tx0, ty0, tx1, ty1;
+        if (!forge_raster__tile_range(buf, vertices, &indices[i], tile_size,
+                                      &tx0, &ty0, &tx1, &ty1)) {
+            continue;
+        }
+        for (int ty = ty0; ty <= ty1; ty++) {
+            for (int tx = tx0; tx <= tx1; tx++) {
+                bin_tris[bin_fill[ty * tiles_x + tx]++] = i;
+            }
+        }
+    }
+    SDL_free(bin_fill);
+
+    ForgeRaster__TileJob job;
+    SDL_memset(&job, 0, sizeof(job));
+    job.buf        = buf;
+    job.vertices   = vertices;
+    job.indices    = indices;
+    job.texture    = texture;
+    job.tile_size  = tile_size;
+    job.tiles_x    = tiles_x;
+    job.tile_count = tile_count;
+    job.bin_start  = bin_start;
+    job.bin_tris   = bin_tris;
+    SDL_SetAtomicInt(&job.next, 0);
+
+    if (opts && opts->pool) {
+        forge_raster__pool_run(opts->pool, &job);
+    } else {
+        /* No pool: one for this draw only.  The caller is one of the
+         * threads, so a single thread (or a failed pool) draws inline. */
+        int thread_count = opts ? opts->thread_count : 0;
+        if (thread_count <= 0) thread_count = SDL_GetNumLogicalCPUCores();
+        if (thread_count > tile_count) thread_count = tile_count;
+        ForgeRasterPool *pool = thread_count > 1
+                              ? forge_raster_pool_create(thread_count) : NULL;
+        if (pool) {
+            forge_raster__pool_run(pool, &job);
+            forge_raster_pool_destroy(pool);
+        } else {
+            forge_raster__tile_worker(&job);
+        }
+    }
+
+    SDL_free(bin_tris);
+    SDL_free(bin_start);
+}
+
+/* ── Packed Vertices ─────────────────────────────────────────────────────── */
+
+static inline void forge_raster__unpack_vertex(const ForgeRasterPackedVertex *src,
+                                               ForgeRasterVertex *dst)
+{
+    dst->x = src->x;
+    dst->y = src->y;
+    dst->u = (float)src->u * (1.0f / 65535.0f);
+    dst->v = (float)src->v * (1.0f / 65535.0f);
+    dst->r = (float)src->r * (1.0f / 255.0f);
+    dst->g = (float)src->g * (1.0f / 255.0f);
+    dst->b = (float)src->b * (1.0f / 255.0f);
+    dst->a = (float)src->a * (1.0f / 255.0f);
+}
+
+static inline void forge_raster_unpack_vertices(const ForgeRasterPackedVertex *src,
+                                                ForgeRasterVertex *dst,
+                                                int count)
+{
+    if (!src || !dst) return;
+    for (int i = 0; i < count; i++) {
+        forge_raster__unpack_vertex(&src[i], &dst[i]);
+    }
+}
+
+static inline void forge_raster_triangles_indexed_packed(ForgeRasterBuffer *buf,
+                                                         const ForgeRasterPackedVertex *vertices,
+                                                         int vertex_count,
+                                                         const Uint32 *indices,
+                                                         int index_count,
+                                                         const ForgeRasterTexture *texture)
+{
+    if (!buf || !buf->pixels || !vertices || !indices) return;
+    if (vertex_count <= 0 || index_count <= 0) return;
+
+    for (int i = 0; i + 2 < index_count; i += 3) {
+        Uint32 i0 = indices[i + 0];
+        Uint32 i1 = indices[i + 1];
+        Uint32 i2 = indices[i + 2];
+
+        if (i0 >= (Uint32)vertex_count ||
+            i1 >= (Uint32)vertex_count ||
+            i2 >= (Uint32)vertex_count) {
+            SDL_Log("forge_raster_triangles_indexed_packed: index out of "
+                    "bounds (%u, %u, %u) with vertex_count=%d",
+                    (unsigned)i0, (unsigned)i1, (unsigned)i2, vertex_count);
+            continue;
+        }
+
+        ForgeRasterVertex tri[3];
+        forge_raster__unpack_vertex(&vertices[i0], &tri[0]);
+        forge_raster__unpack_vertex(&vertices[i1], &tri[1]);
+        forge_raster__unpack_vertex(&vertices[i2], &tri[2]);
+        forge_raster_triangle(buf, &tri[0], &tri[1], &tri[2], texture);
+    }
+}
+
 /* ── BMP Writing ─────────────────────────────────────────────────────────── */
 
 /* BMP file header sizes */
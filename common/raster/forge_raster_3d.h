@@ -0,0 +1,686 @@
+/*
+ * forge_raster_3d.h -- Header-only 3D triangle pipeline for forge_raster
+ *
+ * Renders meshes headlessly on the CPU -- asset previews and golden images
+ * on build machines without a GPU.  Vertices arrive in clip space (the
+ * output of a forge_math model-view-projection mat4), and each triangle
+ * goes through the fixed-function stages a GPU runs after the vertex
+ * shader:
+ *
+ *   1. Clipping against the near and far planes (0 <= z <= w, the
+ *      Vulkan/Metal/D3D depth range mat4_perspective produces) and a
+ *      guard band around the screen, so the 2D rasterizer never sees w <= 0
+ *      or coordinates past its fixed-point range
+ *   2. Perspective divide and viewport transform (NDC +Y up -> framebuffer
+ *      rows top-down)
+ *   3. Back-face culling (forge_math winds front faces CCW)
+ *   4. Rasterization with forge_raster's fixed-point edge functions, top-left
+ *      fill rule and 8x8 block classification
+ *   5. Early depth test against a float or 16-bit depth buffer -- before
+ *      any attribute is interpolated or texel sampled
+ *   6. Perspective-correct interpolation of UVs and colors (attribute / w
+ *      and 1 / w are linear in screen space; their ratio is not), then
+ *      texture sampling and blending exactly as in 2D drawing
+ *
+ * Supports:
+ *   - ForgeRaster3dVertex: clip-space position, UV and RGBA color
+ *   - forge_raster_transform_vertices: mat4 * position for strided vertex
+ *     arrays such as ForgeObjVertex and ForgeGltfVertex
+ *   - Float32 and unorm16 depth buffers, LESS / LESS_EQUAL / ALWAYS tests,
+ *     read-only depth for translucent passes
+ *   - Indexed or non-indexed triangle lists
+ *
+ * Limitations (intentional for a learning library):
+ *   - One texture and per-vertex color per draw; lighting is up to the
+ *     caller (bake it into the vertex colors)
+ *   - Every pixel is shaded by the scalar span kernel (perspective
+ *     correction divides per pixel)
+ *   - No MSAA; no stencil
+ *
+ * Usage:
+ *   #include "math/forge_math.h"
+ *   #include "raster/forge_raster.h"
+ *   #include "raster/forge_raster_3d.h"
+ *
+ *   ForgeRasterBuffer buf = forge_raster_buffer_create(512, 512);
+ *   ForgeRasterDepthBuffer depth = forge_raster_depth_create(
+ *       512, 512, FORGE_RASTER_DEPTH_FLOAT32);
+ *   forge_raster_clear(&buf, 0.1f, 0.1f, 0.1f, 1.0f);
+ *   forge_raster_depth_clear(&depth, 1.0f);
+ *
+ *   mat4 mvp = mat4_multiply(proj, mat4_multiply(view, model));
+ *   forge_raster_transform_vertices(mvp, &mesh.vertices[0].position,
+ *                                   &mesh.vertices[0].uv,
+ *                                   sizeof(ForgeObjVertex),
+ *                                   (int)mesh.vertex_count,
+ *                                   vec4_create(1, 1, 1, 1), clip_verts);
+ *   forge_raster_triangles_3d(&buf, &depth, clip_verts,
+ *                             (int)mesh.vertex_count, NULL, 0, NULL, NULL);
+ *
+ *   forge_raster_write_bmp(&buf, "preview.bmp");
+ *   forge_raster_depth_destroy(&depth);
+ *   forge_raster_buffer_destroy(&buf);
+ *
+ * SPDX-License-Identifier: Zlib
+ */
+
+#ifndef FORGE_RASTER_3D_H
+#define FORGE_RASTER_3D_H
+
+#include <SDL3/SDL.h>
+#include "math/forge_math.h"
+#include "forge_raster.h"
+
+/* ── Constants ───────────────────────────────────────────────────────────── */
+
+/* Half-width of the clipping guard band in NDC units.  Triangles are only
+ * clipped at the sides once they reach this far off screen, which keeps
+ * vertex positions well inside the rasterizer's 2^21 pixel range for any
+ * framebuffer up to FORGE_RASTER_MAX_DIM; everything nearer is left to
+ * the rasterizer's bounding box. */
+#define FORGE_RASTER_GUARD_BAND 64.0f
+
+/* Near, far and the four guard-band sides */
+#define FORGE_RASTER__CLIP_PLANES 6
+
+/* Each plane a convex polygon is clipped against adds at most one vertex,
+ * so a triangle clipped by every plane has at most 3 + 6 */
+#define FORGE_RASTER__CLIP_MAX_VERTS (3 + FORGE_RASTER__CLIP_PLANES)
+
+/* ── Types ───────────────────────────────────────────────────────────────── */
+
+/* A vertex after the vertex stage: clip-space position (model-view-
+ * projection matrix times object-space position) plus the attributes to
+ * interpolate.  Colors are straight alpha, as in ForgeRasterVertex. */
+typedef struct ForgeRaster3dVertex {
+    vec4  position;    /* clip space; w > 0 in front of the camera */
+    float u, v;        /* texture coordinates [0, 1] */
+    float r, g, b, a;  /* vertex color */
+} ForgeRaster3dVertex;
+
+/* Storage format of a depth buffer.  UNORM16 halves the memory and
+ * quantizes depth to 1/65535 -- enough for previews, but distant
+ * surfaces closer together than that z-fight. */
+typedef enum ForgeRasterDepthFormat {
+    FORGE_RASTER_DEPTH_FLOAT32 = 0,
+    FORGE_RASTER_DEPTH_UNORM16
+} ForgeRasterDepthFormat;
+
+/* Per-pixel depth in [0, 1] (0 = near plane, 1 = far plane), row-major
+ * with the framebuffer's top-left origin.  Exactly one of depth32 and
+ * depth16 is allocated, matching format. */
+typedef struct ForgeRasterDepthBuffer {
+    float                 *depth32;
+    Uint16                *depth16;
+    int                    width;
+    int                    height;
+    ForgeRasterDepthFormat format;
+} ForgeRasterDepthBuffer;
+
+/* Which faces forge_raster_triangles_3d discards.  Front faces wind
+ * counter-clockwise in NDC, the forge_math convention. */
+typedef enum ForgeRasterCull {
+    FORGE_RASTER_CULL_BACK = 0,
+    FORGE_RASTER_CULL_FRONT,
+    FORGE_RASTER_CULL_NONE
+} ForgeRasterCull;
+
+/* Depth comparison: a pixel is drawn if its depth compares true against
+ * the stored depth */
+typedef enum ForgeRasterDepthFunc {
+    FORGE_RASTER_DEPTH_LESS = 0,
+    FORGE_RASTER_DEPTH_LESS_EQUAL,
+    FORGE_RASTER_DEPTH_ALWAYS
+} ForgeRasterDepthFunc;
+
+/* Options for forge_raster_triangles_3d().  A zeroed struct (or NULL)
+ * culls back faces and depth-tests with LESS, writing depth. */
+typedef struct ForgeRaster3dOpts {
+    ForgeRasterCull      cull;
+    ForgeRasterDepthFunc depth_func;
+    bool                 depth_read_only;  /* test but do not write, e.g.
+                                            * for translucent surfaces */
+} ForgeRaster3dOpts;
+
+/* ── Public API ──────────────────────────────────────────────────────────── */
+
+/* Allocate a depth buffer.  Returns a buffer with both storage pointers
+ * NULL on failure (logged).  Contents start at 0 -- clear to 1.0 (the far
+ * plane) before a LESS-tested pass. */
+static inline ForgeRasterDepthBuffer forge_raster_depth_create(int width,
+                                                               int height,
+                                                               ForgeRasterDepthFormat format);
+
+/* Free the storage allocated by forge_raster_depth_create. */
+static inline void forge_raster_depth_destroy(ForgeRasterDepthBuffer *depth);
+
+/* Fill the depth buffer with value (clamped to [0, 1]). */
+static inline void forge_raster_depth_clear(ForgeRasterDepthBuffer *depth,
+                                            float value);
+
+/* Depth at pixel (x, y) as a float in [0, 1], or 1.0 if (x, y) is outside
+ * the buffer. */
+static inline float forge_raster_depth_get(const ForgeRasterDepthBuffer *depth,
+                                           int x, int y);
+
+/* Transform count vertices to clip space: out[i].position = mvp *
+ * (positions[i], 1).  Positions (and UVs, if uvs is non-NULL) are read
+ * stride bytes apart, so interleaved layouts work directly -- pass
+ * &mesh.vertices[0].position, &mesh.vertices[0].uv and
+ * sizeof(ForgeObjVertex) (or ForgeGltfVertex).  Every vertex gets color. */
+static inline void forge_raster_transform_vertices(mat4 mvp,
+                                                   const vec3 *positions,
+                                                   const vec2 *uvs,
+                                                   size_t stride,
+                                                   int count,
+                                                   vec4 color,
+                                                   ForgeRaster3dVertex *out);
+
+/* Draw a 3D triangle list.
+ *
+ * With indices, every three indices form one triangle (each validated
+ * against vertex_count); with indices == NULL, every three vertices do,
+ * as in a de-indexed forge_obj mesh.  Triangles are clipped, culled and
+ * rasterized as described at the top of this file.  depth may be NULL
+ * to draw in submission order without depth testing; otherwise it must
+ * match the framebuffer's size.  opts may be NULL for the defaults. */
+static inline void forge_raster_triangles_3d(ForgeRasterBuffer *buf,
+                                             ForgeRasterDepthBuffer *depth,
+                                             const ForgeRaster3dVertex *vertices,
+                                             int vertex_count,
+                                             const Uint32 *indices,
+                                             int index_count,
+                                             const ForgeRasterTexture *texture,
+                                             const ForgeRaster3dOpts *opts);
+
+/* ══════════════════════════════════════════════════════════════════════════ */
+/* ── Implementation ───────────────────────────────────────────────────────── */
+/* ══════════════════════════════════════════════════════════════════════════ */
+
+/* ── Depth Buffer ────────────────────────────────────────────────────────── */
+
+static inline ForgeRasterDepthBuffer forge_raster_depth_create(int width,
+                                                               int height,
+                                                               ForgeRasterDepthFormat format)
+{
+    ForgeRasterDepthBuffer depth;
+    depth.depth32 = NULL;
+    depth.depth16 = NULL;
+    depth.width   = 0;
+    depth.height  = 0;
+    depth.format  = format;
+
+    if (width <= 0 || height <= 0 ||
+        width > FORGE_RASTER_MAX_DIM || height > FORGE_RASTER_MAX_DIM) {
+        SDL_Log("forge_raster_depth_create: invalid dimensions %dx%d "
+                "(max %d)", width, height, FORGE_RASTER_MAX_DIM);
+        return depth;
+    }
+    if (format != FORGE_RASTER_DEPTH_FLOAT32 &&
+        format != FORGE_RASTER_DEPTH_UNORM16) {
+        SDL_Log("forge_raster_depth_create: unknown format %d", (int)format);
+        return depth;
+    }
+
+    size_t count = (size_t)width * (size_t)height;
+    if (format == FORGE_RASTER_DEPTH_FLOAT32) {
+        depth.depth32 = (float *)SDL_calloc(count, sizeof(float));
+    } else {
+        depth.depth16 = (Uint16 *)SDL_calloc(count, sizeof(Uint16));
+    }
+    if (!depth.depth32 && !depth.depth16) {
+        SDL_Log("forge_raster_depth_create: allocation failed (%zu pixels)",
+                count);
+        return depth;
+    }
+    depth.width  = width;
+    depth.height = height;
+    return depth;
+}
+
+static inline void forge_raster_depth_destroy(ForgeRasterDepthBuffer *depth)
+{
+    if (!depth) return;
+    SDL_free(depth->depth32);
+    SDL_free(depth->depth16);
+    depth->depth32 = NULL;
+    depth->depth16 = NULL;
+    depth->width   = 0;
+    depth->height  = 0;
+}
+
+/* Depth in [0, 1] to unorm16, rounding to nearest */
+static inline Uint16 forge_raster__depth_to_u16(float z)
+{
+    return (Uint16)(forge_raster__clampf(z, 0.0f, 1.0f) * 65535.0f + 0.5f);
+}
+
+static inline void forge_raster_depth_clear(ForgeRasterDepthBuffer *depth,
+                                            float value)
+{
+    if (!depth) return;
+    size_t count = (size_t)depth->width * (size_t)depth->height;
+    if (depth->depth32) {
+        float z = forge_raster__clampf(value, 0.0f, 1.0f);
+        for (size_t i = 0; i < count; i++) depth->depth32[i] = z;
+    } else if (depth->depth16) {
+        Uint16 z = forge_raster__depth_to_u16(value);
+        for (size_t i = 0; i < count; i++) depth->depth16[i] = z;
+    }
+}
+
+static inline float forge_raster_depth_get(const ForgeRasterDepthBuffer *depth,
+                                           int x, int y)
+{
+    if (!depth || x < 0 || y < 0 || x >= depth->width || y >= depth->height) {
+        return 1.0f;
+    }
+    size_t i = (size_t)y * (size_t)depth->width + (size_t)x;
+    if (depth->depth32) return depth->depth32[i];
+    if (depth->depth16) return (float)depth->depth16[i] / 65535.0f;
+    return 1.0f;
+}
+
+/* ── Vertex Transform ────────────────────────────────────────────────────── */
+
+static inline void forge_raster_transform_vertices(mat4 mvp,
+                                                   const vec3 *positions,
+                                                   const vec2 *uvs,
+                                                   size_t stride,
+                                                   int count,
+                                                   vec4 color,
+                                                   ForgeRaster3dVertex *out)
+{
+    if (!positions || !out || count <= 0) return;
+    const Uint8 *pos_bytes = (const Uint8 *)positions;
+    const Uint8 *uv_bytes  = (const Uint8 *)uvs;
+
+    for (int i = 0; i < count; i++) {
+        const vec3 *p = (const vec3 *)(pos_bytes + (size_t)i * stride);
+        out[i].position = mat4_multiply_vec4(
+            mvp, vec4_create(p->x, p->y, p->z, 1.0f));
+        if (uv_bytes) {
+            const vec2 *t = (const vec2 *)(uv_bytes + (size_t)i * stride);
+            out[i].u = t->x;
+            out[i].v = t->y;
+        } else {
+            out[i].u = 0.0f;
+            out[i].v = 0.0f;
+        }
+        out[i].r = color.x;
+        out[i].g = color.y;
+        out[i].b = color.z;
+        out[i].a = color.w;
+    }
+}
+
+/* ── Clipping ────────────────────────────────────────────────────────────── */
+
+/* Signed distance of a clip-space position to clip plane `plane` --
+ * inside where >= 0.  The planes are the near and far planes of the
+ * 0 <= z <= w depth range and the four sides of the guard band. */
+static inline float forge_raster__clip_dist(vec4 p, int plane)
+{
+    switch (plane) {
+    case 0:  return p.z;                                  /* near */
+    case 1:  return p.w - p.z;                            /* far */
+    case 2:  return p.x + FORGE_RASTER_GUARD_BAND * p.w;  /* left */
+    case 3:  return FORGE_RASTER_GUARD_BAND * p.w - p.x;  /* right */
+    case 4:  return p.y + FORGE_RASTER_GUARD_BAND * p.w;  /* bottom */
+    default: return FORGE_RASTER_GUARD_BAND * p.w - p.y;  /* top */
+    }
+}
+
+/* Point at t along a -> b.  Every attribute is linear in clip space, so
+ * plain linear interpolation is correct before the perspective divide. */
+static inline ForgeRaster3dVertex forge_raster__clip_lerp(const ForgeRaster3dVertex *a,
+                                                          const ForgeRaster3dVertex *b,
+                                                          float t)
+{
+    ForgeRaster3dVertex o;
+    o.position = vec4_lerp(a->position, b->position, t);
+    o.u = a->u + t * (b->u - a->u);
+    o.v = a->v + t * (b->v - a->v);
+    o.r = a->r + t * (b->r - a->r);
+    o.g = a->g + t * (b->g - a->g);
+    o.b = a->b + t * (b->b - a->b);
+    o.a = a->a + t * (b->a - a->a);
+    return o;
+}
+
+/* Clip a triangle to the planes whose bits are set in `planes`
+ * (Sutherland-Hodgman: each plane keeps the inside part of the polygon,
+ * adding a vertex where an edge crosses it).  Writes the convex polygon
+ * to out and returns its vertex count -- 0 if nothing is left. */
+static inline int forge_raster__clip_triangle(const ForgeRaster3dVertex *v0,
+                                              const ForgeRaster3dVertex *v1,
+                                              const ForgeRaster3dVertex *v2,
+                                              int planes,
+                                              ForgeRaster3dVertex *out)
+{
+    ForgeRaster3dVertex buf_a[FORGE_RASTER__CLIP_MAX_VERTS];
+    ForgeRaster3dVertex buf_b[FORGE_RASTER__CLIP_MAX_VERTS];
+    ForgeRaster3dVertex *src = buf_a, *dst = buf_b;
+    src[0] = *v0;
+    src[1] = *v1;
+    src[2] = *v2;
+    int n = 3;
+
+    for (int plane = 0; plane < FORGE_RASTER__CLIP_PLANES && n > 0; plane++) {
+        if (!(planes & (1 << plane))) continue;
+        int m = 0;
+        for (int i = 0; i < n; i++) {
+            const ForgeRaster3dVertex *a = &src[i];
+            const ForgeRaster3dVertex *b = &src[(i + 1) % n];
+            float da = forge_raster__clip_dist(a->position, plane);
+            float db = forge_raster__clip_dist(b->position, plane);
+            if (da >= 0.0f) dst[m++] = *a;
+            if ((da >= 0.0f) != (db >= 0.0f)) {
+                dst[m++] = forge_raster__clip_lerp(a, b, da / (da - db));
+            }
+        }
+        ForgeRaster3dVertex *t = src;
+        src = dst;
+        dst = t;
+        n = m;
+    }
+
+    for (int i = 0; i < n; i++) out[i] = src[i];
+    return n;
+}
+
+/* ── Rasterization ───────────────────────────────────────────────────────── */
+
+/* A vertex after the perspective divide and viewport transform */
+typedef struct ForgeRaster__ScreenVertex {
+    float x, y;        /* framebuffer pixels */
+    float z;           /* depth in [0, 1] */
+    float inv_w;       /* 1 / clip w, for perspective correction */
+    float u, v;
+    float r, g, b, a;
+} ForgeRaster__ScreenVertex;
+
+static inline ForgeRaster__ScreenVertex forge_raster__to_screen(const ForgeRaster3dVertex *v,
+                                                                int width,
+                                                                int height)
+{
+    ForgeRaster__ScreenVertex s;
+    float inv_w = 1.0f / v->position.w;
+    /* NDC x, y in [-1, 1] with +y up; framebuffer rows go down */
+    s.x = (v->position.x * inv_w * 0.5f + 0.5f) * (float)width;
+    s.y = (0.5f - v->position.y * inv_w * 0.5f) * (float)height;
+    s.z = forge_raster__clampf(v->position.z * inv_w, 0.0f, 1.0f);
+    s.inv_w = inv_w;
+    s.u = v->u;
+    s.v = v->v;
+    s.r = v->r;
+    s.g = v->g;
+    s.b = v->b;
+    s.a = v->a;
+    return s;
+}
+
+/* Depth test for one pixel; on a pass, writes z unless read_only */
+static inline bool forge_raster__depth_test(ForgeRasterDepthBuffer *depth,
+                                            size_t i, float z,
+                                            ForgeRasterDepthFunc func,
+                                            bool read_only)
+{
+    if (depth->depth32) {
+        float stored = depth->depth32[i];
+        bool pass = func == FORGE_RASTER_DEPTH_ALWAYS ||
+                    (func == FORGE_RASTER_DEPTH_LESS_EQUAL ? z <= stored
+                                                           : z < stored);
+        if (pass && !read_only) depth->depth32[i] = z;
+        return pass;
+    }
+    Uint16 q = forge_raster__depth_to_u16(z);
+    Uint16 stored = depth->depth16[i];
+    bool pass = func == FORGE_RASTER_DEPTH_ALWAYS ||
+                (func == FORGE_RASTER_DEPTH_LESS_EQUAL ? q <= stored
+                                                       : q < stored);
+    if (pass && !read_only) depth->depth16[i] = q;
+    return pass;
+}
+
+/* Rasterize one screen-space triangle with depth testing and
+ * perspective-correct attributes.  Coverage is the same as 2D drawing:
+ * snapped vertices, top-left fill rule, 8x8 block classification. */
+static inline void forge_raster__triangle_3d(ForgeRasterBuffer *buf,
+                                             ForgeRasterDepthBuffer *depth,
+                                             const ForgeRaster__ScreenVertex *s0,
+                                             const ForgeRaster__ScreenVertex *s1,
+                                             const ForgeRaster__ScreenVertex *s2,
+                                             const ForgeRasterTexture *texture,
+                                             const ForgeRaster3dOpts *opts)
+{
+    ForgeRasterVertex p0 = { s0->x, s0->y, 0, 0, 0, 0, 0, 0 };
+    ForgeRasterVertex p1 = { s1->x, s1->y, 0, 0, 0, 0, 0, 0 };
+    ForgeRasterVertex p2 = { s2->x, s2->y, 0, 0, 0, 0, 0, 0 };
+    int fx[3], fy[3];
+    if (!forge_raster__snap_triangle(&p0, &p1, &p2, fx, fy)) return;
+
+    int64_t area = forge_raster__orient2d(fx[0], fy[0], fx[1], fy[1],
+                                          fx[2], fy[2]);
+    if (area == 0) return;
+
+    /* Back-face culling.  A front face is CCW in NDC (+y up); the viewport
+     * flips y, so on the framebuffer it is clockwise -- negative area. */
+    bool front = area < 0;
+    if ((opts->cull == FORGE_RASTER_CULL_BACK && !front) ||
+        (opts->cull == FORGE_RASTER_CULL_FRONT && front)) {
+        return;
+    }
+
+    /* Positive winding for the fill rule, as in 2D drawing */
+    if (area < 0) {
+        const ForgeRaster__ScreenVertex *tv = s1;
+        s1 = s2;
+        s2 = tv;
+        int t = fx[1]; fx[1] = fx[2]; fx[2] = t;
+        t = fy[1]; fy[1] = fy[2]; fy[2] = t;
+        area = -area;
+    }
+
+    int min_x, min_y, max_x, max_y;
+    if (!forge_raster__triangle_pixel_bounds(fx, fy, 0, 0, buf->width - 1,
+                                             buf->height - 1, &min_x, &min_y,
+                                             &max_x, &max_y)) {
+        return;
+    }
+
+    int px = min_x * FORGE_RASTER__SUBPIXEL_ONE + FORGE_RASTER__SUBPIXEL_HALF;
+    int py = min_y * FORGE_RASTER__SUBPIXEL_ONE + FORGE_RASTER__SUBPIXEL_HALF;
+    ForgeRaster__Edge e0, e1, e2;
+    forge_raster__edge_setup(&e0, fx[1], fy[1], fx[2], fy[2], px, py);
+    forge_raster__edge_setup(&e1, fx[2], fy[2], fx[0], fy[0], px, py);
+    forge_raster__edge_setup(&e2, fx[0], fy[0], fx[1], fy[1], px, py);
+
+    /* Screen-space barycentrics and their per-pixel steps */
+    float inv_area = 1.0f / (float)area;
+    float d0 = (float)e0.step_x * inv_area;
+    float d1 = (float)e1.step_x * inv_area;
+    float d2 = (float)e2.step_x * inv_area;
+
+    /* Attributes divided by w -- these, and 1/w itself, are the values
+     * that vary linearly across the screen */
+    float iw0 = s0->inv_w, iw1 = s1->inv_w, iw2 = s2->inv_w;
+
+    ForgeRaster__Span pixel;
+    pixel.dr = pixel.dg = pixel.db = pixel.da = 0.0f;
+    pixel.du = pixel.dv = 0.0f;
+    pixel.offset = 0;
+    pixel.texture = (texture && texture->pixels &&
+                     texture->width > 0 && texture->height > 0)
+                    ? texture : NULL;
+
+    bool read_only = opts->depth_read_only;
+    Uint8 block_class[FORGE_RASTER__MAX_BLOCKS];
+    int y = min_y;
+    while (y <= max_y) {
+        int strip_end = y | (FORGE_RASTER__BLOCK_SIZE - 1);
+        if (strip_end > max_y) strip_end = max_y;
+        forge_raster__classify_strip(block_class, min_x, max_x,
+                                     strip_end - y, &e0, &e1, &e2);
+
+        for (; y <= strip_end; y++) {
+            int run_start, run_end;
+            if (forge_raster__row_run(block_class, min_x, max_x,
+                                      &e0, &e1, &e2, &run_start, &run_end)) {
+                int64_t off = (int64_t)(run_start - min_x);
+                float base0 = (float)(e0.w + off * e0.step_x) * inv_area;
+                float base1 = (float)(e1.w + off * e1.step_x) * inv_area;
+                float base2 = (float)(e2.w + off * e2.step_x) * inv_area;
+                size_t row = (size_t)y * (size_t)buf->width;
+                Uint8 *dst = buf->pixels + (size_t)y * (size_t)buf->stride;
+
+                for (int x = run_start; x < run_end; x++) {
+                    /* start + k * step, as in the span kernels: summing
+                     * the step along a long run drifts by more than a
+                     * unorm16 depth step */
+                    float k = (float)(x - run_start);
+                    float b0 = base0 + k * d0;
+                    float b1 = base1 + k * d1;
+                    float b2 = base2 + k * d2;
+
+                    /* Depth is affine in screen space (z/w was divided
+                     * already), so plain barycentrics interpolate it.
+                     * Test it first: hidden pixels cost no more. */
+                    float z = b0 * s0->z + b1 * s1->z + b2 * s2->z;
+                    if (depth && !forge_raster__depth_test(
+                            depth, row + (size_t)x, z,
+                            opts->depth_func, read_only)) {
+                        continue;
+                    }
+
+                    /* Perspective-correct weights: interpolate w_i / w
+                     * and divide by the interpolated 1 / w */
+                    float q0 = b0 * iw0, q1 = b1 * iw1, q2 = b2 * iw2;
+                    float inv_q = 1.0f / (q0 + q1 + q2);
+                    q0 *= inv_q;
+                    q1 *= inv_q;
+                    q2 *= inv_q;
+
+                    pixel.r = q0 * s0->r + q1 * s1->r + q2 * s2->r;
+                    pixel.g = q0 * s0->g + q1 * s1->g + q2 * s2->g;
+                    pixel.b = q0 * s0->b + q1 * s1->b + q2 * s2->b;
+                    pixel.a = q0 * s0->a + q1 * s1->a + q2 * s2->a;
+                    pixel.u = q0 * s0->u + q1 * s1->u + q2 * s2->u;
+                    pixel.v = q0 * s0->v + q1 * s1->v + q2 * s2->v;
+                    forge_raster__span_scalar(
+                        dst + (size_t)x * FORGE_RASTER_BPP, 0, 1, &pixel);
+                }
+            }
+
+            e0.w += e0.step_y;
+            e1.w += e1.step_y;
+            e2.w += e2.step_y;
+        }
+    }
+}
+
+/* ── Triangle Pipeline ───────────────────────────────────────────────────── */
+
+/* Bit i set if p is outside clip plane i */
+static inline int forge_raster__clip_outcode(vec4 p)
+{
+    int code = 0;
+    for (int plane = 0; plane < FORGE_RASTER__CLIP_PLANES; plane++) {
+        if (!(forge_raster__clip_dist(p, plane) >= 0.0f)) code |= 1 << plane;
+    }
+    return code;
+}
+
+/* Clip, project and rasterize one clip-space triangle */
+static inline void forge_raster__draw_3d(ForgeRasterBuffer *buf,
+                                         ForgeRasterDepthBuffer *depth,
+                                         const ForgeRaster3dVertex *v0,
+                                         const ForgeRaster3dVertex *v1,
+                                         const ForgeRaster3dVertex *v2,
+                                         const ForgeRasterTexture *texture,
+                                         const ForgeRaster3dOpts *opts)
+{
+    int c0 = forge_raster__clip_outcode(v0->position);
+    int c1 = forge_raster__clip_outcode(v1->position);
+    int c2 = forge_raster__clip_outcode(v2->position);
+
+    /* All three outside one plane: nothing to draw.  (A NaN coordinate
+     * makes every distance test fail, so it lands here too.) */
+    if (c0 & c1 & c2) return;
+
+    ForgeRaster3dVertex poly[FORGE_RASTER__CLIP_MAX_VERTS];
+    int n;
+    if ((c0 | c1 | c2) == 0) {
+        /* Common case: entirely inside, no clipping */
+        poly[0] = *v0;
+        poly[1] = *v1;
+        poly[2] = *v2;
+        n = 3;
+    } else {
+        n = forge_raster__clip_triangle(v0, v1, v2, c0 | c1 | c2, poly);
+    }
+
+    /* The clipped polygon is convex and keeps the triangle's winding, so
+     * a fan from its first vertex covers it, and its triangles share
+     * edges -- the fill rule keeps them watertight */
+    ForgeRaster__ScreenVertex s[FORGE_RASTER__CLIP_MAX_VERTS];
+    for (int i = 0; i < n; i++) {
+        s[i] = forge_raster__to_screen(&poly[i], buf->width, buf->height);
+    }
+    for (int i = 1; i + 1 < n; i++) {
+        forge_raster__triangle_3d(buf, depth, &s[0], &s[i], &s[i + 1],
+                                  texture, opts);
+    }
+}
+
+static inline void forge_raster_triangles_3d(ForgeRasterBuffer *buf,
+                                             ForgeRasterDepthBuffer *depth,
+                                             const ForgeRaster3dVertex *vertices,
+                                             int vertex_count,
+                                             const Uint32 *indices,
+                                             int index_count,
+                                             const ForgeRasterTexture *texture,
+                                             const ForgeRaster3dOpts *opts)
+{
+    if (!buf || !buf->pixels || !vertices || vertex_count <= 0) return;
+    if (depth && (!depth->depth32 && !depth->depth16)) depth = NULL;
+    if (depth && (depth->width != buf->width ||
+                  depth->height != buf->height)) {
+        SDL_Log("forge_raster_triangles_3d: depth buffer is %dx%d, "
+                "framebuffer is %dx%d", depth->width, depth->height,
+                buf->width, buf->height);
+        return;
+    }
+
+    ForgeRaster3dOpts defaults = { FORGE_RASTER_CULL_BACK,
+                                   FORGE_RASTER_DEPTH_LESS, false };
+    if (!opts) opts = &defaults;
+
+    if (!indices) {
+        for (int i = 0; i + 2 < vertex_count; i += 3) {
+            forge_raster__draw_3d(buf, depth, &vertices[i], &vertices[i + 1],
+                                  &vertices[i + 2], texture, opts);
+        }
+        return;
+    }
+
+    for (int i = 0; i + 2 < index_count; i += 3) {
+        Uint32 i0 = indices[i + 0];
+        Uint32 i1 = indices[i + 1];
+        Uint32 i2 = indices[i + 2];
+
+        /* Validate each index against the vertex array bounds */
+        if (i0 >= (Uint32)vertex_count ||
+            i1 >= (Uint32)vertex_count ||
+            i2 >= (Uint32)vertex_count) {
+            SDL_Log("forge_raster_triangles_3d: index out of bounds "
+                    "(%u, %u, %u) with vertex_count=%d",
+                    (unsigned)i0, (unsigned)i1, (unsigned)i2, vertex_count);
+            continue;
+        }
+        forge_raster__draw_3d(buf, depth, &vertices[i0], &vertices[i1],
+                              &vertices[i2], texture, opts);
+    }
+}
+
+#endif /* FORGE_RASTER_3D_H */
@@ -11,10 +11,14 @@
  *   - head table (unitsPerEm, bounding box, indexToLocFormat)
  *   - hhea table (ascender, descender, lineGap, numberOfHMetrics)
  *   - maxp table (numGlyphs)
- *   - cmap table with format 4 (BMP Unicode to glyph index mapping)
+ *   - cmap table with format 4 (BMP) and format 12 (full Unicode) mapping,
+ *     with an optional precomputed codepoint page table
  *   - loca table (short and long format glyph offsets)
  *   - glyf table (simple glyph outlines with contours, flags, coordinates)
  *   - hmtx table (per-glyph advance widths and left side bearings)
+ *   - Pair kerning from the kern table (format 0) or GPOS pair adjustment
+ *     (the 'kern' feature), merged into one hash at load time
+ *   - UTF-8 text layout
  *   - Glyph rasterization with configurable supersampled anti-aliasing
  *   - Font atlas building (rectangle packing, UV coordinates, glyph metadata)
  *   - Grayscale BMP writing for atlas and glyph visualization
@@ -22,7 +26,8 @@
  * Limitations (intentional for a learning library):
  *   - No compound glyph parsing (detected and skipped with a log message)
  *   - No hinting or grid-fitting instructions
- *   - No kerning (kern table) or advanced positioning (GPOS)
+ *   - Kerning is pair x-advance only: no GPOS mark, cursive, or
+ *     contextual positioning
  *   - No glyph substitution (GSUB)
  *   - No sub-pixel rendering (ClearType-style RGB anti-aliasing)
  *   - TrueType outlines only (no CFF/OpenType outlines)
@@ -50,6 +55,19 @@
 #include <SDL3/SDL.h>
 #include <stdio.h>   /* FILE, fopen, fwrite, fclose for BMP writing */
 #include <limits.h>  /* INT_MAX for text layout validation */
+#include <float.h>   /* FLT_MAX for pixel height validation */
+
+/* SIMD for bulk vertex packing (forge_ui_pack_vertices) and, in
+ * forge_ui_ctx.h, index rebasing.  SSE2 is part of the x86-64 baseline
+ * and NEON of AArch64, so no runtime check is needed; other targets use
+ * the scalar loops. */
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define FORGE_UI__SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define FORGE_UI__SIMD_NEON 1
+#endif
 
 /* ── Public Constants ────────────────────────────────────────────────────── */
 
@@ -109,6 +127,17 @@ typedef struct ForgeUiTtfGlyph {
     ForgeUiPoint *points;        /* absolute coordinates in font units */
 } ForgeUiTtfGlyph;
 
+/* Pair kerning table: an open-addressed hash from a glyph pair to an
+ * x-advance adjustment in font units.  The key is (left << 16) | right;
+ * pairs involving glyph 0 (.notdef) are never stored, so key 0 marks an
+ * empty slot.  Capacity is a power of two kept at most half full. */
+typedef struct ForgeUiKernTable {
+    Uint32 *keys;    /* (left << 16) | right, 0 = empty slot */
+    Sint16 *values;  /* adjustment in font units, added to the left advance */
+    Uint32  mask;    /* capacity - 1 (0 when no table is allocated) */
+    Uint32  count;   /* pairs stored */
+} ForgeUiKernTable;
+
 /* Top-level font structure holding all parsed data. */
 typedef struct ForgeUiFont {
     /* Raw file data (kept for on-demand glyph parsing) */
@@ -132,6 +161,19 @@ typedef struct ForgeUiFont {
     Uint16 *cmap_id_range_offsets;
     const Uint8 *cmap_id_range_base; /* pointer into font data for range calc */
 
+    /* cmap format 12 data (sequential map groups, covers supplementary
+     * planes).  When present it is used instead of format 4. */
+    Uint32  cmap12_group_count; /* number of groups (0 if no format 12) */
+    Uint32 *cmap12_groups;      /* 3 per group: startChar, endChar, startGlyph */
+
+    /* Optional precomputed codepoint -> glyph index table (built at load
+     * time when ForgeUiFontLoadOpts.build_cmap_table is set).  The high
+     * bits of the codepoint select a page, the low byte selects the glyph
+     * index within it, so a lookup is two memory reads. */
+    Uint16 *cmap_page_map;      /* 0x1100 entries: page + 1 (0 = all .notdef) */
+    Uint16 *cmap_pages;         /* 256 glyph indices per allocated page */
+    int     cmap_page_count;    /* number of allocated pages */
+
     /* loca table (glyph offsets into glyf) */
     Uint32 *loca_offsets;       /* numGlyphs + 1 entries, always uint32 */
 
@@ -140,20 +182,44 @@ typedef struct ForgeUiFont {
     Sint16 *hmtx_left_side_bearings; /* numberOfHMetrics entries */
     Uint16  hmtx_last_advance;      /* advance width shared by trailing glyphs */
 
+    /* Pair kerning from GPOS ('kern' feature) or, when GPOS has none, the
+     * legacy kern table.  Empty for fonts without kerning. */
+    ForgeUiKernTable kern;
+
     /* Offsets to key tables within font data */
     Uint32 glyf_offset;        /* start of glyf table in file */
 } ForgeUiFont;
 
+/* Options controlling font loading.  Pass NULL to forge_ui_ttf_load_opts()
+ * for the defaults, which match forge_ui_ttf_load(). */
+typedef struct ForgeUiFontLoadOpts {
+    bool build_cmap_table;  /* precompute the codepoint page table (default false) */
+} ForgeUiFontLoadOpts;
+
 /* ── Rasterization Types ─────────────────────────────────────────────────── */
 
+/* Coverage algorithm used by forge_ui_rasterize_glyph().  SCANLINE and
+ * ACTIVE_EDGE produce bit-identical supersampled coverage and differ only
+ * in speed.  ANALYTIC computes the exact area of each pixel covered by the
+ * outline in a single pass and ignores supersample_level. */
+typedef enum ForgeUiRasterMethod {
+    FORGE_UI_RASTER_SCANLINE    = 0,  /* test every edge on every scanline (default) */
+    FORGE_UI_RASTER_ACTIVE_EDGE = 1,  /* active edge table: only edges spanning the row */
+    FORGE_UI_RASTER_ANALYTIC    = 2   /* exact signed-area coverage, no supersampling */
+} ForgeUiRasterMethod;
+
 /* Options controlling glyph rasterization quality.
  * supersample_level controls anti-aliasing:
  *   1 = no anti-aliasing (binary on/off per pixel)
  *   2 = 2x2 supersampling (4 samples per pixel)
  *   4 = 4x4 supersampling (16 samples per pixel, recommended)
- *   8 = 8x8 supersampling (64 samples per pixel, high quality) */
+ *   8 = 8x8 supersampling (64 samples per pixel, high quality)
+ *
+ * Zero-initialize the struct before setting fields so options added later
+ * keep their defaults. */
 typedef struct ForgeUiRasterOpts {
-    int supersample_level;  /* samples per pixel axis (1, 2, 4, or 8) */
+    int                 supersample_level;  /* samples per pixel axis (1, 2, 4, or 8) */
+    ForgeUiRasterMethod method;             /* coverage algorithm (default SCANLINE) */
 } ForgeUiRasterOpts;
 
 /* A rasterized glyph bitmap — single-channel alpha coverage.
@@ -202,6 +268,66 @@ typedef struct ForgeUiPackedGlyph {
     Uint16      advance_width;  /* horizontal advance in font units */
 } ForgeUiPackedGlyph;
 
+/* Number of 256-codepoint pages needed to cover the Basic Multilingual
+ * Plane (U+0000..U+FFFF) in the atlas lookup page table. */
+#define FORGE_UI_ATLAS_LOOKUP_PAGES 256
+
+/* Default and maximum SDF distance range in atlas texels (see
+ * ForgeUiAtlasOpts.sdf_range). */
+#define FORGE_UI_SDF_DEFAULT_RANGE  4.0f
+#define FORGE_UI_SDF_MAX_RANGE      32.0f
+
+/* Upper bound on ForgeUiAtlasOpts.thread_count. */
+#define FORGE_UI_ATLAS_MAX_THREADS  64
+
+/* Non-power-of-two atlas dimensions are rounded up to a multiple of this,
+ * keeping rows 4-byte aligned for texture uploads. */
+#define FORGE_UI_ATLAS_NPOT_ALIGN   4
+
+/* What the atlas texels encode.
+ *
+ * COVERAGE texels are anti-aliased coverage (0 = empty, 255 = solid) and
+ * look right only at the pixel height they were rasterized at.
+ *
+ * SDF texels are signed distances to the glyph outline: 128 is the outline,
+ * larger values are inside, smaller outside, reaching 255 / 0 at sdf_range
+ * texels from the outline.  Because a distance can be resampled at any
+ * scale, one SDF atlas serves every pixel height; the renderer reconstructs
+ * coverage from the interpolated distance (see forge_raster_sample_sdf). */
+typedef enum ForgeUiAtlasMode {
+    FORGE_UI_ATLAS_COVERAGE = 0,  /* coverage bitmaps (default) */
+    FORGE_UI_ATLAS_SDF      = 1   /* single-channel signed distance field */
+} ForgeUiAtlasMode;
+
+/* How glyph rectangles are placed in the atlas.
+ *
+ * SHELF fills left-to-right rows, each as tall as its tallest glyph, so
+ * short glyphs leave gaps above them.  SKYLINE tracks the top contour of
+ * what has been placed and drops each glyph at the lowest spot it fits
+ * (bottom-left rule), filling most of those gaps. */
+typedef enum ForgeUiAtlasPacker {
+    FORGE_UI_ATLAS_PACK_SHELF   = 0,  /* row-based shelves (default) */
+    FORGE_UI_ATLAS_PACK_SKYLINE = 1   /* skyline, bottom-left placement */
+} ForgeUiAtlasPacker;
+
+/* Options for forge_ui_atlas_build_opts().  Zero-initialize before setting
+ * fields; a zeroed struct (or NULL) builds a power-of-two coverage atlas
+ * with the shelf packer. */
+typedef struct ForgeUiAtlasOpts {
+    ForgeUiAtlasMode mode;       /* texel encoding (default COVERAGE) */
+    float            sdf_range;  /* SDF: texels from outline to 0/255
+                                  * (0 = FORGE_UI_SDF_DEFAULT_RANGE) */
+    int              thread_count; /* threads rasterizing glyphs, including
+                                    * the caller (0 or 1 = serial; clamped
+                                    * to FORGE_UI_ATLAS_MAX_THREADS).  The
+                                    * atlas is byte-identical for any count */
+    ForgeUiAtlasPacker packer;     /* placement algorithm (default SHELF) */
+    bool             non_power_of_two; /* size the atlas to the packed glyphs
+                                        * (width and height multiples of
+                                        * FORGE_UI_ATLAS_NPOT_ALIGN) instead
+                                        * of the next power of two */
+} ForgeUiAtlasOpts;
+
 /* A font atlas — a single texture containing all requested glyphs plus
  * a white pixel region for solid-colored geometry rendering.
  *
@@ -210,8 +336,9 @@ typedef struct ForgeUiPackedGlyph {
  * forge_ui_atlas_build() from the font's head and hhea tables. */
 typedef struct ForgeUiFontAtlas {
     Uint8              *pixels;      /* atlas pixel data (single-channel, row-major) */
-    int                 width;       /* atlas width in pixels (power of two) */
-    int                 height;      /* atlas height in pixels (power of two) */
+    int                 width;       /* atlas width in pixels (power of two
+                                      * unless built with non_power_of_two) */
+    int                 height;      /* atlas height in pixels (likewise) */
     ForgeUiPackedGlyph *glyphs;      /* per-glyph metadata array */
     int                 glyph_count; /* number of packed glyphs */
     ForgeUiUVRect       white_uv;    /* UV rect for the 2x2 white pixel region */
@@ -222,6 +349,50 @@ typedef struct ForgeUiFontAtlas {
     Sint16              ascender;      /* typographic ascender in font units (positive) */
     Sint16              descender;     /* typographic descender in font units (negative) */
     Sint16              line_gap;      /* additional inter-line spacing in font units */
+
+    /* Texel encoding.  Glyph bitmap sizes and bearings are in texels at
+     * raster_pixel_height; text layout scales them by
+     * pixel_height / raster_pixel_height, which is 1 unless an SDF atlas
+     * has been retargeted with forge_ui_atlas_set_pixel_height().  A zero
+     * raster_pixel_height (hand-assembled atlas) means "same as
+     * pixel_height". */
+    ForgeUiAtlasMode    mode;                /* COVERAGE or SDF */
+    float               raster_pixel_height; /* pixel height glyphs were rendered at */
+    float               sdf_range;           /* SDF: texels from outline to 0/255 (else 0) */
+
+    /* Fraction of the texture covered by glyph bitmaps and the white
+     * region (0..1], set by forge_ui_atlas_build.  Track it to catch
+     * glyph sets that waste texture memory. */
+    float               packing_efficiency;
+
+    /* Codepoint lookup tables (built by forge_ui_atlas_build so that
+     * forge_ui_atlas_lookup is constant time).  BMP codepoints resolve
+     * through a two-level page table: the high byte selects a page, the low
+     * byte selects a glyph index within it.  Codepoints above U+FFFF go
+     * through a small open-addressed hash.  Entries are indices into glyphs[]
+     * or -1 for "not present".  When lookup_ready is false (e.g. a
+     * hand-assembled atlas) lookup falls back to a linear scan. */
+    bool                lookup_ready;     /* true once the tables below are valid */
+    Uint16              lookup_page_map[FORGE_UI_ATLAS_LOOKUP_PAGES]; /* high byte -> page + 1 (0 = empty) */
+    Sint32             *lookup_pages;     /* allocated pages, 256 glyph indices each */
+    Sint32             *lookup_hash;      /* supplementary-plane glyph indices (NULL if none) */
+    Uint32              lookup_hash_mask; /* hash capacity - 1 (capacity is a power of two) */
+
+    /* The font's kerning pairs whose glyphs are both in the atlas (set by
+     * forge_ui_atlas_build; empty for fonts without kerning) */
+    ForgeUiKernTable    kern;
+
+    /* On-demand glyph source (NULL for a built atlas).  When set,
+     * forge_ui_atlas_lookup returns lookup_fn(lookup_data, codepoint)
+     * instead of reading glyphs[] and the tables above.  The atlas is then
+     * a view of a glyph cache page (forge_ui_glyph_cache_bind_atlas() in
+     * forge_ui_glyph_cache.h), whose glyphs can move: *lookup_generation
+     * changes whenever a glyph returned earlier may have been evicted or
+     * a lookup failed, so anything that keeps UVs across frames must lay
+     * its text out again. */
+    const ForgeUiPackedGlyph *(*lookup_fn)(void *data, Uint32 codepoint);
+    void               *lookup_data;
+    const Uint64       *lookup_generation;
 } ForgeUiFontAtlas;
 
 /* ── Text Layout Types ──────────────────────────────────────────────────── */
@@ -242,6 +413,32 @@ typedef struct ForgeUiVertex {
     float a;       /* alpha color component [0, 1] */
 } ForgeUiVertex;
 
+/* Vertex layouts a UI context can hand to the renderer. */
+typedef enum ForgeUiVertexFormat {
+    FORGE_UI_VERTEX_FORMAT_FLOAT  = 0, /* ForgeUiVertex, 32 bytes (default) */
+    FORGE_UI_VERTEX_FORMAT_PACKED = 1  /* ForgeUiPackedVertex, 16 bytes */
+} ForgeUiVertexFormat;
+
+/* Compact UI vertex: float2 position, unorm16x2 UV, RGBA8 color.
+ *
+ * Same information as ForgeUiVertex in 16 bytes instead of 32, for UIs
+ * that push enough vertices per frame for upload bandwidth to matter.
+ * Positions stay float (sub-pixel text placement needs them); UVs are
+ * quantized to 1/65535, fine for atlases up to 4096 texels where that
+ * is 1/16 of a texel; colors to 1/255, the precision of an 8-bit
+ * framebuffer anyway.  Matches the GPU vertex formats FLOAT2, USHORT2_NORM,
+ * UBYTE4_NORM at offsets 0, 8, 12. */
+typedef struct ForgeUiPackedVertex {
+    float  pos_x;   /* screen-space x position in pixels */
+    float  pos_y;   /* screen-space y position in pixels */
+    Uint16 uv_u;    /* horizontal atlas coordinate, unorm16 */
+    Uint16 uv_v;    /* vertical atlas coordinate, unorm16 */
+    Uint8  r;       /* red, unorm8 */
+    Uint8  g;       /* green, unorm8 */
+    Uint8  b;       /* blue, unorm8 */
+    Uint8  a;       /* alpha, unorm8 */
+} ForgeUiPackedVertex;
+
 /* Text alignment modes for multi-line text layout. */
 typedef enum ForgeUiTextAlign {
     FORGE_UI_TEXT_ALIGN_LEFT   = 0,  /* left edge flush (default) */
@@ -272,6 +469,30 @@ typedef struct ForgeUiTextLayout {
     int            line_count;   /* number of lines produced */
 } ForgeUiTextLayout;
 
+/* Caller-owned, growable destination for forge_ui_text_layout_into().
+ *
+ * Each field points at storage the caller already owns — typically the
+ * vertex/index arrays of a UI context or window draw list — so glyph
+ * quads are written where they will be drawn from, with no temporary
+ * allocation or second copy.  Arrays are grown with SDL_realloc as
+ * needed; counts are advanced past the appended quads and indices are
+ * based at the vertex count on entry.
+ *
+ * Set indices to NULL to collect vertices only.  When has_clip is true,
+ * quads are trimmed to [clip_x0, clip_x1) x [clip_y0, clip_y1) with
+ * proportional UV remapping, and quads fully outside are dropped. */
+typedef struct ForgeUiTextSink {
+    ForgeUiVertex **vertices;        /* vertex array (may be *NULL) */
+    int            *vertex_count;    /* vertices in use */
+    int            *vertex_capacity; /* allocated vertices */
+    Uint32        **indices;         /* index array, or NULL for none */
+    int            *index_count;     /* indices in use */
+    int            *index_capacity;  /* allocated indices */
+    bool            has_clip;        /* trim quads to the clip rectangle */
+    float           clip_x0, clip_y0; /* clip rectangle, top-left */
+    float           clip_x1, clip_y1; /* clip rectangle, bottom-right */
+} ForgeUiTextSink;
+
 /* Text measurement result — bounding box without generating vertices. */
 typedef struct ForgeUiTextMetrics {
     float  width;       /* total bounding box width in pixels */
@@ -279,6 +500,69 @@ typedef struct ForgeUiTextMetrics {
     int    line_count;  /* number of lines */
 } ForgeUiTextMetrics;
 
+/* Paragraph internals (see ForgeUiParagraph).  An item is one glyph, or a
+ * tab or newline, with its pixel advance and its kerning against the
+ * previous glyph.  A run is the glyphs between two tabs or newlines. */
+typedef struct ForgeUi__ParagraphItem {
+    Sint32 glyph;    /* index into atlas->glyphs, or FORGE_UI__PARA_TAB /
+                      * FORGE_UI__PARA_NEWLINE */
+    float  kern;     /* pixels added before this glyph */
+    float  advance;  /* glyph advance in pixels */
+} ForgeUi__ParagraphItem;
+
+typedef struct ForgeUi__ParagraphRun {
+    int  first;      /* first item of the run */
+    int  end;        /* one past the last; items[end] is a tab or newline
+                      * unless end == item_count */
+    bool monotone;   /* no item has kern + advance < 0 (binary-searchable) */
+} ForgeUi__ParagraphRun;
+
+typedef struct ForgeUi__ParagraphLine {
+    int   first;     /* first item on the line */
+    int   end;       /* one past the last item */
+    bool  wrapped;   /* starts at a wrap point: the first glyph is unkerned */
+    float width;     /* pen advance across the line in pixels */
+} ForgeUi__ParagraphLine;
+
+/* A block of text prepared once for repeated wrapping and drawing.
+ *
+ * forge_ui_paragraph_init() decodes the text and resolves every glyph,
+ * advance, and kerning pair up front, and keeps running sums of the
+ * advances.  Wrapping at a width then binary-searches those sums for each
+ * line break, so it costs O(lines * log n) rather than a pass over the
+ * text, and the line breaks are kept until the width changes: measuring
+ * and laying out again at the same width does no wrapping work at all.
+ * Lines break where forge_ui_text_layout() breaks them; the running sums
+ * are doubles, so only a glyph ending within float rounding of the width
+ * can land on the other side of a break.
+ *
+ * The paragraph refers to its atlas, which must outlive it; rebuild it
+ * after forge_ui_atlas_set_pixel_height().  The atlas must be built (not
+ * a glyph cache view with a lookup_fn).  Fields are read-only. */
+typedef struct ForgeUiParagraph {
+    const ForgeUiFontAtlas *atlas;      /* atlas the glyphs come from */
+    float                   pixel_height; /* atlas height at init */
+    ForgeUi__ParagraphItem *items;      /* glyphs, tabs, and newlines */
+    int                     item_count;
+    double                 *sums;       /* sums[i]: kern + advance of items
+                                         * [0, i), tabs and newlines as 0 */
+    ForgeUi__ParagraphRun  *runs;       /* glyph runs in text order */
+    int                     run_count;
+    int                     quad_count; /* items that draw a quad */
+    float                   line_height; /* pixels between baselines */
+    float                   tab_width;   /* tab stop spacing in pixels */
+    float                   ink_top;     /* highest glyph top above the
+                                          * baseline, in pixels */
+    float                   ink_bottom;  /* lowest glyph bottom below it */
+
+    /* Wrap cache: line breaks for wrap_width (< 0 when none) */
+    float                   wrap_width;
+    ForgeUi__ParagraphLine *lines;
+    int                     line_count;
+    int                     line_capacity;
+    float                   max_line_width; /* widest line at wrap_width */
+} ForgeUiParagraph;
+
 /* ── Public API ──────────────────────────────────────────────────────────── */
 
 /* Load a TTF font file and parse its table directory and core tables.
@@ -286,10 +570,21 @@ typedef struct ForgeUiTextMetrics {
  * The font must be freed with forge_ui_ttf_free() when no longer needed. */
 static bool forge_ui_ttf_load(const char *path, ForgeUiFont *out_font);
 
+/* Load a TTF font with options.  With build_cmap_table set, every mapped
+ * codepoint is resolved once at load time into a two-level page table so
+ * forge_ui_ttf_glyph_index() no longer walks the cmap segments.  The table
+ * costs about 9 KB plus 512 bytes per 256-codepoint page in use.
+ * opts may be NULL for the defaults. */
+static bool forge_ui_ttf_load_opts(const char *path,
+                                    const ForgeUiFontLoadOpts *opts,
+                                    ForgeUiFont *out_font);
+
 /* Free all memory allocated by forge_ui_ttf_load(). */
 static void forge_ui_ttf_free(ForgeUiFont *font);
 
 /* Look up the glyph index for a Unicode codepoint using the cmap table.
+ * Uses the precomputed page table when present, otherwise format 12 (binary
+ * search over groups) or format 4 (segment scan).
  * Returns 0 (the .notdef glyph) if the codepoint is not mapped. */
 static Uint16 forge_ui_ttf_glyph_index(const ForgeUiFont *font,
                                         Uint32 codepoint);
@@ -329,6 +624,28 @@ static bool forge_ui_rasterize_glyph(const ForgeUiFont *font,
 /* Free pixel data allocated by forge_ui_rasterize_glyph(). */
 static void forge_ui_glyph_bitmap_free(ForgeUiGlyphBitmap *bitmap);
 
+/* Render a glyph as a signed distance field instead of coverage.
+ *
+ * Each texel stores the distance from its center to the nearest point on
+ * the glyph outline, computed from the contour lines and quadratic curves
+ * (curves are subdivided finely enough that the error stays far below one
+ * 8-bit step).  The stored value is 255 * (0.5 + distance / (2 * sdf_range))
+ * clamped to [0, 255], with distance positive inside the glyph.  The bitmap
+ * is enlarged by ceil(sdf_range) texels on every side so the field can fall
+ * off fully outside the glyph, and the bearings account for that margin.
+ *
+ * Parameters are as for forge_ui_rasterize_glyph(); sdf_range is in texels
+ * (0 < sdf_range <= FORGE_UI_SDF_MAX_RANGE).  Free the result with
+ * forge_ui_glyph_bitmap_free().
+ *
+ * Returns true on success, false on error (logged via SDL_Log).
+ * Returns true with zero-size bitmap for whitespace glyphs (no contours). */
+static bool forge_ui_rasterize_glyph_sdf(const ForgeUiFont *font,
+                                          Uint16 glyph_index,
+                                          float pixel_height,
+                                          float sdf_range,
+                                          ForgeUiGlyphBitmap *out_bitmap);
+
 /* ── hmtx API ───────────────────────────────────────────────────────────── */
 
 /* Look up the advance width (in font units) for a glyph index.
@@ -342,6 +659,14 @@ static void forge_ui_glyph_bitmap_free(ForgeUiGlyphBitmap *bitmap);
 static Uint16 forge_ui_ttf_advance_width(const ForgeUiFont *font,
                                           Uint16 glyph_index);
 
+/* ── Kerning API ────────────────────────────────────────────────────────── */
+
+/* Pair kerning adjustment (in font units) to add to the pen after the left
+ * glyph when the right glyph follows it.  Usually negative ("AV", "To").
+ * Returns 0 for pairs the font does not kern. */
+static Sint16 forge_ui_ttf_kerning(const ForgeUiFont *font,
+                                    Uint16 left_glyph, Uint16 right_glyph);
+
 /* ── Font Atlas API ─────────────────────────────────────────────────────── */
 
 /* Build a font atlas from a set of codepoints.
@@ -367,22 +692,68 @@ static bool forge_ui_atlas_build(const ForgeUiFont *font,
                                   int padding,
                                   ForgeUiFontAtlas *out_atlas);
 
+/* Build a font atlas with explicit options — forge_ui_atlas_build() is
+ * this function with opts == NULL.  With opts->mode == FORGE_UI_ATLAS_SDF
+ * the glyphs are stored as distance fields (forge_ui_rasterize_glyph_sdf)
+ * and the atlas can later be retargeted to any pixel height with
+ * forge_ui_atlas_set_pixel_height() instead of being rebuilt.  Build SDF
+ * atlases at a moderate height (32–64 px); larger text stays sharp because
+ * the distance field, not the texels, defines the edge.
+ *
+ * opts->packer and opts->non_power_of_two trade the default shelf packing
+ * and power-of-two size for a denser texture; the result's
+ * packing_efficiency shows how much of it the glyphs use. */
+static bool forge_ui_atlas_build_opts(const ForgeUiFont *font,
+                                       float pixel_height,
+                                       const Uint32 *codepoints,
+                                       int codepoint_count,
+                                       int padding,
+                                       const ForgeUiAtlasOpts *opts,
+                                       ForgeUiFontAtlas *out_atlas);
+
 /* Free all memory allocated by forge_ui_atlas_build(). */
 static void forge_ui_atlas_free(ForgeUiFontAtlas *atlas);
 
+/* Change the pixel height text is laid out at.  Only SDF atlases can be
+ * retargeted; for coverage atlases this fails (logged) unless pixel_height
+ * equals the height the atlas was built at.  Layout and measurement pick
+ * up the new height immediately, so a UI scale change becomes one call
+ * rather than an atlas rebuild.  Returns true on success. */
+static bool forge_ui_atlas_set_pixel_height(ForgeUiFontAtlas *atlas,
+                                             float pixel_height);
+
+/* Distance range of an SDF atlas in screen pixels at its current
+ * pixel_height: the screen distance between texel values 0 and 255.
+ * Renderers turn a sampled distance d in [0, 1] into coverage with
+ *   alpha = clamp((d - 0.5) * screen_range + 0.5, 0, 1)
+ * Returns 0 for coverage atlases. */
+static float forge_ui_atlas_sdf_screen_range(const ForgeUiFontAtlas *atlas);
+
 /* Look up a packed glyph by codepoint.
  * Returns a pointer to the ForgeUiPackedGlyph or NULL if not found.
- * The returned pointer is valid until the atlas is freed. */
+ * Constant time for atlases built by forge_ui_atlas_build(); if the same
+ * codepoint was requested more than once, the first packed entry wins.
+ * The returned pointer is valid until the atlas is freed; for an atlas
+ * with a lookup_fn, until the source says otherwise. */
 static const ForgeUiPackedGlyph *forge_ui_atlas_lookup(
     const ForgeUiFontAtlas *atlas, Uint32 codepoint);
 
+/* Pair kerning between two atlas glyphs (by glyph index, see
+ * ForgeUiPackedGlyph.glyph_index), in font units.  Same values as
+ * forge_ui_ttf_kerning() for glyphs in the atlas; 0 otherwise. */
+static Sint16 forge_ui_atlas_kerning(const ForgeUiFontAtlas *atlas,
+                                      Uint16 left_glyph, Uint16 right_glyph);
+
 /* ── Text Layout API ────────────────────────────────────────────────────── */
 
 /* Lay out a string of text into positioned, textured quads.
  *
- * Converts an ASCII string into vertex and index arrays suitable for GPU
+ * Converts a UTF-8 string into vertex and index arrays suitable for GPU
  * rendering.  Each visible character becomes a quad (4 vertices, 6 indices)
  * with screen-space positions, atlas UV coordinates, and per-vertex color.
+ * Codepoints missing from the atlas are skipped; a malformed UTF-8 byte
+ * decodes to U+FFFD (drawn only if the atlas has it).  Glyph pairs the font
+ * kerns are moved closer or apart by the atlas's kerning table.
  *
  * Coordinates use a screen-space convention: origin at top-left, x increases
  * rightward, y increases downward.  The (x, y) parameter specifies the pen
@@ -391,7 +762,7 @@ static const ForgeUiPackedGlyph *forge_ui_atlas_lookup(
  *
  * Parameters:
  *   atlas      — font atlas with glyph metadata and font metrics
- *   text       — null-terminated ASCII string to lay out
+ *   text       — null-terminated UTF-8 string to lay out
  *   x, y       — starting pen position (x = left edge, y = baseline)
  *   opts       — layout options (NULL for defaults: no wrap, left align, white)
  *   out_layout — receives vertex/index arrays; caller must free with
@@ -407,6 +778,40 @@ static bool forge_ui_text_layout(const ForgeUiFontAtlas *atlas,
 /* Free vertex and index arrays allocated by forge_ui_text_layout(). */
 static void forge_ui_text_layout_free(ForgeUiTextLayout *layout);
 
+/* Lay out a string and append its quads to a caller-owned sink.
+ *
+ * Same layout as forge_ui_text_layout(), but nothing is allocated beyond
+ * growing the sink's arrays, which amortizes to zero once they reach
+ * their working size.  Alignment is applied before clipping, so clipped
+ * output matches clipping the forge_ui_text_layout() result quad by quad.
+ *
+ * Parameters:
+ *   atlas       — font atlas with glyph metadata and font metrics
+ *   text        — null-terminated UTF-8 string to lay out
+ *   x, y        — starting pen position (x = left edge, y = baseline)
+ *   opts        — layout options (NULL for defaults)
+ *   sink        — destination arrays (see ForgeUiTextSink)
+ *   out_metrics — receives the unclipped bounding box (may be NULL)
+ *
+ * Returns true on success, false on error (logged via SDL_Log); on
+ * failure the sink's counts are left unchanged. */
+static bool forge_ui_text_layout_into(const ForgeUiFontAtlas *atlas,
+                                       const char *text,
+                                       float x, float y,
+                                       const ForgeUiTextOpts *opts,
+                                       const ForgeUiTextSink *sink,
+                                       ForgeUiTextMetrics *out_metrics);
+
+/* Convert count vertices to the packed layout.  UVs and colors are
+ * clamped to [0, 1] and rounded to nearest.  src and dst must not
+ * overlap. */
+static void forge_ui_pack_vertices(const ForgeUiVertex *src,
+                                   ForgeUiPackedVertex *dst, int count);
+
+/* Convert count packed vertices back to floats (for tools and tests). */
+static void forge_ui_unpack_vertices(const ForgeUiPackedVertex *src,
+                                     ForgeUiVertex *dst, int count);
+
 /* Measure text dimensions without generating vertices.
  *
  * Performs the same layout calculation as forge_ui_text_layout() but only
@@ -416,7 +821,7 @@ static void forge_ui_text_layout_free(ForgeUiTextLayout *layout);
  *
  * Parameters:
  *   atlas — font atlas with glyph metadata and font metrics
- *   text  — null-terminated ASCII string to measure
+ *   text  — null-terminated UTF-8 string to measure
  *   opts  — layout options (max_width, alignment affect wrapping)
  *
  * Returns a ForgeUiTextMetrics with width, height, and line count. */
@@ -424,6 +829,39 @@ static ForgeUiTextMetrics forge_ui_text_measure(const ForgeUiFontAtlas *atlas,
                                                  const char *text,
                                                  const ForgeUiTextOpts *opts);
 
+/* ── Paragraph API ──────────────────────────────────────────────────────── */
+
+/* Prepare a UTF-8 string for repeated wrapping (see ForgeUiParagraph).
+ * The text is not referenced afterwards.  Returns true on success, false
+ * on error (logged via SDL_Log); free with forge_ui_paragraph_free(). */
+static bool forge_ui_paragraph_init(const ForgeUiFontAtlas *atlas,
+                                     const char *text,
+                                     ForgeUiParagraph *out_para);
+
+/* Free a paragraph's arrays. */
+static void forge_ui_paragraph_free(ForgeUiParagraph *para);
+
+/* Measure the paragraph wrapped at opts->max_width (0 = no wrap, opts may
+ * be NULL).  Matches forge_ui_text_measure() on the original text, except
+ * where a glyph ends within float rounding of the wrap width and the
+ * break lands on the other side (see ForgeUiParagraph).
+ * Only a new width re-wraps; measuring again at the last width reads the
+ * cached line breaks. */
+static ForgeUiTextMetrics forge_ui_paragraph_measure(ForgeUiParagraph *para,
+                                                     const ForgeUiTextOpts *opts);
+
+/* Lay out the paragraph into a sink, like forge_ui_text_layout_into() on
+ * the original text: the same quads for the same line breaks, but with no
+ * glyph lookups or kerning queries, and line breaks from the wrap cache
+ * (which can differ at float-rounding edges, see ForgeUiParagraph).  When
+ * the sink clips, lines entirely above or below the clip rect are skipped
+ * without visiting their glyphs.  Returns false on error (logged via SDL_Log). */
+static bool forge_ui_paragraph_layout_into(ForgeUiParagraph *para,
+                                            float x, float y,
+                                            const ForgeUiTextOpts *opts,
+                                            const ForgeUiTextSink *sink,
+                                            ForgeUiTextMetrics *out_metrics);
+
 /* ── BMP Writing (internal helper) ──────────────────────────────────────── */
 
 /* Write a single-channel grayscale bitmap as a BMP file.
@@ -659,10 +1097,13 @@ static bool forge_ui__parse_maxp(ForgeUiFont *font)
     return true;
 }
 
-/* ── cmap table parsing (format 4) ───────────────────────────────────────── */
+/* ── cmap table parsing (formats 4 and 12) ───────────────────────────────── */
 /* The cmap table maps Unicode codepoints to glyph indices.  We look for a
  * platform 3 (Windows) / encoding 1 (Unicode BMP) subtable, or platform 0
- * (Unicode) as a fallback, then parse format 4 (segmented mapping).
+ * (Unicode) as a fallback, then parse format 4 (segmented mapping).  If the
+ * font also has a full-repertoire subtable (platform 3 / encoding 10, or
+ * platform 0) in format 12, that is parsed too so supplementary-plane
+ * codepoints (emoji, historic scripts, CJK extensions) resolve.
  *
  * Format 4 structure (after the subtable header):
  *   offset 0:  format          (uint16, must be 4)
@@ -675,90 +1116,25 @@ static bool forge_ui__parse_maxp(ForgeUiFont *font)
  *   then:      reservedPad     (uint16)
  *   then:      startCode[]     (uint16 * segCount)
  *   then:      idDelta[]       (int16 * segCount)
- *   then:      idRangeOffset[] (uint16 * segCount) */
-
-static bool forge_ui__parse_cmap(ForgeUiFont *font)
+ *   then:      idRangeOffset[] (uint16 * segCount)
+ *
+ * Format 12 structure:
+ *   offset 0:  format          (uint16, must be 12)
+ *   offset 2:  reserved        (uint16)
+ *   offset 4:  length          (uint32)
+ *   offset 8:  language        (uint32)
+ *   offset 12: numGroups       (uint32)
+ *   offset 16: groups[]        (numGroups * 12 bytes:
+ *                               startCharCode, endCharCode, startGlyphID) */
+
+#define FORGE_UI__CMAP12_HEADER_SIZE  16
+#define FORGE_UI__CMAP12_GROUP_SIZE   12
+#define FORGE_UI__CMAP_MAX_CODEPOINT  0x10FFFFu
+
+static bool forge_ui__parse_cmap_format4(ForgeUiFont *font,
+                                          const Uint8 *sub, size_t sub_avail)
 {
-    const ForgeUiTtfTableEntry *t = forge_ui__find_table(font, "cmap");
-    if (!t) {
-        SDL_Log("forge_ui__parse_cmap: 'cmap' table not found");
-        return false;
-    }
-
-    const Uint8 *cmap = font->data + t->offset;
-    Uint32 cmap_length = t->length;
-
-    /* The cmap header has version (uint16) and numTables (uint16) -- 4 bytes */
-    if (cmap_length < 4) {
-        SDL_Log("forge_ui__parse_cmap: 'cmap' table too small for header "
-                "(%u bytes)", cmap_length);
-        return false;
-    }
-
-    Uint16 num_subtables = forge_ui__read_u16(cmap + 2);
-
-    /* Validate that the subtable records fit within the cmap table.
-     * Each record is 8 bytes, starting at offset 4. */
-    size_t records_end = (size_t)num_subtables * 8 + 4;
-    if (records_end < 4 || records_end > cmap_length) {
-        SDL_Log("forge_ui__parse_cmap: %u subtable records exceed cmap "
-                "table length (%u bytes)", num_subtables, cmap_length);
-        return false;
-    }
-
-    /* Search for a suitable subtable:
-     * Priority 1: platform 3 (Windows), encoding 1 (Unicode BMP)
-     * Priority 2: platform 0 (Unicode), any encoding */
-    Uint32 subtable_offset = 0;
-    bool found = false;
-
-    for (Uint16 i = 0; i < num_subtables; i++) {
-        size_t rec_off = 4 + (size_t)i * 8;
-        if (rec_off + 8 > cmap_length) {
-            SDL_Log("forge_ui__parse_cmap: subtable record %u extends past "
-                    "cmap table", i);
-            return false;
-        }
-        const Uint8 *rec = cmap + rec_off;
-        Uint16 platform = forge_ui__read_u16(rec);
-        Uint16 encoding = forge_ui__read_u16(rec + 2);
-        Uint32 offset   = forge_ui__read_u32(rec + 4);
-
-        if (platform == 3 && encoding == 1) {
-            subtable_offset = offset;
-            found = true;
-            break; /* Best match -- stop searching */
-        }
-        if (platform == 0 && !found) {
-            subtable_offset = offset;
-            found = true;
-            /* Keep searching in case platform 3 appears later */
-        }
-    }
-
-    if (!found) {
-        SDL_Log("forge_ui__parse_cmap: no Unicode cmap subtable found");
-        return false;
-    }
-
-    /* Validate subtable offset before reading the format field */
-    if (subtable_offset + 2 > cmap_length) {
-        SDL_Log("forge_ui__parse_cmap: subtable offset %u exceeds cmap "
-                "table length (%u)", subtable_offset, cmap_length);
-        return false;
-    }
-
-    /* Parse the subtable -- we only support format 4 */
-    const Uint8 *sub = cmap + subtable_offset;
-    Uint16 format = forge_ui__read_u16(sub);
-    if (format != 4) {
-        SDL_Log("forge_ui__parse_cmap: unsupported cmap format %u "
-                "(only format 4 is implemented)", format);
-        return false;
-    }
-
     /* Format 4 header is 14 bytes; validate before reading fields */
-    size_t sub_avail = cmap_length - subtable_offset;
     if (sub_avail < 14) {
         SDL_Log("forge_ui__parse_cmap: format 4 subtable header truncated "
                 "(%zu bytes available)", sub_avail);
@@ -837,6 +1213,344 @@ static bool forge_ui__parse_cmap(ForgeUiFont *font)
     return true;
 }
 
+static bool forge_ui__parse_cmap_format12(ForgeUiFont *font,
+                                           const Uint8 *sub, size_t sub_avail)
+{
+    if (sub_avail < FORGE_UI__CMAP12_HEADER_SIZE) {
+        SDL_Log("forge_ui__parse_cmap: format 12 subtable header truncated "
+                "(%zu bytes available)", sub_avail);
+        return false;
+    }
+
+    Uint32 num_groups = forge_ui__read_u32(sub + 12);
+    if (num_groups == 0 ||
+        num_groups > (sub_avail - FORGE_UI__CMAP12_HEADER_SIZE) /
+                     FORGE_UI__CMAP12_GROUP_SIZE) {
+        SDL_Log("forge_ui__parse_cmap: format 12 has %u groups but subtable "
+                "has %zu bytes", num_groups, sub_avail);
+        return false;
+    }
+
+    Uint32 *groups = (Uint32 *)SDL_malloc(sizeof(Uint32) * 3 * (size_t)num_groups);
+    if (!groups) {
+        SDL_Log("forge_ui__parse_cmap: allocation failed (format 12)");
+        return false;
+    }
+
+    /* The spec requires groups sorted by startCharCode and non-overlapping.
+     * Enforcing it here keeps both the binary search and the page-table
+     * build (which walks every mapped codepoint once) well defined. */
+    const Uint8 *g = sub + FORGE_UI__CMAP12_HEADER_SIZE;
+    for (Uint32 i = 0; i < num_groups; i++, g += FORGE_UI__CMAP12_GROUP_SIZE) {
+        Uint32 start = forge_ui__read_u32(g);
+        Uint32 end   = forge_ui__read_u32(g + 4);
+        Uint32 glyph = forge_ui__read_u32(g + 8);
+        if (start > end || end > FORGE_UI__CMAP_MAX_CODEPOINT ||
+            (i > 0 && start <= groups[(i - 1) * 3 + 1])) {
+            SDL_Log("forge_ui__parse_cmap: format 12 group %u is unsorted "
+                    "or out of range (U+%04X..U+%04X)", i, start, end);
+            SDL_free(groups);
+            return false;
+        }
+        groups[i * 3 + 0] = start;
+        groups[i * 3 + 1] = end;
+        groups[i * 3 + 2] = glyph;
+    }
+
+    font->cmap12_groups      = groups;
+    font->cmap12_group_count = num_groups;
+    return true;
+}
+
+static bool forge_ui__parse_cmap(ForgeUiFont *font)
+{
+    const ForgeUiTtfTableEntry *t = forge_ui__find_table(font, "cmap");
+    if (!t) {
+        SDL_Log("forge_ui__parse_cmap: 'cmap' table not found");
+        return false;
+    }
+
+    const Uint8 *cmap = font->data + t->offset;
+    Uint32 cmap_length = t->length;
+
+    /* The cmap header has version (uint16) and numTables (uint16) -- 4 bytes */
+    if (cmap_length < 4) {
+        SDL_Log("forge_ui__parse_cmap: 'cmap' table too small for header "
+                "(%u bytes)", cmap_length);
+        return false;
+    }
+
+    Uint16 num_subtables = forge_ui__read_u16(cmap + 2);
+
+    /* Validate that the subtable records fit within the cmap table.
+     * Each record is 8 bytes, starting at offset 4. */
+    size_t records_end = (size_t)num_subtables * 8 + 4;
+    if (records_end < 4 || records_end > cmap_length) {
+        SDL_Log("forge_ui__parse_cmap: %u subtable records exceed cmap "
+                "table length (%u bytes)", num_subtables, cmap_length);
+        return false;
+    }
+
+    /* Search for suitable subtables:
+     * BMP priority 1: platform 3 (Windows), encoding 1 (Unicode BMP)
+     * BMP priority 2: platform 0 (Unicode), any encoding
+     * Full repertoire: platform 3 / encoding 10, or platform 0, in format 12 */
+    Uint32 subtable_offset = 0;
+    bool found = false;
+    bool found_best = false;
+    Uint32 format12_offset = 0;
+    bool found12 = false;
+
+    for (Uint16 i = 0; i < num_subtables; i++) {
+        size_t rec_off = 4 + (size_t)i * 8;
+        if (rec_off + 8 > cmap_length) {
+            SDL_Log("forge_ui__parse_cmap: subtable record %u extends past "
+                    "cmap table", i);
+            return false;
+        }
+        const Uint8 *rec = cmap + rec_off;
+        Uint16 platform = forge_ui__read_u16(rec);
+        Uint16 encoding = forge_ui__read_u16(rec + 2);
+        Uint32 offset   = forge_ui__read_u32(rec + 4);
+
+        /* Peek at the format so a platform 0 format 12 subtable is not
+         * mistaken for the BMP subtable */
+        Uint16 sub_format = 0;
+        if ((size_t)offset + 2 <= cmap_length) {
+            sub_format = forge_ui__read_u16(cmap + offset);
+        }
+
+        if (sub_format == 12) {
+            if (!found12 &&
+                ((platform == 3 && encoding == 10) || platform == 0)) {
+                format12_offset = offset;
+                found12 = true;
+            }
+            continue;
+        }
+
+        if (platform == 3 && encoding == 1 && !found_best) {
+            subtable_offset = offset;
+            found = true;
+            found_best = true; /* Best BMP match -- keep looking for format 12 */
+            continue;
+        }
+        if (platform == 0 && !found) {
+            subtable_offset = offset;
+            found = true;
+            /* Keep searching in case platform 3 appears later */
+        }
+    }
+
+    if (!found && !found12) {
+        SDL_Log("forge_ui__parse_cmap: no Unicode cmap subtable found");
+        return false;
+    }
+
+    if (found) {
+        /* Validate subtable offset before reading the format field */
+        if ((size_t)subtable_offset + 2 > cmap_length) {
+            SDL_Log("forge_ui__parse_cmap: subtable offset %u exceeds cmap "
+                    "table length (%u)", subtable_offset, cmap_length);
+            return false;
+        }
+
+        /* The BMP subtable must be format 4 */
+        const Uint8 *sub = cmap + subtable_offset;
+        Uint16 format = forge_ui__read_u16(sub);
+        if (format != 4) {
+            SDL_Log("forge_ui__parse_cmap: unsupported cmap format %u "
+                    "(only formats 4 and 12 are implemented)", format);
+            return false;
+        }
+
+        if (!forge_ui__parse_cmap_format4(font, sub,
+                                          cmap_length - subtable_offset)) {
+            return false;
+        }
+    }
+
+    if (found12) {
+        /* A malformed format 12 subtable is not fatal when format 4 is
+         * available -- the font still works for the BMP. */
+        bool ok = forge_ui__parse_cmap_format12(
+            font, cmap + format12_offset, cmap_length - format12_offset);
+        if (!ok && !found) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* ── cmap lookups ────────────────────────────────────────────────────────── */
+
+/* Resolve a codepoint within format 4 segment i (startCode <= cp <= endCode).
+ * Returns 0 (.notdef) if the glyph array reference is out of bounds. */
+static Uint16 forge_ui__cmap4_segment_glyph(const ForgeUiFont *font,
+                                             Uint16 i, Uint16 cp)
+{
+    if (font->cmap_id_range_offsets[i] == 0) {
+        /* Simple case: glyph index = codepoint + idDelta */
+        return (Uint16)(cp + font->cmap_id_deltas[i]);
+    }
+
+    /* Complex case: use idRangeOffset to index into a glyph array.
+     * The formula from the spec:
+     *   addr = idRangeOffset[i] + 2*(cp - startCode[i])
+     *          + &idRangeOffset[i]
+     *   glyph_index = *addr
+     *   if (glyph_index != 0) glyph_index += idDelta[i] */
+    Uint32 range_offset = font->cmap_id_range_offsets[i];
+    Uint32 char_offset = (Uint32)(cp - font->cmap_start_codes[i]);
+    size_t byte_offset = (size_t)i * 2 +
+                         (size_t)range_offset +
+                         (size_t)char_offset * 2;
+    const Uint8 *glyph_addr = font->cmap_id_range_base + byte_offset;
+
+    /* Validate that glyph_addr + 2 is within the font buffer */
+    if (glyph_addr < font->data ||
+        glyph_addr + 2 > font->data + font->data_size) {
+        return 0; /* out-of-bounds — return .notdef */
+    }
+
+    Uint16 glyph_index = forge_ui__read_u16(glyph_addr);
+    if (glyph_index != 0) {
+        glyph_index = (Uint16)(glyph_index + font->cmap_id_deltas[i]);
+    }
+    return glyph_index;
+}
+
+/* Glyph index for codepoint c in a format 12 group.  Glyph indices beyond
+ * the 16-bit range cannot exist in a TrueType font and map to .notdef. */
+static Uint16 forge_ui__cmap12_group_glyph(const Uint32 *group, Uint32 c)
+{
+    Uint32 glyph = group[2] + (c - group[0]);
+    return (glyph > 0xFFFF || glyph < group[2]) ? 0 : (Uint16)glyph;
+}
+
+/* Binary search the format 12 groups (sorted, non-overlapping). */
+static Uint16 forge_ui__cmap12_lookup(const ForgeUiFont *font, Uint32 c)
+{
+    Uint32 lo = 0;
+    Uint32 hi = font->cmap12_group_count;
+    while (lo < hi) {
+        Uint32 mid = lo + (hi - lo) / 2;
+        const Uint32 *group = &font->cmap12_groups[mid * 3];
+        if (c < group[0]) {
+            hi = mid;
+        } else if (c > group[1]) {
+            lo = mid + 1;
+        } else {
+            return forge_ui__cmap12_group_glyph(group, c);
+        }
+    }
+    return 0;
+}
+
+/* ── cmap page table ─────────────────────────────────────────────────────── */
+/* Two-level codepoint -> glyph index table.  The top level has one entry
+ * per 256-codepoint page across all of Unicode (0x1100 pages); only pages
+ * with at least one mapped glyph are allocated.  Built by walking every
+ * mapped codepoint once, so the result is exactly what the segment or
+ * group lookups would return. */
+
+#define FORGE_UI__CMAP_PAGE_SHIFT  8
+#define FORGE_UI__CMAP_PAGE_SIZE   256
+#define FORGE_UI__CMAP_PAGE_MASK   0xFFu
+#define FORGE_UI__CMAP_PAGE_COUNT  ((FORGE_UI__CMAP_MAX_CODEPOINT + 1) >> \
+                                    FORGE_UI__CMAP_PAGE_SHIFT)
+
+/* Store one mapping, allocating its page on first use.  *page_cap tracks
+ * the capacity of font->cmap_pages in pages. */
+static bool forge_ui__cmap_table_set(ForgeUiFont *font, int *page_cap,
+                                     Uint32 c, Uint16 glyph)
+{
+    Uint32 hi = c >> FORGE_UI__CMAP_PAGE_SHIFT;
+    if (font->cmap_page_map[hi] == 0) {
+        if (font->cmap_page_count == *page_cap) {
+            int new_cap = *page_cap ? *page_cap * 2 : 16;
+            Uint16 *grown = (Uint16 *)SDL_realloc(font->cmap_pages,
+                sizeof(Uint16) * FORGE_UI__CMAP_PAGE_SIZE * (size_t)new_cap);
+            if (!grown) {
+                SDL_Log("forge_ui__build_cmap_table: allocation failed "
+                        "(%d pages)", new_cap);
+                return false;
+            }
+            font->cmap_pages = grown;
+            *page_cap = new_cap;
+        }
+        SDL_memset(font->cmap_pages +
+                   (size_t)font->cmap_page_count * FORGE_UI__CMAP_PAGE_SIZE,
+                   0, sizeof(Uint16) * FORGE_UI__CMAP_PAGE_SIZE);
+        font->cmap_page_map[hi] = (Uint16)(++font->cmap_page_count);
+    }
+    font->cmap_pages[(size_t)(font->cmap_page_map[hi] - 1) *
+                     FORGE_UI__CMAP_PAGE_SIZE +
+                     (c & FORGE_UI__CMAP_PAGE_MASK)] = glyph;
+    return true;
+}
+
+static bool forge_ui__build_cmap_table(ForgeUiFont *font)
+{
+    font->cmap_page_map = (Uint16 *)SDL_calloc(FORGE_UI__CMAP_PAGE_COUNT,
+                                               sizeof(Uint16));
+    if (!font->cmap_page_map) {
+        SDL_Log("forge_ui__build_cmap_table: allocation failed (page map)");
+        return false;
+    }
+    font->cmap_pages = NULL;
+    font->cmap_page_count = 0;
+    int page_cap = 0;
+    bool ok = true;
+
+    if (font->cmap12_group_count > 0) {
+        for (Uint32 gi = 0; ok && gi < font->cmap12_group_count; gi++) {
+            const Uint32 *group = &font->cmap12_groups[gi * 3];
+            for (Uint32 c = group[0]; ; c++) {
+                Uint16 glyph = forge_ui__cmap12_group_glyph(group, c);
+                if (glyph != 0 &&
+                    !forge_ui__cmap_table_set(font, &page_cap, c, glyph)) {
+                    ok = false;
+                    break;
+                }
+                if (c == group[1]) break;
+            }
+        }
+    } else {
+        /* The segment scan assigns each codepoint to the first segment
+         * whose endCode covers it.  Skipping codepoints already covered by
+         * an earlier segment keeps the table identical to the scan even for
+         * fonts whose segments are not perfectly sorted. */
+        Uint32 covered_end = 0;   /* one past the largest earlier endCode */
+        for (Uint16 i = 0; ok && i < font->cmap_seg_count; i++) {
+            Uint32 start = font->cmap_start_codes[i];
+            Uint32 end   = font->cmap_end_codes[i];
+            if (start < covered_end) start = covered_end;
+            for (Uint32 c = start; c <= end; c++) {
+                Uint16 glyph = forge_ui__cmap4_segment_glyph(font, i,
+                                                              (Uint16)c);
+                if (glyph != 0 &&
+                    !forge_ui__cmap_table_set(font, &page_cap, c, glyph)) {
+                    ok = false;
+                    break;
+                }
+            }
+            if (end + 1 > covered_end) covered_end = end + 1;
+        }
+    }
+
+    if (!ok) {
+        SDL_free(font->cmap_pages);
+        SDL_free(font->cmap_page_map);
+        font->cmap_pages      = NULL;
+        font->cmap_page_map   = NULL;
+        font->cmap_page_count = 0;
+        return false;
+    }
+    return true;
+}
+
 /* ── loca table parsing ──────────────────────────────────────────────────── */
 /* The loca table maps glyph indices to byte offsets within the glyf table.
  * It has numGlyphs + 1 entries so you can compute each glyph's size by
@@ -952,6 +1666,517 @@ static bool forge_ui__parse_hmtx(ForgeUiFont *font)
     return true;
 }
 
+/* ── Pair kerning (kern and GPOS tables) ─────────────────────────────────── */
+/* Kerning moves particular glyph pairs closer together or further apart
+ * ("AV", "To", "r.") beyond what their advance widths alone would give.
+ * Two tables can carry it:
+ *
+ *   kern  -- the original TrueType table.  Format 0 subtables list sorted
+ *            (left glyph, right glyph, value) triples.
+ *   GPOS  -- OpenType glyph positioning.  Kerning lives in pair adjustment
+ *            lookups (type 2, or type 9 extension lookups wrapping them)
+ *            that the 'kern' feature references.  Pair format 1 lists
+ *            explicit second glyphs per first glyph; format 2 assigns both
+ *            glyphs a class and stores one value per class pair.
+ *
+ * Both are flattened at load time into one ForgeUiKernTable, so layout pays
+ * a single hash probe per glyph pair.  GPOS is used when it yields any
+ * pairs (fonts that ship both keep the kern table for older renderers).
+ * The first value found for a pair is kept, which matches GPOS's rule that
+ * the first subtable covering a pair applies.  Only the first glyph's
+ * x-advance is used; placement and vertical adjustments are ignored, and
+ * format 2 class pairs with a zero value or second-glyph class 0 ("every
+ * glyph not listed") are not expanded. */
+
+#define FORGE_UI__KERN_MAX_PAIRS     (1u << 20) /* cap on flattened pairs */
+#define FORGE_UI__KERN_MIN_CAPACITY  64         /* first table allocation */
+#define FORGE_UI__OT_MAX_GLYPH_LIST  (1 << 20)  /* cap on expanded coverage
+                                                 * or class definitions */
+
+static inline Uint32 forge_ui__kern_key(Uint16 left, Uint16 right)
+{
+    return (Uint32)left << 16 | (Uint32)right;
+}
+
+/* Knuth multiplicative hash folded with its high half.  The key's low
+ * bits are the right glyph, and the low bits of a product depend only on
+ * the low bits of its inputs, so without the fold every pair sharing a
+ * right glyph would start probing at the same slot. */
+static inline Uint32 forge_ui__kern_hash(Uint32 key)
+{
+    Uint32 h = key * 2654435761u;
+    return h ^ (h >> 16);
+}
+
+static Sint16 forge_ui__kern_lookup(const ForgeUiKernTable *table,
+                                    Uint16 left, Uint16 right)
+{
+    if (table->count == 0 || left == 0 || right == 0) return 0;
+    Uint32 key = forge_ui__kern_key(left, right);
+    Uint32 slot = forge_ui__kern_hash(key) & table->mask;
+    for (;;) {
+        Uint32 k = table->keys[slot];
+        if (k == key) return table->values[slot];
+        if (k == 0) return 0;
+        slot = (slot + 1) & table->mask;
+    }
+}
+
+static void forge_ui__kern_free(ForgeUiKernTable *table)
+{
+    SDL_free(table->keys);
+    SDL_free(table->values);
+    SDL_memset(table, 0, sizeof(*table));
+}
+
+/* Rehash into a table of `capacity` slots (a power of two) */
+static bool forge_ui__kern_rehash(ForgeUiKernTable *table, Uint32 capacity)
+{
+    Uint32 *keys = (Uint32 *)SDL_calloc(capacity, sizeof(Uint32));
+    Sint16 *values = (Sint16 *)SDL_malloc(capacity * sizeof(Sint16));
+    if (!keys || !values) {
+        SDL_Log("forge_ui__kern_rehash: allocation failed (%u slots)",
+                capacity);
+        SDL_free(keys);
+        SDL_free(values);
+        return false;
+    }
+    Uint32 mask = capacity - 1;
+    if (table->keys) {
+        for (Uint32 i = 0; i <= table->mask; i++) {
+            Uint32 k = table->keys[i];
+            if (k == 0) continue;
+            Uint32 slot = forge_ui__kern_hash(k) & mask;
+            while (keys[slot] != 0) slot = (slot + 1) & mask;
+            keys[slot] = k;
+            values[slot] = table->values[i];
+        }
+    }
+    SDL_free(table->keys);
+    SDL_free(table->values);
+    table->keys = keys;
+    table->values = values;
+    table->mask = mask;
+    return true;
+}
+
+/* Add a pair unless it is already present (the first value wins).  Pairs
+ * with glyph 0 and pairs past FORGE_UI__KERN_MAX_PAIRS are dropped.
+ * Returns false only on allocation failure. */
+static bool forge_ui__kern_insert(ForgeUiKernTable *table,
+                                  Uint16 left, Uint16 right, Sint16 value)
+{
+    if (left == 0 || right == 0) return true;
+    if (table->count >= FORGE_UI__KERN_MAX_PAIRS) return true;
+    if (!table->keys || (table->count + 1) * 2 > table->mask + 1) {
+        Uint32 capacity = table->keys ? (table->mask + 1) * 2
+                                      : FORGE_UI__KERN_MIN_CAPACITY;
+        if (!forge_ui__kern_rehash(table, capacity)) return false;
+    }
+    Uint32 key = forge_ui__kern_key(left, right);
+    Uint32 slot = forge_ui__kern_hash(key) & table->mask;
+    while (table->keys[slot] != 0) {
+        if (table->keys[slot] == key) return true;
+        slot = (slot + 1) & table->mask;
+    }
+    table->keys[slot] = key;
+    table->values[slot] = value;
+    table->count++;
+    return true;
+}
+
+/* True when [off, off + size) lies inside a table of len bytes */
+static inline bool forge_ui__ot_span(Uint32 len, Uint64 off, Uint64 size)
+{
+    return off <= len && size <= (Uint64)len - off;
+}
+
+/* Bytes in a GPOS ValueRecord: two per bit set in valueFormat */
+static inline Uint32 forge_ui__gpos_value_size(Uint16 value_format)
+{
+    Uint32 size = 0;
+    for (Uint16 bits = value_format & 0xFFu; bits; bits &= (Uint16)(bits - 1)) {
+        size += 2;
+    }
+    return size;
+}
+
+/* One glyph of an expanded Coverage or ClassDef table with its coverage
+ * index or class */
+typedef struct ForgeUi__GlyphValue {
+    Uint16 glyph;
+    Uint16 value;
+} ForgeUi__GlyphValue;
+
+/* Expand a Coverage table (is_classdef false) or a ClassDef table (true)
+ * at offset off into (glyph, value) entries.  A malformed table expands to
+ * nothing.  Returns false only on allocation failure; *out must be freed. */
+static bool forge_ui__ot_glyph_values(const Uint8 *t, Uint32 len, Uint32 off,
+                                      bool is_classdef,
+                                      ForgeUi__GlyphValue **out, int *count)
+{
+    *out = NULL;
+    *count = 0;
+    if (!forge_ui__ot_span(len, off, 4)) return true;
+    Uint16 format = forge_ui__read_u16(t + off);
+
+    /* Coverage 1: glyphCount, glyphArray[]
+     * ClassDef 1: startGlyph, glyphCount, classValueArray[] */
+    if (format == 1) {
+        Uint32 first = is_classdef ? forge_ui__read_u16(t + off + 2) : 0;
+        Uint32 n_off = is_classdef ? off + 4 : off + 2;
+        if (!forge_ui__ot_span(len, n_off, 2)) return true;
+        Uint16 n = forge_ui__read_u16(t + n_off);
+        if (n == 0 || !forge_ui__ot_span(len, n_off + 2, (Uint64)n * 2)) {
+            return true;
+        }
+        *out = (ForgeUi__GlyphValue *)SDL_malloc(n * sizeof(ForgeUi__GlyphValue));
+        if (!*out) {
+            SDL_Log("forge_ui__ot_glyph_values: allocation failed");
+            return false;
+        }
+        for (Uint16 i = 0; i < n; i++) {
+            Uint16 v = forge_ui__read_u16(t + n_off + 2 + (Uint32)i * 2);
+            if (is_classdef) {
+                if (first + i > 0xFFFFu) break;
+                (*out)[*count].glyph = (Uint16)(first + i);
+                (*out)[*count].value = v;
+            } else {
+                (*out)[*count].glyph = v;
+                (*out)[*count].value = i;
+            }
+            (*count)++;
+        }
+        return true;
+    }
+
+    /* Both format 2s: rangeCount, then (start, end, value) records where
+     * value is the range's class or its first glyph's coverage index */
+    if (format != 2) return true;
+    Uint16 ranges = forge_ui__read_u16(t + off + 2);
+    if (!forge_ui__ot_span(len, off + 4, (Uint64)ranges * 6)) return true;
+    Uint64 total = 0;
+    for (Uint16 r = 0; r < ranges; r++) {
+        const Uint8 *rec = t + off + 4 + (Uint32)r * 6;
+        Uint16 start = forge_ui__read_u16(rec);
+        Uint16 end = forge_ui__read_u16(rec + 2);
+        if (end >= start) total += (Uint64)(end - start) + 1;
+    }
+    if (total == 0) return true;
+    if (total > FORGE_UI__OT_MAX_GLYPH_LIST) {
+        SDL_Log("forge_ui__ot_glyph_values: table lists %llu glyphs; "
+                "ignoring it", (unsigned long long)total);
+        return true;
+    }
+    *out = (ForgeUi__GlyphValue *)SDL_malloc((size_t)total *
+                                             sizeof(ForgeUi__GlyphValue));
+    if (!*out) {
+        SDL_Log("forge_ui__ot_glyph_values: allocation failed");
+        return false;
+    }
+    for (Uint16 r = 0; r < ranges; r++) {
+        const Uint8 *rec = t + off + 4 + (Uint32)r * 6;
+        Uint32 start = forge_ui__read_u16(rec);
+        Uint32 end = forge_ui__read_u16(rec + 2);
+        Uint32 value = forge_ui__read_u16(rec + 4);
+        for (Uint32 g = start; g <= end; g++) {
+            (*out)[*count].glyph = (Uint16)g;
+            (*out)[*count].value = is_classdef ? (Uint16)value
+                                               : (Uint16)(value + (g - start));
+            (*count)++;
+        }
+    }
+    return true;
+}
+
+/* Flatten one PairPos subtable at offset sub of the GPOS table */
+static bool forge_ui__gpos_pair_pos(ForgeUiKernTable *kern,
+                                    const Uint8 *t, Uint32 len, Uint32 sub)
+{
+    if (!forge_ui__ot_span(len, sub, 10)) return true;
+    Uint16 format = forge_ui__read_u16(t + sub);
+    Uint32 coverage_off = sub + forge_ui__read_u16(t + sub + 2);
+    Uint16 format1 = forge_ui__read_u16(t + sub + 4);
+    Uint16 format2 = forge_ui__read_u16(t + sub + 6);
+
+    /* Without an x-advance on the first glyph the subtable is not kerning */
+    if (!(format1 & 0x0004)) return true;
+    Uint32 size1 = forge_ui__gpos_value_size(format1);
+    Uint32 size2 = forge_ui__gpos_value_size(format2);
+    /* XAdvance follows XPlacement (0x0001) and YPlacement (0x0002) */
+    Uint32 x_advance = forge_ui__gpos_value_size(format1 & 0x0003);
+
+    ForgeUi__GlyphValue *cov = NULL;
+    int cov_count = 0;
+    if (format != 1 && format != 2) return true;
+    if (!forge_ui__ot_glyph_values(t, len, coverage_off, false,
+                                   &cov, &cov_count)) {
+        return false;
+    }
+
+    bool ok = true;
+    if (format == 1) {
+        /* pairSetCount, pairSetOffsets[]; each PairSet is pairValueCount
+         * then (secondGlyph, valueRecord1, valueRecord2) records */
+        Uint16 set_count = forge_ui__read_u16(t + sub + 8);
+        Uint32 rec_size = 2 + size1 + size2;
+        if (!forge_ui__ot_span(len, sub + 10, (Uint64)set_count * 2)) {
+            set_count = 0;
+        }
+        for (int c = 0; ok && c < cov_count; c++) {
+            if (cov[c].value >= set_count) continue;
+            Uint32 set = sub + forge_ui__read_u16(t + sub + 10 +
+                                                  (Uint32)cov[c].value * 2);
+            if (!forge_ui__ot_span(len, set, 2)) continue;
+            Uint16 n = forge_ui__read_u16(t + set);
+            if (!forge_ui__ot_span(len, set + 2, (Uint64)n * rec_size)) continue;
+            for (Uint16 r = 0; ok && r < n; r++) {
+                const Uint8 *rec = t + set + 2 + (Uint32)r * rec_size;
+                ok = forge_ui__kern_insert(kern, cov[c].glyph,
+                                           forge_ui__read_u16(rec),
+                                           forge_ui__read_i16(rec + 2 + x_advance));
+            }
+        }
+        SDL_free(cov);
+        return ok;
+    }
+
+    /* Format 2: classDef1, classDef2, class1Count, class2Count, then a
+     * class1Count x class2Count matrix of (valueRecord1, valueRecord2) */
+    if (!forge_ui__ot_span(len, sub, 16)) {
+        SDL_free(cov);
+        return true;
+    }
+    Uint32 class_def1 = sub + forge_ui__read_u16(t + sub + 8);
+    Uint32 class_def2 = sub + forge_ui__read_u16(t + sub + 10);
+    Uint16 class1_count = forge_ui__read_u16(t + sub + 12);
+    Uint16 class2_count = forge_ui__read_u16(t + sub + 14);
+    Uint32 rec_size = size1 + size2;
+    if (!forge_ui__ot_span(len, sub + 16, (Uint64)class1_count *
+                                          class2_count * rec_size)) {
+        SDL_free(cov);
+        return true;
+    }
+
+    ForgeUi__GlyphValue *cd1 = NULL, *cd2 = NULL;
+    int cd1_count = 0, cd2_count = 0;
+    Uint16 *class1 = NULL;       /* class of every glyph, by glyph index */
+    int *class2_start = NULL;    /* class c: glyphs2[start[c] .. start[c+1]) */
+    Uint16 *glyphs2 = NULL;      /* second glyphs grouped by class */
+    ok = forge_ui__ot_glyph_values(t, len, class_def1, true, &cd1, &cd1_count) &&
+         forge_ui__ot_glyph_values(t, len, class_def2, true, &cd2, &cd2_count);
+    if (ok) {
+        class1 = (Uint16 *)SDL_calloc(65536, sizeof(Uint16));
+        class2_start = (int *)SDL_calloc((size_t)class2_count + 1, sizeof(int));
+        glyphs2 = (Uint16 *)SDL_malloc(((size_t)cd2_count + 1) * sizeof(Uint16));
+        if (!class1 || !class2_start || !glyphs2) {
+            SDL_Log("forge_ui__gpos_pair_pos: allocation failed");
+            ok = false;
+        }
+    }
+    if (ok) {
+        for (int i = 0; i < cd1_count; i++) class1[cd1[i].glyph] = cd1[i].value;
+
+        /* Counting sort of the second glyphs by class */
+        for (int i = 0; i < cd2_count; i++) {
+            if (cd2[i].value < class2_count) class2_start[cd2[i].value + 1]++;
+        }
+        for (int c = 0; c < class2_count; c++) {
+            class2_start[c + 1] += class2_start[c];
+        }
+        int *fill = class2_start;  /* reuse as write cursors, then restore */
+        for (int i = 0; i < cd2_count; i++) {
+            Uint16 c = cd2[i].value;
+            if (c < class2_count) glyphs2[fill[c]++] = cd2[i].glyph;
+        }
+        for (int c = class2_count; c > 0; c--) fill[c] = fill[c - 1];
+        fill[0] = 0;
+
+        const Uint8 *matrix = t + sub + 16;
+        for (int c = 0; ok && c < cov_count; c++) {
+            Uint16 c1 = class1[cov[c].glyph];
+            if (c1 >= class1_count) continue;
+            for (Uint16 c2 = 1; ok && c2 < class2_count; c2++) {
+                const Uint8 *rec = matrix +
+                    ((size_t)c1 * class2_count + c2) * rec_size;
+                Sint16 value = forge_ui__read_i16(rec + x_advance);
+                if (value == 0) continue;
+                for (int g = class2_start[c2]; ok && g < class2_start[c2 + 1]; g++) {
+                    ok = forge_ui__kern_insert(kern, cov[c].glyph,
+                                               glyphs2[g], value);
+                }
+            }
+        }
+    }
+
+    SDL_free(glyphs2);
+    SDL_free(class2_start);
+    SDL_free(class1);
+    SDL_free(cd2);
+    SDL_free(cd1);
+    SDL_free(cov);
+    return ok;
+}
+
+/* Flatten the pair adjustment lookups of GPOS's 'kern' feature.  A missing
+ * or malformed table leaves the kerning empty; returns false only on
+ * allocation failure. */
+static bool forge_ui__parse_gpos_kerning(ForgeUiFont *font)
+{
+    const ForgeUiTtfTableEntry *entry = forge_ui__find_table(font, "GPOS");
+    if (!entry) return true;
+    const Uint8 *t = font->data + entry->offset;
+    Uint32 len = entry->length;
+
+    /* Header: majorVersion, minorVersion, scriptList, featureList,
+     * lookupList (all uint16) */
+    if (!forge_ui__ot_span(len, 0, 10) || forge_ui__read_u16(t) != 1) {
+        SDL_Log("forge_ui__parse_gpos_kerning: unsupported GPOS header; "
+                "ignoring it");
+        return true;
+    }
+    Uint32 feature_list = forge_ui__read_u16(t + 6);
+    Uint32 lookup_list = forge_ui__read_u16(t + 8);
+    if (!forge_ui__ot_span(len, feature_list, 2) ||
+        !forge_ui__ot_span(len, lookup_list, 2)) {
+        return true;
+    }
+    Uint16 lookup_count = forge_ui__read_u16(t + lookup_list);
+    if (lookup_count == 0 ||
+        !forge_ui__ot_span(len, lookup_list + 2, (Uint64)lookup_count * 2)) {
+        return true;
+    }
+
+    /* Mark every lookup a 'kern' feature references, for any script */
+    bool *use = (bool *)SDL_calloc(lookup_count, sizeof(bool));
+    if (!use) {
+        SDL_Log("forge_ui__parse_gpos_kerning: allocation failed");
+        return false;
+    }
+    Uint16 feature_count = forge_ui__read_u16(t + feature_list);
+    for (Uint16 f = 0; f < feature_count; f++) {
+        Uint32 rec = feature_list + 2 + (Uint32)f * 6;
+        if (!forge_ui__ot_span(len, rec, 6)) break;
+        if (SDL_memcmp(t + rec, "kern", 4) != 0) continue;
+        Uint32 feature = feature_list + forge_ui__read_u16(t + rec + 4);
+        if (!forge_ui__ot_span(len, feature, 4)) continue;
+        Uint16 n = forge_ui__read_u16(t + feature + 2);
+        if (!forge_ui__ot_span(len, feature + 4, (Uint64)n * 2)) continue;
+        for (Uint16 i = 0; i < n; i++) {
+            Uint16 li = forge_ui__read_u16(t + feature + 4 + (Uint32)i * 2);
+            if (li < lookup_count) use[li] = true;
+        }
+    }
+
+    /* Lookups apply in LookupList order */
+    bool ok = true;
+    for (Uint16 l = 0; ok && l < lookup_count; l++) {
+        if (!use[l]) continue;
+        Uint32 lookup = lookup_list +
+            forge_ui__read_u16(t + lookup_list + 2 + (Uint32)l * 2);
+        if (!forge_ui__ot_span(len, lookup, 6)) continue;
+        Uint16 type = forge_ui__read_u16(t + lookup);
+        Uint16 sub_count = forge_ui__read_u16(t + lookup + 4);
+        if (!forge_ui__ot_span(len, lookup + 6, (Uint64)sub_count * 2)) continue;
+        for (Uint16 s = 0; ok && s < sub_count; s++) {
+            Uint32 sub = lookup +
+                forge_ui__read_u16(t + lookup + 6 + (Uint32)s * 2);
+            Uint16 sub_type = type;
+            if (type == 9) {
+                /* Extension: format, extensionLookupType, 32-bit offset */
+                if (!forge_ui__ot_span(len, sub, 8) ||
+                    forge_ui__read_u16(t + sub) != 1) {
+                    continue;
+                }
+                sub_type = forge_ui__read_u16(t + sub + 2);
+                Uint64 target = (Uint64)sub + forge_ui__read_u32(t + sub + 4);
+                if (target >= len) continue;
+                sub = (Uint32)target;
+            }
+            if (sub_type != 2) continue;
+            ok = forge_ui__gpos_pair_pos(&font->kern, t, len, sub);
+        }
+    }
+    SDL_free(use);
+    return ok;
+}
+
+/* Read format 0 subtables of the legacy kern table (version 0, the
+ * Microsoft layout).  Only horizontal, non-minimum, non-cross-stream
+ * subtables are used.  Returns false only on allocation failure. */
+static bool forge_ui__parse_kern_table(ForgeUiFont *font)
+{
+    const ForgeUiTtfTableEntry *entry = forge_ui__find_table(font, "kern");
+    if (!entry) return true;
+    const Uint8 *t = font->data + entry->offset;
+    Uint32 len = entry->length;
+
+    if (!forge_ui__ot_span(len, 0, 4)) return true;
+    if (forge_ui__read_u16(t) != 0) {
+        SDL_Log("forge_ui__parse_kern_table: kern version %u not supported; "
+                "ignoring it", forge_ui__read_u16(t));
+        return true;
+    }
+    Uint16 n_tables = forge_ui__read_u16(t + 2);
+
+    /* Subtable header: version, length, coverage (uint16 each).  Format 0
+     * adds nPairs, searchRange, entrySelector, rangeShift, then 6-byte
+     * (left, right, value) records. */
+    Uint32 off = 4;
+    for (Uint16 i = 0; i < n_tables; i++) {
+        if (!forge_ui__ot_span(len, off, 6)) break;
+        Uint32 sub_len = forge_ui__read_u16(t + off + 2);
+        Uint16 coverage = forge_ui__read_u16(t + off + 4);
+        if ((coverage >> 8) == 0 && forge_ui__ot_span(len, off + 6, 8)) {
+            Uint32 n_pairs = forge_ui__read_u16(t + off + 6);
+            /* The 16-bit length overflows for large subtables; format 0's
+             * real size follows from nPairs */
+            sub_len = 14 + n_pairs * 6;
+            Uint32 fit = (len - (off + 14)) / 6;  /* records in bounds */
+            if (n_pairs > fit) n_pairs = fit;
+            if ((coverage & 0x0007) == 0x0001) {
+                for (Uint32 p = 0; p < n_pairs; p++) {
+                    const Uint8 *rec = t + off + 14 + p * 6;
+                    if (!forge_ui__kern_insert(&font->kern,
+                                               forge_ui__read_u16(rec),
+                                               forge_ui__read_u16(rec + 2),
+                                               forge_ui__read_i16(rec + 4))) {
+                        return false;
+                    }
+                }
+            }
+        }
+        if (sub_len < 6) break;  /* malformed: would not advance */
+        off += sub_len;
+    }
+    return true;
+}
+
+/* Build font->kern from GPOS, falling back to the kern table */
+static bool forge_ui__parse_kerning(ForgeUiFont *font)
+{
+    if (!forge_ui__parse_gpos_kerning(font)) {
+        forge_ui__kern_free(&font->kern);
+        return false;
+    }
+    if (font->kern.count == 0 && !forge_ui__parse_kern_table(font)) {
+        forge_ui__kern_free(&font->kern);
+        return false;
+    }
+    if (font->kern.count >= FORGE_UI__KERN_MAX_PAIRS) {
+        SDL_Log("forge_ui__parse_kerning: kerning truncated at %u pairs",
+                FORGE_UI__KERN_MAX_PAIRS);
+    }
+    return true;
+}
+
+static Sint16 forge_ui_ttf_kerning(const ForgeUiFont *font,
+                                    Uint16 left_glyph, Uint16 right_glyph)
+{
+    if (!font) return 0;
+    return forge_ui__kern_lookup(&font->kern, left_glyph, right_glyph);
+}
+
 /* ── glyf offset caching ────────────────────────────────────────────────── */
 
 static bool forge_ui__cache_glyf_offset(ForgeUiFont *font)
@@ -980,6 +2205,13 @@ static bool forge_ui__cache_glyf_offset(ForgeUiFont *font)
 /* ── Public function implementations ─────────────────────────────────────── */
 
 static bool forge_ui_ttf_load(const char *path, ForgeUiFont *out_font)
+{
+    return forge_ui_ttf_load_opts(path, NULL, out_font);
+}
+
+static bool forge_ui_ttf_load_opts(const char *path,
+                                    const ForgeUiFontLoadOpts *opts,
+                                    ForgeUiFont *out_font)
 {
     if (!out_font) {
         SDL_Log("forge_ui_ttf_load: out_font is NULL");
@@ -1011,14 +2243,23 @@ static bool forge_ui_ttf_load(const char *path, ForgeUiFont *out_font)
      * head first (indexToLocFormat needed by loca),
      * maxp next (numGlyphs needed by loca),
      * then hhea (numberOfHMetrics needed by hmtx),
-     * then cmap, loca, hmtx, and cache glyf offset */
+     * then cmap, loca, hmtx, cache glyf offset, and flatten kerning
+     * (optional: a font without it, or with a table we cannot read,
+     * simply lays out unkerned) */
     if (!forge_ui__parse_head(out_font)  ||
         !forge_ui__parse_maxp(out_font)  ||
         !forge_ui__parse_hhea(out_font)  ||
         !forge_ui__parse_cmap(out_font)  ||
         !forge_ui__parse_loca(out_font)  ||
         !forge_ui__parse_hmtx(out_font)  ||
-        !forge_ui__cache_glyf_offset(out_font)) {
+        !forge_ui__cache_glyf_offset(out_font) ||
+        !forge_ui__parse_kerning(out_font)) {
+        forge_ui_ttf_free(out_font);
+        return false;
+    }
+
+    if (opts && opts->build_cmap_table &&
+        !forge_ui__build_cmap_table(out_font)) {
         forge_ui_ttf_free(out_font);
         return false;
     }
@@ -1030,9 +2271,13 @@ static void forge_ui_ttf_free(ForgeUiFont *font)
 {
     if (!font) return;
 
+    forge_ui__kern_free(&font->kern);
     SDL_free(font->hmtx_left_side_bearings);
     SDL_free(font->hmtx_advance_widths);
     SDL_free(font->loca_offsets);
+    SDL_free(font->cmap_pages);
+    SDL_free(font->cmap_page_map);
+    SDL_free(font->cmap12_groups);
     SDL_free(font->cmap_id_range_offsets);
     SDL_free(font->cmap_id_deltas);
     SDL_free(font->cmap_start_codes);
@@ -1048,6 +2293,20 @@ static Uint16 forge_ui_ttf_glyph_index(const ForgeUiFont *font,
 {
     if (!font) return 0;
 
+    /* Precomputed page table: two memory reads */
+    if (font->cmap_page_map) {
+        if (codepoint > FORGE_UI__CMAP_MAX_CODEPOINT) return 0;
+        Uint16 page = font->cmap_page_map[codepoint >> FORGE_UI__CMAP_PAGE_SHIFT];
+        if (page == 0) return 0;
+        return font->cmap_pages[(size_t)(page - 1) * FORGE_UI__CMAP_PAGE_SIZE +
+                                (codepoint & FORGE_UI__CMAP_PAGE_MASK)];
+    }
+
+    /* Format 12 covers the full repertoire, including the BMP */
+    if (font->cmap12_group_count > 0) {
+        return forge_ui__cmap12_lookup(font, codepoint);
+    }
+
     /* cmap format 4 only supports the Basic Multilingual Plane (0-65535) */
     if (codepoint > 0xFFFF) {
         return 0;
@@ -1062,36 +2321,7 @@ static Uint16 forge_ui_ttf_glyph_index(const ForgeUiFont *font,
                 /* Codepoint falls in a gap between segments */
                 return 0;
             }
-
-            if (font->cmap_id_range_offsets[i] == 0) {
-                /* Simple case: glyph index = codepoint + idDelta */
-                return (Uint16)(cp + font->cmap_id_deltas[i]);
-            }
-
-            /* Complex case: use idRangeOffset to index into a glyph array.
-             * The formula from the spec:
-             *   addr = idRangeOffset[i] + 2*(cp - startCode[i])
-             *          + &idRangeOffset[i]
-             *   glyph_index = *addr
-             *   if (glyph_index != 0) glyph_index += idDelta[i] */
-            Uint32 range_offset = font->cmap_id_range_offsets[i];
-            Uint32 char_offset = (Uint32)(cp - font->cmap_start_codes[i]);
-            size_t byte_offset = (size_t)i * 2 +
-                                 (size_t)range_offset +
-                                 (size_t)char_offset * 2;
-            const Uint8 *glyph_addr = font->cmap_id_range_base + byte_offset;
-
-            /* Validate that glyph_addr + 2 is within the font buffer */
-            if (glyph_addr < font->data ||
-                glyph_addr + 2 > font->data + font->data_size) {
-                return 0; /* out-of-bounds — return .notdef */
-            }
-
-            Uint16 glyph_index = forge_ui__read_u16(glyph_addr);
-            if (glyph_index != 0) {
-                glyph_index = (Uint16)(glyph_index + font->cmap_id_deltas[i]);
-            }
-            return glyph_index;
+            return forge_ui__cmap4_segment_glyph(font, i, cp);
         }
     }
 
@@ -1717,6 +2947,10 @@ static int forge_ui__crossing_cmp(const void *a, const void *b)
     return 0;
 }
 
+static void forge_ui__fill_crossings(const ForgeUi__Crossing *crossings,
+                                     int num_crossings,
+                                     Uint8 *row, int width);
+
 /* ── Scanline rasterization core ─────────────────────────────────────────── */
 /* Rasterize a single scanline at y-coordinate scan_y into the bitmap row.
  *
@@ -1726,12 +2960,13 @@ static int forge_ui__crossing_cmp(const void *a, const void *b)
  * 3. Walk left to right, accumulating the winding number
  * 4. When winding != 0, the pixel is inside the glyph — fill it */
 
-static void forge_ui__rasterize_scanline(
+/* Collect every edge crossing of the scanline at scan_y (unsorted).
+ * Returns the number of crossings written, at most max_crossings. */
+static int forge_ui__gather_crossings(
     const ForgeUi__Edge *edges, int edge_count,
     float scan_y,
-    Uint8 *row, int width)
+    ForgeUi__Crossing *crossings, int max_crossings)
 {
-    ForgeUi__Crossing crossings[FORGE_UI__MAX_CROSSINGS];
     int num_crossings = 0;
 
     for (int i = 0; i < edge_count; i++) {
@@ -1741,9 +2976,9 @@ static void forge_ui__rasterize_scanline(
             float cx;
             if (forge_ui__line_crossing(e->x0, e->y0, e->x1, e->y1,
                                          scan_y, &cx)) {
-                if (num_crossings >= FORGE_UI__MAX_CROSSINGS) {
-                    SDL_Log("forge_ui__rasterize_scanline: crossing limit "
-                            "(%d) exceeded at y=%.1f", FORGE_UI__MAX_CROSSINGS,
+                if (num_crossings >= max_crossings) {
+                    SDL_Log("forge_ui__gather_crossings: crossing limit "
+                            "(%d) exceeded at y=%.1f", max_crossings,
                             (double)scan_y);
                     break;
                 }
@@ -1753,10 +2988,10 @@ static void forge_ui__rasterize_scanline(
             }
         } else {
             /* Quadratic Bézier edge */
-            int space = FORGE_UI__MAX_CROSSINGS - num_crossings;
+            int space = max_crossings - num_crossings;
             if (space <= 0) {
-                SDL_Log("forge_ui__rasterize_scanline: crossing limit "
-                        "(%d) exceeded at y=%.1f", FORGE_UI__MAX_CROSSINGS,
+                SDL_Log("forge_ui__gather_crossings: crossing limit "
+                        "(%d) exceeded at y=%.1f", max_crossings,
                         (double)scan_y);
                 break;
             }
@@ -1768,12 +3003,38 @@ static void forge_ui__rasterize_scanline(
         }
     }
 
+    return num_crossings;
+}
+
+static void forge_ui__rasterize_scanline(
+    const ForgeUi__Edge *edges, int edge_count,
+    float scan_y,
+    Uint8 *row, int width)
+{
+    ForgeUi__Crossing crossings[FORGE_UI__MAX_CROSSINGS];
+    int num_crossings = forge_ui__gather_crossings(
+        edges, edge_count, scan_y, crossings, FORGE_UI__MAX_CROSSINGS);
+
     if (num_crossings < 2) return;
 
     /* Sort crossings by x position */
     SDL_qsort(crossings, (size_t)num_crossings,
               sizeof(ForgeUi__Crossing), forge_ui__crossing_cmp);
 
+    forge_ui__fill_crossings(crossings, num_crossings, row, width);
+}
+
+/* ── Span filling ────────────────────────────────────────────────────────── */
+/* Fill a bitmap row from crossings already sorted by x.  Shared by the
+ * reference scanline path and the active edge table so both produce the
+ * same pixels from the same crossings. */
+
+static void forge_ui__fill_crossings(const ForgeUi__Crossing *crossings,
+                                     int num_crossings,
+                                     Uint8 *row, int width)
+{
+    if (num_crossings < 2) return;
+
     /* Walk crossings and fill using the non-zero winding rule.
      * The winding number starts at 0.  Each crossing adds its winding
      * value.  When winding transitions from 0 to non-zero we record the
@@ -1807,63 +3068,477 @@ static void forge_ui__rasterize_scanline(
     }
 }
 
-/* ── Main rasterization function ─────────────────────────────────────────── */
+/* ── Active edge table ───────────────────────────────────────────────────── */
+/* forge_ui__rasterize_scanline tests every edge against every scanline and
+ * sorts the crossings from scratch.  The active edge table instead sorts
+ * the edges once by their top y.  As scanlines advance downward, edges are
+ * activated when their vertical span begins and retired once it ends, so
+ * each scanline only considers the few edges that can actually cross it.
+ *
+ * Crossing x positions come from the same functions as the reference path
+ * (forge_ui__line_crossing and forge_ui__quad_crossings) instead of being
+ * stepped incrementally.  Accumulating dx/dy per row drifts by a few ULPs,
+ * which is enough to move a span end across a pixel boundary; evaluating
+ * the same expressions keeps the coverage bit-identical.
+ *
+ * Crossing order barely changes between consecutive scanlines, so the
+ * active list is kept in the previous row's x order.  The crossings it
+ * produces are then nearly sorted, and insertion sort finishes the job in
+ * close to linear time. */
+
+/* Spans are padded by this many (supersampled) rows on both sides.  The
+ * padding only makes activation conservative — the crossing functions do
+ * the exact range test — so a quadratic root landing a hair outside its
+ * hull due to rounding is never missed. */
+#define FORGE_UI__AET_MARGIN  1.0f
+
+typedef struct ForgeUi__EdgeSpan {
+    float y_min;  /* activate once the scanline reaches this y */
+    float y_max;  /* retire once the scanline passes this y */
+    int   edge;   /* index into the edge array */
+} ForgeUi__EdgeSpan;
+
+typedef struct ForgeUi__ActiveEdge {
+    float y_max;  /* retire once the scanline passes this y */
+    float key;    /* x of this edge's first crossing on the latest row */
+    int   edge;   /* index into the edge array */
+} ForgeUi__ActiveEdge;
+
+typedef struct ForgeUi__EdgeTable {
+    const ForgeUi__Edge *edges;
+    ForgeUi__EdgeSpan   *spans;        /* sorted by y_min */
+    int                  span_count;
+    int                  next_span;    /* first span not yet activated */
+    ForgeUi__ActiveEdge *active;       /* edges spanning the current row */
+    int                  active_count;
+} ForgeUi__EdgeTable;
+
+static int forge_ui__edge_span_cmp(const void *a, const void *b)
+{
+    const ForgeUi__EdgeSpan *sa = (const ForgeUi__EdgeSpan *)a;
+    const ForgeUi__EdgeSpan *sb = (const ForgeUi__EdgeSpan *)b;
+    if (sa->y_min < sb->y_min) return -1;
+    if (sa->y_min > sb->y_min) return  1;
+    return sa->edge - sb->edge;
+}
 
-static bool forge_ui_rasterize_glyph(const ForgeUiFont *font,
-                                      Uint16 glyph_index,
-                                      float pixel_height,
-                                      const ForgeUiRasterOpts *opts,
-                                      ForgeUiGlyphBitmap *out_bitmap)
+/* Build the y-sorted span list.  Scanlines passed to
+ * forge_ui__edge_table_scanline() afterwards must increase monotonically. */
+static bool forge_ui__edge_table_init(ForgeUi__EdgeTable *table,
+                                      const ForgeUi__Edge *edges,
+                                      int edge_count)
 {
-    if (!font || !out_bitmap) {
-        SDL_Log("forge_ui_rasterize_glyph: NULL argument");
+    SDL_memset(table, 0, sizeof(*table));
+    table->edges = edges;
+    if (edge_count <= 0) return true;
+
+    table->spans = (ForgeUi__EdgeSpan *)SDL_malloc(
+        sizeof(ForgeUi__EdgeSpan) * (size_t)edge_count);
+    table->active = (ForgeUi__ActiveEdge *)SDL_malloc(
+        sizeof(ForgeUi__ActiveEdge) * (size_t)edge_count);
+    if (!table->spans || !table->active) {
+        SDL_Log("forge_ui__edge_table_init: allocation failed");
+        SDL_free(table->spans);
+        SDL_free(table->active);
+        SDL_memset(table, 0, sizeof(*table));
         return false;
     }
-    SDL_memset(out_bitmap, 0, sizeof(ForgeUiGlyphBitmap));
 
-    if (!(pixel_height > 0.0f)) {
-        SDL_Log("forge_ui_rasterize_glyph: pixel_height must be positive "
-                "(got %f)", (double)pixel_height);
-        return false;
+    for (int i = 0; i < edge_count; i++) {
+        const ForgeUi__Edge *e = &edges[i];
+        float lo = e->y0 < e->y1 ? e->y0 : e->y1;
+        float hi = e->y0 < e->y1 ? e->y1 : e->y0;
+        if (e->type == FORGE_UI__EDGE_QUAD) {
+            /* The curve stays inside the hull of its three points */
+            if (e->y2 < lo) lo = e->y2;
+            if (e->y2 > hi) hi = e->y2;
+        } else if (e->y0 == e->y1) {
+            continue;  /* horizontal lines never cross a scanline */
+        }
+        ForgeUi__EdgeSpan *sp = &table->spans[table->span_count++];
+        sp->y_min = lo - FORGE_UI__AET_MARGIN;
+        sp->y_max = hi + FORGE_UI__AET_MARGIN;
+        sp->edge  = i;
     }
 
-    /* Default options: 4x4 supersampling.
-     * Only powers of two up to 8 are allowed — arbitrary values could
-     * cause enormous allocations (hi-res buffer is bmp_w*ss × bmp_h*ss). */
-    int ss = FORGE_UI__DEFAULT_SS;
-    if (opts) {
-        int req = opts->supersample_level;
-        if (req == 1 || req == 2 || req == 4 || req == 8) {
-            ss = req;
-        } else if (req >= 1) {
-            SDL_Log("forge_ui_rasterize_glyph: invalid supersample_level "
-                    "%d — must be 1, 2, 4, or 8; using default %d",
-                    req, FORGE_UI__DEFAULT_SS);
+    SDL_qsort(table->spans, (size_t)table->span_count,
+              sizeof(ForgeUi__EdgeSpan), forge_ui__edge_span_cmp);
+    return true;
+}
+
+static void forge_ui__edge_table_free(ForgeUi__EdgeTable *table)
+{
+    SDL_free(table->spans);
+    SDL_free(table->active);
+    SDL_memset(table, 0, sizeof(*table));
+}
+
+/* Rasterize one scanline using the active edge table. */
+static void forge_ui__edge_table_scanline(ForgeUi__EdgeTable *table,
+                                          float scan_y,
+                                          Uint8 *row, int width)
+{
+    /* Retire edges whose span ended above this row (order preserved) */
+    int kept = 0;
+    for (int i = 0; i < table->active_count; i++) {
+        if (table->active[i].y_max >= scan_y) {
+            table->active[kept++] = table->active[i];
         }
     }
+    table->active_count = kept;
+
+    /* Activate edges whose span has begun.  New edges go at the end; the
+     * key sort below moves them into place. */
+    while (table->next_span < table->span_count &&
+           table->spans[table->next_span].y_min <= scan_y) {
+        const ForgeUi__EdgeSpan *sp = &table->spans[table->next_span++];
+        if (sp->y_max < scan_y) continue;  /* span lies entirely above */
+        ForgeUi__ActiveEdge *ae = &table->active[table->active_count++];
+        ae->y_max = sp->y_max;
+        ae->key   = 0.0f;
+        ae->edge  = sp->edge;
+    }
 
-    /* Load the glyph outline */
-    ForgeUiTtfGlyph glyph;
-    if (!forge_ui_ttf_load_glyph(font, glyph_index, &glyph)) {
-        SDL_Log("forge_ui_rasterize_glyph: failed to load glyph %u",
-                glyph_index);
-        return false;
+    /* Gather crossings from active edges only */
+    ForgeUi__Crossing crossings[FORGE_UI__MAX_CROSSINGS];
+    int num_crossings = 0;
+
+    for (int i = 0; i < table->active_count; i++) {
+        const ForgeUi__Edge *e = &table->edges[table->active[i].edge];
+        int first = num_crossings;
+
+        if (e->type == FORGE_UI__EDGE_LINE) {
+            float cx;
+            if (forge_ui__line_crossing(e->x0, e->y0, e->x1, e->y1,
+                                         scan_y, &cx)) {
+                if (num_crossings >= FORGE_UI__MAX_CROSSINGS) {
+                    SDL_Log("forge_ui__edge_table_scanline: crossing limit "
+                            "(%d) exceeded at y=%.1f", FORGE_UI__MAX_CROSSINGS,
+                            (double)scan_y);
+                    break;
+                }
+                crossings[num_crossings].x = cx;
+                crossings[num_crossings].winding = e->winding;
+                num_crossings++;
+            }
+        } else {
+            int space = FORGE_UI__MAX_CROSSINGS - num_crossings;
+            if (space <= 0) {
+                SDL_Log("forge_ui__edge_table_scanline: crossing limit "
+                        "(%d) exceeded at y=%.1f", FORGE_UI__MAX_CROSSINGS,
+                        (double)scan_y);
+                break;
+            }
+            num_crossings += forge_ui__quad_crossings(
+                e->x0, e->y0, e->x1, e->y1, e->x2, e->y2,
+                scan_y, e->winding, &crossings[first], space);
+        }
+
+        if (num_crossings > first) {
+            table->active[i].key = crossings[first].x;
+        }
     }
 
-    /* Whitespace glyphs have no contours — return success with zero-size bitmap */
-    if (glyph.contour_count == 0) {
-        forge_ui_ttf_glyph_free(&glyph);
-        return true;
+    /* Insertion sort — nearly sorted because the active list is in the
+     * previous row's x order */
+    for (int i = 1; i < num_crossings; i++) {
+        ForgeUi__Crossing c = crossings[i];
+        int j = i - 1;
+        while (j >= 0 && crossings[j].x > c.x) {
+            crossings[j + 1] = crossings[j];
+            j--;
+        }
+        crossings[j + 1] = c;
+    }
+    for (int i = 1; i < table->active_count; i++) {
+        ForgeUi__ActiveEdge ae = table->active[i];
+        int j = i - 1;
+        while (j >= 0 && table->active[j].key > ae.key) {
+            table->active[j + 1] = table->active[j];
+            j--;
+        }
+        table->active[j + 1] = ae;
     }
 
-    /* Compute scale factor: font units → pixels.
-     * scale = pixel_height / unitsPerEm */
-    float scale = pixel_height / (float)font->head.units_per_em;
+    forge_ui__fill_crossings(crossings, num_crossings, row, width);
+}
 
-    /* Compute bitmap dimensions from the glyph's bounding box.
-     * Font coordinates have y-up; bitmaps have y=0 at top.  We flip
-     * y during edge building so the bitmap renders correctly.
-     *
+/* Rasterize one row with whichever method the caller selected.  table is
+ * NULL for the reference scanline path. */
+static void forge_ui__raster_row(const ForgeUi__Edge *edges, int edge_count,
+                                 ForgeUi__EdgeTable *table,
+                                 float scan_y, Uint8 *row, int width)
+{
+    if (table) {
+        forge_ui__edge_table_scanline(table, scan_y, row, width);
+    } else {
+        forge_ui__rasterize_scanline(edges, edge_count, scan_y, row, width);
+    }
+}
+
+/* ── Analytic coverage ───────────────────────────────────────────────────── */
+/* Supersampling estimates coverage by counting sample points; ANALYTIC
+ * computes it exactly, in the style of font-rs and stb_truetype v2.
+ *
+ * Every outline segment contributes signed area to an accumulation buffer.
+ * For each pixel row a segment passes through, it adds the covered height
+ * (dy, signed by direction) split across the pixels it touches in
+ * proportion to how much of each pixel lies to the right of the segment.
+ * A running sum along each row then turns those differences into the
+ * signed area covered at every pixel — walking from left to right, each
+ * crossing adds or removes its share of coverage exactly like a winding
+ * counter, but with fractional values instead of whole numbers.
+ *
+ * The absolute value of the sum, clamped to 1, is the coverage.  For
+ * well-formed outlines (no self-overlap with matching direction) this is
+ * identical to the non-zero winding rule; overlapping contours saturate at
+ * full coverage, as they do with non-zero.
+ *
+ * Quadratic Béziers are flattened into line segments first.  The number of
+ * segments grows with the curve's deviation from its chord so subdivision
+ * error stays well below what an 8-bit coverage value can represent. */
+
+/* Curves whose control point deviates less than this (squared, pixels²)
+ * from the chord midpoint are drawn as one line. */
+#define FORGE_UI__FLATTEN_MIN_DEV_SQ  0.333f
+
+/* Subdivision density: segments ≈ 1 + (TOL * dev²)^(1/4). */
+#define FORGE_UI__FLATTEN_TOL         3.0f
+
+/* Upper bound on segments per curve, to bound work for hostile outlines. */
+#define FORGE_UI__FLATTEN_MAX_SEGS    64
+
+/* Accumulate one line segment's signed area into acc (width * height
+ * floats plus one spill slot).  x is clamped to the bitmap on every row so
+ * malformed outlines cannot write outside the buffer; rows outside it are
+ * skipped. */
+static void forge_ui__coverage_line(float *acc, int width, int height,
+                                    float x0, float y0, float x1, float y1)
+{
+    if (y0 == y1) return;  /* horizontal segments cover no height */
+
+    float max_x = (float)(width - 1);
+    x0 = x0 < 0.0f ? 0.0f : (x0 > max_x ? max_x : x0);
+    x1 = x1 < 0.0f ? 0.0f : (x1 > max_x ? max_x : x1);
+
+    /* Walk top to bottom; dir carries the original direction */
+    float dir = 1.0f;
+    if (y0 > y1) {
+        float t;
+        t = x0; x0 = x1; x1 = t;
+        t = y0; y0 = y1; y1 = t;
+        dir = -1.0f;
+    }
+
+    float dxdy = (x1 - x0) / (y1 - y0);
+    float x = x0;
+    int y_start = (int)SDL_floorf(y0);
+    if (y_start < 0) {
+        x -= y0 * dxdy;  /* advance x to the top of the bitmap */
+        y_start = 0;
+    }
+    int y_end = (int)SDL_ceilf(y1);
+    if (y_end > height) y_end = height;
+
+    for (int y = y_start; y < y_end; y++) {
+        float *line = &acc[y * width];
+        float row_top = (float)y > y0 ? (float)y : y0;
+        float row_bot = (float)(y + 1) < y1 ? (float)(y + 1) : y1;
+        float dy = row_bot - row_top;
+        float x_next = x + dxdy * dy;
+        float d = dy * dir;
+
+        /* The endpoints were clamped, but stepping x by dxdy can round a
+         * hair past either side of the bitmap */
+        float xl = x < x_next ? x : x_next;
+        float xr = x < x_next ? x_next : x;
+        xl = xl < 0.0f ? 0.0f : (xl > max_x ? max_x : xl);
+        xr = xr < 0.0f ? 0.0f : (xr > max_x ? max_x : xr);
+        float xl_floor = SDL_floorf(xl);
+        int   xl_i = (int)xl_floor;
+        float xr_ceil = SDL_ceilf(xr);
+        int   xr_i = (int)xr_ceil;
+
+        if (xr_i <= xl_i + 1) {
+            /* Segment stays within one pixel column: split d between this
+             * pixel and the next by the mean x position */
+            float xm = 0.5f * (xl + xr) - xl_floor;
+            line[xl_i]     += d - d * xm;
+            line[xl_i + 1] += d * xm;
+        } else {
+            /* Segment spans several columns: the covered area ramps up
+             * linearly across them (triangle at each end, constant slope
+             * in between) */
+            float inv = 1.0f / (xr - xl);
+            float xl_f = xl - xl_floor;
+            float a0 = 0.5f * inv * (1.0f - xl_f) * (1.0f - xl_f);
+            float xr_f = xr - xr_ceil + 1.0f;
+            float am = 0.5f * inv * xr_f * xr_f;
+
+            line[xl_i] += d * a0;
+            if (xr_i == xl_i + 2) {
+                line[xl_i + 1] += d * (1.0f - a0 - am);
+            } else {
+                float a1 = inv * (1.5f - xl_f);
+                line[xl_i + 1] += d * (a1 - a0);
+                for (int xi = xl_i + 2; xi < xr_i - 1; xi++) {
+                    line[xi] += d * inv;
+                }
+                float a2 = a1 + (float)(xr_i - xl_i - 3) * inv;
+                line[xr_i - 1] += d * (1.0f - a2 - am);
+            }
+            line[xr_i] += d * am;
+        }
+        x = x_next;
+    }
+}
+
+/* Flatten a quadratic Bézier into lines and accumulate each. */
+static void forge_ui__coverage_quad(float *acc, int width, int height,
+                                    const ForgeUi__Edge *e)
+{
+    float dev_x = e->x0 - 2.0f * e->x1 + e->x2;
+    float dev_y = e->y0 - 2.0f * e->y1 + e->y2;
+    float dev_sq = dev_x * dev_x + dev_y * dev_y;
+    if (dev_sq < FORGE_UI__FLATTEN_MIN_DEV_SQ) {
+        forge_ui__coverage_line(acc, width, height,
+                                e->x0, e->y0, e->x2, e->y2);
+        return;
+    }
+
+    int segs = 1 + (int)SDL_floorf(
+        SDL_sqrtf(SDL_sqrtf(FORGE_UI__FLATTEN_TOL * dev_sq)));
+    if (segs > FORGE_UI__FLATTEN_MAX_SEGS) segs = FORGE_UI__FLATTEN_MAX_SEGS;
+
+    float px = e->x0;
+    float py = e->y0;
+    for (int i = 1; i <= segs; i++) {
+        float t = (float)i / (float)segs;
+        float u = 1.0f - t;
+        /* B(t) = u²·P0 + 2ut·P1 + t²·P2; the last point is exact */
+        float nx = (i == segs) ? e->x2
+                 : u * u * e->x0 + 2.0f * u * t * e->x1 + t * t * e->x2;
+        float ny = (i == segs) ? e->y2
+                 : u * u * e->y0 + 2.0f * u * t * e->y1 + t * t * e->y2;
+        forge_ui__coverage_line(acc, width, height, px, py, nx, ny);
+        px = nx;
+        py = ny;
+    }
+}
+
+/* Rasterize edges into an 8-bit coverage bitmap using exact area.
+ * Returns false if the accumulation buffer cannot be allocated. */
+static bool forge_ui__rasterize_analytic(const ForgeUi__Edge *edges,
+                                         int edge_count,
+                                         Uint8 *pixels,
+                                         int width, int height)
+{
+    /* One spill slot: a vertical segment exactly on the last column adds
+     * a zero-weight share one past the end of its row. */
+    size_t count = (size_t)width * (size_t)height;
+    float *acc = (float *)SDL_calloc(count + 1, sizeof(float));
+    if (!acc) {
+        SDL_Log("forge_ui__rasterize_analytic: allocation failed");
+        return false;
+    }
+
+    for (int i = 0; i < edge_count; i++) {
+        const ForgeUi__Edge *e = &edges[i];
+        if (e->type == FORGE_UI__EDGE_LINE) {
+            forge_ui__coverage_line(acc, width, height,
+                                    e->x0, e->y0, e->x1, e->y1);
+        } else {
+            forge_ui__coverage_quad(acc, width, height, e);
+        }
+    }
+
+    /* Prefix sum each row into coverage.  Every row's contributions sum to
+     * zero for a closed outline, so the sum restarts at each row. */
+    for (int y = 0; y < height; y++) {
+        const float *line = &acc[(size_t)y * (size_t)width];
+        Uint8 *row = &pixels[(size_t)y * (size_t)width];
+        float sum = 0.0f;
+        for (int x = 0; x < width; x++) {
+            sum += line[x];
+            float cov = SDL_fabsf(sum);
+            if (cov > 1.0f) cov = 1.0f;
+            row[x] = (Uint8)(cov * 255.0f + 0.5f);
+        }
+    }
+
+    SDL_free(acc);
+    return true;
+}
+
+/* ── Main rasterization function ─────────────────────────────────────────── */
+
+/* Rasterize into caller-provided edge scratch (FORGE_UI__MAX_EDGES entries).
+ * The atlas builder's worker threads each own one scratch buffer and reuse
+ * it for every glyph they render. */
+static bool forge_ui__rasterize_glyph_scratch(const ForgeUiFont *font,
+                                              Uint16 glyph_index,
+                                              float pixel_height,
+                                              const ForgeUiRasterOpts *opts,
+                                              ForgeUi__Edge *edges,
+                                              ForgeUiGlyphBitmap *out_bitmap)
+{
+    SDL_memset(out_bitmap, 0, sizeof(ForgeUiGlyphBitmap));
+
+    if (!(pixel_height > 0.0f)) {
+        SDL_Log("forge_ui_rasterize_glyph: pixel_height must be positive "
+                "(got %f)", (double)pixel_height);
+        return false;
+    }
+
+    /* Default options: 4x4 supersampling.
+     * Only powers of two up to 8 are allowed — arbitrary values could
+     * cause enormous allocations (hi-res buffer is bmp_w*ss × bmp_h*ss). */
+    int ss = FORGE_UI__DEFAULT_SS;
+    if (opts) {
+        int req = opts->supersample_level;
+        if (req == 1 || req == 2 || req == 4 || req == 8) {
+            ss = req;
+        } else if (req >= 1) {
+            SDL_Log("forge_ui_rasterize_glyph: invalid supersample_level "
+                    "%d — must be 1, 2, 4, or 8; using default %d",
+                    req, FORGE_UI__DEFAULT_SS);
+        }
+    }
+    bool use_aet = false;
+    bool use_analytic = false;
+    if (opts) {
+        if (opts->method == FORGE_UI_RASTER_ACTIVE_EDGE) {
+            use_aet = true;
+        } else if (opts->method == FORGE_UI_RASTER_ANALYTIC) {
+            use_analytic = true;
+        } else if (opts->method != FORGE_UI_RASTER_SCANLINE) {
+            SDL_Log("forge_ui_rasterize_glyph: invalid method %d; using "
+                    "FORGE_UI_RASTER_SCANLINE", (int)opts->method);
+        }
+    }
+
+    /* Load the glyph outline */
+    ForgeUiTtfGlyph glyph;
+    if (!forge_ui_ttf_load_glyph(font, glyph_index, &glyph)) {
+        SDL_Log("forge_ui_rasterize_glyph: failed to load glyph %u",
+                glyph_index);
+        return false;
+    }
+
+    /* Whitespace glyphs have no contours — return success with zero-size bitmap */
+    if (glyph.contour_count == 0) {
+        forge_ui_ttf_glyph_free(&glyph);
+        return true;
+    }
+
+    /* Compute scale factor: font units → pixels.
+     * scale = pixel_height / unitsPerEm */
+    float scale = pixel_height / (float)font->head.units_per_em;
+
+    /* Compute bitmap dimensions from the glyph's bounding box.
+     * Font coordinates have y-up; bitmaps have y=0 at top.  We flip
+     * y during edge building so the bitmap renders correctly.
+     *
      * bearing_x: horizontal offset from pen position to glyph left edge
      * bearing_y: vertical offset from baseline to glyph top edge */
     float scaled_x_min = (float)glyph.x_min * scale;
@@ -1888,15 +3563,6 @@ static bool forge_ui_rasterize_glyph(const ForgeUiFont *font,
     /* Build edges from contour data.  The edge builder handles all three
      * segment types (on→on lines, on→off→on Béziers, off→off implicit
      * midpoints) and applies scaling and y-flip. */
-    ForgeUi__Edge *edges = (ForgeUi__Edge *)SDL_malloc(
-        sizeof(ForgeUi__Edge) * FORGE_UI__MAX_EDGES);
-    if (!edges) {
-        SDL_Log("forge_ui_rasterize_glyph: allocation failed (edges)");
-        forge_ui_ttf_glyph_free(&glyph);
-        return false;
-    }
-
-    /* Adjust edge coordinates: add x_offset so glyph is centered in bitmap */
     int edge_count = forge_ui__build_edges(&glyph, scale, y_offset,
                                             edges, FORGE_UI__MAX_EDGES);
 
@@ -1913,17 +3579,35 @@ static bool forge_ui_rasterize_glyph(const ForgeUiFont *font,
     Uint8 *pixels = (Uint8 *)SDL_calloc((size_t)bmp_w * (size_t)bmp_h, 1);
     if (!pixels) {
         SDL_Log("forge_ui_rasterize_glyph: allocation failed (pixels)");
-        SDL_free(edges);
         forge_ui_ttf_glyph_free(&glyph);
         return false;
     }
 
-    if (ss <= 1) {
+    ForgeUi__EdgeTable aet;
+    ForgeUi__EdgeTable *table = NULL;
+
+    if (use_analytic) {
+        /* Exact area in one pass — no supersampling buffers needed */
+        if (!forge_ui__rasterize_analytic(edges, edge_count,
+                                          pixels, bmp_w, bmp_h)) {
+            SDL_free(pixels);
+            forge_ui_ttf_glyph_free(&glyph);
+            return false;
+        }
+    } else if (ss <= 1) {
         /* No supersampling: one sample per pixel at pixel center */
+        if (use_aet) {
+            if (!forge_ui__edge_table_init(&aet, edges, edge_count)) {
+                SDL_free(pixels);
+                forge_ui_ttf_glyph_free(&glyph);
+                return false;
+            }
+            table = &aet;
+        }
         for (int y = 0; y < bmp_h; y++) {
             float scan_y = (float)y + 0.5f;
-            forge_ui__rasterize_scanline(edges, edge_count, scan_y,
-                                          &pixels[y * bmp_w], bmp_w);
+            forge_ui__raster_row(edges, edge_count, table, scan_y,
+                                 &pixels[y * bmp_w], bmp_w);
         }
     } else {
         /* Supersampling: sample a ss×ss grid per pixel and average.
@@ -1942,7 +3626,6 @@ static bool forge_ui_rasterize_glyph(const ForgeUiFont *font,
             SDL_Log("forge_ui_rasterize_glyph: supersample dimensions "
                     "overflow (%d × %d × %d)", bmp_w, bmp_h, ss);
             SDL_free(pixels);
-            SDL_free(edges);
             forge_ui_ttf_glyph_free(&glyph);
             return false;
         }
@@ -1960,7 +3643,6 @@ static bool forge_ui_rasterize_glyph(const ForgeUiFont *font,
             SDL_free(hi_row);
             SDL_free(coverage);
             SDL_free(pixels);
-            SDL_free(edges);
             forge_ui_ttf_glyph_free(&glyph);
             return false;
         }
@@ -1978,14 +3660,27 @@ static bool forge_ui_rasterize_glyph(const ForgeUiFont *font,
             }
         }
 
+        /* The edge table is built after scaling so spans are in
+         * supersampled rows */
+        if (use_aet) {
+            if (!forge_ui__edge_table_init(&aet, edges, edge_count)) {
+                SDL_free(hi_row);
+                SDL_free(coverage);
+                SDL_free(pixels);
+                forge_ui_ttf_glyph_free(&glyph);
+                return false;
+            }
+            table = &aet;
+        }
+
         for (int y = 0; y < bmp_h; y++) {
             SDL_memset(coverage, 0, sizeof(int) * (size_t)bmp_w);
 
             for (int sub_y = 0; sub_y < ss; sub_y++) {
                 float scan_y = (float)(y * ss + sub_y) + 0.5f;
                 SDL_memset(hi_row, 0, (size_t)hi_w);
-                forge_ui__rasterize_scanline(edges, edge_count, scan_y,
-                                              hi_row, hi_w);
+                forge_ui__raster_row(edges, edge_count, table, scan_y,
+                                     hi_row, hi_w);
 
                 /* Accumulate sub-pixel coverage into output pixels */
                 for (int x = 0; x < bmp_w; x++) {
@@ -2011,6 +3706,10 @@ static bool forge_ui_rasterize_glyph(const ForgeUiFont *font,
         SDL_free(hi_row);
     }
 
+    if (table) {
+        forge_ui__edge_table_free(table);
+    }
+
     /* Fill output bitmap struct */
     out_bitmap->width     = bmp_w;
     out_bitmap->height    = bmp_h;
@@ -2018,11 +3717,35 @@ static bool forge_ui_rasterize_glyph(const ForgeUiFont *font,
     out_bitmap->bearing_x = (int)SDL_floorf(scaled_x_min) - FORGE_UI__BITMAP_PAD;
     out_bitmap->bearing_y = (int)SDL_ceilf(scaled_y_max) + FORGE_UI__BITMAP_PAD;
 
-    SDL_free(edges);
     forge_ui_ttf_glyph_free(&glyph);
     return true;
 }
 
+static bool forge_ui_rasterize_glyph(const ForgeUiFont *font,
+                                      Uint16 glyph_index,
+                                      float pixel_height,
+                                      const ForgeUiRasterOpts *opts,
+                                      ForgeUiGlyphBitmap *out_bitmap)
+{
+    if (!font || !out_bitmap) {
+        SDL_Log("forge_ui_rasterize_glyph: NULL argument");
+        return false;
+    }
+
+    ForgeUi__Edge *edges = (ForgeUi__Edge *)SDL_malloc(
+        sizeof(ForgeUi__Edge) * FORGE_UI__MAX_EDGES);
+    if (!edges) {
+        SDL_Log("forge_ui_rasterize_glyph: allocation failed (edges)");
+        SDL_memset(out_bitmap, 0, sizeof(ForgeUiGlyphBitmap));
+        return false;
+    }
+    bool ok = forge_ui__rasterize_glyph_scratch(font, glyph_index,
+                                                pixel_height, opts, edges,
+                                                out_bitmap);
+    SDL_free(edges);
+    return ok;
+}
+
 static void forge_ui_glyph_bitmap_free(ForgeUiGlyphBitmap *bitmap)
 {
     if (!bitmap) return;
@@ -2030,6 +3753,251 @@ static void forge_ui_glyph_bitmap_free(ForgeUiGlyphBitmap *bitmap)
     SDL_memset(bitmap, 0, sizeof(ForgeUiGlyphBitmap));
 }
 
+/* ══════════════════════════════════════════════════════════════════════════ */
+/* ── Signed Distance Field Generation ───────────────────────────────────── */
+/* ══════════════════════════════════════════════════════════════════════════ */
+
+/* A distance field is generated in two passes over the same edges the
+ * coverage rasterizer uses:
+ *
+ *   1. Sign — for each texel row, gather the outline crossings at the row
+ *      center and walk them left to right with the non-zero winding rule.
+ *      A texel is inside if its center lies in a span with winding != 0.
+ *   2. Distance — the outline is flattened into line segments and each
+ *      texel takes the minimum point-to-segment distance.  Segments whose
+ *      bounding box is farther than the current best (initially just past
+ *      sdf_range, since anything farther clamps anyway) are skipped, which
+ *      keeps the brute-force search cheap for glyph-sized bitmaps.
+ *
+ * Curves are flattened with enough segments that the chord error
+ * dev / (4 n²) stays under FORGE_UI__SDF_FLATTEN_ERR texels, where dev is
+ * the control point's deviation |P0 - 2P1 + P2|. */
+
+#define FORGE_UI__SDF_FLATTEN_ERR   (1.0f / 32.0f)
+#define FORGE_UI__SDF_MAX_CURVE_SEGS 32
+
+typedef struct ForgeUi__SdfSegment {
+    float ax, ay;              /* start point (texels) */
+    float bx, by;              /* end point (texels) */
+    float min_x, min_y;        /* bounding box, for early rejection */
+    float max_x, max_y;
+} ForgeUi__SdfSegment;
+
+static void forge_ui__sdf_add_segment(ForgeUi__SdfSegment *segs, int *count,
+                                      float ax, float ay, float bx, float by)
+{
+    ForgeUi__SdfSegment *sg = &segs[(*count)++];
+    sg->ax = ax;  sg->ay = ay;
+    sg->bx = bx;  sg->by = by;
+    sg->min_x = ax < bx ? ax : bx;
+    sg->max_x = ax < bx ? bx : ax;
+    sg->min_y = ay < by ? ay : by;
+    sg->max_y = ay < by ? by : ay;
+}
+
+/* Squared distance from (px, py) to a segment. */
+static float forge_ui__sdf_dist_sq(const ForgeUi__SdfSegment *sg,
+                                   float px, float py)
+{
+    float dx = sg->bx - sg->ax;
+    float dy = sg->by - sg->ay;
+    float len_sq = dx * dx + dy * dy;
+    float t = 0.0f;
+    if (len_sq > FORGE_UI__EPSILON) {
+        t = ((px - sg->ax) * dx + (py - sg->ay) * dy) / len_sq;
+        if (t < 0.0f) t = 0.0f;
+        if (t > 1.0f) t = 1.0f;
+    }
+    float ex = sg->ax + t * dx - px;
+    float ey = sg->ay + t * dy - py;
+    return ex * ex + ey * ey;
+}
+
+/* SDF generation into caller-provided edge scratch, as
+ * forge_ui__rasterize_glyph_scratch. */
+static bool forge_ui__rasterize_glyph_sdf_scratch(const ForgeUiFont *font,
+                                                  Uint16 glyph_index,
+                                                  float pixel_height,
+                                                  float sdf_range,
+                                                  ForgeUi__Edge *edges,
+                                                  ForgeUiGlyphBitmap *out_bitmap)
+{
+    SDL_memset(out_bitmap, 0, sizeof(ForgeUiGlyphBitmap));
+
+    if (!(pixel_height > 0.0f)) {
+        SDL_Log("forge_ui_rasterize_glyph_sdf: pixel_height must be positive "
+                "(got %f)", (double)pixel_height);
+        return false;
+    }
+    if (!(sdf_range > 0.0f) || sdf_range > FORGE_UI_SDF_MAX_RANGE) {
+        SDL_Log("forge_ui_rasterize_glyph_sdf: sdf_range must be in "
+                "(0, %.0f] (got %f)", (double)FORGE_UI_SDF_MAX_RANGE,
+                (double)sdf_range);
+        return false;
+    }
+
+    ForgeUiTtfGlyph glyph;
+    if (!forge_ui_ttf_load_glyph(font, glyph_index, &glyph)) {
+        SDL_Log("forge_ui_rasterize_glyph_sdf: failed to load glyph %u",
+                glyph_index);
+        return false;
+    }
+    if (glyph.contour_count == 0) {
+        forge_ui_ttf_glyph_free(&glyph);
+        return true;  /* whitespace */
+    }
+
+    /* Unlike the coverage path, the bitmap origin is snapped to whole
+     * texels (floor/ceil of the bounding box) so the bearings describe the
+     * texel grid exactly.  That matters here because SDF quads are scaled
+     * to other pixel heights, which would magnify any sub-texel offset. */
+    float scale  = pixel_height / (float)font->head.units_per_em;
+    int   margin = FORGE_UI__BITMAP_PAD + (int)SDL_ceilf(sdf_range);
+    int   left   = (int)SDL_floorf((float)glyph.x_min * scale);
+    int   right  = (int)SDL_ceilf((float)glyph.x_max * scale);
+    int   bottom = (int)SDL_floorf((float)glyph.y_min * scale);
+    int   top    = (int)SDL_ceilf((float)glyph.y_max * scale);
+
+    int bmp_w = right - left + 2 * margin;
+    int bmp_h = top - bottom + 2 * margin;
+    if (right - left <= 0 || top - bottom <= 0) {
+        forge_ui_ttf_glyph_free(&glyph);
+        return true;  /* degenerate glyph */
+    }
+
+    int edge_count = forge_ui__build_edges(&glyph, scale,
+                                            (float)(top + margin),
+                                            edges, FORGE_UI__MAX_EDGES);
+    forge_ui_ttf_glyph_free(&glyph);
+
+    float x_offset = (float)(margin - left);
+    for (int i = 0; i < edge_count; i++) {
+        edges[i].x0 += x_offset;
+        edges[i].x1 += x_offset;
+        if (edges[i].type == FORGE_UI__EDGE_QUAD) {
+            edges[i].x2 += x_offset;
+        }
+    }
+
+    /* Flatten to segments: at most FORGE_UI__SDF_MAX_CURVE_SEGS per edge */
+    ForgeUi__SdfSegment *segs = (ForgeUi__SdfSegment *)SDL_malloc(
+        sizeof(ForgeUi__SdfSegment) * (size_t)(edge_count > 0 ? edge_count : 1) *
+        FORGE_UI__SDF_MAX_CURVE_SEGS);
+    Uint8 *pixels = (Uint8 *)SDL_malloc((size_t)bmp_w * (size_t)bmp_h);
+    if (!segs || !pixels) {
+        SDL_Log("forge_ui_rasterize_glyph_sdf: allocation failed");
+        SDL_free(segs);
+        SDL_free(pixels);
+        return false;
+    }
+
+    int seg_count = 0;
+    for (int i = 0; i < edge_count; i++) {
+        const ForgeUi__Edge *e = &edges[i];
+        if (e->type == FORGE_UI__EDGE_LINE) {
+            forge_ui__sdf_add_segment(segs, &seg_count,
+                                      e->x0, e->y0, e->x1, e->y1);
+            continue;
+        }
+        float dev_x = e->x0 - 2.0f * e->x1 + e->x2;
+        float dev_y = e->y0 - 2.0f * e->y1 + e->y2;
+        float dev = SDL_sqrtf(dev_x * dev_x + dev_y * dev_y);
+        int n = (int)SDL_ceilf(SDL_sqrtf(dev / (4.0f * FORGE_UI__SDF_FLATTEN_ERR)));
+        if (n < 1) n = 1;
+        if (n > FORGE_UI__SDF_MAX_CURVE_SEGS) n = FORGE_UI__SDF_MAX_CURVE_SEGS;
+        float px = e->x0, py = e->y0;
+        for (int k = 1; k <= n; k++) {
+            float t = (float)k / (float)n;
+            float u = 1.0f - t;
+            float nx = (k == n) ? e->x2
+                     : u * u * e->x0 + 2.0f * u * t * e->x1 + t * t * e->x2;
+            float ny = (k == n) ? e->y2
+                     : u * u * e->y0 + 2.0f * u * t * e->y1 + t * t * e->y2;
+            forge_ui__sdf_add_segment(segs, &seg_count, px, py, nx, ny);
+            px = nx;
+            py = ny;
+        }
+    }
+
+    float limit = sdf_range + 1.0f;  /* distances beyond this all clamp */
+    float value_scale = 127.5f / sdf_range;
+
+    for (int y = 0; y < bmp_h; y++) {
+        float cy = (float)y + 0.5f;
+
+        /* Pass 1: crossings for the inside test on this row */
+        ForgeUi__Crossing crossings[FORGE_UI__MAX_CROSSINGS];
+        int num_crossings = forge_ui__gather_crossings(
+            edges, edge_count, cy, crossings, FORGE_UI__MAX_CROSSINGS);
+        SDL_qsort(crossings, (size_t)num_crossings,
+                  sizeof(ForgeUi__Crossing), forge_ui__crossing_cmp);
+        int next = 0;
+        int winding = 0;
+
+        for (int x = 0; x < bmp_w; x++) {
+            float cx = (float)x + 0.5f;
+            while (next < num_crossings && crossings[next].x < cx) {
+                winding += crossings[next].winding;
+                next++;
+            }
+
+            /* Pass 2: nearest segment */
+            float best_sq = limit * limit;
+            for (int k = 0; k < seg_count; k++) {
+                const ForgeUi__SdfSegment *sg = &segs[k];
+                float bx = cx < sg->min_x ? sg->min_x - cx
+                         : (cx > sg->max_x ? cx - sg->max_x : 0.0f);
+                float by = cy < sg->min_y ? sg->min_y - cy
+                         : (cy > sg->max_y ? cy - sg->max_y : 0.0f);
+                if (bx * bx + by * by >= best_sq) continue;
+                float d_sq = forge_ui__sdf_dist_sq(sg, cx, cy);
+                if (d_sq < best_sq) best_sq = d_sq;
+            }
+
+            float dist = SDL_sqrtf(best_sq);
+            if (winding == 0) dist = -dist;
+            float v = 127.5f + dist * value_scale;
+            if (v < 0.0f) v = 0.0f;
+            if (v > 255.0f) v = 255.0f;
+            pixels[y * bmp_w + x] = (Uint8)(v + 0.5f);
+        }
+    }
+
+    SDL_free(segs);
+
+    out_bitmap->width     = bmp_w;
+    out_bitmap->height    = bmp_h;
+    out_bitmap->pixels    = pixels;
+    out_bitmap->bearing_x = left - margin;
+    out_bitmap->bearing_y = top + margin;
+    return true;
+}
+
+static bool forge_ui_rasterize_glyph_sdf(const ForgeUiFont *font,
+                                          Uint16 glyph_index,
+                                          float pixel_height,
+                                          float sdf_range,
+                                          ForgeUiGlyphBitmap *out_bitmap)
+{
+    if (!font || !out_bitmap) {
+        SDL_Log("forge_ui_rasterize_glyph_sdf: NULL argument");
+        return false;
+    }
+
+    ForgeUi__Edge *edges = (ForgeUi__Edge *)SDL_malloc(
+        sizeof(ForgeUi__Edge) * FORGE_UI__MAX_EDGES);
+    if (!edges) {
+        SDL_Log("forge_ui_rasterize_glyph_sdf: allocation failed (edges)");
+        SDL_memset(out_bitmap, 0, sizeof(ForgeUiGlyphBitmap));
+        return false;
+    }
+    bool ok = forge_ui__rasterize_glyph_sdf_scratch(font, glyph_index,
+                                                    pixel_height, sdf_range,
+                                                    edges, out_bitmap);
+    SDL_free(edges);
+    return ok;
+}
+
 /* ══════════════════════════════════════════════════════════════════════════ */
 /* ── hmtx Advance Width Lookup ──────────────────────────────────────────── */
 /* ══════════════════════════════════════════════════════════════════════════ */
@@ -2197,6 +4165,14 @@ static bool forge_ui__write_grayscale_bmp(const char *path,
  * inefficiency (row gaps above short glyphs, wasted ends of rows). */
 #define FORGE_UI__PACKING_SAFETY_MARGIN  1.15f
 
+/* The skyline packer fills most of those gaps, so it starts its size
+ * search closer to the raw glyph area. */
+#define FORGE_UI__SKYLINE_SAFETY_MARGIN  1.05f
+
+/* Column widths tried for non-power-of-two atlases, in steps of 1/16 of
+ * the square root of the glyph area. */
+#define FORGE_UI__NPOT_WIDTH_STEPS  8
+
 /* ── Internal: temporary glyph data during atlas building ──────────────── */
 
 typedef struct ForgeUi__GlyphEntry {
@@ -2208,6 +4184,69 @@ typedef struct ForgeUi__GlyphEntry {
     int                 atlas_y;      /* placement y in atlas (set by packer) */
 } ForgeUi__GlyphEntry;
 
+/* ── Internal: parallel glyph rasterization ───────────────────────────── */
+/* Phase 1 of the atlas build.  Threads claim codepoints in small chunks
+ * from a shared counter and write each result to the entry with the same
+ * index, so the outcome does not depend on which thread ran which glyph. */
+
+/* Codepoints claimed per counter increment — large enough to keep the
+ * atomic off the profile, small enough to balance uneven glyph costs. */
+#define FORGE_UI__ATLAS_RASTER_CHUNK 16
+
+typedef struct ForgeUi__AtlasRasterJob {
+    const ForgeUiFont   *font;
+    float                pixel_height;
+    ForgeUiAtlasMode     mode;
+    float                sdf_range;
+    ForgeUiRasterOpts    opts;        /* coverage mode options */
+    const Uint32        *codepoints;
+    int                  count;
+    ForgeUi__GlyphEntry *entries;     /* [count] results, indexed like codepoints */
+    bool                *ok;          /* [count] rasterization succeeded */
+    SDL_AtomicInt        next;        /* next unclaimed codepoint index */
+} ForgeUi__AtlasRasterJob;
+
+/* Returns 0 on success, -1 if the thread's edge scratch could not be
+ * allocated (it then claims no work). */
+static int forge_ui__atlas_raster_worker(void *data)
+{
+    ForgeUi__AtlasRasterJob *job = (ForgeUi__AtlasRasterJob *)data;
+
+    ForgeUi__Edge *edges = (ForgeUi__Edge *)SDL_malloc(
+        sizeof(ForgeUi__Edge) * FORGE_UI__MAX_EDGES);
+    if (!edges) {
+        SDL_Log("forge_ui_atlas_build: allocation failed (edges)");
+        return -1;
+    }
+
+    for (;;) {
+        int start = SDL_AddAtomicInt(&job->next, FORGE_UI__ATLAS_RASTER_CHUNK);
+        if (start >= job->count) break;
+        int end = start + FORGE_UI__ATLAS_RASTER_CHUNK;
+        if (end > job->count) end = job->count;
+
+        for (int i = start; i < end; i++) {
+            ForgeUi__GlyphEntry *e = &job->entries[i];
+            Uint32 cp = job->codepoints[i];
+            Uint16 gi = forge_ui_ttf_glyph_index(job->font, cp);
+
+            e->codepoint     = cp;
+            e->glyph_index   = gi;
+            e->advance_width = forge_ui_ttf_advance_width(job->font, gi);
+            job->ok[i] = (job->mode == FORGE_UI_ATLAS_SDF)
+                ? forge_ui__rasterize_glyph_sdf_scratch(
+                      job->font, gi, job->pixel_height, job->sdf_range,
+                      edges, &e->bitmap)
+                : forge_ui__rasterize_glyph_scratch(
+                      job->font, gi, job->pixel_height, &job->opts,
+                      edges, &e->bitmap);
+        }
+    }
+
+    SDL_free(edges);
+    return 0;
+}
+
 /* ── Internal: comparison function for sorting glyphs by height ────────── */
 /* Sort tallest first so shelf rows are filled efficiently. */
 
@@ -2296,64 +4335,473 @@ static bool forge_ui__shelf_pack(ForgeUi__GlyphEntry *entries,
     return true;
 }
 
-/* ── Internal: find smallest power-of-two atlas that fits ──────────────── */
-/* Estimates the required area, picks an initial power-of-two size, then
- * tries packing.  If it fails, doubles the smaller dimension and retries. */
+/* ── Internal: skyline packer ──────────────────────────────────────────── */
+/* Pack glyphs with the skyline bottom-left heuristic.
+ *
+ * The skyline is the top contour of everything placed so far, stored as
+ * horizontal segments left to right.  Each glyph tries every segment as
+ * its left edge, resting on the highest segment it spans, and goes where
+ * its bottom edge ends up lowest (ties: the narrower segment).  The glyph
+ * then becomes a new segment and the ones it covers are trimmed.
+ *
+ * Padding works as in the shelf packer: a border around the atlas and a
+ * gap between glyphs.  nodes must hold count + 1 segments — each placed
+ * glyph adds at most one. */
+
+typedef struct ForgeUi__SkylineNode {
+    int x;      /* left edge */
+    int y;      /* first free row at this span */
+    int width;  /* span width */
+} ForgeUi__SkylineNode;
+
+/* Top y at which a w × h rectangle fits with its left edge on node i, or
+ * -1 if it runs off the right or bottom of the atlas. */
+static int forge_ui__skyline_fit(const ForgeUi__SkylineNode *nodes,
+                                 int node_count, int i, int w, int h,
+                                 int atlas_w, int atlas_h)
+{
+    if (nodes[i].x + w > atlas_w) return -1;
+    int y = nodes[i].y;
+    int remaining = w;
+    for (int j = i; remaining > 0; j++) {
+        if (j >= node_count) return -1;
+        if (nodes[j].y > y) y = nodes[j].y;
+        if (y + h > atlas_h) return -1;
+        remaining -= nodes[j].width;
+    }
+    return y;
+}
 
-static bool forge_ui__find_atlas_size(ForgeUi__GlyphEntry *entries,
-                                       int count,
-                                       int padding,
-                                       int *out_w, int *out_h)
+static bool forge_ui__skyline_pack(ForgeUi__GlyphEntry *entries,
+                                    int count,
+                                    int atlas_w, int atlas_h,
+                                    int padding,
+                                    ForgeUi__SkylineNode *nodes)
 {
-    /* Estimate total area needed (sum of padded glyph areas + white pixel).
-     * Use 64-bit arithmetic to avoid overflow when many large glyphs are
-     * present.  Multiply by the packing safety margin to account for shelf
-     * inefficiency (row gaps above short glyphs, wasted row ends). */
-    Uint64 total_area_u = (Uint64)FORGE_UI__WHITE_SIZE * FORGE_UI__WHITE_SIZE;
+    int node_count = 1;
+    nodes[0].x = padding;
+    nodes[0].y = padding;
+    nodes[0].width = atlas_w - padding;
+
     for (int i = 0; i < count; i++) {
-        Uint64 pw = (Uint64)(entries[i].bitmap.width + padding * 2);
-        Uint64 ph = (Uint64)(entries[i].bitmap.height + padding * 2);
-        total_area_u += pw * ph;
-    }
-    total_area_u = (Uint64)((double)total_area_u *
-                            (double)FORGE_UI__PACKING_SAFETY_MARGIN);
-    /* Clamp to maximum atlas area to avoid overflow when cast to int */
+        int gw = entries[i].bitmap.width;
+        int gh = entries[i].bitmap.height;
+
+        /* Skip zero-size bitmaps (whitespace glyphs like space) */
+        if (gw == 0 || gh == 0) {
+            entries[i].atlas_x = 0;
+            entries[i].atlas_y = 0;
+            continue;
+        }
+
+        int padded_w = gw + padding;
+        int padded_h = gh + padding;
+        if (padded_w + padding > atlas_w || padded_h + padding > atlas_h) {
+            return false;  /* atlas too small for this glyph */
+        }
+
+        int best = -1;
+        int best_y = 0;
+        int best_bottom = INT_MAX;
+        int best_width = INT_MAX;
+        for (int n = 0; n < node_count; n++) {
+            int y = forge_ui__skyline_fit(nodes, node_count, n,
+                                          padded_w, padded_h,
+                                          atlas_w, atlas_h);
+            if (y < 0) continue;
+            int bottom = y + padded_h;
+            if (bottom < best_bottom
+                || (bottom == best_bottom && nodes[n].width < best_width)) {
+                best = n;
+                best_y = y;
+                best_bottom = bottom;
+                best_width = nodes[n].width;
+            }
+        }
+        if (best < 0) {
+            return false;  /* atlas too small */
+        }
+
+        entries[i].atlas_x = nodes[best].x;
+        entries[i].atlas_y = best_y;
+
+        /* Insert the glyph's top as a new segment */
+        SDL_memmove(&nodes[best + 1], &nodes[best],
+                    sizeof(ForgeUi__SkylineNode) * (size_t)(node_count - best));
+        nodes[best].width = padded_w;
+        nodes[best].y = best_bottom;
+        node_count++;
+
+        /* Trim or drop the segments now underneath it */
+        int right = nodes[best].x + padded_w;
+        int j = best + 1;
+        while (j < node_count && nodes[j].x < right) {
+            int overlap = right - nodes[j].x;
+            if (overlap < nodes[j].width) {
+                nodes[j].x += overlap;
+                nodes[j].width -= overlap;
+                break;
+            }
+            SDL_memmove(&nodes[j], &nodes[j + 1],
+                        sizeof(ForgeUi__SkylineNode) *
+                        (size_t)(node_count - j - 1));
+            node_count--;
+        }
+
+        /* Merge neighbors at the same height */
+        for (int k = 0; k + 1 < node_count; ) {
+            if (nodes[k].y == nodes[k + 1].y) {
+                nodes[k].width += nodes[k + 1].width;
+                SDL_memmove(&nodes[k + 1], &nodes[k + 2],
+                            sizeof(ForgeUi__SkylineNode) *
+                            (size_t)(node_count - k - 2));
+                node_count--;
+            } else {
+                k++;
+            }
+        }
+    }
+
+    return true;
+}
+
+/* ── Internal: find the smallest atlas that fits ───────────────────────── */
+/* Power-of-two atlases: estimate the required area, pick the smallest
+ * power-of-two square (shelf) or half-square rectangle (skyline) that
+ * holds it, then try packing, doubling the smaller dimension on failure.
+ *
+ * Non-power-of-two atlases: pack into columns as tall as the maximum
+ * dimension, at several widths near the square root of the glyph area,
+ * trim each to its lowest glyph, and keep the smallest. */
+
+/* Pack into a w × h region with the chosen algorithm */
+static bool forge_ui__atlas_pack(ForgeUi__GlyphEntry *entries, int count,
+                                 int w, int h, int padding,
+                                 ForgeUiAtlasPacker packer,
+                                 ForgeUi__SkylineNode *nodes)
+{
+    if (packer == FORGE_UI_ATLAS_PACK_SKYLINE) {
+        return forge_ui__skyline_pack(entries, count, w, h, padding, nodes);
+    }
+    return forge_ui__shelf_pack(entries, count, w, h, padding);
+}
+
+/* Round v up to a multiple of FORGE_UI_ATLAS_NPOT_ALIGN */
+static int forge_ui__npot_align(int v)
+{
+    return (v + FORGE_UI_ATLAS_NPOT_ALIGN - 1)
+         / FORGE_UI_ATLAS_NPOT_ALIGN * FORGE_UI_ATLAS_NPOT_ALIGN;
+}
+
+/* Atlas height used by the last pack: the lowest glyph's bottom edge plus
+ * its padding, aligned to FORGE_UI_ATLAS_NPOT_ALIGN */
+static int forge_ui__packed_height(const ForgeUi__GlyphEntry *entries,
+                                   int count, int padding)
+{
+    int h = padding;
+    for (int i = 0; i < count; i++) {
+        if (entries[i].bitmap.width == 0 || entries[i].bitmap.height == 0) {
+            continue;
+        }
+        int bottom = entries[i].atlas_y + entries[i].bitmap.height + padding;
+        if (bottom > h) h = bottom;
+    }
+    return forge_ui__npot_align(h);
+}
+
+static bool forge_ui__find_atlas_size(ForgeUi__GlyphEntry *entries,
+                                       int count,
+                                       int padding,
+                                       ForgeUiAtlasPacker packer,
+                                       bool non_power_of_two,
+                                       int *out_w, int *out_h)
+{
+    /* Estimate total area needed (sum of padded glyph areas + white pixel).
+     * Use 64-bit arithmetic to avoid overflow when many large glyphs are
+     * present.  Multiply by the packing safety margin to account for packer
+     * inefficiency (row gaps above short glyphs, wasted row ends). */
+    Uint64 total_area_u = (Uint64)FORGE_UI__WHITE_SIZE * FORGE_UI__WHITE_SIZE;
+    int widest = 0;
+    for (int i = 0; i < count; i++) {
+        Uint64 pw = (Uint64)(entries[i].bitmap.width + padding * 2);
+        Uint64 ph = (Uint64)(entries[i].bitmap.height + padding * 2);
+        total_area_u += pw * ph;
+        if ((int)pw > widest) widest = (int)pw;
+    }
+    Uint64 raw_area = total_area_u;
+    float margin = (packer == FORGE_UI_ATLAS_PACK_SKYLINE)
+        ? FORGE_UI__SKYLINE_SAFETY_MARGIN : FORGE_UI__PACKING_SAFETY_MARGIN;
+    total_area_u = (Uint64)((double)total_area_u * (double)margin);
+    /* Clamp to maximum atlas area to avoid overflow when cast to int */
     Uint64 max_area = (Uint64)FORGE_UI__MAX_ATLAS_DIM *
                       (Uint64)FORGE_UI__MAX_ATLAS_DIM;
     if (total_area_u > max_area) total_area_u = max_area;
     int total_area = (int)total_area_u;
 
-    /* Find the smallest power-of-two square that exceeds the total area */
-    int size = FORGE_UI__MIN_ATLAS_DIM;
-    while (size * size < total_area && size < FORGE_UI__MAX_ATLAS_DIM) {
-        size *= 2;
+    ForgeUi__SkylineNode *nodes = NULL;
+    if (packer == FORGE_UI_ATLAS_PACK_SKYLINE) {
+        nodes = (ForgeUi__SkylineNode *)SDL_malloc(
+            sizeof(ForgeUi__SkylineNode) * ((size_t)count + 1));
+        if (!nodes) {
+            SDL_Log("forge_ui__find_atlas_size: allocation failed "
+                    "(skyline)");
+            return false;
+        }
     }
 
-    /* Try packing with progressively larger dimensions */
-    int w = size;
-    int h = size;
-
-    while (w <= FORGE_UI__MAX_ATLAS_DIM && h <= FORGE_UI__MAX_ATLAS_DIM) {
-        if (forge_ui__shelf_pack(entries, count, w, h, padding)) {
-            *out_w = w;
-            *out_h = h;
+    if (non_power_of_two) {
+        /* Column width is a guess, so try a few from the square root of
+         * the raw area upward and keep the smallest result (ties go to
+         * the narrower, squarer one).  The winner is packed again last so
+         * the entries hold its positions. */
+        int base = (int)SDL_ceilf(SDL_sqrtf((float)raw_area));
+        int best_w = 0, best_h = 0;
+        Uint64 best_area = 0;
+        for (int k = 0; k < FORGE_UI__NPOT_WIDTH_STEPS; k++) {
+            int w = forge_ui__npot_align(base + base * k / 16);
+            if (w < widest) w = forge_ui__npot_align(widest);
+            if (w > FORGE_UI__MAX_ATLAS_DIM) break;
+            if (!forge_ui__atlas_pack(entries, count, w,
+                                      FORGE_UI__MAX_ATLAS_DIM, padding,
+                                      packer, nodes)) {
+                continue;
+            }
+            int h = forge_ui__packed_height(entries, count, padding);
+            Uint64 area = (Uint64)w * (Uint64)h;
+            if (best_w == 0 || area < best_area) {
+                best_w = w;
+                best_h = h;
+                best_area = area;
+            }
+        }
+        if (best_w > 0
+            && forge_ui__atlas_pack(entries, count, best_w,
+                                    FORGE_UI__MAX_ATLAS_DIM, padding, packer,
+                                    nodes)) {
+            SDL_free(nodes);
+            *out_w = best_w;
+            *out_h = best_h;
             return true;
         }
-
-        /* Double the smaller dimension first, then the other */
-        if (w <= h) {
-            w *= 2;
+    } else {
+        int w = FORGE_UI__MIN_ATLAS_DIM;
+        int h = FORGE_UI__MIN_ATLAS_DIM;
+        if (packer == FORGE_UI_ATLAS_PACK_SKYLINE) {
+            /* Skyline packs tightly enough to fill a half-square, so start
+             * from the smallest power-of-two rectangle (width at most
+             * twice the height) that exceeds the total area */
+            while ((Uint64)w * (Uint64)h < (Uint64)total_area
+                   && h < FORGE_UI__MAX_ATLAS_DIM) {
+                if (w <= h) {
+                    w *= 2;
+                } else {
+                    h *= 2;
+                }
+            }
         } else {
-            h *= 2;
+            /* Find the smallest power-of-two square that exceeds the
+             * total area */
+            while (w * w < total_area && w < FORGE_UI__MAX_ATLAS_DIM) {
+                w *= 2;
+            }
+            h = w;
+        }
+
+        /* Try packing with progressively larger dimensions */
+        while (w <= FORGE_UI__MAX_ATLAS_DIM && h <= FORGE_UI__MAX_ATLAS_DIM) {
+            if (forge_ui__atlas_pack(entries, count, w, h, padding, packer,
+                                     nodes)) {
+                SDL_free(nodes);
+                *out_w = w;
+                *out_h = h;
+                return true;
+            }
+
+            /* Double the smaller dimension first, then the other */
+            if (w <= h) {
+                w *= 2;
+            } else {
+                h *= 2;
+            }
         }
     }
 
+    SDL_free(nodes);
     SDL_Log("forge_ui__find_atlas_size: could not fit %d glyphs in a "
             "%dx%d atlas", count, FORGE_UI__MAX_ATLAS_DIM,
             FORGE_UI__MAX_ATLAS_DIM);
     return false;
 }
 
+/* ── Codepoint lookup tables ─────────────────────────────────────────────── */
+/*
+ * forge_ui_atlas_lookup() runs once per character laid out, so it must not
+ * scale with the glyph count.  BMP codepoints (which covers Latin, Greek,
+ * Cyrillic, CJK, etc.) map through a two-level page table — only pages that
+ * actually contain glyphs are allocated, so an ASCII-only atlas costs one
+ * 1 KB page.  Supplementary-plane codepoints are sparse (emoji, historic
+ * scripts), so they use an open-addressed hash with linear probing sized to
+ * at most 50% load.
+ */
+
+#define FORGE_UI__LOOKUP_BMP_MAX     0xFFFFu
+#define FORGE_UI__LOOKUP_PAGE_SHIFT  8        /* high byte selects the page */
+#define FORGE_UI__LOOKUP_PAGE_SIZE   256      /* glyph slots per page */
+#define FORGE_UI__LOOKUP_PAGE_MASK   0xFFu    /* low byte selects the slot */
+#define FORGE_UI__LOOKUP_EMPTY       (-1)     /* slot holds no glyph */
+#define FORGE_UI__LOOKUP_HASH_MAX    (1 << 28) /* cap on hashed glyphs */
+
+/* Knuth multiplicative hash — spreads consecutive codepoints across the
+ * table so runs of adjacent emoji do not form long probe chains. */
+static inline Uint32 forge_ui__lookup_hash(Uint32 codepoint)
+{
+    return codepoint * 2654435761u;
+}
+
+/* Build the page table and hash from atlas->glyphs.  When a codepoint
+ * appears more than once, the lowest glyph index wins, matching the order
+ * a linear scan would find.  Returns false on allocation failure. */
+static bool forge_ui__atlas_build_lookup(ForgeUiFontAtlas *atlas)
+{
+    SDL_memset(atlas->lookup_page_map, 0, sizeof(atlas->lookup_page_map));
+    atlas->lookup_pages     = NULL;
+    atlas->lookup_hash      = NULL;
+    atlas->lookup_hash_mask = 0;
+    atlas->lookup_ready     = false;
+
+    /* Pass 1: assign page numbers and count supplementary glyphs */
+    int page_count = 0;
+    int supp_count = 0;
+    for (int i = 0; i < atlas->glyph_count; i++) {
+        Uint32 cp = atlas->glyphs[i].codepoint;
+        if (cp <= FORGE_UI__LOOKUP_BMP_MAX) {
+            Uint32 hi = cp >> FORGE_UI__LOOKUP_PAGE_SHIFT;
+            if (atlas->lookup_page_map[hi] == 0) {
+                atlas->lookup_page_map[hi] = (Uint16)(++page_count);
+            }
+        } else {
+            supp_count++;
+        }
+    }
+
+    if (page_count > 0) {
+        size_t slots = (size_t)page_count * FORGE_UI__LOOKUP_PAGE_SIZE;
+        atlas->lookup_pages = (Sint32 *)SDL_malloc(slots * sizeof(Sint32));
+        if (!atlas->lookup_pages) {
+            SDL_Log("forge_ui__atlas_build_lookup: allocation failed (pages)");
+            return false;
+        }
+        for (size_t i = 0; i < slots; i++) {
+            atlas->lookup_pages[i] = FORGE_UI__LOOKUP_EMPTY;
+        }
+    }
+
+    if (supp_count > 0) {
+        if (supp_count > FORGE_UI__LOOKUP_HASH_MAX) {
+            SDL_Log("forge_ui__atlas_build_lookup: too many supplementary "
+                    "glyphs (%d)", supp_count);
+            SDL_free(atlas->lookup_pages);
+            atlas->lookup_pages = NULL;
+            return false;
+        }
+        Uint32 cap = 1;
+        while (cap < (Uint32)supp_count * 2) {
+            cap <<= 1;
+        }
+        atlas->lookup_hash = (Sint32 *)SDL_malloc((size_t)cap * sizeof(Sint32));
+        if (!atlas->lookup_hash) {
+            SDL_Log("forge_ui__atlas_build_lookup: allocation failed (hash)");
+            SDL_free(atlas->lookup_pages);
+            atlas->lookup_pages = NULL;
+            return false;
+        }
+        for (Uint32 i = 0; i < cap; i++) {
+            atlas->lookup_hash[i] = FORGE_UI__LOOKUP_EMPTY;
+        }
+        atlas->lookup_hash_mask = cap - 1;
+    }
+
+    /* Pass 2: insert glyph indices (first occurrence wins) */
+    for (int i = 0; i < atlas->glyph_count; i++) {
+        Uint32 cp = atlas->glyphs[i].codepoint;
+        if (cp <= FORGE_UI__LOOKUP_BMP_MAX) {
+            Uint16 page = atlas->lookup_page_map[cp >> FORGE_UI__LOOKUP_PAGE_SHIFT];
+            Sint32 *slot = &atlas->lookup_pages[
+                (size_t)(page - 1) * FORGE_UI__LOOKUP_PAGE_SIZE
+                + (cp & FORGE_UI__LOOKUP_PAGE_MASK)];
+            if (*slot == FORGE_UI__LOOKUP_EMPTY) {
+                *slot = (Sint32)i;
+            }
+        } else {
+            Uint32 h = forge_ui__lookup_hash(cp) & atlas->lookup_hash_mask;
+            while (atlas->lookup_hash[h] != FORGE_UI__LOOKUP_EMPTY &&
+                   atlas->glyphs[atlas->lookup_hash[h]].codepoint != cp) {
+                h = (h + 1) & atlas->lookup_hash_mask;
+            }
+            if (atlas->lookup_hash[h] == FORGE_UI__LOOKUP_EMPTY) {
+                atlas->lookup_hash[h] = (Sint32)i;
+            }
+        }
+    }
+
+    atlas->lookup_ready = true;
+    return true;
+}
+
+/* Copy the font's kerning pairs whose glyphs are both in the atlas, so
+ * layout can kern without a font reference.  Zero-valued pairs are
+ * dropped.  Returns false on allocation failure. */
+static bool forge_ui__atlas_build_kerning(ForgeUiFontAtlas *atlas,
+                                          const ForgeUiFont *font)
+{
+    SDL_memset(&atlas->kern, 0, sizeof(atlas->kern));
+    if (font->kern.count == 0) return true;
+
+    /* One bit per glyph index */
+    Uint8 *present = (Uint8 *)SDL_calloc(65536 / 8, 1);
+    if (!present) {
+        SDL_Log("forge_ui__atlas_build_kerning: allocation failed");
+        return false;
+    }
+    for (int i = 0; i < atlas->glyph_count; i++) {
+        Uint16 g = atlas->glyphs[i].glyph_index;
+        present[g >> 3] |= (Uint8)(1u << (g & 7));
+    }
+
+    bool ok = true;
+    for (Uint32 i = 0; ok && i <= font->kern.mask; i++) {
+        Uint32 key = font->kern.keys[i];
+        if (key == 0 || font->kern.values[i] == 0) continue;
+        Uint16 left = (Uint16)(key >> 16), right = (Uint16)key;
+        if ((present[left >> 3] & (1u << (left & 7))) &&
+            (present[right >> 3] & (1u << (right & 7)))) {
+            ok = forge_ui__kern_insert(&atlas->kern, left, right,
+                                       font->kern.values[i]);
+        }
+    }
+    SDL_free(present);
+    if (!ok) forge_ui__kern_free(&atlas->kern);
+    return ok;
+}
+
+/* ── Pixel height helpers ────────────────────────────────────────────────── */
+
+/* Height the glyph texels were rendered at.  Hand-assembled atlases leave
+ * raster_pixel_height at zero, meaning "the current pixel_height". */
+static float forge_ui__atlas_raster_height(const ForgeUiFontAtlas *atlas)
+{
+    return atlas->raster_pixel_height > 0.0f ? atlas->raster_pixel_height
+                                             : atlas->pixel_height;
+}
+
+/* Screen pixels per atlas texel when laying out at atlas->pixel_height.
+ * Always 1 for coverage atlases. */
+static float forge_ui__atlas_quad_scale(const ForgeUiFontAtlas *atlas)
+{
+    float raster = forge_ui__atlas_raster_height(atlas);
+    return raster > 0.0f ? atlas->pixel_height / raster : 1.0f;
+}
+
 /* ── Public atlas API ────────────────────────────────────────────────────── */
 
 static bool forge_ui_atlas_build(const ForgeUiFont *font,
@@ -2362,6 +4810,19 @@ static bool forge_ui_atlas_build(const ForgeUiFont *font,
                                   int codepoint_count,
                                   int padding,
                                   ForgeUiFontAtlas *out_atlas)
+{
+    return forge_ui_atlas_build_opts(font, pixel_height, codepoints,
+                                     codepoint_count, padding, NULL,
+                                     out_atlas);
+}
+
+static bool forge_ui_atlas_build_opts(const ForgeUiFont *font,
+                                       float pixel_height,
+                                       const Uint32 *codepoints,
+                                       int codepoint_count,
+                                       int padding,
+                                       const ForgeUiAtlasOpts *atlas_opts,
+                                       ForgeUiFontAtlas *out_atlas)
 {
     /* Validate public pointer arguments before any dereference */
     if (!out_atlas) {
@@ -2389,6 +4850,36 @@ static bool forge_ui_atlas_build(const ForgeUiFont *font,
     }
     if (padding < 0) padding = 0;
 
+    ForgeUiAtlasMode mode = FORGE_UI_ATLAS_COVERAGE;
+    float sdf_range = 0.0f;
+    if (atlas_opts && atlas_opts->mode == FORGE_UI_ATLAS_SDF) {
+        mode = FORGE_UI_ATLAS_SDF;
+        sdf_range = atlas_opts->sdf_range;
+        if (sdf_range == 0.0f) sdf_range = FORGE_UI_SDF_DEFAULT_RANGE;
+        if (!(sdf_range > 0.0f) || sdf_range > FORGE_UI_SDF_MAX_RANGE) {
+            SDL_Log("forge_ui_atlas_build: sdf_range must be in (0, %.0f] "
+                    "(got %f)", (double)FORGE_UI_SDF_MAX_RANGE,
+                    (double)sdf_range);
+            return false;
+        }
+    } else if (atlas_opts && atlas_opts->mode != FORGE_UI_ATLAS_COVERAGE) {
+        SDL_Log("forge_ui_atlas_build: invalid mode %d",
+                (int)atlas_opts->mode);
+        return false;
+    }
+
+    ForgeUiAtlasPacker packer = FORGE_UI_ATLAS_PACK_SHELF;
+    bool non_power_of_two = false;
+    if (atlas_opts) {
+        packer = atlas_opts->packer;
+        non_power_of_two = atlas_opts->non_power_of_two;
+        if (packer != FORGE_UI_ATLAS_PACK_SHELF
+            && packer != FORGE_UI_ATLAS_PACK_SKYLINE) {
+            SDL_Log("forge_ui_atlas_build: invalid packer %d", (int)packer);
+            return false;
+        }
+    }
+
     /* ── Phase 1: Rasterize all requested glyphs ─────────────────────── */
 
     /* Allocate one extra entry for the white pixel reservation so the shelf
@@ -2400,30 +4891,83 @@ static bool forge_ui_atlas_build(const ForgeUiFont *font,
         return false;
     }
 
+    /* Every codepoint is rasterized into its own slot, in parallel when
+     * thread_count > 1, then compacted in input order so the packer sees
+     * exactly what a serial build would. */
+    bool *raster_ok = (bool *)SDL_calloc((size_t)codepoint_count,
+                                         sizeof(bool));
+    if (!raster_ok) {
+        SDL_Log("forge_ui_atlas_build: allocation failed (raster flags)");
+        SDL_free(entries);
+        return false;
+    }
+
+    ForgeUi__AtlasRasterJob job;
+    SDL_memset(&job, 0, sizeof(job));
+    job.font         = font;
+    job.pixel_height = pixel_height;
+    job.mode         = mode;
+    job.sdf_range    = sdf_range;
+    job.codepoints   = codepoints;
+    job.count        = codepoint_count;
+    job.entries      = entries;
+    job.ok           = raster_ok;
     /* Default rasterization options: 4x4 supersampling */
-    ForgeUiRasterOpts opts;
-    opts.supersample_level = 4;
+    /* The active edge table gives the same pixels as the reference
+     * scanline path, only faster */
+    job.opts.supersample_level = 4;
+    job.opts.method = FORGE_UI_RASTER_ACTIVE_EDGE;
+    SDL_SetAtomicInt(&job.next, 0);
+
+    int thread_count = atlas_opts ? atlas_opts->thread_count : 1;
+    if (thread_count > FORGE_UI_ATLAS_MAX_THREADS) {
+        thread_count = FORGE_UI_ATLAS_MAX_THREADS;
+    }
+    if (thread_count > codepoint_count) thread_count = codepoint_count;
+
+    /* The caller is one of the threads; workers that fail to start just
+     * leave their share to the others. */
+    SDL_Thread *workers[FORGE_UI_ATLAS_MAX_THREADS];
+    int worker_count = 0;
+    for (int t = 1; t < thread_count; t++) {
+        SDL_Thread *th = SDL_CreateThread(forge_ui__atlas_raster_worker,
+                                          "forge_ui_atlas", &job);
+        if (!th) {
+            SDL_Log("forge_ui_atlas_build: SDL_CreateThread failed: %s",
+                    SDL_GetError());
+            break;
+        }
+        workers[worker_count++] = th;
+    }
+    int caller_status = forge_ui__atlas_raster_worker(&job);
+    for (int t = 0; t < worker_count; t++) {
+        SDL_WaitThread(workers[t], NULL);
+    }
+    if (caller_status != 0) {
+        /* The caller could not allocate scratch, so glyphs it would have
+         * claimed may be unrendered; fail rather than silently drop them */
+        for (int i = 0; i < codepoint_count; i++) {
+            forge_ui_glyph_bitmap_free(&entries[i].bitmap);
+        }
+        SDL_free(raster_ok);
+        SDL_free(entries);
+        return false;
+    }
 
     int valid_count = 0;
     for (int i = 0; i < codepoint_count; i++) {
-        Uint32 cp = codepoints[i];
-        Uint16 gi = forge_ui_ttf_glyph_index(font, cp);
-
-        ForgeUiGlyphBitmap bitmap;
-        if (!forge_ui_rasterize_glyph(font, gi, pixel_height, &opts, &bitmap)) {
+        if (!raster_ok[i]) {
             SDL_Log("forge_ui_atlas_build: failed to rasterize codepoint %u "
-                    "(glyph %u) -- skipping", cp, gi);
+                    "(glyph %u) -- skipping", entries[i].codepoint,
+                    entries[i].glyph_index);
             continue;
         }
-
-        entries[valid_count].codepoint     = cp;
-        entries[valid_count].glyph_index   = gi;
-        entries[valid_count].bitmap        = bitmap;
-        entries[valid_count].advance_width = forge_ui_ttf_advance_width(font, gi);
-        entries[valid_count].atlas_x       = 0;
-        entries[valid_count].atlas_y       = 0;
-        valid_count++;
+        entries[valid_count++] = entries[i];
     }
+    /* Clear the moved-from tail, including the white pixel slot below */
+    SDL_memset(&entries[valid_count], 0, sizeof(ForgeUi__GlyphEntry)
+               * (size_t)(codepoint_count + 1 - valid_count));
+    SDL_free(raster_ok);
 
     if (valid_count == 0) {
         SDL_Log("forge_ui_atlas_build: no glyphs could be rasterized");
@@ -2450,8 +4994,8 @@ static bool forge_ui_atlas_build(const ForgeUiFont *font,
 
     /* ── Phase 3: Find atlas dimensions and pack ─────────────────────── */
     int atlas_w = 0, atlas_h = 0;
-    if (!forge_ui__find_atlas_size(entries, pack_count, padding,
-                                    &atlas_w, &atlas_h)) {
+    if (!forge_ui__find_atlas_size(entries, pack_count, padding, packer,
+                                    non_power_of_two, &atlas_w, &atlas_h)) {
         SDL_Log("forge_ui_atlas_build: failed to find suitable atlas dimensions");
         for (int i = 0; i < pack_count; i++) {
             forge_ui_glyph_bitmap_free(&entries[i].bitmap);
@@ -2474,6 +5018,7 @@ static bool forge_ui_atlas_build(const ForgeUiFont *font,
 
     /* Copy each glyph bitmap into the atlas at its packed position.
      * Skip entries with NULL pixels (white pixel reservation entry). */
+    Uint64 used_texels = (Uint64)FORGE_UI__WHITE_SIZE * FORGE_UI__WHITE_SIZE;
     for (int i = 0; i < pack_count; i++) {
         ForgeUi__GlyphEntry *e = &entries[i];
         if (!e->bitmap.pixels || e->bitmap.width == 0
@@ -2487,6 +5032,7 @@ static bool forge_ui_atlas_build(const ForgeUiFont *font,
                 &e->bitmap.pixels[row * e->bitmap.width],
                 (size_t)e->bitmap.width);
         }
+        used_texels += (Uint64)e->bitmap.width * (Uint64)e->bitmap.height;
     }
 
     /* ── Phase 5: Write white pixel region ───────────────────────────── */
@@ -2566,6 +5112,8 @@ static bool forge_ui_atlas_build(const ForgeUiFont *font,
     out_atlas->height      = atlas_h;
     out_atlas->glyphs      = packed;
     out_atlas->glyph_count = valid_count;
+    out_atlas->packing_efficiency = (float)((double)used_texels /
+                                            ((double)atlas_w * (double)atlas_h));
 
     /* Store font metrics so text layout works without a separate font ref */
     out_atlas->pixel_height = pixel_height;
@@ -2574,18 +5122,31 @@ static bool forge_ui_atlas_build(const ForgeUiFont *font,
     out_atlas->descender    = font->hhea.descender;
     out_atlas->line_gap     = font->hhea.line_gap;
 
+    out_atlas->mode                = mode;
+    out_atlas->raster_pixel_height = pixel_height;
+    out_atlas->sdf_range           = sdf_range;
+
     /* White pixel UV rect (center of the 2x2 block for safe bilinear sampling) */
     out_atlas->white_uv.u0 = (float)white_x * inv_w;
     out_atlas->white_uv.v0 = (float)white_y * inv_h;
     out_atlas->white_uv.u1 = (float)(white_x + FORGE_UI__WHITE_SIZE) * inv_w;
     out_atlas->white_uv.v1 = (float)(white_y + FORGE_UI__WHITE_SIZE) * inv_h;
 
+    /* ── Phase 8: Build codepoint lookup and kerning tables ───────────── */
+    bool lookup_ok = forge_ui__atlas_build_lookup(out_atlas) &&
+                     forge_ui__atlas_build_kerning(out_atlas, font);
+
     /* ── Cleanup: free individual glyph bitmaps (data is in atlas now) ── */
     for (int i = 0; i < pack_count; i++) {
         forge_ui_glyph_bitmap_free(&entries[i].bitmap);
     }
     SDL_free(entries);
 
+    if (!lookup_ok) {
+        forge_ui_atlas_free(out_atlas);
+        return false;
+    }
+
     return true;
 }
 
@@ -2594,15 +5155,76 @@ static void forge_ui_atlas_free(ForgeUiFontAtlas *atlas)
     if (!atlas) return;
     SDL_free(atlas->glyphs);
     SDL_free(atlas->pixels);
+    SDL_free(atlas->lookup_pages);
+    SDL_free(atlas->lookup_hash);
+    forge_ui__kern_free(&atlas->kern);
     SDL_memset(atlas, 0, sizeof(ForgeUiFontAtlas));
 }
 
+static bool forge_ui_atlas_set_pixel_height(ForgeUiFontAtlas *atlas,
+                                             float pixel_height)
+{
+    if (!atlas) {
+        SDL_Log("forge_ui_atlas_set_pixel_height: atlas is NULL");
+        return false;
+    }
+    if (!(pixel_height > 0.0f && pixel_height <= FLT_MAX)) {
+        SDL_Log("forge_ui_atlas_set_pixel_height: pixel_height must be "
+                "positive and finite (got %f)", (double)pixel_height);
+        return false;
+    }
+    if (atlas->mode != FORGE_UI_ATLAS_SDF &&
+        pixel_height != forge_ui__atlas_raster_height(atlas)) {
+        SDL_Log("forge_ui_atlas_set_pixel_height: coverage atlases only "
+                "render at %.1f px; rebuild or use FORGE_UI_ATLAS_SDF",
+                (double)forge_ui__atlas_raster_height(atlas));
+        return false;
+    }
+    atlas->pixel_height = pixel_height;
+    return true;
+}
+
+static float forge_ui_atlas_sdf_screen_range(const ForgeUiFontAtlas *atlas)
+{
+    if (!atlas || atlas->mode != FORGE_UI_ATLAS_SDF) return 0.0f;
+    return 2.0f * atlas->sdf_range * forge_ui__atlas_quad_scale(atlas);
+}
+
 static const ForgeUiPackedGlyph *forge_ui_atlas_lookup(
     const ForgeUiFontAtlas *atlas, Uint32 codepoint)
 {
-    if (!atlas || !atlas->glyphs) return NULL;
+    if (!atlas) return NULL;
+    if (atlas->lookup_fn) return atlas->lookup_fn(atlas->lookup_data, codepoint);
+    if (!atlas->glyphs) return NULL;
+
+    if (atlas->lookup_ready) {
+        if (codepoint <= FORGE_UI__LOOKUP_BMP_MAX) {
+            /* Two memory reads: page map, then the page entry */
+            Uint16 page = atlas->lookup_page_map[
+                codepoint >> FORGE_UI__LOOKUP_PAGE_SHIFT];
+            if (page == 0) return NULL;
+            Sint32 idx = atlas->lookup_pages[
+                (size_t)(page - 1) * FORGE_UI__LOOKUP_PAGE_SIZE
+                + (codepoint & FORGE_UI__LOOKUP_PAGE_MASK)];
+            return (idx != FORGE_UI__LOOKUP_EMPTY) ? &atlas->glyphs[idx] : NULL;
+        }
 
-    /* Linear search — the glyph count is small (typically < 200) */
+        if (!atlas->lookup_hash) return NULL;
+
+        /* Linear probing — the table is at most half full, so an empty
+         * slot always terminates the probe sequence. */
+        Uint32 slot = forge_ui__lookup_hash(codepoint) & atlas->lookup_hash_mask;
+        for (;;) {
+            Sint32 idx = atlas->lookup_hash[slot];
+            if (idx == FORGE_UI__LOOKUP_EMPTY) return NULL;
+            if (atlas->glyphs[idx].codepoint == codepoint) {
+                return &atlas->glyphs[idx];
+            }
+            slot = (slot + 1) & atlas->lookup_hash_mask;
+        }
+    }
+
+    /* Linear search — only used for atlases without lookup tables */
     for (int i = 0; i < atlas->glyph_count; i++) {
         if (atlas->glyphs[i].codepoint == codepoint) {
             return &atlas->glyphs[i];
@@ -2611,6 +5233,13 @@ static const ForgeUiPackedGlyph *forge_ui_atlas_lookup(
     return NULL;
 }
 
+static Sint16 forge_ui_atlas_kerning(const ForgeUiFontAtlas *atlas,
+                                      Uint16 left_glyph, Uint16 right_glyph)
+{
+    if (!atlas) return 0;
+    return forge_ui__kern_lookup(&atlas->kern, left_glyph, right_glyph);
+}
+
 /* ══════════════════════════════════════════════════════════════════════════ */
 /* ── Text Layout Implementation ──────────────────────────────────────────── */
 /* ══════════════════════════════════════════════════════════════════════════ */
@@ -2633,48 +5262,49 @@ static const ForgeUiTextOpts FORGE_UI__DEFAULT_TEXT_OPTS = {
 /* Tab stop width in multiples of space advance */
 #define FORGE_UI__TAB_STOP_WIDTH 4
 
-/* ── Internal: emit one character quad into vertex/index arrays ──────────── */
+/* ── Internal: UTF-8 decoding ────────────────────────────────────────────── */
 
-static void forge_ui__emit_quad(
-    ForgeUiVertex *verts, int vert_base,
-    Uint32 *indices, int idx_base,
-    float x0, float y0, float x1, float y1,
-    float u0, float v0, float u1, float v1,
-    float r, float g, float b, float a)
+/* Substituted for malformed UTF-8 (rendered only if the atlas has it) */
+#define FORGE_UI__REPLACEMENT_CHAR 0xFFFDu
+
+/* Decode the rest of a multi-byte UTF-8 sequence whose lead byte (>= 0x80)
+ * was text[*i - 1].  On success *i is advanced past the continuation bytes
+ * and the codepoint returned.  Overlong forms, surrogates, values above
+ * U+10FFFF, and truncated sequences return U+FFFD with only the lead byte
+ * consumed, so decoding resynchronizes on the next byte. */
+static inline Uint32 forge_ui__utf8_decode(const char *text, int len,
+                                           Uint32 lead, int *i)
 {
-    /* Four vertices: top-left, top-right, bottom-right, bottom-left.
-     *
-     *   0 --- 1       Triangle 0: (0, 1, 2) — CCW
-     *   |   / |       Triangle 1: (2, 3, 0) — CCW
-     *   | /   |
-     *   3 --- 2
-     */
-    ForgeUiVertex *v = &verts[vert_base];
-
-    v[0].pos_x = x0;  v[0].pos_y = y0;  /* top-left */
-    v[0].uv_u  = u0;  v[0].uv_v  = v0;
-    v[0].r = r;  v[0].g = g;  v[0].b = b;  v[0].a = a;
-
-    v[1].pos_x = x1;  v[1].pos_y = y0;  /* top-right */
-    v[1].uv_u  = u1;  v[1].uv_v  = v0;
-    v[1].r = r;  v[1].g = g;  v[1].b = b;  v[1].a = a;
-
-    v[2].pos_x = x1;  v[2].pos_y = y1;  /* bottom-right */
-    v[2].uv_u  = u1;  v[2].uv_v  = v1;
-    v[2].r = r;  v[2].g = g;  v[2].b = b;  v[2].a = a;
-
-    v[3].pos_x = x0;  v[3].pos_y = y1;  /* bottom-left */
-    v[3].uv_u  = u0;  v[3].uv_v  = v1;
-    v[3].r = r;  v[3].g = g;  v[3].b = b;  v[3].a = a;
-
-    /* Two CCW triangles */
-    Uint32 base = (Uint32)vert_base;
-    indices[idx_base + 0] = base + 0;
-    indices[idx_base + 1] = base + 1;
-    indices[idx_base + 2] = base + 2;
-    indices[idx_base + 3] = base + 2;
-    indices[idx_base + 4] = base + 3;
-    indices[idx_base + 5] = base + 0;
+    int extra;
+    Uint32 cp;
+    Uint8 lo = 0x80, hi = 0xBF;  /* allowed range of the next byte */
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        extra = 1;
+        cp = lead & 0x1Fu;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        extra = 2;
+        cp = lead & 0x0Fu;
+        if (lead == 0xE0) lo = 0xA0;       /* overlong */
+        else if (lead == 0xED) hi = 0x9F;  /* surrogates */
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        extra = 3;
+        cp = lead & 0x07u;
+        if (lead == 0xF0) lo = 0x90;       /* overlong */
+        else if (lead == 0xF4) hi = 0x8F;  /* above U+10FFFF */
+    } else {
+        return FORGE_UI__REPLACEMENT_CHAR;
+    }
+    if (extra > len - *i) return FORGE_UI__REPLACEMENT_CHAR;
+
+    for (int k = 0; k < extra; k++) {
+        Uint8 c = (Uint8)text[*i + k];
+        if (c < lo || c > hi) return FORGE_UI__REPLACEMENT_CHAR;
+        lo = 0x80;
+        hi = 0xBF;
+        cp = (cp << 6) | (c & 0x3Fu);
+    }
+    *i += extra;
+    return cp;
 }
 
 /* ── Internal: apply horizontal alignment to vertices on one line ────────── */
@@ -2698,23 +5328,146 @@ static void forge_ui__align_line(
     }
 }
 
-/* ── forge_ui_text_layout ────────────────────────────────────────────────── */
+/* ── Internal: clip a glyph quad in place ────────────────────────────────── */
 
-static bool forge_ui_text_layout(const ForgeUiFontAtlas *atlas,
-                                  const char *text,
-                                  float x, float y,
-                                  const ForgeUiTextOpts *opts,
-                                  ForgeUiTextLayout *out_layout)
+/* Trim a glyph quad (top-left, top-right, bottom-right, bottom-left) to the
+ * rectangle [cx0, cx1) x [cy0, cy1), remapping UVs proportionally so the
+ * visible part of the glyph stays put.  Returns false if nothing of the
+ * quad remains; the vertices are then unspecified. */
+static bool forge_ui__clip_glyph_quad(ForgeUiVertex *v,
+                                      float cx0, float cy0,
+                                      float cx1, float cy1)
 {
-    if (!atlas || !text || !out_layout) {
-        SDL_Log("forge_ui_text_layout: NULL parameter");
+    /* Original quad bounds */
+    float x0 = v[0].pos_x, x1 = v[1].pos_x;
+    float y0 = v[0].pos_y, y1 = v[2].pos_y;
+
+    /* Fully outside or degenerate (zero area) -- discard */
+    if (x1 <= cx0 || x0 >= cx1 || y1 <= cy0 || y0 >= cy1) return false;
+    if (x0 >= x1 || y0 >= y1) return false;
+
+    /* Compute clipped bounds */
+    float nx0 = (x0 < cx0) ? cx0 : x0;
+    float ny0 = (y0 < cy0) ? cy0 : y0;
+    float nx1 = (x1 > cx1) ? cx1 : x1;
+    float ny1 = (y1 > cy1) ? cy1 : y1;
+
+    /* Discard degenerate (zero-area) intersections that can arise
+     * from edge-touching quads or zero-size clip rects. */
+    if (nx1 <= nx0 || ny1 <= ny0) return false;
+
+    /* Proportional UV remapping */
+    float u0 = v[0].uv_u, u1 = v[1].uv_u;
+    float v0 = v[0].uv_v, v1 = v[2].uv_v;
+
+    float inv_w = 1.0f / (x1 - x0);
+    float inv_h = 1.0f / (y1 - y0);
+
+    float nu0 = u0 + (u1 - u0) * (nx0 - x0) * inv_w;
+    float nu1 = u0 + (u1 - u0) * (nx1 - x0) * inv_w;
+    float nv0 = v0 + (v1 - v0) * (ny0 - y0) * inv_h;
+    float nv1 = v0 + (v1 - v0) * (ny1 - y0) * inv_h;
+
+    v[0].pos_x = nx0;  v[0].pos_y = ny0;  v[0].uv_u = nu0;  v[0].uv_v = nv0;
+    v[1].pos_x = nx1;  v[1].pos_y = ny0;  v[1].uv_u = nu1;  v[1].uv_v = nv0;
+    v[2].pos_x = nx1;  v[2].pos_y = ny1;  v[2].uv_u = nu1;  v[2].uv_v = nv1;
+    v[3].pos_x = nx0;  v[3].pos_y = ny1;  v[3].uv_u = nu0;  v[3].uv_v = nv1;
+    return true;
+}
+
+/* ── Internal: grow a sink array ─────────────────────────────────────────── */
+
+/* Ensure *buf (elem_size bytes per element) has room for `extra` elements
+ * past `count`, doubling from FORGE_UI__INITIAL_CHAR_CAPACITY quads. */
+static bool forge_ui__sink_reserve(void **buf, int *capacity, int count,
+                                    int extra, size_t elem_size,
+                                    int min_capacity)
+{
+    if (count > INT_MAX - extra) {
+        SDL_Log("forge_ui__sink_reserve: count overflow");
         return false;
     }
+    int needed = count + extra;
+    if (needed <= *capacity) return true;
 
-    SDL_memset(out_layout, 0, sizeof(ForgeUiTextLayout));
+    int new_cap = *capacity > min_capacity ? *capacity : min_capacity;
+    while (new_cap < needed) {
+        if (new_cap > INT_MAX / 2) {
+            SDL_Log("forge_ui__sink_reserve: capacity overflow");
+            return false;
+        }
+        new_cap *= 2;
+    }
+    if ((size_t)new_cap > SIZE_MAX / elem_size) {
+        SDL_Log("forge_ui__sink_reserve: allocation size overflow");
+        return false;
+    }
+
+    void *new_buf = SDL_realloc(*buf, (size_t)new_cap * elem_size);
+    if (!new_buf) {
+        SDL_Log("forge_ui__sink_reserve: realloc failed (%d elements)",
+                new_cap);
+        return false;
+    }
+    *buf = new_buf;
+    *capacity = new_cap;
+    return true;
+}
+
+/* ── Internal: finish one laid-out line ──────────────────────────────────── */
+
+/* Align quads [line_start, *quad_count) and, if the sink clips, trim them
+ * and compact the survivors in place.  Quads before line_start are final. */
+static void forge_ui__finish_line(ForgeUiVertex *verts, int line_start,
+                                  int *quad_count, float line_width,
+                                  const ForgeUiTextOpts *o,
+                                  const ForgeUiTextSink *sink)
+{
+    if (o->max_width > 0.0f && o->alignment != FORGE_UI_TEXT_ALIGN_LEFT) {
+        forge_ui__align_line(verts, line_start * FORGE_UI__VERTS_PER_QUAD,
+                              *quad_count * FORGE_UI__VERTS_PER_QUAD,
+                              line_width, o->max_width, o->alignment);
+    }
+
+    if (!sink->has_clip) return;
+
+    int kept = line_start;
+    for (int q = line_start; q < *quad_count; q++) {
+        ForgeUiVertex *quad = &verts[q * FORGE_UI__VERTS_PER_QUAD];
+        if (!forge_ui__clip_glyph_quad(quad, sink->clip_x0, sink->clip_y0,
+                                       sink->clip_x1, sink->clip_y1)) {
+            continue;
+        }
+        if (kept != q) {
+            SDL_memcpy(&verts[kept * FORGE_UI__VERTS_PER_QUAD], quad,
+                       FORGE_UI__VERTS_PER_QUAD * sizeof(ForgeUiVertex));
+        }
+        kept++;
+    }
+    *quad_count = kept;
+}
+
+/* ── forge_ui_text_layout_into ───────────────────────────────────────────── */
+
+static bool forge_ui_text_layout_into(const ForgeUiFontAtlas *atlas,
+                                       const char *text,
+                                       float x, float y,
+                                       const ForgeUiTextOpts *opts,
+                                       const ForgeUiTextSink *sink,
+                                       ForgeUiTextMetrics *out_metrics)
+{
+    if (out_metrics) SDL_memset(out_metrics, 0, sizeof(*out_metrics));
+
+    if (!atlas || !text || !sink || !sink->vertices || !sink->vertex_count
+        || !sink->vertex_capacity
+        || (sink->indices && (!sink->index_count || !sink->index_capacity))) {
+        SDL_Log("forge_ui_text_layout_into: NULL parameter");
+        return false;
+    }
 
     if (atlas->units_per_em == 0) {
-        SDL_Log("forge_ui_text_layout: atlas has units_per_em == 0 (invalid)");
+        SDL_Log("forge_ui_text_layout_into: atlas has units_per_em == 0 "
+                "(invalid)");
         return false;
     }
 
@@ -2725,6 +5478,10 @@ static bool forge_ui_text_layout(const ForgeUiFontAtlas *atlas,
      * multiply by this scale to get pixel-space advance. */
     float scale = atlas->pixel_height / (float)atlas->units_per_em;
 
+    /* Glyph bitmaps are measured in texels; an SDF atlas retargeted to a
+     * different pixel height scales its quads by this factor. */
+    float quad_scale = forge_ui__atlas_quad_scale(atlas);
+
     /* Line height in pixels: (ascender - descender + lineGap) * scale.
      * ascender is positive, descender is negative, so this is a sum of
      * three positive-ish values. */
@@ -2744,84 +5501,85 @@ static bool forge_ui_text_layout(const ForgeUiFontAtlas *atlas,
         ? (float)space_glyph->advance_width * scale
         : atlas->pixel_height * 0.5f;  /* fallback: half the pixel height */
 
-    /* Count visible characters to pre-allocate arrays.
-     * We allocate for worst case (all characters visible). */
     size_t raw_len = SDL_strlen(text);
-    if (raw_len > (size_t)INT_MAX) {
-        SDL_Log("forge_ui_text_layout: text too long (%zu bytes)", raw_len);
+    if (raw_len > (size_t)(INT_MAX / FORGE_UI__INDICES_PER_QUAD)) {
+        SDL_Log("forge_ui_text_layout_into: text too long (%zu bytes)",
+                raw_len);
         return false;
     }
     int text_len = (int)raw_len;
     if (text_len == 0) {
-        out_layout->line_count = 1;
+        if (out_metrics) out_metrics->line_count = 1;
         return true;
     }
 
-    /* Allocate vertex and index arrays */
-    int capacity = text_len;
-    if (capacity < FORGE_UI__INITIAL_CHAR_CAPACITY) {
-        capacity = FORGE_UI__INITIAL_CHAR_CAPACITY;
-    }
-
-    /* Use size_t for allocation arithmetic to avoid overflow on 32-bit.
-     * Check before multiplying: cap * VERTS_PER_QUAD * sizeof(vertex)
-     * could exceed SIZE_MAX when capacity is large. */
-    size_t cap = (size_t)capacity;
-    if (cap > SIZE_MAX / (FORGE_UI__VERTS_PER_QUAD * sizeof(ForgeUiVertex))) {
-        SDL_Log("forge_ui_text_layout: allocation size overflow (vertices)");
+    /* Reserve for the worst case (every byte a visible glyph) up front so
+     * the layout loop never reallocates under its own feet */
+    if (!forge_ui__sink_reserve((void **)sink->vertices, sink->vertex_capacity,
+                                *sink->vertex_count,
+                                text_len * FORGE_UI__VERTS_PER_QUAD,
+                                sizeof(ForgeUiVertex),
+                                FORGE_UI__INITIAL_CHAR_CAPACITY *
+                                FORGE_UI__VERTS_PER_QUAD)) {
         return false;
     }
-    if (cap > SIZE_MAX / (FORGE_UI__INDICES_PER_QUAD * sizeof(Uint32))) {
-        SDL_Log("forge_ui_text_layout: allocation size overflow (indices)");
+    if (sink->indices &&
+        !forge_ui__sink_reserve((void **)sink->indices, sink->index_capacity,
+                                *sink->index_count,
+                                text_len * FORGE_UI__INDICES_PER_QUAD,
+                                sizeof(Uint32),
+                                FORGE_UI__INITIAL_CHAR_CAPACITY *
+                                FORGE_UI__INDICES_PER_QUAD)) {
         return false;
     }
-    size_t verts_bytes   = cap * FORGE_UI__VERTS_PER_QUAD * sizeof(ForgeUiVertex);
-    size_t indices_bytes = cap * FORGE_UI__INDICES_PER_QUAD * sizeof(Uint32);
-
-    ForgeUiVertex *verts = (ForgeUiVertex *)SDL_malloc(verts_bytes);
-    Uint32 *indices = (Uint32 *)SDL_malloc(indices_bytes);
-
-    if (!verts || !indices) {
-        SDL_Log("forge_ui_text_layout: allocation failed");
-        SDL_free(verts);
-        SDL_free(indices);
+    if (*sink->vertex_count > INT_MAX - text_len * FORGE_UI__VERTS_PER_QUAD) {
+        SDL_Log("forge_ui_text_layout_into: vertex count overflow");
         return false;
     }
 
+    /* Quads are written from here on; quad indices below are relative */
+    ForgeUiVertex *verts = *sink->vertices + *sink->vertex_count;
+
     /* ── Layout loop ─────────────────────────────────────────────────── */
     float pen_x = x;
     float pen_y = y;
     float origin_x = x;            /* left edge for line resets */
-    int quad_count = 0;             /* visible characters emitted */
+    int quad_count = 0;             /* quads kept so far */
     int line_count = 1;
-    int line_start_vert = 0;        /* first vertex index of current line */
+    int line_start = 0;             /* first quad of current line */
     float line_width = 0.0f;        /* pen advance on current line */
     float max_line_width = 0.0f;    /* widest line seen so far */
 
-    for (int i = 0; i < text_len; i++) {
-        unsigned char ch = (unsigned char)text[i];
+    /* Pair kerning: consulted only when the atlas has pairs.  prev_glyph
+     * is the previous glyph on the line (0 = none, nothing to kern). */
+    const ForgeUiKernTable *kern = atlas->kern.count > 0 ? &atlas->kern : NULL;
+    Uint16 prev_glyph = 0;
+
+    for (int i = 0; i < text_len; ) {
+        /* ASCII bytes are codepoints as-is; only a byte >= 0x80 starts a
+         * multi-byte sequence, so plain ASCII text never decodes */
+        Uint32 ch = (Uint8)text[i++];
+        if (ch >= 0x80) ch = forge_ui__utf8_decode(text, text_len, ch, &i);
 
         /* ── Newline: start a new line ────────────────────────────── */
         if (ch == '\n') {
-            /* Apply alignment to the completed line */
-            if (o->max_width > 0.0f && o->alignment != FORGE_UI_TEXT_ALIGN_LEFT) {
-                forge_ui__align_line(verts, line_start_vert,
-                                      quad_count * FORGE_UI__VERTS_PER_QUAD,
-                                      line_width, o->max_width, o->alignment);
-            }
+            forge_ui__finish_line(verts, line_start, &quad_count,
+                                  line_width, o, sink);
 
             if (line_width > max_line_width) max_line_width = line_width;
 
             pen_x = origin_x;
             pen_y += line_height;
             line_width = 0.0f;
-            line_start_vert = quad_count * FORGE_UI__VERTS_PER_QUAD;
+            line_start = quad_count;
             line_count++;
+            prev_glyph = 0;
             continue;
         }
 
         /* ── Tab: advance to next tab stop ────────────────────────── */
         if (ch == '\t') {
+            prev_glyph = 0;
             float tab_width = space_advance * FORGE_UI__TAB_STOP_WIDTH;
             if (tab_width > 0.0f) {
                 float rel_x = pen_x - origin_x;
@@ -2835,28 +5593,39 @@ static bool forge_ui_text_layout(const ForgeUiFontAtlas *atlas,
 
         /* ── Look up glyph in atlas ───────────────────────────────── */
         const ForgeUiPackedGlyph *glyph = forge_ui_atlas_lookup(atlas, ch);
-        if (!glyph) continue;  /* skip unmapped characters */
+        if (!glyph) {
+            prev_glyph = 0;
+            continue;  /* skip unmapped characters */
+        }
 
         float advance = (float)glyph->advance_width * scale;
 
+        /* ── Kerning against the previous glyph ───────────────────── */
+        float kern_px = 0.0f;
+        if (kern && prev_glyph != 0) {
+            kern_px = (float)forge_ui__kern_lookup(kern, prev_glyph,
+                                                   glyph->glyph_index) * scale;
+        }
+        prev_glyph = glyph->glyph_index;
+
         /* ── Line wrapping: check if this character exceeds max_width ── */
-        if (o->max_width > 0.0f && line_width + advance > o->max_width &&
+        if (o->max_width > 0.0f &&
+            line_width + kern_px + advance > o->max_width &&
             line_width > 0.0f) {
-            /* Apply alignment to the completed line */
-            if (o->alignment != FORGE_UI_TEXT_ALIGN_LEFT) {
-                forge_ui__align_line(verts, line_start_vert,
-                                      quad_count * FORGE_UI__VERTS_PER_QUAD,
-                                      line_width, o->max_width, o->alignment);
-            }
+            forge_ui__finish_line(verts, line_start, &quad_count,
+                                  line_width, o, sink);
 
             if (line_width > max_line_width) max_line_width = line_width;
 
             pen_x = origin_x;
             pen_y += line_height;
             line_width = 0.0f;
-            line_start_vert = quad_count * FORGE_UI__VERTS_PER_QUAD;
+            line_start = quad_count;
             line_count++;
+            kern_px = 0.0f;  /* nothing to kern against at a line start */
         }
+        pen_x += kern_px;
+        line_width += kern_px;
 
         /* ── Space: advance pen but don't emit a quad ─────────────── */
         if (ch == ' ') {
@@ -2877,18 +5646,29 @@ static bool forge_ui_text_layout(const ForgeUiFontAtlas *atlas,
          * bearing_x is the horizontal offset from pen to bitmap left edge.
          * bearing_y is the vertical offset from baseline to bitmap top edge.
          * In y-down screen coordinates: bitmap top = pen_y - bearing_y. */
-        float qx0 = pen_x + (float)glyph->bearing_x;
-        float qy0 = pen_y - (float)glyph->bearing_y;
-        float qx1 = qx0 + (float)glyph->bitmap_w;
-        float qy1 = qy0 + (float)glyph->bitmap_h;
-
-        /* Emit the quad */
-        forge_ui__emit_quad(
-            verts, quad_count * FORGE_UI__VERTS_PER_QUAD,
-            indices, quad_count * FORGE_UI__INDICES_PER_QUAD,
-            qx0, qy0, qx1, qy1,
-            glyph->uv.u0, glyph->uv.v0, glyph->uv.u1, glyph->uv.v1,
-            o->r, o->g, o->b, o->a);
+        float qx0 = pen_x + (float)glyph->bearing_x * quad_scale;
+        float qy0 = pen_y - (float)glyph->bearing_y * quad_scale;
+        float qx1 = qx0 + (float)glyph->bitmap_w * quad_scale;
+        float qy1 = qy0 + (float)glyph->bitmap_h * quad_scale;
+
+        /* Four vertices: top-left, top-right, bottom-right, bottom-left.
+         *
+         *   0 --- 1       Triangle 0: (0, 1, 2) — CCW
+         *   |   / |       Triangle 1: (2, 3, 0) — CCW
+         *   | /   |
+         *   3 --- 2
+         *
+         * Indices are written once the quads are final (clipping may
+         * still drop or move them). */
+        ForgeUiVertex *v = &verts[quad_count * FORGE_UI__VERTS_PER_QUAD];
+        v[0] = (ForgeUiVertex){ qx0, qy0, glyph->uv.u0, glyph->uv.v0,
+                                o->r, o->g, o->b, o->a };
+        v[1] = (ForgeUiVertex){ qx1, qy0, glyph->uv.u1, glyph->uv.v0,
+                                o->r, o->g, o->b, o->a };
+        v[2] = (ForgeUiVertex){ qx1, qy1, glyph->uv.u1, glyph->uv.v1,
+                                o->r, o->g, o->b, o->a };
+        v[3] = (ForgeUiVertex){ qx0, qy1, glyph->uv.u0, glyph->uv.v1,
+                                o->r, o->g, o->b, o->a };
 
         quad_count++;
         pen_x += advance;
@@ -2896,23 +5676,74 @@ static bool forge_ui_text_layout(const ForgeUiFontAtlas *atlas,
     }
 
     /* ── Finalize last line ──────────────────────────────────────────── */
-    if (o->max_width > 0.0f && o->alignment != FORGE_UI_TEXT_ALIGN_LEFT) {
-        forge_ui__align_line(verts, line_start_vert,
-                              quad_count * FORGE_UI__VERTS_PER_QUAD,
-                              line_width, o->max_width, o->alignment);
-    }
+    forge_ui__finish_line(verts, line_start, &quad_count, line_width, o, sink);
 
     if (line_width > max_line_width) max_line_width = line_width;
 
-    /* ── Fill output struct ──────────────────────────────────────────── */
-    out_layout->vertices     = verts;
-    out_layout->vertex_count = quad_count * FORGE_UI__VERTS_PER_QUAD;
-    out_layout->indices      = indices;
-    out_layout->index_count  = quad_count * FORGE_UI__INDICES_PER_QUAD;
-    out_layout->total_width  = max_line_width;
-    out_layout->total_height = (float)line_count * line_height;
-    out_layout->line_count   = line_count;
+    /* ── Indices: two CCW triangles per kept quad ────────────────────── */
+    if (sink->indices) {
+        Uint32 *idx = *sink->indices + *sink->index_count;
+        Uint32 base = (Uint32)*sink->vertex_count;
+        for (int q = 0; q < quad_count; q++) {
+            Uint32 vb = base + (Uint32)(q * FORGE_UI__VERTS_PER_QUAD);
+            idx[0] = vb + 0;  idx[1] = vb + 1;  idx[2] = vb + 2;
+            idx[3] = vb + 2;  idx[4] = vb + 3;  idx[5] = vb + 0;
+            idx += FORGE_UI__INDICES_PER_QUAD;
+        }
+        *sink->index_count += quad_count * FORGE_UI__INDICES_PER_QUAD;
+    }
+    *sink->vertex_count += quad_count * FORGE_UI__VERTS_PER_QUAD;
 
+    if (out_metrics) {
+        out_metrics->width      = max_line_width;
+        out_metrics->height     = (float)line_count * line_height;
+        out_metrics->line_count = line_count;
+    }
+    return true;
+}
+
+/* ── forge_ui_text_layout ────────────────────────────────────────────────── */
+
+static bool forge_ui_text_layout(const ForgeUiFontAtlas *atlas,
+                                  const char *text,
+                                  float x, float y,
+                                  const ForgeUiTextOpts *opts,
+                                  ForgeUiTextLayout *out_layout)
+{
+    if (!atlas || !text || !out_layout) {
+        SDL_Log("forge_ui_text_layout: NULL parameter");
+        return false;
+    }
+
+    SDL_memset(out_layout, 0, sizeof(ForgeUiTextLayout));
+
+    if (atlas->units_per_em == 0) {
+        SDL_Log("forge_ui_text_layout: atlas has units_per_em == 0 (invalid)");
+        return false;
+    }
+
+    /* Lay out into arrays owned by the result; the sink allocates them at
+     * a minimum of FORGE_UI__INITIAL_CHAR_CAPACITY quads */
+    int vertex_capacity = 0;
+    int index_capacity = 0;
+    ForgeUiTextSink sink;
+    SDL_memset(&sink, 0, sizeof(sink));
+    sink.vertices        = &out_layout->vertices;
+    sink.vertex_count    = &out_layout->vertex_count;
+    sink.vertex_capacity = &vertex_capacity;
+    sink.indices         = &out_layout->indices;
+    sink.index_count     = &out_layout->index_count;
+    sink.index_capacity  = &index_capacity;
+
+    ForgeUiTextMetrics metrics;
+    if (!forge_ui_text_layout_into(atlas, text, x, y, opts, &sink, &metrics)) {
+        forge_ui_text_layout_free(out_layout);
+        return false;
+    }
+
+    out_layout->total_width  = metrics.width;
+    out_layout->total_height = metrics.height;
+    out_layout->line_count   = metrics.line_count;
     return true;
 }
 
@@ -2924,6 +5755,127 @@ static void forge_ui_text_layout_free(ForgeUiTextLayout *layout)
     SDL_memset(layout, 0, sizeof(ForgeUiTextLayout));
 }
 
+/* ── Vertex packing ──────────────────────────────────────────────────────── */
+
+/* Round a [0, 1] value to an unsigned normalized integer with `max` as
+ * 1.0, clamping out-of-range input and mapping NaN to 0.  The clamps are
+ * selects rather than early returns so the compiler can turn them into
+ * min/max instructions and keep the packing loop branch-free. */
+static inline Uint32 forge_ui__unorm(float f, float max)
+{
+    f = (f > 0.0f) ? f : 0.0f;   /* also catches NaN */
+    f = (f < 1.0f) ? f : 1.0f;
+    return (Uint32)(Sint32)(f * max + 0.5f);
+}
+
+/* Pack one vertex: the scalar reference the SIMD loops must match */
+static inline void forge_ui__pack_vertex(const ForgeUiVertex *s,
+                                         ForgeUiPackedVertex *d)
+{
+    d->pos_x = s->pos_x;
+    d->pos_y = s->pos_y;
+    d->uv_u  = (Uint16)forge_ui__unorm(s->uv_u, 65535.0f);
+    d->uv_v  = (Uint16)forge_ui__unorm(s->uv_v, 65535.0f);
+    d->r     = (Uint8)forge_ui__unorm(s->r, 255.0f);
+    d->g     = (Uint8)forge_ui__unorm(s->g, 255.0f);
+    d->b     = (Uint8)forge_ui__unorm(s->b, 255.0f);
+    d->a     = (Uint8)forge_ui__unorm(s->a, 255.0f);
+}
+
+/* The SIMD loops convert one vertex per register pair: position and UV
+ * in the first four floats, color in the last four.  The clamp, scale
+ * and round are the same float operations as forge_ui__unorm, so the
+ * output is bit-identical to the scalar path. */
+static void forge_ui_pack_vertices(const ForgeUiVertex *src,
+                                   ForgeUiPackedVertex *dst, int count)
+{
+    if (!src || !dst) return;
+    int i = 0;
+#if defined(FORGE_UI__SIMD_SSE2)
+    const __m128  zero     = _mm_setzero_ps();
+    const __m128  one      = _mm_set1_ps(1.0f);
+    const __m128  half     = _mm_set1_ps(0.5f);
+    const __m128  uv_scale = _mm_set1_ps(65535.0f);
+    const __m128  c_scale  = _mm_set1_ps(255.0f);
+    const __m128i bias     = _mm_set1_epi32(32768);
+    const __m128i flip     = _mm_set1_epi16((short)0x8000);
+    for (; i < count; i++) {
+        const float *s = (const float *)&src[i];
+        __m128 pos_uv = _mm_loadu_ps(s);      /* x, y, u, v */
+        __m128 color  = _mm_loadu_ps(s + 4);  /* r, g, b, a */
+        /* max returns its second operand for NaN, so NaN becomes 0 */
+        __m128 uv = _mm_movehl_ps(pos_uv, pos_uv);
+        uv    = _mm_min_ps(_mm_max_ps(uv, zero), one);
+        color = _mm_min_ps(_mm_max_ps(color, zero), one);
+        __m128i uvi = _mm_cvttps_epi32(
+            _mm_add_ps(_mm_mul_ps(uv, uv_scale), half));
+        __m128i ci  = _mm_cvttps_epi32(
+            _mm_add_ps(_mm_mul_ps(color, c_scale), half));
+        /* SSE2 only narrows with signed saturation: shift 0..65535 down
+         * to the int16 range and flip the sign bit back afterwards */
+        uvi = _mm_sub_epi32(uvi, bias);
+        uvi = _mm_xor_si128(_mm_packs_epi32(uvi, uvi), flip);
+        ci  = _mm_packs_epi32(ci, ci);
+        ci  = _mm_packus_epi16(ci, ci);
+        __m128i tail = _mm_unpacklo_epi32(uvi, ci);   /* uv, rgba */
+        _mm_storeu_si128((__m128i *)&dst[i],
+                         _mm_unpacklo_epi64(_mm_castps_si128(pos_uv), tail));
+    }
+#elif defined(FORGE_UI__SIMD_NEON)
+    const float32x4_t zero     = vdupq_n_f32(0.0f);
+    const float32x4_t one      = vdupq_n_f32(1.0f);
+    const float32x4_t half     = vdupq_n_f32(0.5f);
+    const float32x4_t uv_scale = vdupq_n_f32(65535.0f);
+    const float32x4_t c_scale  = vdupq_n_f32(255.0f);
+    for (; i < count; i++) {
+        const float *s = (const float *)&src[i];
+        float32x4_t pos_uv = vld1q_f32(s);      /* x, y, u, v */
+        float32x4_t color  = vld1q_f32(s + 4);  /* r, g, b, a */
+        float32x2_t uv2    = vget_high_f32(pos_uv);
+        float32x4_t uv     = vcombine_f32(uv2, uv2);
+        /* f > 0 is false for NaN, so NaN selects 0 */
+        uv    = vminq_f32(vbslq_f32(vcgtq_f32(uv, zero), uv, zero), one);
+        color = vminq_f32(vbslq_f32(vcgtq_f32(color, zero), color, zero),
+                          one);
+        uint32x4_t uvi = vcvtq_u32_f32(
+            vaddq_f32(vmulq_f32(uv, uv_scale), half));
+        uint32x4_t ci  = vcvtq_u32_f32(
+            vaddq_f32(vmulq_f32(color, c_scale), half));
+        uint16x4_t uv16 = vmovn_u32(uvi);
+        uint16x4_t c16  = vmovn_u32(ci);
+        uint8x8_t  c8   = vmovn_u16(vcombine_u16(c16, c16));
+        uint32x2_t tail = vdup_n_u32(
+            vget_lane_u32(vreinterpret_u32_u16(uv16), 0));
+        tail = vset_lane_u32(vget_lane_u32(vreinterpret_u32_u8(c8), 0),
+                             tail, 1);
+        vst1q_u32((uint32_t *)&dst[i],
+                  vcombine_u32(vreinterpret_u32_f32(vget_low_f32(pos_uv)),
+                               tail));
+    }
+#endif
+    for (; i < count; i++) {
+        forge_ui__pack_vertex(&src[i], &dst[i]);
+    }
+}
+
+static void forge_ui_unpack_vertices(const ForgeUiPackedVertex *src,
+                                     ForgeUiVertex *dst, int count)
+{
+    if (!src || !dst) return;
+    for (int i = 0; i < count; i++) {
+        const ForgeUiPackedVertex *s = &src[i];
+        ForgeUiVertex *d = &dst[i];
+        d->pos_x = s->pos_x;
+        d->pos_y = s->pos_y;
+        d->uv_u  = (float)s->uv_u * (1.0f / 65535.0f);
+        d->uv_v  = (float)s->uv_v * (1.0f / 65535.0f);
+        d->r     = (float)s->r * (1.0f / 255.0f);
+        d->g     = (float)s->g * (1.0f / 255.0f);
+        d->b     = (float)s->b * (1.0f / 255.0f);
+        d->a     = (float)s->a * (1.0f / 255.0f);
+    }
+}
+
 /* ── forge_ui_text_measure ───────────────────────────────────────────────── */
 
 static ForgeUiTextMetrics forge_ui_text_measure(const ForgeUiFontAtlas *atlas,
@@ -2964,17 +5916,26 @@ static ForgeUiTextMetrics forge_ui_text_measure(const ForgeUiFontAtlas *atlas,
     float max_line_width = 0.0f;
     int line_count = 1;
 
-    for (int i = 0; i < text_len; i++) {
-        unsigned char ch = (unsigned char)text[i];
+    /* Same kerning rule as forge_ui_text_layout_into */
+    const ForgeUiKernTable *kern = atlas->kern.count > 0 ? &atlas->kern : NULL;
+    Uint16 prev_glyph = 0;
+
+    for (int i = 0; i < text_len; ) {
+        /* ASCII bytes are codepoints as-is; only a byte >= 0x80 starts a
+         * multi-byte sequence, so plain ASCII text never decodes */
+        Uint32 ch = (Uint8)text[i++];
+        if (ch >= 0x80) ch = forge_ui__utf8_decode(text, text_len, ch, &i);
 
         if (ch == '\n') {
             if (pen_x > max_line_width) max_line_width = pen_x;
             pen_x = 0.0f;
             line_count++;
+            prev_glyph = 0;
             continue;
         }
 
         if (ch == '\t') {
+            prev_glyph = 0;
             float tab_width = space_advance * FORGE_UI__TAB_STOP_WIDTH;
             if (tab_width > 0.0f) {
                 float next_stop = tab_width *
@@ -2985,17 +5946,29 @@ static ForgeUiTextMetrics forge_ui_text_measure(const ForgeUiFontAtlas *atlas,
         }
 
         const ForgeUiPackedGlyph *glyph = forge_ui_atlas_lookup(atlas, ch);
-        if (!glyph) continue;
+        if (!glyph) {
+            prev_glyph = 0;
+            continue;
+        }
 
         float advance = (float)glyph->advance_width * scale;
 
-        if (o->max_width > 0.0f && pen_x + advance > o->max_width &&
+        float kern_px = 0.0f;
+        if (kern && prev_glyph != 0) {
+            kern_px = (float)forge_ui__kern_lookup(kern, prev_glyph,
+                                                   glyph->glyph_index) * scale;
+        }
+        prev_glyph = glyph->glyph_index;
+
+        if (o->max_width > 0.0f && pen_x + kern_px + advance > o->max_width &&
             pen_x > 0.0f) {
             if (pen_x > max_line_width) max_line_width = pen_x;
             pen_x = 0.0f;
             line_count++;
+            kern_px = 0.0f;
         }
 
+        pen_x += kern_px;
         pen_x += advance;
     }
 
@@ -3007,4 +5980,447 @@ static ForgeUiTextMetrics forge_ui_text_measure(const ForgeUiFontAtlas *atlas,
     return result;
 }
 
+/* ── Paragraphs ──────────────────────────────────────────────────────────── */
+
+#define FORGE_UI__PARA_TAB       (-1)  /* item is a tab */
+#define FORGE_UI__PARA_NEWLINE   (-2)  /* item is a newline */
+#define FORGE_UI__PARA_MIN_LINES 16    /* initial line array capacity */
+
+static void forge_ui_paragraph_free(ForgeUiParagraph *para)
+{
+    if (!para) return;
+    SDL_free(para->items);
+    SDL_free(para->sums);
+    SDL_free(para->runs);
+    SDL_free(para->lines);
+    SDL_memset(para, 0, sizeof(*para));
+}
+
+static bool forge_ui_paragraph_init(const ForgeUiFontAtlas *atlas,
+                                     const char *text,
+                                     ForgeUiParagraph *out_para)
+{
+    if (!out_para) {
+        SDL_Log("forge_ui_paragraph_init: NULL parameter");
+        return false;
+    }
+    SDL_memset(out_para, 0, sizeof(*out_para));
+    out_para->wrap_width = -1.0f;
+    if (!atlas || !text) {
+        SDL_Log("forge_ui_paragraph_init: NULL parameter");
+        return false;
+    }
+    if (atlas->units_per_em == 0) {
+        SDL_Log("forge_ui_paragraph_init: atlas has units_per_em == 0 "
+                "(invalid)");
+        return false;
+    }
+    if (atlas->lookup_fn) {
+        /* Items index glyphs[]; a glyph cache has no stable array */
+        SDL_Log("forge_ui_paragraph_init: atlas has a lookup_fn; "
+                "paragraphs need a built atlas");
+        return false;
+    }
+
+    /* Same metrics as forge_ui_text_layout_into */
+    float scale = atlas->pixel_height / (float)atlas->units_per_em;
+    float quad_scale = forge_ui__atlas_quad_scale(atlas);
+    float line_height = ((float)atlas->ascender - (float)atlas->descender +
+                          (float)atlas->line_gap) * scale;
+    if (line_height <= 0.0f) line_height = 1.0f;
+    const ForgeUiPackedGlyph *space_glyph = forge_ui_atlas_lookup(atlas, ' ');
+    float space_advance = space_glyph
+        ? (float)space_glyph->advance_width * scale
+        : atlas->pixel_height * 0.5f;
+
+    out_para->atlas        = atlas;
+    out_para->pixel_height = atlas->pixel_height;
+    out_para->line_height  = line_height;
+    out_para->tab_width    = space_advance * FORGE_UI__TAB_STOP_WIDTH;
+
+    size_t raw_len = SDL_strlen(text);
+    if (raw_len > (size_t)(INT_MAX / FORGE_UI__INDICES_PER_QUAD)) {
+        SDL_Log("forge_ui_paragraph_init: text too long (%zu bytes)", raw_len);
+        return false;
+    }
+    int text_len = (int)raw_len;
+    if (text_len == 0) return true;  /* no runs: measures as empty text */
+
+    /* At most one item per byte and one run per tab or newline, plus one;
+     * both arrays are trimmed once the real counts are known */
+    out_para->items = (ForgeUi__ParagraphItem *)SDL_malloc(
+        raw_len * sizeof(ForgeUi__ParagraphItem));
+    out_para->runs = (ForgeUi__ParagraphRun *)SDL_malloc(
+        (raw_len + 1) * sizeof(ForgeUi__ParagraphRun));
+    if (!out_para->items || !out_para->runs) {
+        SDL_Log("forge_ui_paragraph_init: allocation failed");
+        forge_ui_paragraph_free(out_para);
+        return false;
+    }
+
+    /* ── Decode and resolve glyphs with forge_ui_text_layout_into's rules ── */
+    const ForgeUiKernTable *kern = atlas->kern.count > 0 ? &atlas->kern : NULL;
+    Uint16 prev_glyph = 0;
+    ForgeUi__ParagraphItem *items = out_para->items;
+    int n = 0;
+    int run_first = 0;
+    bool monotone = true;
+    for (int i = 0; i < text_len; ) {
+        Uint32 ch = (Uint8)text[i++];
+        if (ch >= 0x80) ch = forge_ui__utf8_decode(text, text_len, ch, &i);
+
+        if (ch == '\n' || ch == '\t') {
+            ForgeUi__ParagraphRun *run = &out_para->runs[out_para->run_count++];
+            run->first = run_first;
+            run->end = n;
+            run->monotone = monotone;
+            items[n].glyph = ch == '\n' ? FORGE_UI__PARA_NEWLINE
+                                        : FORGE_UI__PARA_TAB;
+            items[n].kern = 0.0f;
+            items[n].advance = 0.0f;
+            n++;
+            run_first = n;
+            monotone = true;
+            prev_glyph = 0;
+            continue;
+        }
+
+        const ForgeUiPackedGlyph *glyph = forge_ui_atlas_lookup(atlas, ch);
+        if (!glyph) {
+            prev_glyph = 0;
+            continue;
+        }
+        float kern_px = 0.0f;
+        if (kern && prev_glyph != 0) {
+            kern_px = (float)forge_ui__kern_lookup(kern, prev_glyph,
+                                                   glyph->glyph_index) * scale;
+        }
+        prev_glyph = glyph->glyph_index;
+
+        items[n].glyph = (Sint32)(glyph - atlas->glyphs);
+        items[n].kern = kern_px;
+        items[n].advance = (float)glyph->advance_width * scale;
+        if (kern_px + items[n].advance < 0.0f) monotone = false;
+        n++;
+
+        if (ch != ' ' && glyph->bitmap_w > 0 && glyph->bitmap_h > 0) {
+            float top = (float)glyph->bearing_y * quad_scale;
+            float bottom = (float)(glyph->bitmap_h - glyph->bearing_y) *
+                           quad_scale;
+            if (top > out_para->ink_top) out_para->ink_top = top;
+            if (bottom > out_para->ink_bottom) out_para->ink_bottom = bottom;
+            out_para->quad_count++;
+        }
+    }
+    ForgeUi__ParagraphRun *last = &out_para->runs[out_para->run_count++];
+    last->first = run_first;
+    last->end = n;
+    last->monotone = monotone;
+    out_para->item_count = n;
+
+    /* Trim; a failed shrink just keeps the larger block */
+    if (n > 0) {
+        void *shrunk = SDL_realloc(items, (size_t)n * sizeof(*items));
+        if (shrunk) out_para->items = (ForgeUi__ParagraphItem *)shrunk;
+    }
+    void *shrunk_runs = SDL_realloc(out_para->runs, (size_t)out_para->run_count
+                                    * sizeof(ForgeUi__ParagraphRun));
+    if (shrunk_runs) out_para->runs = (ForgeUi__ParagraphRun *)shrunk_runs;
+
+    /* ── Running sums of kern + advance, in double so a difference of two
+     *    sums far into a long paragraph is still exact to the pixel ── */
+    out_para->sums = (double *)SDL_malloc(((size_t)n + 1) * sizeof(double));
+    if (!out_para->sums) {
+        SDL_Log("forge_ui_paragraph_init: allocation failed");
+        forge_ui_paragraph_free(out_para);
+        return false;
+    }
+    out_para->sums[0] = 0.0;
+    for (int i = 0; i < n; i++) {
+        const ForgeUi__ParagraphItem *it = &out_para->items[i];
+        double w = it->glyph >= 0 ? (double)it->kern + (double)it->advance
+                                  : 0.0;
+        out_para->sums[i + 1] = out_para->sums[i] + w;
+    }
+    return true;
+}
+
+/* Append a line to the wrap cache */
+static bool forge_ui__paragraph_push_line(ForgeUiParagraph *para, int first,
+                                          int end, bool wrapped, double width)
+{
+    if (para->line_count == para->line_capacity) {
+        int cap = para->line_capacity > 0 ? para->line_capacity * 2
+                                          : FORGE_UI__PARA_MIN_LINES;
+        ForgeUi__ParagraphLine *lines = (ForgeUi__ParagraphLine *)SDL_realloc(
+            para->lines, (size_t)cap * sizeof(ForgeUi__ParagraphLine));
+        if (!lines) {
+            SDL_Log("forge_ui__paragraph_push_line: allocation failed");
+            return false;
+        }
+        para->lines = lines;
+        para->line_capacity = cap;
+    }
+    ForgeUi__ParagraphLine *line = &para->lines[para->line_count++];
+    line->first = first;
+    line->end = end;
+    line->wrapped = wrapped;
+    line->width = (float)width;
+    if (line->width > para->max_line_width) para->max_line_width = line->width;
+    return true;
+}
+
+/* First item j in [from, end) with sums[j + 1] > limit, or end.  The sums
+ * must be nondecreasing over the range (a monotone run). */
+static int forge_ui__paragraph_search(const double *sums, int from, int end,
+                                      double limit)
+{
+    int lo = from, hi = end;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (sums[mid + 1] > limit) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo;
+}
+
+/* Compute line breaks for max_width unless they are already cached.
+ *
+ * forge_ui_text_layout_into wraps glyph j when the line is not empty and
+ * its width plus kern_j + advance_j exceeds max_width; the wrapped glyph
+ * starts the next line unkerned.  A line that starts at item s with width
+ * c has width c + sums[k] - sums[s] after item k - 1, so the next wrap is
+ * the first sums[j + 1] above max_width - c + sums[s]: one binary search
+ * per line.  Runs with negative kern + advance are not sorted and are
+ * scanned glyph by glyph instead. */
+static bool forge_ui__paragraph_wrap(ForgeUiParagraph *para, float max_width)
+{
+    if (!(max_width > 0.0f)) max_width = 0.0f;  /* no wrap, as in layout */
+    if (para->wrap_width == max_width) return true;
+
+    para->wrap_width = -1.0f;
+    para->line_count = 0;
+    para->max_line_width = 0.0f;
+
+    const double *sums = para->sums;
+    double limit_w = (double)max_width;
+    int line_first = 0;
+    bool wrapped = false;
+    double width = 0.0;
+    for (int r = 0; r < para->run_count; r++) {
+        const ForgeUi__ParagraphRun *run = &para->runs[r];
+        int s = run->first;  /* line width is c + sums[k] - sums[s] */
+        double c = width;
+        if (max_width > 0.0f) {
+            int j = run->first;
+            while (j < run->end) {
+                double limit = limit_w - c + sums[s];
+                if (run->monotone) {
+                    j = forge_ui__paragraph_search(sums, j, run->end, limit);
+                } else {
+                    while (j < run->end && !(sums[j + 1] > limit)) j++;
+                }
+                if (j >= run->end) break;
+
+                /* Overflowing an empty line is allowed: no wrap */
+                double before = c + (sums[j] - sums[s]);
+                if (before > 0.0) {
+                    if (!forge_ui__paragraph_push_line(para, line_first, j,
+                                                       wrapped, before)) {
+                        return false;
+                    }
+                    line_first = j;
+                    wrapped = true;
+                    s = j;
+                    c = -(double)para->items[j].kern;
+                }
+                j++;
+            }
+        }
+        width = c + (sums[run->end] - sums[s]);
+        if (run->end == para->item_count) break;
+
+        /* The run ends at a tab or newline */
+        if (para->items[run->end].glyph == FORGE_UI__PARA_NEWLINE) {
+            if (!forge_ui__paragraph_push_line(para, line_first, run->end,
+                                               wrapped, width)) {
+                return false;
+            }
+            line_first = run->end + 1;
+            wrapped = false;
+            width = 0.0;
+        } else if (para->tab_width > 0.0f) {
+            float tab = para->tab_width;
+            width = (double)(tab * (SDL_floorf((float)width / tab) + 1.0f));
+        }
+    }
+    if (!forge_ui__paragraph_push_line(para, line_first, para->item_count,
+                                       wrapped, width)) {
+        return false;
+    }
+    para->wrap_width = max_width;
+    return true;
+}
+
+static ForgeUiTextMetrics forge_ui_paragraph_measure(ForgeUiParagraph *para,
+                                                     const ForgeUiTextOpts *opts)
+{
+    ForgeUiTextMetrics result = { 0.0f, 0.0f, 0 };
+    if (!para || !para->atlas) return result;
+    if (para->run_count == 0) {
+        result.line_count = 1;
+        return result;
+    }
+
+    const ForgeUiTextOpts *o = opts ? opts : &FORGE_UI__DEFAULT_TEXT_OPTS;
+    if (!forge_ui__paragraph_wrap(para, o->max_width)) return result;
+
+    result.width      = para->max_line_width;
+    result.height     = (float)para->line_count * para->line_height;
+    result.line_count = para->line_count;
+    return result;
+}
+
+static bool forge_ui_paragraph_layout_into(ForgeUiParagraph *para,
+                                            float x, float y,
+                                            const ForgeUiTextOpts *opts,
+                                            const ForgeUiTextSink *sink,
+                                            ForgeUiTextMetrics *out_metrics)
+{
+    if (out_metrics) SDL_memset(out_metrics, 0, sizeof(*out_metrics));
+
+    if (!para || !para->atlas || !sink || !sink->vertices
+        || !sink->vertex_count || !sink->vertex_capacity
+        || (sink->indices && (!sink->index_count || !sink->index_capacity))) {
+        SDL_Log("forge_ui_paragraph_layout_into: NULL parameter");
+        return false;
+    }
+    const ForgeUiFontAtlas *atlas = para->atlas;
+    if (atlas->pixel_height != para->pixel_height) {
+        SDL_Log("forge_ui_paragraph_layout_into: atlas pixel height changed "
+                "since forge_ui_paragraph_init");
+        return false;
+    }
+
+    const ForgeUiTextOpts *o = opts ? opts : &FORGE_UI__DEFAULT_TEXT_OPTS;
+    if (para->run_count == 0) {
+        if (out_metrics) out_metrics->line_count = 1;
+        return true;
+    }
+    if (!forge_ui__paragraph_wrap(para, o->max_width)) return false;
+
+    int max_quads = para->quad_count;
+    if (!forge_ui__sink_reserve((void **)sink->vertices, sink->vertex_capacity,
+                                *sink->vertex_count,
+                                max_quads * FORGE_UI__VERTS_PER_QUAD,
+                                sizeof(ForgeUiVertex),
+                                FORGE_UI__INITIAL_CHAR_CAPACITY *
+                                FORGE_UI__VERTS_PER_QUAD)) {
+        return false;
+    }
+    if (sink->indices &&
+        !forge_ui__sink_reserve((void **)sink->indices, sink->index_capacity,
+                                *sink->index_count,
+                                max_quads * FORGE_UI__INDICES_PER_QUAD,
+                                sizeof(Uint32),
+                                FORGE_UI__INITIAL_CHAR_CAPACITY *
+                                FORGE_UI__INDICES_PER_QUAD)) {
+        return false;
+    }
+    if (*sink->vertex_count > INT_MAX - max_quads * FORGE_UI__VERTS_PER_QUAD) {
+        SDL_Log("forge_ui_paragraph_layout_into: vertex count overflow");
+        return false;
+    }
+
+    ForgeUiVertex *verts = *sink->vertices + *sink->vertex_count;
+    float quad_scale = forge_ui__atlas_quad_scale(atlas);
+    int quad_count = 0;
+    float pen_y = y;
+
+    for (int l = 0; l < para->line_count; l++, pen_y += para->line_height) {
+        const ForgeUi__ParagraphLine *line = &para->lines[l];
+
+        /* Every quad on a line lies within its ink band (a pixel of slack
+         * covers rounding); bands outside the clip would be clipped away */
+        if (sink->has_clip &&
+            (pen_y - para->ink_top - 1.0f >= sink->clip_y1 ||
+             pen_y + para->ink_bottom + 1.0f <= sink->clip_y0)) {
+            continue;
+        }
+
+        /* Same pen arithmetic as forge_ui_text_layout_into, so the quads
+         * match it bit for bit */
+        int line_start = quad_count;
+        float pen_x = x;
+        float line_width = 0.0f;
+        for (int i = line->first; i < line->end; i++) {
+            const ForgeUi__ParagraphItem *it = &para->items[i];
+            if (it->glyph < 0) {
+                /* Tab (newlines only end lines) */
+                float tab_width = para->tab_width;
+                if (tab_width > 0.0f) {
+                    float rel_x = pen_x - x;
+                    float next_stop = tab_width *
+                        (SDL_floorf(rel_x / tab_width) + 1.0f);
+                    pen_x = x + next_stop;
+                    line_width = pen_x - x;
+                }
+                continue;
+            }
+
+            float kern_px = (i == line->first && line->wrapped) ? 0.0f
+                                                                : it->kern;
+            pen_x += kern_px;
+            line_width += kern_px;
+
+            const ForgeUiPackedGlyph *glyph = &atlas->glyphs[it->glyph];
+            if (glyph->codepoint == ' ' ||
+                glyph->bitmap_w == 0 || glyph->bitmap_h == 0) {
+                pen_x += it->advance;
+                line_width += it->advance;
+                continue;
+            }
+
+            float qx0 = pen_x + (float)glyph->bearing_x * quad_scale;
+            float qy0 = pen_y - (float)glyph->bearing_y * quad_scale;
+            float qx1 = qx0 + (float)glyph->bitmap_w * quad_scale;
+            float qy1 = qy0 + (float)glyph->bitmap_h * quad_scale;
+            ForgeUiVertex *v = &verts[quad_count * FORGE_UI__VERTS_PER_QUAD];
+            v[0] = (ForgeUiVertex){ qx0, qy0, glyph->uv.u0, glyph->uv.v0,
+                                    o->r, o->g, o->b, o->a };
+            v[1] = (ForgeUiVertex){ qx1, qy0, glyph->uv.u1, glyph->uv.v0,
+                                    o->r, o->g, o->b, o->a };
+            v[2] = (ForgeUiVertex){ qx1, qy1, glyph->uv.u1, glyph->uv.v1,
+                                    o->r, o->g, o->b, o->a };
+            v[3] = (ForgeUiVertex){ qx0, qy1, glyph->uv.u0, glyph->uv.v1,
+                                    o->r, o->g, o->b, o->a };
+            quad_count++;
+            pen_x += it->advance;
+            line_width += it->advance;
+        }
+        forge_ui__finish_line(verts, line_start, &quad_count, line_width,
+                              o, sink);
+    }
+
+    if (sink->indices) {
+        Uint32 *idx = *sink->indices + *sink->index_count;
+        Uint32 base = (Uint32)*sink->vertex_count;
+        for (int q = 0; q < quad_count; q++) {
+            Uint32 vb = base + (Uint32)(q * FORGE_UI__VERTS_PER_QUAD);
+            idx[0] = vb + 0;  idx[1] = vb + 1;  idx[2] = vb + 2;
+            idx[3] = vb + 2;  idx[4] = vb + 3;  idx[5] = vb + 0;
+            idx += FORGE_UI__INDICES_PER_QUAD;
+        }
+        *sink->index_count += quad_count * FORGE_UI__INDICES_PER_QUAD;
+    }
+    *sink->vertex_count += quad_count * FORGE_UI__VERTS_PER_QUAD;
+
+    if (out_metrics) {
+        out_metrics->width      = para->max_line_width;
+        out_metrics->height     = (float)para->line_count * para->line_height;
+        out_metrics->line_count = para->line_count;
+    }
+    return true;
+}
+
 #endif /* FORGE_UI_H */
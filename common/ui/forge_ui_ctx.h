@@ -13,7 +13,9 @@
  *   - Widget IDs are FNV-1a hashes of string labels combined with a
  *     hierarchical scope seed.  The "##" separator lets callers
  *     distinguish widgets with identical display text.
- *   - Labels emit textured quads for each character using forge_ui_text_layout.
+ *   - Labels emit textured quads for each character, laid out once per
+ *     string (see ForgeUiTextCache) and written straight into the draw
+ *     buffers with forge_ui_text_layout_into.
  *   - Buttons emit a solid-colored background rectangle (using the atlas
  *     white_uv region) plus centered text, and return true on click.
  *   - Hit testing checks the mouse position against widget bounding rects.
@@ -41,6 +43,7 @@
 #define FORGE_UI_CTX_H
 
 #include <math.h>
+#include <stdarg.h>  /* va_list for forge_ui_ctx_frame_printf */
 #include <string.h>
 #include <SDL3/SDL.h>
 #include "forge_ui_theme.h"
@@ -54,6 +57,19 @@
 #define FORGE_UI_CTX_INITIAL_VERTEX_CAPACITY  256
 #define FORGE_UI_CTX_INITIAL_INDEX_CAPACITY   384
 
+/* Initial capacity for the draw command list.  A command is opened per
+ * clip/texture change, so a frame with a handful of panels needs few. */
+#define FORGE_UI_CTX_INITIAL_DRAW_CMD_CAPACITY  16
+
+/* Damage tracking granularity: the screen is diffed in square tiles of
+ * this many pixels.  Smaller tiles give tighter damage rects for more
+ * hashing work per triangle. */
+#define FORGE_UI_DAMAGE_TILE_SIZE  32
+
+/* Most damage rects reported per frame.  A frame whose damage would need
+ * more is reported as the single rect bounding all of it. */
+#define FORGE_UI_DAMAGE_MAX_RECTS  64
+
 /* No widget is hot or active.  Zero is reserved as the null ID -- callers
  * must use non-zero IDs for their widgets. */
 #define FORGE_UI_ID_NONE  0
@@ -156,6 +172,39 @@ typedef struct ForgeUiRect {
     float h;  /* height */
 } ForgeUiRect;
 
+/* One draw call's worth of the frame's index buffer.  With draw commands
+ * enabled (forge_ui_ctx_set_draw_commands), clipped widgets emit their
+ * full geometry and the renderer applies clip_rect as a scissor instead
+ * of the CPU trimming every quad.  Commands are in draw order and their
+ * index ranges are contiguous and non-overlapping.
+ *
+ * Rendering: for each command, set the scissor to clip_rect (or the full
+ * viewport when has_clip is false), bind texture_id, and draw
+ * index_count indices starting at index_offset. */
+typedef struct ForgeUiDrawCmd {
+    int         index_offset; /* first index in ctx->indices */
+    int         index_count;  /* number of indices (multiple of 3) */
+    ForgeUiRect clip_rect;    /* scissor in screen pixels (if has_clip) */
+    bool        has_clip;     /* false = no scissor */
+    Uint32      texture_id;   /* caller's texture handle (see set_texture) */
+} ForgeUiDrawCmd;
+
+/* One piece of the frame's draw data, in draw order.  forge_ui_wctx_end
+ * fills these (see ForgeUiWindowComposeMode in forge_ui_window.h).
+ * Pointers are valid until the next forge_ui_ctx_begin /
+ * forge_ui_wctx_begin; do not emit widgets between forge_ui_wctx_end and
+ * forge_ui_ctx_end. */
+typedef struct ForgeUiDrawSegment {
+    const ForgeUiVertex  *vertices;
+    int                   vertex_count;
+    const Uint32         *indices;        /* zero-based into vertices */
+    int                   index_count;
+    int                   base_vertex;    /* vertices in earlier segments */
+    int                   first_index;    /* indices in earlier segments */
+    const ForgeUiDrawCmd *draw_cmds;      /* offsets relative to indices; */
+    int                   draw_cmd_count; /* 0 unless draw commands are on */
+} ForgeUiDrawSegment;
+
 /* Layout direction — determines which axis the cursor advances along
  * and which axis fills the available space. */
 typedef enum ForgeUiLayoutDirection {
@@ -226,6 +275,33 @@ typedef struct ForgeUiPanel {
     Uint32       id;             /* widget ID hash (for pre-clamp matching across frames) */
 } ForgeUiPanel;
 
+/* List clipper for long, vertically laid out lists.
+ *
+ * Instead of declaring every row and letting the clip rect discard the
+ * hidden ones, the caller asks the clipper which rows intersect the
+ * current clip rect (after the panel's scroll offset) and declares only
+ * those.  The clipper advances the layout cursor over the rows it skips,
+ * so the panel's content_height -- and therefore the scrollbar -- is the
+ * same as if every row had been declared.
+ *
+ *   ForgeUiListClipper clip;
+ *   if (forge_ui_ctx_list_clipper_begin(ctx, &clip, count, row_h)) {
+ *       for (int i = clip.display_start; i < clip.display_end; i++)
+ *           forge_ui_ctx_label_layout(ctx, rows[i], row_h);
+ *       forge_ui_ctx_list_clipper_end(ctx, &clip);
+ *   }
+ *
+ * Rows keep the layout's spacing between them, exactly as consecutive
+ * layout_next calls would place them. */
+typedef struct ForgeUiListClipper {
+    int          item_count;     /* total rows in the list */
+    float        item_height;    /* uniform row height (0 when offsets is set) */
+    const float *offsets;        /* variable heights: item_count + 1 prefix sums, or NULL */
+    int          display_start;  /* first row to declare (inclusive) */
+    int          display_end;    /* last row to declare (exclusive) */
+    int          _layout_depth;  /* layout the list lives in (checked by end) */
+} ForgeUiListClipper;
+
 /* Application-owned text input state.
  *
  * Each text input field needs its own ForgeUiTextInputState that persists
@@ -245,6 +321,225 @@ typedef struct ForgeUiTextInputState {
     int   cursor;    /* byte index for insertion point; 0 <= cursor <= length */
 } ForgeUiTextInputState;
 
+/* ── Frame arena ────────────────────────────────────────────────────────── */
+
+/* Smallest block the frame arena takes from SDL_malloc. */
+#define FORGE_UI_ARENA_BLOCK_SIZE  (64 * 1024)
+
+/* Arena allocations are aligned to this many bytes. */
+#define FORGE_UI_ARENA_ALIGN       16
+
+/* One chunk of arena memory; the bytes follow the header. */
+typedef struct ForgeUiArenaBlock {
+    struct ForgeUiArenaBlock *next;  /* older block of the same half */
+    size_t                    size;  /* usable bytes */
+    size_t                    used;  /* bytes handed out */
+} ForgeUiArenaBlock;
+
+/* Bump allocator for memory that only lives for a frame or two (see
+ * forge_ui_ctx_frame_alloc).  It has two halves: forge_ui_ctx_begin
+ * switches to the half the frame before last used and rewinds it, so an
+ * allocation stays valid through the frame after the one that made it.
+ * A half that needed several blocks is merged into one block when it is
+ * rewound, so a steady workload stops calling SDL_malloc after a few
+ * frames.
+ *
+ * The counters cover the current frame and are reset by
+ * forge_ui_ctx_begin; read them after forge_ui_ctx_end. */
+typedef struct ForgeUiArena {
+    ForgeUiArenaBlock *blocks[2];   /* per half, newest first */
+    int                current;     /* half this frame allocates from */
+    size_t             capacity;    /* bytes held by both halves */
+    size_t             bytes;       /* bytes handed out this frame */
+    int                allocs;      /* allocations this frame */
+    int                heap_allocs; /* blocks taken from SDL_malloc this frame */
+    size_t             peak_bytes;  /* most bytes handed out in one frame */
+} ForgeUiArena;
+
+/* ── Text layout cache ──────────────────────────────────────────────────── */
+
+/* Slots allocated the first time a label is drawn (power of two). */
+#define FORGE_UI_TEXT_CACHE_INITIAL_SLOTS  64
+
+/* Slot cap.  The table is kept at most half full; once it reaches half of
+ * this, further new strings are laid out without caching. */
+#define FORGE_UI_TEXT_CACHE_MAX_SLOTS      4096
+
+/* A run not drawn for this many frames is evicted by forge_ui_ctx_begin.
+ * Runs drawn in only one frame are evicted two frames later (see
+ * ForgeUiTextRun.transient). */
+#define FORGE_UI_TEXT_CACHE_MAX_AGE        60
+
+/* One laid-out string kept across frames.
+ *
+ * Quads are stored as laid out with the pen at the origin, so the run is
+ * position-independent: drawing it at (x, y) adds (x, y) to every vertex.
+ * Vertex colors are written when the run is drawn, so one run serves any
+ * color.  The atlas size is part of the key so an atlas rebuilt at the
+ * same address (e.g. after a scale change) does not reuse stale UVs.
+ *
+ * A new run lives in the frame arena.  It moves to the heap when it is
+ * drawn again on a later frame; if it is not, it is dropped before its
+ * arena half is rewound.  Strings that change every frame (counters,
+ * timers) therefore never reach SDL_malloc. */
+typedef struct ForgeUiTextRun {
+    Uint32                  hash;         /* key hash (0 = empty slot) */
+    const ForgeUiFontAtlas *atlas;        /* key: atlas laid out against */
+    float                   pixel_height; /* key: atlas->pixel_height */
+    int                     atlas_w;      /* key: atlas->width */
+    int                     atlas_h;      /* key: atlas->height */
+    Uint64                  glyph_generation; /* key: forge_ui__atlas_generation */
+    float                   max_width;    /* key: ForgeUiTextOpts.max_width */
+    ForgeUiTextAlign        alignment;    /* key: ForgeUiTextOpts.alignment */
+    const char             *text;         /* key: copy of the string */
+    ForgeUiVertex          *vertices;     /* 4 per glyph, origin-relative;
+                                           * one block with text */
+    int                     vertex_count; /* multiple of 4 */
+    ForgeUiTextMetrics      metrics;      /* layout width, height, lines */
+    ForgeUiRect             bounds;       /* box around all quads, origin-relative */
+    Uint32                  last_used;    /* ForgeUiTextCache.frame of last use */
+    bool                    transient;    /* vertices/text are in the arena */
+} ForgeUiTextRun;
+
+/* Per-context cache of ForgeUiTextRun, an open-addressed hash table with
+ * linear probing.  Owned by the context; freed by forge_ui_ctx_free. */
+typedef struct ForgeUiTextCache {
+    ForgeUiTextRun *runs;      /* capacity slots (NULL until first use) */
+    int             capacity;  /* slot count (power of two) */
+    int             count;     /* occupied slots */
+    Uint32          frame;     /* advanced by each forge_ui_ctx_begin */
+    Uint32          hits;      /* lookups served from the cache */
+    Uint32          misses;    /* lookups that had to lay the text out */
+    ForgeUiVertex  *scratch;   /* layout target on a miss (reused) */
+    int             scratch_count;
+    int             scratch_capacity;
+} ForgeUiTextCache;
+
+/* ── Cached regions ─────────────────────────────────────────────────────── */
+
+/* Most regions recorded at once.  A cached panel or window declared while
+ * the cache is full is drawn normally but not recorded. */
+#define FORGE_UI_REGION_CACHE_MAX      64
+
+/* A region not declared for this many frames is evicted by
+ * forge_ui_ctx_begin. */
+#define FORGE_UI_REGION_CACHE_MAX_AGE  60
+
+/* The draw data one cached panel or window emitted when it was last
+ * declared (see forge_ui_ctx_panel_begin_cached).
+ *
+ * The key is the region's widget ID, the caller's content version, its
+ * size and scroll offset, and a hash of everything else that shapes the
+ * output (atlas, scale, spacing, theme, draw command state).  Position is
+ * not part of the key: a region that moved is replayed with every vertex
+ * (and draw command clip rect) translated by the difference.
+ *
+ * A replay runs none of the region's widgets, so it also refreshes the
+ * widget state (forge_ui_ctx_state) they requested while recording;
+ * otherwise a scroll offset or cursor inside a long-replayed region would
+ * expire after FORGE_UI_STATE_MAX_AGE frames. */
+typedef struct ForgeUiRegion {
+    Uint32          id;             /* panel / window widget ID */
+    Uint32          version;        /* key: caller's content version */
+    Uint32          style;          /* key: see forge_ui__region_style */
+    float           w, h;           /* key: rect size */
+    float           scroll_y;       /* key: scroll offset */
+    ForgeUiRect     rect;           /* rect when recorded */
+    ForgeUiRect     content_rect;   /* panel content rect when recorded */
+    float           content_height; /* panel_end's measurement */
+    ForgeUiVertex  *vertices;       /* as emitted at rect */
+    int             vertex_count;
+    int             vertex_capacity;
+    Uint32         *indices;        /* zero-based into vertices */
+    int             index_count;
+    int             index_capacity;
+    ForgeUiDrawCmd *draw_cmds;      /* offsets relative to indices */
+    int             draw_cmd_count;
+    int             draw_cmd_capacity;
+    Uint32         *state_ids;      /* forge_ui_ctx_state IDs requested */
+    int             state_id_count;
+    int             state_id_capacity;
+    Uint32          last_used;      /* ForgeUiRegionCache.frame */
+} ForgeUiRegion;
+
+/* Per-context list of ForgeUiRegion.  Owned by the context; freed by
+ * forge_ui_ctx_free.  A region is recorded between its cached begin call
+ * and the matching end; the _rec_* fields track that recording. */
+typedef struct ForgeUiRegionCache {
+    ForgeUiRegion *regions;     /* count used of capacity */
+    int            count;
+    int            capacity;
+    Uint32         frame;       /* advanced by each forge_ui_ctx_begin */
+    Uint32         hits;        /* regions replayed */
+    Uint32         misses;      /* cached regions declared in full */
+
+    bool           _recording;
+    ForgeUiRegion  _rec_key;    /* id, version, style, w, h, scroll_y */
+    int            _rec_vertex_start;
+    int            _rec_index_start;
+    int            _rec_draw_cmd_start;
+    Uint32        *_rec_state_ids;  /* state IDs requested while recording */
+    int            _rec_state_count;
+    int            _rec_state_capacity;
+} ForgeUiRegionCache;
+
+/* ── Widget state table ─────────────────────────────────────────────────── */
+
+/* Table slots allocated by the first forge_ui_ctx_state call (power of
+ * two).  The table is kept at most half full. */
+#define FORGE_UI_STATE_INITIAL_SLOTS  64
+
+/* Table slot cap: 2^20 slots hold up to 512k widgets' state. */
+#define FORGE_UI_STATE_MAX_SLOTS      (1 << 20)
+
+/* State storage is allocated in pages of this many entries, so a widget's
+ * state never moves while the table grows. */
+#define FORGE_UI_STATE_PAGE_SIZE      256
+
+/* State not requested for this many frames is released by
+ * forge_ui_ctx_begin (see FORGE_UI_STATE_SWEEP_DIVISOR). */
+#define FORGE_UI_STATE_MAX_AGE        60
+
+/* forge_ui_ctx_begin checks 1/this of the table (at least 64 slots) for
+ * expired state per frame, so a large table costs a fixed slice of work
+ * per frame and expired state is released within this many frames of
+ * expiring. */
+#define FORGE_UI_STATE_SWEEP_DIVISOR  8
+
+/* Per-widget storage kept by the context across frames (see
+ * forge_ui_ctx_state): 32 bytes, zeroed when created, viewed as floats,
+ * integers, or raw bytes -- enough for a scroll offset and velocity, an
+ * animation clock, or a text cursor and selection. */
+typedef union ForgeUiWidgetState {
+    float  f[8];
+    Sint32 i[8];
+    Uint32 u[8];
+    Uint8  bytes[32];
+} ForgeUiWidgetState;
+
+/* One table slot: a widget ID and where its state lives. */
+typedef struct ForgeUiStateEntry {
+    Uint32 id;         /* widget ID (FORGE_UI_ID_NONE = empty slot) */
+    Uint32 last_used;  /* ForgeUiStateTable.frame of the last request */
+    Uint32 index;      /* state index: page index / PAGE_SIZE */
+} ForgeUiStateEntry;
+
+/* Per-context map from widget ID to ForgeUiWidgetState, an open-addressed
+ * hash table with linear probing and backward-shift deletion.  Owned by
+ * the context; freed by forge_ui_ctx_free. */
+typedef struct ForgeUiStateTable {
+    ForgeUiStateEntry   *entries;     /* capacity slots (NULL until first use) */
+    int                  capacity;    /* slot count (power of two) */
+    int                  count;       /* occupied slots */
+    ForgeUiWidgetState **pages;       /* page_count pages of PAGE_SIZE states */
+    int                  page_count;
+    Uint32               used;        /* state indices handed out so far */
+    Uint32               free_head;   /* released index + 1 (0 = none); the
+                                       * next link is kept in u[0] */
+    Uint32               frame;       /* advanced by each forge_ui_ctx_begin */
+    int                  sweep;       /* next slot the eviction sweep checks */
+} ForgeUiStateTable;
+
 /* Immediate-mode UI context.
  *
  * Holds per-frame mouse input, the hot/active widget IDs, a pointer to
@@ -327,7 +622,9 @@ typedef struct ForgeUiContext {
     /* Clip rect for panel content area.  When has_clip is true, all
      * vertex-emitting functions clip quads against this rect: fully
      * outside quads are discarded, partially outside quads are trimmed
-     * with UV remapping, and hit tests also respect the clip rect. */
+     * with UV remapping, and hit tests also respect the clip rect.
+     * With draw commands enabled the trimming is left to the renderer's
+     * scissor; only whole rects outside the clip are still dropped. */
     ForgeUiRect clip_rect;
     bool        has_clip;
 
@@ -380,6 +677,8 @@ typedef struct ForgeUiContext {
      * spacing.  Set once before building the atlas; the atlas pixel_height
      * should be base_pixel_height * scale.  The atlas must be rebuilt when
      * scale changes — this is an explicit application responsibility.
+     * SDF atlases (FORGE_UI_ATLAS_SDF) skip the rebuild: call
+     * forge_ui_atlas_set_pixel_height(atlas, base_pixel_height * scale).
      * forge_ui_ctx_begin resets invalid values (<=0, NaN, Inf) to 1.0. */
     float scale;
 
@@ -404,6 +703,88 @@ typedef struct ForgeUiContext {
      * can be overridden with forge_ui_ctx_set_theme(), which returns false
      * if the context is NULL or any color component is outside [0, 1]. */
     ForgeUiTheme theme;
+
+    /* Laid-out label text reused across frames (see ForgeUiTextCache).
+     * Labels, button captions, and panel/window titles go through it;
+     * call forge_ui_ctx_text_cache_clear after changing an atlas in
+     * place without changing its address, size, or pixel height. */
+    ForgeUiTextCache text_cache;
+
+    /* Per-frame bump allocator (see ForgeUiArena).  New text cache runs
+     * and damage tracking scratch come from it, as does
+     * forge_ui_ctx_frame_alloc / forge_ui_ctx_frame_printf. */
+    ForgeUiArena arena;
+
+    /* Vertex layout handed to the renderer.  Widgets always emit
+     * ForgeUiVertex; with FORGE_UI_VERTEX_FORMAT_PACKED, forge_ui_ctx_end
+     * also converts the frame's vertices into packed_vertices (same order
+     * and count, so indices apply unchanged; with window segments, the
+     * segments back to back at their base_vertex).  Upload
+     * packed_vertices instead of vertices to move 16 bytes per vertex
+     * instead of 32.
+     * Set with forge_ui_ctx_set_vertex_format. */
+    ForgeUiVertexFormat  vertex_format;
+    ForgeUiPackedVertex *packed_vertices;        /* valid after ctx_end */
+    int                  packed_vertex_count;    /* 0 until ctx_end */
+    int                  packed_vertex_capacity; /* allocated packed vertices */
+
+    /* Draw command list (see ForgeUiDrawCmd).  Off by default: the frame
+     * is one draw call and clipping happens on the CPU.  When enabled with
+     * forge_ui_ctx_set_draw_commands, each change of clip rect or
+     * texture_id starts a new command.  The list is final after ctx_end. */
+    bool            draw_cmds_enabled;
+    ForgeUiDrawCmd *draw_cmds;          /* commands in draw order */
+    int             draw_cmd_count;     /* number of commands this frame */
+    int             draw_cmd_capacity;  /* allocated commands */
+    Uint32          texture_id;         /* recorded into new commands */
+
+    /* The frame as a list of segments when windows are composed in
+     * FORGE_UI_WINDOW_COMPOSE_SEGMENTS mode (set by forge_ui_wctx_end,
+     * cleared by forge_ui_ctx_begin).  NULL means ctx's own buffers hold
+     * the whole frame.  forge_ui_ctx_end reads the frame through these
+     * for packing and damage tracking. */
+    const ForgeUiDrawSegment *_segments;
+    int                       _segment_count;
+
+    /* Panels and windows replayed from an earlier frame (see
+     * forge_ui_ctx_panel_begin_cached).  A region is only recorded or
+     * replayed while no input can reach it: the cursor, the point where
+     * hot was last claimed, and (while a widget is active or focused) the
+     * last press all lie outside its rect.  Those points are tracked
+     * below, set by forge_ui_ctx_begin / forge_ui_ctx_end. */
+    ForgeUiRegionCache region_cache;
+    float              _hot_mouse_x;    /* cursor when hot was adopted */
+    float              _hot_mouse_y;
+    float              _press_mouse_x;  /* cursor at the last press edge */
+    float              _press_mouse_y;
+
+    /* Widget state kept across frames, keyed by widget ID (see
+     * forge_ui_ctx_state).  Entries a widget stops requesting are
+     * released after FORGE_UI_STATE_MAX_AGE frames. */
+    ForgeUiStateTable state;
+
+    /* Damage tracking for partial redraws (off by default; enable with
+     * forge_ui_ctx_set_damage_tracking).  forge_ui_ctx_end hashes the
+     * frame's triangles, in draw order, into the screen tiles their
+     * bounds touch and compares each tile with the previous frame.
+     * damage_rects then lists disjoint, tile-aligned screen rects that
+     * cover every changed tile; pixels outside them are unchanged from
+     * the previous frame.  The whole screen is damaged on the first
+     * frame and after forge_ui_ctx_damage_reset.  Windows composed in
+     * FORGE_UI_WINDOW_COMPOSE_SEGMENTS mode are hashed from their own
+     * draw lists, in segment order. */
+    bool         damage_enabled;
+    int          damage_width;          /* screen size in pixels */
+    int          damage_height;
+    ForgeUiRect *damage_rects;          /* valid after ctx_end */
+    int          damage_rect_count;
+    int          damage_rect_capacity;
+    Uint32      *_damage_tiles;         /* this frame's tile hashes */
+    Uint32      *_damage_prev_tiles;    /* last frame's tile hashes */
+    int          _damage_cols;
+    int          _damage_rows;
+    bool         _damage_prev_valid;    /* _damage_prev_tiles is usable */
+    Uint32      *_damage_vertex_hash;   /* per-vertex scratch (arena) */
 } ForgeUiContext;
 
 /* ── Public API ─────────────────────────────────────────────────────────── */
@@ -426,6 +807,72 @@ static inline void forge_ui_ctx_begin(ForgeUiContext *ctx,
  * Call this once after all widget calls. */
 static inline void forge_ui_ctx_end(ForgeUiContext *ctx);
 
+/* Drop every cached text run (see ForgeUiContext.text_cache). */
+static inline void forge_ui_ctx_text_cache_clear(ForgeUiContext *ctx);
+
+/* Allocate size bytes (aligned to FORGE_UI_ARENA_ALIGN, not zeroed) from
+ * the frame arena.  The memory stays valid until the next
+ * forge_ui_ctx_begin and must not be freed.  Returns NULL if ctx is NULL,
+ * size is 0, or a new arena block cannot be allocated. */
+static inline void *forge_ui_ctx_frame_alloc(ForgeUiContext *ctx, size_t size);
+
+/* Format a string into the frame arena, e.g. a label whose value changes
+ * every frame.  Same lifetime as forge_ui_ctx_frame_alloc.  Returns NULL
+ * if ctx or fmt is NULL or the arena is out of memory. */
+static inline const char *forge_ui_ctx_frame_printf(ForgeUiContext *ctx,
+                                                    const char *fmt, ...);
+
+/* Choose the vertex layout forge_ui_ctx_end produces (see
+ * ForgeUiContext.vertex_format).  Returns false if ctx is NULL or the
+ * format is unknown. */
+static inline bool forge_ui_ctx_set_vertex_format(ForgeUiContext *ctx,
+                                                  ForgeUiVertexFormat format);
+
+/* Turn draw command output on or off (see ForgeUiContext.draw_cmds).
+ * Call between frames, not between ctx_begin and ctx_end.  Returns false
+ * if ctx is NULL. */
+static inline bool forge_ui_ctx_set_draw_commands(ForgeUiContext *ctx,
+                                                  bool enabled);
+
+/* Set the texture handle recorded into draw commands for geometry emitted
+ * from here on.  The value is opaque to forge_ui (e.g. an index into the
+ * renderer's texture table); 0 is the font atlas by convention.  Has no
+ * effect on the output when draw commands are disabled. */
+static inline void forge_ui_ctx_set_texture(ForgeUiContext *ctx,
+                                            Uint32 texture_id);
+
+/* Turn damage tracking on for a width x height pixel screen, or off with
+ * a zero size (see ForgeUiContext.damage_rects).  Changing the size
+ * damages the whole next frame.  Returns false if ctx is NULL, the size
+ * is negative or above 16384, or the tile arrays cannot be allocated
+ * (tracking is then off). */
+static inline bool forge_ui_ctx_set_damage_tracking(ForgeUiContext *ctx,
+                                                    int width, int height);
+
+/* Damage the whole screen on the next frame, e.g. after the framebuffer
+ * was cleared or a texture the UI samples changed. */
+static inline void forge_ui_ctx_damage_reset(ForgeUiContext *ctx);
+
+/* Return the state kept for widget id (e.g. from forge_ui_hash_id),
+ * creating it zero-filled on first request; *created (if non-NULL) tells
+ * which.  The pointer stays valid until the state expires (it was not
+ * requested for FORGE_UI_STATE_MAX_AGE frames, counting frames in which a
+ * cached panel or window that requested it was replayed as requests) or
+ * the table is cleared.
+ * Lookups are O(1).  Returns NULL if ctx is NULL, id is FORGE_UI_ID_NONE,
+ * or the state cannot be allocated. */
+static inline ForgeUiWidgetState *forge_ui_ctx_state(ForgeUiContext *ctx,
+                                                     Uint32 id,
+                                                     bool *created);
+
+/* Return the state kept for id without creating it or keeping it alive,
+ * or NULL if there is none. */
+static inline ForgeUiWidgetState *forge_ui_ctx_state_find(const ForgeUiContext *ctx,
+                                                          Uint32 id);
+
+/* Release every widget's state (see ForgeUiContext.state). */
+static inline void forge_ui_ctx_state_clear(ForgeUiContext *ctx);
+
 /* Draw a text label at (x, y) with an explicit color.
  * The y coordinate is the baseline.  Does not participate in hit testing. */
 static inline void forge_ui_ctx_label_colored(ForgeUiContext *ctx,
@@ -618,6 +1065,18 @@ static inline void forge_ui_ctx_label_layout(ForgeUiContext *ctx,
                                               const char *text,
                                               float size);
 
+/* Wrapped block of text placed by the current layout, in the theme's
+ * text color.  In a vertical layout the paragraph wraps to the available
+ * width and takes the wrapped height, so help text re-flows as a window is
+ * resized; in a horizontal layout (or with no width left) it is unwrapped
+ * and takes its natural width.  The paragraph must be built on ctx->atlas.
+ * Re-wrapping happens only when the width changes, and lines outside the
+ * clip rect are not visited.  Line breaks follow forge_ui_text_layout()
+ * except where a glyph ends within float rounding of the width (see
+ * ForgeUiParagraph). */
+static inline void forge_ui_ctx_paragraph_layout(ForgeUiContext *ctx,
+                                                  ForgeUiParagraph *para);
+
 /* Button placed by the current layout.  Returns true on click. */
 static inline bool forge_ui_ctx_button_layout(ForgeUiContext *ctx,
                                                const char *text,
@@ -666,6 +1125,67 @@ static inline bool forge_ui_ctx_panel_begin(ForgeUiContext *ctx,
  * if content overflows the visible area. */
 static inline void forge_ui_ctx_panel_end(ForgeUiContext *ctx);
 
+/* Cached panel: same contract as forge_ui_ctx_panel_begin, plus a
+ * caller-maintained `version` that must change whenever anything the
+ * panel's widgets draw changes (values, labels, which widgets exist).
+ *
+ * If the panel was recorded on an earlier frame with the same version,
+ * size, scroll offset, and style, and no input can reach it this frame,
+ * the recorded draw data is appended (translated if rect moved) and the
+ * function returns false: the caller skips its widgets and must NOT call
+ * panel_end, exactly as for a rejected panel.  Otherwise the panel begins
+ * normally and returns true; the matching panel_end records it.
+ *
+ * A replayed panel runs no widget code, so widgets inside it cannot
+ * report clicks or changes that frame -- which is why a region that the
+ * cursor, the hot widget, or an active/focused widget may touch is never
+ * replayed.  Nor is any region while the atlas is a glyph cache view
+ * (ForgeUiFontAtlas.lookup_fn): a recording cannot keep its glyphs from
+ * being evicted. */
+static inline bool forge_ui_ctx_panel_begin_cached(ForgeUiContext *ctx,
+                                                    const char *title,
+                                                    ForgeUiRect rect,
+                                                    float *scroll_y,
+                                                    Uint32 version);
+
+/* Drop every recorded region (see ForgeUiContext.region_cache). */
+static inline void forge_ui_ctx_region_cache_clear(ForgeUiContext *ctx);
+
+/* ── List clipper API ──────────────────────────────────────────────────── */
+
+/* Begin a list of item_count rows that are all item_height tall, placed
+ * by the current (vertical) layout.  Fills clipper->display_start and
+ * display_end with the rows that intersect the clip rect and moves the
+ * layout cursor to the top of display_start.  Without a clip rect every
+ * row is visible.
+ *
+ * Cost is O(1) regardless of item_count.  Returns false (and declares
+ * nothing) on NULL ctx/clipper, negative count, non-finite or negative
+ * height, or when there is no vertical layout active; on false the
+ * caller must not call list_clipper_end. */
+static inline bool forge_ui_ctx_list_clipper_begin(ForgeUiContext *ctx,
+                                                   ForgeUiListClipper *clipper,
+                                                   int item_count,
+                                                   float item_height);
+
+/* Variable-height variant.  offsets holds item_count + 1 ascending
+ * prefix sums of the row heights: offsets[0] = 0 and offsets[i + 1] =
+ * offsets[i] + height of row i (the size the caller passes to the
+ * layout for that row; layout spacing is added by the clipper).  The
+ * array must stay valid until list_clipper_end.  Cost is O(log n) in
+ * item_count. */
+static inline bool forge_ui_ctx_list_clipper_begin_variable(ForgeUiContext *ctx,
+                                                            ForgeUiListClipper *clipper,
+                                                            int item_count,
+                                                            const float *offsets);
+
+/* End the list: advance the layout cursor over the rows after
+ * display_end so later widgets and the panel's content_height land
+ * where they would had every row been declared.  The caller must have
+ * declared exactly rows [display_start, display_end) in between. */
+static inline void forge_ui_ctx_list_clipper_end(ForgeUiContext *ctx,
+                                                 ForgeUiListClipper *clipper);
+
 /* ── Internal Helpers ───────────────────────────────────────────────────── */
 
 /* Test whether a point is inside a rectangle. */
@@ -883,6 +1403,145 @@ static inline bool forge_ui__grow_indices(ForgeUiContext *ctx, int count)
     return true;
 }
 
+/* Ensure the draw command list has room for `count` more commands. */
+static inline bool forge_ui__grow_draw_cmds(ForgeUiContext *ctx, int count)
+{
+    if (count <= 0) return count == 0;
+    if (ctx->draw_cmd_count > INT_MAX - count) {
+        SDL_Log("forge_ui__grow_draw_cmds: count overflow");
+        return false;
+    }
+    int needed = ctx->draw_cmd_count + count;
+    if (needed <= ctx->draw_cmd_capacity) return true;
+
+    int new_cap = ctx->draw_cmd_capacity;
+    if (new_cap == 0) new_cap = FORGE_UI_CTX_INITIAL_DRAW_CMD_CAPACITY;
+    while (new_cap < needed) {
+        if (new_cap > INT_MAX / 2) {
+            SDL_Log("forge_ui__grow_draw_cmds: capacity overflow");
+            return false;
+        }
+        new_cap *= 2;
+    }
+
+    ForgeUiDrawCmd *new_buf = (ForgeUiDrawCmd *)SDL_realloc(
+        ctx->draw_cmds, (size_t)new_cap * sizeof(ForgeUiDrawCmd));
+    if (!new_buf) {
+        SDL_Log("forge_ui__grow_draw_cmds: realloc failed (%d commands)",
+                new_cap);
+        return false;
+    }
+    ctx->draw_cmds = new_buf;
+    ctx->draw_cmd_capacity = new_cap;
+    return true;
+}
+
+/* True when emitters must trim geometry to clip_rect themselves.  With
+ * draw commands on, the clip travels with the command as a scissor. */
+static inline bool forge_ui__cpu_clip(const ForgeUiContext *ctx)
+{
+    return ctx->has_clip && !ctx->draw_cmds_enabled;
+}
+
+/* Set the last command's index_count from the current index_count.  The
+ * last command stays open while geometry is appended, so its count is
+ * only written when another command follows or the frame ends. */
+static inline void forge_ui__draw_cmd_close(ForgeUiContext *ctx)
+{
+    if (ctx->draw_cmd_count == 0) return;
+    ForgeUiDrawCmd *cmd = &ctx->draw_cmds[ctx->draw_cmd_count - 1];
+    cmd->index_count = ctx->index_count - cmd->index_offset;
+}
+
+/* True if geometry emitted under the current clip/texture state can be
+ * appended to cmd. */
+static inline bool forge_ui__draw_cmd_matches(const ForgeUiContext *ctx,
+                                              const ForgeUiDrawCmd *cmd)
+{
+    if (cmd->has_clip != ctx->has_clip) return false;
+    if (cmd->texture_id != ctx->texture_id) return false;
+    if (!ctx->has_clip) return true;
+    return cmd->clip_rect.x == ctx->clip_rect.x &&
+           cmd->clip_rect.y == ctx->clip_rect.y &&
+           cmd->clip_rect.w == ctx->clip_rect.w &&
+           cmd->clip_rect.h == ctx->clip_rect.h;
+}
+
+/* Called by every emitter before it appends indices: make sure the open
+ * command matches the current clip rect and texture, starting a new one
+ * if not.  An open command that received no indices is retargeted (or
+ * dropped in favor of a matching predecessor) instead of being left
+ * behind empty. */
+static inline void forge_ui__draw_cmd_sync(ForgeUiContext *ctx)
+{
+    if (!ctx->draw_cmds_enabled) return;
+
+    if (ctx->draw_cmd_count > 0) {
+        ForgeUiDrawCmd *last = &ctx->draw_cmds[ctx->draw_cmd_count - 1];
+        if (forge_ui__draw_cmd_matches(ctx, last)) return;
+        if (last->index_offset == ctx->index_count) {
+            ctx->draw_cmd_count--;
+            if (ctx->draw_cmd_count > 0 &&
+                forge_ui__draw_cmd_matches(
+                    ctx, &ctx->draw_cmds[ctx->draw_cmd_count - 1])) {
+                return;
+            }
+        }
+        forge_ui__draw_cmd_close(ctx);
+    }
+
+    if (!forge_ui__grow_draw_cmds(ctx, 1)) return;
+    ForgeUiDrawCmd *cmd = &ctx->draw_cmds[ctx->draw_cmd_count++];
+    cmd->index_offset = ctx->index_count;
+    cmd->index_count  = 0;
+    cmd->has_clip     = ctx->has_clip;
+    cmd->texture_id   = ctx->texture_id;
+    if (ctx->has_clip) {
+        cmd->clip_rect = ctx->clip_rect;
+    } else {
+        SDL_memset(&cmd->clip_rect, 0, sizeof(cmd->clip_rect));
+    }
+}
+
+/* Close the last draw command and drop it if it received no indices.
+ * Called when a command list is handed over: at ctx_end, and when a
+ * window's list is swapped out. */
+static inline void forge_ui__draw_cmd_finish(ForgeUiContext *ctx)
+{
+    if (ctx->draw_cmd_count == 0) return;
+    forge_ui__draw_cmd_close(ctx);
+    if (ctx->draw_cmds[ctx->draw_cmd_count - 1].index_count == 0) {
+        ctx->draw_cmd_count--;
+    }
+}
+
+/* dst[i] = src[i] + base for count indices, eight at a time with SSE2 or
+ * NEON where available.  Used wherever zero-based indices are appended to
+ * a shared buffer: text layouts and window draw lists. */
+static inline void forge_ui__rebase_indices(Uint32 *dst, const Uint32 *src,
+                                            int count, Uint32 base)
+{
+    int i = 0;
+#if defined(FORGE_UI__SIMD_SSE2)
+    __m128i vbase = _mm_set1_epi32((int)base);
+    for (; i + 8 <= count; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(src + i + 4));
+        _mm_storeu_si128((__m128i *)(dst + i),     _mm_add_epi32(a, vbase));
+        _mm_storeu_si128((__m128i *)(dst + i + 4), _mm_add_epi32(b, vbase));
+    }
+#elif defined(FORGE_UI__SIMD_NEON)
+    uint32x4_t vbase = vdupq_n_u32(base);
+    for (; i + 8 <= count; i += 8) {
+        vst1q_u32(dst + i,     vaddq_u32(vld1q_u32(src + i),     vbase));
+        vst1q_u32(dst + i + 4, vaddq_u32(vld1q_u32(src + i + 4), vbase));
+    }
+#endif
+    for (; i < count; i++) {
+        dst[i] = src[i] + base;
+    }
+}
+
 /* Emit a solid-colored rectangle using 4 vertices and 6 indices.
  * Samples the atlas white_uv region so the texture multiplier is 1.0,
  * giving a flat color determined entirely by the vertex color. */
@@ -904,27 +1563,31 @@ static inline void forge_ui__emit_rect(ForgeUiContext *ctx,
         float rx1 = rect.x + rect.w;
         float ry1 = rect.y + rect.h;
 
-        /* Fully outside -- discard */
+        /* Fully outside -- discard (also worth doing under a scissor) */
         if (rx1 <= cx0 || rx0 >= cx1 || ry1 <= cy0 || ry0 >= cy1) return;
 
-        /* Trim to intersection (solid rects use a single UV point so
-         * only positions change -- no UV remapping needed) */
-        if (rx0 < cx0) rx0 = cx0;
-        if (ry0 < cy0) ry0 = cy0;
-        if (rx1 > cx1) rx1 = cx1;
-        if (ry1 > cy1) ry1 = cy1;
-        rect.x = rx0;
-        rect.y = ry0;
-        rect.w = rx1 - rx0;
-        rect.h = ry1 - ry0;
-
-        /* Discard degenerate (zero-area) intersections that can arise
-         * from edge-touching rects or zero-size clip rects. */
-        if (rect.w <= 0.0f || rect.h <= 0.0f) return;
+        /* Under a draw command scissor the rect is emitted whole */
+        if (!ctx->draw_cmds_enabled) {
+            /* Trim to intersection (solid rects use a single UV point so
+             * only positions change -- no UV remapping needed) */
+            if (rx0 < cx0) rx0 = cx0;
+            if (ry0 < cy0) ry0 = cy0;
+            if (rx1 > cx1) rx1 = cx1;
+            if (ry1 > cy1) ry1 = cy1;
+            rect.x = rx0;
+            rect.y = ry0;
+            rect.w = rx1 - rx0;
+            rect.h = ry1 - ry0;
+
+            /* Discard degenerate (zero-area) intersections that can arise
+             * from edge-touching rects or zero-size clip rects. */
+            if (rect.w <= 0.0f || rect.h <= 0.0f) return;
+        }
     }
 
     if (!forge_ui__grow_vertices(ctx, 4)) return;
     if (!forge_ui__grow_indices(ctx, 6)) return;
+    forge_ui__draw_cmd_sync(ctx);
 
     /* UV coordinates: center of the white pixel region to ensure we sample
      * pure white (coverage = 255).  Using the midpoint avoids edge texels. */
@@ -958,134 +1621,1312 @@ static inline void forge_ui__emit_quad_clipped(ForgeUiContext *ctx,
                                                 const ForgeUiVertex *src,
                                                 const ForgeUiRect *clip)
 {
-    /* Original quad bounds */
-    float x0 = src[0].pos_x, x1 = src[1].pos_x;
-    float y0 = src[0].pos_y, y1 = src[2].pos_y;
+    ForgeUiVertex quad[4];
+    SDL_memcpy(quad, src, sizeof(quad));
+    if (!forge_ui__clip_glyph_quad(quad, clip->x, clip->y,
+                                   clip->x + clip->w, clip->y + clip->h)) {
+        return;
+    }
+
+    if (!forge_ui__grow_vertices(ctx, 4)) return;
+    if (!forge_ui__grow_indices(ctx, 6)) return;
+    forge_ui__draw_cmd_sync(ctx);
+
+    Uint32 base = (Uint32)ctx->vertex_count;
+    SDL_memcpy(&ctx->vertices[ctx->vertex_count], quad, sizeof(quad));
+    ctx->vertex_count += 4;
+
+    Uint32 *idx = &ctx->indices[ctx->index_count];
+    idx[0] = base + 0;  idx[1] = base + 1;  idx[2] = base + 2;
+    idx[3] = base + 0;  idx[4] = base + 2;  idx[5] = base + 3;
+    ctx->index_count += 6;
+}
+
+/* Append vertices and indices from a finished text layout into the
+ * context's draw buffers.  When clipping is active, processes each glyph
+ * quad individually with UV remapping; otherwise bulk-copies all data.
+ * Widgets skip the intermediate layout and write through
+ * forge_ui__ctx_text_sink instead; this is for callers that already
+ * hold a ForgeUiTextLayout. */
+static inline void forge_ui__emit_text_layout(ForgeUiContext *ctx,
+                                              const ForgeUiTextLayout *layout)
+{
+    if (!layout || layout->vertex_count == 0 || !layout->vertices || !layout->indices) return;
+
+    /* ── Per-quad clipping path (CPU clipping only) ──────────────────── */
+    if (forge_ui__cpu_clip(ctx)) {
+        /* Each glyph is a quad: 4 vertices, 6 indices.  Iterate per-quad
+         * and clip individually with UV remapping. */
+        int quad_count = layout->vertex_count / 4;
+        for (int q = 0; q < quad_count; q++) {
+            forge_ui__emit_quad_clipped(ctx,
+                                         &layout->vertices[q * 4],
+                                         &ctx->clip_rect);
+        }
+        return;
+    }
+
+    /* ── Bulk copy path (unclipped, or scissored by a draw command) ─── */
+    if (!forge_ui__grow_vertices(ctx, layout->vertex_count)) return;
+    if (!forge_ui__grow_indices(ctx, layout->index_count)) return;
+    forge_ui__draw_cmd_sync(ctx);
+
+    Uint32 base = (Uint32)ctx->vertex_count;
+
+    /* Copy vertices into the shared buffer without modification --
+     * vertex positions are absolute screen coordinates. */
+    SDL_memcpy(&ctx->vertices[ctx->vertex_count],
+               layout->vertices,
+               (size_t)layout->vertex_count * sizeof(ForgeUiVertex));
+    ctx->vertex_count += layout->vertex_count;
+
+    /* Rebase indices by the current vertex count so they reference the
+     * correct positions in the shared vertex buffer (text layouts produce
+     * indices starting from zero). */
+    forge_ui__rebase_indices(&ctx->indices[ctx->index_count],
+                             layout->indices, layout->index_count, base);
+    ctx->index_count += layout->index_count;
+}
+
+/* A text sink over the context's draw buffers and clip rect.  Inside a
+ * window these are the window's own draw list (forge_ui_wctx_window_begin
+ * swaps them in), so text lands directly in the list it is drawn from. */
+static inline ForgeUiTextSink forge_ui__ctx_text_sink(ForgeUiContext *ctx)
+{
+    ForgeUiTextSink sink;
+    sink.vertices        = &ctx->vertices;
+    sink.vertex_count    = &ctx->vertex_count;
+    sink.vertex_capacity = &ctx->vertex_capacity;
+    sink.indices         = &ctx->indices;
+    sink.index_count     = &ctx->index_count;
+    sink.index_capacity  = &ctx->index_capacity;
+    sink.has_clip        = forge_ui__cpu_clip(ctx);
+    sink.clip_x0         = ctx->clip_rect.x;
+    sink.clip_y0         = ctx->clip_rect.y;
+    sink.clip_x1         = ctx->clip_rect.x + ctx->clip_rect.w;
+    sink.clip_y1         = ctx->clip_rect.y + ctx->clip_rect.h;
+    return sink;
+}
+
+/* ── Frame arena ────────────────────────────────────────────────────────── */
+
+/* Block header size rounded up so the first allocation is aligned */
+#define FORGE_UI__ARENA_HEADER \
+    ((sizeof(ForgeUiArenaBlock) + FORGE_UI_ARENA_ALIGN - 1) \
+     & ~(size_t)(FORGE_UI_ARENA_ALIGN - 1))
+
+static inline Uint8 *forge_ui__arena_data(ForgeUiArenaBlock *block)
+{
+    return (Uint8 *)block + FORGE_UI__ARENA_HEADER;
+}
 
-    float cx0 = clip->x, cy0 = clip->y;
-    float cx1 = cx0 + clip->w, cy1 = cy0 + clip->h;
+/* Take a block of at least size bytes from the heap and push it onto the
+ * current half. */
+static inline ForgeUiArenaBlock *forge_ui__arena_push_block(ForgeUiArena *arena,
+                                                            size_t size)
+{
+    if (size > SIZE_MAX - FORGE_UI__ARENA_HEADER) return NULL;
+    ForgeUiArenaBlock *block = (ForgeUiArenaBlock *)SDL_malloc(
+        FORGE_UI__ARENA_HEADER + size);
+    if (!block) {
+        SDL_Log("forge_ui__arena_push_block: allocation failed (%zu bytes)",
+                size);
+        return NULL;
+    }
+    block->next = arena->blocks[arena->current];
+    block->size = size;
+    block->used = 0;
+    arena->blocks[arena->current] = block;
+    arena->capacity += size;
+    arena->heap_allocs++;
+    return block;
+}
 
-    /* Fully outside or degenerate (zero area) -- discard */
-    if (x1 <= cx0 || x0 >= cx1 || y1 <= cy0 || y0 >= cy1) return;
-    if (x0 >= x1 || y0 >= y1) return;
+static inline void *forge_ui__arena_alloc(ForgeUiArena *arena, size_t size)
+{
+    if (size == 0) return NULL;
+    if (size > SIZE_MAX - FORGE_UI_ARENA_ALIGN) return NULL;
+    size = (size + FORGE_UI_ARENA_ALIGN - 1)
+           & ~(size_t)(FORGE_UI_ARENA_ALIGN - 1);
+
+    ForgeUiArenaBlock *block = arena->blocks[arena->current];
+    if (!block || block->size - block->used < size) {
+        /* Grow geometrically so a frame needs few blocks */
+        size_t want = FORGE_UI_ARENA_BLOCK_SIZE;
+        if (block && block->size <= SIZE_MAX / 2 && block->size * 2 > want) {
+            want = block->size * 2;
+        }
+        if (size > want) want = size;
+        block = forge_ui__arena_push_block(arena, want);
+        if (!block) return NULL;
+    }
+    void *ptr = forge_ui__arena_data(block) + block->used;
+    block->used += size;
+    arena->bytes += size;
+    arena->allocs++;
+    if (arena->bytes > arena->peak_bytes) arena->peak_bytes = arena->bytes;
+    return ptr;
+}
 
-    /* Compute clipped bounds */
-    float nx0 = (x0 < cx0) ? cx0 : x0;
-    float ny0 = (y0 < cy0) ? cy0 : y0;
-    float nx1 = (x1 > cx1) ? cx1 : x1;
-    float ny1 = (y1 > cy1) ? cy1 : y1;
+static inline void forge_ui__arena_free_half(ForgeUiArena *arena, int half)
+{
+    ForgeUiArenaBlock *block = arena->blocks[half];
+    while (block) {
+        ForgeUiArenaBlock *next = block->next;
+        arena->capacity -= block->size;
+        SDL_free(block);
+        block = next;
+    }
+    arena->blocks[half] = NULL;
+}
 
-    /* Discard degenerate (zero-area) intersections that can arise
-     * from edge-touching quads or zero-size clip rects. */
-    if (nx1 <= nx0 || ny1 <= ny0) return;
+/* Start a frame: switch halves, rewind the one the frame before last
+ * used (merging its blocks), and reset the counters.  Anything still
+ * pointing into that half must have been dropped first. */
+static inline void forge_ui__arena_begin_frame(ForgeUiArena *arena)
+{
+    arena->current ^= 1;
+    arena->bytes = 0;
+    arena->allocs = 0;
+    arena->heap_allocs = 0;
+
+    ForgeUiArenaBlock *block = arena->blocks[arena->current];
+    if (block && block->next) {
+        size_t total = 0;
+        for (ForgeUiArenaBlock *b = block; b; b = b->next) {
+            total += b->size;
+        }
+        forge_ui__arena_free_half(arena, arena->current);
+        /* On failure the half simply starts empty */
+        forge_ui__arena_push_block(arena, total);
+    } else if (block) {
+        block->used = 0;
+    }
+}
+
+static inline void forge_ui__arena_free(ForgeUiArena *arena)
+{
+    forge_ui__arena_free_half(arena, 0);
+    forge_ui__arena_free_half(arena, 1);
+    SDL_memset(arena, 0, sizeof(*arena));
+}
+
+/* ── Text layout cache ──────────────────────────────────────────────────── */
+
+/* Key hash: the string, then the atlas identity and layout options mixed
+ * in FNV-1a style.  Never returns 0 (the empty-slot marker). */
+static inline Uint32 forge_ui__text_run_hash(const ForgeUiFontAtlas *atlas,
+                                             const char *text,
+                                             const ForgeUiTextOpts *opts)
+{
+    Uint32 hash = forge_ui__fnv1a(text, FORGE_UI_FNV_OFFSET_BASIS);
+    Uint32 parts[4];
+    parts[0] = (Uint32)(uintptr_t)atlas;
+    SDL_memcpy(&parts[1], &atlas->pixel_height, sizeof(Uint32));
+    SDL_memcpy(&parts[2], &opts->max_width, sizeof(Uint32));
+    parts[3] = (Uint32)opts->alignment;
+    for (int i = 0; i < 4; i++) {
+        hash ^= parts[i];
+        hash *= FORGE_UI_FNV_PRIME;
+    }
+    return hash ? hash : 1;
+}
+
+/* *atlas->lookup_generation, or 0 for a built atlas (its glyphs never
+ * move).  A run laid out against a glyph cache view is stale once the
+ * cache evicts, since its UVs may name a reused cell. */
+static inline Uint64 forge_ui__atlas_generation(const ForgeUiFontAtlas *atlas)
+{
+    return atlas->lookup_generation ? *atlas->lookup_generation : 0;
+}
+
+/* Look up every codepoint of a run's text again, so a glyph cache behind
+ * the atlas counts its glyphs as used this frame and cannot evict them
+ * while the run's vertices are in the draw list. */
+static inline void forge_ui__text_run_touch(const ForgeUiFontAtlas *atlas,
+                                            const char *text)
+{
+    int len = (int)SDL_strlen(text);
+    for (int i = 0; i < len; ) {
+        Uint32 ch = (Uint8)text[i++];
+        if (ch >= 0x80) ch = forge_ui__utf8_decode(text, len, ch, &i);
+        if (ch == '\n' || ch == '\t') continue;  /* layout skips these */
+        (void)forge_ui_atlas_lookup(atlas, ch);
+    }
+}
+
+static inline bool forge_ui__text_run_matches(const ForgeUiTextRun *run,
+                                              Uint32 hash,
+                                              const ForgeUiFontAtlas *atlas,
+                                              const char *text,
+                                              const ForgeUiTextOpts *opts)
+{
+    return run->hash == hash
+        && run->atlas == atlas
+        && run->pixel_height == atlas->pixel_height
+        && run->atlas_w == atlas->width
+        && run->atlas_h == atlas->height
+        && run->glyph_generation == forge_ui__atlas_generation(atlas)
+        && run->max_width == opts->max_width
+        && run->alignment == opts->alignment
+        && SDL_strcmp(run->text, text) == 0;
+}
+
+/* Move every run into a table of new_capacity slots.  On allocation
+ * failure the old table is kept unchanged. */
+static inline bool forge_ui__text_cache_rehash(ForgeUiTextCache *cache,
+                                               int new_capacity)
+{
+    ForgeUiTextRun *runs = (ForgeUiTextRun *)SDL_calloc(
+        (size_t)new_capacity, sizeof(ForgeUiTextRun));
+    if (!runs) {
+        SDL_Log("forge_ui__text_cache_rehash: allocation failed "
+                "(%d slots)", new_capacity);
+        return false;
+    }
+
+    Uint32 mask = (Uint32)new_capacity - 1;
+    for (int i = 0; i < cache->capacity; i++) {
+        ForgeUiTextRun *run = &cache->runs[i];
+        if (run->hash == 0) continue;
+        Uint32 slot = run->hash & mask;
+        while (runs[slot].hash != 0) slot = (slot + 1) & mask;
+        runs[slot] = *run;
+    }
+
+    SDL_free(cache->runs);
+    cache->runs = runs;
+    cache->capacity = new_capacity;
+    return true;
+}
+
+/* Empty a slot and pull later runs of its probe chain back (backward-shift
+ * deletion), so no allocation or tombstone is needed. */
+static inline void forge_ui__text_cache_remove(ForgeUiTextCache *cache,
+                                               Uint32 slot)
+{
+    Uint32 mask = (Uint32)cache->capacity - 1;
+    if (!cache->runs[slot].transient) SDL_free(cache->runs[slot].vertices);
+
+    Uint32 hole = slot;
+    for (Uint32 j = (slot + 1) & mask; cache->runs[j].hash != 0;
+         j = (j + 1) & mask) {
+        Uint32 home = cache->runs[j].hash & mask;
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            cache->runs[hole] = cache->runs[j];
+            hole = j;
+        }
+    }
+    SDL_memset(&cache->runs[hole], 0, sizeof(ForgeUiTextRun));
+    cache->count--;
+}
+
+/* Evict runs that have not been drawn recently, and arena runs whose
+ * arena half is about to be rewound.  Called once per frame by
+ * forge_ui_ctx_begin, before the arena switches halves. */
+static inline void forge_ui__text_cache_evict(ForgeUiTextCache *cache)
+{
+    for (int i = 0; i < cache->capacity; ) {
+        const ForgeUiTextRun *run = &cache->runs[i];
+        Uint32 age = cache->frame - run->last_used;
+        if (run->hash != 0 &&
+            (age > FORGE_UI_TEXT_CACHE_MAX_AGE || (run->transient && age >= 2))) {
+            /* A later run may have moved into this slot; look again */
+            forge_ui__text_cache_remove(cache, (Uint32)i);
+            continue;
+        }
+        i++;
+    }
+}
+
+/* Copy an arena run's block to the heap: it was drawn on a second frame,
+ * so it is likely to stay.  On failure it stays in the arena and is
+ * evicted with it. */
+static inline void forge_ui__text_run_promote(ForgeUiTextRun *run)
+{
+    size_t vert_bytes = (size_t)run->vertex_count * sizeof(ForgeUiVertex);
+    size_t text_len = SDL_strlen(run->text);
+    ForgeUiVertex *block = (ForgeUiVertex *)SDL_malloc(vert_bytes + text_len + 1);
+    if (!block) {
+        SDL_Log("forge_ui__text_run_promote: allocation failed");
+        return;
+    }
+    if (vert_bytes > 0) SDL_memcpy(block, run->vertices, vert_bytes);
+    char *key_text = (char *)block + vert_bytes;
+    SDL_memcpy(key_text, run->text, text_len + 1);
+    run->vertices = block;
+    run->text = key_text;
+    run->transient = false;
+}
 
-    /* Proportional UV remapping */
-    float u0 = src[0].uv_u, u1 = src[1].uv_u;
-    float v0 = src[0].uv_v, v1 = src[2].uv_v;
+/* Look up the run for (text, opts) against ctx->atlas, laying it out and
+ * inserting it on a miss.  Colors in opts are ignored.  Returns NULL if
+ * the text cannot be cached (allocation failure or a full table); the
+ * caller then falls back to an uncached layout. */
+static inline const ForgeUiTextRun *forge_ui__ctx_text_run(
+    ForgeUiContext *ctx, const char *text, const ForgeUiTextOpts *opts)
+{
+    ForgeUiTextCache *cache = &ctx->text_cache;
+    const ForgeUiFontAtlas *atlas = ctx->atlas;
+    Uint32 hash = forge_ui__text_run_hash(atlas, text, opts);
+
+    if (cache->capacity > 0) {
+        Uint32 mask = (Uint32)cache->capacity - 1;
+        for (Uint32 slot = hash & mask; cache->runs[slot].hash != 0;
+             slot = (slot + 1) & mask) {
+            ForgeUiTextRun *run = &cache->runs[slot];
+            if (forge_ui__text_run_matches(run, hash, atlas, text, opts)) {
+                if (run->transient && run->last_used != cache->frame) {
+                    forge_ui__text_run_promote(run);
+                }
+                if (atlas->lookup_fn && run->last_used != cache->frame) {
+                    forge_ui__text_run_touch(atlas, run->text);
+                }
+                run->last_used = cache->frame;
+                cache->hits++;
+                return run;
+            }
+        }
+    }
+
+    /* Miss: keep the table at most half full */
+    cache->misses++;
+    if (cache->count + 1 > cache->capacity / 2) {
+        int grown = cache->capacity > 0 ? cache->capacity * 2
+                                        : FORGE_UI_TEXT_CACHE_INITIAL_SLOTS;
+        if (grown > FORGE_UI_TEXT_CACHE_MAX_SLOTS) return NULL;
+        if (!forge_ui__text_cache_rehash(cache, grown)) return NULL;
+    }
+
+    /* Lay out at the origin into the reusable scratch array; the run is
+     * translated when drawn */
+    cache->scratch_count = 0;
+    ForgeUiTextSink sink;
+    SDL_memset(&sink, 0, sizeof(sink));
+    sink.vertices        = &cache->scratch;
+    sink.vertex_count    = &cache->scratch_count;
+    sink.vertex_capacity = &cache->scratch_capacity;
+    ForgeUiTextMetrics metrics;
+    if (!forge_ui_text_layout_into(atlas, text, 0.0f, 0.0f, opts,
+                                   &sink, &metrics)) {
+        return NULL;
+    }
+
+    /* One block: vertices, then the key string */
+    size_t text_len = SDL_strlen(text);
+    size_t vert_bytes = (size_t)cache->scratch_count * sizeof(ForgeUiVertex);
+    ForgeUiVertex *block = (ForgeUiVertex *)forge_ui__arena_alloc(
+        &ctx->arena, vert_bytes + text_len + 1);
+    if (!block) return NULL;
+    if (vert_bytes > 0) SDL_memcpy(block, cache->scratch, vert_bytes);
+    char *key_text = (char *)block + vert_bytes;
+    SDL_memcpy(key_text, text, text_len + 1);
+
+    Uint32 mask = (Uint32)cache->capacity - 1;
+    Uint32 slot = hash & mask;
+    while (cache->runs[slot].hash != 0) slot = (slot + 1) & mask;
+
+    ForgeUiTextRun *run = &cache->runs[slot];
+    run->hash           = hash;
+    run->atlas          = atlas;
+    run->pixel_height   = atlas->pixel_height;
+    run->atlas_w        = atlas->width;
+    run->atlas_h        = atlas->height;
+    run->glyph_generation = forge_ui__atlas_generation(atlas);
+    run->max_width      = opts->max_width;
+    run->alignment      = opts->alignment;
+    run->text           = key_text;
+    run->vertices       = block;
+    run->vertex_count   = cache->scratch_count;
+    run->metrics        = metrics;
+    run->last_used      = cache->frame;
+    run->transient      = true;
+
+    /* Bounding box of the quads, so a clipped draw can reject the whole
+     * run with one test */
+    SDL_memset(&run->bounds, 0, sizeof(run->bounds));
+    if (run->vertex_count > 0) {
+        float x0 = block[0].pos_x, y0 = block[0].pos_y;
+        float x1 = x0, y1 = y0;
+        for (int i = 1; i < run->vertex_count; i++) {
+            if (block[i].pos_x < x0) x0 = block[i].pos_x;
+            if (block[i].pos_x > x1) x1 = block[i].pos_x;
+            if (block[i].pos_y < y0) y0 = block[i].pos_y;
+            if (block[i].pos_y > y1) y1 = block[i].pos_y;
+        }
+        run->bounds = (ForgeUiRect){ x0, y0, x1 - x0, y1 - y0 };
+    }
+    cache->count++;
+    return run;
+}
+
+/* Append a cached run at pen position (x, y) with the given color.
+ * A run wholly outside the clip rect is dropped.  Unclipped (or
+ * scissored) runs are written straight into the draw buffers;
+ * CPU-clipped runs go through the per-quad clipper. */
+static inline void forge_ui__emit_text_run(ForgeUiContext *ctx,
+                                           const ForgeUiTextRun *run,
+                                           float x, float y,
+                                           float r, float g, float b, float a)
+{
+    if (run->vertex_count == 0) return;
+
+    if (ctx->has_clip) {
+        float bx0 = run->bounds.x + x;
+        float by0 = run->bounds.y + y;
+        if (bx0 + run->bounds.w <= ctx->clip_rect.x ||
+            bx0 >= ctx->clip_rect.x + ctx->clip_rect.w ||
+            by0 + run->bounds.h <= ctx->clip_rect.y ||
+            by0 >= ctx->clip_rect.y + ctx->clip_rect.h) {
+            return;
+        }
+    }
+
+    if (forge_ui__cpu_clip(ctx)) {
+        for (int q = 0; q < run->vertex_count; q += 4) {
+            ForgeUiVertex quad[4];
+            for (int k = 0; k < 4; k++) {
+                quad[k] = run->vertices[q + k];
+                quad[k].pos_x += x;
+                quad[k].pos_y += y;
+                quad[k].r = r;  quad[k].g = g;
+                quad[k].b = b;  quad[k].a = a;
+            }
+            forge_ui__emit_quad_clipped(ctx, quad, &ctx->clip_rect);
+        }
+        return;
+    }
+
+    int index_count = run->vertex_count / 4 * 6;
+    if (!forge_ui__grow_vertices(ctx, run->vertex_count)) return;
+    if (!forge_ui__grow_indices(ctx, index_count)) return;
+    forge_ui__draw_cmd_sync(ctx);
+
+    ForgeUiVertex *dst = &ctx->vertices[ctx->vertex_count];
+    for (int i = 0; i < run->vertex_count; i++) {
+        dst[i] = run->vertices[i];
+        dst[i].pos_x += x;
+        dst[i].pos_y += y;
+        dst[i].r = r;  dst[i].g = g;  dst[i].b = b;  dst[i].a = a;
+    }
+
+    /* Same winding as forge_ui_text_layout: (0, 1, 2) and (2, 3, 0) */
+    Uint32 *idx = &ctx->indices[ctx->index_count];
+    Uint32 base = (Uint32)ctx->vertex_count;
+    for (int q = 0; q < run->vertex_count / 4; q++) {
+        Uint32 v = base + (Uint32)q * 4;
+        idx[0] = v;      idx[1] = v + 1;  idx[2] = v + 2;
+        idx[3] = v + 2;  idx[4] = v + 3;  idx[5] = v;
+        idx += 6;
+    }
+    ctx->vertex_count += run->vertex_count;
+    ctx->index_count += index_count;
+}
+
+/* Text metrics for a ctx-drawn string (no wrapping, left aligned).  Goes
+ * through the cache so the draw that follows is a hit. */
+static inline ForgeUiTextMetrics forge_ui__ctx_text_measure(ForgeUiContext *ctx,
+                                                            const char *text)
+{
+    ForgeUiTextOpts opts = { 0.0f, FORGE_UI_TEXT_ALIGN_LEFT,
+                             1.0f, 1.0f, 1.0f, 1.0f };
+    const ForgeUiTextRun *run = forge_ui__ctx_text_run(ctx, text, &opts);
+    if (run) return run->metrics;
+    return forge_ui_text_measure(ctx->atlas, text, NULL);
+}
+
+/* Emit a rectangular border as four thin edge rects drawn INSIDE the
+ * given rectangle.  Used for the focused text input outline. */
+static inline void forge_ui__emit_border(ForgeUiContext *ctx,
+                                          ForgeUiRect rect,
+                                          float border_w,
+                                          float r, float g, float b, float a)
+{
+    if (!ctx) return;
+    /* Reject degenerate borders: width must be positive, finite, and must
+     * fit within half the rect dimension to avoid inverted geometry.
+     * NaN fails the > 0 check (NaN > 0 is false). */
+    if (!(border_w > 0.0f)) return;
+    if (border_w > rect.w * 0.5f || border_w > rect.h * 0.5f) return;
+
+    /* Top edge — full width so corners are covered by the horizontal edges */
+    forge_ui__emit_rect(ctx,
+        (ForgeUiRect){ rect.x, rect.y, rect.w, border_w },
+        r, g, b, a);
+    /* Bottom edge — full width, same reason */
+    forge_ui__emit_rect(ctx,
+        (ForgeUiRect){ rect.x, rect.y + rect.h - border_w, rect.w, border_w },
+        r, g, b, a);
+    /* Left edge — shortened to avoid double-drawing corner pixels where
+     * it would overlap the top and bottom edges */
+    forge_ui__emit_rect(ctx,
+        (ForgeUiRect){ rect.x, rect.y + border_w,
+                       border_w, rect.h - 2.0f * border_w },
+        r, g, b, a);
+    /* Right edge — shortened for the same corner overlap reason */
+    forge_ui__emit_rect(ctx,
+        (ForgeUiRect){ rect.x + rect.w - border_w, rect.y + border_w,
+                       border_w, rect.h - 2.0f * border_w },
+        r, g, b, a);
+}
+
+/* ── Widget state table ─────────────────────────────────────────────────── */
+
+/* Home slot for id.  IDs are FNV-1a hashes, whose low bits are weak for
+ * labels that differ only in their last character; a multiply and fold
+ * spreads them before masking. */
+static inline Uint32 forge_ui__state_home(Uint32 id, Uint32 mask)
+{
+    Uint32 h = id * 0x9e3779b1u;
+    return (h ^ (h >> 16)) & mask;
+}
+
+static inline ForgeUiWidgetState *forge_ui__state_at(const ForgeUiStateTable *table,
+                                                     Uint32 index)
+{
+    return &table->pages[index / FORGE_UI_STATE_PAGE_SIZE]
+                        [index % FORGE_UI_STATE_PAGE_SIZE];
+}
+
+/* Slot holding id, or -1 */
+static inline int forge_ui__state_lookup(const ForgeUiStateTable *table,
+                                         Uint32 id)
+{
+    if (table->capacity == 0) return -1;
+    Uint32 mask = (Uint32)table->capacity - 1;
+    for (Uint32 slot = forge_ui__state_home(id, mask);
+         table->entries[slot].id != FORGE_UI_ID_NONE;
+         slot = (slot + 1) & mask) {
+        if (table->entries[slot].id == id) return (int)slot;
+    }
+    return -1;
+}
+
+/* Move every entry into a table of new_capacity slots.  States stay
+ * where they are.  On allocation failure the old table is kept. */
+static inline bool forge_ui__state_rehash(ForgeUiStateTable *table,
+                                          int new_capacity)
+{
+    ForgeUiStateEntry *entries = (ForgeUiStateEntry *)SDL_calloc(
+        (size_t)new_capacity, sizeof(ForgeUiStateEntry));
+    if (!entries) {
+        SDL_Log("forge_ui__state_rehash: allocation failed (%d slots)",
+                new_capacity);
+        return false;
+    }
+    Uint32 mask = (Uint32)new_capacity - 1;
+    for (int i = 0; i < table->capacity; i++) {
+        const ForgeUiStateEntry *e = &table->entries[i];
+        if (e->id == FORGE_UI_ID_NONE) continue;
+        Uint32 slot = forge_ui__state_home(e->id, mask);
+        while (entries[slot].id != FORGE_UI_ID_NONE) slot = (slot + 1) & mask;
+        entries[slot] = *e;
+    }
+    SDL_free(table->entries);
+    table->entries = entries;
+    table->capacity = new_capacity;
+    table->sweep = 0;
+    return true;
+}
+
+/* Hand out a zeroed state index, reusing released ones first.  Returns
+ * false if a new page cannot be allocated. */
+static inline bool forge_ui__state_alloc(ForgeUiStateTable *table,
+                                         Uint32 *out_index)
+{
+    Uint32 index;
+    if (table->free_head != 0) {
+        index = table->free_head - 1;
+        table->free_head = forge_ui__state_at(table, index)->u[0];
+    } else {
+        if (table->used == (Uint32)table->page_count * FORGE_UI_STATE_PAGE_SIZE) {
+            ForgeUiWidgetState **pages = (ForgeUiWidgetState **)SDL_realloc(
+                table->pages,
+                (size_t)(table->page_count + 1) * sizeof(ForgeUiWidgetState *));
+            if (!pages) {
+                SDL_Log("forge_ui__state_alloc: page table realloc failed");
+                return false;
+            }
+            table->pages = pages;
+            pages[table->page_count] = (ForgeUiWidgetState *)SDL_malloc(
+                FORGE_UI_STATE_PAGE_SIZE * sizeof(ForgeUiWidgetState));
+            if (!pages[table->page_count]) {
+                SDL_Log("forge_ui__state_alloc: page allocation failed");
+                return false;
+            }
+            table->page_count++;
+        }
+        index = table->used++;
+    }
+    SDL_memset(forge_ui__state_at(table, index), 0, sizeof(ForgeUiWidgetState));
+    *out_index = index;
+    return true;
+}
+
+/* Empty the slot and pull later entries of its probe chain back, so no
+ * tombstone is needed and lookups stay short. */
+static inline void forge_ui__state_remove(ForgeUiStateTable *table, Uint32 slot)
+{
+    Uint32 mask = (Uint32)table->capacity - 1;
+    ForgeUiWidgetState *state = forge_ui__state_at(table, table->entries[slot].index);
+    state->u[0] = table->free_head;
+    table->free_head = table->entries[slot].index + 1;
+
+    Uint32 hole = slot;
+    for (Uint32 j = (slot + 1) & mask;
+         table->entries[j].id != FORGE_UI_ID_NONE;
+         j = (j + 1) & mask) {
+        /* The entry at j may fill the hole if the hole lies between its
+         * home slot and j (cyclically) */
+        Uint32 home = forge_ui__state_home(table->entries[j].id, mask);
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            table->entries[hole] = table->entries[j];
+            hole = j;
+        }
+    }
+    SDL_memset(&table->entries[hole], 0, sizeof(ForgeUiStateEntry));
+    table->count--;
+}
+
+/* Release state not requested for FORGE_UI_STATE_MAX_AGE frames.  Called
+ * once per frame by forge_ui_ctx_begin; checks one slice of the table. */
+static inline void forge_ui__state_evict(ForgeUiStateTable *table)
+{
+    if (table->count == 0) return;
+    int budget = table->capacity / FORGE_UI_STATE_SWEEP_DIVISOR;
+    if (budget < 64) budget = 64;
+    if (budget > table->capacity) budget = table->capacity;
+    Uint32 mask = (Uint32)table->capacity - 1;
+    Uint32 slot = (Uint32)table->sweep & mask;
+    for (int k = 0; k < budget; k++) {
+        const ForgeUiStateEntry *e = &table->entries[slot];
+        if (e->id != FORGE_UI_ID_NONE
+            && table->frame - e->last_used > FORGE_UI_STATE_MAX_AGE) {
+            /* A later entry may have moved into this slot; look again */
+            forge_ui__state_remove(table, slot);
+            continue;
+        }
+        slot = (slot + 1) & mask;
+    }
+    table->sweep = (int)slot;
+}
+
+/* The finished frame's draw data: the segments forge_ui_wctx_end handed
+ * out, or ctx's own buffers as a single segment (written to *whole).
+ * *vertex_total is the vertex count of all segments together. */
+static inline const ForgeUiDrawSegment *forge_ui__ctx_frame_segments(
+    const ForgeUiContext *ctx, ForgeUiDrawSegment *whole, int *seg_count,
+    int *vertex_total)
+{
+    whole->vertices       = ctx->vertices;
+    whole->vertex_count   = ctx->vertex_count;
+    whole->indices        = ctx->indices;
+    whole->index_count    = ctx->index_count;
+    whole->base_vertex    = 0;
+    whole->first_index    = 0;
+    whole->draw_cmds      = ctx->draw_cmds;
+    whole->draw_cmd_count = ctx->draw_cmd_count;
+    const ForgeUiDrawSegment *segs = whole;
+    *seg_count = 1;
+    if (ctx->_segments) {
+        segs = ctx->_segments;
+        *seg_count = ctx->_segment_count;
+    }
+    *vertex_total = 0;
+    for (int s = 0; s < *seg_count; s++) {
+        int end = segs[s].base_vertex + segs[s].vertex_count;
+        if (end > *vertex_total) *vertex_total = end;
+    }
+    return segs;
+}
+
+/* ── Cached regions ─────────────────────────────────────────────────────── */
+
+/* Hash of everything besides the version and rect that shapes a region's
+ * draw data: atlas identity, scale, spacing, theme, and the draw command
+ * state.  Never returns 0. */
+static inline Uint32 forge_ui__region_style(const ForgeUiContext *ctx)
+{
+    Uint32 parts[6];
+    parts[0] = (Uint32)(uintptr_t)ctx->atlas;
+    SDL_memcpy(&parts[1], &ctx->atlas->pixel_height, sizeof(Uint32));
+    parts[2] = ((Uint32)ctx->atlas->width << 16) ^ (Uint32)ctx->atlas->height;
+    SDL_memcpy(&parts[3], &ctx->scale, sizeof(Uint32));
+    parts[4] = ctx->draw_cmds_enabled ? 1u : 0u;
+    parts[5] = ctx->texture_id;
+
+    Uint32 hash = FORGE_UI_FNV_OFFSET_BASIS;
+    const Uint8 *bytes[3] = { (const Uint8 *)parts,
+                              (const Uint8 *)&ctx->spacing,
+                              (const Uint8 *)&ctx->theme };
+    size_t sizes[3] = { sizeof(parts), sizeof(ctx->spacing),
+                        sizeof(ctx->theme) };
+    for (int b = 0; b < 3; b++) {
+        for (size_t i = 0; i < sizes[b]; i++) {
+            hash ^= bytes[b][i];
+            hash *= FORGE_UI_FNV_PRIME;
+        }
+    }
+    return hash ? hash : 1;
+}
+
+/* True when no input can reach a region at rect this frame: the cursor is
+ * outside it, hot was not claimed inside it, and no widget inside it can
+ * be active or focused (both require a press on the widget). */
+static inline bool forge_ui__region_quiet(const ForgeUiContext *ctx,
+                                          ForgeUiRect rect)
+{
+    if (forge_ui__rect_contains(rect, ctx->mouse_x, ctx->mouse_y)) {
+        return false;
+    }
+    if (ctx->hot != FORGE_UI_ID_NONE &&
+        forge_ui__rect_contains(rect, ctx->_hot_mouse_x, ctx->_hot_mouse_y)) {
+        return false;
+    }
+    if ((ctx->active != FORGE_UI_ID_NONE ||
+         ctx->focused != FORGE_UI_ID_NONE) &&
+        forge_ui__rect_contains(rect, ctx->_press_mouse_x,
+                                ctx->_press_mouse_y)) {
+        return false;
+    }
+    return true;
+}
+
+/* Grow *buf (an array of elem_size items with *capacity slots) to hold at
+ * least `needed` items. */
+static inline bool forge_ui__region_reserve(void **buf, int *capacity,
+                                            int needed, size_t elem_size)
+{
+    if (needed <= *capacity) return true;
+    int new_cap = *capacity > 0 ? *capacity : 16;
+    while (new_cap < needed) {
+        if (new_cap > INT_MAX / 2) return false;
+        new_cap *= 2;
+    }
+    void *grown = SDL_realloc(*buf, (size_t)new_cap * elem_size);
+    if (!grown) {
+        SDL_Log("forge_ui__region_reserve: realloc failed (%d items)",
+                new_cap);
+        return false;
+    }
+    *buf = grown;
+    *capacity = new_cap;
+    return true;
+}
+
+static inline ForgeUiRegion *forge_ui__region_find(ForgeUiRegionCache *cache,
+                                                   Uint32 id)
+{
+    for (int i = 0; i < cache->count; i++) {
+        if (cache->regions[i].id == id) return &cache->regions[i];
+    }
+    return NULL;
+}
+
+static inline void forge_ui__region_free(ForgeUiRegion *region)
+{
+    SDL_free(region->vertices);
+    SDL_free(region->indices);
+    SDL_free(region->draw_cmds);
+    SDL_free(region->state_ids);
+    SDL_memset(region, 0, sizeof(*region));
+}
+
+/* Drop regions nobody declared lately.  Called once per frame by
+ * forge_ui_ctx_begin. */
+static inline void forge_ui__region_cache_evict(ForgeUiRegionCache *cache)
+{
+    for (int i = 0; i < cache->count; ) {
+        if (cache->frame - cache->regions[i].last_used
+            > FORGE_UI_REGION_CACHE_MAX_AGE) {
+            forge_ui__region_free(&cache->regions[i]);
+            cache->regions[i] = cache->regions[cache->count - 1];
+            cache->count--;
+        } else {
+            i++;
+        }
+    }
+}
+
+/* Append region `id` as recorded, translated to rect, if its key matches
+ * and rect is quiet.  On success the panel state panel_end would have
+ * left behind (id, rect, content height) is restored so the next frame's
+ * scroll pre-clamp still works, and true is returned. */
+static inline bool forge_ui__region_replay(ForgeUiContext *ctx, Uint32 id,
+                                           Uint32 version, ForgeUiRect rect,
+                                           float scroll_y)
+{
+    ForgeUiRegionCache *cache = &ctx->region_cache;
+    if (cache->_recording || ctx->has_clip) return false;
+    if (!isfinite(rect.x) || !isfinite(rect.y)) return false;
+
+    ForgeUiRegion *region = forge_ui__region_find(cache, id);
+    if (!region || region->version != version ||
+        region->w != rect.w || region->h != rect.h ||
+        region->scroll_y != scroll_y ||
+        region->style != forge_ui__region_style(ctx) ||
+        !forge_ui__region_quiet(ctx, rect)) {
+        cache->misses++;
+        return false;
+    }
+    if (!forge_ui__grow_vertices(ctx, region->vertex_count) ||
+        !forge_ui__grow_indices(ctx, region->index_count)) {
+        cache->misses++;
+        return false;
+    }
+
+    float dx = rect.x - region->rect.x;
+    float dy = rect.y - region->rect.y;
+    Uint32 base = (Uint32)ctx->vertex_count;
+    ForgeUiVertex *dst = &ctx->vertices[ctx->vertex_count];
+    for (int i = 0; i < region->vertex_count; i++) {
+        dst[i] = region->vertices[i];
+        dst[i].pos_x += dx;
+        dst[i].pos_y += dy;
+    }
+    ctx->vertex_count += region->vertex_count;
+
+    if (ctx->draw_cmds_enabled) {
+        /* Re-enter each recorded command's state so the usual sync logic
+         * splits or merges commands around the replayed range */
+        bool saved_has_clip = ctx->has_clip;
+        ForgeUiRect saved_clip = ctx->clip_rect;
+        Uint32 saved_texture = ctx->texture_id;
+        for (int c = 0; c < region->draw_cmd_count; c++) {
+            const ForgeUiDrawCmd *cmd = &region->draw_cmds[c];
+            ctx->has_clip = cmd->has_clip;
+            ctx->clip_rect = cmd->clip_rect;
+            ctx->clip_rect.x += dx;
+            ctx->clip_rect.y += dy;
+            ctx->texture_id = cmd->texture_id;
+            forge_ui__draw_cmd_sync(ctx);
+            forge_ui__rebase_indices(&ctx->indices[ctx->index_count],
+                                     &region->indices[cmd->index_offset],
+                                     cmd->index_count, base);
+            ctx->index_count += cmd->index_count;
+        }
+        ctx->has_clip = saved_has_clip;
+        ctx->clip_rect = saved_clip;
+        ctx->texture_id = saved_texture;
+    } else {
+        forge_ui__rebase_indices(&ctx->indices[ctx->index_count],
+                                 region->indices, region->index_count, base);
+        ctx->index_count += region->index_count;
+    }
+
+    ctx->_panel.id = id;
+    ctx->_panel.rect = rect;
+    ctx->_panel.content_rect = region->content_rect;
+    ctx->_panel.content_rect.x += dx;
+    ctx->_panel.content_rect.y += dy;
+    ctx->_panel.content_height = region->content_height;
+    ctx->_panel.scroll_y = NULL;
+
+    /* Keep alive the state the skipped widgets would have requested.
+     * State released meanwhile (forge_ui_ctx_state_clear) is not
+     * recreated. */
+    ForgeUiStateTable *table = &ctx->state;
+    for (int i = 0; i < region->state_id_count; i++) {
+        int found = forge_ui__state_lookup(table, region->state_ids[i]);
+        if (found >= 0) table->entries[found].last_used = table->frame;
+    }
+
+    region->last_used = cache->frame;
+    cache->hits++;
+    return true;
+}
+
+/* Start recording region `id` if rect is quiet (a region touched by input
+ * this frame would be recorded with hover or press visuals).  Recording
+ * ends in panel_end. */
+static inline void forge_ui__region_record_begin(ForgeUiContext *ctx,
+                                                 Uint32 id, Uint32 version,
+                                                 ForgeUiRect rect,
+                                                 float scroll_y)
+{
+    ForgeUiRegionCache *cache = &ctx->region_cache;
+    if (cache->_recording || ctx->has_clip) return;
+    if (!forge_ui__region_quiet(ctx, rect)) return;
+    /* A replay emits glyph UVs without looking the glyphs up, so a glyph
+     * cache behind the atlas could evict them mid-frame; never record */
+    if (ctx->atlas->lookup_fn) return;
+    if (!forge_ui__region_find(cache, id) &&
+        cache->count >= FORGE_UI_REGION_CACHE_MAX) {
+        return;
+    }
+
+    SDL_memset(&cache->_rec_key, 0, sizeof(cache->_rec_key));
+    cache->_rec_key.id       = id;
+    cache->_rec_key.version  = version;
+    cache->_rec_key.style    = forge_ui__region_style(ctx);
+    cache->_rec_key.w        = rect.w;
+    cache->_rec_key.h        = rect.h;
+    cache->_rec_key.scroll_y = scroll_y;
+    cache->_rec_vertex_start   = ctx->vertex_count;
+    cache->_rec_index_start    = ctx->index_count;
+    cache->_rec_draw_cmd_start = ctx->draw_cmd_count;
+    cache->_rec_state_count    = 0;
+    cache->_recording = true;
+}
+
+/* Note that the region being recorded requested widget state id, so its
+ * replays can keep that state alive.  A repeat of the last ID (a widget
+ * asking twice) is dropped; if the list cannot grow, the recording is
+ * abandoned rather than kept with state it would let expire. */
+static inline void forge_ui__region_note_state(ForgeUiRegionCache *cache,
+                                               Uint32 id)
+{
+    if (cache->_rec_state_count > 0 &&
+        cache->_rec_state_ids[cache->_rec_state_count - 1] == id) {
+        return;
+    }
+    if (!forge_ui__region_reserve((void **)&cache->_rec_state_ids,
+                                  &cache->_rec_state_capacity,
+                                  cache->_rec_state_count + 1,
+                                  sizeof(Uint32))) {
+        cache->_recording = false;
+        return;
+    }
+    cache->_rec_state_ids[cache->_rec_state_count++] = id;
+}
+
+/* Finish the recording started by forge_ui__region_record_begin, called
+ * by panel_end once the panel is complete.  scroll_y is the panel's
+ * scroll pointer; if the panel changed it (clamping), the draw data
+ * belongs to neither value and is not kept. */
+static inline void forge_ui__region_record_end(ForgeUiContext *ctx,
+                                               const float *scroll_y)
+{
+    ForgeUiRegionCache *cache = &ctx->region_cache;
+    if (!cache->_recording) return;
+    cache->_recording = false;
+
+    const ForgeUiRegion *key = &cache->_rec_key;
+    if (ctx->_panel.id != key->id || !scroll_y ||
+        *scroll_y != key->scroll_y ||
+        ctx->_panel.rect.w != key->w || ctx->_panel.rect.h != key->h) {
+        return;
+    }
+    int vertex_count = ctx->vertex_count - cache->_rec_vertex_start;
+    int index_count  = ctx->index_count - cache->_rec_index_start;
+    if (vertex_count < 0 || index_count < 0) return;
+
+    ForgeUiRegion *region = forge_ui__region_find(cache, key->id);
+    if (!region) {
+        if (cache->count >= FORGE_UI_REGION_CACHE_MAX) return;
+        if (!forge_ui__region_reserve((void **)&cache->regions,
+                                      &cache->capacity, cache->count + 1,
+                                      sizeof(ForgeUiRegion))) {
+            return;
+        }
+        region = &cache->regions[cache->count++];
+        SDL_memset(region, 0, sizeof(*region));
+        region->id = key->id;
+    }
 
-    float inv_w = (x1 != x0) ? 1.0f / (x1 - x0) : 0.0f;
-    float inv_h = (y1 != y0) ? 1.0f / (y1 - y0) : 0.0f;
+    /* Invalidate first so a failed copy cannot leave a stale match */
+    region->version = key->version;
+    region->style = 0;
+    region->last_used = cache->frame;
+    region->vertex_count = 0;
+    region->index_count = 0;
+    region->draw_cmd_count = 0;
+    region->state_id_count = 0;
+    if (!forge_ui__region_reserve((void **)&region->vertices,
+                                  &region->vertex_capacity, vertex_count,
+                                  sizeof(ForgeUiVertex)) ||
+        !forge_ui__region_reserve((void **)&region->indices,
+                                  &region->index_capacity, index_count,
+                                  sizeof(Uint32)) ||
+        !forge_ui__region_reserve((void **)&region->state_ids,
+                                  &region->state_id_capacity,
+                                  cache->_rec_state_count, sizeof(Uint32))) {
+        return;
+    }
+    if (cache->_rec_state_count > 0) {
+        SDL_memcpy(region->state_ids, cache->_rec_state_ids,
+                   (size_t)cache->_rec_state_count * sizeof(Uint32));
+    }
 
-    float nu0 = u0 + (u1 - u0) * (nx0 - x0) * inv_w;
-    float nu1 = u0 + (u1 - u0) * (nx1 - x0) * inv_w;
-    float nv0 = v0 + (v1 - v0) * (ny0 - y0) * inv_h;
-    float nv1 = v0 + (v1 - v0) * (ny1 - y0) * inv_h;
+    Uint32 vertex_start = (Uint32)cache->_rec_vertex_start;
+    if (vertex_count > 0) {
+        SDL_memcpy(region->vertices, &ctx->vertices[vertex_start],
+                   (size_t)vertex_count * sizeof(ForgeUiVertex));
+    }
+    const Uint32 *src = &ctx->indices[cache->_rec_index_start];
+    for (int i = 0; i < index_count; i++) {
+        region->indices[i] = src[i] - vertex_start;
+    }
 
-    if (!forge_ui__grow_vertices(ctx, 4)) return;
-    if (!forge_ui__grow_indices(ctx, 6)) return;
+    /* The commands covering the recorded index range.  The first may have
+     * been opened before the region (e.g. the unclipped command the
+     * panel background merged into), so ranges are clamped. */
+    if (ctx->draw_cmds_enabled && ctx->draw_cmd_count > 0) {
+        forge_ui__draw_cmd_close(ctx);
+        int first = cache->_rec_draw_cmd_start > 0
+                    ? cache->_rec_draw_cmd_start - 1 : 0;
+        int range_start = cache->_rec_index_start;
+        int range_end = ctx->index_count;
+        if (!forge_ui__region_reserve((void **)&region->draw_cmds,
+                                      &region->draw_cmd_capacity,
+                                      ctx->draw_cmd_count - first,
+                                      sizeof(ForgeUiDrawCmd))) {
+            return;
+        }
+        for (int c = first; c < ctx->draw_cmd_count; c++) {
+            ForgeUiDrawCmd cmd = ctx->draw_cmds[c];
+            int lo = cmd.index_offset > range_start ? cmd.index_offset
+                                                    : range_start;
+            int hi = cmd.index_offset + cmd.index_count;
+            if (hi > range_end) hi = range_end;
+            if (hi <= lo) continue;
+            cmd.index_offset = lo - range_start;
+            cmd.index_count = hi - lo;
+            region->draw_cmds[region->draw_cmd_count++] = cmd;
+        }
+    }
 
-    Uint32 base = (Uint32)ctx->vertex_count;
-    float r = src[0].r, g = src[0].g, b = src[0].b, a = src[0].a;
+    region->vertex_count   = vertex_count;
+    region->index_count    = index_count;
+    region->state_id_count = cache->_rec_state_count;
+    region->w              = key->w;
+    region->h              = key->h;
+    region->scroll_y       = key->scroll_y;
+    region->rect           = ctx->_panel.rect;
+    region->content_rect   = ctx->_panel.content_rect;
+    region->content_height = ctx->_panel.content_height;
+    region->style          = key->style;
+}
 
-    ForgeUiVertex *v = &ctx->vertices[ctx->vertex_count];
-    v[0] = (ForgeUiVertex){ nx0, ny0, nu0, nv0, r, g, b, a };
-    v[1] = (ForgeUiVertex){ nx1, ny0, nu1, nv0, r, g, b, a };
-    v[2] = (ForgeUiVertex){ nx1, ny1, nu1, nv1, r, g, b, a };
-    v[3] = (ForgeUiVertex){ nx0, ny1, nu0, nv1, r, g, b, a };
-    ctx->vertex_count += 4;
+/* ── Damage tracking ────────────────────────────────────────────────────── */
 
-    Uint32 *idx = &ctx->indices[ctx->index_count];
-    idx[0] = base + 0;  idx[1] = base + 1;  idx[2] = base + 2;
-    idx[3] = base + 0;  idx[4] = base + 2;  idx[5] = base + 3;
-    ctx->index_count += 6;
+/* One MurmurHash3 round: fold k into h.  Order-dependent, so a tile's
+ * hash changes when the same triangles are drawn in a different order. */
+static inline Uint32 forge_ui__damage_mix(Uint32 h, Uint32 k)
+{
+    k *= 0xcc9e2d51u;
+    k = (k << 15) | (k >> 17);
+    k *= 0x1b873593u;
+    h ^= k;
+    h = (h << 13) | (h >> 19);
+    return h * 5u + 0xe6546b64u;
 }
 
-/* Append vertices and indices from a text layout into the context's
- * draw buffers.  When clipping is active, processes each glyph quad
- * individually with UV remapping; otherwise bulk-copies all data. */
-static inline void forge_ui__emit_text_layout(ForgeUiContext *ctx,
-                                              const ForgeUiTextLayout *layout)
+/* Append one damage rect (tile coordinates, inclusive) in pixels. */
+static inline bool forge_ui__damage_push(ForgeUiContext *ctx,
+                                         int c0, int r0, int c1, int r1)
 {
-    if (!layout || layout->vertex_count == 0 || !layout->vertices || !layout->indices) return;
-
-    /* ── Per-quad clipping path (when has_clip is true) ──────────────── */
-    if (ctx->has_clip) {
-        /* Each glyph is a quad: 4 vertices, 6 indices.  Iterate per-quad
-         * and clip individually with UV remapping. */
-        int quad_count = layout->vertex_count / 4;
-        for (int q = 0; q < quad_count; q++) {
-            forge_ui__emit_quad_clipped(ctx,
-                                         &layout->vertices[q * 4],
-                                         &ctx->clip_rect);
+    if (ctx->damage_rect_count >= ctx->damage_rect_capacity) {
+        int new_cap = ctx->damage_rect_capacity > 0
+                      ? ctx->damage_rect_capacity * 2 : 16;
+        if (new_cap > FORGE_UI_DAMAGE_MAX_RECTS) {
+            new_cap = FORGE_UI_DAMAGE_MAX_RECTS;
         }
-        return;
+        if (new_cap <= ctx->damage_rect_count) return false;
+        ForgeUiRect *buf = (ForgeUiRect *)SDL_realloc(
+            ctx->damage_rects, (size_t)new_cap * sizeof(ForgeUiRect));
+        if (!buf) {
+            SDL_Log("forge_ui__damage_push: realloc failed (%d rects)",
+                    new_cap);
+            return false;
+        }
+        ctx->damage_rects = buf;
+        ctx->damage_rect_capacity = new_cap;
     }
+    int x0 = c0 * FORGE_UI_DAMAGE_TILE_SIZE;
+    int y0 = r0 * FORGE_UI_DAMAGE_TILE_SIZE;
+    int x1 = (c1 + 1) * FORGE_UI_DAMAGE_TILE_SIZE;
+    int y1 = (r1 + 1) * FORGE_UI_DAMAGE_TILE_SIZE;
+    if (x1 > ctx->damage_width)  x1 = ctx->damage_width;
+    if (y1 > ctx->damage_height) y1 = ctx->damage_height;
+    ctx->damage_rects[ctx->damage_rect_count++] = (ForgeUiRect){
+        (float)x0, (float)y0, (float)(x1 - x0), (float)(y1 - y0)
+    };
+    return true;
+}
 
-    /* ── Bulk copy path (no clipping) ────────────────────────────────── */
-    if (!forge_ui__grow_vertices(ctx, layout->vertex_count)) return;
-    if (!forge_ui__grow_indices(ctx, layout->index_count)) return;
+/* Hash triangles [first, first + count) of seg's index buffer into the
+ * tiles they touch, limited to clip when has_clip (the scissor decides
+ * which pixels a clipped triangle can reach, so the clip rect and texture
+ * are part of the triangle's hash too). */
+static inline void forge_ui__damage_hash_range(ForgeUiContext *ctx,
+                                               const ForgeUiDrawSegment *seg,
+                                               int first, int count,
+                                               bool has_clip,
+                                               ForgeUiRect clip,
+                                               Uint32 texture_id)
+{
+    const float tile = (float)FORGE_UI_DAMAGE_TILE_SIZE;
+    float lim_x0 = 0.0f, lim_y0 = 0.0f;
+    float lim_x1 = (float)ctx->damage_width;
+    float lim_y1 = (float)ctx->damage_height;
+    Uint32 clip_hash = forge_ui__damage_mix(0, texture_id);
+    if (has_clip) {
+        if (clip.x > lim_x0) lim_x0 = clip.x;
+        if (clip.y > lim_y0) lim_y0 = clip.y;
+        if (clip.x + clip.w < lim_x1) lim_x1 = clip.x + clip.w;
+        if (clip.y + clip.h < lim_y1) lim_y1 = clip.y + clip.h;
+        Uint32 bits[4];
+        SDL_memcpy(bits, &clip, sizeof(bits));
+        for (int i = 0; i < 4; i++) clip_hash = forge_ui__damage_mix(clip_hash, bits[i]);
+    }
+    if (!(lim_x0 < lim_x1) || !(lim_y0 < lim_y1)) return;
+
+    const Uint32 *vh = &ctx->_damage_vertex_hash[seg->base_vertex];
+    for (int i = first; i + 2 < first + count; i += 3) {
+        Uint32 i0 = seg->indices[i], i1 = seg->indices[i + 1];
+        Uint32 i2 = seg->indices[i + 2];
+        if (i0 >= (Uint32)seg->vertex_count ||
+            i1 >= (Uint32)seg->vertex_count ||
+            i2 >= (Uint32)seg->vertex_count) {
+            continue;
+        }
+        const ForgeUiVertex *a = &seg->vertices[i0];
+        const ForgeUiVertex *b = &seg->vertices[i1];
+        const ForgeUiVertex *c = &seg->vertices[i2];
+        float x0 = a->pos_x, x1 = a->pos_x, y0 = a->pos_y, y1 = a->pos_y;
+        if (b->pos_x < x0) x0 = b->pos_x;
+        if (b->pos_x > x1) x1 = b->pos_x;
+        if (c->pos_x < x0) x0 = c->pos_x;
+        if (c->pos_x > x1) x1 = c->pos_x;
+        if (b->pos_y < y0) y0 = b->pos_y;
+        if (b->pos_y > y1) y1 = b->pos_y;
+        if (c->pos_y < y0) y0 = c->pos_y;
+        if (c->pos_y > y1) y1 = c->pos_y;
+        if (x0 < lim_x0) x0 = lim_x0;
+        if (y0 < lim_y0) y0 = lim_y0;
+        if (x1 > lim_x1) x1 = lim_x1;
+        if (y1 > lim_y1) y1 = lim_y1;
+        /* Also rejects NaN bounds */
+        if (!(x0 <= x1) || !(y0 <= y1)) continue;
+
+        Uint32 h = forge_ui__damage_mix(clip_hash, vh[i0]);
+        h = forge_ui__damage_mix(h, vh[i1]);
+        h = forge_ui__damage_mix(h, vh[i2]);
+
+        int col0 = (int)(x0 / tile), col1 = (int)(x1 / tile);
+        int row0 = (int)(y0 / tile), row1 = (int)(y1 / tile);
+        if (col1 >= ctx->_damage_cols) col1 = ctx->_damage_cols - 1;
+        if (row1 >= ctx->_damage_rows) row1 = ctx->_damage_rows - 1;
+        for (int r = row0; r <= row1; r++) {
+            Uint32 *row = &ctx->_damage_tiles[r * ctx->_damage_cols];
+            for (int col = col0; col <= col1; col++) {
+                row[col] = forge_ui__damage_mix(row[col], h);
+            }
+        }
+    }
+}
 
-    Uint32 base = (Uint32)ctx->vertex_count;
+/* Fill damage_rects for the finished frame (called by ctx_end). */
+static inline void forge_ui__ctx_damage(ForgeUiContext *ctx)
+{
+    ctx->damage_rect_count = 0;
+    if (!ctx->damage_enabled) return;
+    int cols = ctx->_damage_cols, rows = ctx->_damage_rows;
+    int tiles = cols * rows;
+    if (tiles == 0) return;
+
+    ForgeUiDrawSegment whole;
+    int seg_count, vertex_total;
+    const ForgeUiDrawSegment *segs = forge_ui__ctx_frame_segments(
+        ctx, &whole, &seg_count, &vertex_total);
+
+    /* Per-vertex hashes, so shared quad corners are hashed once */
+    ctx->_damage_vertex_hash = NULL;
+    if (vertex_total > 0) {
+        ctx->_damage_vertex_hash = (Uint32 *)forge_ui__arena_alloc(
+            &ctx->arena, (size_t)vertex_total * sizeof(Uint32));
+        if (!ctx->_damage_vertex_hash) {
+            ctx->_damage_prev_valid = false;
+            forge_ui__damage_push(ctx, 0, 0, cols - 1, rows - 1);
+            return;
+        }
+    }
+    for (int s = 0; s < seg_count; s++) {
+        const ForgeUiVertex *verts = segs[s].vertices;
+        Uint32 *vh = &ctx->_damage_vertex_hash[segs[s].base_vertex];
+        for (int i = 0; i < segs[s].vertex_count; i++) {
+            /* Odd multipliers: a change to any single field always
+             * changes the sum, and one mix round spreads it over all
+             * bits */
+            Uint32 w[8];
+            SDL_memcpy(w, &verts[i], sizeof(w));
+            Uint32 sum = w[0] * 0x9e3779b1u + w[1] * 0x85ebca77u
+                       + w[2] * 0xc2b2ae3du + w[3] * 0x27d4eb2fu
+                       + w[4] * 0x165667b1u + w[5] * 0xd3a2646du
+                       + w[6] * 0xfd7046c5u + w[7] * 0xb55a4f09u;
+            vh[i] = forge_ui__damage_mix(0x2545f491u, sum);
+        }
+    }
 
-    /* Copy vertices into the shared buffer without modification --
-     * vertex positions are absolute screen coordinates. */
-    SDL_memcpy(&ctx->vertices[ctx->vertex_count],
-               layout->vertices,
-               (size_t)layout->vertex_count * sizeof(ForgeUiVertex));
-    ctx->vertex_count += layout->vertex_count;
+    for (int t = 0; t < tiles; t++) ctx->_damage_tiles[t] = 0x9e3779b9u;
+    for (int s = 0; s < seg_count; s++) {
+        const ForgeUiDrawSegment *seg = &segs[s];
+        if (ctx->draw_cmds_enabled) {
+            for (int c = 0; c < seg->draw_cmd_count; c++) {
+                const ForgeUiDrawCmd *cmd = &seg->draw_cmds[c];
+                forge_ui__damage_hash_range(ctx, seg, cmd->index_offset,
+                                            cmd->index_count, cmd->has_clip,
+                                            cmd->clip_rect, cmd->texture_id);
+            }
+        } else {
+            ForgeUiRect none = { 0.0f, 0.0f, 0.0f, 0.0f };
+            forge_ui__damage_hash_range(ctx, seg, 0, seg->index_count, false,
+                                        none, ctx->texture_id);
+        }
+    }
 
-    /* Rebase indices by the current vertex count so they reference the
-     * correct positions in the shared vertex buffer (text layouts produce
-     * indices starting from zero). */
-    for (int i = 0; i < layout->index_count; i++) {
-        ctx->indices[ctx->index_count + i] = layout->indices[i] + base;
+    /* Changed tiles become rects: runs along each row, then runs with the
+     * same columns on consecutive rows are merged */
+    bool full = !ctx->_damage_prev_valid;
+    int bound_c0 = cols, bound_r0 = rows, bound_c1 = -1, bound_r1 = -1;
+    bool overflow = false;
+    for (int r = 0; r < rows && !full; r++) {
+        const Uint32 *cur = &ctx->_damage_tiles[r * cols];
+        const Uint32 *old = &ctx->_damage_prev_tiles[r * cols];
+        for (int c = 0; c < cols; ) {
+            if (cur[c] == old[c]) { c++; continue; }
+            int c0 = c;
+            while (c < cols && cur[c] != old[c]) c++;
+            int c1 = c - 1;
+            if (c0 < bound_c0) bound_c0 = c0;
+            if (c1 > bound_c1) bound_c1 = c1;
+            if (r < bound_r0) bound_r0 = r;
+            bound_r1 = r;
+            if (overflow) continue;
+
+            bool merged = false;
+            for (int k = 0; k < ctx->damage_rect_count; k++) {
+                ForgeUiRect *d = &ctx->damage_rects[k];
+                int dc0 = (int)d->x / FORGE_UI_DAMAGE_TILE_SIZE;
+                int dc1 = ((int)(d->x + d->w) - 1) / FORGE_UI_DAMAGE_TILE_SIZE;
+                int dr1 = ((int)(d->y + d->h) - 1) / FORGE_UI_DAMAGE_TILE_SIZE;
+                if (dc0 == c0 && dc1 == c1 && dr1 == r - 1) {
+                    int y1 = (r + 1) * FORGE_UI_DAMAGE_TILE_SIZE;
+                    if (y1 > ctx->damage_height) y1 = ctx->damage_height;
+                    d->h = (float)y1 - d->y;
+                    merged = true;
+                    break;
+                }
+            }
+            if (!merged && !forge_ui__damage_push(ctx, c0, r, c1, r)) {
+                overflow = true;
+            }
+        }
     }
-    ctx->index_count += layout->index_count;
-}
 
-/* Emit a rectangular border as four thin edge rects drawn INSIDE the
- * given rectangle.  Used for the focused text input outline. */
-static inline void forge_ui__emit_border(ForgeUiContext *ctx,
-                                          ForgeUiRect rect,
-                                          float border_w,
-                                          float r, float g, float b, float a)
-{
-    if (!ctx) return;
-    /* Reject degenerate borders: width must be positive, finite, and must
-     * fit within half the rect dimension to avoid inverted geometry.
-     * NaN fails the > 0 check (NaN > 0 is false). */
-    if (!(border_w > 0.0f)) return;
-    if (border_w > rect.w * 0.5f || border_w > rect.h * 0.5f) return;
+    if (full) {
+        ctx->damage_rect_count = 0;
+        forge_ui__damage_push(ctx, 0, 0, cols - 1, rows - 1);
+    } else if (overflow) {
+        ctx->damage_rect_count = 0;
+        forge_ui__damage_push(ctx, bound_c0, bound_r0, bound_c1, bound_r1);
+    }
 
-    /* Top edge — full width so corners are covered by the horizontal edges */
-    forge_ui__emit_rect(ctx,
-        (ForgeUiRect){ rect.x, rect.y, rect.w, border_w },
-        r, g, b, a);
-    /* Bottom edge — full width, same reason */
-    forge_ui__emit_rect(ctx,
-        (ForgeUiRect){ rect.x, rect.y + rect.h - border_w, rect.w, border_w },
-        r, g, b, a);
-    /* Left edge — shortened to avoid double-drawing corner pixels where
-     * it would overlap the top and bottom edges */
-    forge_ui__emit_rect(ctx,
-        (ForgeUiRect){ rect.x, rect.y + border_w,
-                       border_w, rect.h - 2.0f * border_w },
-        r, g, b, a);
-    /* Right edge — shortened for the same corner overlap reason */
-    forge_ui__emit_rect(ctx,
-        (ForgeUiRect){ rect.x + rect.w - border_w, rect.y + border_w,
-                       border_w, rect.h - 2.0f * border_w },
-        r, g, b, a);
+    Uint32 *swap = ctx->_damage_prev_tiles;
+    ctx->_damage_prev_tiles = ctx->_damage_tiles;
+    ctx->_damage_tiles = swap;
+    ctx->_damage_prev_valid = true;
 }
 
 /* ── Implementation ─────────────────────────────────────────────────────── */
@@ -1165,6 +3006,25 @@ static inline bool forge_ui_ctx_init(ForgeUiContext *ctx,
 static inline void forge_ui_ctx_free(ForgeUiContext *ctx)
 {
     if (!ctx) return;
+    forge_ui_ctx_text_cache_clear(ctx);
+    SDL_free(ctx->text_cache.runs);
+    SDL_free(ctx->text_cache.scratch);
+    SDL_memset(&ctx->text_cache, 0, sizeof(ctx->text_cache));
+    forge_ui__arena_free(&ctx->arena);
+    forge_ui_ctx_region_cache_clear(ctx);
+    SDL_free(ctx->region_cache.regions);
+    SDL_free(ctx->region_cache._rec_state_ids);
+    SDL_memset(&ctx->region_cache, 0, sizeof(ctx->region_cache));
+    SDL_free(ctx->packed_vertices);
+    ctx->packed_vertices = NULL;
+    ctx->packed_vertex_count = 0;
+    ctx->packed_vertex_capacity = 0;
+    SDL_free(ctx->draw_cmds);
+    ctx->draw_cmds = NULL;
+    ctx->draw_cmd_count = 0;
+    ctx->draw_cmd_capacity = 0;
+    forge_ui_ctx_set_damage_tracking(ctx, 0, 0);
+    forge_ui_ctx_state_clear(ctx);
     SDL_free(ctx->vertices);
     SDL_free(ctx->indices);
     ctx->vertices = NULL;
@@ -1204,6 +3064,12 @@ static inline void forge_ui_ctx_begin(ForgeUiContext *ctx,
     ctx->mouse_x = isfinite(mouse_x) ? mouse_x : 0.0f;
     ctx->mouse_y = isfinite(mouse_y) ? mouse_y : 0.0f;
     ctx->mouse_down = mouse_down;
+    ctx->_segments = NULL;
+    ctx->_segment_count = 0;
+    if (ctx->mouse_down && !ctx->mouse_down_prev) {
+        ctx->_press_mouse_x = ctx->mouse_x;
+        ctx->_press_mouse_y = ctx->mouse_y;
+    }
 
     /* Reset hot for this frame -- widgets will claim it during processing */
     ctx->next_hot = FORGE_UI_ID_NONE;
@@ -1283,9 +3149,273 @@ static inline void forge_ui_ctx_begin(ForgeUiContext *ctx,
     }
     ctx->id_stack_depth = 0;
 
+    /* Advance the text cache clock and drop runs nobody drew lately,
+     * including arena runs whose half is rewound next */
+    ctx->text_cache.frame++;
+    forge_ui__text_cache_evict(&ctx->text_cache);
+    forge_ui__arena_begin_frame(&ctx->arena);
+
+    /* Widget state ages the same way, one slice of the table per frame */
+    ctx->state.frame++;
+    forge_ui__state_evict(&ctx->state);
+
+    /* Same for recorded regions; a recording left open by a panel that
+     * never ended is abandoned */
+    ctx->region_cache.frame++;
+    ctx->region_cache._recording = false;
+    forge_ui__region_cache_evict(&ctx->region_cache);
+
     /* Reset draw buffers (keep allocated memory) */
     ctx->vertex_count = 0;
     ctx->index_count = 0;
+    ctx->packed_vertex_count = 0;
+    ctx->draw_cmd_count = 0;
+}
+
+static inline bool forge_ui_ctx_set_vertex_format(ForgeUiContext *ctx,
+                                                  ForgeUiVertexFormat format)
+{
+    if (!ctx) return false;
+    if (format != FORGE_UI_VERTEX_FORMAT_FLOAT &&
+        format != FORGE_UI_VERTEX_FORMAT_PACKED) {
+        SDL_Log("forge_ui_ctx_set_vertex_format: unknown format %d",
+                (int)format);
+        return false;
+    }
+    ctx->vertex_format = format;
+    if (format == FORGE_UI_VERTEX_FORMAT_FLOAT) {
+        ctx->packed_vertex_count = 0;
+    }
+    return true;
+}
+
+static inline bool forge_ui_ctx_set_draw_commands(ForgeUiContext *ctx,
+                                                  bool enabled)
+{
+    if (!ctx) return false;
+    ctx->draw_cmds_enabled = enabled;
+    ctx->draw_cmd_count = 0;
+    return true;
+}
+
+static inline void forge_ui_ctx_set_texture(ForgeUiContext *ctx,
+                                            Uint32 texture_id)
+{
+    if (!ctx) return;
+    ctx->texture_id = texture_id;
+}
+
+static inline bool forge_ui_ctx_set_damage_tracking(ForgeUiContext *ctx,
+                                                    int width, int height)
+{
+    if (!ctx) return false;
+    if (width < 0 || height < 0 || width > 16384 || height > 16384) {
+        SDL_Log("forge_ui_ctx_set_damage_tracking: invalid size %dx%d",
+                width, height);
+        return false;
+    }
+
+    SDL_free(ctx->_damage_tiles);
+    SDL_free(ctx->_damage_prev_tiles);
+    ctx->_damage_tiles = NULL;
+    ctx->_damage_prev_tiles = NULL;
+    ctx->_damage_cols = 0;
+    ctx->_damage_rows = 0;
+    ctx->_damage_prev_valid = false;
+    ctx->damage_rect_count = 0;
+    ctx->damage_width = 0;
+    ctx->damage_height = 0;
+    ctx->damage_enabled = false;
+
+    if (width == 0 || height == 0) {
+        SDL_free(ctx->damage_rects);
+        ctx->damage_rects = NULL;
+        ctx->damage_rect_capacity = 0;
+        return true;
+    }
+
+    int cols = (width + FORGE_UI_DAMAGE_TILE_SIZE - 1) / FORGE_UI_DAMAGE_TILE_SIZE;
+    int rows = (height + FORGE_UI_DAMAGE_TILE_SIZE - 1) / FORGE_UI_DAMAGE_TILE_SIZE;
+    size_t bytes = (size_t)cols * (size_t)rows * sizeof(Uint32);
+    ctx->_damage_tiles = (Uint32 *)SDL_malloc(bytes);
+    ctx->_damage_prev_tiles = (Uint32 *)SDL_malloc(bytes);
+    if (!ctx->_damage_tiles || !ctx->_damage_prev_tiles) {
+        SDL_Log("forge_ui_ctx_set_damage_tracking: allocation failed "
+                "(%dx%d tiles)", cols, rows);
+        SDL_free(ctx->_damage_tiles);
+        SDL_free(ctx->_damage_prev_tiles);
+        ctx->_damage_tiles = NULL;
+        ctx->_damage_prev_tiles = NULL;
+        return false;
+    }
+    ctx->_damage_cols = cols;
+    ctx->_damage_rows = rows;
+    ctx->damage_width = width;
+    ctx->damage_height = height;
+    ctx->damage_enabled = true;
+    return true;
+}
+
+static inline void forge_ui_ctx_damage_reset(ForgeUiContext *ctx)
+{
+    if (!ctx) return;
+    ctx->_damage_prev_valid = false;
+}
+
+static inline ForgeUiWidgetState *forge_ui_ctx_state(ForgeUiContext *ctx,
+                                                     Uint32 id,
+                                                     bool *created)
+{
+    if (created) *created = false;
+    if (!ctx || id == FORGE_UI_ID_NONE) return NULL;
+    ForgeUiStateTable *table = &ctx->state;
+
+    if (ctx->region_cache._recording) {
+        forge_ui__region_note_state(&ctx->region_cache, id);
+    }
+
+    int found = forge_ui__state_lookup(table, id);
+    if (found >= 0) {
+        ForgeUiStateEntry *e = &table->entries[found];
+        e->last_used = table->frame;
+        return forge_ui__state_at(table, e->index);
+    }
+
+    /* New entry: keep the table at most half full */
+    if (table->count + 1 > table->capacity / 2) {
+        int grown = table->capacity > 0 ? table->capacity * 2
+                                        : FORGE_UI_STATE_INITIAL_SLOTS;
+        if (grown > FORGE_UI_STATE_MAX_SLOTS) {
+            SDL_Log("forge_ui_ctx_state: table full (%d widgets)",
+                    table->count);
+            return NULL;
+        }
+        if (!forge_ui__state_rehash(table, grown)) return NULL;
+    }
+    Uint32 index;
+    if (!forge_ui__state_alloc(table, &index)) return NULL;
+
+    Uint32 mask = (Uint32)table->capacity - 1;
+    Uint32 slot = forge_ui__state_home(id, mask);
+    while (table->entries[slot].id != FORGE_UI_ID_NONE) slot = (slot + 1) & mask;
+    table->entries[slot].id = id;
+    table->entries[slot].last_used = table->frame;
+    table->entries[slot].index = index;
+    table->count++;
+    if (created) *created = true;
+    return forge_ui__state_at(table, index);
+}
+
+static inline ForgeUiWidgetState *forge_ui_ctx_state_find(const ForgeUiContext *ctx,
+                                                          Uint32 id)
+{
+    if (!ctx || id == FORGE_UI_ID_NONE) return NULL;
+    int found = forge_ui__state_lookup(&ctx->state, id);
+    if (found < 0) return NULL;
+    return forge_ui__state_at(&ctx->state, ctx->state.entries[found].index);
+}
+
+static inline void forge_ui_ctx_state_clear(ForgeUiContext *ctx)
+{
+    if (!ctx) return;
+    ForgeUiStateTable *table = &ctx->state;
+    for (int p = 0; p < table->page_count; p++) SDL_free(table->pages[p]);
+    SDL_free(table->pages);
+    SDL_free(table->entries);
+    Uint32 frame = table->frame;
+    SDL_memset(table, 0, sizeof(*table));
+    table->frame = frame;
+}
+
+static inline void forge_ui_ctx_text_cache_clear(ForgeUiContext *ctx)
+{
+    if (!ctx) return;
+    ForgeUiTextCache *cache = &ctx->text_cache;
+    for (int i = 0; i < cache->capacity; i++) {
+        if (cache->runs[i].hash != 0 && !cache->runs[i].transient) {
+            SDL_free(cache->runs[i].vertices);
+        }
+    }
+    if (cache->runs) {
+        SDL_memset(cache->runs, 0,
+                   (size_t)cache->capacity * sizeof(ForgeUiTextRun));
+    }
+    cache->count = 0;
+}
+
+static inline void *forge_ui_ctx_frame_alloc(ForgeUiContext *ctx, size_t size)
+{
+    if (!ctx) return NULL;
+    return forge_ui__arena_alloc(&ctx->arena, size);
+}
+
+static inline const char *forge_ui_ctx_frame_printf(ForgeUiContext *ctx,
+                                                    const char *fmt, ...)
+{
+    if (!ctx || !fmt) return NULL;
+    va_list args;
+    va_start(args, fmt);
+    int len = SDL_vsnprintf(NULL, 0, fmt, args);
+    va_end(args);
+    if (len < 0) return NULL;
+
+    char *buf = (char *)forge_ui__arena_alloc(&ctx->arena, (size_t)len + 1);
+    if (!buf) return NULL;
+    va_start(args, fmt);
+    SDL_vsnprintf(buf, (size_t)len + 1, fmt, args);
+    va_end(args);
+    return buf;
+}
+
+static inline void forge_ui_ctx_region_cache_clear(ForgeUiContext *ctx)
+{
+    if (!ctx) return;
+    ForgeUiRegionCache *cache = &ctx->region_cache;
+    for (int i = 0; i < cache->count; i++) {
+        forge_ui__region_free(&cache->regions[i]);
+    }
+    cache->count = 0;
+    cache->_recording = false;
+}
+
+/* Convert this frame's vertices into ctx->packed_vertices, growing the
+ * packed array the same way the draw buffers grow.  Segments are packed
+ * back to back, so each segment's base_vertex indexes the packed array.
+ * On failure the packed count stays 0 so the renderer sees an empty
+ * frame, not a stale one. */
+static inline void forge_ui__ctx_pack_vertices(ForgeUiContext *ctx)
+{
+    ctx->packed_vertex_count = 0;
+    ForgeUiDrawSegment whole;
+    int seg_count, vertex_total;
+    const ForgeUiDrawSegment *segs = forge_ui__ctx_frame_segments(
+        ctx, &whole, &seg_count, &vertex_total);
+    if (vertex_total > ctx->packed_vertex_capacity) {
+        int new_cap = ctx->packed_vertex_capacity;
+        if (new_cap == 0) new_cap = FORGE_UI_CTX_INITIAL_VERTEX_CAPACITY;
+        while (new_cap < vertex_total) {
+            if (new_cap > INT_MAX / 2) {
+                SDL_Log("forge_ui__ctx_pack_vertices: capacity overflow");
+                return;
+            }
+            new_cap *= 2;
+        }
+        ForgeUiPackedVertex *buf = (ForgeUiPackedVertex *)SDL_realloc(
+            ctx->packed_vertices, (size_t)new_cap * sizeof(ForgeUiPackedVertex));
+        if (!buf) {
+            SDL_Log("forge_ui__ctx_pack_vertices: realloc failed "
+                    "(%d vertices)", new_cap);
+            return;
+        }
+        ctx->packed_vertices = buf;
+        ctx->packed_vertex_capacity = new_cap;
+    }
+    for (int s = 0; s < seg_count; s++) {
+        forge_ui_pack_vertices(segs[s].vertices,
+                               &ctx->packed_vertices[segs[s].base_vertex],
+                               segs[s].vertex_count);
+    }
+    ctx->packed_vertex_count = vertex_total;
 }
 
 static inline void forge_ui_ctx_end(ForgeUiContext *ctx)
@@ -1328,6 +3458,8 @@ static inline void forge_ui_ctx_end(ForgeUiContext *ctx)
      * if the cursor slides off during a press. */
     if (ctx->active == FORGE_UI_ID_NONE) {
         ctx->hot = ctx->next_hot;
+        ctx->_hot_mouse_x = ctx->mouse_x;
+        ctx->_hot_mouse_y = ctx->mouse_y;
     }
 
     /* Safety net: if a panel was opened but never closed, clean up the
@@ -1357,6 +3489,18 @@ static inline void forge_ui_ctx_end(ForgeUiContext *ctx)
                 ctx->layout_depth, ctx->layout_depth,
                 ctx->layout_depth == 1 ? "" : "s");
     }
+
+    /* Close the last draw command; drop it if nothing was drawn into it */
+    forge_ui__draw_cmd_finish(ctx);
+
+    /* The draw data is final (windows were assembled or segmented by
+     * wctx_end); convert it if the renderer wants the packed layout */
+    if (ctx->vertex_format == FORGE_UI_VERTEX_FORMAT_PACKED) {
+        forge_ui__ctx_pack_vertices(ctx);
+    }
+
+    /* Compare the final draw data with last frame's, tile by tile */
+    forge_ui__ctx_damage(ctx);
 }
 
 static inline void forge_ui_ctx_label_colored(ForgeUiContext *ctx,
@@ -1375,11 +3519,16 @@ static inline void forge_ui_ctx_label_colored(ForgeUiContext *ctx,
     if (a < 0.0f) a = 0.0f; else if (a > 1.0f) a = 1.0f;
 
     ForgeUiTextOpts opts = { 0.0f, FORGE_UI_TEXT_ALIGN_LEFT, r, g, b, a };
-    ForgeUiTextLayout layout;
-    if (forge_ui_text_layout(ctx->atlas, text, x, y, &opts, &layout)) {
-        forge_ui__emit_text_layout(ctx, &layout);
-        forge_ui_text_layout_free(&layout);
+    const ForgeUiTextRun *run = forge_ui__ctx_text_run(ctx, text, &opts);
+    if (run) {
+        forge_ui__emit_text_run(ctx, run, x, y, r, g, b, a);
+        return;
     }
+
+    /* Uncacheable (table full or out of memory): lay out directly */
+    forge_ui__draw_cmd_sync(ctx);
+    ForgeUiTextSink sink = forge_ui__ctx_text_sink(ctx);
+    forge_ui_text_layout_into(ctx->atlas, text, x, y, &opts, &sink, NULL);
 }
 
 static inline void forge_ui_ctx_label(ForgeUiContext *ctx,
@@ -1475,7 +3624,7 @@ static inline bool forge_ui_ctx_button(ForgeUiContext *ctx,
 
     /* ── Emit centered text label ─────────────────────────────────────── */
     /* Measure text to compute centering offsets */
-    ForgeUiTextMetrics metrics = forge_ui_text_measure(ctx->atlas, disp_buf, NULL);
+    ForgeUiTextMetrics metrics = forge_ui__ctx_text_measure(ctx, disp_buf);
 
     /* Center the text within the button rectangle.
      * Horizontal: offset by half the difference between rect width and text width.
@@ -2130,6 +4279,30 @@ static inline void forge_ui_ctx_label_layout(ForgeUiContext *ctx,
                                        ctx->theme.text.b, ctx->theme.text.a);
 }
 
+static inline void forge_ui_ctx_paragraph_layout(ForgeUiContext *ctx,
+                                                  ForgeUiParagraph *para)
+{
+    if (!ctx || !para || !ctx->atlas || para->atlas != ctx->atlas) return;
+    if (ctx->layout_depth <= 0) return;  /* no active layout — no-op */
+
+    const ForgeUiLayout *layout = &ctx->layout_stack[ctx->layout_depth - 1];
+    bool vertical = layout->direction == FORGE_UI_LAYOUT_VERTICAL;
+    ForgeUiTextOpts opts = { vertical ? layout->remaining_w : 0.0f,
+                             FORGE_UI_TEXT_ALIGN_LEFT,
+                             ctx->theme.text.r, ctx->theme.text.g,
+                             ctx->theme.text.b, ctx->theme.text.a };
+
+    ForgeUiTextMetrics m = forge_ui_paragraph_measure(para, &opts);
+    ForgeUiRect rect = forge_ui_ctx_layout_next(ctx, vertical ? m.height
+                                                              : m.width);
+
+    forge_ui__draw_cmd_sync(ctx);
+    ForgeUiTextSink sink = forge_ui__ctx_text_sink(ctx);
+    forge_ui_paragraph_layout_into(para, rect.x,
+                                   rect.y + forge_ui__ascender_px(ctx->atlas),
+                                   &opts, &sink, NULL);
+}
+
 static inline bool forge_ui_ctx_button_layout(ForgeUiContext *ctx,
                                                const char *text,
                                                float size)
@@ -2244,7 +4417,7 @@ static inline bool forge_ui_ctx_panel_begin(ForgeUiContext *ctx,
         SDL_memcpy(disp_buf, title, (size_t)disp_len);
         disp_buf[disp_len] = '\0';
 
-        ForgeUiTextMetrics m = forge_ui_text_measure(ctx->atlas, disp_buf, NULL);
+        ForgeUiTextMetrics m = forge_ui__ctx_text_measure(ctx, disp_buf);
         float ascender_px = forge_ui__ascender_px(ctx->atlas);
         float tx = rect.x + (rect.w - m.width) * 0.5f;
         float ty = rect.y + (title_bar_h - m.height) * 0.5f
@@ -2369,10 +4542,9 @@ static inline bool forge_ui_ctx_panel_begin(ForgeUiContext *ctx,
     return true;
 }
 
-static inline void forge_ui_ctx_panel_end(ForgeUiContext *ctx)
+/* Body of panel_end (window_end shares it through panel_end). */
+static inline void forge_ui__panel_finish(ForgeUiContext *ctx)
 {
-    if (!ctx || !ctx->_panel_active) return;
-
     /* ── Compute content height from layout cursor advancement ────────── */
     float content_h = 0.0f;
     if (ctx->layout_depth > 0) {
@@ -2488,6 +4660,212 @@ static inline void forge_ui_ctx_panel_end(ForgeUiContext *ctx)
     forge_ui_pop_id(ctx);
 }
 
+static inline void forge_ui_ctx_panel_end(ForgeUiContext *ctx)
+{
+    if (!ctx || !ctx->_panel_active) return;
+
+    /* panel_finish clears _panel.scroll_y; keep it for the recording */
+    const float *scroll_y = ctx->_panel.scroll_y;
+    forge_ui__panel_finish(ctx);
+    forge_ui__region_record_end(ctx, scroll_y);
+}
+
+static inline bool forge_ui_ctx_panel_begin_cached(ForgeUiContext *ctx,
+                                                    const char *title,
+                                                    ForgeUiRect rect,
+                                                    float *scroll_y,
+                                                    Uint32 version)
+{
+    if (!ctx || !ctx->atlas || !title || title[0] == '\0' || !scroll_y)
+        return false;
+
+    /* Nested panels are rejected (and logged) by panel_begin */
+    if (!ctx->_panel_active) {
+        Uint32 id = forge_ui_hash_id(ctx, title);
+        if (forge_ui__region_replay(ctx, id, version, rect, *scroll_y)) {
+            return false;
+        }
+        forge_ui__region_record_begin(ctx, id, version, rect, *scroll_y);
+    }
+
+    if (!forge_ui_ctx_panel_begin(ctx, title, rect, scroll_y)) {
+        /* Leave an enclosing window's recording alone */
+        if (!ctx->_panel_active) ctx->region_cache._recording = false;
+        return false;
+    }
+    return true;
+}
+
+/* ── List clipper implementation ───────────────────────────────────────── */
+
+/* Advance the layout cursor over rows [first, last) without placing them.
+ * Matches what (last - first) layout_next calls with the rows' heights
+ * would do: a spacing gap before every row except the layout's first. */
+static inline void forge_ui__list_skip(ForgeUiLayout *layout,
+                                       const ForgeUiListClipper *clipper,
+                                       int first, int last)
+{
+    if (last <= first) return;
+    int n = last - first;
+    float heights = clipper->offsets
+                  ? clipper->offsets[last] - clipper->offsets[first]
+                  : (float)n * clipper->item_height;
+    float advance = heights + (float)n * layout->spacing;
+    if (layout->item_count == 0) advance -= layout->spacing;
+
+    layout->cursor_y += advance;
+    layout->remaining_h -= advance;
+    if (layout->remaining_h < 0.0f) layout->remaining_h = 0.0f;
+    layout->item_count += n;
+}
+
+/* Shared body of the two begin variants.  Rows are visible when they
+ * overlap the clip rect's vertical span; the horizontal extent is the
+ * layout's full width, so only y matters.  The range errs by at most
+ * one row on the inclusive side (a row whose bottom lies in the spacing
+ * gap above the clip), which the clip rect then discards. */
+static inline bool forge_ui__list_clipper_begin(ForgeUiContext *ctx,
+                                                ForgeUiListClipper *clipper,
+                                                int item_count,
+                                                float item_height,
+                                                const float *offsets)
+{
+    if (!ctx || !clipper) return false;
+    *clipper = (ForgeUiListClipper){0};
+
+    if (item_count < 0) {
+        SDL_Log("forge_ui_ctx_list_clipper_begin: negative item_count (%d)",
+                item_count);
+        return false;
+    }
+    if (ctx->layout_depth <= 0 ||
+        ctx->layout_stack[ctx->layout_depth - 1].direction
+            != FORGE_UI_LAYOUT_VERTICAL) {
+        SDL_Log("forge_ui_ctx_list_clipper_begin: needs an active vertical "
+                "layout");
+        return false;
+    }
+
+    ForgeUiLayout *layout = &ctx->layout_stack[ctx->layout_depth - 1];
+    float spacing = layout->spacing;
+
+    clipper->item_count = item_count;
+    clipper->item_height = offsets ? 0.0f : item_height;
+    clipper->offsets = offsets;
+    clipper->display_start = 0;
+    clipper->display_end = item_count;
+    clipper->_layout_depth = ctx->layout_depth;
+
+    if (ctx->has_clip && item_count > 0) {
+        /* Screen y of row 0: the cursor, plus the gap layout_next adds
+         * before a non-first widget, shifted by the panel's scroll */
+        float top = layout->cursor_y + (layout->item_count > 0 ? spacing : 0.0f);
+        if (ctx->_panel_active && ctx->_panel.scroll_y) {
+            top -= *ctx->_panel.scroll_y;
+        }
+
+        /* Clip span relative to row 0 */
+        float lo = ctx->clip_rect.y - top;
+        float hi = lo + ctx->clip_rect.h;
+        int start, end;
+
+        if (offsets) {
+            /* Prefix sums are relative to offsets[0] */
+            lo += offsets[0];
+            hi += offsets[0];
+            /* First row whose bottom passes lo */
+            int a = 0, b = item_count;
+            while (a < b) {
+                int mid = a + (b - a) / 2;
+                if (offsets[mid + 1] + (float)mid * spacing > lo) b = mid;
+                else a = mid + 1;
+            }
+            start = a;
+            /* First row (at or after start) whose top reaches hi */
+            b = item_count;
+            while (a < b) {
+                int mid = a + (b - a) / 2;
+                if (offsets[mid] + (float)mid * spacing >= hi) b = mid;
+                else a = mid + 1;
+            }
+            end = a;
+        } else {
+            float pitch = item_height + spacing;
+            if (pitch > 0.0f) {
+                /* Clamp in float space before converting so a huge
+                 * scroll offset cannot overflow the int cast */
+                float fs = SDL_floorf(lo / pitch);
+                float fe = SDL_ceilf(hi / pitch);
+                if (!(fs >= 0.0f)) fs = 0.0f;
+                if (fs > (float)item_count) fs = (float)item_count;
+                if (!(fe >= 0.0f)) fe = 0.0f;
+                if (fe > (float)item_count) fe = (float)item_count;
+                start = (int)fs;
+                end = (int)fe;
+            } else {
+                /* Zero-height rows with no spacing never draw anything */
+                start = 0;
+                end = 0;
+            }
+        }
+        if (end < start) end = start;
+        clipper->display_start = start;
+        clipper->display_end = end;
+    }
+
+    forge_ui__list_skip(layout, clipper, 0, clipper->display_start);
+    return true;
+}
+
+static inline bool forge_ui_ctx_list_clipper_begin(ForgeUiContext *ctx,
+                                                   ForgeUiListClipper *clipper,
+                                                   int item_count,
+                                                   float item_height)
+{
+    if (!ctx || !clipper) return false;
+    if (!isfinite(item_height) || item_height < 0.0f) {
+        SDL_Log("forge_ui_ctx_list_clipper_begin: invalid item_height (%g)",
+                (double)item_height);
+        return false;
+    }
+    return forge_ui__list_clipper_begin(ctx, clipper, item_count,
+                                        item_height, NULL);
+}
+
+static inline bool forge_ui_ctx_list_clipper_begin_variable(ForgeUiContext *ctx,
+                                                            ForgeUiListClipper *clipper,
+                                                            int item_count,
+                                                            const float *offsets)
+{
+    if (!ctx || !clipper || !offsets) return false;
+    /* O(1) sanity check; per-row monotonicity is the caller's contract */
+    if (item_count >= 0 &&
+        (!isfinite(offsets[0]) || !isfinite(offsets[item_count]) ||
+         !(offsets[item_count] >= offsets[0]))) {
+        SDL_Log("forge_ui_ctx_list_clipper_begin_variable: offsets are not "
+                "finite ascending prefix sums");
+        return false;
+    }
+    return forge_ui__list_clipper_begin(ctx, clipper, item_count,
+                                        0.0f, offsets);
+}
+
+static inline void forge_ui_ctx_list_clipper_end(ForgeUiContext *ctx,
+                                                 ForgeUiListClipper *clipper)
+{
+    if (!ctx || !clipper) return;
+    if (clipper->_layout_depth <= 0 ||
+        ctx->layout_depth != clipper->_layout_depth) {
+        SDL_Log("forge_ui_ctx_list_clipper_end: layout depth %d does not "
+                "match list_clipper_begin (%d)",
+                ctx->layout_depth, clipper->_layout_depth);
+        return;
+    }
+    forge_ui__list_skip(&ctx->layout_stack[ctx->layout_depth - 1], clipper,
+                        clipper->display_end, clipper->item_count);
+    clipper->_layout_depth = 0;
+}
+
 /* ── Theme setter (declared in forge_ui_theme.h) ───────────────────────── */
 
 /* Return true if a single color has finite components in [0, 1]. */
@@ -0,0 +1,731 @@
+/*
+ * forge_ui_glyph_cache.h -- Header-only dynamic glyph cache for forge-gpu
+ *
+ * forge_ui_atlas_build() rasterizes a fixed codepoint set up front and the
+ * resulting atlas never changes.  That works for ASCII, but not for text
+ * whose character set is unknown ahead of time (chat, file names, CJK).
+ * The glyph cache instead rasterizes each glyph the first time it is
+ * requested, stores it in a fixed-size atlas page, and evicts the least
+ * recently used glyphs when space runs out.
+ *
+ * Key concepts:
+ *   - Pages are square single-channel textures of a fixed size.  A page is
+ *     divided into a uniform grid of cells, each large enough for any glyph
+ *     in the font at the cache's pixel height (sized from the head table
+ *     bounding box).  Uniform cells make eviction trivial: any freed cell
+ *     fits any glyph, so there is no fragmentation to manage.
+ *   - Cell 0 of every page holds a 2x2 white block (white_uv) so solid
+ *     geometry can be drawn with whichever page texture is bound.
+ *   - Glyphs with an empty bitmap (spaces and other whitespace) have no
+ *     texels to store, so they are kept in blank slots outside the page
+ *     grid: they never take a cell and never push a real glyph out.
+ *   - Up to max_pages pages are allocated on demand.  When every allocated
+ *     cell is taken and no page can be added, the least recently used glyph
+ *     is evicted — but never a glyph used in the current frame, because
+ *     vertices already emitted this frame still reference its UVs.
+ *   - Every page tracks dirty rectangles: a new page is dirty in full (the
+ *     renderer must create and upload the texture), and each newly
+ *     rasterized glyph dirties its cell.  After uploading, the renderer
+ *     starts the next frame with forge_ui_glyph_cache_begin_frame(), which
+ *     clears the dirty lists.
+ *
+ * Usage:
+ *   #include "ui/forge_ui.h"
+ *   #include "ui/forge_ui_glyph_cache.h"
+ *
+ *   ForgeUiGlyphCache cache;
+ *   forge_ui_glyph_cache_init(&cache, &font, 24.0f, 1024, 4, 1);
+ *
+ *   // Each frame:
+ *   forge_ui_glyph_cache_begin_frame(&cache);
+ *   const ForgeUiCachedGlyph *g = forge_ui_glyph_cache_get(&cache, 0x4E2D);
+ *   // ... emit a quad with g->glyph.uv, sampling page g->page ...
+ *   for (int p = 0; p < cache.page_count; p++) {
+ *       for (int r = 0; r < cache.pages[p].dirty_count; r++) {
+ *           // upload cache.pages[p].dirty[r] from cache.pages[p].pixels
+ *       }
+ *   }
+ *
+ *   forge_ui_glyph_cache_free(&cache);
+ *
+ * Text layout and ForgeUiContext read glyphs through a ForgeUiFontAtlas.
+ * forge_ui_glyph_cache_bind_atlas() fills in an atlas that looks every
+ * glyph up in a single-page cache, so labels and forge_ui_text_layout()
+ * rasterize on demand:
+ *
+ *   ForgeUiFontAtlas view;
+ *   forge_ui_glyph_cache_init(&cache, &font, 24.0f, 1024, 1, 1);
+ *   forge_ui_glyph_cache_bind_atlas(&cache, &view);
+ *   forge_ui_ctx_init(&ctx, &view);
+ *   // Each frame: forge_ui_glyph_cache_begin_frame, then the UI frame,
+ *   // then upload page 0's dirty rectangles to the texture drawn with.
+ *
+ * SPDX-License-Identifier: Zlib
+ */
+
+#ifndef FORGE_UI_GLYPH_CACHE_H
+#define FORGE_UI_GLYPH_CACHE_H
+
+#include "forge_ui.h"
+
+/* ── Constants ──────────────────────────────────────────────────────────── */
+
+/* Maximum number of atlas pages a cache can own.  Each page is a separate
+ * texture, so a handful is plenty before eviction takes over. */
+#define FORGE_UI_GLYPH_CACHE_MAX_PAGES  8
+
+/* Maximum dirty rectangles tracked per page per frame.  When a page
+ * exceeds this, its rectangles collapse into one bounding rectangle —
+ * still correct, just a larger upload. */
+#define FORGE_UI_GLYPH_CACHE_MAX_DIRTY  32
+
+/* Maximum distinct glyphs with an empty bitmap kept outside the page
+ * grid.  Fonts have a handful of whitespace glyphs; past this limit a
+ * blank glyph takes a cell like any other. */
+#define FORGE_UI_GLYPH_CACHE_MAX_BLANKS 64
+
+/* ── Types ──────────────────────────────────────────────────────────────── */
+
+/* Integer pixel rectangle within a cache page (origin top-left). */
+typedef struct ForgeUiGlyphCacheRect {
+    int x;  /* left edge in pixels */
+    int y;  /* top edge in pixels */
+    int w;  /* width in pixels */
+    int h;  /* height in pixels */
+} ForgeUiGlyphCacheRect;
+
+/* A glyph resident in the cache.  glyph.uv is normalized to the page
+ * texture identified by page.  Whitespace and glyphs that could not be
+ * rasterized have a zero-size bitmap and UVs pointing at the white block,
+ * matching forge_ui_atlas_build(). */
+typedef struct ForgeUiCachedGlyph {
+    ForgeUiPackedGlyph glyph;  /* metrics and UVs within the page */
+    int                page;   /* index into ForgeUiGlyphCache.pages */
+} ForgeUiCachedGlyph;
+
+/* One atlas page: pixel data plus the regions changed this frame. */
+typedef struct ForgeUiGlyphCachePage {
+    Uint8                *pixels;       /* page_size * page_size, single channel */
+    ForgeUiGlyphCacheRect dirty[FORGE_UI_GLYPH_CACHE_MAX_DIRTY];
+    int                   dirty_count;  /* rectangles to upload this frame */
+} ForgeUiGlyphCachePage;
+
+/* Internal per-glyph bookkeeping: one slot per grid cell across all
+ * pages, then FORGE_UI_GLYPH_CACHE_MAX_BLANKS blank slots.  Blank slots
+ * are never on the LRU list, so they are never evicted. */
+typedef struct ForgeUi__GlyphCacheSlot {
+    ForgeUiCachedGlyph entry;      /* public glyph data */
+    Uint64             last_used;  /* frame number of the most recent get */
+    int                lru_prev;   /* more recently used slot (-1 = head) */
+    int                lru_next;   /* less recently used slot (-1 = tail) */
+    int                hash_next;  /* next slot in the same hash bucket */
+    bool               in_use;     /* slot holds a glyph */
+} ForgeUi__GlyphCacheSlot;
+
+/* The glyph cache.  Fields are readable by the caller (pages, page_count,
+ * white_uv, statistics); modify them only through the API. */
+typedef struct ForgeUiGlyphCache {
+    const ForgeUiFont *font;          /* font glyphs are rasterized from */
+    float              pixel_height;  /* rasterization height in pixels */
+    int                padding;       /* empty pixels right/below each glyph */
+
+    /* Page geometry */
+    int page_size;       /* page width and height in pixels */
+    int cell_w;          /* grid cell width in pixels (includes padding) */
+    int cell_h;          /* grid cell height in pixels (includes padding) */
+    int cells_per_row;   /* grid columns per page */
+    int cells_per_page;  /* grid cells per page (cell 0 is the white block) */
+
+    ForgeUiGlyphCachePage pages[FORGE_UI_GLYPH_CACHE_MAX_PAGES];
+    int                   page_count;  /* pages allocated so far */
+    int                   max_pages;   /* page limit set at init */
+    ForgeUiUVRect         white_uv;    /* 2x2 white block, same on every page */
+
+    /* Font metrics for text layout (copied from the font) */
+    Uint16 units_per_em;
+    Sint16 ascender;
+    Sint16 descender;
+    Sint16 line_gap;
+
+    /* Statistics for the current frame (reset by begin_frame) */
+    int frame_hits;       /* lookups served from the cache */
+    int frame_misses;     /* glyphs rasterized */
+    int frame_evictions;  /* glyphs evicted to make room */
+    int blank_count;      /* blank slots in use (glyphs stored without a cell) */
+
+    /* Advanced whenever a glyph returned earlier is evicted or a get
+     * fails, so text laid out before may have stale UVs or missing
+     * glyphs (ForgeUiFontAtlas.lookup_generation points here). */
+    Uint64 generation;
+
+    /* Internal state */
+    ForgeUi__GlyphCacheSlot *slots;       /* cell_slots, then the blank slots */
+    int                      cell_slots;  /* cells_per_page * max_pages */
+    int                     *buckets;     /* hash heads, -1 = empty */
+    Uint32                   bucket_mask; /* bucket count - 1 */
+    int                     *free_cells;  /* stack of unused slot indices */
+    int                      free_count;  /* entries on the free stack */
+    int                      lru_head;    /* most recently used slot */
+    int                      lru_tail;    /* least recently used slot */
+    Uint64                   frame;       /* current frame number */
+} ForgeUiGlyphCache;
+
+/* ── Public API ─────────────────────────────────────────────────────────── */
+
+/* Initialize a glyph cache.
+ *
+ * Parameters:
+ *   cache        — cache to initialize (free with forge_ui_glyph_cache_free)
+ *   font         — loaded font; must outlive the cache
+ *   pixel_height — glyph rendering height in pixels
+ *   page_size    — page width/height: a power of two from 64 to 4096
+ *   max_pages    — page limit (1 to FORGE_UI_GLYPH_CACHE_MAX_PAGES)
+ *   padding      — empty pixels between neighbouring glyphs (0–8)
+ *
+ * No pages are allocated until the first glyph is requested.
+ * Returns true on success, false on error (logged via SDL_Log). */
+static bool forge_ui_glyph_cache_init(ForgeUiGlyphCache *cache,
+                                       const ForgeUiFont *font,
+                                       float pixel_height,
+                                       int page_size,
+                                       int max_pages,
+                                       int padding);
+
+/* Free all pages and bookkeeping.  Safe to call on a zeroed cache. */
+static void forge_ui_glyph_cache_free(ForgeUiGlyphCache *cache);
+
+/* Start a new frame: clears every page's dirty rectangles (call after the
+ * previous frame's uploads) and resets the per-frame statistics.  Glyphs
+ * requested before the next begin_frame are protected from eviction. */
+static void forge_ui_glyph_cache_begin_frame(ForgeUiGlyphCache *cache);
+
+/* Get a glyph, rasterizing it into a page on first use.
+ *
+ * Returns the cached glyph, or NULL if the glyph is not resident and no
+ * cell can be freed (every cell holds a glyph used this frame).  The
+ * pointer stays valid until the glyph is evicted, which cannot happen
+ * before the next forge_ui_glyph_cache_begin_frame().  Glyphs with an
+ * empty bitmap are never evicted. */
+static const ForgeUiCachedGlyph *forge_ui_glyph_cache_get(
+    ForgeUiGlyphCache *cache, Uint32 codepoint);
+
+/* Fill in out_atlas as a view of the cache, so forge_ui_text_layout(),
+ * forge_ui_text_measure(), and ForgeUiContext widgets look glyphs up
+ * through forge_ui_glyph_cache_get() (see ForgeUiFontAtlas.lookup_fn).
+ *
+ * The cache must have max_pages == 1: a vertex carries UVs but no page,
+ * so every glyph must sit in the one texture the atlas describes.  Page 0
+ * is allocated here; out_atlas->pixels points at it.  Kerning comes from
+ * the font's table.  A glyph the cache cannot store this frame is skipped
+ * by layout, like a codepoint missing from a built atlas.
+ *
+ * The view owns nothing: it must not outlive the cache or the font, must
+ * not be passed to forge_ui_atlas_free(), and cannot back a
+ * ForgeUiParagraph.  Returns true on success, false on error (logged via
+ * SDL_Log). */
+static bool forge_ui_glyph_cache_bind_atlas(ForgeUiGlyphCache *cache,
+                                            ForgeUiFontAtlas *out_atlas);
+
+/* ══════════════════════════════════════════════════════════════════════════ */
+/* ── Implementation ────────────────────────────────────────────────────── */
+/* ══════════════════════════════════════════════════════════════════════════ */
+
+#define FORGE_UI__CACHE_MIN_PAGE     64    /* smallest page dimension */
+#define FORGE_UI__CACHE_MAX_PAGE     4096  /* largest page dimension */
+#define FORGE_UI__CACHE_MAX_PADDING  8     /* largest glyph padding */
+#define FORGE_UI__CACHE_WHITE_SIZE   2     /* white block is 2x2 pixels */
+#define FORGE_UI__CACHE_NONE         (-1)  /* null slot / bucket index */
+
+/* Raster supersampling matches forge_ui_atlas_build() so cached glyphs
+ * look identical to prebuilt atlas glyphs. */
+#define FORGE_UI__CACHE_SUPERSAMPLE  4
+
+/* ── Slot geometry ───────────────────────────────────────────────────────── */
+
+static inline int forge_ui__cache_slot_page(const ForgeUiGlyphCache *cache,
+                                            int slot)
+{
+    return slot / cache->cells_per_page;
+}
+
+static inline ForgeUiGlyphCacheRect forge_ui__cache_cell_rect(
+    const ForgeUiGlyphCache *cache, int slot)
+{
+    int cell = slot % cache->cells_per_page;
+    ForgeUiGlyphCacheRect r;
+    r.x = (cell % cache->cells_per_row) * cache->cell_w;
+    r.y = (cell / cache->cells_per_row) * cache->cell_h;
+    r.w = cache->cell_w;
+    r.h = cache->cell_h;
+    return r;
+}
+
+/* ── Dirty rectangles ────────────────────────────────────────────────────── */
+
+static void forge_ui__cache_mark_dirty(ForgeUiGlyphCachePage *page,
+                                       ForgeUiGlyphCacheRect r)
+{
+    if (page->dirty_count < FORGE_UI_GLYPH_CACHE_MAX_DIRTY) {
+        page->dirty[page->dirty_count++] = r;
+        return;
+    }
+
+    /* Out of rectangles — collapse everything into one bounding box */
+    int x0 = r.x, y0 = r.y, x1 = r.x + r.w, y1 = r.y + r.h;
+    for (int i = 0; i < page->dirty_count; i++) {
+        const ForgeUiGlyphCacheRect *d = &page->dirty[i];
+        if (d->x < x0) x0 = d->x;
+        if (d->y < y0) y0 = d->y;
+        if (d->x + d->w > x1) x1 = d->x + d->w;
+        if (d->y + d->h > y1) y1 = d->y + d->h;
+    }
+    page->dirty[0].x = x0;
+    page->dirty[0].y = y0;
+    page->dirty[0].w = x1 - x0;
+    page->dirty[0].h = y1 - y0;
+    page->dirty_count = 1;
+}
+
+/* ── Hash and LRU list ───────────────────────────────────────────────────── */
+
+static inline Uint32 forge_ui__cache_hash(Uint32 codepoint)
+{
+    return codepoint * 2654435761u;  /* Knuth multiplicative hash */
+}
+
+static void forge_ui__cache_lru_unlink(ForgeUiGlyphCache *cache, int slot)
+{
+    ForgeUi__GlyphCacheSlot *s = &cache->slots[slot];
+    if (s->lru_prev != FORGE_UI__CACHE_NONE) {
+        cache->slots[s->lru_prev].lru_next = s->lru_next;
+    } else {
+        cache->lru_head = s->lru_next;
+    }
+    if (s->lru_next != FORGE_UI__CACHE_NONE) {
+        cache->slots[s->lru_next].lru_prev = s->lru_prev;
+    } else {
+        cache->lru_tail = s->lru_prev;
+    }
+    s->lru_prev = FORGE_UI__CACHE_NONE;
+    s->lru_next = FORGE_UI__CACHE_NONE;
+}
+
+static void forge_ui__cache_lru_push_front(ForgeUiGlyphCache *cache, int slot)
+{
+    ForgeUi__GlyphCacheSlot *s = &cache->slots[slot];
+    s->lru_prev = FORGE_UI__CACHE_NONE;
+    s->lru_next = cache->lru_head;
+    if (cache->lru_head != FORGE_UI__CACHE_NONE) {
+        cache->slots[cache->lru_head].lru_prev = slot;
+    } else {
+        cache->lru_tail = slot;
+    }
+    cache->lru_head = slot;
+}
+
+static void forge_ui__cache_hash_remove(ForgeUiGlyphCache *cache, int slot)
+{
+    Uint32 b = forge_ui__cache_hash(cache->slots[slot].entry.glyph.codepoint)
+               & cache->bucket_mask;
+    int *link = &cache->buckets[b];
+    while (*link != FORGE_UI__CACHE_NONE) {
+        if (*link == slot) {
+            *link = cache->slots[slot].hash_next;
+            cache->slots[slot].hash_next = FORGE_UI__CACHE_NONE;
+            return;
+        }
+        link = &cache->slots[*link].hash_next;
+    }
+}
+
+/* ── Cell allocation ─────────────────────────────────────────────────────── */
+
+/* Allocate a new page and push its glyph cells onto the free stack. */
+static bool forge_ui__cache_add_page(ForgeUiGlyphCache *cache)
+{
+    int p = cache->page_count;
+    size_t bytes = (size_t)cache->page_size * (size_t)cache->page_size;
+    Uint8 *pixels = (Uint8 *)SDL_calloc(bytes, 1);
+    if (!pixels) {
+        SDL_Log("forge_ui_glyph_cache_get: allocation failed (page %d)", p);
+        return false;
+    }
+
+    /* Cell 0 holds the white block used for solid geometry */
+    for (int y = 0; y < FORGE_UI__CACHE_WHITE_SIZE; y++) {
+        for (int x = 0; x < FORGE_UI__CACHE_WHITE_SIZE; x++) {
+            pixels[y * cache->page_size + x] = 255;
+        }
+    }
+
+    ForgeUiGlyphCachePage *page = &cache->pages[p];
+    page->pixels = pixels;
+    page->dirty_count = 0;
+
+    /* A new page must be uploaded in full */
+    ForgeUiGlyphCacheRect full = { 0, 0, cache->page_size, cache->page_size };
+    forge_ui__cache_mark_dirty(page, full);
+
+    /* Push cells in reverse so the top-left cells are handed out first */
+    int first = p * cache->cells_per_page;
+    for (int c = cache->cells_per_page - 1; c >= 1; c--) {
+        cache->free_cells[cache->free_count++] = first + c;
+    }
+
+    cache->page_count++;
+    return true;
+}
+
+/* Find a cell for a new glyph: a free cell, then a new page, then the
+ * least recently used glyph not touched this frame. */
+static int forge_ui__cache_acquire_slot(ForgeUiGlyphCache *cache)
+{
+    if (cache->free_count == 0 && cache->page_count < cache->max_pages) {
+        if (!forge_ui__cache_add_page(cache)) {
+            return FORGE_UI__CACHE_NONE;
+        }
+    }
+    if (cache->free_count > 0) {
+        return cache->free_cells[--cache->free_count];
+    }
+
+    /* The LRU tail is the least recently used glyph; if even that one was
+     * used this frame, every glyph was and nothing may be evicted. */
+    int victim = cache->lru_tail;
+    if (victim == FORGE_UI__CACHE_NONE ||
+        cache->slots[victim].last_used == cache->frame) {
+        return FORGE_UI__CACHE_NONE;
+    }
+
+    forge_ui__cache_lru_unlink(cache, victim);
+    forge_ui__cache_hash_remove(cache, victim);
+    cache->slots[victim].in_use = false;
+    cache->frame_evictions++;
+    cache->generation++;
+    return victim;
+}
+
+/* Rasterize a glyph at the cache's size.  A glyph that fails to
+ * rasterize or does not fit a cell comes back as an empty bitmap. */
+static Uint16 forge_ui__cache_rasterize(const ForgeUiGlyphCache *cache,
+                                        Uint32 codepoint,
+                                        ForgeUiGlyphBitmap *bmp)
+{
+    const ForgeUiFont *font = cache->font;
+    Uint16 glyph_index = forge_ui_ttf_glyph_index(font, codepoint);
+
+    ForgeUiRasterOpts opts;
+    SDL_memset(&opts, 0, sizeof(opts));
+    opts.supersample_level = FORGE_UI__CACHE_SUPERSAMPLE;
+    opts.method = FORGE_UI_RASTER_ACTIVE_EDGE;
+    if (!forge_ui_rasterize_glyph(font, glyph_index, cache->pixel_height,
+                                  &opts, bmp)) {
+        /* Compound or malformed glyph: cache it as blank so the pen still
+         * advances and the failure is logged once, not every frame. */
+        SDL_memset(bmp, 0, sizeof(*bmp));
+    }
+    if (bmp->width > cache->cell_w - cache->padding ||
+        bmp->height > cache->cell_h - cache->padding) {
+        SDL_Log("forge_ui_glyph_cache_get: codepoint U+%04X (%dx%d) exceeds "
+                "the cell size (%dx%d); caching as blank", codepoint,
+                bmp->width, bmp->height, cache->cell_w, cache->cell_h);
+        forge_ui_glyph_bitmap_free(bmp);
+        SDL_memset(bmp, 0, sizeof(*bmp));
+    }
+    return glyph_index;
+}
+
+/* Store a rasterized glyph in a slot: copy the bitmap into the slot's
+ * cell (blank slots have none) and fill in its metadata. */
+static void forge_ui__cache_fill_slot(ForgeUiGlyphCache *cache, int slot,
+                                      Uint32 codepoint, Uint16 glyph_index,
+                                      const ForgeUiGlyphBitmap *bmp)
+{
+    ForgeUi__GlyphCacheSlot *s = &cache->slots[slot];
+    ForgeUiGlyphCacheRect cell = { 0, 0, 0, 0 };
+    int page_idx = 0;
+    if (slot < cache->cell_slots) {
+        page_idx = forge_ui__cache_slot_page(cache, slot);
+        ForgeUiGlyphCachePage *page = &cache->pages[page_idx];
+        cell = forge_ui__cache_cell_rect(cache, slot);
+
+        /* Clear the whole cell (it may hold an evicted glyph), then copy */
+        for (int y = 0; y < cell.h; y++) {
+            Uint8 *row = page->pixels
+                         + (size_t)(cell.y + y) * cache->page_size + cell.x;
+            SDL_memset(row, 0, (size_t)cell.w);
+            if (y < bmp->height) {
+                SDL_memcpy(row, bmp->pixels + (size_t)y * bmp->width,
+                           (size_t)bmp->width);
+            }
+        }
+        forge_ui__cache_mark_dirty(page, cell);
+    }
+
+    float inv = 1.0f / (float)cache->page_size;
+    ForgeUiPackedGlyph *pg = &s->entry.glyph;
+    pg->codepoint     = codepoint;
+    pg->glyph_index   = glyph_index;
+    pg->bitmap_w      = bmp->width;
+    pg->bitmap_h      = bmp->height;
+    pg->bearing_x     = bmp->bearing_x;
+    pg->bearing_y     = bmp->bearing_y;
+    pg->advance_width = forge_ui_ttf_advance_width(cache->font, glyph_index);
+    if (bmp->width > 0 && bmp->height > 0) {
+        pg->uv.u0 = (float)cell.x * inv;
+        pg->uv.v0 = (float)cell.y * inv;
+        pg->uv.u1 = (float)(cell.x + bmp->width) * inv;
+        pg->uv.v1 = (float)(cell.y + bmp->height) * inv;
+    } else {
+        /* Whitespace — point UVs at one texel of the white block */
+        pg->uv.u0 = 0.0f;
+        pg->uv.v0 = 0.0f;
+        pg->uv.u1 = inv;
+        pg->uv.v1 = inv;
+    }
+    s->entry.page = page_idx;
+}
+
+/* ForgeUiFontAtlas.lookup_fn for a view made by
+ * forge_ui_glyph_cache_bind_atlas(). */
+static const ForgeUiPackedGlyph *forge_ui__cache_atlas_lookup(void *data,
+                                                              Uint32 codepoint)
+{
+    const ForgeUiCachedGlyph *g =
+        forge_ui_glyph_cache_get((ForgeUiGlyphCache *)data, codepoint);
+    return g ? &g->glyph : NULL;
+}
+
+/* ── Public API implementation ───────────────────────────────────────────── */
+
+static bool forge_ui_glyph_cache_init(ForgeUiGlyphCache *cache,
+                                       const ForgeUiFont *font,
+                                       float pixel_height,
+                                       int page_size,
+                                       int max_pages,
+                                       int padding)
+{
+    if (!cache) {
+        SDL_Log("forge_ui_glyph_cache_init: cache is NULL");
+        return false;
+    }
+    SDL_memset(cache, 0, sizeof(*cache));
+
+    if (!font || font->head.units_per_em == 0) {
+        SDL_Log("forge_ui_glyph_cache_init: font is NULL or invalid");
+        return false;
+    }
+    if (!(pixel_height > 0.0f) || pixel_height > (float)FORGE_UI__CACHE_MAX_PAGE) {
+        SDL_Log("forge_ui_glyph_cache_init: invalid pixel_height %f",
+                (double)pixel_height);
+        return false;
+    }
+    if (page_size < FORGE_UI__CACHE_MIN_PAGE ||
+        page_size > FORGE_UI__CACHE_MAX_PAGE ||
+        (page_size & (page_size - 1)) != 0) {
+        SDL_Log("forge_ui_glyph_cache_init: page_size %d must be a power of "
+                "two in [%d, %d]", page_size, FORGE_UI__CACHE_MIN_PAGE,
+                FORGE_UI__CACHE_MAX_PAGE);
+        return false;
+    }
+    if (max_pages < 1 || max_pages > FORGE_UI_GLYPH_CACHE_MAX_PAGES) {
+        SDL_Log("forge_ui_glyph_cache_init: max_pages %d must be in [1, %d]",
+                max_pages, FORGE_UI_GLYPH_CACHE_MAX_PAGES);
+        return false;
+    }
+    if (padding < 0 || padding > FORGE_UI__CACHE_MAX_PADDING) {
+        SDL_Log("forge_ui_glyph_cache_init: padding %d must be in [0, %d]",
+                padding, FORGE_UI__CACHE_MAX_PADDING);
+        return false;
+    }
+
+    /* Size cells from the font-wide bounding box so every glyph fits.
+     * The rasterizer adds FORGE_UI__BITMAP_PAD on each side. */
+    float scale = pixel_height / (float)font->head.units_per_em;
+    int bbox_w = font->head.x_max - font->head.x_min;
+    int bbox_h = font->head.y_max - font->head.y_min;
+    int cell_w = (int)SDL_ceilf((float)bbox_w * scale)
+                 + 2 * FORGE_UI__BITMAP_PAD + padding;
+    int cell_h = (int)SDL_ceilf((float)bbox_h * scale)
+                 + 2 * FORGE_UI__BITMAP_PAD + padding;
+    if (cell_w < FORGE_UI__CACHE_WHITE_SIZE) cell_w = FORGE_UI__CACHE_WHITE_SIZE;
+    if (cell_h < FORGE_UI__CACHE_WHITE_SIZE) cell_h = FORGE_UI__CACHE_WHITE_SIZE;
+
+    int cells_per_row = page_size / cell_w;
+    int cells_per_col = page_size / cell_h;
+    if (cells_per_row * cells_per_col < 2) {
+        SDL_Log("forge_ui_glyph_cache_init: %dx%d page cannot hold a %dx%d "
+                "glyph cell", page_size, page_size, cell_w, cell_h);
+        return false;
+    }
+
+    cache->font           = font;
+    cache->pixel_height   = pixel_height;
+    cache->padding        = padding;
+    cache->page_size      = page_size;
+    cache->cell_w         = cell_w;
+    cache->cell_h         = cell_h;
+    cache->cells_per_row  = cells_per_row;
+    cache->cells_per_page = cells_per_row * cells_per_col;
+    cache->max_pages      = max_pages;
+    cache->units_per_em   = font->head.units_per_em;
+    cache->ascender       = font->hhea.ascender;
+    cache->descender      = font->hhea.descender;
+    cache->line_gap       = font->hhea.line_gap;
+    cache->lru_head       = FORGE_UI__CACHE_NONE;
+    cache->lru_tail       = FORGE_UI__CACHE_NONE;
+    cache->frame          = 1;  /* slots start at last_used 0 */
+
+    float inv = 1.0f / (float)page_size;
+    cache->white_uv.u0 = 0.0f;
+    cache->white_uv.v0 = 0.0f;
+    cache->white_uv.u1 = (float)FORGE_UI__CACHE_WHITE_SIZE * inv;
+    cache->white_uv.v1 = (float)FORGE_UI__CACHE_WHITE_SIZE * inv;
+
+    cache->cell_slots = cache->cells_per_page * max_pages;
+    int slot_count = cache->cell_slots + FORGE_UI_GLYPH_CACHE_MAX_BLANKS;
+    Uint32 bucket_count = 1;
+    while (bucket_count < (Uint32)slot_count) {
+        bucket_count <<= 1;
+    }
+
+    cache->slots = (ForgeUi__GlyphCacheSlot *)SDL_calloc(
+        (size_t)slot_count, sizeof(ForgeUi__GlyphCacheSlot));
+    cache->free_cells = (int *)SDL_malloc((size_t)cache->cell_slots
+                                          * sizeof(int));
+    cache->buckets = (int *)SDL_malloc((size_t)bucket_count * sizeof(int));
+    if (!cache->slots || !cache->free_cells || !cache->buckets) {
+        SDL_Log("forge_ui_glyph_cache_init: allocation failed");
+        forge_ui_glyph_cache_free(cache);
+        return false;
+    }
+    for (Uint32 i = 0; i < bucket_count; i++) {
+        cache->buckets[i] = FORGE_UI__CACHE_NONE;
+    }
+    for (int i = 0; i < slot_count; i++) {
+        cache->slots[i].lru_prev  = FORGE_UI__CACHE_NONE;
+        cache->slots[i].lru_next  = FORGE_UI__CACHE_NONE;
+        cache->slots[i].hash_next = FORGE_UI__CACHE_NONE;
+    }
+    cache->bucket_mask = bucket_count - 1;
+
+    return true;
+}
+
+static void forge_ui_glyph_cache_free(ForgeUiGlyphCache *cache)
+{
+    if (!cache) return;
+    for (int p = 0; p < cache->page_count; p++) {
+        SDL_free(cache->pages[p].pixels);
+    }
+    SDL_free(cache->slots);
+    SDL_free(cache->free_cells);
+    SDL_free(cache->buckets);
+    SDL_memset(cache, 0, sizeof(*cache));
+}
+
+static void forge_ui_glyph_cache_begin_frame(ForgeUiGlyphCache *cache)
+{
+    if (!cache) return;
+    for (int p = 0; p < cache->page_count; p++) {
+        cache->pages[p].dirty_count = 0;
+    }
+    cache->frame_hits      = 0;
+    cache->frame_misses    = 0;
+    cache->frame_evictions = 0;
+    cache->frame++;
+}
+
+static const ForgeUiCachedGlyph *forge_ui_glyph_cache_get(
+    ForgeUiGlyphCache *cache, Uint32 codepoint)
+{
+    if (!cache || !cache->slots) return NULL;
+
+    /* Hit: refresh recency and return */
+    Uint32 b = forge_ui__cache_hash(codepoint) & cache->bucket_mask;
+    for (int i = cache->buckets[b]; i != FORGE_UI__CACHE_NONE;
+         i = cache->slots[i].hash_next) {
+        ForgeUi__GlyphCacheSlot *s = &cache->slots[i];
+        if (s->entry.glyph.codepoint == codepoint) {
+            s->last_used = cache->frame;
+            if (i < cache->cell_slots && cache->lru_head != i) {
+                forge_ui__cache_lru_unlink(cache, i);
+                forge_ui__cache_lru_push_front(cache, i);
+            }
+            cache->frame_hits++;
+            return &s->entry;
+        }
+    }
+
+    /* Miss: rasterize, then find a slot.  An empty bitmap has no texels,
+     * so it goes in a blank slot instead of taking a cell -- and possibly
+     * evicting a real glyph.  Page 0 still exists so its UVs (the white
+     * block) name a real texel. */
+    ForgeUiGlyphBitmap bmp;
+    Uint16 glyph_index = forge_ui__cache_rasterize(cache, codepoint, &bmp);
+    int slot;
+    if ((bmp.width <= 0 || bmp.height <= 0) &&
+        cache->blank_count < FORGE_UI_GLYPH_CACHE_MAX_BLANKS &&
+        (cache->page_count > 0 || forge_ui__cache_add_page(cache))) {
+        slot = cache->cell_slots + cache->blank_count++;
+    } else {
+        slot = forge_ui__cache_acquire_slot(cache);
+    }
+    if (slot == FORGE_UI__CACHE_NONE) {
+        forge_ui_glyph_bitmap_free(&bmp);
+        cache->generation++;
+        return NULL;
+    }
+
+    forge_ui__cache_fill_slot(cache, slot, codepoint, glyph_index, &bmp);
+    forge_ui_glyph_bitmap_free(&bmp);
+
+    ForgeUi__GlyphCacheSlot *s = &cache->slots[slot];
+    s->in_use    = true;
+    s->last_used = cache->frame;
+    s->hash_next = cache->buckets[b];
+    cache->buckets[b] = slot;
+    if (slot < cache->cell_slots) {
+        forge_ui__cache_lru_push_front(cache, slot);
+    }
+    cache->frame_misses++;
+    return &s->entry;
+}
+
+static bool forge_ui_glyph_cache_bind_atlas(ForgeUiGlyphCache *cache,
+                                            ForgeUiFontAtlas *out_atlas)
+{
+    if (!cache || !cache->slots || !out_atlas) {
+        SDL_Log("forge_ui_glyph_cache_bind_atlas: NULL or uninitialized "
+                "parameter");
+        return false;
+    }
+    if (cache->max_pages != 1) {
+        SDL_Log("forge_ui_glyph_cache_bind_atlas: max_pages is %d; an atlas "
+                "view needs a single-page cache", cache->max_pages);
+        return false;
+    }
+    if (cache->page_count == 0 && !forge_ui__cache_add_page(cache)) {
+        return false;
+    }
+
+    SDL_memset(out_atlas, 0, sizeof(*out_atlas));
+    out_atlas->pixels              = cache->pages[0].pixels;
+    out_atlas->width               = cache->page_size;
+    out_atlas->height              = cache->page_size;
+    out_atlas->white_uv            = cache->white_uv;
+    out_atlas->pixel_height        = cache->pixel_height;
+    out_atlas->units_per_em        = cache->units_per_em;
+    out_atlas->ascender            = cache->ascender;
+    out_atlas->descender           = cache->descender;
+    out_atlas->line_gap            = cache->line_gap;
+    out_atlas->mode                = FORGE_UI_ATLAS_COVERAGE;
+    out_atlas->raster_pixel_height = cache->pixel_height;
+    out_atlas->kern                = cache->font->kern;  /* shared, not owned */
+    out_atlas->lookup_fn           = forge_ui__cache_atlas_lookup;
+    out_atlas->lookup_data         = cache;
+    out_atlas->lookup_generation   = &cache->generation;
+    return true;
+}
+
+#endif /* FORGE_UI_GLYPH_CACHE_H */
@@ -17,7 +17,9 @@
  *     a separate draw list (vertex/index buffers) for deferred rendering.
  *   - Windows draw back-to-front: each window's vertices/indices are emitted
  *     into a per-window draw list during declaration, then
- *     forge_ui_wctx_end() sorts by z_order and appends to the main buffers.
+ *     forge_ui_wctx_end() sorts by z_order and appends to the main buffers
+ *     (or, in FORGE_UI_WINDOW_COMPOSE_SEGMENTS mode, hands the lists out
+ *     as-is in wctx.segments for base-vertex draws).
  *   - Input routing respects z-order: only the topmost window under the
  *     mouse cursor receives mouse interaction.
  *   - The collapse toggle is a small triangle indicator in the title bar:
@@ -110,6 +112,26 @@ typedef struct ForgeUiWindowState {
     int         z_order;    /* draw priority (higher = on top) */
 } ForgeUiWindowState;
 
+/* How forge_ui_wctx_end hands out the frame's draw data.
+ *
+ * COMPACT (default): every window's vertices and indices are copied onto
+ *   the end of the main context buffers, so ctx.vertices / ctx.indices
+ *   hold the whole frame.  wctx.segments then holds one segment covering
+ *   those buffers.
+ *
+ * SEGMENTS: nothing is copied.  wctx.segments lists the main buffers
+ *   (widgets outside any window) followed by each window's own draw list
+ *   in z order.  Indices in a segment are zero-based; upload the segments
+ *   back to back and draw each with base_vertex as the vertex offset (and
+ *   first_index as the index offset).  ctx.vertices holds only the
+ *   widgets outside windows; with FORGE_UI_VERTEX_FORMAT_PACKED,
+ *   ctx.packed_vertices holds every segment back to back, so base_vertex
+ *   indexes it directly. */
+typedef enum ForgeUiWindowComposeMode {
+    FORGE_UI_WINDOW_COMPOSE_COMPACT  = 0,
+    FORGE_UI_WINDOW_COMPOSE_SEGMENTS = 1
+} ForgeUiWindowComposeMode;
+
 /* Per-window draw list entry.  Each window gets its own vertex/index
  * buffers during the declaration phase.  forge_ui_wctx_end() sorts
  * these by z_order and appends to the main context buffers in
@@ -125,6 +147,13 @@ typedef struct ForgeUiWindowEntry {
     Uint32              *indices;          /* heap-allocated index array for this window */
     int                  index_count;      /* number of indices emitted so far */
     int                  index_capacity;   /* current allocation size (grows dynamically) */
+
+    /* Per-window draw commands (only filled when the context has draw
+     * commands enabled).  Offsets are relative to this window's indices
+     * until forge_ui_wctx_end rebases them into the main list. */
+    ForgeUiDrawCmd      *draw_cmds;
+    int                  draw_cmd_count;
+    int                  draw_cmd_capacity;
 } ForgeUiWindowEntry;
 
 /* Window context that wraps a ForgeUiContext with window management.
@@ -179,6 +208,16 @@ typedef struct ForgeUiWindowContext {
     Uint32              *saved_indices;
     int                  saved_index_count;
     int                  saved_index_capacity;
+    ForgeUiDrawCmd      *saved_draw_cmds;
+    int                  saved_draw_cmd_count;
+    int                  saved_draw_cmd_capacity;
+
+    /* Frame output written by forge_ui_wctx_end (see
+     * ForgeUiWindowComposeMode).  Set the mode with
+     * forge_ui_wctx_set_compose_mode. */
+    ForgeUiWindowComposeMode compose_mode;
+    ForgeUiDrawSegment       segments[FORGE_UI_WINDOW_MAX + 1];
+    int                      segment_count;
 } ForgeUiWindowContext;
 
 /* ── Public API ─────────────────────────────────────────────────────────── */
@@ -200,9 +239,18 @@ static inline void forge_ui_wctx_begin(ForgeUiWindowContext *wctx);
 
 /* End the frame.  Sorts window draw lists by z_order and appends
  * them to the main context's vertex/index buffers in back-to-front
- * order.  Must be called before forge_ui_ctx_end(). */
+ * order, along with their draw commands when those are enabled, then
+ * fills wctx->segments.  In FORGE_UI_WINDOW_COMPOSE_SEGMENTS mode the
+ * lists are not copied; segments reference them directly.
+ * Must be called before forge_ui_ctx_end(). */
 static inline void forge_ui_wctx_end(ForgeUiWindowContext *wctx);
 
+/* Choose how forge_ui_wctx_end hands out draw data (see
+ * ForgeUiWindowComposeMode).  Returns false if wctx is NULL or the mode is
+ * unknown. */
+static inline bool forge_ui_wctx_set_compose_mode(ForgeUiWindowContext *wctx,
+                                                  ForgeUiWindowComposeMode mode);
+
 /* Begin a window: draw title bar with collapse toggle, process
  * dragging and z-ordering, and if not collapsed set up clipping
  * and layout for child widgets.
@@ -219,6 +267,17 @@ static inline bool forge_ui_wctx_window_begin(ForgeUiWindowContext *wctx,
                                                 const char *title,
                                                 ForgeUiWindowState *state);
 
+/* Cached window: window_begin plus a caller-maintained content `version`
+ * (see forge_ui_ctx_panel_begin_cached).  When the window's last recorded
+ * draw list still matches and no input can reach the window, the list is
+ * replayed (translated if the window moved) and false is returned: the
+ * caller skips its widgets and must NOT call window_end.  Collapsed
+ * windows are never cached; they return false as usual. */
+static inline bool forge_ui_wctx_window_begin_cached(ForgeUiWindowContext *wctx,
+                                                       const char *title,
+                                                       ForgeUiWindowState *state,
+                                                       Uint32 version);
+
 /* End a window: compute content height, draw scrollbar if needed,
  * pop layout, clear clip rect, and restore the main context buffers.
  * If the window was collapsed, window_begin returned false and
@@ -287,6 +346,7 @@ static inline void forge_ui_win__emit_triangle(ForgeUiContext *ctx,
     if (!ctx || !ctx->atlas) return;
     if (!forge_ui__grow_vertices(ctx, 3)) return;
     if (!forge_ui__grow_indices(ctx, 3)) return;
+    forge_ui__draw_cmd_sync(ctx);
 
     const ForgeUiUVRect *wuv = &ctx->atlas->white_uv;
     float u = (wuv->u0 + wuv->u1) * 0.5f;
@@ -307,6 +367,33 @@ static inline void forge_ui_win__emit_triangle(ForgeUiContext *ctx,
     ctx->index_count += 3;
 }
 
+/* Append a window's draw command to the main list.  Empty commands are
+ * skipped, and a command that continues the previous one (same clip and
+ * texture, adjacent index range) extends it instead, so e.g. the
+ * unclipped title bar of a window merges with whatever preceded it. */
+static inline void forge_ui_win__append_draw_cmd(ForgeUiContext *ctx,
+                                                  const ForgeUiDrawCmd *cmd)
+{
+    if (cmd->index_count == 0) return;
+    if (ctx->draw_cmd_count > 0) {
+        ForgeUiDrawCmd *prev = &ctx->draw_cmds[ctx->draw_cmd_count - 1];
+        if (prev->index_count == 0) {
+            ctx->draw_cmd_count--;
+        } else if (prev->index_offset + prev->index_count == cmd->index_offset &&
+                   prev->has_clip == cmd->has_clip &&
+                   prev->texture_id == cmd->texture_id &&
+                   (!cmd->has_clip ||
+                    (prev->clip_rect.x == cmd->clip_rect.x &&
+                     prev->clip_rect.y == cmd->clip_rect.y &&
+                     prev->clip_rect.w == cmd->clip_rect.w &&
+                     prev->clip_rect.h == cmd->clip_rect.h))) {
+            prev->index_count += cmd->index_count;
+            return;
+        }
+    }
+    ctx->draw_cmds[ctx->draw_cmd_count++] = *cmd;
+}
+
 /* ── Implementation ─────────────────────────────────────────────────────── */
 
 static inline bool forge_ui_wctx_init(ForgeUiWindowContext *wctx,
@@ -334,6 +421,9 @@ static inline void forge_ui_win__restore_from_window(
 
     ForgeUiWindowEntry *entry = &wctx->window_entries[idx];
 
+    /* Close the window's open draw command so its index_count is final */
+    forge_ui__draw_cmd_finish(ctx);
+
     /* Save the window's final buffer state back to its entry.  Widget
      * emit calls may have reallocated the buffers (growing capacity),
      * so the entry's pointers and counts must reflect the current ctx
@@ -344,6 +434,9 @@ static inline void forge_ui_win__restore_from_window(
     entry->indices = ctx->indices;
     entry->index_count = ctx->index_count;
     entry->index_capacity = ctx->index_capacity;
+    entry->draw_cmds = ctx->draw_cmds;
+    entry->draw_cmd_count = ctx->draw_cmd_count;
+    entry->draw_cmd_capacity = ctx->draw_cmd_capacity;
 
     /* Restore main context's buffers */
     ctx->vertices = wctx->saved_vertices;
@@ -352,6 +445,9 @@ static inline void forge_ui_win__restore_from_window(
     ctx->indices = wctx->saved_indices;
     ctx->index_count = wctx->saved_index_count;
     ctx->index_capacity = wctx->saved_index_capacity;
+    ctx->draw_cmds = wctx->saved_draw_cmds;
+    ctx->draw_cmd_count = wctx->saved_draw_cmd_count;
+    ctx->draw_cmd_capacity = wctx->saved_draw_cmd_capacity;
 
     wctx->active_window_idx = -1;
 }
@@ -373,8 +469,12 @@ static inline void forge_ui_wctx_free(ForgeUiWindowContext *wctx)
     for (int i = 0; i < FORGE_UI_WINDOW_MAX; i++) {
         SDL_free(wctx->window_entries[i].vertices);
         SDL_free(wctx->window_entries[i].indices);
+        SDL_free(wctx->window_entries[i].draw_cmds);
         wctx->window_entries[i].vertices = NULL;
         wctx->window_entries[i].indices = NULL;
+        wctx->window_entries[i].draw_cmds = NULL;
+        wctx->window_entries[i].draw_cmd_count = 0;
+        wctx->window_entries[i].draw_cmd_capacity = 0;
         wctx->window_entries[i].vertex_count = 0;
         wctx->window_entries[i].vertex_capacity = 0;
         wctx->window_entries[i].index_count = 0;
@@ -391,6 +491,10 @@ static inline void forge_ui_wctx_free(ForgeUiWindowContext *wctx)
     wctx->saved_vertex_capacity = 0;
     wctx->saved_index_count = 0;
     wctx->saved_index_capacity = 0;
+    wctx->saved_draw_cmds = NULL;
+    wctx->saved_draw_cmd_count = 0;
+    wctx->saved_draw_cmd_capacity = 0;
+    wctx->segment_count = 0;
     wctx->ctx = NULL;
 }
 
@@ -461,11 +565,13 @@ static inline void forge_ui_wctx_begin(ForgeUiWindowContext *wctx)
     for (int i = 0; i < wctx->window_count; i++) {
         wctx->window_entries[i].vertex_count = 0;
         wctx->window_entries[i].index_count = 0;
+        wctx->window_entries[i].draw_cmd_count = 0;
         wctx->window_entries[i].id = FORGE_UI_ID_NONE;
         wctx->window_entries[i].state = NULL;
     }
     wctx->window_count = 0;
     wctx->active_window_idx = -1;
+    wctx->segment_count = 0;
 }
 
 /* Sort comparison for window entries by z_order (ascending = back to front) */
@@ -497,6 +603,47 @@ static inline void forge_ui_wctx_end(ForgeUiWindowContext *wctx)
     /* ── Sort window entries by z_order (ascending = back to front) ────── */
     forge_ui_win__sort_entries(wctx->window_entries, wctx->window_count);
 
+    /* The main list's open draw command is closed first so window
+     * commands (or segments) follow it. */
+    forge_ui__draw_cmd_finish(ctx);
+
+    /* ── Segments: hand out the per-window lists without copying ───────── */
+    if (wctx->compose_mode == FORGE_UI_WINDOW_COMPOSE_SEGMENTS) {
+        int base_vertex = 0, first_index = 0;
+        wctx->segment_count = 0;
+        for (int w = -1; w < wctx->window_count; w++) {
+            ForgeUiDrawSegment *seg = &wctx->segments[wctx->segment_count];
+            if (w < 0) {
+                /* Widgets outside any window draw behind all windows */
+                seg->vertices       = ctx->vertices;
+                seg->vertex_count   = ctx->vertex_count;
+                seg->indices        = ctx->indices;
+                seg->index_count    = ctx->index_count;
+                seg->draw_cmds      = ctx->draw_cmds;
+                seg->draw_cmd_count = ctx->draw_cmd_count;
+            } else {
+                const ForgeUiWindowEntry *entry = &wctx->window_entries[w];
+                seg->vertices       = entry->vertices;
+                seg->vertex_count   = entry->vertex_count;
+                seg->indices        = entry->indices;
+                seg->index_count    = entry->index_count;
+                seg->draw_cmds      = entry->draw_cmds;
+                seg->draw_cmd_count = ctx->draw_cmds_enabled
+                                    ? entry->draw_cmd_count : 0;
+            }
+            if (seg->vertex_count == 0 || seg->index_count == 0) continue;
+            seg->base_vertex = base_vertex;
+            seg->first_index = first_index;
+            base_vertex += seg->vertex_count;
+            first_index += seg->index_count;
+            wctx->segment_count++;
+        }
+        /* ctx_end reads the frame through the segments (damage) */
+        ctx->_segments = wctx->segments;
+        ctx->_segment_count = wctx->segment_count;
+        return;
+    }
+
     /* ── Append per-window draw lists to main context in z-order ────────── */
     /* Non-window widgets (labels, buttons drawn outside any window) are
      * already in the main context's buffers and are drawn behind all
@@ -515,9 +662,25 @@ static inline void forge_ui_wctx_end(ForgeUiWindowContext *wctx)
                     "window %u", (unsigned)entry->id);
             continue;
         }
+        if (ctx->draw_cmds_enabled &&
+            !forge_ui__grow_draw_cmds(ctx, entry->draw_cmd_count)) {
+            SDL_Log("forge_ui_wctx_end: draw command grow failed for "
+                    "window %u", (unsigned)entry->id);
+            continue;
+        }
 
         Uint32 base = (Uint32)ctx->vertex_count;
 
+        /* Copy draw commands, moving their index ranges past what the
+         * main list already holds */
+        if (ctx->draw_cmds_enabled) {
+            for (int c = 0; c < entry->draw_cmd_count; c++) {
+                ForgeUiDrawCmd cmd = entry->draw_cmds[c];
+                cmd.index_offset += ctx->index_count;
+                forge_ui_win__append_draw_cmd(ctx, &cmd);
+            }
+        }
+
         /* Copy vertices */
         SDL_memcpy(&ctx->vertices[ctx->vertex_count],
                    entry->vertices,
@@ -525,11 +688,38 @@ static inline void forge_ui_wctx_end(ForgeUiWindowContext *wctx)
         ctx->vertex_count += entry->vertex_count;
 
         /* Copy indices with rebase */
-        for (int i = 0; i < entry->index_count; i++) {
-            ctx->indices[ctx->index_count + i] = entry->indices[i] + base;
-        }
+        forge_ui__rebase_indices(&ctx->indices[ctx->index_count],
+                                 entry->indices, entry->index_count, base);
         ctx->index_count += entry->index_count;
     }
+
+    /* The main buffers now hold the whole frame: one segment */
+    wctx->segment_count = 0;
+    if (ctx->vertex_count > 0 && ctx->index_count > 0) {
+        ForgeUiDrawSegment *seg = &wctx->segments[0];
+        seg->vertices       = ctx->vertices;
+        seg->vertex_count   = ctx->vertex_count;
+        seg->indices        = ctx->indices;
+        seg->index_count    = ctx->index_count;
+        seg->base_vertex    = 0;
+        seg->first_index    = 0;
+        seg->draw_cmds      = ctx->draw_cmds;
+        seg->draw_cmd_count = ctx->draw_cmd_count;
+        wctx->segment_count = 1;
+    }
+}
+
+static inline bool forge_ui_wctx_set_compose_mode(ForgeUiWindowContext *wctx,
+                                                  ForgeUiWindowComposeMode mode)
+{
+    if (!wctx) return false;
+    if (mode != FORGE_UI_WINDOW_COMPOSE_COMPACT &&
+        mode != FORGE_UI_WINDOW_COMPOSE_SEGMENTS) {
+        SDL_Log("forge_ui_wctx_set_compose_mode: unknown mode %d", (int)mode);
+        return false;
+    }
+    wctx->compose_mode = mode;
+    return true;
 }
 
 /* Switch the context's vertex/index buffers to a per-window draw list */
@@ -546,6 +736,10 @@ static inline void forge_ui_win__redirect_to_window(
     wctx->saved_indices = ctx->indices;
     wctx->saved_index_count = ctx->index_count;
     wctx->saved_index_capacity = ctx->index_capacity;
+    forge_ui__draw_cmd_close(ctx);
+    wctx->saved_draw_cmds = ctx->draw_cmds;
+    wctx->saved_draw_cmd_count = ctx->draw_cmd_count;
+    wctx->saved_draw_cmd_capacity = ctx->draw_cmd_capacity;
 
     /* Point context at this window's draw list */
     ctx->vertices = entry->vertices;
@@ -554,13 +748,18 @@ static inline void forge_ui_win__redirect_to_window(
     ctx->indices = entry->indices;
     ctx->index_count = entry->index_count;
     ctx->index_capacity = entry->index_capacity;
+    ctx->draw_cmds = entry->draw_cmds;
+    ctx->draw_cmd_count = entry->draw_cmd_count;
+    ctx->draw_cmd_capacity = entry->draw_cmd_capacity;
 
     wctx->active_window_idx = window_idx;
 }
 
-static inline bool forge_ui_wctx_window_begin(ForgeUiWindowContext *wctx,
-                                                const char *title,
-                                                ForgeUiWindowState *state)
+/* Shared body of window_begin and window_begin_cached */
+static inline bool forge_ui_win__window_begin(ForgeUiWindowContext *wctx,
+                                               const char *title,
+                                               ForgeUiWindowState *state,
+                                               bool cached, Uint32 version)
 {
     if (!wctx || !wctx->ctx || !wctx->ctx->atlas ||
         !state || !title || title[0] == '\0') {
@@ -612,6 +811,7 @@ static inline bool forge_ui_wctx_window_begin(ForgeUiWindowContext *wctx,
     entry->state = state;
     entry->vertex_count = 0;
     entry->index_count = 0;
+    entry->draw_cmd_count = 0;
     wctx->window_count++;
 
     /* ── Redirect context output to this window's draw list ────────────── */
@@ -624,12 +824,25 @@ static inline bool forge_ui_wctx_window_begin(ForgeUiWindowContext *wctx,
         forge_ui_win__restore_from_window(wctx);
         entry->vertex_count = 0;
         entry->index_count = 0;
+        entry->draw_cmd_count = 0;
         entry->id = FORGE_UI_ID_NONE;
         entry->state = NULL;
         wctx->window_count--;
         return false;
     }
 
+    /* ── Cached window: replay the recorded draw list if it still applies.
+     *    Quiet windows (see forge_ui__region_quiet) have no title bar
+     *    interaction to process, so skipping straight to the end is the
+     *    same as running it. ─────────────────────────────────────────── */
+    if (cached && !state->collapsed &&
+        forge_ui__region_replay(ctx, id, version, state->rect,
+                                state->scroll_y)) {
+        forge_ui_pop_id(ctx);
+        forge_ui_win__restore_from_window(wctx);
+        return false;
+    }
+
     /* ── Determine if this window can receive input ────────────────────── */
     /* A window receives input only if it is the hovered window (topmost
      * under the cursor) or if no window contains the mouse position.
@@ -752,6 +965,12 @@ static inline bool forge_ui_wctx_window_begin(ForgeUiWindowContext *wctx,
         ctx->active = FORGE_UI_ID_NONE;
     }
 
+    /* Record this window's draw list (ended by window_end's panel_end) */
+    if (cached && !state->collapsed) {
+        forge_ui__region_record_begin(ctx, id, version, state->rect,
+                                      state->scroll_y);
+    }
+
     /* ── Draw title bar background ─────────────────────────────────────── */
     /* Recalculate title_rect after potential drag */
     title_rect = (ForgeUiRect){
@@ -818,7 +1037,7 @@ static inline bool forge_ui_wctx_window_begin(ForgeUiWindowContext *wctx,
         SDL_memcpy(disp_buf, title, (size_t)disp_len);
         disp_buf[disp_len] = '\0';
 
-        ForgeUiTextMetrics m = forge_ui_text_measure(ctx->atlas, disp_buf, NULL);
+        ForgeUiTextMetrics m = forge_ui__ctx_text_measure(ctx, disp_buf);
         float ascender_px = forge_ui__ascender_px(ctx->atlas);
         float title_text_x = state->rect.x + win_toggle_p
                              + win_toggle_s + win_toggle_p;
@@ -882,6 +1101,7 @@ static inline bool forge_ui_wctx_window_begin(ForgeUiWindowContext *wctx,
                                    FORGE_UI_LAYOUT_EXPLICIT_ZERO,
                                    FORGE_UI_SCALED(ctx, ctx->spacing.item_spacing))) {
         SDL_Log("forge_ui_wctx_window_begin: layout_push failed");
+        ctx->region_cache._recording = false;
         ctx->has_clip = false;
         ctx->_panel_active = false;
         ctx->_panel.id = FORGE_UI_ID_NONE;
@@ -895,6 +1115,7 @@ static inline bool forge_ui_wctx_window_begin(ForgeUiWindowContext *wctx,
          * does not render a half-constructed window. */
         entry->vertex_count = 0;
         entry->index_count = 0;
+        entry->draw_cmd_count = 0;
         entry->id = FORGE_UI_ID_NONE;
         entry->state = NULL;
         wctx->window_count--;
@@ -910,6 +1131,21 @@ static inline bool forge_ui_wctx_window_begin(ForgeUiWindowContext *wctx,
     return true;
 }
 
+static inline bool forge_ui_wctx_window_begin(ForgeUiWindowContext *wctx,
+                                                const char *title,
+                                                ForgeUiWindowState *state)
+{
+    return forge_ui_win__window_begin(wctx, title, state, false, 0);
+}
+
+static inline bool forge_ui_wctx_window_begin_cached(ForgeUiWindowContext *wctx,
+                                                       const char *title,
+                                                       ForgeUiWindowState *state,
+                                                       Uint32 version)
+{
+    return forge_ui_win__window_begin(wctx, title, state, true, version);
+}
+
 static inline void forge_ui_wctx_window_end(ForgeUiWindowContext *wctx)
 {
     if (!wctx || !wctx->ctx) return;
@@ -933,6 +1169,7 @@ static inline void forge_ui_wctx_window_end(ForgeUiWindowContext *wctx)
         int widx = wctx->active_window_idx;
         wctx->window_entries[widx].vertex_count = 0;
         wctx->window_entries[widx].index_count = 0;
+        wctx->window_entries[widx].draw_cmd_count = 0;
         wctx->window_entries[widx].id = FORGE_UI_ID_NONE;
         wctx->window_entries[widx].state = NULL;
         if (wctx->window_count > 0) wctx->window_count--;
@@ -946,6 +1183,11 @@ static inline void forge_ui_wctx_window_end(ForgeUiWindowContext *wctx)
         ctx->indices = wctx->saved_indices;
         ctx->index_count = wctx->saved_index_count;
         ctx->index_capacity = wctx->saved_index_capacity;
+        wctx->window_entries[widx].draw_cmds = ctx->draw_cmds;
+        wctx->window_entries[widx].draw_cmd_capacity = ctx->draw_cmd_capacity;
+        ctx->draw_cmds = wctx->saved_draw_cmds;
+        ctx->draw_cmd_count = wctx->saved_draw_cmd_count;
+        ctx->draw_cmd_capacity = wctx->saved_draw_cmd_capacity;
         wctx->active_window_idx = -1;
         return;
     }
@@ -185,7 +185,7 @@ static void demo_textured_quad(void)
      * it easy to verify that UV interpolation and sampling are correct. */
     Uint8 tex_pixels[CHECKER_SIZE * CHECKER_SIZE];
     make_checkerboard(tex_pixels, CHECKER_SIZE);
-    ForgeRasterTexture tex = { tex_pixels, CHECKER_SIZE, CHECKER_SIZE };
+    ForgeRasterTexture tex = { tex_pixels, CHECKER_SIZE, CHECKER_SIZE, 0.0f };
 
     /* A white quad with UVs spanning the full texture.  The vertex color
      * is white so the texture value shows through unmodified -- the texel
@@ -258,7 +258,7 @@ static void demo_scene(void)
     /* Generate checkerboard texture for the textured region */
     Uint8 tex_pixels[CHECKER_SIZE * CHECKER_SIZE];
     make_checkerboard(tex_pixels, CHECKER_SIZE);
-    ForgeRasterTexture tex = { tex_pixels, CHECKER_SIZE, CHECKER_SIZE };
+    ForgeRasterTexture tex = { tex_pixels, CHECKER_SIZE, CHECKER_SIZE, 0.0f };
 
     /* ── Background: textured region ─────────────────────────────────── */
     /* A subtle checkered area in the lower portion */
@@ -90,6 +90,7 @@ static bool rasterize_and_report(const ForgeUiFont *font,
             scale, pixel_height, font->head.units_per_em);
 
     ForgeUiRasterOpts opts;
+    SDL_memset(&opts, 0, sizeof(opts));
     opts.supersample_level = ss_level;
 
     ForgeUiGlyphBitmap bitmap;
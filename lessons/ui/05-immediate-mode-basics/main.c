@@ -119,7 +119,8 @@ static bool render_frame_bmp(const char *path,
     ForgeRasterTexture tex = {
         atlas->pixels,
         atlas->width,
-        atlas->height
+        atlas->height,
+        0.0f
     };
 
     /* Draw all UI triangles in one batch */
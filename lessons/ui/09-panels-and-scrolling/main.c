@@ -135,7 +135,8 @@ static bool render_frame_bmp(const char *path,
     ForgeRasterTexture tex = {
         atlas->pixels,
         atlas->width,
-        atlas->height
+        atlas->height,
+        0.0f
     };
 
     forge_raster_triangles_indexed(
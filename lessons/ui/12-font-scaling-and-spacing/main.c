@@ -203,7 +203,8 @@ static bool render_frame_scales(ForgeRasterBuffer *fb,
         ForgeRasterTexture tex = {
             sui[i].atlas.pixels,
             sui[i].atlas.width,
-            sui[i].atlas.height
+            sui[i].atlas.height,
+            0.0f
         };
         forge_raster_triangles_indexed(
             fb,
@@ -283,7 +284,8 @@ static bool render_frame_spacing(ForgeRasterBuffer *fb,
         ForgeRasterTexture tex = {
             spacious.atlas.pixels,
             spacious.atlas.width,
-            spacious.atlas.height
+            spacious.atlas.height,
+            0.0f
         };
         forge_raster_triangles_indexed(
             fb,
@@ -320,7 +322,8 @@ static bool render_frame_spacing(ForgeRasterBuffer *fb,
         ForgeRasterTexture tex = {
             compact.atlas.pixels,
             compact.atlas.width,
-            compact.atlas.height
+            compact.atlas.height,
+            0.0f
         };
         forge_raster_triangles_indexed(
             fb,
@@ -177,7 +177,8 @@ static bool render_and_save(ForgeRasterBuffer *fb,
     ForgeRasterTexture tex = {
         atlas->pixels,
         atlas->width,
-        atlas->height
+        atlas->height,
+        0.0f
     };
 
     forge_raster_triangles_indexed(
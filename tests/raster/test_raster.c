@@ -253,7 +253,7 @@ static void test_texture_sampling(void)
 
     /* 2x2 checkerboard: white(255), black(0), black(0), white(255) */
     Uint8 tex_pixels[4] = { 255, 0, 0, 255 };
-    ForgeRasterTexture tex = { tex_pixels, 2, 2 };
+    ForgeRasterTexture tex = { tex_pixels, 2, 2, 0.0f };
 
     /* White quad with UV mapping across the full texture */
     ForgeRasterVertex verts[4] = {
@@ -277,6 +277,64 @@ static void test_texture_sampling(void)
     forge_raster_buffer_destroy(&buf);
 }
 
+static void test_sdf_sample(void)
+{
+    TEST("sample_sdf: bilinear distance mapped through the screen range");
+    /* 4x1 field with the outline halfway between texels 1 and 2:
+     * values 64, 96 | 160, 192 (outside | inside) */
+    Uint8 field[4] = { 64, 96, 160, 192 };
+    ForgeRasterTexture tex = { field, 4, 1, 8.0f };
+
+    /* At the outline (u = 0.5) the interpolated distance is 128/255 */
+    float at_edge = forge_raster_sample_sdf(&tex, 0.5f, 0.5f);
+    ASSERT_TRUE(at_edge > 0.45f && at_edge < 0.55f);
+
+    /* Texel centers well away from the edge saturate */
+    ASSERT_TRUE(forge_raster_sample_sdf(&tex, 0.125f, 0.5f) == 0.0f);
+    ASSERT_TRUE(forge_raster_sample_sdf(&tex, 0.875f, 0.5f) == 1.0f);
+
+    /* Coverage textures are not SDFs */
+    ForgeRasterTexture plain = { field, 4, 1, 0.0f };
+    ASSERT_TRUE(forge_raster_sample_sdf(&plain, 0.5f, 0.5f) == 0.0f);
+}
+
+static void test_sdf_edge_stays_sharp_when_magnified(void)
+{
+    TEST("sdf_texture: magnified edge keeps a ~1 pixel transition");
+    /* A vertical edge through the middle of a 4-texel field, stretched
+     * across 64 pixels (16x magnification).  Nearest sampling would give a
+     * hard step on texel boundaries; a coverage texture filtered
+     * bilinearly would blur over 16 pixels.  The SDF reconstructs an edge
+     * about one pixel wide at x = 32. */
+    Uint8 field[4] = { 80, 112, 144, 176 };  /* 32 per texel, edge at 128 */
+    /* 0..255 spans 8 texels = 128 screen px at 16x */
+    ForgeRasterTexture tex = { field, 4, 1, 128.0f };
+
+    ForgeRasterBuffer buf = forge_raster_buffer_create(64, 4);
+    ASSERT_TRUE(buf.pixels != NULL);
+    forge_raster_clear(&buf, 0.0f, 0.0f, 0.0f, 0.0f);
+
+    ForgeRasterVertex v0 = { 0.0f,  -1.0f, 0.0f, 0.5f,  1, 1, 1, 1 };
+    ForgeRasterVertex v1 = { 64.0f, -1.0f, 1.0f, 0.5f,  1, 1, 1, 1 };
+    ForgeRasterVertex v2 = { 64.0f,  8.0f, 1.0f, 0.5f,  1, 1, 1, 1 };
+    ForgeRasterVertex v3 = { 0.0f,   8.0f, 0.0f, 0.5f,  1, 1, 1, 1 };
+    Uint32 indices[6] = { 0, 1, 2,  0, 2, 3 };
+    ForgeRasterVertex verts[4] = { v0, v1, v2, v3 };
+    forge_raster_triangles_indexed(&buf, verts, 4, indices, 6, &tex);
+
+    Uint8 r, g, b, a;
+    get_pixel(&buf, 28, 2, &r, &g, &b, &a);
+    ASSERT_EQ_BYTE(a, 0);
+    get_pixel(&buf, 30, 2, &r, &g, &b, &a);
+    ASSERT_EQ_BYTE(a, 0);
+    get_pixel(&buf, 33, 2, &r, &g, &b, &a);
+    ASSERT_EQ_BYTE(a, 255);
+    get_pixel(&buf, 36, 2, &r, &g, &b, &a);
+    ASSERT_EQ_BYTE(a, 255);
+
+    forge_raster_buffer_destroy(&buf);
+}
+
 static void test_alpha_blending(void)
 {
     TEST("alpha_blending: source-over compositing");
@@ -287,8 +345,8 @@ static void test_alpha_blending(void)
     forge_raster_clear(&buf, 1.0f, 1.0f, 1.0f, 1.0f);
 
     /* Draw a 50% transparent red triangle covering the test pixel.
-     * We use a single triangle instead of a quad to avoid the shared-edge
-     * double-blend issue (this library has no fill rule to prevent it). */
+     * A single triangle keeps this a test of one blend in isolation
+     * (shared edges are covered by the fill rule tests). */
     ForgeRasterVertex v0 = { -1.0f, -1.0f, 0, 0,  1, 0, 0, 0.5f };
     ForgeRasterVertex v1 = { 10.0f, -1.0f, 0, 0,  1, 0, 0, 0.5f };
     ForgeRasterVertex v2 = { -1.0f, 10.0f, 0, 0,  1, 0, 0, 0.5f };
@@ -350,6 +408,183 @@ static void test_cw_winding(void)
     forge_raster_buffer_destroy(&buf);
 }
 
+/* ── Fill Rule Tests ─────────────────────────────────────────────────────── */
+
+/* Count pixels whose red channel differs from bg_r, and check that every
+ * such pixel has red channel expect_r +/- 1 (one blend, never two; the
+ * barycentric weights may not sum to exactly 1).  Returns the count, or
+ * -1 if some pixel was blended to a different value. */
+static int count_single_blends(const ForgeRasterBuffer *buf, Uint8 bg_r,
+                               Uint8 expect_r)
+{
+    int count = 0;
+    for (int y = 0; y < buf->height; y++) {
+        for (int x = 0; x < buf->width; x++) {
+            Uint8 r = buf->pixels[(size_t)y * (size_t)buf->stride +
+                                  (size_t)x * FORGE_RASTER_BPP];
+            if (r == bg_r) continue;
+            if (r + 1 < expect_r || r > expect_r + 1) {
+                SDL_Log("    pixel (%d, %d) has red %u, expected %u",
+                        x, y, r, expect_r);
+                return -1;
+            }
+            count++;
+        }
+    }
+    return count;
+}
+
+static void test_fill_rule_top_left(void)
+{
+    TEST("fill_rule: centers on left/top edges in, right/bottom out");
+    ForgeRasterBuffer buf = forge_raster_buffer_create(8, 8);
+    ASSERT_TRUE(buf.pixels != NULL);
+
+    /* Edges at 1.5 and 5.5 pass exactly through pixel centers: columns
+     * and rows 1..4 are covered, 5 is not -- a 4x4 block, as on a GPU.
+     * Both windings and both diagonals must agree. */
+    ForgeRasterVertex q[4] = {
+        { 1.5f, 1.5f, 0, 0, 1, 1, 1, 1 },
+        { 5.5f, 1.5f, 0, 0, 1, 1, 1, 1 },
+        { 5.5f, 5.5f, 0, 0, 1, 1, 1, 1 },
+        { 1.5f, 5.5f, 0, 0, 1, 1, 1, 1 },
+    };
+    const Uint32 quads[4][6] = {
+        { 0, 1, 2,  0, 2, 3 },  /* CW on screen, diagonal 0-2 */
+        { 0, 2, 1,  0, 3, 2 },  /* CCW, diagonal 0-2 */
+        { 0, 1, 3,  1, 2, 3 },  /* CW, diagonal 1-3 */
+        { 1, 0, 3,  3, 2, 1 },  /* CCW, diagonal 1-3 */
+    };
+    for (int i = 0; i < 4; i++) {
+        forge_raster_clear(&buf, 0.0f, 0.0f, 0.0f, 1.0f);
+        forge_raster_triangles_indexed(&buf, q, 4, quads[i], 6, NULL);
+        for (int y = 0; y < 8; y++) {
+            for (int x = 0; x < 8; x++) {
+                Uint8 r, g, b, a;
+                get_pixel(&buf, x, y, &r, &g, &b, &a);
+                bool inside = x >= 1 && x <= 4 && y >= 1 && y <= 4;
+                ASSERT_EQ_BYTE(r, inside ? 255 : 0);
+            }
+        }
+    }
+
+    forge_raster_buffer_destroy(&buf);
+}
+
+static void test_fill_rule_shared_edges(void)
+{
+    TEST("fill_rule: translucent quads blend shared edges once");
+    ForgeRasterBuffer buf = forge_raster_buffer_create(24, 16);
+    ASSERT_TRUE(buf.pixels != NULL);
+    forge_raster_clear(&buf, 0.0f, 0.0f, 0.0f, 1.0f);
+
+    /* Two 50% quads side by side; the shared edge at x = 8.5 and both
+     * diagonals pass through pixel centers */
+    ForgeRasterVertex verts[6] = {
+        { 0.5f,  0.5f,  0, 0, 1, 1, 1, 0.5f },
+        { 8.5f,  0.5f,  0, 0, 1, 1, 1, 0.5f },
+        { 16.5f, 0.5f,  0, 0, 1, 1, 1, 0.5f },
+        { 0.5f,  8.5f,  0, 0, 1, 1, 1, 0.5f },
+        { 8.5f,  8.5f,  0, 0, 1, 1, 1, 0.5f },
+        { 16.5f, 8.5f,  0, 0, 1, 1, 1, 0.5f },
+    };
+    Uint32 indices[12] = { 0, 1, 4,  0, 4, 3,  1, 2, 5,  1, 5, 4 };
+    forge_raster_triangles_indexed(&buf, verts, 6, indices, 12, NULL);
+
+    /* Every covered pixel is blended exactly once (128), and the covered
+     * region is exactly 16 x 8 */
+    ASSERT_EQ_INT(count_single_blends(&buf, 0, 128), 16 * 8);
+
+    forge_raster_buffer_destroy(&buf);
+}
+
+static void test_fill_rule_fan_watertight(void)
+{
+    TEST("fill_rule: fan around a shared vertex has no gaps or overlaps");
+    ForgeRasterBuffer buf = forge_raster_buffer_create(40, 40);
+    ASSERT_TRUE(buf.pixels != NULL);
+    forge_raster_clear(&buf, 0.0f, 0.0f, 0.0f, 1.0f);
+
+    /* Slivers around a center that sits on a pixel center, with rim
+     * vertices at fractional positions (a rough circle of radius ~17) */
+    enum { SEGMENTS = 12 };
+    static const float rim[SEGMENTS][2] = {
+        { 17.3f,  0.0f  }, { 14.98f, 8.65f  }, { 8.65f,  14.98f },
+        { 0.0f,   17.3f }, { -8.65f, 14.98f }, { -14.98f, 8.65f },
+        { -17.3f, 0.0f  }, { -14.98f, -8.65f }, { -8.65f, -14.98f },
+        { 0.0f, -17.3f  }, { 8.65f, -14.98f }, { 14.98f, -8.65f },
+    };
+    ForgeRasterVertex verts[SEGMENTS + 1];
+    Uint32 indices[SEGMENTS * 3];
+    verts[0] = (ForgeRasterVertex){ 20.5f, 20.5f, 0, 0, 1, 1, 1, 0.5f };
+    for (int i = 0; i < SEGMENTS; i++) {
+        verts[i + 1] = (ForgeRasterVertex){
+            20.5f + rim[i][0], 20.5f + rim[i][1], 0, 0, 1, 1, 1, 0.5f };
+        indices[i * 3 + 0] = 0;
+        indices[i * 3 + 1] = (Uint32)(i + 1);
+        indices[i * 3 + 2] = (Uint32)((i + 1) % SEGMENTS + 1);
+    }
+    forge_raster_triangles_indexed(&buf, verts, SEGMENTS + 1, indices,
+                                   SEGMENTS * 3, NULL);
+
+    ASSERT_TRUE(count_single_blends(&buf, 0, 128) > 0);
+
+    /* No holes: everything well inside the rim is covered */
+    for (int y = 8; y < 33; y++) {
+        for (int x = 8; x < 33; x++) {
+            float dx = (float)x + 0.5f - 20.5f;
+            float dy = (float)y + 0.5f - 20.5f;
+            if (dx * dx + dy * dy > 14.0f * 14.0f) continue;
+            Uint8 r, g, b, a;
+            get_pixel(&buf, x, y, &r, &g, &b, &a);
+            ASSERT_NEAR_BYTE(r, 128, 1);
+        }
+    }
+
+    forge_raster_buffer_destroy(&buf);
+}
+
+static void test_subpixel_precision(void)
+{
+    TEST("subpixel: coverage follows edges between pixel centers");
+    ForgeRasterBuffer buf = forge_raster_buffer_create(8, 4);
+    ASSERT_TRUE(buf.pixels != NULL);
+    forge_raster_clear(&buf, 0.0f, 0.0f, 0.0f, 1.0f);
+
+    /* A right edge just past a pixel center covers it; just before it
+     * does not.  1/64 px is well above the 1/256 px snapping grid. */
+    ForgeRasterVertex a[3] = {
+        { 0.0f,       0.0f, 0, 0, 1, 1, 1, 1 },
+        { 3.515625f,  0.0f, 0, 0, 1, 1, 1, 1 },
+        { 3.515625f,  2.0f, 0, 0, 1, 1, 1, 1 },
+    };
+    forge_raster_triangle(&buf, &a[0], &a[1], &a[2], NULL);
+    Uint8 r, g, b, al;
+    get_pixel(&buf, 3, 0, &r, &g, &b, &al);
+    ASSERT_EQ_BYTE(r, 255);
+
+    forge_raster_clear(&buf, 0.0f, 0.0f, 0.0f, 1.0f);
+    a[1].x = 3.484375f;
+    a[2].x = 3.484375f;
+    forge_raster_triangle(&buf, &a[0], &a[1], &a[2], NULL);
+    get_pixel(&buf, 3, 0, &r, &g, &b, &al);
+    ASSERT_EQ_BYTE(r, 0);
+    get_pixel(&buf, 2, 0, &r, &g, &b, &al);
+    ASSERT_EQ_BYTE(r, 255);
+
+    /* A sliver between two rows of centers covers nothing */
+    forge_raster_clear(&buf, 0.0f, 0.0f, 0.0f, 1.0f);
+    ForgeRasterVertex s[3] = {
+        { 0.0f, 0.6f, 0, 0, 1, 1, 1, 1 },
+        { 8.0f, 0.6f, 0, 0, 1, 1, 1, 1 },
+        { 8.0f, 1.4f, 0, 0, 1, 1, 1, 1 },
+    };
+    forge_raster_triangle(&buf, &s[0], &s[1], &s[2], NULL);
+    ASSERT_EQ_INT(count_single_blends(&buf, 0, 255), 0);
+
+    forge_raster_buffer_destroy(&buf);
+}
+
 static void test_off_screen_triangle(void)
 {
     TEST("off_screen_triangle: partially off-screen is clipped");
@@ -414,6 +649,615 @@ static void test_vertex_layout_size(void)
     ASSERT_EQ_INT((int)sizeof(ForgeRasterVertex), 32);
 }
 
+static void test_packed_vertex_layout_size(void)
+{
+    TEST("vertex_layout: ForgeRasterPackedVertex is 16 bytes");
+    ASSERT_EQ_INT((int)sizeof(ForgeRasterPackedVertex), 16);
+}
+
+static void test_unpack_vertices(void)
+{
+    TEST("unpack_vertices: unorm UV and color expand to [0, 1]");
+    ForgeRasterPackedVertex p = { 3.5f, -2.0f, 65535, 32768, 255, 0, 51, 128 };
+    ForgeRasterVertex v;
+    forge_raster_unpack_vertices(&p, &v, 1);
+    ASSERT_TRUE(v.x == 3.5f && v.y == -2.0f);
+    ASSERT_TRUE(v.u == 1.0f);
+    ASSERT_TRUE(SDL_fabsf(v.v - 32768.0f / 65535.0f) < 1e-6f);
+    ASSERT_TRUE(v.r == 1.0f && v.g == 0.0f);
+    ASSERT_TRUE(SDL_fabsf(v.b - 0.2f) < 1e-6f);
+    ASSERT_TRUE(SDL_fabsf(v.a - 128.0f / 255.0f) < 1e-6f);
+}
+
+static void test_packed_indexed_matches_float(void)
+{
+    TEST("indexed_drawing: packed vertices draw like unpacked floats");
+    ForgeRasterBuffer a = forge_raster_buffer_create(32, 32);
+    ForgeRasterBuffer b = forge_raster_buffer_create(32, 32);
+    ASSERT_TRUE(a.pixels != NULL && b.pixels != NULL);
+    forge_raster_clear(&a, 0.1f, 0.2f, 0.3f, 1.0f);
+    forge_raster_clear(&b, 0.1f, 0.2f, 0.3f, 1.0f);
+
+    /* Textured, color-interpolated, translucent quad */
+    Uint8 texels[4 * 4];
+    for (int i = 0; i < 16; i++) texels[i] = (Uint8)(i * 17);
+    ForgeRasterTexture tex = { texels, 4, 4, 0.0f };
+    ForgeRasterPackedVertex packed[4] = {
+        { 2.0f,  3.0f,  0,     0,     255, 0,   0,   200 },
+        { 29.5f, 3.0f,  65535, 0,     0,   255, 0,   255 },
+        { 29.5f, 30.0f, 65535, 65535, 0,   0,   255, 128 },
+        { 2.0f,  30.0f, 0,     65535, 255, 255, 255, 64  },
+    };
+    ForgeRasterVertex floats[4];
+    forge_raster_unpack_vertices(packed, floats, 4);
+    Uint32 indices[6] = { 0, 1, 2,  2, 3, 0 };
+
+    forge_raster_triangles_indexed(&a, floats, 4, indices, 6, &tex);
+    forge_raster_triangles_indexed_packed(&b, packed, 4, indices, 6, &tex);
+    ASSERT_TRUE(SDL_memcmp(a.pixels, b.pixels,
+                           (size_t)a.stride * (size_t)a.height) == 0);
+
+    /* Out-of-range indices are skipped, as in the float path */
+    Uint32 bad[3] = { 0, 1, 4 };
+    forge_raster_triangles_indexed_packed(&b, packed, 4, bad, 3, &tex);
+    ASSERT_TRUE(SDL_memcmp(a.pixels, b.pixels,
+                           (size_t)a.stride * (size_t)a.height) == 0);
+
+    forge_raster_buffer_destroy(&a);
+    forge_raster_buffer_destroy(&b);
+}
+
+static void test_scissor_matches_inside_rect(void)
+{
+    TEST("indexed_drawing: scissor keeps inside pixels, leaves the rest");
+    ForgeRasterBuffer full = forge_raster_buffer_create(32, 32);
+    ForgeRasterBuffer cut  = forge_raster_buffer_create(32, 32);
+    ASSERT_TRUE(full.pixels != NULL && cut.pixels != NULL);
+    forge_raster_clear(&full, 0.1f, 0.2f, 0.3f, 1.0f);
+    forge_raster_clear(&cut,  0.1f, 0.2f, 0.3f, 1.0f);
+
+    ForgeRasterVertex verts[4] = {
+        { 1.0f,  1.0f,  0, 0,  1.0f, 0.0f, 0.0f, 0.8f },
+        { 31.0f, 2.0f,  1, 0,  0.0f, 1.0f, 0.0f, 1.0f },
+        { 30.0f, 31.0f, 1, 1,  0.0f, 0.0f, 1.0f, 0.6f },
+        { 2.0f,  30.0f, 0, 1,  1.0f, 1.0f, 1.0f, 0.9f },
+    };
+    Uint32 indices[6] = { 0, 1, 2,  2, 3, 0 };
+    forge_raster_triangles_indexed(&full, verts, 4, indices, 6, NULL);
+    forge_raster_triangles_indexed_scissor(&cut, verts, 4, indices, 6, NULL,
+                                           8, 5, 12, 20);
+
+    Uint8 background[4] = { 0 };
+    get_pixel(&cut, 0, 0, &background[0], &background[1],
+              &background[2], &background[3]);
+    for (int y = 0; y < 32; y++) {
+        for (int x = 0; x < 32; x++) {
+            bool inside = x >= 8 && x < 20 && y >= 5 && y < 25;
+            const Uint8 *pc = cut.pixels + (size_t)y * (size_t)cut.stride
+                              + (size_t)x * FORGE_RASTER_BPP;
+            const Uint8 *pf = full.pixels + (size_t)y * (size_t)full.stride
+                              + (size_t)x * FORGE_RASTER_BPP;
+            const Uint8 *expect = inside ? pf : background;
+            ASSERT_TRUE(SDL_memcmp(pc, expect, FORGE_RASTER_BPP) == 0);
+        }
+    }
+
+    forge_raster_buffer_destroy(&full);
+    forge_raster_buffer_destroy(&cut);
+}
+
+static void test_scissor_out_of_range(void)
+{
+    TEST("indexed_drawing: scissor clamps to buffer, empty draws nothing");
+    ForgeRasterBuffer a = forge_raster_buffer_create(16, 16);
+    ForgeRasterBuffer b = forge_raster_buffer_create(16, 16);
+    ASSERT_TRUE(a.pixels != NULL && b.pixels != NULL);
+    forge_raster_clear(&a, 0.0f, 0.0f, 0.0f, 1.0f);
+    forge_raster_clear(&b, 0.0f, 0.0f, 0.0f, 1.0f);
+    size_t size = (size_t)a.stride * (size_t)a.height;
+
+    ForgeRasterVertex verts[3] = {
+        { -4.0f, -4.0f, 0, 0,  1, 1, 1, 1 },
+        { 20.0f, -4.0f, 0, 0,  1, 1, 1, 1 },
+        { -4.0f, 20.0f, 0, 0,  1, 1, 1, 1 },
+    };
+    Uint32 indices[3] = { 0, 1, 2 };
+
+    /* Empty, inverted, and fully outside scissors touch nothing */
+    forge_raster_triangles_indexed_scissor(&b, verts, 3, indices, 3, NULL,
+                                           4, 4, 0, 8);
+    forge_raster_triangles_indexed_scissor(&b, verts, 3, indices, 3, NULL,
+                                           4, 4, 8, -1);
+    forge_raster_triangles_indexed_scissor(&b, verts, 3, indices, 3, NULL,
+                                           16, 0, 8, 8);
+    forge_raster_triangles_indexed_scissor(&b, verts, 3, indices, 3, NULL,
+                                           -20, 0, 20, 8);
+    ASSERT_TRUE(SDL_memcmp(a.pixels, b.pixels, size) == 0);
+
+    /* A scissor larger than the buffer (even one that would overflow
+     * x + w) draws the same as no scissor */
+    forge_raster_triangles_indexed(&a, verts, 3, indices, 3, NULL);
+    forge_raster_triangles_indexed_scissor(&b, verts, 3, indices, 3, NULL,
+                                           -100, 2, SDL_MAX_SINT32, SDL_MAX_SINT32);
+    forge_raster_triangles_indexed_scissor(&b, verts, 3, indices, 3, NULL,
+                                           0, 0, 16, 2);
+    ASSERT_TRUE(SDL_memcmp(a.pixels, b.pixels, size) == 0);
+
+    forge_raster_buffer_destroy(&a);
+    forge_raster_buffer_destroy(&b);
+}
+
+static void test_rects_match_inside_rects(void)
+{
+    TEST("indexed_drawing: rect list draws like scissors, clear_rect too");
+    ForgeRasterBuffer full = forge_raster_buffer_create(32, 32);
+    ForgeRasterBuffer part = forge_raster_buffer_create(32, 32);
+    ASSERT_TRUE(full.pixels != NULL && part.pixels != NULL);
+    forge_raster_clear(&full, 0.1f, 0.2f, 0.3f, 1.0f);
+    forge_raster_clear(&part, 0.5f, 0.5f, 0.5f, 1.0f);
+
+    ForgeRasterVertex verts[4] = {
+        { 1.0f,  1.0f,  0, 0,  1.0f, 0.0f, 0.0f, 0.8f },
+        { 31.0f, 2.0f,  1, 0,  0.0f, 1.0f, 0.0f, 1.0f },
+        { 30.0f, 31.0f, 1, 1,  0.0f, 0.0f, 1.0f, 0.6f },
+        { 2.0f,  30.0f, 0, 1,  1.0f, 1.0f, 1.0f, 0.9f },
+    };
+    Uint32 indices[6] = { 0, 1, 2,  2, 3, 0 };
+    /* One rect hangs off the buffer and one misses it entirely */
+    ForgeRasterRect rects[3] = {
+        { 2, 3, 10, 6 }, { 20, 16, 20, 20 }, { 40, 40, 4, 4 },
+    };
+    forge_raster_triangles_indexed(&full, verts, 4, indices, 6, NULL);
+    for (int r = 0; r < 3; r++) {
+        forge_raster_clear_rect(&part, rects[r].x, rects[r].y, rects[r].w,
+                                rects[r].h, 0.1f, 0.2f, 0.3f, 1.0f);
+    }
+    forge_raster_triangles_indexed_rects(&part, verts, 4, indices, 6, NULL,
+                                         rects, 3);
+
+    for (int y = 0; y < 32; y++) {
+        for (int x = 0; x < 32; x++) {
+            bool inside = (x >= 2 && x < 12 && y >= 3 && y < 9) ||
+                          (x >= 20 && y >= 16);
+            const Uint8 *pp = part.pixels + (size_t)y * (size_t)part.stride
+                              + (size_t)x * FORGE_RASTER_BPP;
+            const Uint8 *pf = full.pixels + (size_t)y * (size_t)full.stride
+                              + (size_t)x * FORGE_RASTER_BPP;
+            if (inside) {
+                ASSERT_TRUE(SDL_memcmp(pp, pf, FORGE_RASTER_BPP) == 0);
+            } else {
+                ASSERT_EQ_INT(pp[0], 128);
+            }
+        }
+    }
+
+    /* No rects, or a NULL list, draws nothing */
+    size_t size = (size_t)part.stride * (size_t)part.height;
+    SDL_memcpy(full.pixels, part.pixels, size);
+    forge_raster_triangles_indexed_rects(&part, verts, 4, indices, 6, NULL,
+                                         rects, 0);
+    forge_raster_triangles_indexed_rects(&part, verts, 4, indices, 6, NULL,
+                                         NULL, 3);
+    forge_raster_clear_rect(&part, 0, 0, 0, 32, 1.0f, 1.0f, 1.0f, 1.0f);
+    ASSERT_TRUE(SDL_memcmp(full.pixels, part.pixels, size) == 0);
+
+    forge_raster_buffer_destroy(&full);
+    forge_raster_buffer_destroy(&part);
+}
+
+/* ── Block Classification Tests ──────────────────────────────────────────── */
+
+static void test_block_classes_match_pixels(void)
+{
+    TEST("block: inside/outside classes agree with every pixel test");
+    Uint32 seed = 777u;
+    int inside_blocks = 0, outside_blocks = 0, wrong = 0;
+    for (int t = 0; t < 200; t++) {
+        int fx[3], fy[3];
+        for (int i = 0; i < 3; i++) {
+            seed = seed * 1664525u + 1013904223u;
+            fx[i] = (int)(seed >> 18);  /* up to 64 px in 1/256 steps */
+            seed = seed * 1664525u + 1013904223u;
+            fy[i] = (int)(seed >> 18);
+        }
+        int64_t area = forge_raster__orient2d(fx[0], fy[0], fx[1], fy[1],
+                                              fx[2], fy[2]);
+        if (area == 0) continue;
+        if (area < 0) {
+            int tmp = fx[1]; fx[1] = fx[2]; fx[2] = tmp;
+            tmp = fy[1]; fy[1] = fy[2]; fy[2] = tmp;
+        }
+
+        /* Blocks at odd offsets and sizes, as clipping produces */
+        for (int by = 0; by < 64; by += 5) {
+            for (int bx = 0; bx < 64; bx += 3) {
+                int px = bx * FORGE_RASTER__SUBPIXEL_ONE +
+                         FORGE_RASTER__SUBPIXEL_HALF;
+                int py = by * FORGE_RASTER__SUBPIXEL_ONE +
+                         FORGE_RASTER__SUBPIXEL_HALF;
+                ForgeRaster__Edge e[3];
+                forge_raster__edge_setup(&e[0], fx[1], fy[1], fx[2], fy[2], px, py);
+                forge_raster__edge_setup(&e[1], fx[2], fy[2], fx[0], fy[0], px, py);
+                forge_raster__edge_setup(&e[2], fx[0], fy[0], fx[1], fy[1], px, py);
+                int last = (bx + by) % FORGE_RASTER__BLOCK_SIZE;
+                int cls = FORGE_RASTER__BLOCK_INSIDE;
+                for (int i = 0; i < 3; i++) {
+                    int c = forge_raster__edge_block_class(&e[i], e[i].w,
+                                                           last, 7 - last);
+                    if (c < cls) cls = c;
+                }
+
+                int covered = 0, total = 0;
+                for (int y = 0; y <= 7 - last; y++) {
+                    for (int x = 0; x <= last; x++) {
+                        bool in = true;
+                        for (int i = 0; i < 3; i++) {
+                            in = in && e[i].w + x * e[i].step_x +
+                                       y * e[i].step_y >= 0;
+                        }
+                        covered += in ? 1 : 0;
+                        total++;
+                    }
+                }
+                if (cls == FORGE_RASTER__BLOCK_INSIDE) {
+                    if (covered != total) wrong++;
+                    inside_blocks++;
+                } else if (cls == FORGE_RASTER__BLOCK_OUTSIDE) {
+                    if (covered != 0) wrong++;
+                    outside_blocks++;
+                }
+            }
+        }
+    }
+    ASSERT_EQ_INT(wrong, 0);
+
+    /* Both shortcuts were actually exercised */
+    ASSERT_TRUE(inside_blocks > 100);
+    ASSERT_TRUE(outside_blocks > 100);
+}
+
+static void test_block_large_quad(void)
+{
+    TEST("block: misaligned large quad covers exactly its pixel centers");
+    ForgeRasterBuffer buf = forge_raster_buffer_create(200, 150);
+    ASSERT_TRUE(buf.pixels != NULL);
+    forge_raster_clear(&buf, 0.0f, 0.0f, 0.0f, 1.0f);
+
+    /* Corners off the 8-pixel grid, so every block along the edges is
+     * partial and the interior is mostly whole blocks.  Centers x + 0.5
+     * in [3.3, 190.6) are columns 3..190; y + 0.5 in [5.7, 141.2) are
+     * rows 6..140. */
+    ForgeRasterVertex q[4] = {
+        { 3.3f,   5.7f,   0, 0, 1, 1, 1, 0.5f },
+        { 190.6f, 5.7f,   0, 0, 1, 1, 1, 0.5f },
+        { 190.6f, 141.2f, 0, 0, 1, 1, 1, 0.5f },
+        { 3.3f,   141.2f, 0, 0, 1, 1, 1, 0.5f },
+    };
+    Uint32 indices[6] = { 0, 1, 2,  0, 2, 3 };
+    forge_raster_triangles_indexed(&buf, q, 4, indices, 6, NULL);
+    ASSERT_EQ_INT(count_single_blends(&buf, 0, 128), 188 * 135);
+
+    Uint8 r, g, b, a;
+    get_pixel(&buf, 3, 6, &r, &g, &b, &a);
+    ASSERT_NEAR_BYTE(r, 128, 1);
+    get_pixel(&buf, 190, 140, &r, &g, &b, &a);
+    ASSERT_NEAR_BYTE(r, 128, 1);
+    get_pixel(&buf, 2, 6, &r, &g, &b, &a);
+    ASSERT_EQ_BYTE(r, 0);
+    get_pixel(&buf, 191, 140, &r, &g, &b, &a);
+    ASSERT_EQ_BYTE(r, 0);
+    get_pixel(&buf, 100, 5, &r, &g, &b, &a);
+    ASSERT_EQ_BYTE(r, 0);
+    get_pixel(&buf, 100, 141, &r, &g, &b, &a);
+    ASSERT_EQ_BYTE(r, 0);
+
+    /* Right and bottom edges through the centers of a block's last column
+     * and row: those pixels are excluded by the fill rule, so the block
+     * must not be classified as fully inside */
+    forge_raster_clear(&buf, 0.0f, 0.0f, 0.0f, 1.0f);
+    ForgeRasterVertex e[4] = {
+        { 0.5f,  0.5f,  0, 0, 1, 1, 1, 0.5f },
+        { 15.5f, 0.5f,  0, 0, 1, 1, 1, 0.5f },
+        { 15.5f, 15.5f, 0, 0, 1, 1, 1, 0.5f },
+        { 0.5f,  15.5f, 0, 0, 1, 1, 1, 0.5f },
+    };
+    forge_raster_triangles_indexed(&buf, e, 4, indices, 6, NULL);
+    ASSERT_EQ_INT(count_single_blends(&buf, 0, 128), 15 * 15);
+
+    forge_raster_buffer_destroy(&buf);
+}
+
+/* ── Tiled Drawing Tests ─────────────────────────────────────────────────── */
+
+/* Fill a scene of overlapping translucent triangles, some reaching past
+ * the framebuffer edges, from a fixed-seed LCG.  Writes count * 3
+ * vertices and indices (one triangle per three vertices). */
+static void make_overlap_scene(ForgeRasterVertex *verts, Uint32 *indices,
+                               int count, int width, int height)
+{
+    Uint32 seed = 12345u;
+    for (int i = 0; i < count * 3; i++) {
+        float f[8];
+        for (int k = 0; k < 8; k++) {
+            seed = seed * 1664525u + 1013904223u;
+            f[k] = (float)(seed >> 8) / 16777216.0f;  /* [0, 1) */
+        }
+        verts[i].x = f[0] * (float)(width + 40) - 20.0f;
+        verts[i].y = f[1] * (float)(height + 40) - 20.0f;
+        verts[i].u = f[2];
+        verts[i].v = f[3];
+        verts[i].r = f[4];
+        verts[i].g = f[5];
+        verts[i].b = f[6];
+        verts[i].a = 0.3f + 0.6f * f[7];
+        indices[i] = (Uint32)i;
+    }
+}
+
+static void test_tiled_matches_serial(void)
+{
+    TEST("tiled: byte-identical to serial for any tile size / threads");
+    enum { W = 203, H = 151, TRIS = 300 };
+    ForgeRasterVertex verts[TRIS * 3];
+    Uint32 indices[TRIS * 3];
+    make_overlap_scene(verts, indices, TRIS, W, H);
+
+    /* A textured batch covers the texture-sampling path as well */
+    Uint8 texels[8 * 8];
+    for (int i = 0; i < 64; i++) texels[i] = (Uint8)(i * 4 + 3);
+    ForgeRasterTexture tex = { texels, 8, 8, 0.0f };
+
+    ForgeRasterBuffer ref  = forge_raster_buffer_create(W, H);
+    ForgeRasterBuffer tile = forge_raster_buffer_create(W, H);
+    ASSERT_TRUE(ref.pixels != NULL && tile.pixels != NULL);
+    size_t size = (size_t)ref.stride * (size_t)ref.height;
+
+    forge_raster_clear(&ref, 0.1f, 0.2f, 0.3f, 1.0f);
+    forge_raster_triangles_indexed(&ref, verts, TRIS * 3, indices,
+                                   TRIS * 3, NULL);
+    forge_raster_triangles_indexed(&ref, verts, TRIS * 3, indices,
+                                   TRIS * 3, &tex);
+
+    /* Tile sizes that divide the buffer unevenly, one below the minimum,
+     * one larger than the buffer; 0 threads = one per core */
+    const int tile_sizes[]    = { 0, 4, 16, 37, 1024 };
+    const int thread_counts[] = { 1, 2, 3, 8, 0 };
+    for (int ts = 0; ts < (int)SDL_arraysize(tile_sizes); ts++) {
+        for (int tc = 0; tc < (int)SDL_arraysize(thread_counts); tc++) {
+            ForgeRasterTileOpts opts = { tile_sizes[ts], thread_counts[tc] };
+            forge_raster_clear(&tile, 0.1f, 0.2f, 0.3f, 1.0f);
+            forge_raster_triangles_indexed_tiled(&tile, verts, TRIS * 3,
+                                                 indices, TRIS * 3, NULL,
+                                                 &opts);
+            forge_raster_triangles_indexed_tiled(&tile, verts, TRIS * 3,
+                                                 indices, TRIS * 3, &tex,
+                                                 &opts);
+            ASSERT_TRUE(SDL_memcmp(ref.pixels, tile.pixels, size) == 0);
+        }
+    }
+
+    /* NULL options behave like a zeroed struct */
+    forge_raster_clear(&tile, 0.1f, 0.2f, 0.3f, 1.0f);
+    forge_raster_triangles_indexed_tiled(&tile, verts, TRIS * 3, indices,
+                                         TRIS * 3, NULL, NULL);
+    forge_raster_triangles_indexed_tiled(&tile, verts, TRIS * 3, indices,
+                                         TRIS * 3, &tex, NULL);
+    ASSERT_TRUE(SDL_memcmp(ref.pixels, tile.pixels, size) == 0);
+
+    forge_raster_buffer_destroy(&ref);
+    forge_raster_buffer_destroy(&tile);
+}
+
+static void test_tiled_pool_reused(void)
+{
+    TEST("tiled: a pool reused across many draws matches serial");
+    enum { W = 203, H = 151, TRIS = 300, PER_DRAW = 7 };
+    ForgeRasterVertex verts[TRIS * 3];
+    Uint32 indices[TRIS * 3];
+    make_overlap_scene(verts, indices, TRIS, W, H);
+
+    ForgeRasterBuffer ref  = forge_raster_buffer_create(W, H);
+    ForgeRasterBuffer tile = forge_raster_buffer_create(W, H);
+    ASSERT_TRUE(ref.pixels != NULL && tile.pixels != NULL);
+    size_t size = (size_t)ref.stride * (size_t)ref.height;
+    forge_raster_clear(&ref, 0.1f, 0.2f, 0.3f, 1.0f);
+    forge_raster_triangles_indexed(&ref, verts, TRIS * 3, indices,
+                                   TRIS * 3, NULL);
+
+    ASSERT_TRUE(forge_raster_pool_create(-1) == NULL);
+    ASSERT_TRUE(forge_raster_pool_thread_count(NULL) == 0);
+    forge_raster_pool_destroy(NULL);
+
+    /* One small draw per few triangles, like one per UI draw command;
+     * more workers than the buffer has tiles is fine too */
+    const int thread_counts[] = { 1, 2, 4, 0 };
+    for (int tc = 0; tc < (int)SDL_arraysize(thread_counts); tc++) {
+        ForgeRasterPool *pool = forge_raster_pool_create(thread_counts[tc]);
+        ASSERT_TRUE(pool != NULL);
+        if (thread_counts[tc] > 0) {
+            ASSERT_TRUE(forge_raster_pool_thread_count(pool) ==
+                        thread_counts[tc]);
+        }
+        ForgeRasterTileOpts opts = { 64, 0, pool };
+        for (int rep = 0; rep < 3; rep++) {
+            forge_raster_clear(&tile, 0.1f, 0.2f, 0.3f, 1.0f);
+            for (int t = 0; t < TRIS; t += PER_DRAW) {
+                int n = TRIS - t < PER_DRAW ? TRIS - t : PER_DRAW;
+                forge_raster_triangles_indexed_tiled(&tile, verts, TRIS * 3,
+                                                     &indices[t * 3], n * 3,
+                                                     NULL, &opts);
+            }
+            ASSERT_TRUE(SDL_memcmp(ref.pixels, tile.pixels, size) == 0);
+        }
+        forge_raster_pool_destroy(pool);
+    }
+
+    forge_raster_buffer_destroy(&ref);
+    forge_raster_buffer_destroy(&tile);
+}
+
+static void test_tiled_skips_bad_triangles(void)
+{
+    TEST("tiled: bad indices, NaN and off-screen triangles skipped");
+    ForgeRasterBuffer ref  = forge_raster_buffer_create(48, 40);
+    ForgeRasterBuffer tile = forge_raster_buffer_create(48, 40);
+    ASSERT_TRUE(ref.pixels != NULL && tile.pixels != NULL);
+    forge_raster_clear(&ref, 0.0f, 0.0f, 0.0f, 1.0f);
+    forge_raster_clear(&tile, 0.0f, 0.0f, 0.0f, 1.0f);
+
+    volatile float zero = 0.0f;
+    float nan_val = zero / zero;
+    ForgeRasterVertex verts[7] = {
+        { 1.0f,    2.0f,    0, 0,  1.0f, 0.0f, 0.0f, 0.7f },
+        { 46.0f,   5.0f,    0, 0,  0.0f, 1.0f, 0.0f, 0.7f },
+        { 20.0f,   39.0f,   0, 0,  0.0f, 0.0f, 1.0f, 0.7f },
+        { nan_val, 4.0f,    0, 0,  1.0f, 1.0f, 1.0f, 1.0f },
+        { -90.0f,  -90.0f,  0, 0,  1.0f, 1.0f, 1.0f, 1.0f },
+        { -50.0f,  -90.0f,  0, 0,  1.0f, 1.0f, 1.0f, 1.0f },
+        { -70.0f,  -40.0f,  0, 0,  1.0f, 1.0f, 1.0f, 1.0f },
+    };
+    /* Out-of-bounds index, NaN vertex, off-screen, then a valid triangle;
+     * the trailing two indices do not form a triangle */
+    Uint32 indices[14] = { 0, 1, 99,  3, 1, 2,  4, 5, 6,  0, 1, 2,  0, 1 };
+    ForgeRasterTileOpts opts = { 16, 4 };
+    forge_raster_triangles_indexed(&ref, verts, 7, indices, 14, NULL);
+    forge_raster_triangles_indexed_tiled(&tile, verts, 7, indices, 14, NULL,
+                                         &opts);
+    ASSERT_TRUE(SDL_memcmp(ref.pixels, tile.pixels,
+                           (size_t)ref.stride * (size_t)ref.height) == 0);
+
+    Uint8 r, g, b, a;
+    get_pixel(&tile, 20, 12, &r, &g, &b, &a);
+    ASSERT_TRUE(r > 0 || g > 0 || b > 0);
+
+    /* Invalid arguments draw nothing */
+    SDL_memcpy(ref.pixels, tile.pixels,
+               (size_t)ref.stride * (size_t)ref.height);
+    forge_raster_triangles_indexed_tiled(&tile, verts, 0, indices, 14, NULL,
+                                         &opts);
+    forge_raster_triangles_indexed_tiled(&tile, verts, 7, indices, -3, NULL,
+                                         &opts);
+    forge_raster_triangles_indexed_tiled(&tile, NULL, 7, indices, 14, NULL,
+                                         &opts);
+    forge_raster_triangles_indexed_tiled(NULL, verts, 7, indices, 14, NULL,
+                                         &opts);
+    ASSERT_TRUE(SDL_memcmp(ref.pixels, tile.pixels,
+                           (size_t)ref.stride * (size_t)ref.height) == 0);
+
+    forge_raster_buffer_destroy(&ref);
+    forge_raster_buffer_destroy(&tile);
+}
+
+/* ── SIMD Span Tests ─────────────────────────────────────────────────────── */
+
+static void test_simd_select(void)
+{
+    TEST("simd: set/get kernel, unsupported kernels rejected");
+    ASSERT_TRUE(forge_raster_simd_supported(FORGE_RASTER_SIMD_AUTO));
+    ASSERT_TRUE(forge_raster_simd_supported(FORGE_RASTER_SIMD_SCALAR));
+
+    /* AUTO resolves to a concrete, supported kernel */
+    ASSERT_TRUE(forge_raster_set_simd(FORGE_RASTER_SIMD_AUTO));
+    ForgeRasterSimd best = forge_raster_get_simd();
+    ASSERT_TRUE(best != FORGE_RASTER_SIMD_AUTO);
+    ASSERT_TRUE(forge_raster_simd_supported(best));
+
+    ASSERT_TRUE(forge_raster_set_simd(FORGE_RASTER_SIMD_SCALAR));
+    ASSERT_EQ_INT(forge_raster_get_simd(), FORGE_RASTER_SIMD_SCALAR);
+
+    /* SSE2 and NEON never share a build, so at least one of these fails
+     * and must leave the selection alone */
+    const ForgeRasterSimd kernels[] = {
+        FORGE_RASTER_SIMD_SSE2, FORGE_RASTER_SIMD_AVX2, FORGE_RASTER_SIMD_NEON
+    };
+    int rejected = 0;
+    for (int i = 0; i < (int)SDL_arraysize(kernels); i++) {
+        if (forge_raster_simd_supported(kernels[i])) continue;
+        ASSERT_TRUE(!forge_raster_set_simd(kernels[i]));
+        ASSERT_EQ_INT(forge_raster_get_simd(), FORGE_RASTER_SIMD_SCALAR);
+        rejected++;
+    }
+    ASSERT_TRUE(rejected > 0);
+    ASSERT_TRUE(!forge_raster_set_simd((ForgeRasterSimd)99));
+
+    forge_raster_set_simd(FORGE_RASTER_SIMD_AUTO);
+}
+
+/* Largest per-byte difference between two same-sized buffers */
+static int max_byte_diff(const ForgeRasterBuffer *a,
+                         const ForgeRasterBuffer *b)
+{
+    size_t size = (size_t)a->stride * (size_t)a->height;
+    int worst = 0;
+    for (size_t i = 0; i < size; i++) {
+        int d = (int)a->pixels[i] - (int)b->pixels[i];
+        if (d < 0) d = -d;
+        if (d > worst) worst = d;
+    }
+    return worst;
+}
+
+/* Overlapping translucent triangles, plain and textured, plus one quad
+ * per span length 1..24 so every SIMD body/tail split is exercised */
+static void draw_simd_scene(ForgeRasterBuffer *buf,
+                            const ForgeRasterVertex *verts, int vert_count,
+                            const Uint32 *indices,
+                            const ForgeRasterTexture *tex)
+{
+    forge_raster_clear(buf, 0.1f, 0.2f, 0.3f, 1.0f);
+    forge_raster_triangles_indexed(buf, verts, vert_count, indices,
+                                   vert_count, NULL);
+    forge_raster_triangles_indexed(buf, verts, vert_count, indices,
+                                   vert_count, tex);
+
+    for (int n = 1; n <= 24; n++) {
+        float x0 = 2.5f, x1 = 2.5f + (float)n;
+        float y0 = (float)(n * 2), y1 = y0 + 1.0f;
+        ForgeRasterVertex q[4] = {
+            { x0, y0, 0.0f, 0.0f,  1.0f, 0.0f, 0.2f, 0.9f },
+            { x1, y0, 1.0f, 0.0f,  0.0f, 1.0f, 0.4f, 0.5f },
+            { x1, y1, 1.0f, 1.0f,  0.3f, 0.2f, 1.0f, 0.7f },
+            { x0, y1, 0.0f, 1.0f,  0.8f, 0.8f, 0.0f, 1.0f },
+        };
+        Uint32 qi[6] = { 0, 1, 2, 0, 2, 3 };
+        forge_raster_triangles_indexed(buf, q, 4, qi, 6,
+                                       (n & 1) ? tex : NULL);
+    }
+}
+
+static void test_simd_matches_scalar(void)
+{
+    TEST("simd: every supported kernel within 1 LSB of scalar");
+    enum { W = 131, H = 97, TRIS = 120 };
+    ForgeRasterVertex verts[TRIS * 3];
+    Uint32 indices[TRIS * 3];
+    make_overlap_scene(verts, indices, TRIS, W, H);
+
+    Uint8 texels[8 * 8];
+    for (int i = 0; i < 64; i++) texels[i] = (Uint8)(i * 4 + 3);
+    ForgeRasterTexture tex = { texels, 8, 8, 0.0f };
+
+    ForgeRasterBuffer ref  = forge_raster_buffer_create(W, H);
+    ForgeRasterBuffer simd = forge_raster_buffer_create(W, H);
+    ASSERT_TRUE(ref.pixels != NULL && simd.pixels != NULL);
+
+    ASSERT_TRUE(forge_raster_set_simd(FORGE_RASTER_SIMD_SCALAR));
+    draw_simd_scene(&ref, verts, TRIS * 3, indices, &tex);
+
+    const ForgeRasterSimd kernels[] = {
+        FORGE_RASTER_SIMD_SSE2, FORGE_RASTER_SIMD_AVX2, FORGE_RASTER_SIMD_NEON
+    };
+    for (int i = 0; i < (int)SDL_arraysize(kernels); i++) {
+        if (!forge_raster_set_simd(kernels[i])) continue;
+        draw_simd_scene(&simd, verts, TRIS * 3, indices, &tex);
+        ASSERT_TRUE(max_byte_diff(&ref, &simd) <= 1);
+    }
+
+    forge_raster_set_simd(FORGE_RASTER_SIMD_AUTO);
+    forge_raster_buffer_destroy(&ref);
+    forge_raster_buffer_destroy(&simd);
+}
+
 /* ── Safety & Validation Tests ───────────────────────────────────────────── */
 
 static void test_buffer_create_max_dim(void)
@@ -604,7 +1448,7 @@ static void test_zero_size_texture(void)
     /* Texture with zero width -- sampling should be skipped entirely,
      * falling back to vertex colors only */
     Uint8 tex_pixel = 128;
-    ForgeRasterTexture tex = { &tex_pixel, 0, 1 };
+    ForgeRasterTexture tex = { &tex_pixel, 0, 1, 0.0f };
 
     ForgeRasterVertex v0 = { 0.0f, 0.0f, 0, 0, 1, 1, 1, 1 };
     ForgeRasterVertex v1 = { 8.0f, 0.0f, 0, 0, 1, 1, 1, 1 };
@@ -672,11 +1516,36 @@ int main(int argc, char *argv[])
     test_cw_winding();
     test_off_screen_triangle();
 
+    SDL_Log("-- Fill rule --");
+    test_fill_rule_top_left();
+    test_fill_rule_shared_edges();
+    test_fill_rule_fan_watertight();
+    test_subpixel_precision();
+
+    SDL_Log("-- Block classification --");
+    test_block_classes_match_pixels();
+    test_block_large_quad();
+
     SDL_Log("-- Indexed drawing --");
     test_indexed_drawing();
+    test_packed_indexed_matches_float();
+    test_scissor_matches_inside_rect();
+    test_scissor_out_of_range();
+    test_rects_match_inside_rects();
+
+    SDL_Log("-- Tiled drawing --");
+    test_tiled_matches_serial();
+    test_tiled_pool_reused();
+    test_tiled_skips_bad_triangles();
+
+    SDL_Log("-- SIMD spans --");
+    test_simd_select();
+    test_simd_matches_scalar();
 
     SDL_Log("-- Texture sampling --");
     test_texture_sampling();
+    test_sdf_sample();
+    test_sdf_edge_stays_sharp_when_magnified();
 
     SDL_Log("-- Alpha blending --");
     test_alpha_blending();
@@ -686,6 +1555,8 @@ int main(int argc, char *argv[])
 
     SDL_Log("-- Vertex layout --");
     test_vertex_layout_size();
+    test_packed_vertex_layout_size();
+    test_unpack_vertices();
 
     SDL_Log("-- Safety & validation --");
     test_buffer_create_max_dim();
@@ -0,0 +1,759 @@
+/*
+ * Raster 3D Pipeline Tests
+ *
+ * Automated tests for common/raster/forge_raster_3d.h -- depth buffers,
+ * depth testing, back-face culling, near-plane and guard-band clipping,
+ * perspective-correct interpolation, and vertex transformation of
+ * forge_obj-style interleaved vertices.
+ *
+ * Exit code: 0 if all tests pass, 1 if any test fails
+ *
+ * SPDX-License-Identifier: Zlib
+ */
+
+#include <SDL3/SDL.h>
+#include <assert.h>  /* assert() for defensive bounds checks in helpers */
+#include <string.h>  /* memcmp() for comparing framebuffers */
+#include "math/forge_math.h"
+#include "obj/forge_obj.h"
+#include "raster/forge_raster.h"
+#include "raster/forge_raster_3d.h"
+
+/* ── Test Framework ──────────────────────────────────────────────────────── */
+
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST(name)                                                \
+    do {                                                          \
+        test_count++;                                             \
+        SDL_Log("  [TEST] %s", name);                             \
+    } while (0)
+
+#define ASSERT_TRUE(expr)                                         \
+    do {                                                          \
+        if (!(expr)) {                                            \
+            SDL_Log("    FAIL: %s (line %d)", #expr, __LINE__);   \
+            fail_count++;                                         \
+            return;                                               \
+        }                                                         \
+        pass_count++;                                             \
+    } while (0)
+
+#define ASSERT_EQ_INT(a, b)                                       \
+    do {                                                          \
+        int _a = (a), _b = (b);                                   \
+        if (_a != _b) {                                           \
+            SDL_Log("    FAIL: %s == %d, expected %d (line %d)",  \
+                    #a, _a, _b, __LINE__);                        \
+            fail_count++;                                         \
+            return;                                               \
+        }                                                         \
+        pass_count++;                                             \
+    } while (0)
+
+#define ASSERT_NEAR_FLOAT(a, b, tol)                              \
+    do {                                                          \
+        float _a = (a), _b = (b);                                 \
+        if (!(SDL_fabsf(_a - _b) <= (tol))) {                     \
+            SDL_Log("    FAIL: %s == %f, expected %f +/-%f "      \
+                    "(line %d)", #a, _a, _b, (tol), __LINE__);    \
+            fail_count++;                                         \
+            return;                                               \
+        }                                                         \
+        pass_count++;                                             \
+    } while (0)
+
+/* Allow a tolerance of +/- tol for byte comparisons (rounding) */
+#define ASSERT_NEAR_BYTE(a, b, tol)                               \
+    do {                                                          \
+        Uint8 _a = (a), _b = (b);                                 \
+        int diff = (int)_a - (int)_b;                             \
+        if (diff < -(tol) || diff > (tol)) {                      \
+            SDL_Log("    FAIL: %s == %u, expected %u +/-%d "      \
+                    "(line %d)", #a, _a, _b, (tol), __LINE__);    \
+            fail_count++;                                         \
+            return;                                               \
+        }                                                         \
+        pass_count++;                                             \
+    } while (0)
+
+/* ── Helpers ─────────────────────────────────────────────────────────────── */
+
+#define TEST_SIZE 64
+
+/* Pointer to the RGBA bytes of pixel (x, y) */
+static const Uint8 *pixel_at(const ForgeRasterBuffer *buf, int x, int y)
+{
+    assert(x >= 0 && x < buf->width && "pixel_at: x out of bounds");
+    assert(y >= 0 && y < buf->height && "pixel_at: y out of bounds");
+    return buf->pixels + y * buf->stride + x * FORGE_RASTER_BPP;
+}
+
+/* A 90-degree, square perspective camera at the origin looking down -Z.
+ * With tan(fov/2) = 1, the view ray through NDC (nx, ny) is (nx, ny, -1). */
+static mat4 test_projection(void)
+{
+    return mat4_perspective(90.0f * FORGE_DEG2RAD, 1.0f, 0.1f, 100.0f);
+}
+
+/* Clip-space vertex for a view-space point */
+static ForgeRaster3dVertex make_vertex(mat4 mvp, float x, float y, float z,
+                                       float u, float v,
+                                       float r, float g, float b)
+{
+    ForgeRaster3dVertex out;
+    out.position = mat4_multiply_vec4(mvp, vec4_create(x, y, z, 1.0f));
+    out.u = u;
+    out.v = v;
+    out.r = r;
+    out.g = g;
+    out.b = b;
+    out.a = 1.0f;
+    return out;
+}
+
+/* Two triangles forming a quad facing the camera at depth z, spanning
+ * [-s, s] in x and y, wound counter-clockwise (front-facing) */
+static void make_quad(mat4 mvp, float z, float s, float r, float g, float b,
+                      ForgeRaster3dVertex out[6])
+{
+    out[0] = make_vertex(mvp, -s, -s, z, 0, 0, r, g, b);
+    out[1] = make_vertex(mvp,  s, -s, z, 1, 0, r, g, b);
+    out[2] = make_vertex(mvp,  s,  s, z, 1, 1, r, g, b);
+    out[3] = make_vertex(mvp, -s, -s, z, 0, 0, r, g, b);
+    out[4] = make_vertex(mvp,  s,  s, z, 1, 1, r, g, b);
+    out[5] = make_vertex(mvp, -s,  s, z, 0, 1, r, g, b);
+}
+
+/* Number of pixels with non-zero alpha */
+static int count_drawn(const ForgeRasterBuffer *buf)
+{
+    int n = 0;
+    for (int y = 0; y < buf->height; y++) {
+        for (int x = 0; x < buf->width; x++) {
+            if (pixel_at(buf, x, y)[3] != 0) n++;
+        }
+    }
+    return n;
+}
+
+/* ── Depth Buffer Tests ──────────────────────────────────────────────────── */
+
+static void test_depth_create(void)
+{
+    TEST("depth_create: float32 and unorm16");
+    ForgeRasterDepthBuffer d32 = forge_raster_depth_create(
+        16, 8, FORGE_RASTER_DEPTH_FLOAT32);
+    ASSERT_TRUE(d32.depth32 != NULL);
+    ASSERT_TRUE(d32.depth16 == NULL);
+    ASSERT_EQ_INT(d32.width, 16);
+    ASSERT_EQ_INT(d32.height, 8);
+
+    ForgeRasterDepthBuffer d16 = forge_raster_depth_create(
+        16, 8, FORGE_RASTER_DEPTH_UNORM16);
+    ASSERT_TRUE(d16.depth16 != NULL);
+    ASSERT_TRUE(d16.depth32 == NULL);
+
+    forge_raster_depth_clear(&d32, 0.25f);
+    forge_raster_depth_clear(&d16, 0.25f);
+    ASSERT_NEAR_FLOAT(forge_raster_depth_get(&d32, 15, 7), 0.25f, 0.0f);
+    ASSERT_NEAR_FLOAT(forge_raster_depth_get(&d16, 15, 7), 0.25f,
+                      1.0f / 65535.0f);
+
+    /* Out-of-range clear values clamp; outside pixels read as far */
+    forge_raster_depth_clear(&d16, 2.0f);
+    ASSERT_EQ_INT(d16.depth16[0], 65535);
+    ASSERT_NEAR_FLOAT(forge_raster_depth_get(&d32, 16, 0), 1.0f, 0.0f);
+
+    forge_raster_depth_destroy(&d32);
+    forge_raster_depth_destroy(&d16);
+    ASSERT_TRUE(d32.depth32 == NULL);
+    ASSERT_TRUE(d16.depth16 == NULL);
+
+    TEST("depth_create: invalid dimensions");
+    ForgeRasterDepthBuffer bad = forge_raster_depth_create(
+        0, 8, FORGE_RASTER_DEPTH_FLOAT32);
+    ASSERT_TRUE(bad.depth32 == NULL && bad.depth16 == NULL);
+    bad = forge_raster_depth_create(FORGE_RASTER_MAX_DIM + 1, 8,
+                                    FORGE_RASTER_DEPTH_UNORM16);
+    ASSERT_TRUE(bad.depth32 == NULL && bad.depth16 == NULL);
+    forge_raster_depth_destroy(&bad);
+    forge_raster_depth_destroy(NULL);
+}
+
+/* Draw a red quad at z = -5 and a smaller blue one at z = -2 in the given
+ * order; the blue one must cover the center either way */
+static void check_depth_order(ForgeRasterDepthFormat format, bool near_first)
+{
+    mat4 mvp = test_projection();
+    ForgeRaster3dVertex far_quad[6], near_quad[6];
+    make_quad(mvp, -5.0f, 4.0f, 1, 0, 0, far_quad);
+    make_quad(mvp, -2.0f, 0.5f, 0, 0, 1, near_quad);
+
+    ForgeRasterBuffer buf = forge_raster_buffer_create(TEST_SIZE, TEST_SIZE);
+    ForgeRasterDepthBuffer depth = forge_raster_depth_create(
+        TEST_SIZE, TEST_SIZE, format);
+    ASSERT_TRUE(buf.pixels != NULL);
+    forge_raster_clear(&buf, 0, 0, 0, 0);
+    forge_raster_depth_clear(&depth, 1.0f);
+
+    const ForgeRaster3dVertex *first  = near_first ? near_quad : far_quad;
+    const ForgeRaster3dVertex *second = near_first ? far_quad : near_quad;
+    forge_raster_triangles_3d(&buf, &depth, first, 6, NULL, 0, NULL, NULL);
+    forge_raster_triangles_3d(&buf, &depth, second, 6, NULL, 0, NULL, NULL);
+
+    const Uint8 *center = pixel_at(&buf, TEST_SIZE / 2, TEST_SIZE / 2);
+    ASSERT_EQ_INT(center[0], 0);
+    ASSERT_EQ_INT(center[2], 255);
+    const Uint8 *corner = pixel_at(&buf, 10, 10);
+    ASSERT_EQ_INT(corner[0], 255);
+
+    /* The stored depth is the projected z of the near quad */
+    vec4 clip = mat4_multiply_vec4(mvp, vec4_create(0, 0, -2.0f, 1.0f));
+    float tol = format == FORGE_RASTER_DEPTH_UNORM16 ? 1.0f / 65535.0f
+                                                     : 1e-5f;
+    ASSERT_NEAR_FLOAT(forge_raster_depth_get(&depth, TEST_SIZE / 2,
+                                             TEST_SIZE / 2),
+                      clip.z / clip.w, tol);
+
+    forge_raster_depth_destroy(&depth);
+    forge_raster_buffer_destroy(&buf);
+}
+
+static void test_depth_order(void)
+{
+    TEST("depth test: near over far, float32, far drawn first");
+    check_depth_order(FORGE_RASTER_DEPTH_FLOAT32, false);
+    TEST("depth test: near over far, float32, near drawn first");
+    check_depth_order(FORGE_RASTER_DEPTH_FLOAT32, true);
+    TEST("depth test: near over far, unorm16, far drawn first");
+    check_depth_order(FORGE_RASTER_DEPTH_UNORM16, false);
+    TEST("depth test: near over far, unorm16, near drawn first");
+    check_depth_order(FORGE_RASTER_DEPTH_UNORM16, true);
+}
+
+static void test_depth_funcs(void)
+{
+    mat4 mvp = test_projection();
+    ForgeRaster3dVertex red[6], green[6];
+    make_quad(mvp, -3.0f, 1.0f, 1, 0, 0, red);
+    make_quad(mvp, -3.0f, 1.0f, 0, 1, 0, green);
+
+    ForgeRasterBuffer buf = forge_raster_buffer_create(TEST_SIZE, TEST_SIZE);
+    ForgeRasterDepthBuffer depth = forge_raster_depth_create(
+        TEST_SIZE, TEST_SIZE, FORGE_RASTER_DEPTH_FLOAT32);
+    ASSERT_TRUE(buf.pixels != NULL && depth.depth32 != NULL);
+    int c = TEST_SIZE / 2;
+
+    TEST("depth func: LESS keeps the first of equal depths");
+    forge_raster_depth_clear(&depth, 1.0f);
+    forge_raster_triangles_3d(&buf, &depth, red, 6, NULL, 0, NULL, NULL);
+    forge_raster_triangles_3d(&buf, &depth, green, 6, NULL, 0, NULL, NULL);
+    ASSERT_EQ_INT(pixel_at(&buf, c, c)[0], 255);
+    ASSERT_EQ_INT(pixel_at(&buf, c, c)[1], 0);
+
+    TEST("depth func: LESS_EQUAL takes the last of equal depths");
+    ForgeRaster3dOpts opts = { FORGE_RASTER_CULL_BACK,
+                               FORGE_RASTER_DEPTH_LESS_EQUAL, false };
+    forge_raster_depth_clear(&depth, 1.0f);
+    forge_raster_triangles_3d(&buf, &depth, red, 6, NULL, 0, NULL, &opts);
+    forge_raster_triangles_3d(&buf, &depth, green, 6, NULL, 0, NULL, &opts);
+    ASSERT_EQ_INT(pixel_at(&buf, c, c)[0], 0);
+    ASSERT_EQ_INT(pixel_at(&buf, c, c)[1], 255);
+
+    TEST("depth func: ALWAYS draws a far surface over a near one");
+    ForgeRaster3dVertex far_quad[6];
+    make_quad(mvp, -9.0f, 3.0f, 0, 0, 1, far_quad);
+    opts.depth_func = FORGE_RASTER_DEPTH_ALWAYS;
+    forge_raster_triangles_3d(&buf, &depth, far_quad, 6, NULL, 0, NULL,
+                              &opts);
+    ASSERT_EQ_INT(pixel_at(&buf, c, c)[2], 255);
+
+    TEST("depth_read_only: tests without writing");
+    forge_raster_clear(&buf, 0, 0, 0, 0);
+    forge_raster_depth_clear(&depth, 1.0f);
+    ForgeRaster3dOpts ro = { FORGE_RASTER_CULL_BACK,
+                             FORGE_RASTER_DEPTH_LESS, true };
+    forge_raster_triangles_3d(&buf, &depth, red, 6, NULL, 0, NULL, &ro);
+    ASSERT_EQ_INT(pixel_at(&buf, c, c)[0], 255);
+    ASSERT_NEAR_FLOAT(forge_raster_depth_get(&depth, c, c), 1.0f, 0.0f);
+    /* Nothing was written, so a farther surface still passes */
+    forge_raster_triangles_3d(&buf, &depth, far_quad, 6, NULL, 0, NULL,
+                              NULL);
+    ASSERT_EQ_INT(pixel_at(&buf, c, c)[2], 255);
+
+    TEST("depth: NULL depth buffer draws in submission order");
+    forge_raster_triangles_3d(&buf, NULL, red, 6, NULL, 0, NULL, NULL);
+    forge_raster_triangles_3d(&buf, NULL, far_quad, 6, NULL, 0, NULL, NULL);
+    ASSERT_EQ_INT(pixel_at(&buf, c, c)[2], 255);
+
+    forge_raster_depth_destroy(&depth);
+    forge_raster_buffer_destroy(&buf);
+}
+
+/* ── Culling Tests ───────────────────────────────────────────────────────── */
+
+static void test_culling(void)
+{
+    mat4 mvp = test_projection();
+    ForgeRaster3dVertex front[6], back[6];
+    make_quad(mvp, -3.0f, 1.0f, 1, 1, 1, front);
+    /* Same quad with every triangle's winding reversed */
+    for (int i = 0; i < 6; i += 3) {
+        back[i + 0] = front[i + 0];
+        back[i + 1] = front[i + 2];
+        back[i + 2] = front[i + 1];
+    }
+
+    ForgeRasterBuffer buf = forge_raster_buffer_create(TEST_SIZE, TEST_SIZE);
+    ASSERT_TRUE(buf.pixels != NULL);
+
+    TEST("cull back (default): CCW drawn, CW culled");
+    forge_raster_clear(&buf, 0, 0, 0, 0);
+    forge_raster_triangles_3d(&buf, NULL, front, 6, NULL, 0, NULL, NULL);
+    int front_pixels = count_drawn(&buf);
+    ASSERT_TRUE(front_pixels > 0);
+    forge_raster_clear(&buf, 0, 0, 0, 0);
+    forge_raster_triangles_3d(&buf, NULL, back, 6, NULL, 0, NULL, NULL);
+    ASSERT_EQ_INT(count_drawn(&buf), 0);
+
+    TEST("cull front: CW drawn, CCW culled");
+    ForgeRaster3dOpts opts = { FORGE_RASTER_CULL_FRONT,
+                               FORGE_RASTER_DEPTH_LESS, false };
+    forge_raster_clear(&buf, 0, 0, 0, 0);
+    forge_raster_triangles_3d(&buf, NULL, front, 6, NULL, 0, NULL, &opts);
+    ASSERT_EQ_INT(count_drawn(&buf), 0);
+    forge_raster_triangles_3d(&buf, NULL, back, 6, NULL, 0, NULL, &opts);
+    ASSERT_EQ_INT(count_drawn(&buf), front_pixels);
+
+    TEST("cull none: both windings drawn");
+    opts.cull = FORGE_RASTER_CULL_NONE;
+    forge_raster_clear(&buf, 0, 0, 0, 0);
+    forge_raster_triangles_3d(&buf, NULL, back, 6, NULL, 0, NULL, &opts);
+    ASSERT_EQ_INT(count_drawn(&buf), front_pixels);
+
+    forge_raster_buffer_destroy(&buf);
+}
+
+/* ── Clipping Tests ──────────────────────────────────────────────────────── */
+
+static void test_near_plane_clipping(void)
+{
+    mat4 mvp = test_projection();
+    ForgeRasterBuffer buf = forge_raster_buffer_create(TEST_SIZE, TEST_SIZE);
+    ForgeRasterDepthBuffer depth = forge_raster_depth_create(
+        TEST_SIZE, TEST_SIZE, FORGE_RASTER_DEPTH_FLOAT32);
+    ASSERT_TRUE(buf.pixels != NULL && depth.depth32 != NULL);
+
+    TEST("near clip: floor passing under the camera is drawn");
+    /* A floor triangle at y = -1 reaching from behind the camera (z = +5,
+     * negative w) to z = -50.  Without clipping its projection is
+     * meaningless. */
+    ForgeRaster3dVertex floor_tri[3] = {
+        make_vertex(mvp, -10.0f, -1.0f,   5.0f, 0, 0, 1, 1, 1),
+        make_vertex(mvp,  10.0f, -1.0f,   5.0f, 0, 0, 1, 1, 1),
+        make_vertex(mvp,   0.0f, -1.0f, -50.0f, 0, 0, 1, 1, 1),
+    };
+    ASSERT_TRUE(floor_tri[0].position.w < 0.0f);
+    forge_raster_clear(&buf, 0, 0, 0, 0);
+    forge_raster_depth_clear(&depth, 1.0f);
+    forge_raster_triangles_3d(&buf, &depth, floor_tri, 3, NULL, 0, NULL,
+                              NULL);
+    /* Below the horizon: covered all the way to the bottom edge */
+    ASSERT_EQ_INT(pixel_at(&buf, TEST_SIZE / 2, TEST_SIZE - 1)[3], 255);
+    ASSERT_EQ_INT(pixel_at(&buf, 0, TEST_SIZE - 1)[3], 255);
+    ASSERT_EQ_INT(pixel_at(&buf, TEST_SIZE - 1, TEST_SIZE - 1)[3], 255);
+    /* Above the horizon: untouched */
+    ASSERT_EQ_INT(pixel_at(&buf, TEST_SIZE / 2, 0)[3], 0);
+    ASSERT_EQ_INT(pixel_at(&buf, TEST_SIZE / 2, TEST_SIZE / 2 - 1)[3], 0);
+    /* Every stored depth stays inside [0, 1] */
+    int out_of_range = 0;
+    for (int i = 0; i < TEST_SIZE * TEST_SIZE; i++) {
+        if (!(depth.depth32[i] >= 0.0f && depth.depth32[i] <= 1.0f)) {
+            out_of_range++;
+        }
+    }
+    ASSERT_EQ_INT(out_of_range, 0);
+
+    TEST("near clip: triangle entirely behind the camera draws nothing");
+    ForgeRaster3dVertex behind[3] = {
+        make_vertex(mvp, -1.0f, -1.0f, 2.0f, 0, 0, 1, 1, 1),
+        make_vertex(mvp,  1.0f, -1.0f, 2.0f, 0, 0, 1, 1, 1),
+        make_vertex(mvp,  0.0f,  1.0f, 2.0f, 0, 0, 1, 1, 1),
+    };
+    ForgeRaster3dOpts no_cull = { FORGE_RASTER_CULL_NONE,
+                                  FORGE_RASTER_DEPTH_LESS, false };
+    forge_raster_clear(&buf, 0, 0, 0, 0);
+    forge_raster_triangles_3d(&buf, NULL, behind, 3, NULL, 0, NULL,
+                              &no_cull);
+    ASSERT_EQ_INT(count_drawn(&buf), 0);
+
+    TEST("far clip: triangle beyond the far plane draws nothing");
+    ForgeRaster3dVertex beyond[3] = {
+        make_vertex(mvp, -1.0f, -1.0f, -200.0f, 0, 0, 1, 1, 1),
+        make_vertex(mvp,  1.0f, -1.0f, -200.0f, 0, 0, 1, 1, 1),
+        make_vertex(mvp,  0.0f,  1.0f, -200.0f, 0, 0, 1, 1, 1),
+    };
+    forge_raster_triangles_3d(&buf, NULL, beyond, 3, NULL, 0, NULL,
+                              &no_cull);
+    ASSERT_EQ_INT(count_drawn(&buf), 0);
+
+    forge_raster_depth_destroy(&depth);
+    forge_raster_buffer_destroy(&buf);
+}
+
+static void test_guard_band_clipping(void)
+{
+    TEST("guard band: huge triangle is clipped and covers the screen");
+    /* Vertices a million NDC units off screen -- far past the
+     * rasterizer's fixed-point range once projected */
+    ForgeRaster3dVertex huge[3];
+    float xs[3] = { -1.0e6f, 1.0e6f, 0.0f };
+    float ys[3] = { -1.0e6f, -1.0e6f, 1.0e6f };
+    for (int i = 0; i < 3; i++) {
+        huge[i].position = vec4_create(xs[i], ys[i], 0.5f, 1.0f);
+        huge[i].u = huge[i].v = 0.0f;
+        huge[i].r = huge[i].g = huge[i].b = huge[i].a = 1.0f;
+    }
+    ForgeRasterBuffer buf = forge_raster_buffer_create(TEST_SIZE, TEST_SIZE);
+    ASSERT_TRUE(buf.pixels != NULL);
+    forge_raster_clear(&buf, 0, 0, 0, 0);
+    forge_raster_triangles_3d(&buf, NULL, huge, 3, NULL, 0, NULL, NULL);
+    ASSERT_EQ_INT(count_drawn(&buf), TEST_SIZE * TEST_SIZE);
+    forge_raster_buffer_destroy(&buf);
+}
+
+static void test_clip_all_planes(void)
+{
+    TEST("clipping: triangle cut by all six planes yields 9 vertices");
+    /* Crosses the near plane (z < 0), the far plane (z > w) and all four
+     * guard-band sides -- each plane adds one vertex, the most the clip
+     * buffers have to hold */
+    float g = FORGE_RASTER_GUARD_BAND * 1.8f;
+    ForgeRaster3dVertex tri[3];
+    SDL_memset(tri, 0, sizeof(tri));
+    tri[0].position = vec4_create(g, 0.0f, -0.4f, 1.0f);
+    tri[1].position = vec4_create(-g, g, 0.5f, 1.0f);
+    tri[2].position = vec4_create(0.0f, -g, 1.4f, 1.0f);
+    for (int i = 0; i < 3; i++) tri[i].r = tri[i].a = 1.0f;
+
+    ForgeRaster3dVertex poly[FORGE_RASTER__CLIP_MAX_VERTS];
+    int n = forge_raster__clip_triangle(&tri[0], &tri[1], &tri[2],
+                                        (1 << FORGE_RASTER__CLIP_PLANES) - 1,
+                                        poly);
+    ASSERT_EQ_INT(n, 9);
+    for (int i = 0; i < n; i++) {
+        for (int plane = 0; plane < FORGE_RASTER__CLIP_PLANES; plane++) {
+            ASSERT_TRUE(forge_raster__clip_dist(poly[i].position, plane) >=
+                        -1e-3f);
+        }
+    }
+
+    TEST("clipping: drawing the 9-vertex polygon stays in bounds");
+    ForgeRaster3dOpts no_cull = { FORGE_RASTER_CULL_NONE,
+                                  FORGE_RASTER_DEPTH_LESS, false };
+    ForgeRasterBuffer buf = forge_raster_buffer_create(TEST_SIZE, TEST_SIZE);
+    ForgeRasterDepthBuffer depth = forge_raster_depth_create(
+        TEST_SIZE, TEST_SIZE, FORGE_RASTER_DEPTH_FLOAT32);
+    ASSERT_TRUE(buf.pixels != NULL && depth.depth32 != NULL);
+    forge_raster_clear(&buf, 0, 0, 0, 0);
+    forge_raster_depth_clear(&depth, 1.0f);
+    forge_raster_triangles_3d(&buf, &depth, tri, 3, NULL, 0, NULL, &no_cull);
+    ASSERT_TRUE(count_drawn(&buf) > 0);
+    forge_raster_depth_destroy(&depth);
+    forge_raster_buffer_destroy(&buf);
+}
+
+/* ── Interpolation Tests ─────────────────────────────────────────────────── */
+
+static void test_perspective_correct(void)
+{
+    TEST("perspective-correct: floor gradient matches the ray hit");
+    /* A floor quad at y = -1 from z = -1 to z = -9.  Red encodes the
+     * distance along the floor (0 near, 1 far) and green the position
+     * across it, so each pixel's color can be checked against where its
+     * view ray meets the floor. */
+    mat4 mvp = test_projection();
+    ForgeRaster3dVertex quad[6];
+    quad[0] = make_vertex(mvp, -4.0f, -1.0f, -1.0f, 0, 0, 0, 0, 0);
+    quad[1] = make_vertex(mvp,  4.0f, -1.0f, -1.0f, 0, 0, 0, 1, 0);
+    quad[2] = make_vertex(mvp,  4.0f, -1.0f, -9.0f, 0, 0, 1, 1, 0);
+    quad[3] = quad[0];
+    quad[4] = quad[2];
+    quad[5] = make_vertex(mvp, -4.0f, -1.0f, -9.0f, 0, 0, 1, 0, 0);
+
+    ForgeRasterBuffer buf = forge_raster_buffer_create(TEST_SIZE, TEST_SIZE);
+    ASSERT_TRUE(buf.pixels != NULL);
+    forge_raster_clear(&buf, 0, 0, 0, 0);
+    forge_raster_triangles_3d(&buf, NULL, quad, 6, NULL, 0, NULL, NULL);
+
+    int rows[3] = { 38, 46, 60 };
+    int cols[3] = { 20, 32, 44 };
+    float max_affine_error = 0.0f;
+    for (int j = 0; j < 3; j++) {
+        for (int i = 0; i < 3; i++) {
+            float nx = ((float)cols[i] + 0.5f) / TEST_SIZE * 2.0f - 1.0f;
+            float ny = 1.0f - ((float)rows[j] + 0.5f) / TEST_SIZE * 2.0f;
+            /* The ray (nx, ny, -1) * t meets y = -1 at t = -1 / ny */
+            float t = -1.0f / ny;
+            float hit_x = nx * t, hit_z = -t;
+            float depth_frac = (-1.0f - hit_z) / 8.0f;
+            float across = (hit_x + 4.0f) / 8.0f;
+
+            const Uint8 *p = pixel_at(&buf, cols[i], rows[j]);
+            ASSERT_NEAR_BYTE(p[0], (Uint8)(depth_frac * 255.0f + 0.5f), 2);
+            ASSERT_NEAR_BYTE(p[1], (Uint8)(across * 255.0f + 0.5f), 2);
+
+            /* Screen-linear interpolation along the floor would put the
+             * gradient where the rows are, not where the ray hits */
+            float ny_near = -1.0f, ny_far = -1.0f / 9.0f;
+            float affine = (ny - ny_near) / (ny_far - ny_near);
+            float err = SDL_fabsf(affine - depth_frac);
+            if (err > max_affine_error) max_affine_error = err;
+        }
+    }
+    /* ...which would be off by far more than the tolerance */
+    ASSERT_TRUE(max_affine_error > 0.2f);
+
+    forge_raster_buffer_destroy(&buf);
+}
+
+static void test_perspective_texture(void)
+{
+    TEST("perspective-correct: texture UVs use the same weights");
+    /* 2x1 coverage texture: left texel 0, right texel 255.  A quad slanted
+     * in depth with u = 0 at its near edge and u = 1 at its far edge
+     * switches at u = 0.5 -- the midpoint in view space, which is left
+     * of the midpoint on screen. */
+    Uint8 texels[2] = { 0, 255 };
+    ForgeRasterTexture tex = { texels, 2, 1, 0.0f };
+
+    mat4 mvp = test_projection();
+    ForgeRaster3dVertex quad[6];
+    quad[0] = make_vertex(mvp, -1.0f, -1.0f, -1.5f, 0, 0, 1, 1, 1);
+    quad[1] = make_vertex(mvp,  1.0f, -1.0f, -6.0f, 1, 0, 1, 1, 1);
+    quad[2] = make_vertex(mvp,  1.0f,  1.0f, -6.0f, 1, 1, 1, 1, 1);
+    quad[3] = quad[0];
+    quad[4] = quad[2];
+    quad[5] = make_vertex(mvp, -1.0f,  1.0f, -1.5f, 0, 1, 1, 1, 1);
+
+    ForgeRasterBuffer buf = forge_raster_buffer_create(TEST_SIZE, TEST_SIZE);
+    ASSERT_TRUE(buf.pixels != NULL);
+    forge_raster_clear(&buf, 0, 0, 0, 0);
+    forge_raster_triangles_3d(&buf, NULL, quad, 6, NULL, 0, &tex, NULL);
+
+    /* View-space midpoint (0, 0, -3.75) projects to NDC x = 0 -- the
+     * screen center.  The screen midpoint of the two edges is left of
+     * it, at x = (-1/1.5 + 1/6) / 2. */
+    int mid = TEST_SIZE / 2;
+    int row = TEST_SIZE / 2;
+    ASSERT_EQ_INT(pixel_at(&buf, mid - 2, row)[0], 0);
+    ASSERT_EQ_INT(pixel_at(&buf, mid + 1, row)[0], 255);
+    float screen_mid_ndc = (-1.0f / 1.5f + 1.0f / 6.0f) * 0.5f;
+    int screen_mid = (int)((screen_mid_ndc * 0.5f + 0.5f) * TEST_SIZE);
+    ASSERT_TRUE(screen_mid < mid - 4);
+    ASSERT_EQ_INT(pixel_at(&buf, screen_mid, row)[0], 0);
+
+    forge_raster_buffer_destroy(&buf);
+}
+
+/* ── Vertex Transform Tests ──────────────────────────────────────────────── */
+
+static void test_transform_obj_vertices(void)
+{
+    TEST("transform_vertices: strided ForgeObjVertex input");
+    ForgeObjVertex mesh[3];
+    SDL_memset(mesh, 0, sizeof(mesh));
+    mesh[0].position = vec3_create(-1.0f, -1.0f, -3.0f);
+    mesh[1].position = vec3_create( 1.0f, -1.0f, -3.0f);
+    mesh[2].position = vec3_create( 0.0f,  1.0f, -3.0f);
+    mesh[0].uv = vec2_create(0.0f, 0.0f);
+    mesh[1].uv = vec2_create(1.0f, 0.0f);
+    mesh[2].uv = vec2_create(0.5f, 1.0f);
+    mesh[0].normal = vec3_create(9.0f, 9.0f, 9.0f);  /* must be skipped */
+
+    mat4 mvp = mat4_multiply(test_projection(),
+                             mat4_translate(vec3_create(0.5f, 0, 0)));
+    ForgeRaster3dVertex out[3];
+    forge_raster_transform_vertices(mvp, &mesh[0].position, &mesh[0].uv,
+                                    sizeof(ForgeObjVertex), 3,
+                                    vec4_create(0.2f, 0.4f, 0.6f, 0.8f),
+                                    out);
+    for (int i = 0; i < 3; i++) {
+        vec3 p = mesh[i].position;
+        vec4 expect = mat4_multiply_vec4(
+            mvp, vec4_create(p.x, p.y, p.z, 1.0f));
+        ASSERT_NEAR_FLOAT(out[i].position.x, expect.x, 1e-6f);
+        ASSERT_NEAR_FLOAT(out[i].position.y, expect.y, 1e-6f);
+        ASSERT_NEAR_FLOAT(out[i].position.z, expect.z, 1e-6f);
+        ASSERT_NEAR_FLOAT(out[i].position.w, expect.w, 1e-6f);
+        ASSERT_NEAR_FLOAT(out[i].u, mesh[i].uv.x, 0.0f);
+        ASSERT_NEAR_FLOAT(out[i].v, mesh[i].uv.y, 0.0f);
+        ASSERT_NEAR_FLOAT(out[i].g, 0.4f, 0.0f);
+        ASSERT_NEAR_FLOAT(out[i].a, 0.8f, 0.0f);
+    }
+
+    TEST("transform_vertices: NULL uvs give zero texture coordinates");
+    forge_raster_transform_vertices(mvp, &mesh[0].position, NULL,
+                                    sizeof(ForgeObjVertex), 3,
+                                    vec4_create(1, 1, 1, 1), out);
+    ASSERT_NEAR_FLOAT(out[2].u, 0.0f, 0.0f);
+    ASSERT_NEAR_FLOAT(out[2].v, 0.0f, 0.0f);
+
+    TEST("transform_vertices: output draws as a front face");
+    ForgeRasterBuffer buf = forge_raster_buffer_create(TEST_SIZE, TEST_SIZE);
+    ASSERT_TRUE(buf.pixels != NULL);
+    forge_raster_clear(&buf, 0, 0, 0, 0);
+    forge_raster_triangles_3d(&buf, NULL, out, 3, NULL, 0, NULL, NULL);
+    ASSERT_TRUE(count_drawn(&buf) > 0);
+    forge_raster_buffer_destroy(&buf);
+}
+
+/* ── Indexed Drawing Tests ───────────────────────────────────────────────── */
+
+static void test_indexed_matches_list(void)
+{
+    TEST("triangles_3d: indexed quad matches the triangle list");
+    mat4 mvp = test_projection();
+    ForgeRaster3dVertex list[6];
+    make_quad(mvp, -2.5f, 1.0f, 0.3f, 0.6f, 0.9f, list);
+    ForgeRaster3dVertex shared[4] = { list[0], list[1], list[2], list[5] };
+    Uint32 indices[6] = { 0, 1, 2, 0, 2, 3 };
+
+    ForgeRasterBuffer a = forge_raster_buffer_create(TEST_SIZE, TEST_SIZE);
+    ForgeRasterBuffer b = forge_raster_buffer_create(TEST_SIZE, TEST_SIZE);
+    ASSERT_TRUE(a.pixels != NULL && b.pixels != NULL);
+    forge_raster_clear(&a, 0, 0, 0, 0);
+    forge_raster_clear(&b, 0, 0, 0, 0);
+    forge_raster_triangles_3d(&a, NULL, list, 6, NULL, 0, NULL, NULL);
+    forge_raster_triangles_3d(&b, NULL, shared, 4, indices, 6, NULL, NULL);
+    ASSERT_TRUE(count_drawn(&a) > 0);
+    ASSERT_TRUE(SDL_memcmp(a.pixels, b.pixels,
+                           (size_t)a.stride * (size_t)a.height) == 0);
+
+    TEST("triangles_3d: shared edges are drawn exactly once");
+    /* Half-transparent: a pixel blended twice would be brighter */
+    for (int i = 0; i < 4; i++) shared[i].a = 0.5f;
+    forge_raster_clear(&b, 0, 0, 0, 0);
+    forge_raster_triangles_3d(&b, NULL, shared, 4, indices, 6, NULL, NULL);
+    Uint8 alpha = pixel_at(&b, TEST_SIZE / 2, TEST_SIZE / 2)[3];
+    int mismatched = 0;
+    for (int y = 0; y < TEST_SIZE; y++) {
+        for (int x = 0; x < TEST_SIZE; x++) {
+            Uint8 pa = pixel_at(&b, x, y)[3];
+            int diff = (int)pa - (int)alpha;
+            if (pa != 0 && (diff < -1 || diff > 1)) mismatched++;
+        }
+    }
+    ASSERT_EQ_INT(mismatched, 0);
+
+    forge_raster_buffer_destroy(&a);
+    forge_raster_buffer_destroy(&b);
+}
+
+/* ── Safety & Validation Tests ───────────────────────────────────────────── */
+
+static void test_invalid_input(void)
+{
+    mat4 mvp = test_projection();
+    ForgeRaster3dVertex quad[6];
+    make_quad(mvp, -2.0f, 1.0f, 1, 1, 1, quad);
+    ForgeRasterBuffer buf = forge_raster_buffer_create(TEST_SIZE, TEST_SIZE);
+    ASSERT_TRUE(buf.pixels != NULL);
+    forge_raster_clear(&buf, 0, 0, 0, 0);
+
+    TEST("triangles_3d: NULL arguments are ignored");
+    forge_raster_triangles_3d(NULL, NULL, quad, 6, NULL, 0, NULL, NULL);
+    forge_raster_triangles_3d(&buf, NULL, NULL, 6, NULL, 0, NULL, NULL);
+    forge_raster_triangles_3d(&buf, NULL, quad, 0, NULL, 0, NULL, NULL);
+    forge_raster_transform_vertices(mvp, NULL, NULL, 0, 3,
+                                    vec4_create(1, 1, 1, 1), quad);
+    ASSERT_EQ_INT(count_drawn(&buf), 0);
+
+    TEST("triangles_3d: out-of-bounds indices are skipped");
+    Uint32 bad[6] = { 0, 1, 99, 0, 1, 2 };
+    forge_raster_triangles_3d(&buf, NULL, quad, 6, bad, 6, NULL, NULL);
+    ForgeRasterBuffer ref = forge_raster_buffer_create(TEST_SIZE, TEST_SIZE);
+    ASSERT_TRUE(ref.pixels != NULL);
+    forge_raster_clear(&ref, 0, 0, 0, 0);
+    forge_raster_triangles_3d(&ref, NULL, quad, 3, NULL, 0, NULL, NULL);
+    ASSERT_TRUE(SDL_memcmp(buf.pixels, ref.pixels,
+                           (size_t)buf.stride * (size_t)buf.height) == 0);
+    forge_raster_buffer_destroy(&ref);
+
+    TEST("triangles_3d: mismatched depth buffer draws nothing");
+    ForgeRasterDepthBuffer small = forge_raster_depth_create(
+        8, 8, FORGE_RASTER_DEPTH_FLOAT32);
+    forge_raster_clear(&buf, 0, 0, 0, 0);
+    forge_raster_triangles_3d(&buf, &small, quad, 6, NULL, 0, NULL, NULL);
+    ASSERT_EQ_INT(count_drawn(&buf), 0);
+    forge_raster_depth_destroy(&small);
+
+    TEST("triangles_3d: NaN and w = 0 vertices draw nothing");
+    volatile float zero = 0.0f;
+    ForgeRaster3dVertex nan_tri[3] = { quad[0], quad[1], quad[2] };
+    nan_tri[1].position.x = zero / zero;
+    forge_raster_triangles_3d(&buf, NULL, nan_tri, 3, NULL, 0, NULL, NULL);
+    ForgeRaster3dVertex w0_tri[3] = { quad[0], quad[1], quad[2] };
+    for (int i = 0; i < 3; i++) {
+        w0_tri[i].position = vec4_create((float)i, 1.0f - (float)i, 0, 0);
+    }
+    ForgeRaster3dOpts no_cull = { FORGE_RASTER_CULL_NONE,
+                                  FORGE_RASTER_DEPTH_LESS, false };
+    forge_raster_triangles_3d(&buf, NULL, w0_tri, 3, NULL, 0, NULL,
+                              &no_cull);
+    ASSERT_EQ_INT(count_drawn(&buf), 0);
+
+    forge_raster_buffer_destroy(&buf);
+}
+
+/* ── Main ────────────────────────────────────────────────────────────────── */
+
+int main(int argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    if (!SDL_Init(0)) {
+        SDL_Log("SDL_Init failed: %s", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("=== Raster 3D Pipeline Tests ===");
+    SDL_Log("");
+
+    SDL_Log("-- Depth buffer --");
+    test_depth_create();
+    test_depth_order();
+    test_depth_funcs();
+
+    SDL_Log("-- Culling --");
+    test_culling();
+
+    SDL_Log("-- Clipping --");
+    test_near_plane_clipping();
+    test_guard_band_clipping();
+    test_clip_all_planes();
+
+    SDL_Log("-- Perspective-correct interpolation --");
+    test_perspective_correct();
+    test_perspective_texture();
+
+    SDL_Log("-- Vertex transform --");
+    test_transform_obj_vertices();
+
+    SDL_Log("-- Indexed drawing --");
+    test_indexed_matches_list();
+
+    SDL_Log("-- Safety & validation --");
+    test_invalid_input();
+
+    SDL_Log("");
+    SDL_Log("=== Results: %d tests, %d assertions passed, %d failed ===",
+            test_count, pass_count, fail_count);
+
+    SDL_Quit();
+    return fail_count > 0 ? 1 : 0;
+}
@@ -0,0 +1,1602 @@
+/*
+ * UI Library Benchmarks
+ *
+ * Micro-benchmarks for hot paths in common/ui/forge_ui.h.  Each benchmark
+ * compares the current implementation against the straightforward approach
+ * it replaced, so regressions and wins are visible side by side.
+ *
+ * Benchmarks:
+ *   - Atlas glyph lookup: linear scan vs page table / hash, for synthetic
+ *     atlases of 100, 1,000 and 10,000 glyphs
+ *   - Glyph rasterization: reference scanline vs active edge table, for the
+ *     printable ASCII set of Liberation Mono at 16, 32, 64 and 128 px
+ *   - Analytic coverage vs 4x4 and 8x8 supersampling (same glyphs/sizes)
+ *   - Atlas build: serial vs worker threads, for every simple glyph the font
+ *     maps in the BMP, at 32 and 64 px
+ *   - Atlas packing: shelf vs skyline, power-of-two vs tight dimensions
+ *     (texture size and packing efficiency, plus build time)
+ *   - Label text: allocating forge_ui_text_layout plus a copy into the
+ *     draw buffers vs forge_ui_text_layout_into, and uncached layout vs the
+ *     context's text layout cache, for a frame of 50 and 500 short labels
+ *   - Vertex format: bytes handed to the renderer, emit throughput and
+ *     frame time for the float (32-byte) and packed (16-byte) layouts, for
+ *     a debug-overlay sized frame of 50,000 rects plus labels (~220k
+ *     vertices), and the packing pass alone (SIMD vs per-vertex)
+ *   - Clipped text: per-quad CPU clipping vs draw commands with scissor
+ *     rects, for a scrolled panel of 100 and 1,000 long rows
+ *   - Window composition: forge_ui_wctx_end copying 16 windows of property
+ *     rows into the main buffers (scalar vs SIMD index rebase) vs handing
+ *     them out as base-vertex segments
+ *   - Cached regions: full frames of 16 property windows declared every
+ *     frame vs replayed through forge_ui_wctx_window_begin_cached, with
+ *     and without one window moving
+ *   - Damage tracking: frame cost with and without tile hashing, and the
+ *     CPU rasterizer redrawing a 1280x720 grid of sliders in full vs only
+ *     the damage rects, idle and with one slider animating
+ *   - Widget state: per-frame cost of touching the state of 1,000 to
+ *     30,000 widgets through forge_ui_ctx_state vs a linear-search store
+ *   - Large lists: a scrolled log panel of 1,000 and 50,000 rows declared
+ *     in full vs only the rows forge_ui_ctx_list_clipper_begin reports
+ *   - Text layout throughput: glyphs per second laid out and measured for
+ *     an 8 KB ASCII paragraph and a Latin/Greek/Cyrillic UTF-8 one, with
+ *     and without a synthetic pair-kerning table
+ *   - Help text: measuring and laying out 8 KB and 64 KB of wrapped text in
+ *     a 600 px view every frame, directly vs through a ForgeUiParagraph,
+ *     with the width changing every frame and held steady
+ *
+ * Built alongside the tests but not registered with ctest — timings are
+ * machine-dependent and the runs take longer than unit tests.  Run the
+ * executable directly from the build directory:
+ *   ./bench_ui
+ *
+ * The rasterization benchmark loads the test font from assets/fonts/
+ * relative to the working directory and is skipped if it is missing.
+ *
+ * Exit code: 0 on success, 1 if a benchmark's results disagree with its
+ * reference implementation
+ *
+ * SPDX-License-Identifier: Zlib
+ */
+
+#include <SDL3/SDL.h>
+#include "ui/forge_ui.h"
+#include "ui/forge_ui_ctx.h"
+#include "ui/forge_ui_window.h"
+#include "raster/forge_raster.h"
+
+/* ── Timing helpers ──────────────────────────────────────────────────────── */
+
+static double bench_seconds(Uint64 start, Uint64 end)
+{
+    return (double)(end - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+/* Tiny xorshift PRNG so query sequences are reproducible across runs */
+static Uint32 bench_rng_state = 0x9E3779B9u;
+
+static Uint32 bench_rand(void)
+{
+    Uint32 x = bench_rng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    bench_rng_state = x;
+    return x;
+}
+
+/* ══════════════════════════════════════════════════════════════════════════ */
+/* ── Atlas glyph lookup ────────────────────────────────────────────────── */
+/* ══════════════════════════════════════════════════════════════════════════ */
+
+#define LOOKUP_QUERY_COUNT   4096      /* distinct queries, replayed per pass */
+#define LOOKUP_WORK_BUDGET   200000000 /* glyph comparisons per linear run */
+#define LOOKUP_FAST_PASSES   2000      /* passes over the queries (tables) */
+#define LOOKUP_MISS_RATE     8         /* one query in N is a miss */
+#define LOOKUP_SUPP_RATE     4         /* one glyph in N is above U+FFFF */
+
+/* The lookup as it was before the acceleration tables: a linear scan. */
+static const ForgeUiPackedGlyph *linear_lookup(const ForgeUiFontAtlas *atlas,
+                                               Uint32 codepoint)
+{
+    for (int i = 0; i < atlas->glyph_count; i++) {
+        if (atlas->glyphs[i].codepoint == codepoint) {
+            return &atlas->glyphs[i];
+        }
+    }
+    return NULL;
+}
+
+/* Assign codepoints the way a multi-script UI atlas would: mostly BMP text
+ * spread over several pages, with a minority of emoji-range codepoints. */
+static Uint32 synthetic_codepoint(int i)
+{
+    if (i % LOOKUP_SUPP_RATE == LOOKUP_SUPP_RATE - 1) {
+        return 0x1F300u + (Uint32)i;
+    }
+    return 0x20u + (Uint32)i * 3u;
+}
+
+static bool bench_atlas_lookup(int glyph_count)
+{
+    ForgeUiPackedGlyph *glyphs = (ForgeUiPackedGlyph *)SDL_calloc(
+        (size_t)glyph_count, sizeof(ForgeUiPackedGlyph));
+    Uint32 *queries = (Uint32 *)SDL_malloc(
+        LOOKUP_QUERY_COUNT * sizeof(Uint32));
+    if (!glyphs || !queries) {
+        SDL_Log("bench_atlas_lookup: allocation failed");
+        SDL_free(glyphs);
+        SDL_free(queries);
+        return false;
+    }
+
+    for (int i = 0; i < glyph_count; i++) {
+        glyphs[i].codepoint = synthetic_codepoint(i);
+    }
+
+    ForgeUiFontAtlas atlas;
+    SDL_memset(&atlas, 0, sizeof(atlas));
+    atlas.glyphs      = glyphs;
+    atlas.glyph_count = glyph_count;
+    if (!forge_ui__atlas_build_lookup(&atlas)) {
+        SDL_free(glyphs);
+        SDL_free(queries);
+        return false;
+    }
+
+    for (int q = 0; q < LOOKUP_QUERY_COUNT; q++) {
+        if (q % LOOKUP_MISS_RATE == 0) {
+            queries[q] = 0x0E000u + bench_rand() % 0x1000u;  /* private use */
+        } else {
+            queries[q] = synthetic_codepoint((int)(bench_rand() %
+                                                   (Uint32)glyph_count));
+        }
+    }
+
+    /* Verify both paths agree before timing anything */
+    bool ok = true;
+    for (int q = 0; q < LOOKUP_QUERY_COUNT; q++) {
+        if (forge_ui_atlas_lookup(&atlas, queries[q]) !=
+            linear_lookup(&atlas, queries[q])) {
+            SDL_Log("  MISMATCH: U+%04X", queries[q]);
+            ok = false;
+            break;
+        }
+    }
+
+    /* Scale linear passes so each glyph count does similar total work */
+    int linear_passes = LOOKUP_WORK_BUDGET /
+                        (glyph_count * LOOKUP_QUERY_COUNT / 2);
+    if (linear_passes < 1) linear_passes = 1;
+
+    /* Accumulate hit count so the compiler cannot drop the lookups */
+    Uint32 sink = 0;
+
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    for (int p = 0; p < linear_passes; p++) {
+        for (int q = 0; q < LOOKUP_QUERY_COUNT; q++) {
+            sink += linear_lookup(&atlas, queries[q]) != NULL;
+        }
+    }
+    Uint64 t1 = SDL_GetPerformanceCounter();
+    for (int p = 0; p < LOOKUP_FAST_PASSES; p++) {
+        for (int q = 0; q < LOOKUP_QUERY_COUNT; q++) {
+            sink += forge_ui_atlas_lookup(&atlas, queries[q]) != NULL;
+        }
+    }
+    Uint64 t2 = SDL_GetPerformanceCounter();
+
+    double linear_ns = bench_seconds(t0, t1) * 1e9 /
+                       ((double)linear_passes * LOOKUP_QUERY_COUNT);
+    double table_ns  = bench_seconds(t1, t2) * 1e9 /
+                       ((double)LOOKUP_FAST_PASSES * LOOKUP_QUERY_COUNT);
+    double speedup   = table_ns > 0.0 ? linear_ns / table_ns : 0.0;
+
+    SDL_Log("  %6d glyphs: linear %9.2f ns/lookup, table %6.2f ns/lookup "
+            "(%.0fx)  [sink %u]",
+            glyph_count, linear_ns, table_ns, speedup, sink);
+
+    SDL_free(atlas.lookup_pages);
+    SDL_free(atlas.lookup_hash);
+    SDL_free(glyphs);
+    SDL_free(queries);
+    return ok;
+}
+
+/* ══════════════════════════════════════════════════════════════════════════ */
+/* ── Glyph rasterization ───────────────────────────────────────────────── */
+/* ══════════════════════════════════════════════════════════════════════════ */
+
+#define RASTER_FONT_PATH "assets/fonts/liberation_mono/LiberationMono-Regular.ttf"
+#define RASTER_FIRST_CP  0x20
+#define RASTER_LAST_CP   0x7E
+#define RASTER_PIXEL_BUDGET 40000000.0  /* output pixels per timed method */
+
+/* Rasterize the whole ASCII set once; returns total output pixels, or -1
+ * on failure.  If out is non-NULL the bitmaps are kept for comparison. */
+static long long raster_ascii(const ForgeUiFont *font, float pixel_height,
+                              const ForgeUiRasterOpts *opts,
+                              ForgeUiGlyphBitmap *out)
+{
+    long long pixels = 0;
+    for (Uint32 cp = RASTER_FIRST_CP; cp <= RASTER_LAST_CP; cp++) {
+        Uint16 idx = forge_ui_ttf_glyph_index(font, cp);
+        ForgeUiGlyphBitmap bmp;
+        if (!forge_ui_rasterize_glyph(font, idx, pixel_height, opts, &bmp)) {
+            return -1;
+        }
+        pixels += (long long)bmp.width * bmp.height;
+        if (out) {
+            out[cp - RASTER_FIRST_CP] = bmp;
+        } else {
+            forge_ui_glyph_bitmap_free(&bmp);
+        }
+    }
+    return pixels;
+}
+
+static bool bench_rasterize(const ForgeUiFont *font, float pixel_height)
+{
+    enum { GLYPHS = RASTER_LAST_CP - RASTER_FIRST_CP + 1 };
+    ForgeUiGlyphBitmap ref[GLYPHS];
+    ForgeUiGlyphBitmap aet[GLYPHS];
+
+    ForgeUiRasterOpts ref_opts;
+    SDL_memset(&ref_opts, 0, sizeof(ref_opts));
+    ref_opts.supersample_level = 4;  /* what forge_ui_atlas_build uses */
+    ref_opts.method = FORGE_UI_RASTER_SCANLINE;
+    ForgeUiRasterOpts aet_opts = ref_opts;
+    aet_opts.method = FORGE_UI_RASTER_ACTIVE_EDGE;
+
+    /* Verify both paths agree before timing anything */
+    long long pixels = raster_ascii(font, pixel_height, &ref_opts, ref);
+    if (pixels < 0) return false;
+    if (raster_ascii(font, pixel_height, &aet_opts, aet) < 0) {
+        for (int i = 0; i < GLYPHS; i++) forge_ui_glyph_bitmap_free(&ref[i]);
+        return false;
+    }
+    bool ok = true;
+    for (int i = 0; i < GLYPHS; i++) {
+        size_t n = (size_t)ref[i].width * (size_t)ref[i].height;
+        if (ref[i].width != aet[i].width || ref[i].height != aet[i].height ||
+            (n > 0 && SDL_memcmp(ref[i].pixels, aet[i].pixels, n) != 0)) {
+            if (ok) {
+                SDL_Log("  MISMATCH: U+%04X at %.0fpx",
+                        RASTER_FIRST_CP + i, (double)pixel_height);
+            }
+            ok = false;
+        }
+        forge_ui_glyph_bitmap_free(&ref[i]);
+        forge_ui_glyph_bitmap_free(&aet[i]);
+    }
+
+    /* Repeat small sizes so every run rasterizes a similar pixel count */
+    int passes = (int)(RASTER_PIXEL_BUDGET / (double)(pixels > 0 ? pixels : 1));
+    if (passes < 1) passes = 1;
+
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    for (int p = 0; p < passes; p++) {
+        raster_ascii(font, pixel_height, &ref_opts, NULL);
+    }
+    Uint64 t1 = SDL_GetPerformanceCounter();
+    for (int p = 0; p < passes; p++) {
+        raster_ascii(font, pixel_height, &aet_opts, NULL);
+    }
+    Uint64 t2 = SDL_GetPerformanceCounter();
+
+    double ref_us  = bench_seconds(t0, t1) * 1e6 / ((double)passes * GLYPHS);
+    double aet_us  = bench_seconds(t1, t2) * 1e6 / ((double)passes * GLYPHS);
+    double speedup = aet_us > 0.0 ? ref_us / aet_us : 0.0;
+
+    SDL_Log("  %4.0f px: scanline %8.2f us/glyph, active edge %8.2f us/glyph "
+            "(%.1fx)", (double)pixel_height, ref_us, aet_us, speedup);
+    return ok;
+}
+
+/* Time one method over the ASCII set; returns microseconds per glyph. */
+static double time_raster(const ForgeUiFont *font, float pixel_height,
+                          const ForgeUiRasterOpts *opts)
+{
+    long long pixels = raster_ascii(font, pixel_height, opts, NULL);
+    if (pixels < 0) return -1.0;
+    int passes = (int)(RASTER_PIXEL_BUDGET / (double)(pixels > 0 ? pixels : 1));
+    if (passes < 1) passes = 1;
+
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    for (int p = 0; p < passes; p++) {
+        raster_ascii(font, pixel_height, opts, NULL);
+    }
+    Uint64 t1 = SDL_GetPerformanceCounter();
+    return bench_seconds(t0, t1) * 1e6 /
+           ((double)passes * (RASTER_LAST_CP - RASTER_FIRST_CP + 1));
+}
+
+static bool bench_analytic(const ForgeUiFont *font, float pixel_height)
+{
+    /* Supersampled baselines use the faster active edge path */
+    ForgeUiRasterOpts ss4;
+    SDL_memset(&ss4, 0, sizeof(ss4));
+    ss4.supersample_level = 4;
+    ss4.method = FORGE_UI_RASTER_ACTIVE_EDGE;
+    ForgeUiRasterOpts ss8 = ss4;
+    ss8.supersample_level = 8;
+    ForgeUiRasterOpts analytic;
+    SDL_memset(&analytic, 0, sizeof(analytic));
+    analytic.method = FORGE_UI_RASTER_ANALYTIC;
+
+    double ss4_us = time_raster(font, pixel_height, &ss4);
+    double ss8_us = time_raster(font, pixel_height, &ss8);
+    double an_us  = time_raster(font, pixel_height, &analytic);
+    if (ss4_us < 0.0 || ss8_us < 0.0 || an_us < 0.0) return false;
+
+    SDL_Log("  %4.0f px: 4x4 %8.2f us/glyph, 8x8 %8.2f us/glyph, "
+            "analytic %8.2f us/glyph (%.1fx vs 8x8)",
+            (double)pixel_height, ss4_us, ss8_us, an_us,
+            an_us > 0.0 ? ss8_us / an_us : 0.0);
+    return true;
+}
+
+/* ── Parallel atlas build ─────────────────────────────────────────────── */
+
+#define ATLAS_BUILD_PADDING 1
+
+/* True for glyphs with a simple outline.  Compound glyphs are skipped (and
+ * logged) by every build, which would drown the timings in log output. */
+static bool simple_glyph(const ForgeUiFont *font, Uint16 gi)
+{
+    Uint32 start = font->loca_offsets[gi];
+    if (font->loca_offsets[gi + 1] == start) return false;  /* empty */
+    return forge_ui__read_i16(font->data + font->glyf_offset + start) > 0;
+}
+
+/* Time one atlas build; returns seconds, or a negative value on failure. */
+static double time_atlas_build(const ForgeUiFont *font, float pixel_height,
+                               const Uint32 *codepoints, int count,
+                               int thread_count, ForgeUiFontAtlas *out)
+{
+    ForgeUiAtlasOpts opts;
+    SDL_memset(&opts, 0, sizeof(opts));
+    opts.thread_count = thread_count;
+
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    bool built = forge_ui_atlas_build_opts(font, pixel_height, codepoints,
+                                           count, ATLAS_BUILD_PADDING, &opts,
+                                           out);
+    Uint64 t1 = SDL_GetPerformanceCounter();
+    return built ? bench_seconds(t0, t1) : -1.0;
+}
+
+static bool bench_atlas_build(const ForgeUiFont *font, float pixel_height)
+{
+    Uint32 *codepoints = (Uint32 *)SDL_malloc(sizeof(Uint32) * 0x10000);
+    if (!codepoints) {
+        SDL_Log("bench_atlas_build: allocation failed");
+        return false;
+    }
+    int count = 0;
+    for (Uint32 c = 0x20; c < 0x10000; c++) {
+        Uint16 gi = forge_ui_ttf_glyph_index(font, c);
+        if (gi != 0 && simple_glyph(font, gi)) codepoints[count++] = c;
+    }
+
+    int cores = SDL_GetNumLogicalCPUCores();
+    if (cores > FORGE_UI_ATLAS_MAX_THREADS) cores = FORGE_UI_ATLAS_MAX_THREADS;
+
+    ForgeUiFontAtlas serial;
+    double serial_s = time_atlas_build(font, pixel_height, codepoints, count,
+                                       1, &serial);
+    if (serial_s < 0.0) {
+        SDL_free(codepoints);
+        return false;
+    }
+
+    bool ok = true;
+    int thread_counts[] = { 2, 4, cores };
+    for (int i = 0; i < (int)SDL_arraysize(thread_counts); i++) {
+        int threads = thread_counts[i];
+        if (threads < 2 || (i > 0 && threads <= thread_counts[i - 1])) continue;
+
+        ForgeUiFontAtlas parallel;
+        double par_s = time_atlas_build(font, pixel_height, codepoints, count,
+                                        threads, &parallel);
+        if (par_s < 0.0) {
+            ok = false;
+            continue;
+        }
+        bool same = parallel.width == serial.width
+            && parallel.height == serial.height
+            && SDL_memcmp(parallel.pixels, serial.pixels,
+                          (size_t)serial.width * (size_t)serial.height) == 0;
+        if (!same) {
+            SDL_Log("bench_atlas_build: %d-thread atlas differs from serial",
+                    threads);
+            ok = false;
+        }
+        SDL_Log("  %4.0f px, %d glyphs: serial %7.1f ms, %2d threads %7.1f ms "
+                "(%.1fx)", (double)pixel_height, count, serial_s * 1e3,
+                threads, par_s * 1e3, par_s > 0.0 ? serial_s / par_s : 0.0);
+        forge_ui_atlas_free(&parallel);
+    }
+
+    forge_ui_atlas_free(&serial);
+    SDL_free(codepoints);
+    return ok;
+}
+
+/* ── Atlas packing ────────────────────────────────────────────────────── */
+
+static bool bench_atlas_packing(const ForgeUiFont *font, float pixel_height,
+                                int glyph_limit)
+{
+    Uint32 *codepoints = (Uint32 *)SDL_malloc(sizeof(Uint32) * 0x10000);
+    if (!codepoints) {
+        SDL_Log("bench_atlas_packing: allocation failed");
+        return false;
+    }
+    int count = 0;
+    for (Uint32 c = 0x20; c < 0x10000 && count < glyph_limit; c++) {
+        Uint16 gi = forge_ui_ttf_glyph_index(font, c);
+        if (gi != 0 && simple_glyph(font, gi)) codepoints[count++] = c;
+    }
+
+    static const struct {
+        const char        *name;
+        ForgeUiAtlasPacker packer;
+        bool               npot;
+    } configs[] = {
+        { "shelf,   pow2", FORGE_UI_ATLAS_PACK_SHELF,   false },
+        { "skyline, pow2", FORGE_UI_ATLAS_PACK_SKYLINE, false },
+        { "shelf,   npot", FORGE_UI_ATLAS_PACK_SHELF,   true  },
+        { "skyline, npot", FORGE_UI_ATLAS_PACK_SKYLINE, true  },
+    };
+
+    bool ok = true;
+    for (int i = 0; i < (int)SDL_arraysize(configs); i++) {
+        ForgeUiAtlasOpts opts;
+        SDL_memset(&opts, 0, sizeof(opts));
+        opts.packer = configs[i].packer;
+        opts.non_power_of_two = configs[i].npot;
+
+        ForgeUiFontAtlas atlas;
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        bool built = forge_ui_atlas_build_opts(font, pixel_height, codepoints,
+                                               count, ATLAS_BUILD_PADDING,
+                                               &opts, &atlas);
+        Uint64 t1 = SDL_GetPerformanceCounter();
+        if (!built) {
+            ok = false;
+            continue;
+        }
+        SDL_Log("  %4.0f px, %3d glyphs, %s: %4dx%-4d %5.1f%% used "
+                "(%.1f ms)", (double)pixel_height, count, configs[i].name,
+                atlas.width, atlas.height,
+                (double)atlas.packing_efficiency * 100.0,
+                bench_seconds(t0, t1) * 1e3);
+        forge_ui_atlas_free(&atlas);
+    }
+
+    SDL_free(codepoints);
+    return ok;
+}
+
+/* ── Label text ──────────────────────────────────────────────────────────── */
+
+#define TEXT_BENCH_FRAMES 200
+
+/* One frame of label_count uncached labels, written straight into the
+ * context's draw buffers. */
+static void labels_into(ForgeUiContext *ctx, int label_count)
+{
+    char buf[32];
+    ForgeUiTextOpts opts = { 0.0f, FORGE_UI_TEXT_ALIGN_LEFT,
+                             1.0f, 1.0f, 1.0f, 1.0f };
+    ForgeUiTextSink sink = forge_ui__ctx_text_sink(ctx);
+    for (int i = 0; i < label_count; i++) {
+        SDL_snprintf(buf, sizeof(buf), "Setting %d: value", i);
+        forge_ui_text_layout_into(ctx->atlas, buf, 10.0f, (float)i * 20.0f,
+                                  &opts, &sink, NULL);
+    }
+}
+
+static bool bench_text_layout_into(const ForgeUiFontAtlas *atlas,
+                                   int label_count)
+{
+    ForgeUiContext ctx;
+    if (!forge_ui_ctx_init(&ctx, atlas)) return false;
+
+    char buf[32];
+    ForgeUiTextOpts opts = { 0.0f, FORGE_UI_TEXT_ALIGN_LEFT,
+                             1.0f, 1.0f, 1.0f, 1.0f };
+
+    /* Reference: allocate a layout per label, copy it, free it */
+    long long ref_vertices = 0;
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    for (int f = 0; f < TEXT_BENCH_FRAMES; f++) {
+        forge_ui_ctx_begin(&ctx, 0.0f, 0.0f, false);
+        for (int i = 0; i < label_count; i++) {
+            SDL_snprintf(buf, sizeof(buf), "Setting %d: value", i);
+            ForgeUiTextLayout layout;
+            if (forge_ui_text_layout(atlas, buf, 10.0f, (float)i * 20.0f,
+                                     &opts, &layout)) {
+                forge_ui__emit_text_layout(&ctx, &layout);
+                forge_ui_text_layout_free(&layout);
+            }
+        }
+        ref_vertices += ctx.vertex_count;
+        forge_ui_ctx_end(&ctx);
+    }
+    Uint64 t1 = SDL_GetPerformanceCounter();
+
+    long long into_vertices = 0;
+    Uint64 t2 = SDL_GetPerformanceCounter();
+    for (int f = 0; f < TEXT_BENCH_FRAMES; f++) {
+        forge_ui_ctx_begin(&ctx, 0.0f, 0.0f, false);
+        labels_into(&ctx, label_count);
+        into_vertices += ctx.vertex_count;
+        forge_ui_ctx_end(&ctx);
+    }
+    Uint64 t3 = SDL_GetPerformanceCounter();
+
+    double ref_us = bench_seconds(t0, t1) * 1e6 / TEXT_BENCH_FRAMES;
+    double into_us = bench_seconds(t2, t3) * 1e6 / TEXT_BENCH_FRAMES;
+    SDL_Log("  %4d labels: layout+copy %8.1f us/frame, into sink %8.1f "
+            "us/frame (%.1fx)", label_count, ref_us, into_us,
+            into_us > 0.0 ? ref_us / into_us : 0.0);
+
+    forge_ui_ctx_free(&ctx);
+    if (ref_vertices != into_vertices) {
+        SDL_Log("  MISMATCH: %lld vs %lld vertices",
+                ref_vertices, into_vertices);
+        return false;
+    }
+    return true;
+}
+
+static bool bench_text_cache(const ForgeUiFontAtlas *atlas, int label_count)
+{
+    ForgeUiContext ctx;
+    if (!forge_ui_ctx_init(&ctx, atlas)) return false;
+
+    /* Reference: lay every label out from scratch each frame */
+    long long ref_vertices = 0;
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    for (int f = 0; f < TEXT_BENCH_FRAMES; f++) {
+        forge_ui_ctx_begin(&ctx, 0.0f, 0.0f, false);
+        labels_into(&ctx, label_count);
+        ref_vertices += ctx.vertex_count;
+        forge_ui_ctx_end(&ctx);
+    }
+    Uint64 t1 = SDL_GetPerformanceCounter();
+
+    char buf[32];
+    long long cached_vertices = 0;
+    Uint64 t2 = SDL_GetPerformanceCounter();
+    for (int f = 0; f < TEXT_BENCH_FRAMES; f++) {
+        forge_ui_ctx_begin(&ctx, 0.0f, 0.0f, false);
+        for (int i = 0; i < label_count; i++) {
+            SDL_snprintf(buf, sizeof(buf), "Setting %d: value", i);
+            forge_ui_ctx_label(&ctx, buf, 10.0f, (float)i * 20.0f);
+        }
+        cached_vertices += ctx.vertex_count;
+        forge_ui_ctx_end(&ctx);
+    }
+    Uint64 t3 = SDL_GetPerformanceCounter();
+
+    double ref_us = bench_seconds(t0, t1) * 1e6 / TEXT_BENCH_FRAMES;
+    double cached_us = bench_seconds(t2, t3) * 1e6 / TEXT_BENCH_FRAMES;
+    SDL_Log("  %4d labels: uncached %8.1f us/frame, cached %8.1f us/frame "
+            "(%.1fx, %u hits, %u misses)", label_count, ref_us, cached_us,
+            cached_us > 0.0 ? ref_us / cached_us : 0.0,
+            (unsigned)ctx.text_cache.hits, (unsigned)ctx.text_cache.misses);
+
+    forge_ui_ctx_free(&ctx);
+    if (ref_vertices != cached_vertices) {
+        SDL_Log("  MISMATCH: %lld vs %lld vertices",
+                ref_vertices, cached_vertices);
+        return false;
+    }
+    return true;
+}
+
+/* ── Vertex format: float vs packed ─────────────────────────────────────── */
+
+#define VERTEX_BENCH_FRAMES 20
+
+/* A debug-overlay style frame: many small rects with a label per row */
+static void overlay_frame(ForgeUiContext *ctx, int rect_count)
+{
+    char buf[32];
+    forge_ui_ctx_begin(ctx, 0.0f, 0.0f, false);
+    for (int i = 0; i < rect_count; i++) {
+        ForgeUiRect r = { (float)(i % 250) * 4.0f, (float)(i / 250) * 4.0f,
+                          3.0f, 3.0f };
+        forge_ui__emit_rect(ctx, r, (float)(i & 255) / 255.0f, 0.5f,
+                            0.25f, 0.8f);
+        if (i % 250 == 0) {
+            SDL_snprintf(buf, sizeof(buf), "row %d: 250 samples", i / 250);
+            forge_ui_ctx_label(ctx, buf, 1000.0f, (float)(i / 250) * 4.0f);
+        }
+    }
+    forge_ui_ctx_end(ctx);
+}
+
+/* Time rect_count-rect frames in each vertex format: widget emission
+ * through ctx_end (which includes the packing pass), then the same plus
+ * the copy into an upload buffer that a renderer makes every frame
+ * (standing in for a mapped GPU transfer buffer).  The packing pass is
+ * also timed alone, SIMD vs the per-vertex reference. */
+static bool bench_vertex_format(const ForgeUiFontAtlas *atlas, int rect_count)
+{
+    static const struct {
+        const char         *name;
+        ForgeUiVertexFormat format;
+        size_t              vertex_size;
+    } configs[] = {
+        { "float ", FORGE_UI_VERTEX_FORMAT_FLOAT,  sizeof(ForgeUiVertex) },
+        { "packed", FORGE_UI_VERTEX_FORMAT_PACKED, sizeof(ForgeUiPackedVertex) },
+    };
+
+    bool ok = true;
+    int vertex_count[2] = { 0, 0 };
+    for (int c = 0; c < (int)SDL_arraysize(configs); c++) {
+        ForgeUiContext ctx;
+        if (!forge_ui_ctx_init(&ctx, atlas)) return false;
+        forge_ui_ctx_set_vertex_format(&ctx, configs[c].format);
+        overlay_frame(&ctx, rect_count);  /* warm buffers and text cache */
+
+        size_t upload_size = (size_t)ctx.vertex_count * configs[c].vertex_size;
+        void *upload = SDL_malloc(upload_size);
+        if (!upload) {
+            forge_ui_ctx_free(&ctx);
+            return false;
+        }
+
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        for (int f = 0; f < VERTEX_BENCH_FRAMES; f++) {
+            overlay_frame(&ctx, rect_count);
+        }
+        Uint64 t1 = SDL_GetPerformanceCounter();
+        for (int f = 0; f < VERTEX_BENCH_FRAMES; f++) {
+            overlay_frame(&ctx, rect_count);
+            const void *src = configs[c].format == FORGE_UI_VERTEX_FORMAT_PACKED
+                            ? (const void *)ctx.packed_vertices
+                            : (const void *)ctx.vertices;
+            SDL_memcpy(upload, src, upload_size);
+        }
+        Uint64 t2 = SDL_GetPerformanceCounter();
+
+        vertex_count[c] = ctx.vertex_count;
+        if (configs[c].format == FORGE_UI_VERTEX_FORMAT_PACKED &&
+            ctx.packed_vertex_count != ctx.vertex_count) {
+            ok = false;
+        }
+        double emit_ms = bench_seconds(t0, t1) * 1e3 / VERTEX_BENCH_FRAMES;
+        double total_ms = bench_seconds(t1, t2) * 1e3 / VERTEX_BENCH_FRAMES;
+        double mverts = (double)ctx.vertex_count / (emit_ms * 1e3);
+        SDL_Log("  %s: %d vertices, %6.2f MB/frame, emit %.2f ms/frame "
+                "(%.0f Mvert/s), emit + upload copy %.2f ms/frame",
+                configs[c].name, ctx.vertex_count,
+                (double)upload_size / (1024.0 * 1024.0), emit_ms, mverts,
+                total_ms);
+
+        /* The packing pass alone over the float frame */
+        if (configs[c].format == FORGE_UI_VERTEX_FORMAT_PACKED) {
+            int n = ctx.vertex_count;
+            ForgeUiPackedVertex *ref = (ForgeUiPackedVertex *)SDL_malloc(
+                (size_t)n * sizeof(ForgeUiPackedVertex));
+            if (!ref) {
+                SDL_free(upload);
+                forge_ui_ctx_free(&ctx);
+                return false;
+            }
+            Uint64 p0 = SDL_GetPerformanceCounter();
+            for (int f = 0; f < VERTEX_BENCH_FRAMES; f++) {
+                for (int v = 0; v < n; v++) {
+                    forge_ui__pack_vertex(&ctx.vertices[v], &ref[v]);
+                }
+            }
+            Uint64 p1 = SDL_GetPerformanceCounter();
+            for (int f = 0; f < VERTEX_BENCH_FRAMES; f++) {
+                forge_ui_pack_vertices(ctx.vertices, ctx.packed_vertices, n);
+            }
+            Uint64 p2 = SDL_GetPerformanceCounter();
+            if (SDL_memcmp(ref, ctx.packed_vertices,
+                           (size_t)n * sizeof(ForgeUiPackedVertex)) != 0) {
+                SDL_Log("  MISMATCH: SIMD and reference packing differ");
+                ok = false;
+            }
+            SDL_Log("          pack pass: reference %.3f ms, SIMD %.3f ms",
+                    bench_seconds(p0, p1) * 1e3 / VERTEX_BENCH_FRAMES,
+                    bench_seconds(p1, p2) * 1e3 / VERTEX_BENCH_FRAMES);
+            SDL_free(ref);
+        }
+        SDL_free(upload);
+        forge_ui_ctx_free(&ctx);
+    }
+
+    if (vertex_count[0] != vertex_count[1]) {
+        SDL_Log("  MISMATCH: %d vs %d vertices",
+                vertex_count[0], vertex_count[1]);
+        ok = false;
+    }
+    return ok;
+}
+
+/* ── Clipping: CPU per-quad vs draw command scissor ─────────────────────── */
+
+#define CLIP_BENCH_FRAMES 200
+
+/* A scrolled panel of row_count long rows: every visible row runs past
+ * the panel's right edge, and rows above and below are scrolled out */
+static void clipped_panel_frame(ForgeUiContext *ctx, int row_count)
+{
+    char buf[96];
+    float scroll_y = (float)row_count * 8.0f;
+    forge_ui_ctx_begin(ctx, 0.0f, 0.0f, false);
+    ForgeUiRect rect = { 20.0f, 20.0f, 300.0f, 600.0f };
+    if (forge_ui_ctx_panel_begin(ctx, "Log", rect, &scroll_y)) {
+        for (int i = 0; i < row_count; i++) {
+            SDL_snprintf(buf, sizeof(buf),
+                         "[%05d] frame time 16.7 ms, draw calls 12, "
+                         "vertices 4096", i);
+            forge_ui_ctx_label_layout(ctx, buf, 16.0f);
+        }
+        forge_ui_ctx_panel_end(ctx);
+    }
+    forge_ui_ctx_end(ctx);
+}
+
+static bool bench_clip_mode(const ForgeUiFontAtlas *atlas, int row_count)
+{
+    double us[2];
+    int vertices[2], cmds[2];
+    for (int mode = 0; mode < 2; mode++) {
+        ForgeUiContext ctx;
+        if (!forge_ui_ctx_init(&ctx, atlas)) return false;
+        forge_ui_ctx_set_draw_commands(&ctx, mode == 1);
+        clipped_panel_frame(&ctx, row_count);  /* warm buffers and cache */
+
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        for (int f = 0; f < CLIP_BENCH_FRAMES; f++) {
+            clipped_panel_frame(&ctx, row_count);
+        }
+        Uint64 t1 = SDL_GetPerformanceCounter();
+
+        us[mode] = bench_seconds(t0, t1) * 1e6 / CLIP_BENCH_FRAMES;
+        vertices[mode] = ctx.vertex_count;
+        cmds[mode] = ctx.draw_cmd_count;
+        forge_ui_ctx_free(&ctx);
+    }
+    SDL_Log("  %4d rows: CPU clip %8.1f us/frame (%d vertices), "
+            "scissor %8.1f us/frame (%d vertices, %d commands, %.1fx)",
+            row_count, us[0], vertices[0], us[1], vertices[1], cmds[1],
+            us[1] > 0.0 ? us[0] / us[1] : 0.0);
+    return cmds[1] > 0;
+}
+
+/* ── Window composition: compact vs segments ────────────────────────────── */
+
+#define COMPOSE_BENCH_FRAMES 200
+#define COMPOSE_WINDOWS      FORGE_UI_WINDOW_MAX
+
+/* Declare COMPOSE_WINDOWS tall windows of label + slider property rows,
+ * leaving the frame ready for forge_ui_wctx_end */
+static void compose_declare(ForgeUiWindowContext *wctx,
+                            ForgeUiWindowState *states, int rows)
+{
+    char buf[48];
+    ForgeUiContext *ctx = wctx->ctx;
+    forge_ui_ctx_begin(ctx, -1.0f, -1.0f, false);
+    forge_ui_wctx_begin(wctx);
+    for (int w = 0; w < COMPOSE_WINDOWS; w++) {
+        SDL_snprintf(buf, sizeof(buf), "Inspector %d", w);
+        if (!forge_ui_wctx_window_begin(wctx, buf, &states[w])) continue;
+        for (int r = 0; r < rows; r++) {
+            float value = (float)r;
+            SDL_snprintf(buf, sizeof(buf), "property_%03d", r);
+            forge_ui_ctx_label_layout(ctx, buf, 18.0f);
+            SDL_snprintf(buf, sizeof(buf), "##s%d", r);
+            forge_ui_ctx_slider_layout(ctx, buf, &value, 0.0f, 100.0f, 18.0f);
+        }
+        forge_ui_wctx_window_end(wctx);
+    }
+}
+
+/* The copy loop forge_ui_wctx_end used before: scalar index rebase */
+static void compose_scalar(ForgeUiWindowContext *wctx)
+{
+    ForgeUiContext *ctx = wctx->ctx;
+    forge_ui_win__sort_entries(wctx->window_entries, wctx->window_count);
+    for (int w = 0; w < wctx->window_count; w++) {
+        ForgeUiWindowEntry *entry = &wctx->window_entries[w];
+        if (!forge_ui__grow_vertices(ctx, entry->vertex_count) ||
+            !forge_ui__grow_indices(ctx, entry->index_count)) {
+            continue;
+        }
+        Uint32 base = (Uint32)ctx->vertex_count;
+        SDL_memcpy(&ctx->vertices[ctx->vertex_count], entry->vertices,
+                   (size_t)entry->vertex_count * sizeof(ForgeUiVertex));
+        ctx->vertex_count += entry->vertex_count;
+        for (int i = 0; i < entry->index_count; i++) {
+            ctx->indices[ctx->index_count + i] = entry->indices[i] + base;
+        }
+        ctx->index_count += entry->index_count;
+    }
+}
+
+static bool bench_window_compose(const ForgeUiFontAtlas *atlas, int rows)
+{
+    static const char *names[3] = { "scalar copy", "SIMD copy  ", "segments   " };
+    ForgeUiWindowState states[COMPOSE_WINDOWS];
+    double us[3];
+    int vertices[3];
+    for (int mode = 0; mode < 3; mode++) {
+        ForgeUiContext ctx;
+        ForgeUiWindowContext wctx;
+        if (!forge_ui_ctx_init(&ctx, atlas)) return false;
+        if (!forge_ui_wctx_init(&wctx, &ctx)) {
+            forge_ui_ctx_free(&ctx);
+            return false;
+        }
+        if (mode == 2) {
+            forge_ui_wctx_set_compose_mode(&wctx,
+                                           FORGE_UI_WINDOW_COMPOSE_SEGMENTS);
+        }
+        for (int w = 0; w < COMPOSE_WINDOWS; w++) {
+            SDL_memset(&states[w], 0, sizeof(states[w]));
+            states[w].rect = (ForgeUiRect){ (float)w * 30.0f, (float)w * 20.0f,
+                                            320.0f, (float)rows * 60.0f + 80.0f };
+            states[w].z_order = COMPOSE_WINDOWS - w;
+        }
+
+        /* Only the composition step is timed */
+        Uint64 total = 0;
+        for (int f = 0; f <= COMPOSE_BENCH_FRAMES; f++) {
+            compose_declare(&wctx, states, rows);
+            Uint64 t0 = SDL_GetPerformanceCounter();
+            if (mode == 0) compose_scalar(&wctx);
+            else forge_ui_wctx_end(&wctx);
+            Uint64 t1 = SDL_GetPerformanceCounter();
+            forge_ui_ctx_end(&ctx);
+            if (f > 0) total += t1 - t0;  /* frame 0 warms the buffers */
+        }
+        us[mode] = bench_seconds(0, total) * 1e6 / COMPOSE_BENCH_FRAMES;
+
+        vertices[mode] = 0;
+        if (mode == 2) {
+            for (int i = 0; i < wctx.segment_count; i++) {
+                vertices[mode] += wctx.segments[i].vertex_count;
+            }
+        } else {
+            vertices[mode] = ctx.vertex_count;
+        }
+        forge_ui_wctx_free(&wctx);
+        forge_ui_ctx_free(&ctx);
+    }
+    for (int mode = 0; mode < 3; mode++) {
+        SDL_Log("  %3d rows x %d windows, %s: %8.2f us/frame (%d vertices)",
+                rows, COMPOSE_WINDOWS, names[mode], us[mode], vertices[mode]);
+    }
+    if (vertices[0] != vertices[1] || vertices[0] != vertices[2]) {
+        SDL_Log("  MISMATCH: %d / %d / %d vertices",
+                vertices[0], vertices[1], vertices[2]);
+        return false;
+    }
+    return true;
+}
+
+/* ── Cached regions: declare vs replay ──────────────────────────────────── */
+
+#define REGION_BENCH_FRAMES 200
+
+/* One full frame of COMPOSE_WINDOWS property windows.  moving shifts the
+ * first window by a pixel each frame. */
+static void region_frame(ForgeUiWindowContext *wctx,
+                         ForgeUiWindowState *states, int rows,
+                         bool cached, bool moving, int frame)
+{
+    char buf[48];
+    ForgeUiContext *ctx = wctx->ctx;
+    forge_ui_ctx_begin(ctx, -1.0f, -1.0f, false);
+    forge_ui_wctx_begin(wctx);
+    if (moving) states[0].rect.x = 30.0f + (float)(frame % 64);
+    for (int w = 0; w < COMPOSE_WINDOWS; w++) {
+        SDL_snprintf(buf, sizeof(buf), "Inspector %d", w);
+        bool open = cached
+            ? forge_ui_wctx_window_begin_cached(wctx, buf, &states[w], 1)
+            : forge_ui_wctx_window_begin(wctx, buf, &states[w]);
+        if (!open) continue;
+        for (int r = 0; r < rows; r++) {
+            float value = (float)r;
+            SDL_snprintf(buf, sizeof(buf), "property_%03d", r);
+            forge_ui_ctx_label_layout(ctx, buf, 18.0f);
+            SDL_snprintf(buf, sizeof(buf), "##s%d", r);
+            forge_ui_ctx_slider_layout(ctx, buf, &value, 0.0f, 100.0f, 18.0f);
+        }
+        forge_ui_wctx_window_end(wctx);
+    }
+    forge_ui_wctx_end(wctx);
+    forge_ui_ctx_end(ctx);
+}
+
+static bool bench_region_cache(const ForgeUiFontAtlas *atlas, int rows)
+{
+    static const char *names[3] = { "declared      ", "cached        ",
+                                    "cached, moving" };
+    ForgeUiWindowState states[COMPOSE_WINDOWS];
+    int vertices[3];
+    for (int mode = 0; mode < 3; mode++) {
+        ForgeUiContext ctx;
+        ForgeUiWindowContext wctx;
+        if (!forge_ui_ctx_init(&ctx, atlas)) return false;
+        if (!forge_ui_wctx_init(&wctx, &ctx)) {
+            forge_ui_ctx_free(&ctx);
+            return false;
+        }
+        for (int w = 0; w < COMPOSE_WINDOWS; w++) {
+            SDL_memset(&states[w], 0, sizeof(states[w]));
+            states[w].rect = (ForgeUiRect){ (float)w * 30.0f, (float)w * 20.0f,
+                                            320.0f, (float)rows * 60.0f + 80.0f };
+            states[w].z_order = COMPOSE_WINDOWS - w;
+        }
+
+        region_frame(&wctx, states, rows, mode > 0, mode == 2, 0);  /* warm */
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        for (int f = 1; f <= REGION_BENCH_FRAMES; f++) {
+            region_frame(&wctx, states, rows, mode > 0, mode == 2, f);
+        }
+        Uint64 t1 = SDL_GetPerformanceCounter();
+        vertices[mode] = ctx.vertex_count;
+        SDL_Log("  %3d rows x %d windows, %s: %8.2f us/frame "
+                "(%d vertices, %u replays)",
+                rows, COMPOSE_WINDOWS, names[mode],
+                bench_seconds(t0, t1) * 1e6 / REGION_BENCH_FRAMES,
+                vertices[mode], (unsigned)ctx.region_cache.hits);
+        forge_ui_wctx_free(&wctx);
+        forge_ui_ctx_free(&ctx);
+    }
+    if (vertices[0] != vertices[1] || vertices[0] != vertices[2]) {
+        SDL_Log("  MISMATCH: %d / %d / %d vertices",
+                vertices[0], vertices[1], vertices[2]);
+        return false;
+    }
+    return true;
+}
+
+/* ── Damage tracking: full vs partial redraw ────────────────────────────── */
+
+#define DAMAGE_BENCH_W       1280
+#define DAMAGE_BENCH_H       720
+#define DAMAGE_BENCH_COLS    4
+#define DAMAGE_BENCH_ROWS    24
+#define DAMAGE_BENCH_FRAMES  100
+
+/* A settings screen: a grid of labelled sliders.  If animate is set the
+ * first slider's value follows the frame number. */
+static void damage_frame(ForgeUiContext *ctx, bool animate, int frame)
+{
+    char buf[48];
+    forge_ui_ctx_begin(ctx, -1.0f, -1.0f, false);
+    for (int c = 0; c < DAMAGE_BENCH_COLS; c++) {
+        for (int r = 0; r < DAMAGE_BENCH_ROWS; r++) {
+            float x = 20.0f + (float)c * 310.0f;
+            float y = 16.0f + (float)r * 29.0f;
+            float value = (float)((c * 7 + r * 13) % 100);
+            if (animate && c == 0 && r == 0) value = (float)(frame % 100);
+            SDL_snprintf(buf, sizeof(buf), "setting_%d_%02d", c, r);
+            forge_ui_ctx_label(ctx, buf, x, y + 14.0f);
+            SDL_snprintf(buf, sizeof(buf), "##d%d_%d", c, r);
+            forge_ui_ctx_slider(ctx, buf, &value, 0.0f, 100.0f,
+                                (ForgeUiRect){ x + 120.0f, y, 170.0f, 22.0f });
+        }
+    }
+    forge_ui_ctx_end(ctx);
+}
+
+static bool bench_damage(const ForgeUiFontAtlas *atlas, bool animate)
+{
+    ForgeRasterTexture tex = { atlas->pixels, atlas->width, atlas->height, 0.0f };
+    ForgeRasterBuffer full = forge_raster_buffer_create(DAMAGE_BENCH_W, DAMAGE_BENCH_H);
+    ForgeRasterBuffer part = forge_raster_buffer_create(DAMAGE_BENCH_W, DAMAGE_BENCH_H);
+    ForgeUiContext plain, tracked;
+    bool ok = full.pixels && part.pixels;
+    ok = ok && forge_ui_ctx_init(&plain, atlas);
+    ok = ok && forge_ui_ctx_init(&tracked, atlas);
+    ok = ok && forge_ui_ctx_set_damage_tracking(&tracked, DAMAGE_BENCH_W,
+                                                DAMAGE_BENCH_H);
+    if (!ok) {
+        SDL_Log("  setup failed");
+        return false;
+    }
+
+    /* Frame cost with and without tracking */
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    for (int f = 0; f < DAMAGE_BENCH_FRAMES; f++) damage_frame(&plain, animate, f);
+    Uint64 t1 = SDL_GetPerformanceCounter();
+    for (int f = 0; f < DAMAGE_BENCH_FRAMES; f++) damage_frame(&tracked, animate, f);
+    Uint64 t2 = SDL_GetPerformanceCounter();
+
+    /* Redraw cost: the whole screen vs only the damage rects.  Start
+     * from a fully drawn frame, as a presenter would. */
+    forge_ui_ctx_damage_reset(&tracked);
+    damage_frame(&tracked, animate, DAMAGE_BENCH_FRAMES - 1);
+    const ForgeRasterVertex *verts = (const ForgeRasterVertex *)tracked.vertices;
+    forge_raster_clear(&part, 0.0f, 0.0f, 0.0f, 1.0f);
+    forge_raster_triangles_indexed(&part, verts, tracked.vertex_count,
+                                   tracked.indices, tracked.index_count, &tex);
+    double full_s = 0.0, part_s = 0.0, area = 0.0;
+    ForgeRasterRect rects[FORGE_UI_DAMAGE_MAX_RECTS];
+    for (int f = 0; f < DAMAGE_BENCH_FRAMES; f++) {
+        damage_frame(&tracked, animate, DAMAGE_BENCH_FRAMES + f);
+        verts = (const ForgeRasterVertex *)tracked.vertices;
+        Uint64 r0 = SDL_GetPerformanceCounter();
+        forge_raster_clear(&full, 0.0f, 0.0f, 0.0f, 1.0f);
+        forge_raster_triangles_indexed(&full, verts, tracked.vertex_count,
+                                       tracked.indices, tracked.index_count, &tex);
+        Uint64 r1 = SDL_GetPerformanceCounter();
+        for (int i = 0; i < tracked.damage_rect_count; i++) {
+            const ForgeUiRect *d = &tracked.damage_rects[i];
+            rects[i] = (ForgeRasterRect){ (int)d->x, (int)d->y, (int)d->w, (int)d->h };
+            forge_raster_clear_rect(&part, rects[i].x, rects[i].y, rects[i].w,
+                                    rects[i].h, 0.0f, 0.0f, 0.0f, 1.0f);
+            area += (double)d->w * (double)d->h;
+        }
+        forge_raster_triangles_indexed_rects(&part, verts, tracked.vertex_count,
+                                             tracked.indices, tracked.index_count,
+                                             &tex, rects, tracked.damage_rect_count);
+        Uint64 r2 = SDL_GetPerformanceCounter();
+        full_s += bench_seconds(r0, r1);
+        part_s += bench_seconds(r1, r2);
+    }
+    size_t bytes = (size_t)full.stride * (size_t)full.height;
+    bool same = SDL_memcmp(full.pixels, part.pixels, bytes) == 0;
+
+    SDL_Log("  %s: frame %7.1f -> %7.1f us with tracking, redraw %8.1f -> "
+            "%8.1f us (%.1f%% of the screen damaged)",
+            animate ? "one slider moving" : "idle             ",
+            bench_seconds(t0, t1) * 1e6 / DAMAGE_BENCH_FRAMES,
+            bench_seconds(t1, t2) * 1e6 / DAMAGE_BENCH_FRAMES,
+            full_s * 1e6 / DAMAGE_BENCH_FRAMES, part_s * 1e6 / DAMAGE_BENCH_FRAMES,
+            100.0 * area / ((double)DAMAGE_BENCH_FRAMES * DAMAGE_BENCH_W * DAMAGE_BENCH_H));
+    if (!same) SDL_Log("  MISMATCH: partial redraw differs from full redraw");
+
+    forge_ui_ctx_free(&plain);
+    forge_ui_ctx_free(&tracked);
+    forge_raster_buffer_destroy(&full);
+    forge_raster_buffer_destroy(&part);
+    return same;
+}
+
+/* ── Widget state: hash table vs linear search ─────────────────────────── */
+
+#define STATE_BENCH_FRAMES 10
+
+/* The straightforward store: parallel arrays searched front to back */
+typedef struct LinearStateStore {
+    Uint32             *ids;
+    ForgeUiWidgetState *states;
+    int                 count;
+} LinearStateStore;
+
+static ForgeUiWidgetState *linear_state(LinearStateStore *store, Uint32 id)
+{
+    for (int i = 0; i < store->count; i++) {
+        if (store->ids[i] == id) return &store->states[i];
+    }
+    store->ids[store->count] = id;
+    SDL_memset(&store->states[store->count], 0, sizeof(ForgeUiWidgetState));
+    return &store->states[store->count++];
+}
+
+static bool bench_widget_state(const ForgeUiFontAtlas *atlas, int widget_count)
+{
+    ForgeUiContext ctx;
+    if (!forge_ui_ctx_init(&ctx, atlas)) return false;
+    Uint32 *ids = (Uint32 *)SDL_malloc((size_t)widget_count * sizeof(Uint32));
+    LinearStateStore store = { 0 };
+    store.ids = (Uint32 *)SDL_malloc((size_t)widget_count * sizeof(Uint32));
+    store.states = (ForgeUiWidgetState *)SDL_malloc(
+        (size_t)widget_count * sizeof(ForgeUiWidgetState));
+    if (!ids || !store.ids || !store.states) {
+        SDL_free(ids);
+        SDL_free(store.ids);
+        SDL_free(store.states);
+        forge_ui_ctx_free(&ctx);
+        return false;
+    }
+    char label[32];
+    for (int i = 0; i < widget_count; i++) {
+        SDL_snprintf(label, sizeof(label), "widget_%d", i);
+        ids[i] = forge_ui_hash_id(&ctx, label);
+    }
+
+    /* Each frame touches every widget's state once, as a frame that
+     * declares every widget would */
+    float sum_linear = 0.0f, sum_table = 0.0f;
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    for (int f = 0; f < STATE_BENCH_FRAMES; f++) {
+        for (int i = 0; i < widget_count; i++) {
+            ForgeUiWidgetState *s = linear_state(&store, ids[i]);
+            s->f[0] += 1.0f;
+            sum_linear += s->f[0];
+        }
+    }
+    Uint64 t1 = SDL_GetPerformanceCounter();
+    bool ok = true;
+    for (int f = 0; f < STATE_BENCH_FRAMES && ok; f++) {
+        forge_ui_ctx_begin(&ctx, 0, 0, false);
+        for (int i = 0; i < widget_count; i++) {
+            ForgeUiWidgetState *s = forge_ui_ctx_state(&ctx, ids[i], NULL);
+            if (!s) { ok = false; break; }
+            s->f[0] += 1.0f;
+            sum_table += s->f[0];
+        }
+        forge_ui_ctx_end(&ctx);
+    }
+    Uint64 t2 = SDL_GetPerformanceCounter();
+
+    double linear_us = bench_seconds(t0, t1) * 1e6 / STATE_BENCH_FRAMES;
+    double table_us = bench_seconds(t1, t2) * 1e6 / STATE_BENCH_FRAMES;
+    SDL_Log("  %6d widgets: linear %10.1f us/frame, table %8.1f us/frame "
+            "(%.1f ns per lookup, %d slots)",
+            widget_count, linear_us, table_us,
+            table_us * 1e3 / widget_count, ctx.state.capacity);
+    if (!ok || sum_linear != sum_table) {
+        SDL_Log("  MISMATCH: table and linear store disagree");
+        ok = false;
+    }
+
+    SDL_free(ids);
+    SDL_free(store.ids);
+    SDL_free(store.states);
+    forge_ui_ctx_free(&ctx);
+    return ok;
+}
+
+/* ── List clipper: declare every row vs visible rows only ───────────────── */
+
+#define LIST_BENCH_FRAMES 20
+#define LIST_BENCH_ROW_H  16.0f
+
+/* A log viewer: row_count formatted rows in a scrolled panel, either all
+ * declared (and clipped per quad) or only those the list clipper reports */
+static int list_panel_frame(ForgeUiContext *ctx, int row_count, bool clipped)
+{
+    char buf[96];
+    int declared = 0;
+    float scroll_y = (float)row_count * 10.0f;
+    forge_ui_ctx_begin(ctx, 0.0f, 0.0f, false);
+    ForgeUiRect rect = { 20.0f, 20.0f, 400.0f, 600.0f };
+    if (forge_ui_ctx_panel_begin(ctx, "Log", rect, &scroll_y)) {
+        ForgeUiListClipper clip;
+        int start = 0, end = row_count;
+        if (clipped && forge_ui_ctx_list_clipper_begin(ctx, &clip, row_count,
+                                                       LIST_BENCH_ROW_H)) {
+            start = clip.display_start;
+            end = clip.display_end;
+        } else {
+            clipped = false;
+        }
+        for (int i = start; i < end; i++) {
+            SDL_snprintf(buf, sizeof(buf), "[%05d] entity %d moved", i, i * 7);
+            forge_ui_ctx_label_layout(ctx, buf, LIST_BENCH_ROW_H);
+            declared++;
+        }
+        if (clipped) forge_ui_ctx_list_clipper_end(ctx, &clip);
+        forge_ui_ctx_panel_end(ctx);
+    }
+    forge_ui_ctx_end(ctx);
+    return declared;
+}
+
+static bool bench_list_clipper(const ForgeUiFontAtlas *atlas, int row_count)
+{
+    double us[2];
+    int declared[2], vertices[2];
+    for (int mode = 0; mode < 2; mode++) {
+        ForgeUiContext ctx;
+        if (!forge_ui_ctx_init(&ctx, atlas)) return false;
+        /* Two warm-up frames: the second sees the measured content height,
+         * so scroll_y is no longer pre-clamped to zero */
+        list_panel_frame(&ctx, row_count, mode == 1);
+        list_panel_frame(&ctx, row_count, mode == 1);
+
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        for (int f = 0; f < LIST_BENCH_FRAMES; f++) {
+            declared[mode] = list_panel_frame(&ctx, row_count, mode == 1);
+        }
+        Uint64 t1 = SDL_GetPerformanceCounter();
+
+        us[mode] = bench_seconds(t0, t1) * 1e6 / LIST_BENCH_FRAMES;
+        vertices[mode] = ctx.vertex_count;
+        forge_ui_ctx_free(&ctx);
+    }
+    SDL_Log("  %6d rows: all %10.1f us/frame (%d declared), "
+            "clipper %6.1f us/frame (%d declared, %.0fx)",
+            row_count, us[0], declared[0], us[1], declared[1],
+            us[1] > 0.0 ? us[0] / us[1] : 0.0);
+    if (vertices[0] != vertices[1]) {
+        SDL_Log("  MISMATCH: %d vs %d vertices", vertices[0], vertices[1]);
+        return false;
+    }
+    return true;
+}
+
+/* ── Text layout throughput: ASCII vs mixed-script, kerned vs not ───────── */
+
+#define PARA_BENCH_REPS   200
+#define PARA_BENCH_BYTES  8192    /* paragraph size, bytes of UTF-8 */
+#define PARA_BENCH_WIDTH  640.0f  /* wrap width in pixels */
+
+/* Append one codepoint as UTF-8; returns the bytes written */
+static int utf8_put(char *out, Uint32 cp)
+{
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        return 1;
+    }
+    if (cp < 0x800) {
+        out[0] = (char)(0xC0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    out[0] = (char)(0xE0 | (cp >> 12));
+    out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+    out[2] = (char)(0x80 | (cp & 0x3F));
+    return 3;
+}
+
+/* Fill text with words of 2-9 letters drawn from the atlas.  With mixed
+ * set, each word picks one of Latin, Latin-1, Greek, or Cyrillic letters. */
+static void make_paragraph(const ForgeUiFontAtlas *atlas, bool mixed,
+                           char *text, int size)
+{
+    static const Uint32 scripts[4][2] = {
+        { 0x0061, 0x007A },  /* a-z */
+        { 0x00E0, 0x00FF },  /* Latin-1 lowercase */
+        { 0x03B1, 0x03C9 },  /* Greek lowercase */
+        { 0x0430, 0x044F },  /* Cyrillic lowercase */
+    };
+    int len = 0;
+    while (len < size - 64) {
+        const Uint32 *range = scripts[mixed ? bench_rand() % 4 : 0];
+        int letters = 2 + (int)(bench_rand() % 8);
+        for (int i = 0; i < letters; i++) {
+            Uint32 cp = range[0] + bench_rand() % (range[1] - range[0] + 1);
+            if (!forge_ui_atlas_lookup(atlas, cp)) cp = 'x';
+            len += utf8_put(text + len, cp);
+        }
+        text[len++] = ' ';
+    }
+    text[len] = '\0';
+}
+
+/* Lay out (or measure) text PARA_BENCH_REPS times; returns glyphs/second
+ * and the last run's metrics and vertex count. */
+static double time_paragraph(const ForgeUiFontAtlas *atlas, const char *text,
+                             bool measure_only, ForgeUiTextMetrics *metrics,
+                             ForgeUiVertex **verts, int *vert_cap,
+                             Uint32 **indices, int *index_cap,
+                             int *out_vertices)
+{
+    ForgeUiTextOpts opts = { PARA_BENCH_WIDTH, FORGE_UI_TEXT_ALIGN_LEFT,
+                             1.0f, 1.0f, 1.0f, 1.0f };
+    int vert_count = 0, index_count = 0;
+    ForgeUiTextSink sink;
+    SDL_memset(&sink, 0, sizeof(sink));
+    sink.vertices = verts;
+    sink.vertex_count = &vert_count;
+    sink.vertex_capacity = vert_cap;
+    sink.indices = indices;
+    sink.index_count = &index_count;
+    sink.index_capacity = index_cap;
+
+    /* Glyph count from one untimed layout (grows the sink, too) */
+    if (!forge_ui_text_layout_into(atlas, text, 0.0f, 0.0f, &opts, &sink,
+                                   metrics)) {
+        return 0.0;
+    }
+    int glyphs = vert_count / 4;
+    *out_vertices = vert_count;
+
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    for (int r = 0; r < PARA_BENCH_REPS; r++) {
+        if (measure_only) {
+            *metrics = forge_ui_text_measure(atlas, text, &opts);
+        } else {
+            vert_count = 0;
+            index_count = 0;
+            forge_ui_text_layout_into(atlas, text, 0.0f, 0.0f, &opts, &sink,
+                                      metrics);
+        }
+    }
+    Uint64 t1 = SDL_GetPerformanceCounter();
+    double s = bench_seconds(t0, t1);
+    return s > 0.0 ? (double)glyphs * PARA_BENCH_REPS / s : 0.0;
+}
+
+static bool bench_paragraph(const ForgeUiFont *font)
+{
+    /* ASCII plus the Latin-1, Greek, and Cyrillic blocks */
+    Uint32 codepoints[0x500];
+    int count = 0;
+    for (Uint32 c = 0x20; c < 0x500; c++) {
+        if (c >= 0x7F && c < 0xA0) continue;
+        Uint16 gi = forge_ui_ttf_glyph_index(font, c);
+        if (c == 0x20 || (gi != 0 && simple_glyph(font, gi))) {
+            codepoints[count++] = c;
+        }
+    }
+    ForgeUiFontAtlas atlas;
+    if (!forge_ui_atlas_build(font, 16.0f, codepoints, count,
+                              ATLAS_BUILD_PADDING, &atlas)) {
+        return false;
+    }
+
+    /* The same atlas with a synthetic kerning table (the test font has
+     * none): about one pair in eight kerned */
+    ForgeUiFontAtlas kerned = atlas;
+    SDL_memset(&kerned.kern, 0, sizeof(kerned.kern));
+    bool ok = true;
+    for (int i = 0; ok && i < atlas.glyph_count; i++) {
+        for (int j = 0; ok && j < atlas.glyph_count; j++) {
+            if (bench_rand() % 8 != 0) continue;
+            ok = forge_ui__kern_insert(&kerned.kern,
+                                       atlas.glyphs[i].glyph_index,
+                                       atlas.glyphs[j].glyph_index,
+                                       (Sint16)-(20 + (int)(bench_rand() % 60)));
+        }
+    }
+
+    char *text = (char *)SDL_malloc(PARA_BENCH_BYTES);
+    ForgeUiVertex *verts = NULL;
+    Uint32 *indices = NULL;
+    int vert_cap = 0, index_cap = 0;
+    if (!text) ok = false;
+
+    static const char *names[2] = { "ASCII", "mixed" };
+    for (int mixed = 0; ok && mixed < 2; mixed++) {
+        make_paragraph(&atlas, mixed == 1, text, PARA_BENCH_BYTES);
+        double rate[2][2];  /* [kerned][measure] */
+        ForgeUiTextMetrics m[2][2];
+        int vertices[2][2];
+        for (int k = 0; k < 2; k++) {
+            for (int meas = 0; meas < 2; meas++) {
+                rate[k][meas] = time_paragraph(k ? &kerned : &atlas, text,
+                                               meas == 1, &m[k][meas],
+                                               &verts, &vert_cap,
+                                               &indices, &index_cap,
+                                               &vertices[k][meas]);
+            }
+        }
+        SDL_Log("  %s, %d glyphs: layout %6.1f Mglyph/s (kerned %6.1f), "
+                "measure %6.1f Mglyph/s (kerned %6.1f)",
+                names[mixed], vertices[0][0] / 4, rate[0][0] * 1e-6,
+                rate[1][0] * 1e-6, rate[0][1] * 1e-6, rate[1][1] * 1e-6);
+
+        for (int k = 0; k < 2; k++) {
+            if (SDL_fabsf(m[k][0].width - m[k][1].width) > 1e-3f ||
+                m[k][0].line_count != m[k][1].line_count) {
+                SDL_Log("  MISMATCH: measure disagrees with layout");
+                ok = false;
+            }
+        }
+        if (vertices[0][0] != vertices[1][0] || vertices[0][0] == 0) {
+            SDL_Log("  MISMATCH: %d vs %d vertices with kerning",
+                    vertices[0][0], vertices[1][0]);
+            ok = false;
+        }
+    }
+
+    SDL_free(indices);
+    SDL_free(verts);
+    SDL_free(text);
+    forge_ui__kern_free(&kerned.kern);
+    forge_ui_atlas_free(&atlas);
+    return ok;
+}
+
+/* ── Paragraphs: re-wrapping help text as a window resizes ──────────────── */
+
+#define REWRAP_BENCH_FRAMES 200
+#define REWRAP_BENCH_VIEW_H 600.0f  /* visible height of the text panel */
+
+/* One frame of a help window: measure the text to size the scroll area,
+ * then lay it out clipped to the view.  Returns the vertex count. */
+static int help_text_frame(const ForgeUiFontAtlas *atlas, const char *text,
+                           ForgeUiParagraph *para, float width,
+                           ForgeUiVertex **verts, int *vert_cap,
+                           Uint32 **indices, int *index_cap)
+{
+    ForgeUiTextOpts opts = { width, FORGE_UI_TEXT_ALIGN_LEFT,
+                             1.0f, 1.0f, 1.0f, 1.0f };
+    int vert_count = 0, index_count = 0;
+    ForgeUiTextSink sink = { verts, &vert_count, vert_cap,
+                             indices, &index_count, index_cap,
+                             true, 0.0f, 0.0f, width, REWRAP_BENCH_VIEW_H };
+    ForgeUiTextMetrics m;
+    if (para) {
+        m = forge_ui_paragraph_measure(para, &opts);
+        forge_ui_paragraph_layout_into(para, 0.0f, 20.0f, &opts, &sink, NULL);
+    } else {
+        m = forge_ui_text_measure(atlas, text, &opts);
+        forge_ui_text_layout_into(atlas, text, 0.0f, 20.0f, &opts, &sink,
+                                  NULL);
+    }
+    return m.line_count > 0 ? vert_count : -1;
+}
+
+static bool bench_paragraph_rewrap(const ForgeUiFontAtlas *atlas,
+                                   int text_bytes, bool resizing)
+{
+    /* Help text: sentences, with a paragraph break every ~500 bytes */
+    static const char *sentences[] = {
+        "Drag a window by its title bar to move it. ",
+        "Scroll the panel with the mouse wheel or the scrollbar thumb. ",
+        "Widgets inside a collapsed window are not evaluated. ",
+        "Hold Shift while dragging a slider for fine adjustment. ",
+    };
+    char *text = (char *)SDL_malloc((size_t)text_bytes + 1);
+    if (!text) return false;
+    int len = 0, since_break = 0;
+    for (int i = 0; ; i++) {
+        const char *s = sentences[i % 4];
+        int n = (int)SDL_strlen(s);
+        if (len + n + 1 > text_bytes) break;
+        SDL_memcpy(text + len, s, (size_t)n);
+        len += n;
+        since_break += n;
+        if (since_break > 500) {
+            text[len++] = '\n';
+            since_break = 0;
+        }
+    }
+    text[len] = '\0';
+
+    ForgeUiParagraph para;
+    if (!forge_ui_paragraph_init(atlas, text, &para)) {
+        SDL_free(text);
+        return false;
+    }
+
+    ForgeUiVertex *verts = NULL;
+    Uint32 *indices = NULL;
+    int vert_cap = 0, index_cap = 0;
+    double us[2];
+    long long vertices[2] = { 0, 0 };
+    for (int mode = 0; mode < 2; mode++) {
+        ForgeUiParagraph *p = mode == 1 ? &para : NULL;
+        help_text_frame(atlas, text, p, 400.0f, &verts, &vert_cap,
+                        &indices, &index_cap);
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        for (int f = 0; f < REWRAP_BENCH_FRAMES; f++) {
+            /* Resizing: a new width every frame, 300-700 px */
+            float width = resizing ? 300.0f + (float)((f * 37) % 400) : 400.0f;
+            vertices[mode] += help_text_frame(atlas, text, p, width,
+                                              &verts, &vert_cap,
+                                              &indices, &index_cap);
+        }
+        Uint64 t1 = SDL_GetPerformanceCounter();
+        us[mode] = bench_seconds(t0, t1) * 1e6 / REWRAP_BENCH_FRAMES;
+    }
+
+    SDL_Log("  %5d bytes, %s: measure+layout %8.1f us/frame, "
+            "paragraph %6.1f us/frame (%.0fx)",
+            len, resizing ? "resizing" : "steady  ", us[0], us[1],
+            us[1] > 0.0 ? us[0] / us[1] : 0.0);
+
+    SDL_free(indices);
+    SDL_free(verts);
+    forge_ui_paragraph_free(&para);
+    SDL_free(text);
+    if (vertices[0] != vertices[1]) {
+        SDL_Log("  MISMATCH: %lld vs %lld vertices", vertices[0], vertices[1]);
+        return false;
+    }
+    return true;
+}
+
+/* ══════════════════════════════════════════════════════════════════════════ */
+/* ── Main ──────────────────────────────────────────────────────────────── */
+/* ══════════════════════════════════════════════════════════════════════════ */
+
+int main(int argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    if (!SDL_Init(0)) {
+        SDL_Log("SDL_Init failed: %s", SDL_GetError());
+        return 1;
+    }
+
+    bool ok = true;
+
+    SDL_Log("=== Atlas glyph lookup ===");
+    ok = bench_atlas_lookup(100) && ok;
+    ok = bench_atlas_lookup(1000) && ok;
+    ok = bench_atlas_lookup(10000) && ok;
+
+    SDL_Log("=== Glyph rasterization (ASCII, 4x4 supersampling) ===");
+    ForgeUiFont font;
+    if (forge_ui_ttf_load(RASTER_FONT_PATH, &font)) {
+        ok = bench_rasterize(&font, 16.0f) && ok;
+        ok = bench_rasterize(&font, 32.0f) && ok;
+        ok = bench_rasterize(&font, 64.0f) && ok;
+        ok = bench_rasterize(&font, 128.0f) && ok;
+
+        SDL_Log("=== Analytic coverage vs supersampling (ASCII) ===");
+        ok = bench_analytic(&font, 16.0f) && ok;
+        ok = bench_analytic(&font, 32.0f) && ok;
+        ok = bench_analytic(&font, 64.0f) && ok;
+        ok = bench_analytic(&font, 128.0f) && ok;
+
+        SDL_Log("=== Atlas build: serial vs worker threads ===");
+        ok = bench_atlas_build(&font, 32.0f) && ok;
+        ok = bench_atlas_build(&font, 64.0f) && ok;
+
+        SDL_Log("=== Atlas packing: shelf vs skyline ===");
+        ok = bench_atlas_packing(&font, 16.0f, 95) && ok;
+        ok = bench_atlas_packing(&font, 32.0f, 95) && ok;
+        ok = bench_atlas_packing(&font, 32.0f, 1000) && ok;
+        ok = bench_atlas_packing(&font, 64.0f, 1000) && ok;
+
+        ForgeUiFontAtlas atlas;
+        Uint32 ascii[95];
+        for (int i = 0; i < 95; i++) ascii[i] = (Uint32)(0x20 + i);
+        if (forge_ui_atlas_build(&font, 16.0f, ascii, 95,
+                                 ATLAS_BUILD_PADDING, &atlas)) {
+            SDL_Log("=== Label text: layout+copy vs layout into sink ===");
+            ok = bench_text_layout_into(&atlas, 50) && ok;
+            ok = bench_text_layout_into(&atlas, 500) && ok;
+
+            SDL_Log("=== Label text: uncached vs text layout cache ===");
+            ok = bench_text_cache(&atlas, 50) && ok;
+            ok = bench_text_cache(&atlas, 500) && ok;
+
+            SDL_Log("=== Vertex format: float vs packed ===");
+            ok = bench_vertex_format(&atlas, 50000) && ok;
+
+            SDL_Log("=== Clipped text: CPU clipping vs draw commands ===");
+            ok = bench_clip_mode(&atlas, 100) && ok;
+            ok = bench_clip_mode(&atlas, 1000) && ok;
+
+            SDL_Log("=== Window composition: compact copy vs segments ===");
+            ok = bench_window_compose(&atlas, 20) && ok;
+            ok = bench_window_compose(&atlas, 100) && ok;
+
+            SDL_Log("=== Cached regions: declared vs replayed windows ===");
+            ok = bench_region_cache(&atlas, 20) && ok;
+            ok = bench_region_cache(&atlas, 100) && ok;
+
+            SDL_Log("=== Damage tracking: full vs partial redraw ===");
+            ok = bench_damage(&atlas, false) && ok;
+            ok = bench_damage(&atlas, true) && ok;
+
+            SDL_Log("=== Widget state: linear search vs hash table ===");
+            ok = bench_widget_state(&atlas, 1000) && ok;
+            ok = bench_widget_state(&atlas, 10000) && ok;
+            ok = bench_widget_state(&atlas, 30000) && ok;
+
+            SDL_Log("=== Large lists: every row vs list clipper ===");
+            ok = bench_list_clipper(&atlas, 1000) && ok;
+            ok = bench_list_clipper(&atlas, 50000) && ok;
+
+            SDL_Log("=== Text layout throughput: ASCII vs mixed-script ===");
+            ok = bench_paragraph(&font) && ok;
+
+            SDL_Log("=== Help text: measure+layout vs paragraph ===");
+            ok = bench_paragraph_rewrap(&atlas, 8192, true) && ok;
+            ok = bench_paragraph_rewrap(&atlas, 8192, false) && ok;
+            ok = bench_paragraph_rewrap(&atlas, 65536, true) && ok;
+            forge_ui_atlas_free(&atlas);
+        } else {
+            ok = false;
+        }
+        forge_ui_ttf_free(&font);
+    } else {
+        SDL_Log("  skipped: could not load %s", RASTER_FONT_PATH);
+    }
+
+    SDL_Quit();
+    return ok ? 0 : 1;
+}
@@ -18,6 +18,7 @@
  */
 
 #include <SDL3/SDL.h>
+#include <stddef.h>  /* offsetof() for vertex layout checks */
 #include <stdio.h>   /* remove() for cleaning up test BMP files */
 #include "ui/forge_ui.h"
 
@@ -268,11 +269,131 @@ static void test_cmap_unmapped(void)
 
 static void test_cmap_beyond_bmp(void)
 {
-    TEST("cmap: codepoint > 0xFFFF returns 0 (format 4 BMP only)");
+    TEST("cmap: codepoint > 0xFFFF returns 0 (font has no format 12)");
     if (!font_loaded) return;
     ASSERT_EQ_U16(forge_ui_ttf_glyph_index(&test_font, 0x10000), 0);
 }
 
+/* ── Test: precomputed cmap page table ───────────────────────────────────── */
+
+static void test_cmap_table_matches_segments(void)
+{
+    TEST("cmap: page table agrees with segment lookup for U+0000..U+1FFFF");
+    if (!font_loaded) return;
+
+    ForgeUiFontLoadOpts opts;
+    opts.build_cmap_table = true;
+    ForgeUiFont font;
+    ASSERT_TRUE(forge_ui_ttf_load_opts(TEST_FONT_PATH, &opts, &font));
+    ASSERT_TRUE(font.cmap_page_map != NULL);
+    ASSERT_TRUE(font.cmap_page_count > 0);
+    ASSERT_TRUE(test_font.cmap_page_map == NULL);  /* default: no table */
+
+    for (Uint32 cp = 0; cp <= 0x1FFFF; cp++) {
+        Uint16 expected = forge_ui_ttf_glyph_index(&test_font, cp);
+        Uint16 actual   = forge_ui_ttf_glyph_index(&font, cp);
+        if (expected != actual) {
+            SDL_Log("    FAIL: U+%04X table=%u segments=%u",
+                    cp, actual, expected);
+            fail_count++;
+            forge_ui_ttf_free(&font);
+            return;
+        }
+    }
+    pass_count++;
+
+    ASSERT_EQ_U16(forge_ui_ttf_glyph_index(&font, 0x110000), 0);
+    forge_ui_ttf_free(&font);
+    ASSERT_TRUE(font.cmap_page_map == NULL);
+}
+
+/* ── Test: cmap format 12 (supplementary planes) ─────────────────────────── */
+
+/* Append a big-endian uint32 to a byte buffer */
+static Uint8 *put_u32(Uint8 *p, Uint32 v)
+{
+    p[0] = (Uint8)(v >> 24);
+    p[1] = (Uint8)(v >> 16);
+    p[2] = (Uint8)(v >> 8);
+    p[3] = (Uint8)v;
+    return p + 4;
+}
+
+/* Build a format 12 subtable with the given groups (start, end, glyph) */
+static size_t make_cmap12(Uint8 *buf, const Uint32 *groups, Uint32 count)
+{
+    size_t len = 16 + (size_t)count * 12;
+    Uint8 *p = buf;
+    *p++ = 0; *p++ = 12;  /* format */
+    *p++ = 0; *p++ = 0;   /* reserved */
+    p = put_u32(p, (Uint32)len);
+    p = put_u32(p, 0);    /* language */
+    p = put_u32(p, count);
+    for (Uint32 i = 0; i < count * 3; i++) {
+        p = put_u32(p, groups[i]);
+    }
+    return len;
+}
+
+static void test_cmap_format12(void)
+{
+    TEST("cmap: format 12 groups resolve BMP and supplementary codepoints");
+
+    static const Uint32 groups[] = {
+        0x0041,  0x005A,  10,   /* A-Z */
+        0x1F600, 0x1F64F, 100,  /* emoticons */
+        0x20000, 0x20000, 500,  /* one CJK extension B ideograph */
+    };
+    Uint8 buf[16 + 3 * 12];
+    size_t len = make_cmap12(buf, groups, 3);
+
+    ForgeUiFont font;
+    SDL_memset(&font, 0, sizeof(font));
+    ASSERT_TRUE(forge_ui__parse_cmap_format12(&font, buf, len));
+    ASSERT_EQ_U32(font.cmap12_group_count, 3);
+
+    ASSERT_EQ_U16(forge_ui_ttf_glyph_index(&font, 'A'), 10);
+    ASSERT_EQ_U16(forge_ui_ttf_glyph_index(&font, 'Z'), 35);
+    ASSERT_EQ_U16(forge_ui_ttf_glyph_index(&font, 'a'), 0);
+    ASSERT_EQ_U16(forge_ui_ttf_glyph_index(&font, 0x1F600), 100);
+    ASSERT_EQ_U16(forge_ui_ttf_glyph_index(&font, 0x1F64F), 179);
+    ASSERT_EQ_U16(forge_ui_ttf_glyph_index(&font, 0x1F650), 0);
+    ASSERT_EQ_U16(forge_ui_ttf_glyph_index(&font, 0x20000), 500);
+    ASSERT_EQ_U16(forge_ui_ttf_glyph_index(&font, 0x20001), 0);
+
+    /* The page table must give identical answers */
+    ASSERT_TRUE(forge_ui__build_cmap_table(&font));
+    ASSERT_EQ_INT(font.cmap_page_count, 3);  /* 0x00, 0x1F6, 0x200 */
+    ASSERT_EQ_U16(forge_ui_ttf_glyph_index(&font, 'A'), 10);
+    ASSERT_EQ_U16(forge_ui_ttf_glyph_index(&font, 'a'), 0);
+    ASSERT_EQ_U16(forge_ui_ttf_glyph_index(&font, 0x1F64F), 179);
+    ASSERT_EQ_U16(forge_ui_ttf_glyph_index(&font, 0x20000), 500);
+    ASSERT_EQ_U16(forge_ui_ttf_glyph_index(&font, 0x30000), 0);
+
+    forge_ui_ttf_free(&font);
+}
+
+static void test_cmap_format12_rejects_unsorted(void)
+{
+    TEST("cmap: format 12 rejects overlapping or truncated groups");
+
+    static const Uint32 overlapping[] = {
+        0x0041, 0x005A, 10,
+        0x0050, 0x0060, 40,  /* starts inside the previous group */
+    };
+    Uint8 buf[16 + 2 * 12];
+    size_t len = make_cmap12(buf, overlapping, 2);
+
+    ForgeUiFont font;
+    SDL_memset(&font, 0, sizeof(font));
+    ASSERT_TRUE(!forge_ui__parse_cmap_format12(&font, buf, len));
+    ASSERT_TRUE(font.cmap12_groups == NULL);
+
+    /* numGroups claims more data than the subtable holds */
+    ASSERT_TRUE(!forge_ui__parse_cmap_format12(&font, buf, len - 1));
+    ASSERT_TRUE(font.cmap12_groups == NULL);
+}
+
 /* ── Test: glyph index out of range ──────────────────────────────────────── */
 
 static void test_glyph_out_of_range(void)
@@ -474,6 +595,7 @@ static void test_raster_basic(void)
 
     Uint16 idx = forge_ui_ttf_glyph_index(&test_font, 'A');
     ForgeUiRasterOpts opts;
+    SDL_memset(&opts, 0, sizeof(opts));
     opts.supersample_level = 4;
 
     ForgeUiGlyphBitmap bmp;
@@ -504,6 +626,7 @@ static void test_raster_donut(void)
 
     Uint16 idx = forge_ui_ttf_glyph_index(&test_font, 'O');
     ForgeUiRasterOpts opts;
+    SDL_memset(&opts, 0, sizeof(opts));
     opts.supersample_level = 1; /* binary — easier to verify hole */
 
     ForgeUiGlyphBitmap bmp;
@@ -546,6 +669,7 @@ static void test_raster_antialiasing(void)
 
     Uint16 idx = forge_ui_ttf_glyph_index(&test_font, 'A');
     ForgeUiRasterOpts opts;
+    SDL_memset(&opts, 0, sizeof(opts));
     opts.supersample_level = 4;
 
     ForgeUiGlyphBitmap bmp;
@@ -575,6 +699,7 @@ static void test_raster_no_aa(void)
 
     Uint16 idx = forge_ui_ttf_glyph_index(&test_font, 'A');
     ForgeUiRasterOpts opts;
+    SDL_memset(&opts, 0, sizeof(opts));
     opts.supersample_level = 1;
 
     ForgeUiGlyphBitmap bmp;
@@ -630,6 +755,248 @@ static void test_raster_default_opts(void)
     forge_ui_glyph_bitmap_free(&bmp);
 }
 
+/* ── Test: active edge table matches the reference scanline path ────────── */
+/* The active edge table is an optimization only — every pixel must match
+ * the reference rasterizer exactly, at every size and supersample level. */
+
+static void test_raster_active_edge_matches_scanline(void)
+{
+    TEST("rasterize_glyph: ACTIVE_EDGE is bit-identical to SCANLINE (ASCII)");
+    if (!font_loaded) return;
+
+    static const float sizes[] = { 16.0f, 32.0f, 64.0f, 128.0f };
+    static const int   levels[] = { 1, 2, 4, 8 };
+    int mismatches = 0;
+    int compared = 0;
+
+    for (int si = 0; si < 4; si++) {
+        for (int li = 0; li < 4; li++) {
+            ForgeUiRasterOpts ref_opts;
+            SDL_memset(&ref_opts, 0, sizeof(ref_opts));
+            ref_opts.supersample_level = levels[li];
+            ref_opts.method = FORGE_UI_RASTER_SCANLINE;
+            ForgeUiRasterOpts aet_opts = ref_opts;
+            aet_opts.method = FORGE_UI_RASTER_ACTIVE_EDGE;
+
+            for (Uint32 cp = 0x20; cp <= 0x7E; cp++) {
+                Uint16 idx = forge_ui_ttf_glyph_index(&test_font, cp);
+                ForgeUiGlyphBitmap ref, aet;
+                if (!forge_ui_rasterize_glyph(&test_font, idx, sizes[si],
+                                              &ref_opts, &ref)) {
+                    mismatches++;
+                    continue;
+                }
+                if (!forge_ui_rasterize_glyph(&test_font, idx, sizes[si],
+                                              &aet_opts, &aet)) {
+                    forge_ui_glyph_bitmap_free(&ref);
+                    mismatches++;
+                    continue;
+                }
+                compared++;
+                if (ref.width != aet.width || ref.height != aet.height ||
+                    ref.bearing_x != aet.bearing_x ||
+                    ref.bearing_y != aet.bearing_y ||
+                    (ref.width > 0 && SDL_memcmp(ref.pixels, aet.pixels,
+                        (size_t)ref.width * (size_t)ref.height) != 0)) {
+                    if (mismatches == 0) {
+                        SDL_Log("    first mismatch: U+%04X at %.0fpx ss=%d",
+                                cp, (double)sizes[si], levels[li]);
+                    }
+                    mismatches++;
+                }
+                forge_ui_glyph_bitmap_free(&ref);
+                forge_ui_glyph_bitmap_free(&aet);
+            }
+        }
+    }
+
+    ASSERT_EQ_INT(compared, 4 * 4 * 95);
+    ASSERT_EQ_INT(mismatches, 0);
+}
+
+/* ── Test: unknown method falls back to the scanline path ────────────────── */
+
+static void test_raster_invalid_method(void)
+{
+    TEST("rasterize_glyph: invalid method falls back to SCANLINE");
+    if (!font_loaded) return;
+
+    Uint16 idx = forge_ui_ttf_glyph_index(&test_font, 'A');
+    ForgeUiRasterOpts opts;
+    SDL_memset(&opts, 0, sizeof(opts));
+    opts.supersample_level = 4;
+
+    ForgeUiGlyphBitmap ref;
+    ASSERT_TRUE(forge_ui_rasterize_glyph(&test_font, idx, 32.0f, &opts, &ref));
+
+    opts.method = (ForgeUiRasterMethod)99;
+    ForgeUiGlyphBitmap bmp;
+    bool result = forge_ui_rasterize_glyph(&test_font, idx, 32.0f, &opts, &bmp);
+    if (!result) {
+        forge_ui_glyph_bitmap_free(&ref);
+    }
+    ASSERT_TRUE(result);
+    bool same = bmp.width == ref.width && bmp.height == ref.height &&
+                SDL_memcmp(bmp.pixels, ref.pixels,
+                           (size_t)ref.width * (size_t)ref.height) == 0;
+    forge_ui_glyph_bitmap_free(&ref);
+    forge_ui_glyph_bitmap_free(&bmp);
+    ASSERT_TRUE(same);
+}
+
+/* ── Test: analytic coverage of an axis-aligned rectangle ────────────────── */
+/* A rectangle from x=1.5 to x=3.5 covers half of columns 1 and 3 and all of
+ * column 2, so exact-area coverage must produce 128, 255, 128 — something
+ * no fixed sample grid gets right for arbitrary offsets. */
+
+static void test_raster_analytic_rect(void)
+{
+    TEST("rasterize_analytic: half-covered pixels get exactly half coverage");
+
+    ForgeUi__Edge edges[4];
+    SDL_memset(edges, 0, sizeof(edges));
+    /* Closed rectangle (1.5,1)-(3.5,3); horizontal edges contribute nothing
+     * but are included as the edge builder would emit them */
+    float pts[5][2] = { {1.5f, 1.0f}, {1.5f, 3.0f}, {3.5f, 3.0f},
+                        {3.5f, 1.0f}, {1.5f, 1.0f} };
+    for (int i = 0; i < 4; i++) {
+        edges[i].type = FORGE_UI__EDGE_LINE;
+        edges[i].x0 = pts[i][0];
+        edges[i].y0 = pts[i][1];
+        edges[i].x1 = pts[i + 1][0];
+        edges[i].y1 = pts[i + 1][1];
+    }
+
+    Uint8 pixels[5 * 4];
+    ASSERT_TRUE(forge_ui__rasterize_analytic(edges, 4, pixels, 5, 4));
+
+    static const Uint8 expected[5 * 4] = {
+        0,   0,   0,   0, 0,
+        0, 128, 255, 128, 0,
+        0, 128, 255, 128, 0,
+        0,   0,   0,   0, 0,
+    };
+    ASSERT_TRUE(SDL_memcmp(pixels, expected, sizeof(expected)) == 0);
+}
+
+/* ── Test: analytic coverage agrees with 8x8 supersampling ───────────────── */
+/* The two methods estimate the same quantity, so per-glyph ink (sum of
+ * coverage) and per-pixel values must stay close.  They are not equal:
+ * supersampling quantizes coverage to 1/64 and its span fill rounds both
+ * ends outward to whole samples, so it reads a few percent heavier than
+ * the exact area. */
+
+static void test_raster_analytic_matches_supersampled(void)
+{
+    TEST("rasterize_glyph: ANALYTIC agrees with 8x8 supersampling (ASCII)");
+    if (!font_loaded) return;
+
+    ForgeUiRasterOpts ss_opts;
+    SDL_memset(&ss_opts, 0, sizeof(ss_opts));
+    ss_opts.supersample_level = 8;
+    ss_opts.method = FORGE_UI_RASTER_ACTIVE_EDGE;
+    ForgeUiRasterOpts an_opts;
+    SDL_memset(&an_opts, 0, sizeof(an_opts));
+    an_opts.method = FORGE_UI_RASTER_ANALYTIC;
+
+    int bad = 0;
+    for (Uint32 cp = 0x21; cp <= 0x7E; cp++) {
+        Uint16 idx = forge_ui_ttf_glyph_index(&test_font, cp);
+        ForgeUiGlyphBitmap ref, an;
+        if (!forge_ui_rasterize_glyph(&test_font, idx, 32.0f, &ss_opts, &ref)) {
+            bad++;
+            continue;
+        }
+        if (!forge_ui_rasterize_glyph(&test_font, idx, 32.0f, &an_opts, &an)) {
+            forge_ui_glyph_bitmap_free(&ref);
+            bad++;
+            continue;
+        }
+
+        if (ref.width != an.width || ref.height != an.height ||
+            ref.bearing_x != an.bearing_x || ref.bearing_y != an.bearing_y) {
+            bad++;
+        } else {
+            long long ink_ref = 0, ink_an = 0;
+            int max_diff = 0;
+            for (int i = 0; i < ref.width * ref.height; i++) {
+                int d = (int)ref.pixels[i] - (int)an.pixels[i];
+                if (d < 0) d = -d;
+                if (d > max_diff) max_diff = d;
+                ink_ref += ref.pixels[i];
+                ink_an  += an.pixels[i];
+            }
+            long long ink_diff = ink_ref - ink_an;
+            if (ink_diff < 0) ink_diff = -ink_diff;
+            /* Total ink within 6%, and no pixel off by more than ~1/4 */
+            if (ink_diff * 100 > ink_ref * 6 || max_diff > 64) {
+                SDL_Log("    U+%04X: ink %lld vs %lld, max pixel diff %d",
+                        cp, ink_ref, ink_an, max_diff);
+                bad++;
+            }
+        }
+        forge_ui_glyph_bitmap_free(&ref);
+        forge_ui_glyph_bitmap_free(&an);
+    }
+    ASSERT_EQ_INT(bad, 0);
+}
+
+/* ── Test: analytic coverage respects holes ──────────────────────────────── */
+
+static void test_raster_analytic_donut(void)
+{
+    TEST("rasterize_glyph: ANALYTIC 'O' has empty center and AA edges");
+    if (!font_loaded) return;
+
+    Uint16 idx = forge_ui_ttf_glyph_index(&test_font, 'O');
+    ForgeUiRasterOpts opts;
+    SDL_memset(&opts, 0, sizeof(opts));
+    opts.method = FORGE_UI_RASTER_ANALYTIC;
+
+    ForgeUiGlyphBitmap bmp;
+    ASSERT_TRUE(forge_ui_rasterize_glyph(&test_font, idx, 64.0f, &opts, &bmp));
+    ASSERT_TRUE(bmp.width > 0 && bmp.height > 0);
+
+    Uint8 center = bmp.pixels[(bmp.height / 2) * bmp.width + bmp.width / 2];
+    bool has_full = false, has_intermediate = false;
+    for (int i = 0; i < bmp.width * bmp.height; i++) {
+        if (bmp.pixels[i] == 255) has_full = true;
+        if (bmp.pixels[i] > 0 && bmp.pixels[i] < 255) has_intermediate = true;
+    }
+    forge_ui_glyph_bitmap_free(&bmp);
+    ASSERT_TRUE(center == 0);
+    ASSERT_TRUE(has_full);
+    ASSERT_TRUE(has_intermediate);
+}
+
+/* ── Test: analytic coverage stays inside the bitmap ─────────────────────── */
+/* A near-vertical edge hugging x = 0 is clamped at its endpoints, but
+ * stepping x down 40 rows rounds a hair below zero.  Without a per-row
+ * clamp the last row writes line[-1] -- the previous row's last pixel, or
+ * before the buffer on row 0. */
+
+static void test_raster_analytic_edge_hugs_left(void)
+{
+    TEST("coverage_line: near-vertical edge at x = 0 stays in bounds");
+    enum { W = 8, H = 40 };
+    /* Guard rows before and after the accumulation buffer */
+    float store[W + W * H + 1 + W];
+    SDL_memset(store, 0, sizeof(store));
+    float *acc = store + W;
+
+    forge_ui__coverage_line(acc, W, H, 0.369870007f, 0.745235682f,
+                            -1.0f, 39.1331978f);
+
+    /* An edge within a pixel of x = 0 only touches columns 0 and 1 */
+    int stray = 0;
+    for (int i = 0; i < (int)SDL_arraysize(store); i++) {
+        int idx = i - W;
+        bool inside = idx >= 0 && idx < W * H;
+        if (store[i] != 0.0f && (!inside || idx % W > 1)) stray++;
+    }
+    ASSERT_EQ_INT(stray, 0);
+}
+
 /* ══════════════════════════════════════════════════════════════════════════ */
 /* ── hmtx / Advance Width Tests ────────────────────────────────────────── */
 /* ══════════════════════════════════════════════════════════════════════════ */
@@ -788,6 +1155,93 @@ static void test_atlas_lookup_missing(void)
     forge_ui_atlas_free(&atlas);
 }
 
+/* ── Test: atlas lookup tables agree with a linear scan ──────────────────── */
+
+static void test_atlas_lookup_matches_linear(void)
+{
+    TEST("atlas_lookup: table lookup matches linear scan for all codepoints");
+    if (!font_loaded) return;
+
+    /* Printable ASCII plus a few Latin-1 and Greek codepoints so more than
+     * one lookup page is populated */
+    Uint32 codepoints[ASCII_COUNT + 3];
+    for (int i = 0; i < ASCII_COUNT; i++) {
+        codepoints[i] = (Uint32)(ASCII_START + i);
+    }
+    codepoints[ASCII_COUNT + 0] = 0x00E9;  /* e acute */
+    codepoints[ASCII_COUNT + 1] = 0x03A9;  /* Greek capital omega */
+    codepoints[ASCII_COUNT + 2] = 0x03C0;  /* Greek small pi */
+
+    ForgeUiFontAtlas atlas;
+    bool result = forge_ui_atlas_build(&test_font, ATLAS_PIXEL_HEIGHT,
+                                       codepoints, ASCII_COUNT + 3,
+                                       ATLAS_PADDING, &atlas);
+    ASSERT_TRUE(result);
+    ASSERT_TRUE(atlas.lookup_ready);
+
+    for (Uint32 cp = 0; cp < 0x400; cp++) {
+        const ForgeUiPackedGlyph *expected = NULL;
+        for (int i = 0; i < atlas.glyph_count; i++) {
+            if (atlas.glyphs[i].codepoint == cp) {
+                expected = &atlas.glyphs[i];
+                break;
+            }
+        }
+        if (forge_ui_atlas_lookup(&atlas, cp) != expected) {
+            SDL_Log("    FAIL: lookup mismatch for U+%04X", cp);
+            fail_count++;
+            forge_ui_atlas_free(&atlas);
+            return;
+        }
+    }
+    pass_count++;
+
+    forge_ui_atlas_free(&atlas);
+    ASSERT_TRUE(atlas.lookup_pages == NULL);
+    ASSERT_TRUE(!atlas.lookup_ready);
+}
+
+/* ── Test: supplementary-plane codepoints resolve through the hash ──────── */
+
+static void test_atlas_lookup_supplementary(void)
+{
+    TEST("atlas_lookup: supplementary codepoints, duplicates, and misses");
+
+    /* Hand-assembled glyph list — the tables only care about codepoints */
+    ForgeUiPackedGlyph glyphs[6];
+    SDL_memset(glyphs, 0, sizeof(glyphs));
+    glyphs[0].codepoint = 'A';
+    glyphs[1].codepoint = 0x1F600;   /* emoji */
+    glyphs[2].codepoint = 0x1F601;
+    glyphs[3].codepoint = 0x10FFFF;  /* highest valid codepoint */
+    glyphs[4].codepoint = 'A';       /* duplicate — first entry must win */
+    glyphs[5].codepoint = 0x1F600;   /* duplicate in the hash */
+
+    ForgeUiFontAtlas atlas;
+    SDL_memset(&atlas, 0, sizeof(atlas));
+    atlas.glyphs      = glyphs;
+    atlas.glyph_count = 6;
+
+    /* Before the tables are built, lookup falls back to a linear scan */
+    ASSERT_TRUE(forge_ui_atlas_lookup(&atlas, 0x1F601) == &glyphs[2]);
+
+    ASSERT_TRUE(forge_ui__atlas_build_lookup(&atlas));
+    ASSERT_TRUE(atlas.lookup_ready);
+    ASSERT_TRUE(atlas.lookup_hash != NULL);
+
+    ASSERT_TRUE(forge_ui_atlas_lookup(&atlas, 'A') == &glyphs[0]);
+    ASSERT_TRUE(forge_ui_atlas_lookup(&atlas, 0x1F600) == &glyphs[1]);
+    ASSERT_TRUE(forge_ui_atlas_lookup(&atlas, 0x1F601) == &glyphs[2]);
+    ASSERT_TRUE(forge_ui_atlas_lookup(&atlas, 0x10FFFF) == &glyphs[3]);
+    ASSERT_TRUE(forge_ui_atlas_lookup(&atlas, 'B') == NULL);
+    ASSERT_TRUE(forge_ui_atlas_lookup(&atlas, 0x4E00) == NULL);
+    ASSERT_TRUE(forge_ui_atlas_lookup(&atlas, 0x1F602) == NULL);
+    ASSERT_TRUE(forge_ui_atlas_lookup(&atlas, 0xFFFFFFFFu) == NULL);
+
+    SDL_free(atlas.lookup_pages);
+    SDL_free(atlas.lookup_hash);
+}
+
 /* ── Test: UV coordinates are in [0, 1] range ────────────────────────────── */
 
 static void test_atlas_uv_range(void)
@@ -1531,6 +1985,182 @@ static void test_layout_invalid_atlas(void)
     ASSERT_TRUE(!result);
 }
 
+/* ── Test: layout_into matches layout and appends after existing data ────── */
+
+#define SINK_PREFILL_VERTS   8
+#define SINK_PREFILL_INDICES 12
+
+static void test_layout_into_matches_layout(void)
+{
+    TEST("text_layout_into: appends the same quads as text_layout");
+    if (!atlas_built) return;
+
+    ForgeUiTextOpts opts = { 300.0f, FORGE_UI_TEXT_ALIGN_CENTER,
+                             0.2f, 0.4f, 0.6f, 0.8f };
+    const char *text = "Hello, World!\nSecond line wraps here";
+    ForgeUiTextLayout ref;
+    ASSERT_TRUE(forge_ui_text_layout(&test_atlas, text, 12.0f, 40.0f,
+                                     &opts, &ref));
+
+    /* A sink that already holds another widget's quads */
+    int vcount = SINK_PREFILL_VERTS, vcap = SINK_PREFILL_VERTS;
+    int icount = SINK_PREFILL_INDICES, icap = SINK_PREFILL_INDICES;
+    ForgeUiVertex *verts = (ForgeUiVertex *)SDL_calloc(
+        SINK_PREFILL_VERTS, sizeof(ForgeUiVertex));
+    Uint32 *indices = (Uint32 *)SDL_calloc(SINK_PREFILL_INDICES,
+                                           sizeof(Uint32));
+    ASSERT_TRUE(verts && indices);
+    verts[SINK_PREFILL_VERTS - 1].pos_x = 123.0f;
+    indices[SINK_PREFILL_INDICES - 1] = 7;
+
+    ForgeUiTextSink sink;
+    SDL_memset(&sink, 0, sizeof(sink));
+    sink.vertices = &verts;   sink.vertex_count = &vcount;
+    sink.vertex_capacity = &vcap;
+    sink.indices = &indices;  sink.index_count = &icount;
+    sink.index_capacity = &icap;
+
+    ForgeUiTextMetrics m;
+    ASSERT_TRUE(forge_ui_text_layout_into(&test_atlas, text, 12.0f, 40.0f,
+                                          &opts, &sink, &m));
+    ASSERT_EQ_INT(vcount, SINK_PREFILL_VERTS + ref.vertex_count);
+    ASSERT_EQ_INT(icount, SINK_PREFILL_INDICES + ref.index_count);
+    ASSERT_TRUE(vcap >= vcount && icap >= icount);
+
+    /* Existing contents survive the grow */
+    ASSERT_TRUE(verts[SINK_PREFILL_VERTS - 1].pos_x == 123.0f);
+    ASSERT_EQ_U32(indices[SINK_PREFILL_INDICES - 1], 7);
+
+    /* Same arithmetic, so the vertices are bit-identical */
+    ASSERT_TRUE(SDL_memcmp(&verts[SINK_PREFILL_VERTS], ref.vertices,
+                           (size_t)ref.vertex_count *
+                           sizeof(ForgeUiVertex)) == 0);
+    for (int i = 0; i < ref.index_count; i++) {
+        ASSERT_EQ_U32(indices[SINK_PREFILL_INDICES + i],
+                      ref.indices[i] + SINK_PREFILL_VERTS);
+    }
+    ASSERT_TRUE(m.width == ref.total_width);
+    ASSERT_TRUE(m.height == ref.total_height);
+    ASSERT_EQ_INT(m.line_count, ref.line_count);
+
+    SDL_free(verts);
+    SDL_free(indices);
+    forge_ui_text_layout_free(&ref);
+}
+
+/* ── Test: layout_into clips after alignment ─────────────────────────────── */
+
+static void test_layout_into_clipped(void)
+{
+    TEST("text_layout_into: clipped output equals clipping aligned quads");
+    if (!atlas_built) return;
+
+    /* Right alignment moves the quads; the clip must see final positions */
+    ForgeUiTextOpts opts = { 400.0f, FORGE_UI_TEXT_ALIGN_RIGHT,
+                             1.0f, 1.0f, 1.0f, 1.0f };
+    const char *text = "Clip me\nthen me";
+    ForgeUiTextLayout ref;
+    ASSERT_TRUE(forge_ui_text_layout(&test_atlas, text, 0.0f, 50.0f,
+                                     &opts, &ref));
+    ASSERT_TRUE(ref.vertex_count > 0);
+
+    /* Clip through the middle of the first glyph of the first line */
+    float cx0 = ref.vertices[0].pos_x +
+                (ref.vertices[1].pos_x - ref.vertices[0].pos_x) * 0.5f;
+    float cy0 = 0.0f, cx1 = 400.0f, cy1 = 55.0f;
+
+    ForgeUiVertex *verts = NULL;
+    Uint32 *indices = NULL;
+    int vcount = 0, vcap = 0, icount = 0, icap = 0;
+    ForgeUiTextSink sink;
+    SDL_memset(&sink, 0, sizeof(sink));
+    sink.vertices = &verts;   sink.vertex_count = &vcount;
+    sink.vertex_capacity = &vcap;
+    sink.indices = &indices;  sink.index_count = &icount;
+    sink.index_capacity = &icap;
+    sink.has_clip = true;
+    sink.clip_x0 = cx0;  sink.clip_y0 = cy0;
+    sink.clip_x1 = cx1;  sink.clip_y1 = cy1;
+
+    ASSERT_TRUE(forge_ui_text_layout_into(&test_atlas, text, 0.0f, 50.0f,
+                                          &opts, &sink, NULL));
+
+    /* Expected: the unclipped quads, clipped one at a time, in order */
+    int expected = 0;
+    for (int q = 0; q < ref.vertex_count / 4; q++) {
+        ForgeUiVertex quad[4];
+        SDL_memcpy(quad, &ref.vertices[q * 4], sizeof(quad));
+        if (!forge_ui__clip_glyph_quad(quad, cx0, cy0, cx1, cy1)) continue;
+        ASSERT_TRUE(expected * 4 < vcount);
+        ASSERT_TRUE(SDL_memcmp(&verts[expected * 4], quad,
+                               sizeof(quad)) == 0);
+        expected++;
+    }
+    ASSERT_TRUE(expected > 0);
+    ASSERT_TRUE(expected < ref.vertex_count / 4);  /* line 2 is clipped */
+    ASSERT_EQ_INT(vcount, expected * 4);
+    ASSERT_EQ_INT(icount, expected * 6);
+    for (int i = 0; i < vcount; i++) {
+        ASSERT_TRUE(verts[i].pos_x >= cx0 && verts[i].pos_x <= cx1);
+        ASSERT_TRUE(verts[i].pos_y >= cy0 && verts[i].pos_y <= cy1);
+    }
+
+    SDL_free(verts);
+    SDL_free(indices);
+    forge_ui_text_layout_free(&ref);
+}
+
+/* ── Test: layout_into with a vertex-only sink ───────────────────────────── */
+
+static void test_layout_into_vertices_only(void)
+{
+    TEST("text_layout_into: NULL indices collects vertices only");
+    if (!atlas_built) return;
+
+    ForgeUiVertex *verts = NULL;
+    int vcount = 0, vcap = 0;
+    ForgeUiTextSink sink;
+    SDL_memset(&sink, 0, sizeof(sink));
+    sink.vertices = &verts;
+    sink.vertex_count = &vcount;
+    sink.vertex_capacity = &vcap;
+
+    ASSERT_TRUE(forge_ui_text_layout_into(&test_atlas, "AB C", 0.0f, 0.0f,
+                                          NULL, &sink, NULL));
+    ASSERT_EQ_INT(vcount, 3 * 4);
+    ASSERT_TRUE(verts != NULL);
+    SDL_free(verts);
+}
+
+/* ── Test: layout_into rejects bad input without touching the sink ──────── */
+
+static void test_layout_into_invalid(void)
+{
+    TEST("text_layout_into: NULL params / bad atlas leave the sink unchanged");
+    if (!atlas_built) return;
+
+    ForgeUiVertex *verts = NULL;
+    int vcount = 0, vcap = 0;
+    ForgeUiTextSink sink;
+    SDL_memset(&sink, 0, sizeof(sink));
+    sink.vertices = &verts;
+    sink.vertex_count = &vcount;
+    sink.vertex_capacity = &vcap;
+
+    ForgeUiFontAtlas bad_atlas;
+    SDL_memset(&bad_atlas, 0, sizeof(bad_atlas));
+
+    ASSERT_TRUE(!forge_ui_text_layout_into(NULL, "A", 0, 0, NULL, &sink, NULL));
+    ASSERT_TRUE(!forge_ui_text_layout_into(&test_atlas, NULL, 0, 0, NULL,
+                                           &sink, NULL));
+    ASSERT_TRUE(!forge_ui_text_layout_into(&test_atlas, "A", 0, 0, NULL,
+                                           NULL, NULL));
+    ASSERT_TRUE(!forge_ui_text_layout_into(&bad_atlas, "A", 0, 0, NULL,
+                                           &sink, NULL));
+    ASSERT_EQ_INT(vcount, 0);
+    ASSERT_TRUE(verts == NULL);
+}
+
 /* ── Test: measure returns zero for atlas with units_per_em == 0 ─────────── */
 
 static void test_measure_invalid_atlas(void)
@@ -1545,6 +2175,579 @@ static void test_measure_invalid_atlas(void)
     ASSERT_TRUE(m.width == 0.0f);
 }
 
+/* ══════════════════════════════════════════════════════════════════════════ */
+/* ── Vertex Packing Tests ───────────────────────────────────────────────── */
+/* ══════════════════════════════════════════════════════════════════════════ */
+
+static void test_packed_vertex_layout(void)
+{
+    TEST("packed_vertex: 16 bytes, GPU-friendly field offsets");
+    ASSERT_EQ_INT((int)sizeof(ForgeUiPackedVertex), 16);
+    ASSERT_EQ_INT((int)offsetof(ForgeUiPackedVertex, uv_u), 8);
+    ASSERT_EQ_INT((int)offsetof(ForgeUiPackedVertex, r), 12);
+}
+
+static void test_pack_vertices_rounding(void)
+{
+    TEST("pack_vertices: rounds to nearest, clamps, maps NaN to 0");
+    ForgeUiVertex src[2] = {
+        { 10.25f, -3.5f, 0.5f, 1.0f, 1.0f, 0.0f, 0.2f, 0.5f },
+        { 0.0f, 0.0f, -0.5f, 2.0f, NAN, 1.5f, 0.999f, 0.001f },
+    };
+    ForgeUiPackedVertex dst[2];
+    forge_ui_pack_vertices(src, dst, 2);
+
+    ASSERT_TRUE(dst[0].pos_x == 10.25f && dst[0].pos_y == -3.5f);
+    ASSERT_EQ_INT(dst[0].uv_u, 32768);
+    ASSERT_EQ_INT(dst[0].uv_v, 65535);
+    ASSERT_EQ_INT(dst[0].r, 255);
+    ASSERT_EQ_INT(dst[0].g, 0);
+    ASSERT_EQ_INT(dst[0].b, 51);
+    ASSERT_EQ_INT(dst[0].a, 128);
+
+    ASSERT_EQ_INT(dst[1].uv_u, 0);
+    ASSERT_EQ_INT(dst[1].uv_v, 65535);
+    ASSERT_EQ_INT(dst[1].r, 0);
+    ASSERT_EQ_INT(dst[1].g, 255);
+    ASSERT_EQ_INT(dst[1].b, 255);
+    ASSERT_EQ_INT(dst[1].a, 0);
+}
+
+static void test_pack_vertices_matches_scalar(void)
+{
+    TEST("pack_vertices: SIMD path matches the per-vertex reference");
+    /* Rounding edges, out-of-range values, NaN and infinities, plus a
+     * spread of ordinary values from a fixed LCG */
+    static const float edges[] = {
+        0.0f, -0.0f, 1.0f, -1.0f, 2.0f, NAN, INFINITY, -INFINITY,
+        0.5f / 255.0f, 1.5f / 255.0f, 254.5f / 255.0f,
+        0.5f / 65535.0f, 32767.5f / 65535.0f, 1.0e-30f, 0.999999f
+    };
+    enum { N = 257 };
+    ForgeUiVertex src[N];
+    ForgeUiPackedVertex simd[N], ref[N];
+    Uint32 seed = 12345u;
+    for (int i = 0; i < N; i++) {
+        float f[8];
+        for (int k = 0; k < 8; k++) {
+            seed = seed * 1664525u + 1013904223u;
+            if ((seed >> 28) < 4) {
+                f[k] = edges[(seed >> 8) % SDL_arraysize(edges)];
+            } else {
+                f[k] = (float)(seed >> 8) / (float)(1u << 24) * 1.2f - 0.1f;
+            }
+        }
+        SDL_memcpy(&src[i], f, sizeof(f));
+    }
+    forge_ui_pack_vertices(src, simd, N);
+    for (int i = 0; i < N; i++) forge_ui__pack_vertex(&src[i], &ref[i]);
+    for (int i = 0; i < N; i++) {
+        ASSERT_TRUE(SDL_memcmp(&simd[i], &ref[i], sizeof(ref[i])) == 0);
+    }
+}
+
+static void test_pack_vertices_round_trip(void)
+{
+    TEST("pack_vertices: laid-out text survives a round trip within 1 LSB");
+    if (!atlas_built) return;
+
+    ForgeUiTextOpts opts = { 0.0f, FORGE_UI_TEXT_ALIGN_LEFT,
+                             0.3f, 0.6f, 0.9f, 0.75f };
+    ForgeUiTextLayout layout;
+    ASSERT_TRUE(forge_ui_text_layout(&test_atlas, "Packed {glyphs}!",
+                                     5.5f, 30.0f, &opts, &layout));
+    int n = layout.vertex_count;
+    ForgeUiPackedVertex *packed = (ForgeUiPackedVertex *)SDL_malloc(
+        (size_t)n * sizeof(ForgeUiPackedVertex));
+    ForgeUiVertex *back = (ForgeUiVertex *)SDL_malloc(
+        (size_t)n * sizeof(ForgeUiVertex));
+    ASSERT_TRUE(packed && back);
+
+    forge_ui_pack_vertices(layout.vertices, packed, n);
+    forge_ui_unpack_vertices(packed, back, n);
+    for (int i = 0; i < n; i++) {
+        const ForgeUiVertex *a = &layout.vertices[i];
+        const ForgeUiVertex *b = &back[i];
+        ASSERT_TRUE(a->pos_x == b->pos_x && a->pos_y == b->pos_y);
+        ASSERT_TRUE(SDL_fabsf(a->uv_u - b->uv_u) <= 0.5f / 65535.0f + 1e-7f);
+        ASSERT_TRUE(SDL_fabsf(a->uv_v - b->uv_v) <= 0.5f / 65535.0f + 1e-7f);
+        ASSERT_TRUE(SDL_fabsf(a->r - b->r) <= 0.5f / 255.0f + 1e-6f);
+        ASSERT_TRUE(SDL_fabsf(a->a - b->a) <= 0.5f / 255.0f + 1e-6f);
+    }
+
+    SDL_free(packed);
+    SDL_free(back);
+    forge_ui_text_layout_free(&layout);
+}
+
+/* ══════════════════════════════════════════════════════════════════════════ */
+/* ── Signed Distance Field Tests ───────────────────────────────────────── */
+/* ══════════════════════════════════════════════════════════════════════════ */
+
+#define SDF_RANGE 4.0f
+
+/* ── Test: SDF sign and falloff for 'O' ──────────────────────────────────── */
+
+static void test_sdf_glyph_sign(void)
+{
+    TEST("rasterize_glyph_sdf: 'O' is inside on the ring, outside in the hole");
+    if (!font_loaded) return;
+
+    Uint16 idx = forge_ui_ttf_glyph_index(&test_font, 'O');
+    ForgeUiGlyphBitmap sdf;
+    ASSERT_TRUE(forge_ui_rasterize_glyph_sdf(&test_font, idx, 64.0f,
+                                             SDF_RANGE, &sdf));
+    ASSERT_TRUE(sdf.width > 0 && sdf.height > 0);
+
+    /* Corners are beyond the range margin: fully outside */
+    Uint8 corner = sdf.pixels[0];
+    /* The hole center is far from the ring: well below the edge value */
+    Uint8 hole = sdf.pixels[(sdf.height / 2) * sdf.width + sdf.width / 2];
+
+    /* Somewhere on the middle row the ring is more than the range deep */
+    Uint8 ring_max = 0;
+    const Uint8 *mid = &sdf.pixels[(sdf.height / 2) * sdf.width];
+    for (int x = 0; x < sdf.width / 2; x++) {
+        if (mid[x] > ring_max) ring_max = mid[x];
+    }
+    forge_ui_glyph_bitmap_free(&sdf);
+
+    ASSERT_EQ_INT(corner, 0);
+    ASSERT_TRUE(hole < 64);
+    ASSERT_TRUE(ring_max > 200);
+}
+
+/* ── Test: thresholding the SDF reproduces the glyph's area ──────────────── */
+
+static void test_sdf_matches_coverage(void)
+{
+    TEST("rasterize_glyph_sdf: texels >= 128 match analytic ink within 2%");
+    if (!font_loaded) return;
+
+    ForgeUiRasterOpts opts;
+    SDL_memset(&opts, 0, sizeof(opts));
+    opts.method = FORGE_UI_RASTER_ANALYTIC;
+
+    const char *letters = "AOgx@";
+    for (const char *c = letters; *c; c++) {
+        Uint16 idx = forge_ui_ttf_glyph_index(&test_font, (Uint32)*c);
+        ForgeUiGlyphBitmap sdf, cov;
+        ASSERT_TRUE(forge_ui_rasterize_glyph_sdf(&test_font, idx, 96.0f,
+                                                 SDF_RANGE, &sdf));
+        ASSERT_TRUE(forge_ui_rasterize_glyph(&test_font, idx, 96.0f,
+                                             &opts, &cov));
+
+        long long inside = 0, ink = 0;
+        for (int i = 0; i < sdf.width * sdf.height; i++) {
+            if (sdf.pixels[i] >= 128) inside++;
+        }
+        for (int i = 0; i < cov.width * cov.height; i++) {
+            ink += cov.pixels[i];
+        }
+        /* The SDF bitmap is larger by the range margin on every side */
+        int margin = (int)SDL_ceilf(SDF_RANGE);
+        bool sized = sdf.width >= cov.width + 2 * margin - 1 &&
+                     sdf.height >= cov.height + 2 * margin - 1;
+        forge_ui_glyph_bitmap_free(&sdf);
+        forge_ui_glyph_bitmap_free(&cov);
+
+        long long ink_px = ink / 255;
+        long long diff = inside - ink_px;
+        if (diff < 0) diff = -diff;
+        ASSERT_TRUE(sized);
+        /* Counting texel centers is a sampling of the area, so allow for
+         * the boundary noise that sampling brings */
+        ASSERT_TRUE(diff * 100 <= ink_px * 2);
+    }
+}
+
+/* ── Test: SDF range validation ──────────────────────────────────────────── */
+
+static void test_sdf_invalid_range(void)
+{
+    TEST("rasterize_glyph_sdf: rejects zero, negative, and oversized ranges");
+    if (!font_loaded) return;
+
+    Uint16 idx = forge_ui_ttf_glyph_index(&test_font, 'A');
+    ForgeUiGlyphBitmap sdf;
+    ASSERT_TRUE(!forge_ui_rasterize_glyph_sdf(&test_font, idx, 32.0f,
+                                              0.0f, &sdf));
+    ASSERT_TRUE(!forge_ui_rasterize_glyph_sdf(&test_font, idx, 32.0f,
+                                              -1.0f, &sdf));
+    ASSERT_TRUE(!forge_ui_rasterize_glyph_sdf(&test_font, idx, 32.0f,
+                                              FORGE_UI_SDF_MAX_RANGE * 2.0f,
+                                              &sdf));
+    ASSERT_TRUE(sdf.pixels == NULL);
+}
+
+/* ── Test: SDF atlas records its mode and serves other pixel heights ─────── */
+
+static void test_sdf_atlas_retarget(void)
+{
+    TEST("atlas_build_opts: SDF atlas can be retargeted to any pixel height");
+    if (!font_loaded) return;
+
+    Uint32 codepoints[ASCII_COUNT];
+    for (int i = 0; i < ASCII_COUNT; i++) {
+        codepoints[i] = (Uint32)(ASCII_START + i);
+    }
+    ForgeUiAtlasOpts opts;
+    SDL_memset(&opts, 0, sizeof(opts));
+    opts.mode = FORGE_UI_ATLAS_SDF;  /* sdf_range 0 = default */
+
+    ForgeUiFontAtlas atlas;
+    ASSERT_TRUE(forge_ui_atlas_build_opts(&test_font, ATLAS_PIXEL_HEIGHT,
+                                          codepoints, ASCII_COUNT,
+                                          ATLAS_PADDING, &opts, &atlas));
+    ASSERT_EQ_INT(atlas.mode, FORGE_UI_ATLAS_SDF);
+    ASSERT_TRUE(atlas.sdf_range == FORGE_UI_SDF_DEFAULT_RANGE);
+    ASSERT_TRUE(atlas.raster_pixel_height == ATLAS_PIXEL_HEIGHT);
+    ASSERT_TRUE(forge_ui_atlas_sdf_screen_range(&atlas) ==
+                2.0f * FORGE_UI_SDF_DEFAULT_RANGE);
+
+    ForgeUiTextLayout small, large;
+    ASSERT_TRUE(forge_ui_text_layout(&atlas, "Hg", 0.0f, 0.0f, NULL, &small));
+    ASSERT_TRUE(forge_ui_atlas_set_pixel_height(&atlas,
+                                                ATLAS_PIXEL_HEIGHT * 3.0f));
+    ASSERT_TRUE(forge_ui_text_layout(&atlas, "Hg", 0.0f, 0.0f, NULL, &large));
+
+    /* Every coordinate scales by 3 when laid out from the origin, and the
+     * distance range in screen pixels grows with it */
+    bool scaled = small.vertex_count == large.vertex_count;
+    for (int i = 0; scaled && i < small.vertex_count; i++) {
+        float dx = large.vertices[i].pos_x - 3.0f * small.vertices[i].pos_x;
+        float dy = large.vertices[i].pos_y - 3.0f * small.vertices[i].pos_y;
+        if (SDL_fabsf(dx) > 0.01f || SDL_fabsf(dy) > 0.01f) scaled = false;
+        if (large.vertices[i].uv_u != small.vertices[i].uv_u) scaled = false;
+    }
+    bool width_scaled = SDL_fabsf(large.total_width -
+                                  3.0f * small.total_width) < 0.01f;
+    float range = forge_ui_atlas_sdf_screen_range(&atlas);
+    forge_ui_text_layout_free(&small);
+    forge_ui_text_layout_free(&large);
+    forge_ui_atlas_free(&atlas);
+
+    ASSERT_TRUE(scaled);
+    ASSERT_TRUE(width_scaled);
+    ASSERT_TRUE(range == 6.0f * FORGE_UI_SDF_DEFAULT_RANGE);
+}
+
+/* ── Test: coverage atlases refuse to be retargeted ──────────────────────── */
+
+static void test_coverage_atlas_rejects_retarget(void)
+{
+    TEST("atlas_set_pixel_height: coverage atlas only accepts its own height");
+    ASSERT_TRUE(atlas_built);
+
+    ASSERT_TRUE(test_atlas.mode == FORGE_UI_ATLAS_COVERAGE);
+    ASSERT_TRUE(forge_ui_atlas_sdf_screen_range(&test_atlas) == 0.0f);
+    ASSERT_TRUE(!forge_ui_atlas_set_pixel_height(&test_atlas,
+                                                 ATLAS_PIXEL_HEIGHT * 2.0f));
+    ASSERT_TRUE(forge_ui_atlas_set_pixel_height(&test_atlas,
+                                                ATLAS_PIXEL_HEIGHT));
+    ASSERT_TRUE(test_atlas.pixel_height == ATLAS_PIXEL_HEIGHT);
+}
+
+/* ══════════════════════════════════════════════════════════════════════════ */
+/* ── Parallel Atlas Build Tests ─────────────────────────────────────────── */
+/* ══════════════════════════════════════════════════════════════════════════ */
+
+static bool atlases_identical(const ForgeUiFontAtlas *a,
+                              const ForgeUiFontAtlas *b)
+{
+    if (a->width != b->width || a->height != b->height
+        || a->glyph_count != b->glyph_count) {
+        return false;
+    }
+    if (SDL_memcmp(a->pixels, b->pixels,
+                   (size_t)a->width * (size_t)a->height) != 0
+        || SDL_memcmp(&a->white_uv, &b->white_uv, sizeof(a->white_uv)) != 0) {
+        return false;
+    }
+    /* Field by field: ForgeUiPackedGlyph has padding bytes */
+    for (int i = 0; i < a->glyph_count; i++) {
+        const ForgeUiPackedGlyph *ga = &a->glyphs[i];
+        const ForgeUiPackedGlyph *gb = &b->glyphs[i];
+        if (ga->codepoint != gb->codepoint
+            || ga->glyph_index != gb->glyph_index
+            || SDL_memcmp(&ga->uv, &gb->uv, sizeof(ga->uv)) != 0
+            || ga->bitmap_w != gb->bitmap_w || ga->bitmap_h != gb->bitmap_h
+            || ga->bearing_x != gb->bearing_x
+            || ga->bearing_y != gb->bearing_y
+            || ga->advance_width != gb->advance_width) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* ── Test: threaded coverage build matches the serial build ──────────────── */
+
+static void test_atlas_parallel_identical(void)
+{
+    TEST("atlas_build_opts: 4 threads produce a byte-identical atlas");
+    if (!font_loaded) return;
+
+    /* 95 glyphs is six work chunks, enough to spread across threads */
+    Uint32 codepoints[ASCII_COUNT];
+    for (int i = 0; i < ASCII_COUNT; i++) {
+        codepoints[i] = (Uint32)(ASCII_START + i);
+    }
+
+    ForgeUiAtlasOpts opts;
+    SDL_memset(&opts, 0, sizeof(opts));
+    ForgeUiFontAtlas serial, parallel;
+    ASSERT_TRUE(forge_ui_atlas_build_opts(&test_font, ATLAS_PIXEL_HEIGHT,
+                                          codepoints, ASCII_COUNT, ATLAS_PADDING,
+                                          &opts, &serial));
+    opts.thread_count = 4;
+    ASSERT_TRUE(forge_ui_atlas_build_opts(&test_font, ATLAS_PIXEL_HEIGHT,
+                                          codepoints, ASCII_COUNT, ATLAS_PADDING,
+                                          &opts, &parallel));
+    bool same = atlases_identical(&serial, &parallel);
+    forge_ui_atlas_free(&serial);
+    forge_ui_atlas_free(&parallel);
+    ASSERT_TRUE(same);
+}
+
+/* ── Test: threaded SDF build matches the serial build ───────────────────── */
+
+static void test_atlas_parallel_sdf_identical(void)
+{
+    TEST("atlas_build_opts: threaded SDF atlas is byte-identical");
+    if (!font_loaded) return;
+
+    /* 95 glyphs is six work chunks, enough to spread across threads */
+    Uint32 codepoints[ASCII_COUNT];
+    for (int i = 0; i < ASCII_COUNT; i++) {
+        codepoints[i] = (Uint32)(ASCII_START + i);
+    }
+
+    ForgeUiAtlasOpts opts;
+    SDL_memset(&opts, 0, sizeof(opts));
+    opts.mode = FORGE_UI_ATLAS_SDF;
+    ForgeUiFontAtlas serial, parallel;
+    ASSERT_TRUE(forge_ui_atlas_build_opts(&test_font, ATLAS_PIXEL_HEIGHT,
+                                          codepoints, ASCII_COUNT, ATLAS_PADDING,
+                                          &opts, &serial));
+    opts.thread_count = 3;
+    ASSERT_TRUE(forge_ui_atlas_build_opts(&test_font, ATLAS_PIXEL_HEIGHT,
+                                          codepoints, ASCII_COUNT, ATLAS_PADDING,
+                                          &opts, &parallel));
+    bool same = atlases_identical(&serial, &parallel);
+    forge_ui_atlas_free(&serial);
+    forge_ui_atlas_free(&parallel);
+    ASSERT_TRUE(same);
+}
+
+/* ── Test: thread count is clamped to the work available ─────────────────── */
+
+static void test_atlas_parallel_clamps_threads(void)
+{
+    TEST("atlas_build_opts: oversized thread_count is clamped");
+    if (!font_loaded) return;
+
+    /* U+00C9 is a compound glyph: it is skipped, and the glyphs after it
+     * must still land in the same order as the serial build */
+    Uint32 codepoints[] = { 'A', 0xC9, 'g', '@' };
+    ForgeUiAtlasOpts opts;
+    SDL_memset(&opts, 0, sizeof(opts));
+    ForgeUiFontAtlas serial, parallel;
+    ASSERT_TRUE(forge_ui_atlas_build_opts(&test_font, ATLAS_PIXEL_HEIGHT,
+                                          codepoints, 4, ATLAS_PADDING,
+                                          &opts, &serial));
+    opts.thread_count = FORGE_UI_ATLAS_MAX_THREADS * 4;
+    ASSERT_TRUE(forge_ui_atlas_build_opts(&test_font, ATLAS_PIXEL_HEIGHT,
+                                          codepoints, 4, ATLAS_PADDING,
+                                          &opts, &parallel));
+    bool same = atlases_identical(&serial, &parallel);
+    forge_ui_atlas_free(&serial);
+    forge_ui_atlas_free(&parallel);
+    ASSERT_TRUE(same);
+}
+
+/* ══════════════════════════════════════════════════════════════════════════ */
+/* ── Atlas Packing Tests ────────────────────────────────────────────────── */
+/* ══════════════════════════════════════════════════════════════════════════ */
+
+/* Build an ASCII atlas with the given packer and sizing */
+static bool build_packed_atlas(ForgeUiAtlasPacker packer, bool npot,
+                               ForgeUiFontAtlas *out)
+{
+    Uint32 codepoints[ASCII_COUNT];
+    for (int i = 0; i < ASCII_COUNT; i++) {
+        codepoints[i] = (Uint32)(ASCII_START + i);
+    }
+    ForgeUiAtlasOpts opts;
+    SDL_memset(&opts, 0, sizeof(opts));
+    opts.packer = packer;
+    opts.non_power_of_two = npot;
+    return forge_ui_atlas_build_opts(&test_font, ATLAS_PIXEL_HEIGHT,
+                                     codepoints, ASCII_COUNT, ATLAS_PADDING,
+                                     &opts, out);
+}
+
+/* True when every glyph lies inside the atlas (padding from the border)
+ * and no two glyphs come closer than the padding. */
+static bool atlas_glyphs_disjoint(const ForgeUiFontAtlas *atlas)
+{
+    for (int i = 0; i < atlas->glyph_count; i++) {
+        const ForgeUiPackedGlyph *a = &atlas->glyphs[i];
+        if (a->bitmap_w == 0 || a->bitmap_h == 0) continue;
+        int ax = (int)(a->uv.u0 * (float)atlas->width + 0.5f);
+        int ay = (int)(a->uv.v0 * (float)atlas->height + 0.5f);
+        if (ax < ATLAS_PADDING || ay < ATLAS_PADDING
+            || ax + a->bitmap_w + ATLAS_PADDING > atlas->width
+            || ay + a->bitmap_h + ATLAS_PADDING > atlas->height) {
+            return false;
+        }
+        for (int j = i + 1; j < atlas->glyph_count; j++) {
+            const ForgeUiPackedGlyph *b = &atlas->glyphs[j];
+            if (b->bitmap_w == 0 || b->bitmap_h == 0) continue;
+            int bx = (int)(b->uv.u0 * (float)atlas->width + 0.5f);
+            int by = (int)(b->uv.v0 * (float)atlas->height + 0.5f);
+            if (ax < bx + b->bitmap_w + ATLAS_PADDING
+                && bx < ax + a->bitmap_w + ATLAS_PADDING
+                && ay < by + b->bitmap_h + ATLAS_PADDING
+                && by < ay + a->bitmap_h + ATLAS_PADDING) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* ── Test: skyline packer places glyphs without overlap ──────────────────── */
+
+static void test_atlas_skyline_disjoint(void)
+{
+    TEST("atlas_build_opts: skyline packer keeps glyphs apart");
+    if (!font_loaded) return;
+
+    ForgeUiFontAtlas atlas;
+    ASSERT_TRUE(build_packed_atlas(FORGE_UI_ATLAS_PACK_SKYLINE, false, &atlas));
+    bool disjoint = atlas_glyphs_disjoint(&atlas);
+    int wx = (int)(atlas.white_uv.u0 * (float)atlas.width);
+    int wy = (int)(atlas.white_uv.v0 * (float)atlas.height);
+    Uint8 white = atlas.pixels[wy * atlas.width + wx];
+    bool pow2 = (atlas.width & (atlas.width - 1)) == 0
+             && (atlas.height & (atlas.height - 1)) == 0;
+    forge_ui_atlas_free(&atlas);
+
+    ASSERT_TRUE(disjoint);
+    ASSERT_EQ_INT(white, 255);
+    ASSERT_TRUE(pow2);
+}
+
+/* ── Test: skyline uses the texture at least as well as shelves ──────────── */
+
+static void test_atlas_skyline_denser(void)
+{
+    TEST("atlas_build_opts: skyline atlas is no larger than shelf atlas");
+    if (!font_loaded) return;
+
+    ForgeUiFontAtlas shelf, skyline;
+    ASSERT_TRUE(build_packed_atlas(FORGE_UI_ATLAS_PACK_SHELF, true, &shelf));
+    ASSERT_TRUE(build_packed_atlas(FORGE_UI_ATLAS_PACK_SKYLINE, true,
+                                   &skyline));
+    int shelf_area = shelf.width * shelf.height;
+    int skyline_area = skyline.width * skyline.height;
+    float shelf_eff = shelf.packing_efficiency;
+    float skyline_eff = skyline.packing_efficiency;
+    forge_ui_atlas_free(&shelf);
+    forge_ui_atlas_free(&skyline);
+
+    ASSERT_TRUE(skyline_area <= shelf_area);
+    ASSERT_TRUE(skyline_eff >= shelf_eff);
+}
+
+/* ── Test: non-power-of-two atlases trim to the packed glyphs ────────────── */
+
+static void test_atlas_npot_tight(void)
+{
+    TEST("atlas_build_opts: non_power_of_two atlas is tight and aligned");
+    if (!font_loaded) return;
+
+    ForgeUiFontAtlas pow2, npot;
+    ASSERT_TRUE(build_packed_atlas(FORGE_UI_ATLAS_PACK_SKYLINE, false, &pow2));
+    ASSERT_TRUE(build_packed_atlas(FORGE_UI_ATLAS_PACK_SKYLINE, true, &npot));
+    bool disjoint = atlas_glyphs_disjoint(&npot);
+    int pow2_area = pow2.width * pow2.height;
+    int npot_w = npot.width, npot_h = npot.height;
+    float pow2_eff = pow2.packing_efficiency;
+    float npot_eff = npot.packing_efficiency;
+    forge_ui_atlas_free(&pow2);
+    forge_ui_atlas_free(&npot);
+
+    ASSERT_TRUE(disjoint);
+    ASSERT_EQ_INT(npot_w % FORGE_UI_ATLAS_NPOT_ALIGN, 0);
+    ASSERT_EQ_INT(npot_h % FORGE_UI_ATLAS_NPOT_ALIGN, 0);
+    ASSERT_TRUE(npot_w * npot_h <= pow2_area);
+    ASSERT_TRUE(npot_eff >= pow2_eff);
+}
+
+/* ── Test: default build reports its packing efficiency ──────────────────── */
+
+static void test_atlas_packing_efficiency(void)
+{
+    TEST("atlas_build: packing_efficiency is the used fraction of texels");
+    ASSERT_TRUE(atlas_built);
+
+    Uint64 used = 4;  /* 2x2 white region */
+    for (int i = 0; i < test_atlas.glyph_count; i++) {
+        used += (Uint64)test_atlas.glyphs[i].bitmap_w *
+                (Uint64)test_atlas.glyphs[i].bitmap_h;
+    }
+    float expected = (float)((double)used /
+                             ((double)test_atlas.width * test_atlas.height));
+    ASSERT_TRUE(test_atlas.packing_efficiency > 0.0f);
+    ASSERT_TRUE(test_atlas.packing_efficiency <= 1.0f);
+    ASSERT_TRUE(SDL_fabsf(test_atlas.packing_efficiency - expected) < 1e-6f);
+}
+
+/* ── Test: default atlases keep the square power-of-two search ───────────── */
+/* Shelf packing without options starts from the smallest power-of-two
+ * square that covers the glyph area, so existing atlas sizes do not change
+ * when the packer options are left at their defaults. */
+
+static void test_atlas_default_square(void)
+{
+    TEST("atlas_build: default power-of-two atlas is square");
+    if (!font_loaded) return;
+
+    Uint32 codepoints[ASCII_COUNT];
+    for (int i = 0; i < ASCII_COUNT; i++) {
+        codepoints[i] = (Uint32)(ASCII_START + i);
+    }
+    ForgeUiFontAtlas small, large;
+    ASSERT_TRUE(forge_ui_atlas_build(&test_font, 16.0f, codepoints,
+                                     ASCII_COUNT, ATLAS_PADDING, &small));
+    ASSERT_TRUE(forge_ui_atlas_build(&test_font, ATLAS_PIXEL_HEIGHT,
+                                     codepoints, ASCII_COUNT, ATLAS_PADDING,
+                                     &large));
+    int small_w = small.width, small_h = small.height;
+    int large_w = large.width, large_h = large.height;
+    forge_ui_atlas_free(&small);
+    forge_ui_atlas_free(&large);
+
+    ASSERT_EQ_INT(small_w, 256);
+    ASSERT_EQ_INT(small_h, 256);
+    ASSERT_EQ_INT(large_w, 256);
+    ASSERT_EQ_INT(large_h, 256);
+}
+
+/* ── Test: unknown packer is rejected ────────────────────────────────────── */
+
+static void test_atlas_invalid_packer(void)
+{
+    TEST("atlas_build_opts: invalid packer fails");
+    if (!font_loaded) return;
+
+    ForgeUiFontAtlas atlas;
+    ASSERT_TRUE(!build_packed_atlas((ForgeUiAtlasPacker)7, false, &atlas));
+    ASSERT_TRUE(atlas.pixels == NULL);
+}
+
 /* ══════════════════════════════════════════════════════════════════════════ */
 /* ── Text Measure Tests ────────────────────────────────────────────────── */
 /* ══════════════════════════════════════════════════════════════════════════ */
@@ -1635,6 +2838,524 @@ static void test_measure_wrapping(void)
     ASSERT_TRUE(m_wrap.height > m_nowrap.height);
 }
 
+/* ── Test: UTF-8 decoding in layout and measure ─────────────────────────── */
+
+static void test_layout_utf8(void)
+{
+    TEST("text_layout: decodes UTF-8 and skips malformed sequences");
+    if (!font_loaded) return;
+
+    /* ASCII plus 2- and 3-byte codepoints (sharp s, Zhe, euro) */
+    Uint32 cps[ASCII_COUNT + 3];
+    for (int i = 0; i < ASCII_COUNT; i++) cps[i] = (Uint32)(ASCII_START + i);
+    cps[ASCII_COUNT + 0] = 0x00DF;
+    cps[ASCII_COUNT + 1] = 0x0416;
+    cps[ASCII_COUNT + 2] = 0x20AC;
+
+    ForgeUiFontAtlas atlas;
+    ASSERT_TRUE(forge_ui_atlas_build(&test_font, ATLAS_PIXEL_HEIGHT, cps,
+                                     ASCII_COUNT + 3, ATLAS_PADDING, &atlas));
+
+    /* Monospaced font: every glyph advances by the same width */
+    float scale = atlas.pixel_height / (float)atlas.units_per_em;
+    float adv = (float)forge_ui_atlas_lookup(&atlas, 'a')->advance_width * scale;
+    const float eps = 1e-3f;
+
+    static const struct {
+        const char *text;
+        int quads;
+    } cases[] = {
+        { "Stra\xC3\x9F" "e",      6 },  /* 2-byte sharp s */
+        { "\xD0\x96\xE2\x82\xAC",  2 },  /* 2-byte Zhe, 3-byte euro */
+        { "a\xF0\x9F\x98\x80" "b", 2 },  /* 4-byte, not in the atlas */
+        { "a\x80" "b",             2 },  /* stray continuation byte */
+        { "a\xC0\xAF" "b",         2 },  /* overlong '/' */
+        { "a\xE0\x80\xAF" "b",     2 },  /* overlong 3-byte */
+        { "a\xED\xA0\x80" "b",     2 },  /* UTF-16 surrogate */
+        { "a\xF4\x90\x80\x80" "b", 2 },  /* above U+10FFFF */
+        { "a\xC3" "b",             2 },  /* truncated, resyncs on 'b' */
+        { "ab\xE2\x82",            2 },  /* truncated at end of string */
+    };
+    for (int c = 0; c < (int)SDL_arraysize(cases); c++) {
+        ForgeUiTextLayout layout;
+        if (!forge_ui_text_layout(&atlas, cases[c].text, 0.0f, 0.0f,
+                                  NULL, &layout)) {
+            SDL_Log("    FAIL: layout of case %d", c);
+            fail_count++;
+            forge_ui_atlas_free(&atlas);
+            return;
+        }
+        ForgeUiTextMetrics m = forge_ui_text_measure(&atlas, cases[c].text,
+                                                     NULL);
+        bool ok = layout.vertex_count == cases[c].quads * 4 &&
+                  SDL_fabsf(layout.total_width - cases[c].quads * adv) < eps &&
+                  SDL_fabsf(m.width - layout.total_width) < eps;
+        forge_ui_text_layout_free(&layout);
+        if (!ok) {
+            SDL_Log("    FAIL: case %d produced the wrong quads or width", c);
+            fail_count++;
+            forge_ui_atlas_free(&atlas);
+            return;
+        }
+    }
+    pass_count++;
+
+    /* The decoder itself: codepoint value and bytes consumed */
+    const char *emoji = "\xF0\x9F\x98\x80";
+    int i = 1;
+    ASSERT_EQ_U32(forge_ui__utf8_decode(emoji, 4, 0xF0, &i), 0x1F600);
+    ASSERT_EQ_INT(i, 4);
+    i = 1;
+    ASSERT_EQ_U32(forge_ui__utf8_decode("\xC3" "b", 2, 0xC3, &i), 0xFFFD);
+    ASSERT_EQ_INT(i, 1);
+
+    forge_ui_atlas_free(&atlas);
+}
+
+/* ── Test: kern and GPOS table parsing ───────────────────────────────────── */
+
+/* Append a big-endian uint16 to a byte buffer */
+static Uint8 *put_u16(Uint8 *p, Uint16 v)
+{
+    p[0] = (Uint8)(v >> 8);
+    p[1] = (Uint8)v;
+    return p + 2;
+}
+
+#define KERN_TEST_GPOS_LEN 202  /* GPOS table at offset 0 */
+#define KERN_TEST_KERN_OFF 204  /* kern table follows, 4-byte aligned */
+#define KERN_TEST_KERN_LEN 50
+
+/* Write a GPOS table with a 'kern' feature (lookups 0 and 2) and a 'liga'
+ * feature (lookup 1), followed by a legacy kern table.  Lookup 0 is
+ * PairPos format 1, lookup 2 a PairPos format 2 behind an extension. */
+static void make_kern_tables(Uint8 *buf)
+{
+    static const Uint16 gpos[] = {
+        /* @0   header: version 1.0, scriptList, featureList, lookupList */
+        1, 0, 0, 10, 38,
+        /* @10  FeatureList: 2 records (tag written below, offset) */
+        2, 0, 0, 14, 0, 0, 22,
+        /* @24  kern feature: params, 2 lookups */
+        0, 2, 0, 2,
+        /* @32  liga feature: params, 1 lookup */
+        0, 1, 1,
+        /* @38  LookupList: 3 lookups */
+        3, 8, 54, 86,
+        /* @46  lookup 0: PairPos, flags, 1 subtable */
+        2, 0, 1, 8,
+        /* @54  PairPos 1: coverage, XAdvance, none, 2 PairSets */
+        1, 14, 0x0004, 0, 2, 22, 32,
+        /* @68  Coverage 1: glyphs 10, 20 */
+        1, 2, 10, 20,
+        /* @76  PairSet for 10: (30, -50), (31, -60) */
+        2, 30, (Uint16)-50, 31, (Uint16)-60,
+        /* @86  PairSet for 20: (30, -70) */
+        1, 30, (Uint16)-70,
+        /* @92  lookup 1 (liga only, must be ignored) */
+        2, 0, 1, 8,
+        /* @100 PairPos 1: (20, 31) = -999 */
+        1, 12, 0x0004, 0, 1, 18,
+        1, 1, 20,
+        1, 31, (Uint16)-999,
+        /* @124 lookup 2: Extension, 1 subtable */
+        9, 0, 1, 8,
+        /* @132 Extension 1: PairPos, 32-bit offset 8 */
+        1, 2, 0, 8,
+        /* @140 PairPos 2: coverage, XPlacement|XAdvance, none, classDefs,
+         *      2x2 classes; matrix of (XPlacement, XAdvance) */
+        2, 32, 0x0005, 0, 42, 52, 2, 2,
+        0, 0,   0, (Uint16)-20,
+        0, 0,   0, (Uint16)-40,
+        /* @172 Coverage 2: glyphs 10-11 */
+        2, 1, 10, 11, 0,
+        /* @182 ClassDef 1: glyph 10 -> class 1, glyph 11 -> class 0 */
+        1, 10, 2, 1, 0,
+        /* @192 ClassDef 2: glyphs 30-32 -> class 1 */
+        2, 1, 30, 32, 1,
+    };
+    static const Uint16 kern[] = {
+        /* version 0, 2 subtables */
+        0, 2,
+        /* horizontal format 0: (40, 41) = -33; glyph 0 pair is dropped */
+        0, 26, 0x0001, 2, 0, 0, 0,
+        40, 41, (Uint16)-33,
+        0, 41, (Uint16)-5,
+        /* minimum-values subtable, must be ignored */
+        0, 20, 0x0003, 1, 0, 0, 0,
+        42, 43, (Uint16)-9,
+    };
+
+    SDL_memset(buf, 0, KERN_TEST_KERN_OFF + KERN_TEST_KERN_LEN);
+    Uint8 *p = buf;
+    for (int i = 0; i < (int)SDL_arraysize(gpos); i++) p = put_u16(p, gpos[i]);
+    SDL_memcpy(buf + 12, "kern", 4);
+    SDL_memcpy(buf + 18, "liga", 4);
+    p = buf + KERN_TEST_KERN_OFF;
+    for (int i = 0; i < (int)SDL_arraysize(kern); i++) p = put_u16(p, kern[i]);
+}
+
+/* Point a zeroed font at the synthetic tables */
+static void make_kern_font(ForgeUiFont *font, Uint8 *buf,
+                           ForgeUiTtfTableEntry *tables, bool with_gpos,
+                           Uint32 gpos_len)
+{
+    SDL_memset(font, 0, sizeof(*font));
+    SDL_memset(tables, 0, 2 * sizeof(*tables));
+    font->data = buf;
+    font->data_size = KERN_TEST_KERN_OFF + KERN_TEST_KERN_LEN;
+    font->tables = tables;
+    SDL_memcpy(tables[0].tag, "kern", 4);
+    tables[0].offset = KERN_TEST_KERN_OFF;
+    tables[0].length = KERN_TEST_KERN_LEN;
+    font->num_tables = 1;
+    if (with_gpos) {
+        SDL_memcpy(tables[1].tag, "GPOS", 4);
+        tables[1].offset = 0;
+        tables[1].length = gpos_len;
+        font->num_tables = 2;
+    }
+}
+
+static void test_kern_table_format0(void)
+{
+    TEST("kerning: kern table format 0 pairs load without GPOS");
+
+    Uint8 buf[KERN_TEST_KERN_OFF + KERN_TEST_KERN_LEN];
+    ForgeUiTtfTableEntry tables[2];
+    ForgeUiFont font;
+    make_kern_tables(buf);
+    make_kern_font(&font, buf, tables, false, 0);
+
+    ASSERT_TRUE(forge_ui__parse_kerning(&font));
+    ASSERT_EQ_U32(font.kern.count, 1);
+    ASSERT_EQ_I16(forge_ui_ttf_kerning(&font, 40, 41), -33);
+    ASSERT_EQ_I16(forge_ui_ttf_kerning(&font, 41, 40), 0);
+    ASSERT_EQ_I16(forge_ui_ttf_kerning(&font, 0, 41), 0);
+    ASSERT_EQ_I16(forge_ui_ttf_kerning(&font, 42, 43), 0);
+    ASSERT_EQ_I16(forge_ui_ttf_kerning(NULL, 40, 41), 0);
+    forge_ui__kern_free(&font.kern);
+    ASSERT_EQ_I16(forge_ui_ttf_kerning(&font, 40, 41), 0);
+}
+
+static void test_kern_gpos_pair_pos(void)
+{
+    TEST("kerning: GPOS PairPos formats 1 and 2 take precedence over kern");
+
+    Uint8 buf[KERN_TEST_KERN_OFF + KERN_TEST_KERN_LEN];
+    ForgeUiTtfTableEntry tables[2];
+    ForgeUiFont font;
+    make_kern_tables(buf);
+    make_kern_font(&font, buf, tables, true, KERN_TEST_GPOS_LEN);
+
+    ASSERT_TRUE(forge_ui__parse_kerning(&font));
+    ASSERT_EQ_U32(font.kern.count, 7);
+
+    /* Format 1 pairs */
+    ASSERT_EQ_I16(forge_ui_ttf_kerning(&font, 10, 30), -50);
+    ASSERT_EQ_I16(forge_ui_ttf_kerning(&font, 10, 31), -60);
+    ASSERT_EQ_I16(forge_ui_ttf_kerning(&font, 20, 30), -70);
+    /* Format 2 class pairs; the earlier lookup wins for (10, 30/31) */
+    ASSERT_EQ_I16(forge_ui_ttf_kerning(&font, 10, 32), -40);
+    ASSERT_EQ_I16(forge_ui_ttf_kerning(&font, 11, 30), -20);
+    ASSERT_EQ_I16(forge_ui_ttf_kerning(&font, 11, 32), -20);
+    ASSERT_EQ_I16(forge_ui_ttf_kerning(&font, 11, 33), 0);
+    /* Lookup outside the kern feature, and the kern table, are unused */
+    ASSERT_EQ_I16(forge_ui_ttf_kerning(&font, 20, 31), 0);
+    ASSERT_EQ_I16(forge_ui_ttf_kerning(&font, 40, 41), 0);
+    forge_ui__kern_free(&font.kern);
+
+    /* A GPOS table cut short keeps the lookups that fit and skips the rest */
+    make_kern_font(&font, buf, tables, true, 150);
+    ASSERT_TRUE(forge_ui__parse_kerning(&font));
+    ASSERT_EQ_U32(font.kern.count, 3);
+    ASSERT_EQ_I16(forge_ui_ttf_kerning(&font, 20, 30), -70);
+    ASSERT_EQ_I16(forge_ui_ttf_kerning(&font, 10, 32), 0);
+    forge_ui__kern_free(&font.kern);
+}
+
+/* ── Test: kerning in atlas build, layout, and measure ──────────────────── */
+
+static void test_layout_kerning(void)
+{
+    TEST("text_layout: pair kerning shifts glyphs and matches measure");
+
+    ForgeUiFont font;
+    ASSERT_TRUE(forge_ui_ttf_load(TEST_FONT_PATH, &font));
+    /* The bundled font has no kerning; add pairs as if it did */
+    ASSERT_EQ_U32(font.kern.count, 0);
+    Uint16 g_a = forge_ui_ttf_glyph_index(&font, 'A');
+    Uint16 g_v = forge_ui_ttf_glyph_index(&font, 'V');
+    Uint16 g_e = forge_ui_ttf_glyph_index(&font, 0x00E9);  /* not in atlas */
+    ASSERT_TRUE(g_a != 0 && g_v != 0 && g_e != 0);
+    ASSERT_TRUE(forge_ui__kern_insert(&font.kern, g_a, g_v, -150));
+    ASSERT_TRUE(forge_ui__kern_insert(&font.kern, g_v, g_a, -150));
+    ASSERT_TRUE(forge_ui__kern_insert(&font.kern, g_a, g_e, -80));
+
+    Uint32 cps[ASCII_COUNT];
+    for (int i = 0; i < ASCII_COUNT; i++) cps[i] = (Uint32)(ASCII_START + i);
+    ForgeUiFontAtlas atlas;
+    bool built = forge_ui_atlas_build(&font, ATLAS_PIXEL_HEIGHT, cps,
+                                      ASCII_COUNT, ATLAS_PADDING, &atlas);
+    forge_ui_ttf_free(&font);
+    ASSERT_TRUE(built);
+
+    /* Only pairs with both glyphs in the atlas are kept */
+    ASSERT_EQ_U32(atlas.kern.count, 2);
+    ASSERT_EQ_I16(forge_ui_atlas_kerning(&atlas, g_a, g_v), -150);
+    ASSERT_EQ_I16(forge_ui_atlas_kerning(&atlas, g_a, g_e), 0);
+
+    /* Same atlas without the pairs, for reference positions */
+    ForgeUiFontAtlas plain = atlas;
+    SDL_memset(&plain.kern, 0, sizeof(plain.kern));
+
+    float kern_px = -150.0f * atlas.pixel_height / (float)atlas.units_per_em;
+    const float eps = 1e-3f;
+    ForgeUiTextLayout kerned, ref;
+    ForgeUiTextMetrics m;
+
+    /* "AV": the V quad moves left by the pair value */
+    ASSERT_TRUE(forge_ui_text_layout(&atlas, "AV", 0.0f, 0.0f, NULL, &kerned));
+    ASSERT_TRUE(forge_ui_text_layout(&plain, "AV", 0.0f, 0.0f, NULL, &ref));
+    bool shifted =
+        kerned.vertices[0].pos_x == ref.vertices[0].pos_x &&
+        SDL_fabsf(kerned.vertices[4].pos_x - ref.vertices[4].pos_x - kern_px) < eps &&
+        SDL_fabsf(kerned.total_width - ref.total_width - kern_px) < eps;
+    m = forge_ui_text_measure(&atlas, "AV", NULL);
+    bool measured = SDL_fabsf(m.width - kerned.total_width) < eps;
+    forge_ui_text_layout_free(&kerned);
+    forge_ui_text_layout_free(&ref);
+    if (!shifted || !measured) forge_ui_atlas_free(&atlas);
+    ASSERT_TRUE(shifted);
+    ASSERT_TRUE(measured);
+
+    /* A newline breaks the pair */
+    ASSERT_TRUE(forge_ui_text_layout(&atlas, "A\nV", 0.0f, 0.0f, NULL, &kerned));
+    ASSERT_TRUE(forge_ui_text_layout(&plain, "A\nV", 0.0f, 0.0f, NULL, &ref));
+    bool unbroken = kerned.vertices[4].pos_x == ref.vertices[4].pos_x;
+    forge_ui_text_layout_free(&kerned);
+    forge_ui_text_layout_free(&ref);
+    if (!unbroken) forge_ui_atlas_free(&atlas);
+    ASSERT_TRUE(unbroken);
+
+    /* Wrapping between A and V: the wrapped V starts flush at the margin */
+    float adv = (float)forge_ui_atlas_lookup(&atlas, 'A')->advance_width *
+                atlas.pixel_height / (float)atlas.units_per_em;
+    ForgeUiTextOpts opts;
+    SDL_memset(&opts, 0, sizeof(opts));
+    opts.max_width = adv * 1.5f;
+    opts.r = 1.0f; opts.g = 1.0f; opts.b = 1.0f; opts.a = 1.0f;
+    ASSERT_TRUE(forge_ui_text_layout(&atlas, "AV", 0.0f, 0.0f, &opts, &kerned));
+    ASSERT_TRUE(forge_ui_text_layout(&plain, "AV", 0.0f, 0.0f, &opts, &ref));
+    m = forge_ui_text_measure(&atlas, "AV", &opts);
+    bool wrapped = kerned.line_count == 2 &&
+                   kerned.vertices[4].pos_x == ref.vertices[4].pos_x &&
+                   m.line_count == kerned.line_count &&
+                   SDL_fabsf(m.width - kerned.total_width) < eps;
+    forge_ui_text_layout_free(&kerned);
+    forge_ui_text_layout_free(&ref);
+    forge_ui_atlas_free(&atlas);
+    ASSERT_TRUE(wrapped);
+}
+
+/* ── Test: paragraphs match direct layout ───────────────────────────────── */
+
+/* Help-text sized sample: hard breaks, tabs, long words, UTF-8 (one
+ * malformed byte), and a run of spaces */
+static const char *PARA_TEXT =
+    "Paragraphs cache glyph advances and line breaks.\n"
+    "\tIndented line with a tab, then words: AVAVAVA WAVE TAVERN.\n"
+    "Supercalifragilisticexpialidocious-and-then-some-more-letters\n"
+    "\n"
+    "Stra\xC3\x9F" "e \xD0\x96 \xE2\x82\xAC 5 \x80 end.    trailing\tTAB\t";
+
+/* Lay out text both ways into fresh sinks and compare the quads */
+static bool paragraph_matches_layout(const ForgeUiFontAtlas *atlas,
+                                     ForgeUiParagraph *para, const char *text,
+                                     const ForgeUiTextOpts *opts,
+                                     bool has_clip, float clip_y0,
+                                     float clip_y1)
+{
+    ForgeUiVertex *va = NULL, *vb = NULL;
+    Uint32 *ia = NULL, *ib = NULL;
+    int vca = 0, vcapa = 0, ica = 0, icapa = 0;
+    int vcb = 0, vcapb = 0, icb = 0, icapb = 0;
+    ForgeUiTextSink sa = { &va, &vca, &vcapa, &ia, &ica, &icapa,
+                           has_clip, -1000.0f, clip_y0, 10000.0f, clip_y1 };
+    ForgeUiTextSink sb = { &vb, &vcb, &vcapb, &ib, &icb, &icapb,
+                           has_clip, -1000.0f, clip_y0, 10000.0f, clip_y1 };
+    ForgeUiTextMetrics ma, mb;
+    bool ok = forge_ui_text_layout_into(atlas, text, 10.0f, 20.0f, opts,
+                                        &sa, &ma) &&
+              forge_ui_paragraph_layout_into(para, 10.0f, 20.0f, opts,
+                                             &sb, &mb);
+    ForgeUiTextMetrics mm = forge_ui_paragraph_measure(para, opts);
+    ForgeUiTextMetrics mt = forge_ui_text_measure(atlas, text, opts);
+    ok = ok && vca == vcb && ica == icb &&
+         (vca == 0 || SDL_memcmp(va, vb, (size_t)vca * sizeof(*va)) == 0) &&
+         (ica == 0 || SDL_memcmp(ia, ib, (size_t)ica * sizeof(*ia)) == 0) &&
+         ma.line_count == mb.line_count && mm.line_count == mt.line_count &&
+         mm.line_count == mb.line_count &&
+         SDL_fabsf(ma.width - mb.width) < 1e-3f &&
+         SDL_fabsf(mm.width - mt.width) < 1e-3f &&
+         SDL_fabsf(mm.height - mt.height) < 1e-3f;
+    SDL_free(va);
+    SDL_free(vb);
+    SDL_free(ia);
+    SDL_free(ib);
+    return ok;
+}
+
+static void test_paragraph_matches_layout(void)
+{
+    TEST("paragraph: same quads and metrics as text_layout_into");
+    ASSERT_TRUE(atlas_built);
+
+    ForgeUiParagraph para;
+    ASSERT_TRUE(forge_ui_paragraph_init(&test_atlas, PARA_TEXT, &para));
+
+    /* No wrap, a glyph-exact width (monospaced), narrow, and odd widths,
+     * each shrinking and then growing again through the wrap cache */
+    float adv = (float)forge_ui_atlas_lookup(&test_atlas, 'a')->advance_width
+                * test_atlas.pixel_height / (float)test_atlas.units_per_em;
+    const float widths[] = { 0.0f, adv * 12.0f, 1000.0f, 333.3f, 97.1f,
+                             adv * 0.5f, 200.0f, 0.0f };
+    const ForgeUiTextAlign aligns[] = { FORGE_UI_TEXT_ALIGN_LEFT,
+                                        FORGE_UI_TEXT_ALIGN_CENTER,
+                                        FORGE_UI_TEXT_ALIGN_RIGHT };
+    for (int a = 0; a < (int)SDL_arraysize(aligns); a++) {
+        for (int w = 0; w < (int)SDL_arraysize(widths); w++) {
+            ForgeUiTextOpts opts = { widths[w], aligns[a],
+                                     0.5f, 0.75f, 1.0f, 1.0f };
+            if (!paragraph_matches_layout(&test_atlas, &para, PARA_TEXT,
+                                          &opts, false, 0.0f, 0.0f)) {
+                SDL_Log("    FAIL: width %.3f, alignment %d",
+                        (double)widths[w], a);
+                fail_count++;
+                forge_ui_paragraph_free(&para);
+                return;
+            }
+        }
+    }
+    pass_count++;
+    forge_ui_paragraph_free(&para);
+
+    /* Empty text: one empty line, as forge_ui_text_measure reports it */
+    ASSERT_TRUE(forge_ui_paragraph_init(&test_atlas, "", &para));
+    ForgeUiTextMetrics m = forge_ui_paragraph_measure(&para, NULL);
+    ASSERT_EQ_INT(m.line_count, 1);
+    ASSERT_TRUE(m.width == 0.0f && m.height == 0.0f);
+    forge_ui_paragraph_free(&para);
+}
+
+static void test_paragraph_kerning(void)
+{
+    TEST("paragraph: kerned breaks, including negative-width pairs");
+    ASSERT_TRUE(atlas_built);
+
+    /* test_atlas with synthetic pairs; one pulls back further than the
+     * glyph advances, so its run cannot be binary-searched */
+    ForgeUiFontAtlas kerned = test_atlas;
+    SDL_memset(&kerned.kern, 0, sizeof(kerned.kern));
+    Uint16 g_a = forge_ui_atlas_lookup(&test_atlas, 'A')->glyph_index;
+    Uint16 g_v = forge_ui_atlas_lookup(&test_atlas, 'V')->glyph_index;
+    Uint16 g_w = forge_ui_atlas_lookup(&test_atlas, 'W')->glyph_index;
+    Uint16 g_e = forge_ui_atlas_lookup(&test_atlas, 'E')->glyph_index;
+    ASSERT_TRUE(forge_ui__kern_insert(&kerned.kern, g_a, g_v, -200));
+    ASSERT_TRUE(forge_ui__kern_insert(&kerned.kern, g_v, g_a, -150));
+    ASSERT_TRUE(forge_ui__kern_insert(&kerned.kern, g_w, g_a, 90));
+    ASSERT_TRUE(forge_ui__kern_insert(&kerned.kern, g_v, g_e, -3000));
+
+    ForgeUiParagraph para;
+    bool ok = forge_ui_paragraph_init(&kerned, PARA_TEXT, &para);
+    if (ok) {
+        bool monotone = true;
+        for (int r = 0; r < para.run_count; r++) {
+            monotone = monotone && para.runs[r].monotone;
+        }
+        ok = !monotone;  /* "WAVE" has the negative-width pair */
+        for (float w = 40.0f; ok && w < 800.0f; w += 7.25f) {
+            ForgeUiTextOpts opts = { w, FORGE_UI_TEXT_ALIGN_LEFT,
+                                     1.0f, 1.0f, 1.0f, 1.0f };
+            if (!paragraph_matches_layout(&kerned, &para, PARA_TEXT, &opts,
+                                          false, 0.0f, 0.0f)) {
+                SDL_Log("    FAIL: width %.2f", (double)w);
+                ok = false;
+            }
+        }
+        forge_ui_paragraph_free(&para);
+    }
+    forge_ui__kern_free(&kerned.kern);
+    ASSERT_TRUE(ok);
+}
+
+static void test_paragraph_wrap_cache(void)
+{
+    TEST("paragraph: line breaks are cached per width");
+    ASSERT_TRUE(atlas_built);
+
+    ForgeUiParagraph para;
+    ASSERT_TRUE(forge_ui_paragraph_init(&test_atlas, PARA_TEXT, &para));
+    ASSERT_TRUE(para.wrap_width < 0.0f);
+    ASSERT_TRUE(para.item_count > 0 && para.quad_count > 0);
+
+    ForgeUiTextOpts opts = { 150.0f, FORGE_UI_TEXT_ALIGN_LEFT,
+                             1.0f, 1.0f, 1.0f, 1.0f };
+    ForgeUiTextMetrics narrow = forge_ui_paragraph_measure(&para, &opts);
+    ASSERT_TRUE(para.wrap_width == 150.0f);
+    ASSERT_EQ_INT(para.line_count, narrow.line_count);
+
+    /* Same width: served from the cache, lines untouched */
+    para.lines[0].width = -1.0f;
+    forge_ui_paragraph_measure(&para, &opts);
+    ASSERT_TRUE(para.lines[0].width == -1.0f);
+
+    /* New width re-wraps */
+    opts.max_width = 600.0f;
+    ForgeUiTextMetrics wide = forge_ui_paragraph_measure(&para, &opts);
+    ASSERT_TRUE(para.wrap_width == 600.0f);
+    ASSERT_TRUE(para.lines[0].width > 0.0f);
+    ASSERT_TRUE(wide.line_count < narrow.line_count);
+
+    /* Negative and NaN widths mean no wrap, like max_width == 0 */
+    opts.max_width = -5.0f;
+    ForgeUiTextMetrics none = forge_ui_paragraph_measure(&para, &opts);
+    ASSERT_TRUE(para.wrap_width == 0.0f);
+    ASSERT_EQ_INT(none.line_count, 5);  /* the hard line breaks */
+
+    /* NULL handling */
+    ForgeUiTextMetrics m0 = forge_ui_paragraph_measure(NULL, &opts);
+    ASSERT_EQ_INT(m0.line_count, 0);
+    forge_ui_paragraph_free(&para);
+    ASSERT_TRUE(para.items == NULL && para.lines == NULL);
+    ASSERT_TRUE(!forge_ui_paragraph_init(&test_atlas, NULL, &para));
+    ASSERT_TRUE(!forge_ui_paragraph_init(NULL, "x", &para));
+    forge_ui_paragraph_free(NULL);
+}
+
+static void test_paragraph_clip_skips_lines(void)
+{
+    TEST("paragraph: lines outside the clip rect are skipped, same output");
+    ASSERT_TRUE(atlas_built);
+
+    ForgeUiParagraph para;
+    ASSERT_TRUE(forge_ui_paragraph_init(&test_atlas, PARA_TEXT, &para));
+    ForgeUiTextOpts opts = { 120.0f, FORGE_UI_TEXT_ALIGN_LEFT,
+                             1.0f, 1.0f, 1.0f, 1.0f };
+
+    /* Bands cutting through lines, between lines, and missing them all */
+    const float bands[][2] = { { 60.0f, 140.0f }, { 0.0f, 25.0f },
+                               { 250.0f, 10000.0f }, { -500.0f, -100.0f } };
+    bool ok = true;
+    for (int b = 0; ok && b < (int)SDL_arraysize(bands); b++) {
+        ok = paragraph_matches_layout(&test_atlas, &para, PARA_TEXT, &opts,
+                                      true, bands[b][0], bands[b][1]);
+        if (!ok) SDL_Log("    FAIL: band %d", b);
+    }
+    forge_ui_paragraph_free(&para);
+    ASSERT_TRUE(ok);
+}
+
 /* ── Parameter validation tests (audit fixes) ───────────────────────────── */
 
 static void test_load_null_out_font(void)
@@ -1809,6 +3530,7 @@ static void test_raster_supersample_overflow_returns_false(void)
 
     Uint16 gi = forge_ui_ttf_glyph_index(&test_font, 'A');
     ForgeUiRasterOpts opts;
+    SDL_memset(&opts, 0, sizeof(opts));
     opts.supersample_level = 8;
 
     /* pixel_height = 5e8 produces bmp_w ~ 341 million.
@@ -1994,6 +3716,9 @@ int main(int argc, char *argv[])
     test_cmap_space();
     test_cmap_unmapped();
     test_cmap_beyond_bmp();
+    test_cmap_table_matches_segments();
+    test_cmap_format12();
+    test_cmap_format12_rejects_unsorted();
 
     /* Glyph loading */
     test_glyph_out_of_range();
@@ -2015,6 +3740,12 @@ int main(int argc, char *argv[])
     test_raster_no_aa();
     test_raster_bitmap_free_zeroed();
     test_raster_default_opts();
+    test_raster_active_edge_matches_scanline();
+    test_raster_invalid_method();
+    test_raster_analytic_rect();
+    test_raster_analytic_matches_supersampled();
+    test_raster_analytic_donut();
+    test_raster_analytic_edge_hugs_left();
 
     /* hmtx / advance width */
     test_hmtx_loaded();
@@ -2027,6 +3758,8 @@ int main(int argc, char *argv[])
     test_atlas_power_of_two();
     test_atlas_lookup_found();
     test_atlas_lookup_missing();
+    test_atlas_lookup_matches_linear();
+    test_atlas_lookup_supplementary();
     test_atlas_uv_range();
     test_atlas_uv_ordering();
     test_atlas_white_pixel();
@@ -2066,6 +3799,38 @@ int main(int argc, char *argv[])
     test_layout_invalid_atlas();
     test_measure_invalid_atlas();
 
+    /* Text layout — forge_ui_text_layout_into */
+    test_layout_into_matches_layout();
+    test_layout_into_clipped();
+    test_layout_into_vertices_only();
+    test_layout_into_invalid();
+
+    /* Vertex packing */
+    test_packed_vertex_layout();
+    test_pack_vertices_rounding();
+    test_pack_vertices_matches_scalar();
+    test_pack_vertices_round_trip();
+
+    /* Signed distance fields */
+    test_sdf_glyph_sign();
+    test_sdf_matches_coverage();
+    test_sdf_invalid_range();
+    test_sdf_atlas_retarget();
+    test_coverage_atlas_rejects_retarget();
+
+    /* Parallel atlas build */
+    test_atlas_parallel_identical();
+    test_atlas_parallel_sdf_identical();
+    test_atlas_parallel_clamps_threads();
+
+    /* Atlas packing */
+    test_atlas_skyline_disjoint();
+    test_atlas_skyline_denser();
+    test_atlas_npot_tight();
+    test_atlas_packing_efficiency();
+    test_atlas_default_square();
+    test_atlas_invalid_packer();
+
     /* Text layout — forge_ui_text_measure */
     test_measure_matches_layout();
     test_measure_empty_string();
@@ -2073,6 +3838,18 @@ int main(int argc, char *argv[])
     test_measure_multiline();
     test_measure_wrapping();
 
+    /* UTF-8 and kerning */
+    test_layout_utf8();
+    test_kern_table_format0();
+    test_kern_gpos_pair_pos();
+    test_layout_kerning();
+
+    /* Paragraphs */
+    test_paragraph_matches_layout();
+    test_paragraph_kerning();
+    test_paragraph_wrap_cache();
+    test_paragraph_clip_skips_lines();
+
     /* Parameter validation (audit fixes) */
     test_load_null_out_font();
     test_load_null_path();
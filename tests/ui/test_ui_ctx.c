@@ -18,6 +18,7 @@
 #include <math.h>
 #include "ui/forge_ui.h"
 #include "ui/forge_ui_ctx.h"
+#include "raster/forge_raster.h"
 
 /* ── Test Framework ──────────────────────────────────────────────────────── */
 
@@ -6333,6 +6334,1574 @@ static void test_label_colored_out_of_range_clamped(void)
     forge_ui_ctx_free(&ctx);
 }
 
+/* ── Text layout cache tests ─────────────────────────────────────────────── */
+
+#define TEXT_CACHE_X 37.0f
+#define TEXT_CACHE_Y 81.0f
+
+static void test_text_cache_hit_on_repeat(void)
+{
+    TEST("text cache: repeated label is laid out once");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    for (int frame = 0; frame < 3; frame++) {
+        forge_ui_ctx_begin(&ctx, 0, 0, false);
+        forge_ui_ctx_label(&ctx, "Cached", TEXT_CACHE_X, TEXT_CACHE_Y);
+        forge_ui_ctx_end(&ctx);
+    }
+    ASSERT_EQ_INT(ctx.text_cache.count, 1);
+    ASSERT_EQ_U32(ctx.text_cache.misses, 1);
+    ASSERT_EQ_U32(ctx.text_cache.hits, 2);
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_text_cache_matches_uncached_layout(void)
+{
+    TEST("text cache: cached label matches forge_ui_text_layout output");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+
+    ForgeUiTextOpts opts = { 0.0f, FORGE_UI_TEXT_ALIGN_LEFT,
+                             0.25f, 0.5f, 0.75f, 1.0f };
+    ForgeUiTextLayout ref;
+    ASSERT_TRUE(forge_ui_text_layout(&test_atlas, "Hello, cache!",
+                                     TEXT_CACHE_X, TEXT_CACHE_Y,
+                                     &opts, &ref));
+
+    /* First frame misses, second replays; both must match the reference */
+    for (int frame = 0; frame < 2; frame++) {
+        forge_ui_ctx_begin(&ctx, 0, 0, false);
+        forge_ui_ctx_label_colored(&ctx, "Hello, cache!",
+                                   TEXT_CACHE_X, TEXT_CACHE_Y,
+                                   0.25f, 0.5f, 0.75f, 1.0f);
+        ASSERT_EQ_INT(ctx.vertex_count, ref.vertex_count);
+        ASSERT_EQ_INT(ctx.index_count, ref.index_count);
+        for (int i = 0; i < ref.vertex_count; i++) {
+            ASSERT_NEAR(ctx.vertices[i].pos_x, ref.vertices[i].pos_x, 0.001f);
+            ASSERT_NEAR(ctx.vertices[i].pos_y, ref.vertices[i].pos_y, 0.001f);
+            ASSERT_NEAR(ctx.vertices[i].uv_u, ref.vertices[i].uv_u, 0.0001f);
+            ASSERT_NEAR(ctx.vertices[i].uv_v, ref.vertices[i].uv_v, 0.0001f);
+            ASSERT_NEAR(ctx.vertices[i].g, 0.5f, 0.0001f);
+        }
+        for (int i = 0; i < ref.index_count; i++) {
+            ASSERT_EQ_U32(ctx.indices[i], ref.indices[i]);
+        }
+        forge_ui_ctx_end(&ctx);
+    }
+
+    forge_ui_text_layout_free(&ref);
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_text_cache_color_not_keyed(void)
+{
+    TEST("text cache: one run serves different colors");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    forge_ui_ctx_begin(&ctx, 0, 0, false);
+    forge_ui_ctx_label_colored(&ctx, "AB", 0, 0, 1, 0, 0, 1);
+    forge_ui_ctx_label_colored(&ctx, "AB", 0, 40, 0, 1, 0, 1);
+    ASSERT_EQ_INT(ctx.text_cache.count, 1);
+    ASSERT_EQ_INT(ctx.vertex_count, 16);
+    ASSERT_NEAR(ctx.vertices[0].r, 1.0f, 0.0001f);
+    ASSERT_NEAR(ctx.vertices[8].r, 0.0f, 0.0001f);
+    ASSERT_NEAR(ctx.vertices[8].g, 1.0f, 0.0001f);
+    forge_ui_ctx_end(&ctx);
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_text_cache_evicts_stale_runs(void)
+{
+    TEST("text cache: runs unused for MAX_AGE frames are evicted");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    forge_ui_ctx_begin(&ctx, 0, 0, false);
+    forge_ui_ctx_label(&ctx, "old", 0, 0);
+    forge_ui_ctx_label(&ctx, "kept", 0, 40);
+    forge_ui_ctx_end(&ctx);
+    ASSERT_EQ_INT(ctx.text_cache.count, 2);
+
+    for (int frame = 0; frame <= FORGE_UI_TEXT_CACHE_MAX_AGE; frame++) {
+        forge_ui_ctx_begin(&ctx, 0, 0, false);
+        forge_ui_ctx_label(&ctx, "kept", 0, 40);
+        forge_ui_ctx_end(&ctx);
+    }
+    ASSERT_EQ_INT(ctx.text_cache.count, 1);
+
+    /* The survivor is still reachable after the rehash */
+    Uint32 misses = ctx.text_cache.misses;
+    forge_ui_ctx_begin(&ctx, 0, 0, false);
+    forge_ui_ctx_label(&ctx, "kept", 0, 40);
+    forge_ui_ctx_end(&ctx);
+    ASSERT_EQ_U32(ctx.text_cache.misses, misses);
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_text_cache_clipped_replay(void)
+{
+    TEST("text cache: clipped replay drops quads outside the clip rect");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    forge_ui_ctx_begin(&ctx, 0, 0, false);
+    forge_ui_ctx_label(&ctx, "ABCD", 0, 0);   /* warm the cache */
+    int unclipped = ctx.vertex_count;
+    ASSERT_EQ_INT(unclipped, 16);
+
+    /* Clip away everything right of the first glyph's advance */
+    ctx.vertex_count = 0;
+    ctx.index_count = 0;
+    ctx.has_clip = true;
+    ctx.clip_rect = (ForgeUiRect){ 0.0f, -100.0f, 1.0f, 400.0f };
+    forge_ui_ctx_label(&ctx, "ABCD", 0, 0);
+    ASSERT_TRUE(ctx.vertex_count < unclipped);
+    for (int i = 0; i < ctx.vertex_count; i++) {
+        ASSERT_TRUE(ctx.vertices[i].pos_x <= 1.0f + 0.001f);
+    }
+    ASSERT_EQ_U32(ctx.text_cache.hits, 1);
+    ctx.has_clip = false;
+    forge_ui_ctx_end(&ctx);
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_text_cache_clear(void)
+{
+    TEST("text cache: clear drops runs, free releases the table");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    forge_ui_ctx_begin(&ctx, 0, 0, false);
+    forge_ui_ctx_label(&ctx, "one", 0, 0);
+    forge_ui_ctx_label(&ctx, "two", 0, 40);
+    ASSERT_EQ_INT(ctx.text_cache.count, 2);
+    forge_ui_ctx_text_cache_clear(&ctx);
+    ASSERT_EQ_INT(ctx.text_cache.count, 0);
+    forge_ui_ctx_label(&ctx, "one", 0, 0);
+    ASSERT_EQ_INT(ctx.text_cache.count, 1);
+    ASSERT_EQ_U32(ctx.text_cache.misses, 3);
+    forge_ui_ctx_end(&ctx);
+    forge_ui_ctx_free(&ctx);
+    ASSERT_TRUE(ctx.text_cache.runs == NULL);
+    ASSERT_EQ_INT(ctx.text_cache.capacity, 0);
+    forge_ui_ctx_text_cache_clear(NULL);
+}
+
+static void test_text_cache_grows(void)
+{
+    TEST("text cache: table grows past the initial slot count");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    forge_ui_ctx_begin(&ctx, 0, 0, false);
+    char buf[16];
+    for (int i = 0; i < FORGE_UI_TEXT_CACHE_INITIAL_SLOTS; i++) {
+        SDL_snprintf(buf, sizeof(buf), "item %d", i);
+        forge_ui_ctx_label(&ctx, buf, 0, 0);
+    }
+    ASSERT_EQ_INT(ctx.text_cache.count, FORGE_UI_TEXT_CACHE_INITIAL_SLOTS);
+    ASSERT_TRUE(ctx.text_cache.capacity > FORGE_UI_TEXT_CACHE_INITIAL_SLOTS);
+    /* Every entry is still found after the rehashes */
+    Uint32 misses = ctx.text_cache.misses;
+    for (int i = 0; i < FORGE_UI_TEXT_CACHE_INITIAL_SLOTS; i++) {
+        SDL_snprintf(buf, sizeof(buf), "item %d", i);
+        forge_ui_ctx_label(&ctx, buf, 0, 0);
+    }
+    ASSERT_EQ_U32(ctx.text_cache.misses, misses);
+    forge_ui_ctx_end(&ctx);
+    forge_ui_ctx_free(&ctx);
+}
+
+/* ── Packed vertex format tests ──────────────────────────────────────────── */
+
+static void test_vertex_format_default_float(void)
+{
+    TEST("vertex_format: default is float, no packed output");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ASSERT_EQ_INT((int)ctx.vertex_format, (int)FORGE_UI_VERTEX_FORMAT_FLOAT);
+    forge_ui_ctx_begin(&ctx, 0, 0, false);
+    forge_ui_ctx_label(&ctx, "AB", 10, 30);
+    forge_ui_ctx_end(&ctx);
+    ASSERT_EQ_INT(ctx.packed_vertex_count, 0);
+    ASSERT_TRUE(ctx.packed_vertices == NULL);
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_vertex_format_packed_frame(void)
+{
+    TEST("vertex_format: packed context converts the frame at ctx_end");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_set_vertex_format(&ctx,
+                                               FORGE_UI_VERTEX_FORMAT_PACKED));
+    for (int frame = 0; frame < 2; frame++) {
+        forge_ui_ctx_begin(&ctx, 0, 0, false);
+        ForgeUiRect rect = { 10.0f, 10.0f, 120.0f, 30.0f };
+        forge_ui_ctx_button(&ctx, "Pack", rect);
+        forge_ui_ctx_label_colored(&ctx, "me", 10, 80, 0.2f, 0.4f, 0.6f, 1);
+        ASSERT_EQ_INT(ctx.packed_vertex_count, 0);  /* not yet */
+        forge_ui_ctx_end(&ctx);
+
+        ASSERT_EQ_INT(ctx.packed_vertex_count, ctx.vertex_count);
+        for (int i = 0; i < ctx.vertex_count; i++) {
+            const ForgeUiVertex *f = &ctx.vertices[i];
+            const ForgeUiPackedVertex *p = &ctx.packed_vertices[i];
+            ASSERT_TRUE(p->pos_x == f->pos_x && p->pos_y == f->pos_y);
+            ASSERT_NEAR((float)p->uv_u / 65535.0f, f->uv_u, 1.0f / 65535.0f);
+            ASSERT_NEAR((float)p->r / 255.0f, f->r, 1.0f / 255.0f);
+            ASSERT_NEAR((float)p->a / 255.0f, f->a, 1.0f / 255.0f);
+        }
+    }
+
+    /* Back to float: no packed output on the next frame */
+    ASSERT_TRUE(forge_ui_ctx_set_vertex_format(&ctx,
+                                               FORGE_UI_VERTEX_FORMAT_FLOAT));
+    forge_ui_ctx_begin(&ctx, 0, 0, false);
+    forge_ui_ctx_label(&ctx, "AB", 10, 30);
+    forge_ui_ctx_end(&ctx);
+    ASSERT_EQ_INT(ctx.packed_vertex_count, 0);
+
+    forge_ui_ctx_free(&ctx);
+    ASSERT_TRUE(ctx.packed_vertices == NULL);
+    ASSERT_EQ_INT(ctx.packed_vertex_capacity, 0);
+}
+
+static void test_vertex_format_invalid_rejected(void)
+{
+    TEST("vertex_format: unknown format and NULL ctx rejected");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ASSERT_TRUE(!forge_ui_ctx_set_vertex_format(&ctx, (ForgeUiVertexFormat)7));
+    ASSERT_EQ_INT((int)ctx.vertex_format, (int)FORGE_UI_VERTEX_FORMAT_FLOAT);
+    ASSERT_TRUE(!forge_ui_ctx_set_vertex_format(NULL,
+                                                FORGE_UI_VERTEX_FORMAT_PACKED));
+    forge_ui_ctx_free(&ctx);
+}
+
+/* ── Draw command tests ─────────────────────────────────────────────────── */
+
+#define TEST_CMD_FB_W   320
+#define TEST_CMD_FB_H   240
+
+/* A panel whose content overflows in both directions after scrolling, so
+ * the top and bottom widgets straddle the clip rect, plus widgets before
+ * and after the panel. */
+static void test_cmd_frame(ForgeUiContext *ctx, float *scroll_y)
+{
+    forge_ui_ctx_begin(ctx, 0, 0, false);
+    forge_ui_ctx_label(ctx, "Before", 8, 24);
+    ForgeUiRect panel = { 40.0f, 30.0f, 220.0f, 170.0f };
+    if (forge_ui_ctx_panel_begin(ctx, "Cmds", panel, scroll_y)) {
+        for (int i = 0; i < 8; i++) {
+            char text[32];
+            SDL_snprintf(text, sizeof(text), "Row %d clipped text", i);
+            forge_ui_ctx_label_layout(ctx, text, 30.0f);
+            SDL_snprintf(text, sizeof(text), "Btn %d##cmd", i);
+            forge_ui_ctx_button_layout(ctx, text, 30.0f);
+        }
+        forge_ui_ctx_panel_end(ctx);
+    }
+    forge_ui_ctx_label(ctx, "After", 8, 230);
+    forge_ui_ctx_end(ctx);
+}
+
+/* Draw each command with its clip rect as the scissor, the way a GPU
+ * renderer would. */
+static void test_cmd_render(ForgeRasterBuffer *fb, const ForgeUiContext *ctx,
+                            const ForgeRasterTexture *tex)
+{
+    for (int c = 0; c < ctx->draw_cmd_count; c++) {
+        const ForgeUiDrawCmd *cmd = &ctx->draw_cmds[c];
+        int x = 0, y = 0, w = fb->width, h = fb->height;
+        if (cmd->has_clip) {
+            x = (int)SDL_floorf(cmd->clip_rect.x);
+            y = (int)SDL_floorf(cmd->clip_rect.y);
+            w = (int)SDL_ceilf(cmd->clip_rect.x + cmd->clip_rect.w) - x;
+            h = (int)SDL_ceilf(cmd->clip_rect.y + cmd->clip_rect.h) - y;
+        }
+        forge_raster_triangles_indexed_scissor(
+            fb, (const ForgeRasterVertex *)ctx->vertices, ctx->vertex_count,
+            ctx->indices + cmd->index_offset, cmd->index_count, tex,
+            x, y, w, h);
+    }
+}
+
+/* Commands must tile the index buffer exactly, in order */
+static bool test_cmds_cover_indices(const ForgeUiContext *ctx)
+{
+    int next = 0;
+    for (int c = 0; c < ctx->draw_cmd_count; c++) {
+        const ForgeUiDrawCmd *cmd = &ctx->draw_cmds[c];
+        if (cmd->index_offset != next) return false;
+        if (cmd->index_count <= 0 || cmd->index_count % 3 != 0) return false;
+        next += cmd->index_count;
+    }
+    return next == ctx->index_count;
+}
+
+static void test_draw_cmds_disabled_by_default(void)
+{
+    TEST("draw_cmds: off by default, CPU clipping as before");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ASSERT_TRUE(!ctx.draw_cmds_enabled);
+    float scroll = 17.0f;
+    test_cmd_frame(&ctx, &scroll);
+    ASSERT_TRUE(ctx.index_count > 0);
+    ASSERT_EQ_INT(ctx.draw_cmd_count, 0);
+    ASSERT_TRUE(ctx.draw_cmds == NULL);
+    ASSERT_TRUE(!forge_ui_ctx_set_draw_commands(NULL, true));
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_draw_cmds_panel_structure(void)
+{
+    TEST("draw_cmds: panel content gets its own scissored command");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_set_draw_commands(&ctx, true));
+
+    for (int frame = 0; frame < 2; frame++) {
+        float scroll = 17.0f;
+        test_cmd_frame(&ctx, &scroll);
+        ASSERT_TRUE(test_cmds_cover_indices(&ctx));
+
+        /* unclipped (label, panel chrome), clipped content, unclipped
+         * (scrollbar, trailing label) */
+        ASSERT_EQ_INT(ctx.draw_cmd_count, 3);
+        ASSERT_TRUE(!ctx.draw_cmds[0].has_clip);
+        ASSERT_TRUE(ctx.draw_cmds[1].has_clip);
+        ASSERT_TRUE(!ctx.draw_cmds[2].has_clip);
+        ASSERT_NEAR(ctx.draw_cmds[1].clip_rect.x, ctx._panel.content_rect.x, 0.0f);
+        ASSERT_NEAR(ctx.draw_cmds[1].clip_rect.y, ctx._panel.content_rect.y, 0.0f);
+        ASSERT_NEAR(ctx.draw_cmds[1].clip_rect.w, ctx._panel.content_rect.w, 0.0f);
+        ASSERT_NEAR(ctx.draw_cmds[1].clip_rect.h, ctx._panel.content_rect.h, 0.0f);
+    }
+    forge_ui_ctx_free(&ctx);
+    ASSERT_TRUE(ctx.draw_cmds == NULL);
+    ASSERT_EQ_INT(ctx.draw_cmd_capacity, 0);
+}
+
+static void test_draw_cmds_skip_cpu_clipping(void)
+{
+    TEST("draw_cmds: straddling text is emitted whole, not trimmed");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_set_draw_commands(&ctx, true));
+
+    /* A label crossing the clip's left edge keeps all its glyph quads
+     * at their unclipped positions */
+    forge_ui_ctx_begin(&ctx, 0, 0, false);
+    ctx.clip_rect = (ForgeUiRect){ 50.0f, 0.0f, 100.0f, 100.0f };
+    ctx.has_clip = true;
+    forge_ui_ctx_label(&ctx, "ABCDEFGH", 20.0f, 40.0f);
+    ctx.has_clip = false;
+    int clipped_vertices = ctx.vertex_count;
+    float first_x = ctx.vertices[0].pos_x;
+    forge_ui_ctx_label(&ctx, "ABCDEFGH", 20.0f, 40.0f);
+    forge_ui_ctx_end(&ctx);
+
+    ASSERT_EQ_INT(clipped_vertices * 2, ctx.vertex_count);
+    ASSERT_NEAR(first_x, ctx.vertices[clipped_vertices].pos_x, 0.0f);
+    ASSERT_TRUE(first_x < 50.0f);
+    ASSERT_EQ_INT(ctx.draw_cmd_count, 2);
+    ASSERT_TRUE(test_cmds_cover_indices(&ctx));
+
+    /* Rects entirely outside the clip are still dropped */
+    forge_ui_ctx_begin(&ctx, 0, 0, false);
+    ctx.clip_rect = (ForgeUiRect){ 50.0f, 50.0f, 10.0f, 10.0f };
+    ctx.has_clip = true;
+    forge_ui__emit_rect(&ctx, (ForgeUiRect){ 0, 0, 20, 20 }, 1, 1, 1, 1);
+    ASSERT_EQ_INT(ctx.vertex_count, 0);
+    forge_ui__emit_rect(&ctx, (ForgeUiRect){ 40, 40, 40, 40 }, 1, 1, 1, 1);
+    ASSERT_EQ_INT(ctx.vertex_count, 4);
+    ASSERT_NEAR(ctx.vertices[0].pos_x, 40.0f, 0.0f);
+    ctx.has_clip = false;
+    forge_ui_ctx_end(&ctx);
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_draw_cmds_texture_split(void)
+{
+    TEST("draw_cmds: texture change starts a command, empty ones vanish");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_set_draw_commands(&ctx, true));
+
+    forge_ui_ctx_begin(&ctx, 0, 0, false);
+    forge_ui_ctx_label(&ctx, "one", 10, 30);
+    forge_ui_ctx_set_texture(&ctx, 7);
+    forge_ui__emit_rect(&ctx, (ForgeUiRect){ 0, 0, 8, 8 }, 1, 1, 1, 1);
+    forge_ui_ctx_set_texture(&ctx, 0);
+    forge_ui_ctx_label(&ctx, "two", 10, 60);
+    /* A clip that nothing is drawn under leaves no command behind */
+    ctx.clip_rect = (ForgeUiRect){ 0, 0, 4, 4 };
+    ctx.has_clip = true;
+    forge_ui_ctx_label(&ctx, "", 10, 90);
+    ctx.has_clip = false;
+    forge_ui_ctx_end(&ctx);
+
+    ASSERT_TRUE(test_cmds_cover_indices(&ctx));
+    ASSERT_EQ_INT(ctx.draw_cmd_count, 3);
+    ASSERT_EQ_U32(ctx.draw_cmds[0].texture_id, 0);
+    ASSERT_EQ_U32(ctx.draw_cmds[1].texture_id, 7);
+    ASSERT_EQ_INT(ctx.draw_cmds[1].index_count, 6);
+    ASSERT_EQ_U32(ctx.draw_cmds[2].texture_id, 0);
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_draw_cmds_scissor_matches_cpu_clip(void)
+{
+    TEST("draw_cmds: scissored render matches CPU-clipped render");
+    if (!setup_atlas()) return;
+    ForgeUiContext cpu, cmd;
+    ASSERT_TRUE(forge_ui_ctx_init(&cpu, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_init(&cmd, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_set_draw_commands(&cmd, true));
+
+    float scroll_cpu = 17.0f, scroll_cmd = 17.0f;
+    test_cmd_frame(&cpu, &scroll_cpu);
+    test_cmd_frame(&cmd, &scroll_cmd);
+    /* The CPU path trims quads, the command path keeps them whole */
+    ASSERT_TRUE(cmd.vertex_count > cpu.vertex_count);
+
+    ForgeRasterTexture tex = { test_atlas.pixels, test_atlas.width,
+                               test_atlas.height, 0.0f };
+    ForgeRasterBuffer a = forge_raster_buffer_create(TEST_CMD_FB_W, TEST_CMD_FB_H);
+    ForgeRasterBuffer b = forge_raster_buffer_create(TEST_CMD_FB_W, TEST_CMD_FB_H);
+    ASSERT_TRUE(a.pixels != NULL && b.pixels != NULL);
+    forge_raster_clear(&a, 0.0f, 0.0f, 0.0f, 1.0f);
+    forge_raster_clear(&b, 0.0f, 0.0f, 0.0f, 1.0f);
+    forge_raster_triangles_indexed(&a, (const ForgeRasterVertex *)cpu.vertices,
+                                   cpu.vertex_count, cpu.indices,
+                                   cpu.index_count, &tex);
+    test_cmd_render(&b, &cmd, &tex);
+
+    /* Trimmed glyphs remap their UVs, so nearest sampling may land on a
+     * neighboring texel at rounding ties; allow a handful of pixels. */
+    int differing = 0, covered = 0;
+    for (int i = 0; i < TEST_CMD_FB_W * TEST_CMD_FB_H; i++) {
+        const Uint8 *pa = a.pixels + (size_t)i * FORGE_RASTER_BPP;
+        const Uint8 *pb = b.pixels + (size_t)i * FORGE_RASTER_BPP;
+        if (pa[0] || pa[1] || pa[2]) covered++;
+        for (int k = 0; k < 3; k++) {
+            int d = (int)pa[k] - (int)pb[k];
+            if (d < -1 || d > 1) { differing++; break; }
+        }
+    }
+    SDL_Log("    %d of %d covered pixels differ", differing, covered);
+    ASSERT_TRUE(covered > 1000);
+    ASSERT_TRUE(differing * 200 <= covered);
+
+    forge_raster_buffer_destroy(&a);
+    forge_raster_buffer_destroy(&b);
+    forge_ui_ctx_free(&cpu);
+    forge_ui_ctx_free(&cmd);
+}
+
+static void test_rebase_indices_matches_scalar(void)
+{
+    TEST("rebase_indices: SIMD body and scalar tail match a plain loop");
+    Uint32 src[37], dst[40];
+    for (int i = 0; i < 37; i++) src[i] = (Uint32)(i * 7919u);
+    for (int count = 0; count <= 37; count++) {
+        Uint32 base = 0xFFFFFF00u + (Uint32)count;  /* wraps like Uint32 */
+        for (int i = 0; i < 40; i++) dst[i] = 0xDEADBEEFu;
+        forge_ui__rebase_indices(dst, src, count, base);
+        for (int i = 0; i < count; i++) {
+            ASSERT_EQ_U32(dst[i], src[i] + base);
+        }
+        for (int i = count; i < 40; i++) {
+            ASSERT_EQ_U32(dst[i], 0xDEADBEEFu);  /* nothing past count */
+        }
+    }
+}
+
+/* ── Cached region tests ────────────────────────────────────────────────── */
+
+/* One frame: a label and a button, then a panel of buttons, labels, and a
+ * slider, then another label.  With cached set the panel goes through
+ * panel_begin_cached; returns whether the panel's widgets were declared. */
+static bool test_region_frame(ForgeUiContext *ctx, ForgeUiRect panel,
+                              float *scroll_y, Uint32 version,
+                              float mx, float my, bool mouse_down,
+                              bool cached)
+{
+    bool declared = false;
+    forge_ui_ctx_begin(ctx, mx, my, mouse_down);
+    forge_ui_ctx_label(ctx, "Before", 8, 24);
+    forge_ui_ctx_button(ctx, "Outside", (ForgeUiRect){ 300.0f, 4.0f, 80.0f, 30.0f });
+    bool open = cached
+        ? forge_ui_ctx_panel_begin_cached(ctx, "Region", panel, scroll_y,
+                                          version)
+        : forge_ui_ctx_panel_begin(ctx, "Region", panel, scroll_y);
+    if (open) {
+        static float value = 40.0f;
+        char text[32];
+        for (int i = 0; i < 4; i++) {
+            SDL_snprintf(text, sizeof(text), "Btn %d##region", i);
+            forge_ui_ctx_button_layout(ctx, text, 30.0f);
+            SDL_snprintf(text, sizeof(text), "Row %u.%d", (unsigned)version, i);
+            forge_ui_ctx_label_layout(ctx, text, 26.0f);
+        }
+        forge_ui_ctx_slider_layout(ctx, "##region_slider", &value,
+                                   0.0f, 100.0f, 30.0f);
+        forge_ui_ctx_panel_end(ctx);
+        declared = true;
+    }
+    forge_ui_ctx_label(ctx, "After", 8, 300);
+    forge_ui_ctx_end(ctx);
+    return declared;
+}
+
+/* Vertex-for-vertex comparison of two frames' draw data */
+static bool test_region_same_draw(const ForgeUiContext *a,
+                                  const ForgeUiContext *b, float tolerance)
+{
+    if (a->vertex_count != b->vertex_count) return false;
+    if (a->index_count != b->index_count) return false;
+    for (int i = 0; i < a->index_count; i++) {
+        if (a->indices[i] != b->indices[i]) return false;
+    }
+    for (int i = 0; i < a->vertex_count; i++) {
+        const ForgeUiVertex *va = &a->vertices[i];
+        const ForgeUiVertex *vb = &b->vertices[i];
+        if (SDL_fabsf(va->pos_x - vb->pos_x) > tolerance ||
+            SDL_fabsf(va->pos_y - vb->pos_y) > tolerance ||
+            va->uv_u != vb->uv_u || va->uv_v != vb->uv_v ||
+            va->r != vb->r || va->g != vb->g ||
+            va->b != vb->b || va->a != vb->a) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_region_replay_matches_declared(void)
+{
+    TEST("region cache: unchanged panel is replayed, same draw data");
+    if (!setup_atlas()) return;
+    ForgeUiContext cached, plain;
+    ASSERT_TRUE(forge_ui_ctx_init(&cached, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_init(&plain, &test_atlas));
+    ForgeUiRect panel = { 40.0f, 40.0f, 240.0f, 200.0f };
+    float scroll_a = 12.0f, scroll_b = 12.0f;
+
+    /* Frame 1 records, frame 2 replays */
+    ASSERT_TRUE(test_region_frame(&cached, panel, &scroll_a, 1,
+                                  400, 400, false, true));
+    ASSERT_EQ_INT(cached.region_cache.count, 1);
+    ASSERT_EQ_U32(cached.region_cache.hits, 0);
+    ASSERT_TRUE(!test_region_frame(&cached, panel, &scroll_a, 1,
+                                   400, 400, false, true));
+    ASSERT_EQ_U32(cached.region_cache.hits, 1);
+
+    test_region_frame(&plain, panel, &scroll_b, 1, 400, 400, false, false);
+    test_region_frame(&plain, panel, &scroll_b, 1, 400, 400, false, false);
+    ASSERT_TRUE(test_region_same_draw(&cached, &plain, 0.0f));
+
+    /* The panel state panel_end leaves behind is restored too */
+    ASSERT_EQ_U32(cached._panel.id, plain._panel.id);
+    ASSERT_NEAR(cached._panel.content_height, plain._panel.content_height, 0.0f);
+    ASSERT_NEAR(scroll_a, scroll_b, 0.0f);
+
+    forge_ui_ctx_free(&cached);
+    forge_ui_ctx_free(&plain);
+    ASSERT_TRUE(cached.region_cache.regions == NULL);
+}
+
+static void test_region_replay_translates_moved_panel(void)
+{
+    TEST("region cache: moved panel is replayed translated");
+    if (!setup_atlas()) return;
+    ForgeUiContext cached, plain;
+    ASSERT_TRUE(forge_ui_ctx_init(&cached, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_init(&plain, &test_atlas));
+    ForgeUiRect panel = { 40.0f, 40.0f, 240.0f, 200.0f };
+    ForgeUiRect moved = { 93.5f, 21.25f, 240.0f, 200.0f };
+    float scroll_a = 0.0f, scroll_b = 0.0f;
+
+    test_region_frame(&cached, panel, &scroll_a, 7, 600, 600, false, true);
+    ASSERT_TRUE(!test_region_frame(&cached, moved, &scroll_a, 7,
+                                   600, 600, false, true));
+    test_region_frame(&plain, moved, &scroll_b, 7, 600, 600, false, false);
+    ASSERT_TRUE(test_region_same_draw(&cached, &plain, 1e-3f));
+    ASSERT_NEAR(cached._panel.content_rect.x, plain._panel.content_rect.x, 1e-4f);
+    ASSERT_NEAR(cached._panel.content_rect.y, plain._panel.content_rect.y, 1e-4f);
+
+    forge_ui_ctx_free(&cached);
+    forge_ui_ctx_free(&plain);
+}
+
+static void test_region_key_changes_redeclare(void)
+{
+    TEST("region cache: version, size, and scroll changes re-declare");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ForgeUiRect panel = { 40.0f, 40.0f, 240.0f, 200.0f };
+    float scroll = 0.0f;
+
+    ASSERT_TRUE(test_region_frame(&ctx, panel, &scroll, 1, 600, 600, false, true));
+    ASSERT_TRUE(!test_region_frame(&ctx, panel, &scroll, 1, 600, 600, false, true));
+    ASSERT_TRUE(test_region_frame(&ctx, panel, &scroll, 2, 600, 600, false, true));
+    ASSERT_TRUE(!test_region_frame(&ctx, panel, &scroll, 2, 600, 600, false, true));
+
+    panel.h = 180.0f;
+    ASSERT_TRUE(test_region_frame(&ctx, panel, &scroll, 2, 600, 600, false, true));
+    ASSERT_TRUE(!test_region_frame(&ctx, panel, &scroll, 2, 600, 600, false, true));
+
+    scroll = 20.0f;
+    ASSERT_TRUE(test_region_frame(&ctx, panel, &scroll, 2, 600, 600, false, true));
+    ASSERT_TRUE(!test_region_frame(&ctx, panel, &scroll, 2, 600, 600, false, true));
+
+    /* A theme change alters every color, so it is part of the key */
+    ctx.theme.bg.r = 0.5f;
+    ASSERT_TRUE(test_region_frame(&ctx, panel, &scroll, 2, 600, 600, false, true));
+    ASSERT_TRUE(!test_region_frame(&ctx, panel, &scroll, 2, 600, 600, false, true));
+    ASSERT_EQ_INT(ctx.region_cache.count, 1);
+
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_region_input_prevents_replay(void)
+{
+    TEST("region cache: hover, hot, and drags inside the panel re-declare");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ForgeUiRect panel = { 40.0f, 40.0f, 240.0f, 200.0f };
+    float scroll = 0.0f;
+
+    ASSERT_TRUE(test_region_frame(&ctx, panel, &scroll, 1, 600, 600, false, true));
+    float bx = ctx._panel.content_rect.x + 5.0f;
+    float by = ctx._panel.content_rect.y + 5.0f;
+
+    /* Cursor over the first button: declared, and the button turns hot */
+    ASSERT_TRUE(test_region_frame(&ctx, panel, &scroll, 1, bx, by, false, true));
+    ASSERT_TRUE(ctx.hot != FORGE_UI_ID_NONE);
+
+    /* Cursor gone, but this frame still draws the button hot */
+    ASSERT_TRUE(test_region_frame(&ctx, panel, &scroll, 1, 600, 600, false, true));
+    ASSERT_EQ_U32(ctx.hot, FORGE_UI_ID_NONE);
+    ASSERT_TRUE(!test_region_frame(&ctx, panel, &scroll, 1, 600, 600, false, true));
+
+    /* Press inside, drag out: the active widget keeps the panel live */
+    ASSERT_TRUE(test_region_frame(&ctx, panel, &scroll, 1, bx, by, false, true));
+    ASSERT_TRUE(test_region_frame(&ctx, panel, &scroll, 1, bx, by, true, true));
+    ASSERT_TRUE(ctx.active != FORGE_UI_ID_NONE);
+    ASSERT_TRUE(test_region_frame(&ctx, panel, &scroll, 1, 600, 600, true, true));
+    ASSERT_TRUE(test_region_frame(&ctx, panel, &scroll, 1, 600, 600, false, true));
+    ASSERT_TRUE(!test_region_frame(&ctx, panel, &scroll, 1, 600, 600, false, true));
+
+    /* A press on a button outside the panel does not; the frames where
+     * the cursor is over it replay the panel as usual */
+    ASSERT_TRUE(!test_region_frame(&ctx, panel, &scroll, 1, 310, 15, false, true));
+    ASSERT_TRUE(!test_region_frame(&ctx, panel, &scroll, 1, 310, 15, true, true));
+    ASSERT_TRUE(ctx.active != FORGE_UI_ID_NONE);
+    ASSERT_TRUE(!test_region_frame(&ctx, panel, &scroll, 1, 600, 600, true, true));
+
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_region_draw_cmds_replayed(void)
+{
+    TEST("region cache: replay rebuilds the same draw commands");
+    if (!setup_atlas()) return;
+    ForgeUiContext cached, plain;
+    ASSERT_TRUE(forge_ui_ctx_init(&cached, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_init(&plain, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_set_draw_commands(&cached, true));
+    ASSERT_TRUE(forge_ui_ctx_set_draw_commands(&plain, true));
+    ForgeUiRect panel = { 40.0f, 40.0f, 240.0f, 200.0f };
+    ForgeUiRect moved = { 50.0f, 60.0f, 240.0f, 200.0f };
+    float scroll_a = 25.0f, scroll_b = 25.0f;
+
+    test_region_frame(&cached, panel, &scroll_a, 3, 600, 600, false, true);
+    ASSERT_TRUE(!test_region_frame(&cached, moved, &scroll_a, 3,
+                                   600, 600, false, true));
+    test_region_frame(&plain, moved, &scroll_b, 3, 600, 600, false, false);
+
+    ASSERT_TRUE(test_region_same_draw(&cached, &plain, 1e-3f));
+    ASSERT_TRUE(test_cmds_cover_indices(&cached));
+    ASSERT_EQ_INT(cached.draw_cmd_count, plain.draw_cmd_count);
+    for (int c = 0; c < cached.draw_cmd_count && c < plain.draw_cmd_count; c++) {
+        const ForgeUiDrawCmd *a = &cached.draw_cmds[c];
+        const ForgeUiDrawCmd *b = &plain.draw_cmds[c];
+        ASSERT_EQ_INT(a->index_offset, b->index_offset);
+        ASSERT_EQ_INT(a->index_count, b->index_count);
+        ASSERT_TRUE(a->has_clip == b->has_clip);
+        ASSERT_NEAR(a->clip_rect.x, b->clip_rect.x, 1e-4f);
+        ASSERT_NEAR(a->clip_rect.y, b->clip_rect.y, 1e-4f);
+        ASSERT_NEAR(a->clip_rect.w, b->clip_rect.w, 0.0f);
+        ASSERT_NEAR(a->clip_rect.h, b->clip_rect.h, 0.0f);
+    }
+
+    forge_ui_ctx_free(&cached);
+    forge_ui_ctx_free(&plain);
+}
+
+static void test_region_clear_and_evict(void)
+{
+    TEST("region cache: clear and age-out drop recorded regions");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ForgeUiRect panel = { 40.0f, 40.0f, 240.0f, 200.0f };
+    float scroll = 0.0f;
+
+    test_region_frame(&ctx, panel, &scroll, 1, 600, 600, false, true);
+    forge_ui_ctx_region_cache_clear(&ctx);
+    ASSERT_EQ_INT(ctx.region_cache.count, 0);
+    ASSERT_TRUE(test_region_frame(&ctx, panel, &scroll, 1, 600, 600, false, true));
+    ASSERT_EQ_INT(ctx.region_cache.count, 1);
+
+    for (int f = 0; f <= FORGE_UI_REGION_CACHE_MAX_AGE; f++) {
+        forge_ui_ctx_begin(&ctx, 600, 600, false);
+        forge_ui_ctx_end(&ctx);
+    }
+    ASSERT_EQ_INT(ctx.region_cache.count, 0);
+    ASSERT_TRUE(test_region_frame(&ctx, panel, &scroll, 1, 600, 600, false, true));
+
+    /* NULL-safe */
+    forge_ui_ctx_region_cache_clear(NULL);
+    ASSERT_TRUE(!forge_ui_ctx_panel_begin_cached(NULL, "x", panel, &scroll, 1));
+    forge_ui_ctx_free(&ctx);
+}
+
+/* ── Damage tracking tests ──────────────────────────────────────────────── */
+
+#define TEST_DAMAGE_W  320
+#define TEST_DAMAGE_H  240
+
+/* A label, a slider near the top, and a checkbox near the bottom, far
+ * enough apart that their tiles never touch. */
+static void test_damage_frame(ForgeUiContext *ctx, float value, bool checked)
+{
+    forge_ui_ctx_begin(ctx, 600, 600, false);
+    forge_ui_ctx_label(ctx, "Damage", 8, 24);
+    forge_ui_ctx_slider(ctx, "##damage_slider", &value, 0.0f, 100.0f,
+                        (ForgeUiRect){ 20.0f, 40.0f, 200.0f, 24.0f });
+    forge_ui_ctx_checkbox(ctx, "Option", &checked,
+                          (ForgeUiRect){ 20.0f, 180.0f, 120.0f, 24.0f });
+    forge_ui_ctx_end(ctx);
+}
+
+/* True if (x, y) lies in one of ctx's damage rects */
+static bool test_damage_contains(const ForgeUiContext *ctx, int x, int y)
+{
+    for (int i = 0; i < ctx->damage_rect_count; i++) {
+        const ForgeUiRect *r = &ctx->damage_rects[i];
+        if ((float)x >= r->x && (float)x < r->x + r->w &&
+            (float)y >= r->y && (float)y < r->y + r->h) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Rects are tile-aligned, inside the screen, and pairwise disjoint */
+static bool test_damage_rects_valid(const ForgeUiContext *ctx)
+{
+    for (int i = 0; i < ctx->damage_rect_count; i++) {
+        const ForgeUiRect *a = &ctx->damage_rects[i];
+        if (a->w <= 0.0f || a->h <= 0.0f) return false;
+        if (a->x < 0.0f || a->y < 0.0f) return false;
+        if (a->x + a->w > (float)ctx->damage_width) return false;
+        if (a->y + a->h > (float)ctx->damage_height) return false;
+        if ((int)a->x % FORGE_UI_DAMAGE_TILE_SIZE != 0) return false;
+        if ((int)a->y % FORGE_UI_DAMAGE_TILE_SIZE != 0) return false;
+        for (int j = i + 1; j < ctx->damage_rect_count; j++) {
+            const ForgeUiRect *b = &ctx->damage_rects[j];
+            if (a->x < b->x + b->w && b->x < a->x + a->w &&
+                a->y < b->y + b->h && b->y < a->y + a->h) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void test_damage_raster(ForgeRasterBuffer *fb, const ForgeUiContext *ctx,
+                               const ForgeRasterTexture *tex, bool partial)
+{
+    if (!partial) {
+        forge_raster_clear(fb, 0.0f, 0.0f, 0.0f, 1.0f);
+        forge_raster_triangles_indexed(fb, (const ForgeRasterVertex *)ctx->vertices,
+                                       ctx->vertex_count, ctx->indices,
+                                       ctx->index_count, tex);
+        return;
+    }
+    ForgeRasterRect rects[FORGE_UI_DAMAGE_MAX_RECTS];
+    for (int i = 0; i < ctx->damage_rect_count; i++) {
+        const ForgeUiRect *r = &ctx->damage_rects[i];
+        rects[i] = (ForgeRasterRect){ (int)r->x, (int)r->y, (int)r->w, (int)r->h };
+        forge_raster_clear_rect(fb, rects[i].x, rects[i].y, rects[i].w,
+                                rects[i].h, 0.0f, 0.0f, 0.0f, 1.0f);
+    }
+    forge_raster_triangles_indexed_rects(fb, (const ForgeRasterVertex *)ctx->vertices,
+                                         ctx->vertex_count, ctx->indices,
+                                         ctx->index_count, tex,
+                                         rects, ctx->damage_rect_count);
+}
+
+static void test_damage_off_by_default(void)
+{
+    TEST("damage: off by default, no rects");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ASSERT_TRUE(!ctx.damage_enabled);
+    test_damage_frame(&ctx, 30.0f, false);
+    ASSERT_EQ_INT(ctx.damage_rect_count, 0);
+    ASSERT_TRUE(ctx.damage_rects == NULL);
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_damage_first_frame_full(void)
+{
+    TEST("damage: first frame and reset damage the whole screen");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_set_damage_tracking(&ctx, TEST_DAMAGE_W, TEST_DAMAGE_H));
+
+    test_damage_frame(&ctx, 30.0f, false);
+    ASSERT_EQ_INT(ctx.damage_rect_count, 1);
+    ASSERT_NEAR(ctx.damage_rects[0].x, 0.0f, 0.0f);
+    ASSERT_NEAR(ctx.damage_rects[0].y, 0.0f, 0.0f);
+    ASSERT_NEAR(ctx.damage_rects[0].w, (float)TEST_DAMAGE_W, 0.0f);
+    ASSERT_NEAR(ctx.damage_rects[0].h, (float)TEST_DAMAGE_H, 0.0f);
+
+    /* Same frame again: nothing to redraw */
+    test_damage_frame(&ctx, 30.0f, false);
+    ASSERT_EQ_INT(ctx.damage_rect_count, 0);
+
+    forge_ui_ctx_damage_reset(&ctx);
+    test_damage_frame(&ctx, 30.0f, false);
+    ASSERT_EQ_INT(ctx.damage_rect_count, 1);
+    ASSERT_NEAR(ctx.damage_rects[0].w, (float)TEST_DAMAGE_W, 0.0f);
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_damage_slider_change_is_local(void)
+{
+    TEST("damage: moving a slider damages only the slider's tiles");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_set_damage_tracking(&ctx, TEST_DAMAGE_W, TEST_DAMAGE_H));
+    test_damage_frame(&ctx, 30.0f, false);
+    test_damage_frame(&ctx, 70.0f, false);
+
+    ASSERT_TRUE(ctx.damage_rect_count > 0);
+    ASSERT_TRUE(test_damage_rects_valid(&ctx));
+    /* Old and new thumb positions are damaged */
+    ASSERT_TRUE(test_damage_contains(&ctx, 20 + (int)(0.3f * 200.0f), 52));
+    ASSERT_TRUE(test_damage_contains(&ctx, 20 + (int)(0.7f * 200.0f), 52));
+    /* The checkbox row and the far right of the screen are not */
+    ASSERT_TRUE(!test_damage_contains(&ctx, 30, 190));
+    ASSERT_TRUE(!test_damage_contains(&ctx, 300, 52));
+    float area = 0.0f;
+    for (int i = 0; i < ctx.damage_rect_count; i++) {
+        area += ctx.damage_rects[i].w * ctx.damage_rects[i].h;
+    }
+    ASSERT_TRUE(area <= 0.25f * (float)(TEST_DAMAGE_W * TEST_DAMAGE_H));
+
+    /* Two separate changes give disjoint rects */
+    test_damage_frame(&ctx, 30.0f, true);
+    ASSERT_TRUE(ctx.damage_rect_count >= 2);
+    ASSERT_TRUE(test_damage_rects_valid(&ctx));
+    ASSERT_TRUE(test_damage_contains(&ctx, 30, 190));
+    ASSERT_TRUE(test_damage_contains(&ctx, 20 + (int)(0.3f * 200.0f), 52));
+    ASSERT_TRUE(!test_damage_contains(&ctx, 200, 120));
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_damage_partial_redraw_matches_full(void)
+{
+    TEST("damage: partial redraw is pixel-identical to a full redraw");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_set_damage_tracking(&ctx, TEST_DAMAGE_W, TEST_DAMAGE_H));
+    ForgeRasterTexture tex = { test_atlas.pixels, test_atlas.width,
+                               test_atlas.height, 0.0f };
+    ForgeRasterBuffer inc = forge_raster_buffer_create(TEST_DAMAGE_W, TEST_DAMAGE_H);
+    ForgeRasterBuffer full = forge_raster_buffer_create(TEST_DAMAGE_W, TEST_DAMAGE_H);
+    ASSERT_TRUE(inc.pixels != NULL && full.pixels != NULL);
+
+    /* Frame 1 is full-screen damage, later frames redraw only the rects */
+    static const float values[] = { 10.0f, 10.0f, 55.0f, 56.0f, 90.0f };
+    static const bool checks[] = { false, true, true, false, false };
+    for (int f = 0; f < 5; f++) {
+        test_damage_frame(&ctx, values[f], checks[f]);
+        test_damage_raster(&inc, &ctx, &tex, true);
+        test_damage_raster(&full, &ctx, &tex, false);
+        ASSERT_TRUE(SDL_memcmp(inc.pixels, full.pixels,
+                               (size_t)full.stride * (size_t)full.height) == 0);
+    }
+
+    forge_raster_buffer_destroy(&inc);
+    forge_raster_buffer_destroy(&full);
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_damage_draw_cmds_clip(void)
+{
+    TEST("damage: scrolling a clipped panel stays inside the panel");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_set_draw_commands(&ctx, true));
+    ASSERT_TRUE(forge_ui_ctx_set_damage_tracking(&ctx, TEST_CMD_FB_W, TEST_CMD_FB_H));
+    float scroll = 17.0f;
+    test_cmd_frame(&ctx, &scroll);
+    test_cmd_frame(&ctx, &scroll);
+    ASSERT_EQ_INT(ctx.damage_rect_count, 0);
+
+    /* Content overflowing the panel is scissored, so the scroll cannot
+     * damage tiles outside the panel (40,30 220x170) */
+    scroll = 40.0f;
+    test_cmd_frame(&ctx, &scroll);
+    ASSERT_TRUE(ctx.damage_rect_count > 0);
+    ASSERT_TRUE(test_damage_rects_valid(&ctx));
+    ASSERT_TRUE(!test_damage_contains(&ctx, 8, 232));
+    ASSERT_TRUE(!test_damage_contains(&ctx, 300, 100));
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_damage_set_tracking_args(void)
+{
+    TEST("damage: set_damage_tracking validates and disables");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ASSERT_TRUE(!forge_ui_ctx_set_damage_tracking(NULL, 100, 100));
+    ASSERT_TRUE(!forge_ui_ctx_set_damage_tracking(&ctx, -1, 100));
+    ASSERT_TRUE(!forge_ui_ctx_set_damage_tracking(&ctx, 100, 20000));
+    ASSERT_TRUE(!ctx.damage_enabled);
+
+    /* A size that is not a tile multiple clamps the last rect */
+    ASSERT_TRUE(forge_ui_ctx_set_damage_tracking(&ctx, 100, 50));
+    test_damage_frame(&ctx, 30.0f, false);
+    ASSERT_EQ_INT(ctx.damage_rect_count, 1);
+    ASSERT_NEAR(ctx.damage_rects[0].w, 100.0f, 0.0f);
+    ASSERT_NEAR(ctx.damage_rects[0].h, 50.0f, 0.0f);
+
+    ASSERT_TRUE(forge_ui_ctx_set_damage_tracking(&ctx, 0, 0));
+    ASSERT_TRUE(!ctx.damage_enabled);
+    test_damage_frame(&ctx, 30.0f, false);
+    ASSERT_EQ_INT(ctx.damage_rect_count, 0);
+    forge_ui_ctx_damage_reset(NULL);
+    forge_ui_ctx_free(&ctx);
+}
+
+/* ── Widget state table tests ───────────────────────────────────────────── */
+
+static void test_state_create_and_find(void)
+{
+    TEST("widget state: created zeroed once, then found");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    Uint32 id = forge_ui_hash_id(&ctx, "Scroller");
+
+    ASSERT_TRUE(forge_ui_ctx_state_find(&ctx, id) == NULL);
+    bool created = false;
+    ForgeUiWidgetState *s = forge_ui_ctx_state(&ctx, id, &created);
+    ASSERT_TRUE(s != NULL);
+    ASSERT_TRUE(created);
+    for (int i = 0; i < 32; i++) ASSERT_EQ_INT(s->bytes[i], 0);
+    s->f[0] = 12.5f;
+    s->i[1] = -3;
+
+    ForgeUiWidgetState *again = forge_ui_ctx_state(&ctx, id, &created);
+    ASSERT_TRUE(again == s);
+    ASSERT_TRUE(!created);
+    ASSERT_TRUE(forge_ui_ctx_state_find(&ctx, id) == s);
+    ASSERT_NEAR(again->f[0], 12.5f, 0.0f);
+    ASSERT_EQ_INT(again->i[1], -3);
+    ASSERT_EQ_INT(ctx.state.count, 1);
+
+    /* created may be NULL; the null ID and NULL ctx are rejected */
+    ASSERT_TRUE(forge_ui_ctx_state(&ctx, id, NULL) == s);
+    ASSERT_TRUE(forge_ui_ctx_state(&ctx, FORGE_UI_ID_NONE, &created) == NULL);
+    ASSERT_TRUE(!created);
+    ASSERT_TRUE(forge_ui_ctx_state(NULL, id, NULL) == NULL);
+    ASSERT_TRUE(forge_ui_ctx_state_find(NULL, id) == NULL);
+    forge_ui_ctx_free(&ctx);
+    ASSERT_TRUE(ctx.state.entries == NULL);
+}
+
+static void test_state_stable_across_growth(void)
+{
+    TEST("widget state: pointers and values survive table growth");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    enum { N = 5000 };
+    ForgeUiWidgetState *first = NULL;
+    char label[32];
+    forge_ui_ctx_begin(&ctx, 0, 0, false);
+    for (int i = 0; i < N; i++) {
+        SDL_snprintf(label, sizeof(label), "row_%d", i);
+        ForgeUiWidgetState *s = forge_ui_ctx_state(
+            &ctx, forge_ui_hash_id(&ctx, label), NULL);
+        ASSERT_TRUE(s != NULL);
+        s->i[0] = i;
+        if (i == 0) first = s;
+    }
+    forge_ui_ctx_end(&ctx);
+    ASSERT_EQ_INT(ctx.state.count, N);
+    ASSERT_TRUE(ctx.state.capacity >= 2 * N);
+
+    SDL_snprintf(label, sizeof(label), "row_%d", 0);
+    ASSERT_TRUE(forge_ui_ctx_state_find(&ctx, forge_ui_hash_id(&ctx, label)) == first);
+    for (int i = 0; i < N; i++) {
+        SDL_snprintf(label, sizeof(label), "row_%d", i);
+        ForgeUiWidgetState *s = forge_ui_ctx_state_find(
+            &ctx, forge_ui_hash_id(&ctx, label));
+        ASSERT_TRUE(s != NULL);
+        if (s) ASSERT_EQ_INT(s->i[0], i);
+    }
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_state_unused_entries_expire(void)
+{
+    TEST("widget state: entries not requested expire, survivors stay");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    enum { N = 2000 };
+    char label[32];
+
+    forge_ui_ctx_begin(&ctx, 0, 0, false);
+    for (int i = 0; i < N; i++) {
+        SDL_snprintf(label, sizeof(label), "item_%d", i);
+        forge_ui_ctx_state(&ctx, forge_ui_hash_id(&ctx, label), NULL)->i[0] = i;
+    }
+    forge_ui_ctx_end(&ctx);
+
+    /* Keep requesting every even item; odd items age out.  Removing them
+     * pulls later entries back along their probe chains, which must
+     * leave every even item reachable. */
+    int frames = FORGE_UI_STATE_MAX_AGE + FORGE_UI_STATE_SWEEP_DIVISOR + 2;
+    for (int f = 0; f < frames; f++) {
+        forge_ui_ctx_begin(&ctx, 0, 0, false);
+        for (int i = 0; i < N; i += 2) {
+            SDL_snprintf(label, sizeof(label), "item_%d", i);
+            ForgeUiWidgetState *s = forge_ui_ctx_state(
+                &ctx, forge_ui_hash_id(&ctx, label), NULL);
+            if (!s || s->i[0] != i) {
+                ASSERT_TRUE(s != NULL && s->i[0] == i);
+                forge_ui_ctx_free(&ctx);
+                return;
+            }
+        }
+        forge_ui_ctx_end(&ctx);
+    }
+    ASSERT_EQ_INT(ctx.state.count, N / 2);
+    for (int i = 1; i < N; i += 2) {
+        SDL_snprintf(label, sizeof(label), "item_%d", i);
+        ASSERT_TRUE(forge_ui_ctx_state_find(&ctx, forge_ui_hash_id(&ctx, label)) == NULL);
+    }
+
+    /* Released storage is reused, zeroed, before new pages are taken */
+    Uint32 used = ctx.state.used;
+    bool created = false;
+    ForgeUiWidgetState *s = forge_ui_ctx_state(&ctx, forge_ui_hash_id(&ctx, "new"),
+                                               &created);
+    ASSERT_TRUE(s != NULL && created);
+    ASSERT_EQ_U32(ctx.state.used, used);
+    if (s) ASSERT_EQ_INT(s->i[0], 0);
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_state_clear(void)
+{
+    TEST("widget state: clear releases everything, table is reusable");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    Uint32 id = forge_ui_hash_id(&ctx, "Anim");
+    forge_ui_ctx_state(&ctx, id, NULL)->f[0] = 1.0f;
+    forge_ui_ctx_state_clear(&ctx);
+    ASSERT_EQ_INT(ctx.state.count, 0);
+    ASSERT_TRUE(ctx.state.entries == NULL && ctx.state.pages == NULL);
+    ASSERT_TRUE(forge_ui_ctx_state_find(&ctx, id) == NULL);
+
+    bool created = false;
+    ForgeUiWidgetState *s = forge_ui_ctx_state(&ctx, id, &created);
+    ASSERT_TRUE(s != NULL && created);
+    if (s) ASSERT_NEAR(s->f[0], 0.0f, 0.0f);
+    forge_ui_ctx_state_clear(NULL);
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_state_survives_region_replay(void)
+{
+    TEST("widget state: replaying a cached panel keeps its widgets' state");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ForgeUiRect panel = { 40.0f, 40.0f, 240.0f, 200.0f };
+    float scroll = 0.0f;
+    Uint32 inner = FORGE_UI_ID_NONE;
+    Uint32 outer = FORGE_UI_ID_NONE;
+    int declared = 0;
+
+    /* The panel is declared once, then replayed for longer than state
+     * lives unrequested; "outer" is requested once outside any panel */
+    int frames = FORGE_UI_STATE_MAX_AGE + FORGE_UI_STATE_SWEEP_DIVISOR + 2;
+    for (int f = 0; f < frames; f++) {
+        forge_ui_ctx_begin(&ctx, 400, 400, false);
+        if (forge_ui_ctx_panel_begin_cached(&ctx, "Stateful", panel,
+                                            &scroll, 1)) {
+            bool created = false;
+            inner = forge_ui_hash_id(&ctx, "cursor");
+            ForgeUiWidgetState *s = forge_ui_ctx_state(&ctx, inner, &created);
+            if (s && created) s->i[0] = 42;
+            forge_ui_ctx_label_layout(&ctx, "Text", 26.0f);
+            forge_ui_ctx_panel_end(&ctx);
+            declared++;
+        }
+        if (f == 0) {
+            outer = forge_ui_hash_id(&ctx, "outer");
+            ASSERT_TRUE(forge_ui_ctx_state(&ctx, outer, NULL) != NULL);
+        }
+        forge_ui_ctx_end(&ctx);
+    }
+    ASSERT_EQ_INT(declared, 1);
+    ASSERT_EQ_U32(ctx.region_cache.hits, (Uint32)(frames - 1));
+    ForgeUiWidgetState *kept = forge_ui_ctx_state_find(&ctx, inner);
+    ASSERT_TRUE(kept != NULL);
+    if (kept) ASSERT_EQ_INT(kept->i[0], 42);
+    ASSERT_TRUE(forge_ui_ctx_state_find(&ctx, outer) == NULL);
+
+    /* Once the panel is no longer declared its state expires as usual */
+    for (int f = 0; f < frames; f++) {
+        forge_ui_ctx_begin(&ctx, 400, 400, false);
+        forge_ui_ctx_end(&ctx);
+    }
+    ASSERT_TRUE(forge_ui_ctx_state_find(&ctx, inner) == NULL);
+    forge_ui_ctx_free(&ctx);
+}
+
+/* ── Frame arena tests ──────────────────────────────────────────────────── */
+
+static void test_arena_alloc_and_counters(void)
+{
+    TEST("frame arena: aligned allocations, per-frame counters");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    forge_ui_ctx_begin(&ctx, 0, 0, false);
+    Uint8 *a = (Uint8 *)forge_ui_ctx_frame_alloc(&ctx, 3);
+    Uint8 *b = (Uint8 *)forge_ui_ctx_frame_alloc(&ctx, 40);
+    ASSERT_TRUE(a != NULL && b != NULL);
+    ASSERT_EQ_INT((int)((uintptr_t)a % FORGE_UI_ARENA_ALIGN), 0);
+    ASSERT_EQ_INT((int)((uintptr_t)b % FORGE_UI_ARENA_ALIGN), 0);
+    ASSERT_TRUE(b >= a + 3);
+    SDL_memset(a, 0xAB, 3);
+    SDL_memset(b, 0xCD, 40);
+    ASSERT_EQ_INT(a[2], 0xAB);
+    ASSERT_EQ_INT(ctx.arena.allocs, 2);
+    ASSERT_EQ_INT((int)ctx.arena.bytes, 16 + 48);
+    ASSERT_EQ_INT(ctx.arena.heap_allocs, 1);
+
+    /* Zero bytes and NULL ctx are rejected */
+    ASSERT_TRUE(forge_ui_ctx_frame_alloc(&ctx, 0) == NULL);
+    ASSERT_TRUE(forge_ui_ctx_frame_alloc(NULL, 8) == NULL);
+    forge_ui_ctx_end(&ctx);
+
+    forge_ui_ctx_begin(&ctx, 0, 0, false);
+    ASSERT_EQ_INT(ctx.arena.allocs, 0);
+    ASSERT_EQ_INT((int)ctx.arena.bytes, 0);
+    ASSERT_EQ_INT(ctx.arena.heap_allocs, 0);
+    forge_ui_ctx_end(&ctx);
+    ASSERT_EQ_INT((int)ctx.arena.peak_bytes, 16 + 48);
+    forge_ui_ctx_free(&ctx);
+    ASSERT_TRUE(ctx.arena.blocks[0] == NULL && ctx.arena.blocks[1] == NULL);
+}
+
+static void test_arena_merges_blocks(void)
+{
+    TEST("frame arena: a half that overflowed is merged, then reused");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    /* Three block sizes' worth per frame */
+    size_t chunk = FORGE_UI_ARENA_BLOCK_SIZE / 2;
+    int heap_allocs[6];
+    for (int f = 0; f < 6; f++) {
+        forge_ui_ctx_begin(&ctx, 0, 0, false);
+        for (int i = 0; i < 6; i++) {
+            Uint8 *p = (Uint8 *)forge_ui_ctx_frame_alloc(&ctx, chunk);
+            ASSERT_TRUE(p != NULL);
+            if (p) p[chunk - 1] = (Uint8)i;
+        }
+        forge_ui_ctx_end(&ctx);
+        heap_allocs[f] = ctx.arena.heap_allocs;
+    }
+    /* Each half grows once, is merged into one block when next rewound,
+     * and then serves every frame without SDL_malloc */
+    ASSERT_TRUE(heap_allocs[0] > 1);
+    ASSERT_EQ_INT(heap_allocs[4], 0);
+    ASSERT_EQ_INT(heap_allocs[5], 0);
+    ASSERT_TRUE(ctx.arena.blocks[0] != NULL && ctx.arena.blocks[0]->next == NULL);
+    ASSERT_TRUE(ctx.arena.blocks[1] != NULL && ctx.arena.blocks[1]->next == NULL);
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_arena_frame_printf(void)
+{
+    TEST("frame arena: frame_printf formats into the arena");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    forge_ui_ctx_begin(&ctx, 0, 0, false);
+    const char *s = forge_ui_ctx_frame_printf(&ctx, "FPS %d (%.1f ms)", 60, 16.7);
+    ASSERT_TRUE(s != NULL);
+    if (s) ASSERT_TRUE(SDL_strcmp(s, "FPS 60 (16.7 ms)") == 0);
+    const char *empty = forge_ui_ctx_frame_printf(&ctx, "%s", "");
+    ASSERT_TRUE(empty != NULL && empty[0] == '\0');
+    ASSERT_TRUE(forge_ui_ctx_frame_printf(NULL, "x") == NULL);
+    ASSERT_TRUE(forge_ui_ctx_frame_printf(&ctx, NULL) == NULL);
+    forge_ui_ctx_label(&ctx, s, 0, 0);
+    ASSERT_TRUE(ctx.vertex_count > 0);
+    forge_ui_ctx_end(&ctx);
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_arena_text_runs_promoted_or_dropped(void)
+{
+    TEST("frame arena: text runs start in the arena, repeats move to heap");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    char buf[32];
+    int after_warmup = -1;
+    for (int f = 0; f < 8; f++) {
+        forge_ui_ctx_begin(&ctx, 0, 0, false);
+        forge_ui_ctx_label(&ctx, "Static", 0, 0);
+        SDL_snprintf(buf, sizeof(buf), "Frame %d", f);
+        forge_ui_ctx_label(&ctx, buf, 0, 40);
+        forge_ui_ctx_end(&ctx);
+        if (f == 4) after_warmup = ctx.arena.heap_allocs;
+    }
+    /* "Static" was promoted on its second frame; the changing labels
+     * live two frames at most, so the cache holds Static plus the last
+     * two counters */
+    ASSERT_EQ_INT(ctx.text_cache.count, 3);
+    ASSERT_EQ_U32(ctx.text_cache.misses, 1 + 8);
+    ASSERT_EQ_U32(ctx.text_cache.hits, 7);
+    ASSERT_EQ_INT(after_warmup, 0);
+    int transient = 0;
+    for (int i = 0; i < ctx.text_cache.capacity; i++) {
+        const ForgeUiTextRun *run = &ctx.text_cache.runs[i];
+        if (run->hash == 0) continue;
+        if (SDL_strcmp(run->text, "Static") == 0) {
+            ASSERT_TRUE(!run->transient);
+        } else {
+            ASSERT_TRUE(run->transient);
+            transient++;
+        }
+    }
+    ASSERT_EQ_INT(transient, 2);
+
+    /* A promoted run still draws all of its glyphs */
+    forge_ui_ctx_begin(&ctx, 0, 0, false);
+    forge_ui_ctx_label(&ctx, "Static", 0, 0);
+    ASSERT_EQ_INT(ctx.vertex_count, 4 * 6);
+    ASSERT_EQ_U32(ctx.text_cache.hits, 8);
+    forge_ui_ctx_end(&ctx);
+    forge_ui_ctx_free(&ctx);
+}
+
+/* ── List clipper tests ───────────────────────────────────────────────── */
+
+#define LIST_ROWS     1000    /* rows in the clipper test lists */
+#define LIST_ROW_H    20.0f   /* uniform row height */
+
+/* Row height for the variable-height lists: 20, 30 or 40 px */
+static float test_list_row_height(int i)
+{
+    return LIST_ROW_H + (float)(i % 3) * 10.0f;
+}
+
+typedef enum TestListMode {
+    TEST_LIST_ALL,       /* declare every row */
+    TEST_LIST_UNIFORM,   /* list_clipper_begin */
+    TEST_LIST_VARIABLE   /* list_clipper_begin_variable */
+} TestListMode;
+
+/* One frame: a header label, the list, and a footer label in a panel.
+ * Variable mode uses test_list_row_height; the others LIST_ROW_H.
+ * Returns the number of rows declared, or -1 if the clipper refused. */
+static int test_list_frame(ForgeUiContext *ctx, float *scroll_y,
+                           TestListMode mode, bool variable_heights,
+                           const float *offsets)
+{
+    int declared = 0;
+    char text[32];
+    forge_ui_ctx_begin(ctx, 0.0f, 0.0f, false);
+    if (forge_ui_ctx_panel_begin(ctx, "List",
+                                 (ForgeUiRect){ 20, 20, 260, 240 }, scroll_y)) {
+        forge_ui_ctx_label_layout(ctx, "Header", ITEM_H);
+        int start = 0, end = LIST_ROWS;
+        ForgeUiListClipper clip;
+        bool clipped = false;
+        if (mode == TEST_LIST_UNIFORM) {
+            if (!forge_ui_ctx_list_clipper_begin(ctx, &clip, LIST_ROWS,
+                                                 LIST_ROW_H)) declared = -1;
+            clipped = true;
+        } else if (mode == TEST_LIST_VARIABLE) {
+            if (!forge_ui_ctx_list_clipper_begin_variable(ctx, &clip, LIST_ROWS,
+                                                          offsets)) declared = -1;
+            clipped = true;
+        }
+        if (declared == 0) {
+            if (clipped) {
+                start = clip.display_start;
+                end = clip.display_end;
+            }
+            for (int i = start; i < end; i++) {
+                SDL_snprintf(text, sizeof(text), "Row %d", i);
+                forge_ui_ctx_label_layout(ctx, text, variable_heights
+                                          ? test_list_row_height(i)
+                                          : LIST_ROW_H);
+                declared++;
+            }
+            if (clipped) forge_ui_ctx_list_clipper_end(ctx, &clip);
+        }
+        forge_ui_ctx_label_layout(ctx, "Footer", ITEM_H);
+        forge_ui_ctx_panel_end(ctx);
+    }
+    forge_ui_ctx_end(ctx);
+    return declared;
+}
+
+static void test_list_clipper_uniform_matches_all(void)
+{
+    TEST("list clipper: uniform rows draw what declaring all rows draws");
+    if (!setup_atlas()) return;
+    ForgeUiContext all, clip;
+    ASSERT_TRUE(forge_ui_ctx_init(&all, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_init(&clip, &test_atlas));
+
+    /* Top, a row boundary, mid-row, and past the end (clamped) */
+    const float scrolls[] = { 0.0f, 240.0f, 5013.0f, 1.0e9f };
+    for (int s = 0; s < (int)(sizeof(scrolls) / sizeof(scrolls[0])); s++) {
+        float scroll_all = scrolls[s], scroll_clip = scrolls[s];
+        /* Twice, so both see the same previous-frame scroll clamp */
+        for (int f = 0; f < 2; f++) {
+            ASSERT_EQ_INT(test_list_frame(&all, &scroll_all, TEST_LIST_ALL,
+                                          false, NULL), LIST_ROWS);
+            int rows = test_list_frame(&clip, &scroll_clip, TEST_LIST_UNIFORM,
+                                       false, NULL);
+            ASSERT_TRUE(rows > 0 && rows < 20);
+        }
+        ASSERT_TRUE(test_region_same_draw(&all, &clip, 0.0f));
+        ASSERT_NEAR(clip._panel.content_height, all._panel.content_height, 0.0f);
+        ASSERT_NEAR(scroll_clip, scroll_all, 0.0f);
+    }
+
+    forge_ui_ctx_free(&all);
+    forge_ui_ctx_free(&clip);
+}
+
+static void test_list_clipper_variable_matches_all(void)
+{
+    TEST("list clipper: prefix-sum rows draw what declaring all rows draws");
+    if (!setup_atlas()) return;
+    static float offsets[LIST_ROWS + 1];
+    offsets[0] = 0.0f;
+    for (int i = 0; i < LIST_ROWS; i++) {
+        offsets[i + 1] = offsets[i] + test_list_row_height(i);
+    }
+    ForgeUiContext all, clip;
+    ASSERT_TRUE(forge_ui_ctx_init(&all, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_init(&clip, &test_atlas));
+
+    const float scrolls[] = { 0.0f, 777.0f, 20000.0f, 1.0e9f };
+    for (int s = 0; s < (int)(sizeof(scrolls) / sizeof(scrolls[0])); s++) {
+        float scroll_all = scrolls[s], scroll_clip = scrolls[s];
+        for (int f = 0; f < 2; f++) {
+            ASSERT_EQ_INT(test_list_frame(&all, &scroll_all, TEST_LIST_ALL,
+                                          true, NULL), LIST_ROWS);
+            int rows = test_list_frame(&clip, &scroll_clip, TEST_LIST_VARIABLE,
+                                       true, offsets);
+            ASSERT_TRUE(rows > 0 && rows < 20);
+        }
+        ASSERT_TRUE(test_region_same_draw(&all, &clip, 0.0f));
+        ASSERT_NEAR(clip._panel.content_height, all._panel.content_height, 0.0f);
+        ASSERT_NEAR(scroll_clip, scroll_all, 0.0f);
+    }
+
+    forge_ui_ctx_free(&all);
+    forge_ui_ctx_free(&clip);
+}
+
+static void test_list_clipper_visible_range(void)
+{
+    TEST("list clipper: range covers exactly the rows in the clip rect");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    if (!panel_test_setup(&ctx)) return;
+    float scroll_y = 0.0f;
+    ASSERT_TRUE(forge_ui_ctx_panel_begin(&ctx, "Range",
+                (ForgeUiRect){ 0, 0, PANEL_W, PANEL_H }, &scroll_y));
+    /* Pretend the previous frame measured the full list so the scroll
+     * offset is not clamped away (panel_begin pre-clamps) */
+    scroll_y = 1000.0f;
+
+    ForgeUiListClipper clip;
+    ASSERT_TRUE(forge_ui_ctx_list_clipper_begin(&ctx, &clip, LIST_ROWS,
+                                                LIST_ROW_H));
+    float spacing = ctx.layout_stack[ctx.layout_depth - 1].spacing;
+    float pitch = LIST_ROW_H + spacing;
+    int first = (int)SDL_floorf(1000.0f / pitch);
+    int last = (int)SDL_ceilf((1000.0f + ctx.clip_rect.h) / pitch);
+    ASSERT_EQ_INT(clip.display_start, first);
+    ASSERT_EQ_INT(clip.display_end, last);
+
+    /* The next layout rect is row display_start, scrolled into view */
+    ForgeUiRect r = forge_ui_ctx_layout_next(&ctx, LIST_ROW_H);
+    ASSERT_NEAR(r.y, ctx.clip_rect.y + (float)first * pitch - 1000.0f, 0.001f);
+    for (int i = clip.display_start + 1; i < clip.display_end; i++) {
+        forge_ui_ctx_layout_next(&ctx, LIST_ROW_H);
+    }
+    forge_ui_ctx_list_clipper_end(&ctx, &clip);
+    forge_ui_ctx_panel_end(&ctx);
+    ASSERT_NEAR(ctx._panel.content_height,
+                (float)LIST_ROWS * pitch - spacing, 0.001f);
+    panel_test_teardown(&ctx);
+}
+
+static void test_list_clipper_no_clip_and_validation(void)
+{
+    TEST("list clipper: all rows without a clip rect; bad input rejected");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    if (!panel_test_setup(&ctx)) return;
+    ForgeUiListClipper clip;
+
+    /* No active layout */
+    ASSERT_TRUE(!forge_ui_ctx_list_clipper_begin(&ctx, &clip, 10, LIST_ROW_H));
+
+    ASSERT_TRUE(forge_ui_ctx_layout_push(&ctx, (ForgeUiRect){ 0, 0, 200, 100 },
+                                         FORGE_UI_LAYOUT_VERTICAL,
+                                         FORGE_UI_LAYOUT_EXPLICIT_ZERO, 4.0f));
+    ASSERT_TRUE(!forge_ui_ctx_list_clipper_begin(NULL, &clip, 10, LIST_ROW_H));
+    ASSERT_TRUE(!forge_ui_ctx_list_clipper_begin(&ctx, NULL, 10, LIST_ROW_H));
+    ASSERT_TRUE(!forge_ui_ctx_list_clipper_begin(&ctx, &clip, -1, LIST_ROW_H));
+    ASSERT_TRUE(!forge_ui_ctx_list_clipper_begin(&ctx, &clip, 10, NAN));
+    ASSERT_TRUE(!forge_ui_ctx_list_clipper_begin(&ctx, &clip, 10, -1.0f));
+    ASSERT_TRUE(!forge_ui_ctx_list_clipper_begin_variable(&ctx, &clip, 10, NULL));
+    const float descending[3] = { 0.0f, 20.0f, -5.0f };
+    ASSERT_TRUE(!forge_ui_ctx_list_clipper_begin_variable(&ctx, &clip, 2,
+                                                          descending));
+
+    /* No clip rect: every row is visible, and end leaves the cursor past
+     * all of them (10 * 20 + 9 gaps of 4) */
+    ASSERT_TRUE(forge_ui_ctx_list_clipper_begin(&ctx, &clip, 10, LIST_ROW_H));
+    ASSERT_EQ_INT(clip.display_start, 0);
+    ASSERT_EQ_INT(clip.display_end, 10);
+    for (int i = 0; i < 10; i++) forge_ui_ctx_layout_next(&ctx, LIST_ROW_H);
+    forge_ui_ctx_list_clipper_end(&ctx, &clip);
+    ASSERT_NEAR(ctx.layout_stack[0].cursor_y, 236.0f, 0.001f);
+    ASSERT_EQ_INT(ctx.layout_stack[0].item_count, 10);
+
+    /* Empty list is valid and moves nothing */
+    ASSERT_TRUE(forge_ui_ctx_list_clipper_begin(&ctx, &clip, 0, LIST_ROW_H));
+    ASSERT_EQ_INT(clip.display_end, 0);
+    forge_ui_ctx_list_clipper_end(&ctx, &clip);
+    ASSERT_NEAR(ctx.layout_stack[0].cursor_y, 236.0f, 0.001f);
+
+    /* end after the layout was popped is ignored */
+    ASSERT_TRUE(forge_ui_ctx_list_clipper_begin(&ctx, &clip, 5, LIST_ROW_H));
+    forge_ui_ctx_layout_pop(&ctx);
+    forge_ui_ctx_list_clipper_end(&ctx, &clip);
+    ASSERT_EQ_INT(ctx.layout_depth, 0);
+
+    panel_test_teardown(&ctx);
+}
+
+/* ── Paragraph widget tests ─────────────────────────────────────────────── */
+
+static void test_paragraph_layout_widget(void)
+{
+    TEST("paragraph_layout: wraps to the layout width and takes its height");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    if (!panel_test_setup(&ctx)) return;
+    ForgeUiParagraph para;
+    if (!forge_ui_paragraph_init(&test_atlas,
+            "Help text re-flows as the window is resized: only the line "
+            "breaks are recomputed, and only when the width changes.",
+            &para)) {
+        SDL_Log("    FAIL: forge_ui_paragraph_init (line %d)", __LINE__);
+        fail_count++;
+        panel_test_teardown(&ctx);
+        return;
+    }
+
+    /* No layout: no-op */
+    forge_ui_ctx_paragraph_layout(&ctx, &para);
+    ASSERT_EQ_INT(ctx.vertex_count, 0);
+
+    const float widths[] = { 200.0f, 90.0f };
+    float heights[2];
+    for (int i = 0; i < 2; i++) {
+        ASSERT_TRUE(forge_ui_ctx_layout_push(&ctx,
+                    (ForgeUiRect){ 0, 0, widths[i], 1000 },
+                    FORGE_UI_LAYOUT_VERTICAL,
+                    FORGE_UI_LAYOUT_EXPLICIT_ZERO, 4.0f));
+        int before = ctx.vertex_count;
+        forge_ui_ctx_paragraph_layout(&ctx, &para);
+        ASSERT_TRUE(para.wrap_width == widths[i]);
+        heights[i] = (float)para.line_count * para.line_height;
+        ASSERT_NEAR(ctx.layout_stack[0].cursor_y, heights[i], 0.001f);
+        ASSERT_EQ_INT(ctx.layout_stack[0].item_count, 1);
+        ASSERT_TRUE(ctx.vertex_count > before);
+        forge_ui_ctx_layout_pop(&ctx);
+    }
+    ASSERT_TRUE(heights[1] > heights[0]);
+
+    /* Horizontal: unwrapped, takes the natural width */
+    ASSERT_TRUE(forge_ui_ctx_layout_push(&ctx, (ForgeUiRect){ 0, 0, 50, 30 },
+                                         FORGE_UI_LAYOUT_HORIZONTAL,
+                                         FORGE_UI_LAYOUT_EXPLICIT_ZERO, 0.0f));
+    forge_ui_ctx_paragraph_layout(&ctx, &para);
+    ASSERT_EQ_INT(para.line_count, 1);
+    ASSERT_NEAR(ctx.layout_stack[0].cursor_x, para.max_line_width, 0.001f);
+
+    /* A paragraph from another atlas is ignored */
+    ForgeUiFontAtlas other = test_atlas;
+    para.atlas = &other;
+    int before = ctx.vertex_count;
+    forge_ui_ctx_paragraph_layout(&ctx, &para);
+    ASSERT_EQ_INT(ctx.vertex_count, before);
+    ASSERT_EQ_INT(ctx.layout_stack[0].item_count, 1);
+    forge_ui_ctx_layout_pop(&ctx);
+
+    forge_ui_paragraph_free(&para);
+    panel_test_teardown(&ctx);
+}
+
 /* ── Main ────────────────────────────────────────────────────────────────── */
 
 int main(int argc, char *argv[])
@@ -6763,6 +8332,66 @@ int main(int argc, char *argv[])
     test_ascender_px_inf_pixel_height();
     test_ascender_px_nan_pixel_height();
 
+    /* Text layout cache */
+    test_text_cache_hit_on_repeat();
+    test_text_cache_matches_uncached_layout();
+    test_text_cache_color_not_keyed();
+    test_text_cache_evicts_stale_runs();
+    test_text_cache_clipped_replay();
+    test_text_cache_clear();
+    test_text_cache_grows();
+
+    /* Packed vertex format */
+    test_vertex_format_default_float();
+    test_vertex_format_packed_frame();
+    test_vertex_format_invalid_rejected();
+
+    /* Draw commands */
+    test_draw_cmds_disabled_by_default();
+    test_draw_cmds_panel_structure();
+    test_draw_cmds_skip_cpu_clipping();
+    test_draw_cmds_texture_split();
+    test_draw_cmds_scissor_matches_cpu_clip();
+    test_rebase_indices_matches_scalar();
+
+    /* Cached regions */
+    test_region_replay_matches_declared();
+    test_region_replay_translates_moved_panel();
+    test_region_key_changes_redeclare();
+    test_region_input_prevents_replay();
+    test_region_draw_cmds_replayed();
+    test_region_clear_and_evict();
+
+    /* Damage tracking */
+    test_damage_off_by_default();
+    test_damage_first_frame_full();
+    test_damage_slider_change_is_local();
+    test_damage_partial_redraw_matches_full();
+    test_damage_draw_cmds_clip();
+    test_damage_set_tracking_args();
+
+    /* Widget state table */
+    test_state_create_and_find();
+    test_state_stable_across_growth();
+    test_state_unused_entries_expire();
+    test_state_clear();
+    test_state_survives_region_replay();
+
+    /* Frame arena */
+    test_arena_alloc_and_counters();
+    test_arena_merges_blocks();
+    test_arena_frame_printf();
+    test_arena_text_runs_promoted_or_dropped();
+
+    /* List clipper */
+    test_list_clipper_uniform_matches_all();
+    test_list_clipper_variable_matches_all();
+    test_list_clipper_visible_range();
+    test_list_clipper_no_clip_and_validation();
+
+    /* Paragraph widget */
+    test_paragraph_layout_widget();
+
     SDL_Log("=== Results: %d tests, %d passed, %d failed ===",
             test_count, pass_count, fail_count);
 
@@ -0,0 +1,590 @@
+/*
+ * UI Glyph Cache Tests
+ *
+ * Automated tests for common/ui/forge_ui_glyph_cache.h — the dynamic
+ * glyph atlas that rasterizes on first use and evicts least recently used
+ * glyphs.
+ *
+ * Tests cover:
+ *   - Init/free lifecycle and parameter validation
+ *   - Rasterize-on-miss, hit on repeat, pixels matching the rasterizer
+ *   - Dirty rectangles (full page on creation, per-cell afterwards)
+ *   - LRU eviction order and protection of glyphs used this frame
+ *   - Multiple pages
+ *   - Whitespace glyphs and the white block
+ *   - Blank glyphs stored without a cell (no evictions for spaces)
+ *   - Atlas views: text layout and ForgeUiContext labels via the cache
+ *
+ * Uses the bundled Liberation Mono Regular font for all tests.
+ *
+ * Exit code: 0 if all tests pass, 1 if any test fails
+ *
+ * SPDX-License-Identifier: Zlib
+ */
+
+#include <SDL3/SDL.h>
+#include "ui/forge_ui.h"
+#include "ui/forge_ui_glyph_cache.h"
+#include "ui/forge_ui_ctx.h"
+
+/* ── Test Framework ──────────────────────────────────────────────────────── */
+
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST(name)                                                \
+    do {                                                          \
+        test_count++;                                             \
+        SDL_Log("  [TEST] %s", name);                             \
+    } while (0)
+
+#define ASSERT_TRUE(expr)                                         \
+    do {                                                          \
+        if (!(expr)) {                                            \
+            SDL_Log("    FAIL: %s (line %d)", #expr, __LINE__);   \
+            fail_count++;                                         \
+            return;                                               \
+        }                                                         \
+        pass_count++;                                             \
+    } while (0)
+
+#define ASSERT_EQ_INT(a, b)                                       \
+    do {                                                          \
+        int _a = (a), _b = (b);                                   \
+        if (_a != _b) {                                           \
+            SDL_Log("    FAIL: %s == %d, expected %d (line %d)",  \
+                    #a, _a, _b, __LINE__);                        \
+            fail_count++;                                         \
+            return;                                               \
+        }                                                         \
+        pass_count++;                                             \
+    } while (0)
+
+/* ── Test parameters ─────────────────────────────────────────────────────── */
+
+#define TEST_FONT_PATH   "assets/fonts/liberation_mono/LiberationMono-Regular.ttf"
+#define CACHE_PX         16.0f  /* small glyphs keep test pages small */
+#define CACHE_PAGE       256    /* page size for general tests */
+#define CACHE_TINY_PAGE  64     /* page size for eviction tests */
+#define CACHE_PADDING    1
+
+static ForgeUiFont test_font;
+static bool font_loaded = false;
+
+/* ── Tests: lifecycle ────────────────────────────────────────────────────── */
+
+static void test_init_free(void)
+{
+    TEST("glyph_cache: init computes geometry, allocates no pages");
+    if (!font_loaded) return;
+
+    ForgeUiGlyphCache cache;
+    ASSERT_TRUE(forge_ui_glyph_cache_init(&cache, &test_font, CACHE_PX,
+                                          CACHE_PAGE, 2, CACHE_PADDING));
+    ASSERT_TRUE(cache.cell_w > 0 && cache.cell_h > 0);
+    ASSERT_TRUE(cache.cells_per_page >= 2);
+    ASSERT_EQ_INT(cache.page_count, 0);
+    ASSERT_TRUE(cache.pages[0].pixels == NULL);
+
+    forge_ui_glyph_cache_free(&cache);
+    ASSERT_TRUE(cache.slots == NULL);
+    ASSERT_EQ_INT(cache.page_count, 0);
+}
+
+static void test_init_rejects_bad_params(void)
+{
+    TEST("glyph_cache: init rejects invalid parameters");
+    if (!font_loaded) return;
+
+    ForgeUiGlyphCache cache;
+    ASSERT_TRUE(!forge_ui_glyph_cache_init(NULL, &test_font, CACHE_PX,
+                                           CACHE_PAGE, 1, 1));
+    ASSERT_TRUE(!forge_ui_glyph_cache_init(&cache, NULL, CACHE_PX,
+                                           CACHE_PAGE, 1, 1));
+    ASSERT_TRUE(!forge_ui_glyph_cache_init(&cache, &test_font, 0.0f,
+                                           CACHE_PAGE, 1, 1));
+    ASSERT_TRUE(!forge_ui_glyph_cache_init(&cache, &test_font, CACHE_PX,
+                                           300, 1, 1));  /* not pow2 */
+    ASSERT_TRUE(!forge_ui_glyph_cache_init(&cache, &test_font, CACHE_PX,
+                                           CACHE_PAGE, 0, 1));
+    ASSERT_TRUE(!forge_ui_glyph_cache_init(
+        &cache, &test_font, CACHE_PX, CACHE_PAGE,
+        FORGE_UI_GLYPH_CACHE_MAX_PAGES + 1, 1));
+    ASSERT_TRUE(!forge_ui_glyph_cache_init(&cache, &test_font, CACHE_PX,
+                                           CACHE_PAGE, 1, -1));
+    /* A 64px glyph cell cannot fit twice in a 64x64 page */
+    ASSERT_TRUE(!forge_ui_glyph_cache_init(&cache, &test_font, 64.0f,
+                                           CACHE_TINY_PAGE, 1, 1));
+    ASSERT_TRUE(cache.slots == NULL);
+}
+
+static void test_free_zeroed(void)
+{
+    TEST("glyph_cache: free is safe on NULL and zeroed caches");
+    ForgeUiGlyphCache cache;
+    SDL_memset(&cache, 0, sizeof(cache));
+    forge_ui_glyph_cache_free(&cache);
+    forge_ui_glyph_cache_free(NULL);
+    ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, 'A') == NULL);
+}
+
+/* ── Tests: rasterize on miss ────────────────────────────────────────────── */
+
+static void test_get_rasterizes_on_miss(void)
+{
+    TEST("glyph_cache: first get rasterizes, second get hits");
+    if (!font_loaded) return;
+
+    ForgeUiGlyphCache cache;
+    ASSERT_TRUE(forge_ui_glyph_cache_init(&cache, &test_font, CACHE_PX,
+                                          CACHE_PAGE, 1, CACHE_PADDING));
+    forge_ui_glyph_cache_begin_frame(&cache);
+
+    const ForgeUiCachedGlyph *a = forge_ui_glyph_cache_get(&cache, 'A');
+    ASSERT_TRUE(a != NULL);
+    ASSERT_EQ_INT(cache.frame_misses, 1);
+    ASSERT_EQ_INT(cache.page_count, 1);
+    ASSERT_EQ_INT(a->page, 0);
+    ASSERT_TRUE(a->glyph.codepoint == 'A');
+    ASSERT_TRUE(a->glyph.bitmap_w > 0 && a->glyph.bitmap_h > 0);
+    ASSERT_TRUE(a->glyph.advance_width > 0);
+
+    const ForgeUiCachedGlyph *again = forge_ui_glyph_cache_get(&cache, 'A');
+    ASSERT_TRUE(again == a);
+    ASSERT_EQ_INT(cache.frame_hits, 1);
+    ASSERT_EQ_INT(cache.frame_misses, 1);
+
+    forge_ui_glyph_cache_free(&cache);
+}
+
+static void test_pixels_match_rasterizer(void)
+{
+    TEST("glyph_cache: cached pixels match forge_ui_rasterize_glyph");
+    if (!font_loaded) return;
+
+    ForgeUiGlyphCache cache;
+    ASSERT_TRUE(forge_ui_glyph_cache_init(&cache, &test_font, CACHE_PX,
+                                          CACHE_PAGE, 1, CACHE_PADDING));
+    forge_ui_glyph_cache_begin_frame(&cache);
+    const ForgeUiCachedGlyph *g = forge_ui_glyph_cache_get(&cache, 'g');
+    ASSERT_TRUE(g != NULL);
+
+    ForgeUiRasterOpts opts;
+    SDL_memset(&opts, 0, sizeof(opts));
+    opts.supersample_level = 4;
+    ForgeUiGlyphBitmap bmp;
+    ASSERT_TRUE(forge_ui_rasterize_glyph(&test_font, g->glyph.glyph_index,
+                                         CACHE_PX, &opts, &bmp));
+    ASSERT_EQ_INT(g->glyph.bitmap_w, bmp.width);
+    ASSERT_EQ_INT(g->glyph.bitmap_h, bmp.height);
+    ASSERT_EQ_INT(g->glyph.bearing_x, bmp.bearing_x);
+    ASSERT_EQ_INT(g->glyph.bearing_y, bmp.bearing_y);
+
+    /* Locate the bitmap in the page through its UVs */
+    int x0 = (int)(g->glyph.uv.u0 * (float)cache.page_size + 0.5f);
+    int y0 = (int)(g->glyph.uv.v0 * (float)cache.page_size + 0.5f);
+    const Uint8 *page = cache.pages[g->page].pixels;
+    bool same = true;
+    for (int y = 0; y < bmp.height && same; y++) {
+        same = SDL_memcmp(page + (size_t)(y0 + y) * cache.page_size + x0,
+                          bmp.pixels + (size_t)y * bmp.width,
+                          (size_t)bmp.width) == 0;
+    }
+    forge_ui_glyph_bitmap_free(&bmp);
+    ASSERT_TRUE(same);
+
+    forge_ui_glyph_cache_free(&cache);
+}
+
+static void test_whitespace_and_white_block(void)
+{
+    TEST("glyph_cache: space is blank and points at the white block");
+    if (!font_loaded) return;
+
+    ForgeUiGlyphCache cache;
+    ASSERT_TRUE(forge_ui_glyph_cache_init(&cache, &test_font, CACHE_PX,
+                                          CACHE_PAGE, 1, CACHE_PADDING));
+    forge_ui_glyph_cache_begin_frame(&cache);
+    const ForgeUiCachedGlyph *sp = forge_ui_glyph_cache_get(&cache, ' ');
+    ASSERT_TRUE(sp != NULL);
+    ASSERT_EQ_INT(sp->glyph.bitmap_w, 0);
+    ASSERT_TRUE(sp->glyph.advance_width > 0);
+    ASSERT_TRUE(sp->glyph.uv.u1 <= cache.white_uv.u1);
+
+    const Uint8 *px = cache.pages[0].pixels;
+    ASSERT_EQ_INT(px[0], 255);
+    ASSERT_EQ_INT(px[1], 255);
+    ASSERT_EQ_INT(px[cache.page_size], 255);
+    ASSERT_EQ_INT(px[cache.page_size + 1], 255);
+
+    forge_ui_glyph_cache_free(&cache);
+}
+
+/* ── Tests: dirty rectangles ─────────────────────────────────────────────── */
+
+static void test_dirty_rects(void)
+{
+    TEST("glyph_cache: new page is fully dirty, later glyphs dirty one cell");
+    if (!font_loaded) return;
+
+    ForgeUiGlyphCache cache;
+    ASSERT_TRUE(forge_ui_glyph_cache_init(&cache, &test_font, CACHE_PX,
+                                          CACHE_PAGE, 1, CACHE_PADDING));
+    forge_ui_glyph_cache_begin_frame(&cache);
+    ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, 'A') != NULL);
+
+    /* Page creation marks the full page, then the glyph's cell */
+    ForgeUiGlyphCachePage *page = &cache.pages[0];
+    ASSERT_TRUE(page->dirty_count >= 1);
+    ASSERT_EQ_INT(page->dirty[0].w, CACHE_PAGE);
+    ASSERT_EQ_INT(page->dirty[0].h, CACHE_PAGE);
+
+    /* Next frame: a hit dirties nothing, a miss dirties exactly its cell */
+    forge_ui_glyph_cache_begin_frame(&cache);
+    ASSERT_EQ_INT(page->dirty_count, 0);
+    ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, 'A') != NULL);
+    ASSERT_EQ_INT(page->dirty_count, 0);
+
+    const ForgeUiCachedGlyph *b = forge_ui_glyph_cache_get(&cache, 'B');
+    ASSERT_TRUE(b != NULL);
+    ASSERT_EQ_INT(page->dirty_count, 1);
+    ASSERT_EQ_INT(page->dirty[0].w, cache.cell_w);
+    ASSERT_EQ_INT(page->dirty[0].h, cache.cell_h);
+    int bx = (int)(b->glyph.uv.u0 * (float)CACHE_PAGE + 0.5f);
+    int by = (int)(b->glyph.uv.v0 * (float)CACHE_PAGE + 0.5f);
+    ASSERT_EQ_INT(page->dirty[0].x, bx);
+    ASSERT_EQ_INT(page->dirty[0].y, by);
+
+    forge_ui_glyph_cache_free(&cache);
+}
+
+static void test_dirty_rects_collapse(void)
+{
+    TEST("glyph_cache: dirty list overflow collapses to a bounding box");
+    if (!font_loaded) return;
+
+    ForgeUiGlyphCache cache;
+    ASSERT_TRUE(forge_ui_glyph_cache_init(&cache, &test_font, CACHE_PX,
+                                          CACHE_PAGE, 1, CACHE_PADDING));
+    ASSERT_TRUE(cache.cells_per_page > FORGE_UI_GLYPH_CACHE_MAX_DIRTY + 1);
+    forge_ui_glyph_cache_begin_frame(&cache);
+    ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, 'A') != NULL);
+    forge_ui_glyph_cache_begin_frame(&cache);
+
+    for (int i = 0; i < FORGE_UI_GLYPH_CACHE_MAX_DIRTY + 1; i++) {
+        ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, (Uint32)('a' + i % 26)
+                                             + (Uint32)(i / 26) * 0x20)
+                    != NULL);
+    }
+    ASSERT_TRUE(cache.pages[0].dirty_count <= FORGE_UI_GLYPH_CACHE_MAX_DIRTY);
+    ASSERT_TRUE(cache.pages[0].dirty_count >= 1);
+
+    forge_ui_glyph_cache_free(&cache);
+}
+
+/* ── Tests: eviction and pages ───────────────────────────────────────────── */
+
+static void test_lru_eviction(void)
+{
+    TEST("glyph_cache: evicts the least recently used glyph when full");
+    if (!font_loaded) return;
+
+    ForgeUiGlyphCache cache;
+    ASSERT_TRUE(forge_ui_glyph_cache_init(&cache, &test_font, CACHE_PX,
+                                          CACHE_TINY_PAGE, 1, CACHE_PADDING));
+    int capacity = cache.cells_per_page - 1;  /* cell 0 is the white block */
+    ASSERT_TRUE(capacity >= 2);
+
+    /* Fill every cell, one glyph per frame so recency is strictly ordered */
+    for (int i = 0; i < capacity; i++) {
+        forge_ui_glyph_cache_begin_frame(&cache);
+        ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, (Uint32)('A' + i)) != NULL);
+    }
+    ASSERT_EQ_INT(cache.free_count, 0);
+
+    /* Touch 'A' so 'B' becomes least recently used */
+    forge_ui_glyph_cache_begin_frame(&cache);
+    ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, 'A') != NULL);
+
+    forge_ui_glyph_cache_begin_frame(&cache);
+    ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, 'z') != NULL);
+    ASSERT_EQ_INT(cache.frame_evictions, 1);
+
+    /* 'A' survived, 'B' was evicted (getting it again is a miss) */
+    ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, 'A') != NULL);
+    ASSERT_EQ_INT(cache.frame_misses, 1);
+    ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, 'B') != NULL);
+    ASSERT_EQ_INT(cache.frame_misses, 2);
+    ASSERT_EQ_INT(cache.frame_evictions, 2);
+
+    forge_ui_glyph_cache_free(&cache);
+}
+
+static void test_no_eviction_within_frame(void)
+{
+    TEST("glyph_cache: glyphs used this frame are never evicted");
+    if (!font_loaded) return;
+
+    ForgeUiGlyphCache cache;
+    ASSERT_TRUE(forge_ui_glyph_cache_init(&cache, &test_font, CACHE_PX,
+                                          CACHE_TINY_PAGE, 1, CACHE_PADDING));
+    int capacity = cache.cells_per_page - 1;
+
+    forge_ui_glyph_cache_begin_frame(&cache);
+    for (int i = 0; i < capacity; i++) {
+        ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, (Uint32)('A' + i)) != NULL);
+    }
+    /* Cache is full of glyphs from this frame — the next miss fails */
+    ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, 'z') == NULL);
+    ASSERT_EQ_INT(cache.frame_evictions, 0);
+
+    /* Next frame the same request succeeds by evicting */
+    forge_ui_glyph_cache_begin_frame(&cache);
+    ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, 'z') != NULL);
+    ASSERT_EQ_INT(cache.frame_evictions, 1);
+
+    forge_ui_glyph_cache_free(&cache);
+}
+
+static void test_multiple_pages(void)
+{
+    TEST("glyph_cache: adds pages before evicting");
+    if (!font_loaded) return;
+
+    ForgeUiGlyphCache cache;
+    ASSERT_TRUE(forge_ui_glyph_cache_init(&cache, &test_font, CACHE_PX,
+                                          CACHE_TINY_PAGE, 2, CACHE_PADDING));
+    int capacity = cache.cells_per_page - 1;
+
+    forge_ui_glyph_cache_begin_frame(&cache);
+    for (int i = 0; i < capacity; i++) {
+        ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, (Uint32)('A' + i)) != NULL);
+    }
+    ASSERT_EQ_INT(cache.page_count, 1);
+
+    const ForgeUiCachedGlyph *g = forge_ui_glyph_cache_get(&cache, 'z');
+    ASSERT_TRUE(g != NULL);
+    ASSERT_EQ_INT(g->page, 1);
+    ASSERT_EQ_INT(cache.page_count, 2);
+    ASSERT_EQ_INT(cache.frame_evictions, 0);
+    ASSERT_TRUE(cache.pages[1].dirty_count >= 1);
+    ASSERT_EQ_INT(cache.pages[1].pixels[0], 255);  /* white block */
+
+    forge_ui_glyph_cache_free(&cache);
+}
+
+/* ── Tests: blank glyphs ─────────────────────────────────────────────────── */
+
+static void test_blank_glyphs_take_no_cell(void)
+{
+    TEST("glyph_cache: spaces take no cell and evict nothing");
+    if (!font_loaded) return;
+
+    ForgeUiGlyphCache cache;
+    ASSERT_TRUE(forge_ui_glyph_cache_init(&cache, &test_font, CACHE_PX,
+                                          CACHE_TINY_PAGE, 1, CACHE_PADDING));
+    int capacity = cache.cells_per_page - 1;
+
+    /* Fill every cell with letters on earlier frames */
+    for (int i = 0; i < capacity; i++) {
+        forge_ui_glyph_cache_begin_frame(&cache);
+        ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, (Uint32)('A' + i)) != NULL);
+    }
+    ASSERT_EQ_INT(cache.free_count, 0);
+
+    /* Text with many spaces: every resident letter, each followed by a
+     * run of spaces and a no-break space */
+    forge_ui_glyph_cache_begin_frame(&cache);
+    for (int i = 0; i < capacity; i++) {
+        ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, (Uint32)('A' + i)) != NULL);
+        for (int k = 0; k < 4; k++) {
+            ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, ' ') != NULL);
+        }
+        ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, 0x00A0) != NULL);
+    }
+    ASSERT_EQ_INT(cache.frame_evictions, 0);
+    ASSERT_EQ_INT(cache.frame_misses, 2);
+    ASSERT_EQ_INT(cache.blank_count, 2);
+    ASSERT_EQ_INT(cache.free_count, 0);
+
+    /* Blanks stay resident across frames without holding a cell */
+    forge_ui_glyph_cache_begin_frame(&cache);
+    ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, 'z') != NULL);
+    ASSERT_EQ_INT(cache.frame_evictions, 1);
+    ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, ' ') != NULL);
+    ASSERT_EQ_INT(cache.frame_misses, 1);
+
+    forge_ui_glyph_cache_free(&cache);
+}
+
+/* ── Tests: atlas views ──────────────────────────────────────────────────── */
+
+static void test_bind_atlas_layout(void)
+{
+    TEST("glyph_cache: bound atlas lays out text like a built atlas");
+    if (!font_loaded) return;
+
+    ForgeUiGlyphCache multi;
+    ForgeUiFontAtlas view;
+    ASSERT_TRUE(forge_ui_glyph_cache_init(&multi, &test_font, CACHE_PX,
+                                          CACHE_PAGE, 2, CACHE_PADDING));
+    ASSERT_TRUE(!forge_ui_glyph_cache_bind_atlas(&multi, &view));
+    forge_ui_glyph_cache_free(&multi);
+
+    ForgeUiGlyphCache cache;
+    ASSERT_TRUE(forge_ui_glyph_cache_init(&cache, &test_font, CACHE_PX,
+                                          CACHE_PAGE, 1, CACHE_PADDING));
+    ASSERT_TRUE(forge_ui_glyph_cache_bind_atlas(&cache, &view));
+    ASSERT_TRUE(view.pixels == cache.pages[0].pixels);
+    ASSERT_EQ_INT(view.width, CACHE_PAGE);
+
+    const char *text = "Hi  there,   world";
+    Uint32 cps[] = { 'H', 'i', ' ', 't', 'h', 'e', 'r', ',', 'w', 'o', 'l',
+                     'd' };
+    ForgeUiFontAtlas built;
+    ASSERT_TRUE(forge_ui_atlas_build(&test_font, CACHE_PX, cps,
+                                     (int)SDL_arraysize(cps), CACHE_PADDING,
+                                     &built));
+
+    forge_ui_glyph_cache_begin_frame(&cache);
+    ForgeUiTextLayout got, want;
+    ASSERT_TRUE(forge_ui_text_layout(&view, text, 10.0f, 20.0f, NULL, &got));
+    ASSERT_TRUE(forge_ui_text_layout(&built, text, 10.0f, 20.0f, NULL, &want));
+    ASSERT_EQ_INT(got.vertex_count, 13 * 4);  /* spaces draw nothing */
+    ASSERT_EQ_INT(got.vertex_count, want.vertex_count);
+    ASSERT_TRUE(got.total_width == want.total_width);
+    for (int i = 0; i < got.vertex_count; i++) {
+        ASSERT_TRUE(got.vertices[i].pos_x == want.vertices[i].pos_x);
+        ASSERT_TRUE(got.vertices[i].pos_y == want.vertices[i].pos_y);
+    }
+    const ForgeUiCachedGlyph *h = forge_ui_glyph_cache_get(&cache, 'H');
+    ASSERT_TRUE(h != NULL);
+    ASSERT_TRUE(got.vertices[0].uv_u == h->glyph.uv.u0);
+    ASSERT_TRUE(got.vertices[0].uv_v == h->glyph.uv.v0);
+    ASSERT_EQ_INT(cache.frame_misses, 12);
+    ASSERT_EQ_INT(cache.blank_count, 1);
+
+    /* Paragraphs index a glyph array the view does not have */
+    ForgeUiParagraph para;
+    ASSERT_TRUE(!forge_ui_paragraph_init(&view, text, &para));
+
+    forge_ui_text_layout_free(&got);
+    forge_ui_text_layout_free(&want);
+    forge_ui_atlas_free(&built);
+    forge_ui_glyph_cache_free(&cache);
+}
+
+/* Draw one label in a fresh context frame (after a glyph cache frame) */
+static void cache_label_frame(ForgeUiGlyphCache *cache, ForgeUiContext *ctx,
+                              const char *text)
+{
+    forge_ui_glyph_cache_begin_frame(cache);
+    forge_ui_ctx_begin(ctx, -1.0f, -1.0f, false);
+    forge_ui_ctx_label(ctx, text, 0.0f, 20.0f);
+    forge_ui_ctx_end(ctx);
+}
+
+static void test_bind_atlas_ctx_labels(void)
+{
+    TEST("glyph_cache: context labels re-lay out after an eviction");
+    if (!font_loaded) return;
+
+    ForgeUiGlyphCache cache;
+    ForgeUiFontAtlas view;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_glyph_cache_init(&cache, &test_font, CACHE_PX,
+                                          CACHE_TINY_PAGE, 1, CACHE_PADDING));
+    ASSERT_TRUE(forge_ui_glyph_cache_bind_atlas(&cache, &view));
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &view));
+    int capacity = cache.cells_per_page - 1;
+    ASSERT_TRUE(capacity >= 3);
+
+    /* Frame 1 rasterizes both glyphs; frame 2 replays the text run, but
+     * still marks its glyphs as used this frame */
+    cache_label_frame(&cache, &ctx, "AB");
+    ASSERT_EQ_INT(cache.frame_misses, 3);  /* layout also asks for ' ' */
+    ASSERT_EQ_INT(ctx.vertex_count, 8);
+    cache_label_frame(&cache, &ctx, "AB");
+    ASSERT_EQ_INT((int)ctx.text_cache.hits, 1);
+    ASSERT_EQ_INT(cache.frame_misses, 0);
+    ASSERT_TRUE(cache.frame_hits >= 2);
+
+    /* Fill the page with other glyphs until 'A' (least recent) is
+     * evicted and its cell reused */
+    forge_ui_glyph_cache_begin_frame(&cache);
+    for (int i = 0; i < capacity - 1; i++) {
+        ASSERT_TRUE(forge_ui_glyph_cache_get(&cache, (Uint32)('a' + i)) != NULL);
+    }
+    ASSERT_EQ_INT(cache.frame_evictions, 1);
+
+    /* The cached run is stale: the label is laid out again and its
+     * quads sample the glyph's new cell */
+    cache_label_frame(&cache, &ctx, "AB");
+    ASSERT_EQ_INT((int)ctx.text_cache.misses, 2);
+    ASSERT_EQ_INT(ctx.vertex_count, 8);
+    const ForgeUiCachedGlyph *a = forge_ui_glyph_cache_get(&cache, 'A');
+    ASSERT_TRUE(a != NULL);
+    ASSERT_TRUE(ctx.vertices[0].uv_u == a->glyph.uv.u0);
+    ASSERT_TRUE(ctx.vertices[0].uv_v == a->glyph.uv.v0);
+
+    forge_ui_ctx_free(&ctx);
+    forge_ui_glyph_cache_free(&cache);
+}
+
+/* ── Main ────────────────────────────────────────────────────────────────── */
+
+int main(int argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    if (!SDL_Init(0)) {
+        SDL_Log("SDL_Init failed: %s", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("=== UI Glyph Cache Tests (forge_ui_glyph_cache.h) ===");
+    SDL_Log("");
+
+    font_loaded = forge_ui_ttf_load(TEST_FONT_PATH, &test_font);
+    if (!font_loaded) {
+        SDL_Log("Failed to load test font: %s", TEST_FONT_PATH);
+        SDL_Quit();
+        return 1;
+    }
+
+    /* Lifecycle */
+    test_init_free();
+    test_init_rejects_bad_params();
+    test_free_zeroed();
+
+    /* Rasterize on miss */
+    test_get_rasterizes_on_miss();
+    test_pixels_match_rasterizer();
+    test_whitespace_and_white_block();
+
+    /* Dirty rectangles */
+    test_dirty_rects();
+    test_dirty_rects_collapse();
+
+    /* Eviction and pages */
+    test_lru_eviction();
+    test_no_eviction_within_frame();
+    test_multiple_pages();
+
+    /* Blank glyphs */
+    test_blank_glyphs_take_no_cell();
+
+    /* Atlas views */
+    test_bind_atlas_layout();
+    test_bind_atlas_ctx_labels();
+
+    SDL_Log("=== Results: %d tests, %d passed, %d failed ===",
+            test_count, pass_count, fail_count);
+
+    forge_ui_ttf_free(&test_font);
+    SDL_Quit();
+
+    return fail_count > 0 ? 1 : 0;
+}
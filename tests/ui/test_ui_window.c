@@ -2051,6 +2051,444 @@ static void test_window_begin_return_checked(void)
     forge_ui_ctx_free(&ctx);
 }
 
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  DRAW COMMANDS
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+static void test_window_draw_cmds_follow_z_order(void)
+{
+    TEST("wctx_end: window draw commands rebased and appended in z order");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_set_draw_commands(&ctx, true));
+    ForgeUiWindowContext wctx;
+    ASSERT_TRUE(forge_ui_wctx_init(&wctx, &ctx));
+
+    /* "Front" is declared first but drawn last */
+    ForgeUiWindowState front = { .rect = { 60, 60, 200, 150 }, .z_order = 2 };
+    ForgeUiWindowState back  = { .rect = { 10, 10, 200, 150 }, .z_order = 1 };
+
+    for (int frame = 0; frame < 2; frame++) {
+        ForgeUiRect front_clip = { 0 }, back_clip = { 0 };
+        forge_ui_ctx_begin(&ctx, 0, 0, false);
+        forge_ui_wctx_begin(&wctx);
+        forge_ui_ctx_label(&ctx, "Behind", 4, 20);
+        if (forge_ui_wctx_window_begin(&wctx, "Front", &front)) {
+            front_clip = ctx.clip_rect;
+            forge_ui_ctx_label_layout(&ctx, "front text", 30.0f);
+            forge_ui_wctx_window_end(&wctx);
+        }
+        if (forge_ui_wctx_window_begin(&wctx, "Back", &back)) {
+            back_clip = ctx.clip_rect;
+            forge_ui_ctx_label_layout(&ctx, "back text", 30.0f);
+            forge_ui_wctx_window_end(&wctx);
+        }
+        /* The main list only holds the label until wctx_end */
+        ASSERT_EQ_INT(ctx.draw_cmd_count, 1);
+        forge_ui_wctx_end(&wctx);
+        forge_ui_ctx_end(&ctx);
+
+        /* label + back chrome merge; then back content, front chrome,
+         * front content */
+        ASSERT_EQ_INT(ctx.draw_cmd_count, 4);
+        int next = 0;
+        for (int c = 0; c < ctx.draw_cmd_count; c++) {
+            ASSERT_EQ_INT(ctx.draw_cmds[c].index_offset, next);
+            ASSERT_TRUE(ctx.draw_cmds[c].index_count > 0);
+            next += ctx.draw_cmds[c].index_count;
+        }
+        ASSERT_EQ_INT(next, ctx.index_count);
+
+        ASSERT_TRUE(!ctx.draw_cmds[0].has_clip);
+        ASSERT_TRUE(ctx.draw_cmds[1].has_clip);
+        ASSERT_NEAR(ctx.draw_cmds[1].clip_rect.x, back_clip.x, 0.0f);
+        ASSERT_NEAR(ctx.draw_cmds[1].clip_rect.y, back_clip.y, 0.0f);
+        ASSERT_TRUE(!ctx.draw_cmds[2].has_clip);
+        ASSERT_TRUE(ctx.draw_cmds[3].has_clip);
+        ASSERT_NEAR(ctx.draw_cmds[3].clip_rect.x, front_clip.x, 0.0f);
+        ASSERT_NEAR(ctx.draw_cmds[3].clip_rect.y, front_clip.y, 0.0f);
+    }
+
+    forge_ui_wctx_free(&wctx);
+    forge_ui_ctx_free(&ctx);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  COMPOSE MODES
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+/* Three overlapping windows declared out of z order, plus a label outside
+ * any window.  The middle window is collapsed on request. */
+static void segment_frame(ForgeUiWindowContext *wctx,
+                          ForgeUiWindowState states[3])
+{
+    static const char *titles[3] = { "Seg A", "Seg B", "Seg C" };
+    ForgeUiContext *ctx = wctx->ctx;
+    forge_ui_ctx_begin(ctx, 0, 0, false);
+    forge_ui_wctx_begin(wctx);
+    forge_ui_ctx_label(ctx, "outside", 4, 20);
+    for (int i = 0; i < 3; i++) {
+        if (forge_ui_wctx_window_begin(wctx, titles[i], &states[i])) {
+            forge_ui_ctx_label_layout(ctx, titles[i], 30.0f);
+            forge_ui_ctx_button_layout(ctx, "Press", 30.0f);
+            forge_ui_wctx_window_end(wctx);
+        }
+    }
+    forge_ui_wctx_end(wctx);
+    forge_ui_ctx_end(ctx);
+}
+
+static void test_segments_match_compact(void)
+{
+    TEST("wctx_end: segments concatenate to the compacted draw data");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx_c, ctx_s;
+    ForgeUiWindowContext wctx_c, wctx_s;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx_c, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx_s, &test_atlas));
+    ASSERT_TRUE(forge_ui_wctx_init(&wctx_c, &ctx_c));
+    ASSERT_TRUE(forge_ui_wctx_init(&wctx_s, &ctx_s));
+    ASSERT_EQ_INT((int)wctx_c.compose_mode, (int)FORGE_UI_WINDOW_COMPOSE_COMPACT);
+    ASSERT_TRUE(forge_ui_wctx_set_compose_mode(&wctx_s,
+                                               FORGE_UI_WINDOW_COMPOSE_SEGMENTS));
+
+    ForgeUiWindowState sc[3] = {
+        { .rect = { 10, 10, 200, 150 }, .z_order = 3 },
+        { .rect = { 40, 40, 200, 150 }, .z_order = 1 },
+        { .rect = { 70, 70, 200, 150 }, .z_order = 2 },
+    };
+    ForgeUiWindowState ss[3];
+    SDL_memcpy(ss, sc, sizeof(ss));
+
+    for (int frame = 0; frame < 2; frame++) {
+        /* Frame 1 collapses a window: it still contributes a title bar */
+        sc[1].collapsed = ss[1].collapsed = (frame == 1);
+        segment_frame(&wctx_c, sc);
+        segment_frame(&wctx_s, ss);
+
+        ASSERT_EQ_INT(wctx_c.segment_count, 1);
+        ASSERT_TRUE(wctx_c.segments[0].vertices == ctx_c.vertices);
+        ASSERT_EQ_INT(wctx_c.segments[0].index_count, ctx_c.index_count);
+
+        /* outside label, then windows back to front: B (z 1), C, A */
+        ASSERT_EQ_INT(wctx_s.segment_count, 4);
+        ASSERT_TRUE(wctx_s.segments[0].vertices == ctx_s.vertices);
+        int base_vertex = 0, first_index = 0;
+        for (int i = 0; i < wctx_s.segment_count; i++) {
+            const ForgeUiDrawSegment *seg = &wctx_s.segments[i];
+            ASSERT_EQ_INT(seg->base_vertex, base_vertex);
+            ASSERT_EQ_INT(seg->first_index, first_index);
+            ASSERT_TRUE(base_vertex + seg->vertex_count <= ctx_c.vertex_count);
+            ASSERT_TRUE(first_index + seg->index_count <= ctx_c.index_count);
+            ASSERT_TRUE(SDL_memcmp(&ctx_c.vertices[base_vertex], seg->vertices,
+                                   (size_t)seg->vertex_count
+                                   * sizeof(ForgeUiVertex)) == 0);
+            for (int k = 0; k < seg->index_count; k++) {
+                ASSERT_TRUE(seg->indices[k] < (Uint32)seg->vertex_count);
+                ASSERT_EQ_U32(ctx_c.indices[first_index + k],
+                              seg->indices[k] + (Uint32)base_vertex);
+            }
+            base_vertex += seg->vertex_count;
+            first_index += seg->index_count;
+        }
+        ASSERT_EQ_INT(base_vertex, ctx_c.vertex_count);
+        ASSERT_EQ_INT(first_index, ctx_c.index_count);
+    }
+
+    ASSERT_TRUE(!forge_ui_wctx_set_compose_mode(&wctx_s,
+                                                (ForgeUiWindowComposeMode)5));
+    ASSERT_TRUE(!forge_ui_wctx_set_compose_mode(NULL,
+                                                FORGE_UI_WINDOW_COMPOSE_COMPACT));
+    forge_ui_wctx_free(&wctx_c);
+    forge_ui_wctx_free(&wctx_s);
+    forge_ui_ctx_free(&ctx_c);
+    forge_ui_ctx_free(&ctx_s);
+}
+
+static void test_segments_carry_draw_cmds(void)
+{
+    TEST("wctx_end: each segment carries its own draw commands");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ForgeUiWindowContext wctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_set_draw_commands(&ctx, true));
+    ASSERT_TRUE(forge_ui_wctx_init(&wctx, &ctx));
+    ASSERT_TRUE(forge_ui_wctx_set_compose_mode(&wctx,
+                                               FORGE_UI_WINDOW_COMPOSE_SEGMENTS));
+
+    ForgeUiWindowState states[3] = {
+        { .rect = { 10, 10, 200, 150 }, .z_order = 0 },
+        { .rect = { 40, 40, 200, 150 }, .z_order = 1 },
+        { .rect = { 70, 70, 200, 150 }, .z_order = 2 },
+    };
+    segment_frame(&wctx, states);
+
+    ASSERT_EQ_INT(wctx.segment_count, 4);
+    ASSERT_EQ_INT(wctx.segments[0].draw_cmd_count, 1);
+    for (int i = 0; i < wctx.segment_count; i++) {
+        const ForgeUiDrawSegment *seg = &wctx.segments[i];
+        int next = 0, clipped = 0;
+        for (int c = 0; c < seg->draw_cmd_count; c++) {
+            ASSERT_EQ_INT(seg->draw_cmds[c].index_offset, next);
+            ASSERT_TRUE(seg->draw_cmds[c].index_count > 0);
+            next += seg->draw_cmds[c].index_count;
+            if (seg->draw_cmds[c].has_clip) clipped++;
+        }
+        ASSERT_EQ_INT(next, seg->index_count);
+        ASSERT_EQ_INT(clipped, i == 0 ? 0 : 1);
+    }
+
+    forge_ui_wctx_free(&wctx);
+    forge_ui_ctx_free(&ctx);
+}
+
+static void test_segments_packed(void)
+{
+    TEST("wctx_end: packed output covers every segment at its base_vertex");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ForgeUiWindowContext wctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_set_vertex_format(&ctx,
+                                               FORGE_UI_VERTEX_FORMAT_PACKED));
+    ASSERT_TRUE(forge_ui_wctx_init(&wctx, &ctx));
+    ASSERT_TRUE(forge_ui_wctx_set_compose_mode(&wctx,
+                                               FORGE_UI_WINDOW_COMPOSE_SEGMENTS));
+
+    ForgeUiWindowState states[3] = {
+        { .rect = { 10, 10, 200, 150 }, .z_order = 2 },
+        { .rect = { 40, 40, 200, 150 }, .z_order = 0 },
+        { .rect = { 70, 70, 200, 150 }, .z_order = 1 },
+    };
+    segment_frame(&wctx, states);
+
+    ASSERT_EQ_INT(wctx.segment_count, 4);
+    const ForgeUiDrawSegment *last = &wctx.segments[wctx.segment_count - 1];
+    ASSERT_EQ_INT(ctx.packed_vertex_count,
+                  last->base_vertex + last->vertex_count);
+    ASSERT_TRUE(ctx.packed_vertex_count > ctx.vertex_count);
+    for (int i = 0; i < wctx.segment_count; i++) {
+        const ForgeUiDrawSegment *seg = &wctx.segments[i];
+        for (int v = 0; v < seg->vertex_count; v++) {
+            ForgeUiPackedVertex expect;
+            forge_ui_pack_vertices(&seg->vertices[v], &expect, 1);
+            ASSERT_TRUE(SDL_memcmp(&ctx.packed_vertices[seg->base_vertex + v],
+                                   &expect, sizeof(expect)) == 0);
+        }
+    }
+
+    forge_ui_wctx_free(&wctx);
+    forge_ui_ctx_free(&ctx);
+}
+
+/* True if (x, y) lies in one of ctx's damage rects */
+static bool damage_contains(const ForgeUiContext *ctx, float x, float y)
+{
+    for (int i = 0; i < ctx->damage_rect_count; i++) {
+        const ForgeUiRect *r = &ctx->damage_rects[i];
+        if (x >= r->x && x < r->x + r->w && y >= r->y && y < r->y + r->h) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* segment_frame with window i declared only when bit i of shown is set */
+static void damage_segment_frame(ForgeUiWindowContext *wctx,
+                                 ForgeUiWindowState states[3], int shown)
+{
+    static const char *titles[3] = { "Dmg A", "Dmg B", "Dmg C" };
+    ForgeUiContext *ctx = wctx->ctx;
+    forge_ui_ctx_begin(ctx, 0, 0, false);
+    forge_ui_wctx_begin(wctx);
+    forge_ui_ctx_label(ctx, "outside", 4, 20);
+    for (int i = 0; i < 3; i++) {
+        if (!(shown & (1 << i))) continue;
+        if (forge_ui_wctx_window_begin(wctx, titles[i], &states[i])) {
+            forge_ui_ctx_label_layout(ctx, titles[i], 30.0f);
+            forge_ui_wctx_window_end(wctx);
+        }
+    }
+    forge_ui_wctx_end(wctx);
+    forge_ui_ctx_end(ctx);
+}
+
+static void test_segments_feed_damage(void)
+{
+    TEST("wctx_end: segment windows are damage tracked");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ForgeUiWindowContext wctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_set_damage_tracking(&ctx, 640, 480));
+    ASSERT_TRUE(forge_ui_wctx_init(&wctx, &ctx));
+    ASSERT_TRUE(forge_ui_wctx_set_compose_mode(&wctx,
+                                               FORGE_UI_WINDOW_COMPOSE_SEGMENTS));
+
+    ForgeUiWindowState states[3] = {
+        { .rect = { 10, 60, 150, 100 }, .z_order = 0 },
+        { .rect = { 200, 60, 150, 100 }, .z_order = 1 },
+        { .rect = { 400, 60, 150, 100 }, .z_order = 2 },
+    };
+    damage_segment_frame(&wctx, states, 7);
+    ASSERT_EQ_INT(wctx.segment_count, 4);
+    damage_segment_frame(&wctx, states, 7);
+    ASSERT_EQ_INT(ctx.damage_rect_count, 0);
+
+    /* Moving a window damages where it was and where it is now */
+    states[1].rect.y += 200;
+    damage_segment_frame(&wctx, states, 7);
+    ASSERT_TRUE(ctx.damage_rect_count > 0);
+    ASSERT_TRUE(damage_contains(&ctx, 275.0f, 100.0f));
+    ASSERT_TRUE(damage_contains(&ctx, 275.0f, 300.0f));
+    ASSERT_TRUE(!damage_contains(&ctx, 85.0f, 100.0f));
+    ASSERT_TRUE(!damage_contains(&ctx, 475.0f, 100.0f));
+
+    /* Closing a window damages the pixels it covered */
+    damage_segment_frame(&wctx, states, 7);
+    ASSERT_EQ_INT(ctx.damage_rect_count, 0);
+    damage_segment_frame(&wctx, states, 3);
+    ASSERT_TRUE(damage_contains(&ctx, 475.0f, 100.0f));
+    ASSERT_TRUE(!damage_contains(&ctx, 85.0f, 100.0f));
+
+    forge_ui_wctx_free(&wctx);
+    forge_ui_ctx_free(&ctx);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  CACHED WINDOWS
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+/* Three windows with a few widgets each, declared through
+ * window_begin_cached when cached is set.  Returns how many windows had
+ * their widgets declared. */
+static int cached_window_frame(ForgeUiWindowContext *wctx,
+                               ForgeUiWindowState states[3], Uint32 version,
+                               float mx, float my, bool cached)
+{
+    static const char *titles[3] = { "Cache A", "Cache B", "Cache C" };
+    ForgeUiContext *ctx = wctx->ctx;
+    int declared = 0;
+    forge_ui_ctx_begin(ctx, mx, my, false);
+    forge_ui_wctx_begin(wctx);
+    for (int i = 0; i < 3; i++) {
+        bool open = cached
+            ? forge_ui_wctx_window_begin_cached(wctx, titles[i], &states[i],
+                                                version)
+            : forge_ui_wctx_window_begin(wctx, titles[i], &states[i]);
+        if (open) {
+            forge_ui_ctx_label_layout(ctx, titles[i], 26.0f);
+            forge_ui_ctx_button_layout(ctx, "Apply", 30.0f);
+            forge_ui_ctx_label_layout(ctx, "Footer", 26.0f);
+            forge_ui_wctx_window_end(wctx);
+            declared++;
+        }
+    }
+    forge_ui_wctx_end(wctx);
+    forge_ui_ctx_end(ctx);
+    return declared;
+}
+
+static bool cached_same_draw(const ForgeUiContext *a, const ForgeUiContext *b,
+                             float tolerance)
+{
+    if (a->vertex_count != b->vertex_count) return false;
+    if (a->index_count != b->index_count) return false;
+    for (int i = 0; i < a->index_count; i++) {
+        if (a->indices[i] != b->indices[i]) return false;
+    }
+    for (int i = 0; i < a->vertex_count; i++) {
+        if (SDL_fabsf(a->vertices[i].pos_x - b->vertices[i].pos_x) > tolerance ||
+            SDL_fabsf(a->vertices[i].pos_y - b->vertices[i].pos_y) > tolerance ||
+            a->vertices[i].uv_u != b->vertices[i].uv_u ||
+            a->vertices[i].uv_v != b->vertices[i].uv_v ||
+            a->vertices[i].r != b->vertices[i].r ||
+            a->vertices[i].a != b->vertices[i].a) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_cached_windows_replay(void)
+{
+    TEST("window_begin_cached: quiet windows replay, moved ones translate");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx_c, ctx_p;
+    ForgeUiWindowContext wctx_c, wctx_p;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx_c, &test_atlas));
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx_p, &test_atlas));
+    ASSERT_TRUE(forge_ui_wctx_init(&wctx_c, &ctx_c));
+    ASSERT_TRUE(forge_ui_wctx_init(&wctx_p, &ctx_p));
+
+    ForgeUiWindowState sc[3] = {
+        { .rect = { 10, 10, 200, 150 }, .z_order = 2 },
+        { .rect = { 60, 40, 200, 150 }, .z_order = 0 },
+        { .rect = { 110, 70, 200, 150 }, .z_order = 1 },
+    };
+    ForgeUiWindowState sp[3];
+    SDL_memcpy(sp, sc, sizeof(sp));
+
+    ASSERT_EQ_INT(cached_window_frame(&wctx_c, sc, 1, 700, 700, true), 3);
+    ASSERT_EQ_INT(ctx_c.region_cache.count, 3);
+    ASSERT_EQ_INT(cached_window_frame(&wctx_c, sc, 1, 700, 700, true), 0);
+    ASSERT_EQ_U32(ctx_c.region_cache.hits, 3);
+    ASSERT_EQ_INT(wctx_c.window_count, 3);
+    cached_window_frame(&wctx_p, sp, 1, 700, 700, false);
+    cached_window_frame(&wctx_p, sp, 1, 700, 700, false);
+    ASSERT_TRUE(cached_same_draw(&ctx_c, &ctx_p, 0.0f));
+
+    /* Move one window (as a drag on an earlier frame would have) */
+    sc[1].rect.x = sp[1].rect.x = 83.5f;
+    sc[1].rect.y = sp[1].rect.y = 12.0f;
+    ASSERT_EQ_INT(cached_window_frame(&wctx_c, sc, 1, 700, 700, true), 0);
+    cached_window_frame(&wctx_p, sp, 1, 700, 700, false);
+    ASSERT_TRUE(cached_same_draw(&ctx_c, &ctx_p, 1e-3f));
+
+    /* The cursor over A's title bar: A is declared, and again on the next
+     * frame because its title bar is still hot from this one */
+    ASSERT_EQ_INT(cached_window_frame(&wctx_c, sc, 1, 20, 20, true), 1);
+    ASSERT_EQ_INT(cached_window_frame(&wctx_c, sc, 1, 700, 700, true), 1);
+    ASSERT_EQ_INT(cached_window_frame(&wctx_c, sc, 1, 700, 700, true), 0);
+
+    /* A new version re-declares everything */
+    ASSERT_EQ_INT(cached_window_frame(&wctx_c, sc, 2, 700, 700, true), 3);
+
+    forge_ui_wctx_free(&wctx_c);
+    forge_ui_wctx_free(&wctx_p);
+    forge_ui_ctx_free(&ctx_c);
+    forge_ui_ctx_free(&ctx_p);
+}
+
+static void test_cached_window_collapsed_not_recorded(void)
+{
+    TEST("window_begin_cached: collapsed windows are not recorded");
+    if (!setup_atlas()) return;
+    ForgeUiContext ctx;
+    ForgeUiWindowContext wctx;
+    ASSERT_TRUE(forge_ui_ctx_init(&ctx, &test_atlas));
+    ASSERT_TRUE(forge_ui_wctx_init(&wctx, &ctx));
+
+    ForgeUiWindowState states[3] = {
+        { .rect = { 10, 10, 200, 150 }, .z_order = 0 },
+        { .rect = { 60, 40, 200, 150 }, .collapsed = true, .z_order = 1 },
+        { .rect = { 110, 70, 200, 150 }, .z_order = 2 },
+    };
+    ASSERT_EQ_INT(cached_window_frame(&wctx, states, 1, 700, 700, true), 2);
+    ASSERT_EQ_INT(ctx.region_cache.count, 2);
+    ASSERT_EQ_INT(cached_window_frame(&wctx, states, 1, 700, 700, true), 0);
+
+    /* The collapsed window still draws its title bar */
+    ASSERT_EQ_INT(wctx.window_count, 3);
+    ASSERT_TRUE(wctx.window_entries[1].vertex_count > 0);
+
+    ASSERT_TRUE(!forge_ui_wctx_window_begin_cached(NULL, "x", &states[0], 1));
+    forge_ui_wctx_free(&wctx);
+    forge_ui_ctx_free(&ctx);
+}
+
 /* ═══════════════════════════════════════════════════════════════════════════
  *  MAIN
  * ═══════════════════════════════════════════════════════════════════════════ */
@@ -2173,6 +2611,19 @@ int main(int argc, char *argv[])
     test_window_scope_isolates_children();
     test_window_begin_return_checked();
 
+    SDL_Log("--- Draw Commands ---");
+    test_window_draw_cmds_follow_z_order();
+
+    SDL_Log("--- Compose Modes ---");
+    test_segments_match_compact();
+    test_segments_carry_draw_cmds();
+    test_segments_packed();
+    test_segments_feed_damage();
+
+    SDL_Log("--- Cached Windows ---");
+    test_cached_windows_replay();
+    test_cached_window_collapsed_not_recorded();
+
     SDL_Log("");
     SDL_Log("=== Results: %d tests, %d assertions passed, %d failed ===",
             test_count, pass_count, fail_count);
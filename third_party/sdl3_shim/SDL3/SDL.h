@@ -22,12 +22,16 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
 
 /* ── Types ──────────────────────────────────────────────────────────────── */
 
 typedef uint8_t Uint8;
 typedef int16_t Sint16;
 typedef uint16_t Uint16;
+typedef int32_t Sint32;
 typedef uint32_t Uint32;
 typedef uint64_t Uint64;
 
@@ -120,6 +124,8 @@ static inline void *SDL_memset(void *dst, int c, size_t n)
     return memset(dst, c, n);
 }
 
+#define SDL_zero(x) SDL_memset(&(x), 0, sizeof((x)))
+
 static inline int SDL_memcmp(const void *a, const void *b, size_t n)
 {
     return memcmp(a, b, n);
@@ -144,6 +150,11 @@ static inline char *SDL_strdup(const char *s)
     return copy;
 }
 
+static inline int SDL_vsnprintf(char *buf, size_t n, const char *fmt, va_list args)
+{
+    return vsnprintf(buf, n, fmt, args);
+}
+
 static inline int SDL_snprintf(char *buf, size_t n, const char *fmt, ...)
 {
     va_list args;
@@ -161,6 +172,186 @@ static inline float SDL_fmodf(float x, float y) { return (float)fmod((double)x,
 static inline float SDL_ceilf(float x)  { return (float)ceil((double)x); }
 static inline float SDL_floorf(float x) { return (float)floor((double)x); }
 
+/* ── Timer ──────────────────────────────────────────────────────────────── */
+/*
+ * Wall-clock counter for benchmarks.  POSIX builds use CLOCK_MONOTONIC with
+ * nanosecond ticks; elsewhere the shim falls back to clock(), which measures
+ * processor time and is only a rough stand-in.
+ */
+
+static inline Uint64 SDL_GetPerformanceCounter(void)
+{
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (Uint64)ts.tv_sec * 1000000000u + (Uint64)ts.tv_nsec;
+#else
+    return (Uint64)clock();
+#endif
+}
+
+static inline Uint64 SDL_GetPerformanceFrequency(void)
+{
+#if defined(CLOCK_MONOTONIC)
+    return 1000000000u;
+#else
+    return (Uint64)CLOCKS_PER_SEC;
+#endif
+}
+
+/* ── CPU info ───────────────────────────────────────────────────────────── */
+/*
+ * Runtime instruction-set checks for code that dispatches to SIMD kernels.
+ * Only what the forge libraries ask about; GCC and Clang answer from CPUID.
+ */
+
+static inline bool SDL_HasAVX2(void)
+{
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#else
+    return false;
+#endif
+}
+
+/* ── Threads and atomics ────────────────────────────────────────────────── */
+/*
+ * POSIX threads behind the SDL3 thread API, enough for worker pools that
+ * create, join, sleep on a condition variable, and hand out work through
+ * an atomic counter.
+ */
+
+typedef int (*SDL_ThreadFunction)(void *data);
+
+typedef struct SDL_Thread {
+    pthread_t          handle;
+    SDL_ThreadFunction fn;
+    void              *data;
+    int                status;
+} SDL_Thread;
+
+typedef struct SDL_AtomicInt { int value; } SDL_AtomicInt;
+
+static inline void *SDL_Shim_ThreadMain(void *arg)
+{
+    SDL_Thread *t = (SDL_Thread *)arg;
+    t->status = t->fn(t->data);
+    return NULL;
+}
+
+static inline SDL_Thread *SDL_CreateThread(SDL_ThreadFunction fn,
+                                           const char *name, void *data)
+{
+    (void)name;
+    SDL_Thread *t = (SDL_Thread *)malloc(sizeof(SDL_Thread));
+    if (!t) return NULL;
+    t->fn = fn;
+    t->data = data;
+    t->status = 0;
+    if (pthread_create(&t->handle, NULL, SDL_Shim_ThreadMain, t) != 0) {
+        free(t);
+        return NULL;
+    }
+    return t;
+}
+
+static inline void SDL_WaitThread(SDL_Thread *thread, int *status)
+{
+    if (!thread) return;
+    pthread_join(thread->handle, NULL);
+    if (status) *status = thread->status;
+    free(thread);
+}
+
+static inline int SDL_GetNumLogicalCPUCores(void)
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+/* Mutexes and condition variables, for worker pools that sleep between
+ * jobs instead of being created per job */
+typedef struct SDL_Mutex     { pthread_mutex_t handle; } SDL_Mutex;
+typedef struct SDL_Condition { pthread_cond_t  handle; } SDL_Condition;
+
+static inline SDL_Mutex *SDL_CreateMutex(void)
+{
+    SDL_Mutex *m = (SDL_Mutex *)malloc(sizeof(SDL_Mutex));
+    if (!m) return NULL;
+    if (pthread_mutex_init(&m->handle, NULL) != 0) {
+        free(m);
+        return NULL;
+    }
+    return m;
+}
+
+static inline void SDL_DestroyMutex(SDL_Mutex *m)
+{
+    if (!m) return;
+    pthread_mutex_destroy(&m->handle);
+    free(m);
+}
+
+static inline void SDL_LockMutex(SDL_Mutex *m)
+{
+    if (m) pthread_mutex_lock(&m->handle);
+}
+
+static inline void SDL_UnlockMutex(SDL_Mutex *m)
+{
+    if (m) pthread_mutex_unlock(&m->handle);
+}
+
+static inline SDL_Condition *SDL_CreateCondition(void)
+{
+    SDL_Condition *c = (SDL_Condition *)malloc(sizeof(SDL_Condition));
+    if (!c) return NULL;
+    if (pthread_cond_init(&c->handle, NULL) != 0) {
+        free(c);
+        return NULL;
+    }
+    return c;
+}
+
+static inline void SDL_DestroyCondition(SDL_Condition *c)
+{
+    if (!c) return;
+    pthread_cond_destroy(&c->handle);
+    free(c);
+}
+
+static inline void SDL_SignalCondition(SDL_Condition *c)
+{
+    if (c) pthread_cond_signal(&c->handle);
+}
+
+static inline void SDL_BroadcastCondition(SDL_Condition *c)
+{
+    if (c) pthread_cond_broadcast(&c->handle);
+}
+
+static inline void SDL_WaitCondition(SDL_Condition *c, SDL_Mutex *m)
+{
+    if (c && m) pthread_cond_wait(&c->handle, &m->handle);
+}
+
+/* Returns the previous value, like SDL3 */
+static inline int SDL_AddAtomicInt(SDL_AtomicInt *a, int v)
+{
+    return __atomic_fetch_add(&a->value, v, __ATOMIC_SEQ_CST);
+}
+
+static inline int SDL_SetAtomicInt(SDL_AtomicInt *a, int v)
+{
+    return __atomic_exchange_n(&a->value, v, __ATOMIC_SEQ_CST);
+}
+
+static inline int SDL_GetAtomicInt(SDL_AtomicInt *a)
+{
+    return __atomic_load_n(&a->value, __ATOMIC_SEQ_CST);
+}
+
 /* ── Sorting ───────────────────────────────────────────────────────────── */
 
 static inline void SDL_qsort(void *base, size_t nmemb, size_t size,